@@ -532,6 +532,35 @@ static void __set_FPSCR(uint32_t fpscr)
 #pragma diag_default=Pe940
 
 
+#elif (defined (LPC_HOST_SIM)) /*------------- Host Register Simulator ------------*/
+/* Host simulator functions: PRIMASK and IPSR are kept by lpc_host_sim.c,
+   all other core registers read as zero and writes are ignored */
+
+extern void     HOSTSIM_SetPrimask(uint32_t primask);
+extern uint32_t HOSTSIM_GetPrimask(void);
+extern uint32_t HOSTSIM_GetIpsr(void);
+
+static __INLINE void __enable_irq(void)                { HOSTSIM_SetPrimask(0); }
+static __INLINE void __disable_irq(void)               { HOSTSIM_SetPrimask(1); }
+static __INLINE uint32_t __get_CONTROL(void)           { return 0; }
+static __INLINE void __set_CONTROL(uint32_t control)   { (void)control; }
+static __INLINE uint32_t __get_IPSR(void)              { return HOSTSIM_GetIpsr(); }
+static __INLINE uint32_t __get_APSR(void)              { return 0; }
+static __INLINE uint32_t __get_xPSR(void)              { return 0; }
+static __INLINE uint32_t __get_PSP(void)               { return 0; }
+static __INLINE void __set_PSP(uint32_t topOfProcStack) { (void)topOfProcStack; }
+static __INLINE uint32_t __get_MSP(void)               { return 0; }
+static __INLINE void __set_MSP(uint32_t topOfMainStack) { (void)topOfMainStack; }
+static __INLINE uint32_t __get_PRIMASK(void)           { return HOSTSIM_GetPrimask(); }
+static __INLINE void __set_PRIMASK(uint32_t priMask)   { HOSTSIM_SetPrimask(priMask); }
+static __INLINE void __enable_fault_irq(void)          { }
+static __INLINE void __disable_fault_irq(void)         { }
+static __INLINE uint32_t __get_BASEPRI(void)           { return 0; }
+static __INLINE void __set_BASEPRI(uint32_t value)     { (void)value; }
+static __INLINE uint32_t __get_FAULTMASK(void)         { return 0; }
+static __INLINE void __set_FAULTMASK(uint32_t faultMask) { (void)faultMask; }
+
+
 #elif (defined (__GNUC__)) /*------------------ GNU Compiler ---------------------*/
 /* GNU gcc specific functions */
 
@@ -450,6 +450,58 @@ static __INLINE void __CLREX(void)
 
 
 
+#elif (defined (LPC_HOST_SIM)) /*------------- Host Register Simulator ------------*/
+/* Host simulator functions: hints and barriers are no-ops, WFI advances the
+   virtual clock of lpc_host_sim.c up to the next interrupt */
+
+extern void HOSTSIM_WaitForInterrupt(void);
+
+static __INLINE void __NOP(void)                       { }
+static __INLINE void __WFI(void)                       { HOSTSIM_WaitForInterrupt(); }
+static __INLINE void __WFE(void)                       { HOSTSIM_WaitForInterrupt(); }
+static __INLINE void __SEV(void)                       { }
+static __INLINE void __ISB(void)                       { __sync_synchronize(); }
+static __INLINE void __DSB(void)                       { __sync_synchronize(); }
+static __INLINE void __DMB(void)                       { __sync_synchronize(); }
+static __INLINE uint32_t __REV(uint32_t value)         { return __builtin_bswap32(value); }
+static __INLINE uint32_t __REV16(uint32_t value)       { return ((value & 0xFF00FF00) >> 8) | ((value & 0x00FF00FF) << 8); }
+static __INLINE int32_t __REVSH(int32_t value)         { return (int16_t)(((value & 0xFF00) >> 8) | ((value & 0x00FF) << 8)); }
+
+static __INLINE uint32_t __RBIT(uint32_t value)
+{
+  uint32_t result = 0;
+  int32_t i;
+
+  for (i = 0; i < 32; i++, value >>= 1)
+  {
+    result = (result << 1) | (value & 1);
+  }
+  return(result);
+}
+
+static __INLINE uint8_t __LDREXB(volatile uint8_t *addr)                  { return *addr; }
+static __INLINE uint16_t __LDREXH(volatile uint16_t *addr)                { return *addr; }
+static __INLINE uint32_t __LDREXW(volatile uint32_t *addr)                { return *addr; }
+static __INLINE uint32_t __STREXB(uint8_t value, volatile uint8_t *addr)   { *addr = value; return 0; }
+static __INLINE uint32_t __STREXH(uint16_t value, volatile uint16_t *addr) { *addr = value; return 0; }
+static __INLINE uint32_t __STREXW(uint32_t value, volatile uint32_t *addr) { *addr = value; return 0; }
+static __INLINE void __CLREX(void)                     { }
+
+#define __SSAT(ARG1,ARG2) \
+({                          \
+  int32_t __v = (ARG1), __m = (int32_t)((1UL << ((ARG2) - 1)) - 1); \
+  (__v > __m) ? __m : ((__v < -__m - 1) ? (-__m - 1) : __v); \
+ })
+
+#define __USAT(ARG1,ARG2) \
+({                          \
+  int32_t __v = (ARG1), __m = (int32_t)((1UL << (ARG2)) - 1); \
+  (uint32_t)((__v > __m) ? __m : ((__v < 0) ? 0 : __v)); \
+ })
+
+static __INLINE uint8_t __CLZ(uint32_t value)          { return (value == 0) ? 32 : __builtin_clz(value); }
+
+
 #elif (defined (__GNUC__)) /*------------------ GNU Compiler ---------------------*/
 /* GNU gcc specific functions */
 
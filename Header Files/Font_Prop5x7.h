@@ -0,0 +1,128 @@
+//GLCD FontName : Prop5x7
+//GLCD FontSize : 1..5 x 7, proportional
+//Packed from default5x7 with blank columns trimmed (SPACE is 3 wide).
+//Each glyph holds 7 rows of Prop5x7_Width[] bits, LSB first and without
+//row padding, starting at byte Prop5x7_Offset[] of Prop5x7_Bits[].
+
+#ifndef __FONT_PROP5x7_H
+#define __FONT_PROP5x7_H
+
+const uint8_t Prop5x7_Width[95] = {
+                         3, 1, 3, 5, 5, 5, 5, 2, 3, 3, 5, 5, 2, 5, 2, 5,
+                         5, 3, 5, 5, 5, 5, 5, 5, 5, 5, 2, 2, 4, 5, 4, 5,
+                         5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 5, 5, 5, 5, 5,
+                         5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 2, 5, 2, 5, 5,
+                         3, 5, 5, 5, 5, 5, 5, 5, 5, 3, 4, 4, 3, 5, 5, 5,
+                         5, 5, 4, 5, 5, 5, 5, 5, 5, 5, 5, 4, 1, 4, 5
+};
+
+const uint16_t Prop5x7_Offset[95] = {
+                           0,   3,   4,   7,  12,  17,  22,  27,  29,  32,  35,  40,
+                          45,  47,  52,  54,  59,  64,  67,  72,  77,  82,  87,  92,
+                          97, 102, 107, 109, 111, 115, 120, 124, 129, 134, 139, 144,
+                         149, 154, 159, 164, 169, 174, 177, 182, 187, 192, 197, 202,
+                         207, 212, 217, 222, 227, 232, 237, 242, 247, 252, 257, 262,
+                         264, 269, 271, 276, 281, 284, 289, 294, 299, 304, 309, 314,
+                         319, 324, 327, 331, 335, 338, 343, 348, 353, 358, 363, 367,
+                         372, 377, 382, 387, 392, 397, 402, 407, 411, 412, 416
+};
+
+const uint8_t Prop5x7_Bits[421] = {
+                         0x00, 0x00, 0x00, // SPACE
+                         0x5F, // !
+                         0x2D, 0x00, 0x00, // "
+                         0x40, 0x7D, 0xF5, 0x15, 0x00, // #
+                         0xC4, 0x17, 0x47, 0x1F, 0x01, // $
+                         0x73, 0x21, 0x22, 0x74, 0x06, // %
+                         0x26, 0x15, 0x51, 0x93, 0x05, // &
+                         0x1B, 0x00, // '
+                         0x54, 0x12, 0x11, // (
+                         0x11, 0x49, 0x05, // )
+                         0x80, 0x54, 0x57, 0x09, 0x00, // *
+                         0x80, 0x90, 0x4F, 0x08, 0x00, // +
+                         0x00, 0x1B, // ,
+                         0x00, 0x80, 0x0F, 0x00, 0x00, // -
+                         0x00, 0x3C, // .
+                         0x00, 0x22, 0x22, 0x02, 0x00, // /
+                         0x2E, 0xE6, 0x3A, 0xA3, 0x03, // 0
+                         0x74, 0x49, 0x12, // 1
+                         0x2E, 0x42, 0x44, 0xC4, 0x07, // 2
+                         0x2E, 0x42, 0x06, 0xA3, 0x03, // 3
+                         0x88, 0xA9, 0xF4, 0x11, 0x02, // 4
+                         0x3F, 0x3C, 0x08, 0xA3, 0x03, // 5
+                         0x2E, 0x86, 0x17, 0xA3, 0x03, // 6
+                         0x1F, 0x42, 0x44, 0x08, 0x01, // 7
+                         0x2E, 0x46, 0x17, 0xA3, 0x03, // 8
+                         0x2E, 0x46, 0x0F, 0xA3, 0x03, // 9
+                         0x3C, 0x0F, // :
+                         0x3C, 0x1B, // ;
+                         0x48, 0x12, 0x42, 0x08, // <
+                         0x00, 0x7C, 0xF0, 0x01, 0x00, // =
+                         0x21, 0x84, 0x24, 0x01, // >
+                         0x2E, 0x42, 0x44, 0x00, 0x01, // ?
+                         0x2E, 0xE6, 0xDA, 0x83, 0x07, // @
+                         0x2E, 0xC6, 0x1F, 0x63, 0x04, // A
+                         0x2F, 0xC6, 0x17, 0xE3, 0x03, // B
+                         0x2E, 0x86, 0x10, 0xA2, 0x03, // C
+                         0x2F, 0xC6, 0x18, 0xE3, 0x03, // D
+                         0x3F, 0x84, 0x17, 0xC2, 0x07, // E
+                         0x3F, 0x84, 0x17, 0x42, 0x00, // F
+                         0x2E, 0x86, 0x1C, 0xA3, 0x03, // G
+                         0x31, 0xC6, 0x1F, 0x63, 0x04, // H
+                         0x97, 0x24, 0x1D, // I
+                         0x10, 0x42, 0x18, 0xA3, 0x03, // J
+                         0x31, 0x95, 0x51, 0x52, 0x04, // K
+                         0x21, 0x84, 0x10, 0xC2, 0x07, // L
+                         0x71, 0xD7, 0x1A, 0x63, 0x04, // M
+                         0x71, 0xD6, 0x1C, 0x63, 0x04, // N
+                         0x2E, 0xC6, 0x18, 0xA3, 0x03, // O
+                         0x2F, 0xC6, 0x17, 0x42, 0x00, // P
+                         0x2E, 0xC6, 0x18, 0x1D, 0x04, // Q
+                         0x2F, 0xC6, 0x17, 0x63, 0x04, // R
+                         0x2E, 0x06, 0x07, 0xA3, 0x03, // S
+                         0x9F, 0x10, 0x42, 0x08, 0x01, // T
+                         0x31, 0xC6, 0x18, 0xA3, 0x03, // U
+                         0x31, 0xC6, 0x18, 0x15, 0x01, // V
+                         0x31, 0xC6, 0x58, 0x77, 0x04, // W
+                         0x51, 0x11, 0x42, 0x54, 0x04, // X
+                         0x31, 0x46, 0x45, 0x08, 0x01, // Y
+                         0x1F, 0x22, 0x22, 0xC2, 0x07, // Z
+                         0x57, 0x35, // [
+                         0x20, 0x08, 0x82, 0x20, 0x00, // '\'
+                         0xAB, 0x3A, // ]
+                         0x44, 0x45, 0x00, 0x00, 0x00, // ^
+                         0x00, 0x00, 0x00, 0xC0, 0x07, // _
+                         0x11, 0x01, 0x00, // `
+                         0x00, 0x38, 0xE8, 0xA3, 0x07, // a
+                         0x21, 0xBC, 0x18, 0xE3, 0x03, // b
+                         0x00, 0xF8, 0x10, 0x82, 0x07, // c
+                         0x10, 0xFA, 0x18, 0xA3, 0x07, // d
+                         0x00, 0xB8, 0xF8, 0x83, 0x03, // e
+                         0x98, 0x7C, 0x42, 0x08, 0x01, // f
+                         0x00, 0xF8, 0xE8, 0xA1, 0x03, // g
+                         0x21, 0xB4, 0x19, 0x63, 0x04, // h
+                         0xC2, 0x24, 0x1D, // i
+                         0x08, 0x8C, 0x98, 0x06, // j
+                         0x11, 0x59, 0x53, 0x09, // k
+                         0x93, 0x24, 0x1D, // l
+                         0x00, 0xAC, 0x5A, 0x6B, 0x05, // m
+                         0x00, 0xB4, 0x19, 0x63, 0x04, // n
+                         0x00, 0xB8, 0x18, 0xA3, 0x03, // o
+                         0x00, 0xBC, 0xF8, 0x42, 0x00, // p
+                         0x00, 0xF8, 0xE8, 0x21, 0x04, // q
+                         0x00, 0x3D, 0x11, 0x01, // r
+                         0x00, 0xB8, 0xE0, 0xE0, 0x03, // s
+                         0x84, 0x7C, 0x42, 0x08, 0x06, // t
+                         0x00, 0xC4, 0x18, 0xB3, 0x05, // u
+                         0x00, 0xC4, 0x18, 0x15, 0x01, // v
+                         0x00, 0xC4, 0x58, 0xAB, 0x02, // w
+                         0x00, 0x44, 0x45, 0x54, 0x04, // x
+                         0x00, 0xC4, 0xE8, 0xA1, 0x03, // y
+                         0x00, 0x7C, 0x44, 0xC4, 0x07, // z
+                         0x2C, 0x12, 0x22, 0x0C, // {
+                         0x7F, // |
+                         0x43, 0x84, 0x44, 0x03, // }
+                         0xA2, 0x22, 0x00, 0x00, 0x00 // ~
+};
+
+#endif /* __FONT_PROP5x7_H */
@@ -39,6 +39,19 @@ extern "C"
 #define MAX_HW_FULLCAN_OBJ 		64
 #define MAX_SW_FULLCAN_OBJ 		32
 
+/** Frames held per controller receive ring (must be a power of two) */
+#define CAN_RX_RING_SIZE		64
+#define CAN_RX_RING_MASK		(CAN_RX_RING_SIZE - 1)
+
+/** Free running timer stamping received frames, counts in microseconds */
+#define CAN_TSTAMP_TIM			LPC_TIM3
+#define CAN_TSTAMP_PCONP		CLKPWR_PCONP_PCTIM3
+#define CAN_TSTAMP_PCLK			CLKPWR_PCLKSEL_TIMER3
+#define CAN_TSTAMP_HZ			1000000
+
+/** Size of the acceptance filter RAM in words, LUT plus FullCAN objects */
+#define CAN_AF_RAM_WORDS		512
+
 /**
  * @}
  */
@@ -687,6 +700,25 @@ typedef struct {
 							*/
 } CAN_MSG_Type;
 
+/**
+ * @brief Received frame as queued by CAN_IRQHandler
+ */
+typedef struct {
+	CAN_MSG_Type Msg;		/**< Frame */
+	uint32_t TimeStamp;		/**< CAN_TSTAMP_TIM count when the ISR took the frame */
+	uint8_t FullCAN;		/**< 1 if read from the FullCAN object area */
+} CAN_RX_FRAME_Type;
+
+/**
+ * @brief CAN receive ring statistics
+ */
+typedef struct {
+	uint32_t Frames;		/**< Frames queued since CAN_Init() */
+	uint32_t HighWater;		/**< Maximum number of frames not yet dequeued */
+	uint32_t RingOverflow;	/**< Frames lost because the ring was full */
+	uint32_t DataOverrun;	/**< Frames lost by the controller (DOI) */
+} CAN_RX_STATS_Type;
+
 /**
  * @brief FullCAN Entry structure
  */
@@ -788,6 +820,16 @@ typedef struct {
 	uint8_t EFF_GPR_NumEntry;		/**< Group Extended ID Entry Number */
 } AF_SectionDef;
 
+/**
+ * @brief Acceptance filter ID for CAN_AFLoadTable() and CAN_AFUpdateTable()
+ */
+typedef struct {
+	uint8_t Type;			/**< Section, one of AFLUT_ENTRY_Type */
+	uint8_t Ctrl;			/**< CAN1_CTRL or CAN2_CTRL */
+	uint32_t LowerID;		/**< ID, or lower bound of a group */
+	uint32_t UpperID;		/**< Upper bound of a group, ignored otherwise */
+} CAN_AF_ID_Type;
+
 /**
  * @}
  */
@@ -815,6 +857,11 @@ Status CAN_SendMsg(LPC_CAN_TypeDef *CANx, CAN_MSG_Type *CAN_Msg);
 Status CAN_ReceiveMsg(LPC_CAN_TypeDef *CANx, CAN_MSG_Type *CAN_Msg);
 CAN_ERROR FCAN_ReadObj(LPC_CANAF_TypeDef* CANAFx, CAN_MSG_Type *CAN_Msg);
 
+/* CAN receive ring functions -------------*/
+uint32_t CAN_RxDequeue(uint8_t ctrl, CAN_RX_FRAME_Type *frames, uint32_t max);
+uint32_t CAN_RxPending(uint8_t ctrl);
+void CAN_GetRxStats(uint8_t ctrl, CAN_RX_STATS_Type *stats);
+
 /* CAN configure functions ---------------*/
 void CAN_ModeConfig(LPC_CAN_TypeDef* CANx, CAN_MODE_Type mode,
 		FunctionalState NewState);
@@ -829,6 +876,10 @@ CAN_ERROR CAN_LoadExplicitEntry(LPC_CAN_TypeDef* CANx, uint32_t ID,
 CAN_ERROR CAN_LoadGroupEntry(LPC_CAN_TypeDef* CANx, uint32_t lowerID,
 		uint32_t upperID, CAN_ID_FORMAT_Type format);
 CAN_ERROR CAN_RemoveEntry(AFLUT_ENTRY_Type EntryType, uint16_t position);
+CAN_ERROR CAN_AFLoadTable(CAN_AF_ID_Type *ids, uint16_t num);
+CAN_ERROR CAN_AFUpdateTable(CAN_AF_ID_Type *add, uint16_t numAdd,
+		CAN_AF_ID_Type *del, uint16_t numDel);
+uint16_t CAN_AFGetFreeWords(void);
 
 /* CAN interrupt functions -----------------*/
 void CAN_IRQCmd(LPC_CAN_TypeDef* CANx, CAN_INT_EN_Type arg, FunctionalState NewState);
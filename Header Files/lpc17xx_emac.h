@@ -19,6 +19,7 @@
 /* Includes ------------------------------------------------------------------- */
 #include "LPC17xx.h"
 #include "lpc_system_init.h"
+#include "lpc_crc.h"
 
 
 #ifdef __cplusplus
@@ -71,12 +72,26 @@ extern "C"
 #define MYMAC_5 	((EMAC_ADDR56 & 0xFF00) >> 8)
 #define MYMAC_6 	((EMAC_ADDR56 & 0xFF))
 
-/* Global Tx Buffer data */
-uint8_t __attribute__ ((aligned (4))) gTxBuf[TX_PACKET_SIZE + 0x10];
-/* Global Rx Buffer data */
-uint8_t __attribute__ ((aligned (4))) gRxBuf[TX_PACKET_SIZE + 0x10];
+/* Global Tx Buffer data, for PacketGen() */
+extern uint8_t gTxBuf[TX_PACKET_SIZE + 0x10];
+
+/** Bus address of a frame buffer for the descriptors, see GPDMA_BUS_ADDR() */
+#ifdef LPC_HOST_SIM
+extern uint32_t HOSTSIM_BusAddr(const void *ptr);
+#define EMAC_BUS_ADDR(ptr)		HOSTSIM_BusAddr(ptr)
+#else
+#define EMAC_BUS_ADDR(ptr)		((uint32_t)(ptr))
+#endif
+
+/* EMAC interrupt counters */
+extern __IO uint32_t RXOverrunCount, RXErrorCount, RxFinishedCount, RxDoneCount;
+extern __IO uint32_t TXUnderrunCount, TXErrorCount, TxFinishedCount, TxDoneCount;
+extern __IO Bool PacketReceived;
 
 
+/** Buffer number of a caller owned EMAC_PBUF_Type fragment */
+#define EMAC_PBUF_CALLER			(0xFF)
+
 /* EMAC PHY status type definitions */
 #define EMAC_PHY_STAT_LINK			(0)		/**< Link Status */
 #define EMAC_PHY_STAT_SPEED			(1)		/**< Speed Status */
@@ -99,11 +114,32 @@ uint8_t __attribute__ ((aligned (4))) gRxBuf[TX_PACKET_SIZE + 0x10];
 
 
 /* EMAC Memory Buffer configuration for 16K Ethernet RAM */
-#define EMAC_NUM_RX_FRAG         4           /**< Num.of RX Fragments 4*1536= 6.0kB */
-#define EMAC_NUM_TX_FRAG         3           /**< Num.of TX Fragments 3*1536= 4.6kB */
+#define EMAC_NUM_RX_FRAG         8           /**< Num.of RX Fragments 8*1536= 12kB  */
+#define EMAC_NUM_TX_FRAG         8           /**< Num.of TX Descriptors             */
+#define EMAC_NUM_TX_BUF          4           /**< Num.of TX Buffers 4*1536= 6.0kB   */
 #define EMAC_ETH_MAX_FLEN        1536        /**< Max. Ethernet Frame Size          */
 #define EMAC_TX_FRAME_TOUT       0x00100000  /**< Frame Transmit timeout count      */
 
+/* The EMAC DMA only reaches the AHB SRAM banks:
+ * bank 0 holds the RX ring, bank 1 the TX ring, the rest of bank 1 is free */
+#define EMAC_RX_DESC_BASE        (LPC_AHBRAM0_BASE)
+#define EMAC_RX_STAT_BASE        (EMAC_RX_DESC_BASE + EMAC_NUM_RX_FRAG*8)
+#define EMAC_RX_BUF_BASE         (EMAC_RX_STAT_BASE + EMAC_NUM_RX_FRAG*8)
+#define EMAC_TX_DESC_BASE        (LPC_AHBRAM1_BASE)
+#define EMAC_TX_STAT_BASE        (EMAC_TX_DESC_BASE + EMAC_NUM_TX_FRAG*8)
+#define EMAC_TX_BUF_BASE         (EMAC_TX_STAT_BASE + EMAC_NUM_TX_FRAG*4)
+#define EMAC_AHBRAM1_FREE        (EMAC_TX_BUF_BASE + EMAC_NUM_TX_BUF*EMAC_ETH_MAX_FLEN)
+
+#if ((EMAC_RX_BUF_BASE + EMAC_NUM_RX_FRAG*EMAC_ETH_MAX_FLEN) > (LPC_AHBRAM0_BASE + 0x4000))
+	#error EMAC RX buffers do not fit in AHB SRAM bank 0
+#endif
+#if (EMAC_AHBRAM1_FREE > (LPC_AHBRAM1_BASE + 0x4000))
+	#error EMAC TX buffers do not fit in AHB SRAM bank 1
+#endif
+#if (EMAC_NUM_TX_BUF > 8)
+	#error EMAC TX buffer count exceeds the ownership mask
+#endif
+
 /* --------------------- BIT DEFINITIONS -------------------------------------- */
 /*********************************************************************//**
  * Macro defines for MAC Configuration Register 1
@@ -573,6 +609,15 @@ typedef struct {
 	uint32_t *pbDataBuf;		/**< A word-align data pointer to data buffer */
 } EMAC_PACKETBUF_Type;
 
+/**
+ * @brief Zero-copy packet buffer, loaned by the driver or owned by the caller
+ */
+typedef struct {
+	uint8_t *pbData;			/**< Frame data inside AHB SRAM */
+	uint16_t ulDataLen;			/**< Data length (capacity after EMAC_TxClaim) */
+	uint8_t bIndex;				/**< Driver buffer number, EMAC_PBUF_CALLER if caller owned */
+} EMAC_PBUF_Type;
+
 /**
  * @brief EMAC configuration structure definition
  */
@@ -620,6 +665,14 @@ void EMAC_SetFilterMode(uint32_t ulFilterMode, FunctionalState NewState);
 void EMAC_WritePacketBuffer(EMAC_PACKETBUF_Type *pDataStruct);
 void EMAC_ReadPacketBuffer(EMAC_PACKETBUF_Type *pDataStruct);
 
+/* EMAC zero-copy buffer functions */
+Status EMAC_RxTake(EMAC_PBUF_Type *pbuf);
+void EMAC_RxRelease(EMAC_PBUF_Type *pbuf);
+Status EMAC_TxClaim(EMAC_PBUF_Type *pbuf);
+void EMAC_TxDiscard(EMAC_PBUF_Type *pbuf);
+Status EMAC_TxSend(EMAC_PBUF_Type *frag, uint8_t num);
+uint32_t EMAC_TxPending(void);
+
 /* EMAC Interrupt functions -------*/
 void EMAC_IntCmd(uint32_t ulIntType, FunctionalState NewState);
 IntStatus EMAC_IntGetStatus(uint32_t ulIntType);
@@ -0,0 +1,302 @@
+/******************************************************************//**
+* @file		lpc17xx_gpdma.h
+* @brief	Contains all macro definitions and function prototypes
+* 			support for GPDMA firmware library on LPC17xx
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @defgroup GPDMA GPDMA
+ * @ingroup LPC1700CMSIS_FwLib_Drivers
+ * @{
+ */
+
+#ifndef LPC17XX_GPDMA_H_
+#define LPC17XX_GPDMA_H_
+
+/* Includes ------------------------------------------------------------------- */
+#include "LPC17xx.h"
+#include "lpc_system_init.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Public Macros -------------------------------------------------------------- */
+/** @defgroup GPDMA_Public_Macros GPDMA Public Macros
+ * @{
+ */
+
+/** Number of GPDMA channels, channel 0 has the highest priority */
+#define GPDMA_NUM_CHANNELS		8
+/** Maximum transfer size of one linked list item (in transfer width units) */
+#define GPDMA_MAX_XFER			0xFFC
+
+/** Bus address of a memory buffer or linked list item. The host build
+ * maps memory above 4 GB into the 32 bit bus of the simulator. */
+#ifdef LPC_HOST_SIM
+extern uint32_t HOSTSIM_BusAddr(const void *ptr);
+#define GPDMA_BUS_ADDR(ptr)		HOSTSIM_BusAddr(ptr)
+#else
+#define GPDMA_BUS_ADDR(ptr)		((uint32_t)(ptr))
+#endif
+
+/** DMA connection number definitions */
+#define GPDMA_CONN_SSP0_Tx 			((0UL)) 		/**< SSP0 Tx */
+#define GPDMA_CONN_SSP0_Rx 			((1UL)) 		/**< SSP0 Rx */
+#define GPDMA_CONN_SSP1_Tx 			((2UL)) 		/**< SSP1 Tx */
+#define GPDMA_CONN_SSP1_Rx 			((3UL)) 		/**< SSP1 Rx */
+#define GPDMA_CONN_ADC 				((4UL)) 		/**< ADC */
+#define GPDMA_CONN_I2S_Channel_0 	((5UL)) 		/**< I2S channel 0 */
+#define GPDMA_CONN_I2S_Channel_1 	((6UL)) 		/**< I2S channel 1 */
+#define GPDMA_CONN_DAC 				((7UL)) 		/**< DAC */
+#define GPDMA_CONN_UART0_Tx			((8UL)) 		/**< UART0 Tx */
+#define GPDMA_CONN_UART0_Rx			((9UL)) 		/**< UART0 Rx */
+#define GPDMA_CONN_UART1_Tx			((10UL)) 		/**< UART1 Tx */
+#define GPDMA_CONN_UART1_Rx			((11UL)) 		/**< UART1 Rx */
+#define GPDMA_CONN_UART2_Tx			((12UL)) 		/**< UART2 Tx */
+#define GPDMA_CONN_UART2_Rx			((13UL)) 		/**< UART2 Rx */
+#define GPDMA_CONN_UART3_Tx			((14UL)) 		/**< UART3 Tx */
+#define GPDMA_CONN_UART3_Rx			((15UL)) 		/**< UART3 Rx */
+#define GPDMA_CONN_MAT0_0 			((16UL)) 		/**< MAT0.0 */
+#define GPDMA_CONN_MAT0_1 			((17UL)) 		/**< MAT0.1 */
+#define GPDMA_CONN_MAT1_0 			((18UL)) 		/**< MAT1.0 */
+#define GPDMA_CONN_MAT1_1   		((19UL)) 		/**< MAT1.1 */
+#define GPDMA_CONN_MAT2_0   		((20UL)) 		/**< MAT2.0 */
+#define GPDMA_CONN_MAT2_1   		((21UL)) 		/**< MAT2.1 */
+#define GPDMA_CONN_MAT3_0 			((22UL)) 		/**< MAT3.0 */
+#define GPDMA_CONN_MAT3_1   		((23UL)) 		/**< MAT3.1 */
+
+/** GPDMA Transfer type definitions */
+#define GPDMA_TRANSFERTYPE_M2M 		((0UL))		/**< Memory to memory - DMA control */
+#define GPDMA_TRANSFERTYPE_M2P 		((1UL))		/**< Memory to peripheral - DMA control */
+#define GPDMA_TRANSFERTYPE_P2M 		((2UL))		/**< Peripheral to memory - DMA control */
+#define GPDMA_TRANSFERTYPE_P2P 		((3UL))		/**< Source peripheral to destination peripheral - DMA control */
+
+/** Burst size in Source and Destination definitions */
+#define GPDMA_BSIZE_1 	((0UL)) /**< Burst size = 1 */
+#define GPDMA_BSIZE_4 	((1UL)) /**< Burst size = 4 */
+#define GPDMA_BSIZE_8 	((2UL)) /**< Burst size = 8 */
+#define GPDMA_BSIZE_16 	((3UL)) /**< Burst size = 16 */
+#define GPDMA_BSIZE_32 	((4UL)) /**< Burst size = 32 */
+#define GPDMA_BSIZE_64 	((5UL)) /**< Burst size = 64 */
+#define GPDMA_BSIZE_128 ((6UL)) /**< Burst size = 128 */
+#define GPDMA_BSIZE_256 ((7UL)) /**< Burst size = 256 */
+
+/** Width in Source transfer width and Destination transfer width definitions */
+#define GPDMA_WIDTH_BYTE 		((0UL)) /**< Width = 1 byte */
+#define GPDMA_WIDTH_HALFWORD 	((1UL)) /**< Width = 2 bytes */
+#define GPDMA_WIDTH_WORD 		((2UL)) /**< Width = 4 bytes */
+
+/** Transfer options */
+#define GPDMA_OPT_SRC_FIXED		((1UL<<0))	/**< Do not increment the memory source (fill) */
+#define GPDMA_OPT_DST_FIXED		((1UL<<1))	/**< Do not increment the memory destination (drain) */
+#define GPDMA_OPT_CIRCULAR		((1UL<<2))	/**< Link the last item back to the first one */
+
+/**
+ * @}
+ */
+
+/* Private Macros ------------------------------------------------------------- */
+/** @defgroup GPDMA_Private_Macros GPDMA Private Macros
+ * @{
+ */
+
+/* --------------------- BIT DEFINITIONS -------------------------------------- */
+/*********************************************************************//**
+ * Macro defines for DMA Interrupt Status register
+ **********************************************************************/
+#define GPDMA_DMACIntStat_Ch(n)			(((1UL<<n)&0xFF))
+#define GPDMA_DMACIntStat_BITMASK		((0xFF))
+
+/*********************************************************************//**
+ * Macro defines for DMA Configuration register
+ **********************************************************************/
+#define GPDMA_DMACConfig_E				((0x01))	 /**< DMA Controller enable*/
+#define GPDMA_DMACConfig_M				((0x02))	 /**< AHB Master endianness configuration*/
+#define GPDMA_DMACConfig_BITMASK		((0x03))
+
+/*********************************************************************//**
+ * Macro defines for DMA Channel Linked List Item registers
+ **********************************************************************/
+/** DMA Channel Linked List Item registers bit mask*/
+#define GPDMA_DMACCxLLI_BITMASK 		((0xFFFFFFFC))
+
+/*********************************************************************//**
+ * Macro defines for DMA channel control registers
+ **********************************************************************/
+#define GPDMA_DMACCxControl_TransferSize(n) (((n&0xFFF)<<0))	/**< Transfer size*/
+#define GPDMA_DMACCxControl_SBSize(n)		(((n&0x07)<<12))	/**< Source burst size*/
+#define GPDMA_DMACCxControl_DBSize(n)		(((n&0x07)<<15))	/**< Destination burst size*/
+#define GPDMA_DMACCxControl_SWidth(n)		(((n&0x07)<<18))	/**< Source transfer width*/
+#define GPDMA_DMACCxControl_DWidth(n)		(((n&0x07)<<21))	/**< Destination transfer width*/
+#define GPDMA_DMACCxControl_SI				((1UL<<26))			/**< Source increment*/
+#define GPDMA_DMACCxControl_DI				((1UL<<27))			/**< Destination increment*/
+#define GPDMA_DMACCxControl_Prot1			((1UL<<28))			/**< Privileged mode */
+#define GPDMA_DMACCxControl_Prot2			((1UL<<29))			/**< Bufferable */
+#define GPDMA_DMACCxControl_Prot3			((1UL<<30))			/**< Cacheable */
+#define GPDMA_DMACCxControl_I				((1UL<<31))			/**< Terminal count interrupt enable bit */
+#define GPDMA_DMACCxControl_BITMASK			((0xFCFFFFFF))
+
+/*********************************************************************//**
+ * Macro defines for DMA Channel Configuration registers
+ **********************************************************************/
+#define GPDMA_DMACCxConfig_E 					((1UL<<0))			/**< DMA control enable*/
+#define GPDMA_DMACCxConfig_SrcPeripheral(n) 	(((n&0x1F)<<1))		/**< Source peripheral*/
+#define GPDMA_DMACCxConfig_DestPeripheral(n) 	(((n&0x1F)<<6))		/**< Destination peripheral*/
+#define GPDMA_DMACCxConfig_TransferType(n) 		(((n&0x7)<<11))		/**< This value indicates the type of transfer*/
+#define GPDMA_DMACCxConfig_IE 					((1UL<<14))			/**< Interrupt error mask*/
+#define GPDMA_DMACCxConfig_ITC 					((1UL<<15))			/**< Terminal count interrupt mask*/
+#define GPDMA_DMACCxConfig_L 					((1UL<<16))			/**< Lock*/
+#define GPDMA_DMACCxConfig_A 					((1UL<<17))			/**< Active*/
+#define GPDMA_DMACCxConfig_H 					((1UL<<18))			/**< Halt*/
+#define GPDMA_DMACCxConfig_BITMASK				((0x7FFFF))
+
+/** Macro to check GPDMA channel */
+#define PARAM_GPDMA_CHANNEL(n)	((n>=0) && (n<=7))
+
+/** Macro to check GPDMA connection */
+#define PARAM_GPDMA_CONN(n)		((n<=GPDMA_CONN_MAT3_1))
+
+/** Macro to check GPDMA transfer type */
+#define PARAM_GPDMA_TRANSFERTYPE(n) ((n==GPDMA_TRANSFERTYPE_M2M)||(n==GPDMA_TRANSFERTYPE_M2P) \
+||(n==GPDMA_TRANSFERTYPE_P2M)||(n==GPDMA_TRANSFERTYPE_P2P))
+
+/** Macro to check GPDMA width */
+#define PARAM_GPDMA_WIDTH(n)	((n==GPDMA_WIDTH_BYTE)||(n==GPDMA_WIDTH_HALFWORD) \
+||(n==GPDMA_WIDTH_WORD))
+
+/** Macro to check GPDMA status type */
+#define PARAM_GPDMA_STAT(n)	((n==GPDMA_STAT_INT) || (n==GPDMA_STAT_INTTC) \
+|| (n==GPDMA_STAT_INTERR) || (n==GPDMA_STAT_RAWINTTC) \
+|| (n==GPDMA_STAT_RAWINTERR) || (n==GPDMA_STAT_ENABLED_CH))
+
+/** Macro to check GPDMA interrupt clear type */
+#define PARAM_GPDMA_STATCLR(n)	((n==GPDMA_STATCLR_INTTC) || (n==GPDMA_STATCLR_INTERR))
+
+/**
+ * @}
+ */
+
+/* Public Types --------------------------------------------------------------- */
+/** @defgroup GPDMA_Public_Types GPDMA Public Types
+ * @{
+ */
+
+/**
+ * @brief GPDMA Status enumeration
+ */
+typedef enum {
+	GPDMA_STAT_INT,			/**< GP DMA status interrupt */
+	GPDMA_STAT_INTTC,		/**< GP DMA terminal count interrupt status */
+	GPDMA_STAT_INTERR,		/**< GP DMA error interrupt status */
+	GPDMA_STAT_RAWINTTC,	/**< GP DMA raw terminal count interrupt status */
+	GPDMA_STAT_RAWINTERR,	/**< GP DMA raw error interrupt status */
+	GPDMA_STAT_ENABLED_CH	/**< GP DMA enabled channel status */
+} GPDMA_Status_Type;
+
+/**
+ * @brief GPDMA Interrupt clear status enumeration
+ */
+typedef enum{
+	GPDMA_STATCLR_INTTC,	/**< GP DMA Interrupt Terminal Count Request Clear */
+	GPDMA_STATCLR_INTERR	/**< GP DMA Interrupt Error Clear */
+}GPDMA_StateClear_Type;
+
+/**
+ * @brief Transfer descriptor structure typedef, the layout is the one
+ * fetched by the GPDMA channel from memory (must be word aligned)
+ */
+typedef struct {
+	uint32_t SrcAddr;	/**< Source Address */
+	uint32_t DstAddr;	/**< Destination address */
+	uint32_t NextLLI;	/**< Next LLI address, otherwise set to '0' */
+	uint32_t Control;	/**< GPDMA Control of this LLI */
+} GPDMA_LLI_Type;
+
+/**
+ * @brief Completion callback, Status is GPDMA_STAT_INTTC for a terminal
+ * count and GPDMA_STAT_INTERR for a bus error
+ */
+typedef void (*GPDMA_CALLBACK_Type)(uint32_t ChannelNum, GPDMA_Status_Type Status);
+
+/**
+ * @brief GPDMA Channel configuration structure type definition
+ */
+typedef struct {
+	uint32_t ChannelNum;	/**< DMA channel number, should be in
+								range from 0 to 7 */
+	uint32_t TransferSize;	/**< Length of transfer in TransferWidth units.
+								Chained transfers (GPDMA_SetupChain) may
+								exceed GPDMA_MAX_XFER */
+	uint32_t TransferWidth;	/**< Transfer width - used for memory to memory
+								transfer only, should be:
+								- GPDMA_WIDTH_BYTE
+								- GPDMA_WIDTH_HALFWORD
+								- GPDMA_WIDTH_WORD */
+	uint32_t SrcMemAddr;	/**< Physical Source Address (GPDMA_BUS_ADDR()),
+								used in case TransferType is M2M or M2P */
+	uint32_t DstMemAddr;	/**< Physical Destination Address (GPDMA_BUS_ADDR()),
+								used in case TransferType is M2M or P2M */
+	uint32_t TransferType;	/**< Transfer Type, should be:
+								- GPDMA_TRANSFERTYPE_M2M
+								- GPDMA_TRANSFERTYPE_M2P
+								- GPDMA_TRANSFERTYPE_P2M
+								- GPDMA_TRANSFERTYPE_P2P */
+	uint32_t SrcConn;		/**< Peripheral Source Connection, one of the
+								GPDMA_CONN_xxx, used in case TransferType is
+								P2M or P2P */
+	uint32_t DstConn;		/**< Peripheral Destination Connection, one of the
+								GPDMA_CONN_xxx, used in case TransferType is
+								M2P or P2P */
+	uint32_t DMALLI;		/**< Linked List Item structure for the next
+								transfer, otherwise set to '0' */
+	uint32_t Options;		/**< Or'ed GPDMA_OPT_xxx, otherwise set to '0' */
+	GPDMA_CALLBACK_Type Callback;	/**< Called from DMA_IRQHandler on
+								completion or error, may be NULL */
+} GPDMA_Channel_CFG_Type;
+
+/**
+ * @}
+ */
+
+/* Public Functions ----------------------------------------------------------- */
+/** @defgroup GPDMA_Public_Functions GPDMA Public Functions
+ * @{
+ */
+
+void GPDMA_Init(void);
+int32_t GPDMA_AllocChannel(void);
+void GPDMA_FreeChannel(uint32_t ChannelNum);
+Status GPDMA_Setup(GPDMA_Channel_CFG_Type *GPDMAChannelConfig);
+Status GPDMA_SetupChain(GPDMA_Channel_CFG_Type *GPDMAChannelConfig, GPDMA_LLI_Type *LLIList, uint32_t LLINum);
+Status GPDMA_SetupRing(GPDMA_Channel_CFG_Type *GPDMAChannelConfig, GPDMA_LLI_Type *LLIList, uint32_t LLINum);
+uint32_t GPDMA_ChainLength(uint32_t TransferSize);
+void GPDMA_ChannelCmd(uint8_t channelNum, FunctionalState NewState);
+uint32_t GPDMA_GetTransferCount(uint8_t channelNum);
+uint32_t GPDMA_GetDestAddr(uint8_t channelNum);
+uint32_t GPDMA_GetSrcAddr(uint8_t channelNum);
+IntStatus GPDMA_IntGetStatus(GPDMA_Status_Type type, uint8_t channel);
+void GPDMA_ClearIntPending(GPDMA_StateClear_Type type, uint8_t channel);
+void DMA_IRQHandler (void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif /* LPC17XX_GPDMA_H_ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -93,6 +93,11 @@ typedef struct {
 	__O  uint16_t FIOCLRU;		/**< FIO clear register upper halfword part */
 } GPIO_HalfWord_TypeDef;
 
+/**
+ * @brief GPIO interrupt callback, called from EINT3_IRQHandler
+ */
+typedef void (*GPIO_INT_CB_Type)(void);
+
 /**
  * @}
  */
@@ -111,6 +116,7 @@ uint32_t GPIO_ReadValue(uint8_t portNum);
 void GPIO_IntCmd(uint8_t portNum, uint32_t bitValue, uint8_t edgeState);
 FunctionalState GPIO_GetIntStatus(uint8_t portNum, uint32_t pinNum, uint8_t edgeState);
 void GPIO_ClearInt(uint8_t portNum, uint32_t bitValue);
+void GPIO_SetIntCallback(GPIO_INT_CB_Type cb);
 
 /* FIO (word-accessible) style ------------------------------- */
 void FIO_SetDir(uint8_t portNum, uint32_t bitValue, uint8_t dir);
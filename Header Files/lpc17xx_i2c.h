@@ -38,13 +38,22 @@ extern "C"
 #define BUFFER_SIZE			  64
 
 #if (I2C_DATABIT_SIZE == 8)
-uint8_t I2C_Tx_Buf[BUFFER_SIZE];
-uint8_t I2C_Rx_Buf[BUFFER_SIZE];
+extern uint8_t I2C_Tx_Buf[BUFFER_SIZE];
+extern uint8_t I2C_Rx_Buf[BUFFER_SIZE];
 #else
-uint16_t I2C_Tx_Buf[BUFFER_SIZE];
-uint16_t I2C_Rx_Buf[BUFFER_SIZE];
+extern uint16_t I2C_Tx_Buf[BUFFER_SIZE];
+extern uint16_t I2C_Rx_Buf[BUFFER_SIZE];
 #endif
 
+/** I2C_QueueTick() calls without bus progress before the interface is
+ * reset, the queue runs the tick from a 1 ms SCHED timer per bus */
+#define I2C_QUEUE_TIMEOUT	  20
+
+/** Queued transaction priorities, lower is served first */
+#define I2C_PRIO_HIGH		  0
+#define I2C_PRIO_NORMAL		  1
+#define I2C_PRIO_LOW		  2
+
 
 /**
  * @}
@@ -89,6 +98,9 @@ uint16_t I2C_Rx_Buf[BUFFER_SIZE];
 /** No relevant information */
 #define I2C_I2STAT_NO_INF						((0xF8))
 
+/** Illegal START or STOP on the bus */
+#define I2C_I2STAT_BUS_ERROR					((0x00))
+
 /* Master transmit mode -------------------------------------------- */
 /** A start condition has been transmitted */
 #define I2C_I2STAT_M_TX_START					((0x08))
@@ -230,6 +242,7 @@ uint16_t I2C_Rx_Buf[BUFFER_SIZE];
 #define I2C_SETUP_STATUS_ARBF   (1<<8)	/**< Arbitration false */
 #define I2C_SETUP_STATUS_NOACKF (1<<9)	/**< No ACK returned */
 #define I2C_SETUP_STATUS_DONE   (1<<10)	/**< Status DONE */
+#define I2C_SETUP_STATUS_TIMEOUT (1<<11)	/**< Bus stuck, interface reset */
 
 /*********************************************************************//**
  * I2C monitor control configuration defines
@@ -331,6 +344,46 @@ typedef enum {
 	I2C_TRANSFER_INTERRUPT			/**< Transfer in interrupt mode */
 } I2C_TRANSFER_OPT_Type;
 
+/**
+ * @brief Queued transaction state
+ */
+typedef enum {
+	I2C_XFER_IDLE = 0,				/**< Never submitted */
+	I2C_XFER_QUEUED,				/**< Waiting for the bus */
+	I2C_XFER_BUSY,					/**< On the bus */
+	I2C_XFER_DONE,					/**< Completed */
+	I2C_XFER_FAILED					/**< Retries used up, see status */
+} I2C_XFER_STATE_Type;
+
+typedef struct I2C_XFER_Tag I2C_XFER_Type;
+
+/** Completion callback, called from the I2C interrupt */
+typedef void (*I2C_XFER_CB_Type)(I2C_XFER_Type *xfer);
+
+/**
+ * @brief Transaction descriptor for I2C_QueueSubmit(): write tx_data,
+ * then read rx_data, either part may be empty. The descriptor and both
+ * buffers must stay valid until the callback.
+ */
+struct I2C_XFER_Tag
+{
+  uint8_t           sl_addr7bit;				/**< Slave address in 7bit mode */
+  uint8_t           priority;					/**< I2C_PRIO_xxx, FIFO within one priority */
+  uint8_t           retries;					/**< Re-transmissions on NACK, lost
+													  arbitration, bus error or time out */
+  uint8_t           restart;					/**< TRUE: repeated start between write
+													  and read, FALSE: stop then start */
+  uint8_t*          tx_data;					/**< Data to write */
+  uint32_t          tx_length;					/**< Write length, 0 for read only */
+  uint8_t*          rx_data;					/**< Buffer for read data */
+  uint32_t          rx_length;					/**< Read length, 0 for write only */
+  I2C_XFER_CB_Type  callback;					/**< Called when done or failed, NULL for none */
+  void*             arg;						/**< Free for the caller */
+  __IO uint8_t      state;						/**< I2C_XFER_STATE_Type */
+  uint32_t          status;						/**< Last status, as I2C_M_SETUP_Type */
+  I2C_XFER_Type*    next;						/**< Queue link, used by the driver */
+};
+
 
 /**
  * @}
@@ -373,6 +426,12 @@ void I2C_IntCmd (LPC_I2C_TypeDef *I2Cx, Bool NewState);
 void I2C_MasterHandler (LPC_I2C_TypeDef *I2Cx);
 void I2C_SlaveHandler (LPC_I2C_TypeDef *I2Cx);
 
+/* I2C transaction queue functions -----*/
+Status I2C_QueueSubmit (LPC_I2C_TypeDef *I2Cx, I2C_XFER_Type *xfer);
+Status I2C_QueueCancel (LPC_I2C_TypeDef *I2Cx, I2C_XFER_Type *xfer);
+uint32_t I2C_QueuePending (LPC_I2C_TypeDef *I2Cx);
+void I2C_QueueTick (LPC_I2C_TypeDef *I2Cx);
+
 
 /**
  * @}
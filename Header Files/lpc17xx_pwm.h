@@ -249,7 +249,7 @@ typedef enum {
 #define PARAM_PWM_CHANNEL_EDGE(n)	((n==PWM_CHANNEL_SINGLE_EDGE) || (n==PWM_CHANNEL_DUAL_EDGE))
 
 
-/** @brief PWM update type */
+/** @brief PWM update type, deprecated, both latch at the next MR0 */
 typedef enum {
 	PWM_MATCH_UPDATE_NOW = 0,			/**< PWM Match Channel Update Now */
 	PWM_MATCH_UPDATE_NEXT_RST			/**< PWM Match Channel Update on next
@@ -286,8 +286,8 @@ typedef enum
 	PWM_INTSTAT_CAP0 = PWM_IR_PWMCAPn(0),	/**< Interrupt flag for capture input 0 */
 	PWM_INTSTAT_CAP1 = PWM_IR_PWMCAPn(1),	/**< Interrupt flag for capture input 1 */
 	PWM_INTSTAT_MR4 = PWM_IR_PWMMRn(4),		/**< Interrupt flag for PWM match channel 4 */
-	PWM_INTSTAT_MR6 = PWM_IR_PWMMRn(5),		/**< Interrupt flag for PWM match channel 5 */
-	PWM_INTSTAT_MR5 = PWM_IR_PWMMRn(6)		/**< Interrupt flag for PWM match channel 6 */
+	PWM_INTSTAT_MR5 = PWM_IR_PWMMRn(5),		/**< Interrupt flag for PWM match channel 5 */
+	PWM_INTSTAT_MR6 = PWM_IR_PWMMRn(6)		/**< Interrupt flag for PWM match channel 6 */
 }PWM_INTSTAT_TYPE;
 
 /** @brief Match update structure */
@@ -322,6 +322,7 @@ void PWM_ConfigCapture(LPC_PWM_TypeDef *PWMx, PWM_CAPTURECFG_Type *PWM_CaptureCo
 uint32_t PWM_GetCaptureValue(LPC_PWM_TypeDef *PWMx, uint8_t CaptureChannel);
 void PWM_MatchUpdate(LPC_PWM_TypeDef *PWMx, uint8_t MatchChannel, \
 					uint32_t MatchValue, uint8_t UpdateType);
+void PWM_MultiMatchUpdate(LPC_PWM_TypeDef *PWMx, PWM_Match_T *MatchStruct , uint8_t UpdateType);
 void PWM_ChannelConfig(LPC_PWM_TypeDef *PWMx, uint8_t PWMChannel, uint8_t ModeOption);
 void PWM_ChannelCmd(LPC_PWM_TypeDef *PWMx, uint8_t PWMChannel, FunctionalState NewState);
 
@@ -37,11 +37,11 @@ extern "C"
 #define BUFFER_SIZE			  64
 
 #if (SPI_DATABIT_SIZE == 8)
-uint8_t Tx_Buf[BUFFER_SIZE];
-uint8_t Rx_Buf[BUFFER_SIZE];
+extern uint8_t Tx_Buf[BUFFER_SIZE];
+extern uint8_t Rx_Buf[BUFFER_SIZE];
 #else
-uint16_t Tx_Buf[BUFFER_SIZE];
-uint16_t Rx_Buf[BUFFER_SIZE];
+extern uint16_t Tx_Buf[BUFFER_SIZE];
+extern uint16_t Rx_Buf[BUFFER_SIZE];
 #endif
 
 /*********************************************************************//**
@@ -282,7 +282,7 @@ typedef struct {
 
 /* SPI Init/DeInit functions ---------*/
 void CS_Force (FunctionalState state);
-void Buffer_Init (void);
+void SPI_Buffer_Init (void);
 void SPI_Config (LPC_SPI_TypeDef *SPIx);
 void SPI_Init(LPC_SPI_TypeDef *SPIx, SPI_CFG_Type *SPI_ConfigStruct);
 void SPI_DeInit(LPC_SPI_TypeDef *SPIx);
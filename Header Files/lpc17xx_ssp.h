@@ -38,11 +38,11 @@ extern "C"
 #define BUFFER_SIZE1			  64
 
 #if (SSP_DATABIT_SIZE == 8)
-uint8_t Tx_Buf1[BUFFER_SIZE1];
-uint8_t Rx_Buf1[BUFFER_SIZE1];
+extern uint8_t Tx_Buf1[BUFFER_SIZE1];
+extern uint8_t Rx_Buf1[BUFFER_SIZE1];
 #else
-uint16_t Tx_Buf1[BUFFER_SIZE1];
-uint16_t Rx_Buf1[BUFFER_SIZE1];
+extern uint16_t Tx_Buf1[BUFFER_SIZE1];
+extern uint16_t Rx_Buf1[BUFFER_SIZE1];
 #endif
 
 
@@ -19,6 +19,7 @@
 /* Includes ------------------------------------------------------------------- */
 #include "lpc_system_init.h"
 #include "stdarg.h"
+#include "lpc_fmt.h"
 
 
 #ifdef __cplusplus
@@ -94,24 +95,32 @@ extern "C"
 /******************************************************************************/
 /*                       UART Buffer Definition                               */
 /******************************************************************************/
-/* buffer size definition */
+/* buffer size definition (must be a power of two) */
 #define UART_RING_BUFSIZE 256
 
+/* Ring indices are free running, only the slot access is masked */
 /* Buf mask */
 #define __BUF_MASK (UART_RING_BUFSIZE-1)
+/* Number of bytes queued */
+#define __BUF_COUNT(head, tail) ((uint32_t)((head)-(tail)))
 /* Check buf is full or not */
-#define __BUF_IS_FULL(head, tail) ((tail&__BUF_MASK)==((head+1)&__BUF_MASK))
-/* Check buf will be full in next receiving or not */
-#define __BUF_WILL_FULL(head, tail) ((tail&__BUF_MASK)==((head+2)&__BUF_MASK))
+#define __BUF_IS_FULL(head, tail) (__BUF_COUNT(head, tail)>=UART_RING_BUFSIZE)
 /* Check buf is empty */
-#define __BUF_IS_EMPTY(head, tail) ((head&__BUF_MASK)==(tail&__BUF_MASK))
+#define __BUF_IS_EMPTY(head, tail) ((head)==(tail))
 /* Reset buf */
 #define __BUF_RESET(bufidx)	(bufidx=0)
-#define __BUF_INCR(bufidx)	(bufidx=(bufidx+1)&__BUF_MASK)
+#define __BUF_INCR(bufidx)	(bufidx=(bufidx+1))
 
 /************************** BUFFER TYPES *************************/
 
-/** @brief UART Ring buffer structure */
+/**
+ * @brief UART Ring buffer structure
+ *
+ * Single producer / single consumer: tx_head and rx_tail are only written
+ * by the application, tx_tail and rx_head only by the UART interrupt. The
+ * OVERWRITE overflow policy is the one exception, it moves the opposite
+ * index inside a critical section.
+ */
 typedef struct
 {
     __IO uint32_t tx_head;                /*!< UART Tx ring buffer head index */
@@ -128,15 +137,12 @@ typedef struct
  */
 
 extern uint16 EscFlag;
-Bool UART0_RxReady,UART2_RxReady;
-extern uchar TTrgLvlU0,TrgLvlU2;
+extern Bool UART0_RxReady,UART2_RxReady;
+extern uchar TrgLvlU0,TrgLvlU2;
 // UART Ring buffer
 
-UART_RING_BUFFER_T rb0;
-UART_RING_BUFFER_T rb2;
-
-// Current Tx Interrupt enable state
-__IO FlagStatus TxIntStat;
+extern UART_RING_BUFFER_T rb0;
+extern UART_RING_BUFFER_T rb2;
 
 #ifdef AB_MODE
 /* Synchronous Flag */
@@ -631,6 +637,27 @@ typedef struct {
 										*/
 } UART_FIFO_CFG_Type;
 
+/**
+ * @brief UART ring buffer overflow policy
+ */
+typedef enum {
+	UART_OVERFLOW_DROP = 0,		/*!< Discard the new data */
+	UART_OVERFLOW_BLOCK,		/*!< Tx: wait for room, Rx: hold data in the FIFO */
+	UART_OVERFLOW_OVERWRITE		/*!< Discard the oldest data in the ring */
+} UART_OVERFLOW_Type;
+
+/**
+ * @brief UART ring buffer statistics
+ */
+typedef struct {
+	uint32_t TxHighWater;		/*!< Maximum number of bytes queued for transmission */
+	uint32_t RxHighWater;		/*!< Maximum number of received bytes not yet read */
+	uint32_t TxOverflow;		/*!< Tx bytes lost by the DROP or OVERWRITE policy */
+	uint32_t RxOverflow;		/*!< Rx bytes lost by the DROP or OVERWRITE policy */
+	uint32_t RxErrors;			/*!< Line status errors (OE, PE, FE, BI) */
+	uint32_t TxBursts;			/*!< THR bursts written (up to UART_TX_FIFO_SIZE bytes each) */
+} UART_RING_STATS_Type;
+
 /********************************************************************//**
 * @brief UART1 Full modem -  RS485 Control configuration type
 **********************************************************************/
@@ -735,6 +762,11 @@ void UART_IrDAPulseDivConfig(LPC_UART_TypeDef *UARTx, UART_IrDA_PULSE_Type Pulse
 uint32_t UART_Send(LPC_UART_TypeDef *UARTx, uint8_t *txbuf,
 		uint32_t buflen, TRANSFER_BLOCK_Type flag);
 uint32_t UART_Receive(LPC_UART_TypeDef *UARTx, uint8_t *rxbuf,uint32_t buflen, TRANSFER_BLOCK_Type flag);
+void UART_SetOverflowPolicy(LPC_UART_TypeDef *UARTx, UART_OVERFLOW_Type TxPolicy, \
+				UART_OVERFLOW_Type RxPolicy);
+void UART_GetRingStats(LPC_UART_TypeDef *UARTx, UART_RING_STATS_Type *Stats);
+void UART_ResetRingStats(LPC_UART_TypeDef *UARTx);
+void UART_TxFlush(LPC_UART_TypeDef *UARTx);
 #endif
 
 /* UART VT100 Terminal functions--------------------------------------------------------*/
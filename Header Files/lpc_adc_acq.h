@@ -0,0 +1,146 @@
+/******************************************************************//**
+* @file		lpc_adc_acq.h
+* @brief	Contains all macro definitions and function prototypes
+* 			support for the continuous ADC acquisition engine with
+* 			DMA ring buffers and decimation filters
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @defgroup ACQ ACQ
+ * @ingroup LPC1700CMSIS_FwLib_Drivers
+ * @{
+ */
+
+#ifndef LPC_ADC_ACQ_H_
+#define LPC_ADC_ACQ_H_
+
+/* Includes ------------------------------------------------------------------- */
+#include "LPC17xx.h"
+#include "lpc_types.h"
+#include "lpc17xx_adc.h"
+#include "lpc17xx_gpdma.h"
+#include "lpc17xx_timer.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Public Macros -------------------------------------------------------------- */
+/** @defgroup ACQ_Public_Macros ACQ Public Macros
+ * @{
+ */
+
+/** Highest conversion rate of the ADC, all channels together */
+#define ACQ_MAX_RATE		200000
+/** Conversions per DMA half buffer, the filters run once per half */
+#define ACQ_DMA_HALF		64
+/** Filtered samples buffered per channel (power of two), two half
+ * buffers of a single undecimated channel */
+#define ACQ_OUT_SIZE		128
+/** CIC filter order and largest decimation shift, the decimation
+ * is 1 << CicShift */
+#define ACQ_CIC_ORDER		3
+#define ACQ_CIC_SHIFT_MAX	6
+/** Longest FIR filter */
+#define ACQ_FIR_MAX_TAPS	32
+
+/** Filtered samples are 12.4 fixed point: the 12-bit ADC scale in
+ * bits 15..4 and four fraction bits gained by the filters */
+#define ACQ_FRAC_BITS		4
+
+/**
+ * @}
+ */
+
+
+/* Public Types --------------------------------------------------------------- */
+/** @defgroup ACQ_Public_Types ACQ Public Types
+ * @{
+ */
+
+/**
+ * @brief Conversion start source
+ */
+typedef enum
+{
+	ACQ_TRIG_BURST = 0,			/*!< ADC burst mode, all channels of the mask in turn */
+	ACQ_TRIG_MAT01				/*!< One conversion per rising edge of MAT0.1,
+									 single channel only, Timer0 is taken over */
+} ACQ_TRIG_Type;
+
+/**
+ * @brief Acquisition configuration
+ */
+typedef struct {
+	uint8_t ChannelMask;		/**< AD0.n channels to sample, bit n for AD0.n */
+	uint8_t Trigger;			/**< ACQ_TRIG_xxx */
+	uint8_t CicShift;			/**< CIC decimation by 1 << CicShift, 0 bypasses the CIC */
+	uint8_t FirTaps;			/**< FIR length up to ACQ_FIR_MAX_TAPS, 0 bypasses the FIR */
+	uint8_t FirDecim;			/**< Keep every FirDecim-th FIR output, 0 or 1 keeps all */
+	const int16_t *FirCoef;		/**< Q15 coefficients, FirCoef[0] weights the newest sample */
+	uint32_t Rate;				/**< Conversions per second: all channels together in
+									 burst mode, up to ACQ_MAX_RATE */
+} ACQ_CFG_Type;
+
+/**
+ * @brief Running statistics of the raw conversions of one channel
+ */
+typedef struct {
+	uint32_t Count;				/**< Conversions accumulated */
+	uint16_t Min;				/**< Smallest 12-bit result */
+	uint16_t Max;				/**< Largest 12-bit result */
+	uint16_t Mean;				/**< Mean in 12.4 fixed point */
+	uint16_t Rms;				/**< Root mean square in 12.4 fixed point */
+} ACQ_CHAN_STATS_Type;
+
+/**
+ * @brief Engine counters
+ */
+typedef struct {
+	uint32_t Rate;				/**< Conversions per second actually programmed */
+	uint32_t Blocks;			/**< DMA half buffers processed */
+	uint32_t Samples;			/**< Conversions processed */
+	uint32_t Overruns;			/**< Conversions the ADC overwrote before DMA read them */
+	uint32_t LostBlocks;		/**< Half buffers overwritten before they were processed */
+	uint32_t Dropped;			/**< Filtered samples lost to a full output ring */
+	uint32_t Errors;			/**< DMA bus errors, the engine is stopped */
+} ACQ_STATS_Type;
+
+/**
+ * @}
+ */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @defgroup ACQ_Public_Functions ACQ Public Functions
+ * @{
+ */
+
+Status ACQ_Init (ACQ_CFG_Type *cfg);
+Status ACQ_Start (void);
+void ACQ_Stop (void);
+uint32_t ACQ_Read (uint8_t ch, uint16_t *buf, uint32_t len);
+void ACQ_GetChannelStats (uint8_t ch, ACQ_CHAN_STATS_Type *stats, Bool reset);
+void ACQ_GetStats (ACQ_STATS_Type *stats);
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LPC_ADC_ACQ_H_ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -18,7 +18,7 @@
 
 /* Includes ------------------------------------------------------------------- */
 #include "lpc_system_init.h"
-#include "lpc17xx_rit.h"
+#include "lpc_dac_synth.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -36,83 +36,66 @@ extern "C"
 */
 
 /**
- * Buzzer Port and Pins
- * BSP Buzzer Bz1 P3.26
- * ASK-25 Buzzer P0.22
+ * Tones are synthesised on the DAC output AOUT P0.26 by the SYNTH
+ * engine, BUZZER_VOICE plays them
  */
-#define BUZZER_PORT   3
-#define BUZZER_PIN    _BIT(26)
+#define BUZZER_VOICE  0
 
 #define MELODY_LENGTH 95
 
-/* Key at 20kHz interrupt service routine Timer2 */
-#define SILENT_NOTE  255   //   00  Hz
+/* Note frequencies in Hz */
+#define SILENT_NOTE  0
 
 /* Middle 4th C 1-line Octave */
-#define C4           76    //  262  Hz
-#define C_SHARP4     72    //  278  Hz  Db4
-#define D4           68    //  294  Hz
-#define D_SHARP4     64    //  312  Hz  Eb4
-#define E4           61    //  330  Hz
-#define F4           57    //  350  Hz
-#define F_SHARP4     54    //  370  Hz
-#define G4           51    //  392  Hz
-#define G_SHARP4     48    //  416  Hz
-#define A4           45    //  440  Hz
-#define A_SHARP4     43    //  467  Hz
-#define B4           41    //  494  Hz
+#define C4           262
+#define C_SHARP4     277   //  Db4
+#define D4           294
+#define D_SHARP4     311   //  Eb4
+#define E4           330
+#define F4           349
+#define F_SHARP4     370
+#define G4           392
+#define G_SHARP4     415
+#define A4           440
+#define A_SHARP4     466
+#define B4           494
 
 /* C 2-line Octave */
-#define C5           38    //  524  Hz
-#define C_SHARP5     36    //  555  Hz
-#define D5           34    //  588  Hz
-#define D_SHARP5     32    //  623  Hz
-#define E5           30    //  660  Hz
-#define F5           29    //  699  Hz
-#define F_SHARP5     27    //  740  Hz
-#define G5           26    //  784  Hz
-#define G_SHARP5     24    //  831  Hz
-#define A5           23    //  880  Hz
-#define A_SHARP5     22    //  933  Hz
-#define B5           20    //  988  Hz
+#define C5           523
+#define C_SHARP5     554
+#define D5           587
+#define D_SHARP5     622
+#define E5           659
+#define F5           698
+#define F_SHARP5     740
+#define G5           784
+#define G_SHARP5     831
+#define A5           880
+#define A_SHARP5     932
+#define B5           988
 
 /* C 3-line Octave */
-#define C6           19    // 1047  Hz
-#define C_SHARP6     18    // 1109  Hz
-#define D6           17    // 1175  Hz
-#define D_SHARP6     16    // 1245  Hz
-#define E6           15    // 1317  Hz
-#define F6           14    // 1397  Hz
-#define F_SHARP6     13    // 1480  Hz
-#define G6           13    // 1568  Hz
-#define G_SHARP6     12    // 1662  Hz
-#define A6           11    // 1760  Hz
-#define A_SHARP6     11    // 1865  Hz
-#define B6           10    // 1976  Hz
+#define C6           1047
+#define C_SHARP6     1109
+#define D6           1175
+#define D_SHARP6     1245
+#define E6           1319
+#define F6           1397
+#define F_SHARP6     1480
+#define G6           1568
+#define G_SHARP6     1661
+#define A6           1760
+#define A_SHARP6     1865
+#define B6           1976
 
 /* C 4-line Octave */
-#define C7           9     // 2093  Hz
-#define D_SHARP7     8     // 2500  Hz
-#define F7           7     // 2857  Hz
-#define G_SHARP7     6     // 3333  Hz
-#define B7           5     // 4000  Hz
+#define C7           2093
+#define D_SHARP7     2489
+#define F7           2794
+#define G_SHARP7     3322
+#define B7           3951
 
-#define D_SHARP8     4     // 5000  Hz
-
-
-
-/*
- * Variables
- */
-/* Buzzer */
-extern uint16 timeout;     /* timeout for note */
-extern uint16 on_time;
-extern uint16 off_time;
-
-extern uint16 on_timer;
-extern uint16 off_timer;
-
-extern Bool play_note;
+#define D_SHARP8     4978
 
 /**
  * @}
@@ -127,6 +110,7 @@ extern Bool play_note;
 void Buzzer_Config(void);
 void Play_Frequency(uint16_t freq, uint16_t dur);
 void Play_Melody(void);
+Bool Buzzer_Busy(void);
 
 /**
  * @}
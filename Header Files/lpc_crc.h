@@ -0,0 +1,145 @@
+/******************************************************************//**
+* @file		lpc_crc.h
+* @brief	Contains all macro definitions and function prototypes
+* 			support for table driven CRC-32, CRC-16 and CRC-7
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @defgroup CRC CRC
+ * @ingroup LPC1700CMSIS_FwLib_Drivers
+ * @{
+ */
+
+#ifndef LPC_CRC_H_
+#define LPC_CRC_H_
+
+/* Includes ------------------------------------------------------------------- */
+#include "LPC17xx.h"
+#include "lpc_types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Public Macros -------------------------------------------------------------- */
+/** @defgroup CRC_Public_Macros CRC Public Macros
+ * @{
+ */
+
+#ifndef ENABLE
+#define	ENABLE		1
+#endif
+#ifndef DISABLE
+#define DISABLE		0
+#endif
+
+/******************************************************************************/
+/*                       CRC Table Select                                     */
+/******************************************************************************/
+/* Flash used by the lookup tables (CRC-32 + CRC-16 + CRC-7):
+ *   byte table   : 1 KB   + 512 B + 256 B
+ *   slicing-by-4 : 4 KB   + 2 KB  + 256 B
+ *   slicing-by-8 : 8 KB   + 4 KB  + 256 B
+ */
+#define 	CRC_TABLE_SEL      ENABLE       // Specify the table size
+#define 	CRC_SLICE4_SEL     DISABLE
+#define 	CRC_SLICE8_SEL     DISABLE
+#define 	CRC_BENCH_SEL      DISABLE      // Host benchmark (LPC_HOST_SIM only)
+
+/******************************************************************************/
+/*                       CRC Table validation                                 */
+/******************************************************************************/
+#if ((CRC_TABLE_SEL + CRC_SLICE4_SEL + CRC_SLICE8_SEL) != 1)
+	#error crc table not correctly selected
+#endif
+
+#if CRC_TABLE_SEL
+	#define CRC_TABLE_MODE
+	#define CRC_SLICES		1
+#elif CRC_SLICE4_SEL
+	#define CRC_SLICE4_MODE
+	#define CRC_SLICES		4
+#else
+	#define CRC_SLICE8_MODE
+	#define CRC_SLICES		8
+#endif
+
+#if (CRC_BENCH_SEL && defined(LPC_HOST_SIM))
+	#define CRC_BENCH_MODE
+#endif
+
+/** Start values for a new CRC, pass to the xxx_Update() functions */
+#define CRC32_INIT		((uint32_t)0xFFFFFFFF)	/**< Ethernet FCS, reflected 0x04C11DB7 */
+#define CRC16_INIT		((uint16_t)0x0000)		/**< SD data block, CCITT 0x1021 */
+#define CRC7_INIT		((uint8_t)0x00)			/**< SD command, 0x09 */
+
+/** Residue of CRC32_Update() over a frame including its FCS */
+#define CRC32_RESIDUE	((uint32_t)0xDEBB20E3)
+
+/**
+ * @}
+ */
+
+
+/* Public Types --------------------------------------------------------------- */
+/** @defgroup CRC_Public_Types CRC Public Types
+ * @{
+ */
+
+#ifdef CRC_BENCH_MODE
+/**
+ * @brief Benchmark result of one CRC against the code it replaces
+ */
+typedef struct {
+	uint32_t Bytes;				/**< Bytes checked per run */
+	uint64_t OldCycles;			/**< Host cycles of the bit/nibble serial code */
+	uint64_t NewCycles;			/**< Host cycles of the table code */
+	Bool Match;					/**< Both produced the same CRC */
+} CRC_BENCH_Type;
+#endif
+
+/**
+ * @}
+ */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @defgroup CRC_Public_Functions CRC Public Functions
+ * @{
+ */
+
+uint32_t CRC32_Update (uint32_t crc, const uint8_t *data, uint32_t len);
+uint32_t CRC32_Calc (const uint8_t *data, uint32_t len);
+uint8_t CRC32_HashIndex (const uint8_t *mac);
+
+uint16_t CRC16_Update (uint16_t crc, const uint8_t *data, uint32_t len);
+uint16_t CRC16_Calc (const uint8_t *data, uint32_t len);
+
+uint8_t CRC7_Update (uint8_t crc, const uint8_t *data, uint32_t len);
+uint8_t CRC7_Calc (const uint8_t *data, uint32_t len);
+
+#ifdef CRC_BENCH_MODE
+void CRC_Benchmark (CRC_BENCH_Type *crc32, CRC_BENCH_Type *crc16, CRC_BENCH_Type *crc7);
+#endif
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LPC_CRC_H_ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -0,0 +1,130 @@
+/******************************************************************//**
+* @file		lpc_dac_synth.h
+* @brief	Contains all macro definitions and function prototypes
+* 			support for the DAC waveform synthesis engine (DDS
+* 			oscillators, envelopes and a melody sequencer)
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @defgroup SYNTH SYNTH
+ * @ingroup LPC1700CMSIS_FwLib_Drivers
+ * @{
+ */
+
+#ifndef LPC_DAC_SYNTH_H_
+#define LPC_DAC_SYNTH_H_
+
+/* Includes ------------------------------------------------------------------- */
+#include "LPC17xx.h"
+#include "lpc_types.h"
+#include "lpc17xx_dac.h"
+#include "lpc17xx_gpdma.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Public Macros -------------------------------------------------------------- */
+/** @defgroup SYNTH_Public_Macros SYNTH Public Macros
+ * @{
+ */
+
+/** Output sample rate, paced by the DAC timeout counter */
+#define SYNTH_RATE			32000
+/** Samples per DMA half buffer, one interrupt per half (4 ms) */
+#define SYNTH_DMA_HALF		128
+/** Oscillators mixed into the output */
+#define SYNTH_VOICES		4
+/** Sine table of 1 << SYNTH_SINE_BITS entries */
+#define SYNTH_SINE_BITS		8
+/** Share of a sequenced note that sounds before its release, in 1/256 */
+#define SYNTH_SEQ_GATE		224
+
+/**
+ * @}
+ */
+
+
+/* Public Types --------------------------------------------------------------- */
+/** @defgroup SYNTH_Public_Types SYNTH Public Types
+ * @{
+ */
+
+/**
+ * @brief Oscillator waveform
+ */
+typedef enum
+{
+	SYNTH_WAVE_SINE = 0,		/*!< Interpolated table sine */
+	SYNTH_WAVE_SQUARE,			/*!< 50% duty square */
+	SYNTH_WAVE_SAW				/*!< Rising sawtooth */
+} SYNTH_WAVE_Type;
+
+/**
+ * @brief Voice configuration. Envelope times are for a full scale
+ * swing, a release from a lower level is shorter.
+ */
+typedef struct {
+	uint8_t Wave;				/**< SYNTH_WAVE_xxx */
+	uint8_t Level;				/**< Peak amplitude, 255 is full scale */
+	uint8_t Sustain;			/**< Sustain level in 1/255 of Level */
+	uint16_t Attack;			/**< Attack time in ms */
+	uint16_t Decay;				/**< Decay time in ms */
+	uint16_t Release;			/**< Release time in ms */
+} SYNTH_VOICE_CFG_Type;
+
+/**
+ * @brief Engine counters
+ */
+typedef struct {
+	uint32_t Rate;				/**< Samples per second actually programmed */
+	uint32_t Blocks;			/**< Half buffers rendered */
+	uint32_t LateBlocks;		/**< Half buffers the DMA replayed because the
+									 interrupt was held off */
+	uint32_t Clipped;			/**< Mixed samples clipped to the DAC range */
+	uint32_t Notes;				/**< Notes started */
+	uint32_t Errors;			/**< DMA bus errors, the engine is stopped */
+} SYNTH_STATS_Type;
+
+/**
+ * @}
+ */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @defgroup SYNTH_Public_Functions SYNTH Public Functions
+ * @{
+ */
+
+Status SYNTH_Init (void);
+Status SYNTH_Start (void);
+void SYNTH_Stop (void);
+void SYNTH_VoiceConfig (uint8_t voice, SYNTH_VOICE_CFG_Type *cfg);
+void SYNTH_NoteOn (uint8_t voice, uint16_t freq);
+void SYNTH_NoteOff (uint8_t voice);
+Status SYNTH_Play (uint8_t voice, const uint16_t *freq, const uint16_t *dur, uint32_t count, Bool loop);
+void SYNTH_Cancel (uint8_t voice);
+Bool SYNTH_Playing (uint8_t voice);
+void SYNTH_GetStats (SYNTH_STATS_Type *stats);
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LPC_DAC_SYNTH_H_ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
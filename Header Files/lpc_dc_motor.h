@@ -0,0 +1,166 @@
+/******************************************************************//**
+* @file		lpc_dc_motor.h
+* @brief	Contains all macro definitions and function prototypes
+* 			support for the DC motor control loop (MCPWM bridge drive,
+* 			QEI feedback and fixed-point PID speed/position control)
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @defgroup DC_MOTOR DC_MOTOR
+ * @ingroup LPC1700CMSIS_FwLib_Drivers
+ * @{
+ */
+
+#ifndef LPC_DC_MOTOR_H_
+#define LPC_DC_MOTOR_H_
+
+/* Includes ------------------------------------------------------------------- */
+#include "LPC17xx.h"
+#include "lpc_types.h"
+#include "lpc17xx_mcpwm.h"
+#include "lpc17xx_qei.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Public Macros -------------------------------------------------------------- */
+/** @defgroup DC_MOTOR_Public_Macros DC_MOTOR Public Macros
+ * @{
+ */
+
+/** Control loop rate (Hz): the QEI velocity timer period. QEI_IRQHandler
+ * must call DCM_IntHandler(). */
+#define DCM_LOOP_HZ				10000
+/** QEI clock, QEI_Init() sets PCLK_QEI to CCLK */
+#define DCM_QEI_PCLK_HZ			100000000UL
+
+/** Bridge drive on MCPWM channel 0: MCOA0 (P1.19) and MCOB0 (P1.22) feed
+ * the two legs of a full bridge in locked anti-phase, 50% is standstill.
+ * PCLK_MC is left at its reset value of CCLK/4. */
+#define DCM_PWM_PCLK_HZ			25000000UL
+#define DCM_PWM_HZ				20000
+#define DCM_PWM_PERIOD			(DCM_PWM_PCLK_HZ / DCM_PWM_HZ)
+/** Dead time between MCOA0 and MCOB0 (MCPWM clocks) */
+#define DCM_DEADTIME			25
+
+/** Encoder counts per revolution: ENC_RES lines in the QEI capture mode.
+ * The QEI inputs share P1.20/P1.23/P1.24 with the stepper coils. */
+#define DCM_CPR					(ENC_RES * COUNT_MODE)
+/** Samples the speed is measured over, power of two */
+#define DCM_VEL_WINDOW			16
+/** Speed of a Q15 speed of 1.0 (RPM) */
+#define DCM_RPM_MAX				3000
+/** The position loop runs once every DCM_POS_DIV samples */
+#define DCM_POS_DIV				10
+/** CPU cycles the loop may take per sample, 20% of a sample at 100 MHz */
+#define DCM_CYCLE_BUDGET		2000
+
+/** Control modes */
+#define DCM_MODE_OFF			0	/**< Bridge off, speed still measured */
+#define DCM_MODE_OPEN			1	/**< Duty set by DCM_SetDuty() */
+#define DCM_MODE_SPEED			2	/**< Speed loop on DCM_SetSpeed() */
+#define DCM_MODE_POSITION		3	/**< Position loop feeding the speed loop */
+
+/** Loops for DCM_SetGains() */
+#define DCM_LOOP_SPEED			0
+#define DCM_LOOP_POSITION		1
+
+/** Q15 value of x, 1.0 is 32768 */
+#define DCM_Q15(x)				((int32_t)((x) * 32768))
+/** Q15 speed of a speed in RPM */
+#define DCM_RPM(rpm)			((int32_t)(((int64_t)(rpm) * 32768) / DCM_RPM_MAX))
+/** Integral gain (1/s) as a Q31 gain per sample of a loop running at hz */
+#define DCM_KI(ki, hz)			((int32_t)((ki) * 2147483648.0 / (hz)))
+/** Derivative gain (s) as a Q15 gain per sample of a loop running at hz */
+#define DCM_KD(kd, hz)			((int32_t)((kd) * (hz) * 32768))
+
+/** Position counts moved over the speed window to a Q15 speed, and to
+ * RPM, both with 16 fraction bits so the loop never divides */
+#define DCM_SPEED_K				((int32_t)((60ULL * DCM_LOOP_HZ * 32768 * 65536) / \
+									((uint64_t)DCM_VEL_WINDOW * DCM_CPR * DCM_RPM_MAX)))
+#define DCM_RPM_K				((int32_t)((60ULL * DCM_LOOP_HZ * 65536) / \
+									((uint64_t)DCM_VEL_WINDOW * DCM_CPR)))
+
+/**
+ * @}
+ */
+
+
+/* Public Types --------------------------------------------------------------- */
+/** @defgroup DC_MOTOR_Public_Types DC_MOTOR Public Types
+ * @{
+ */
+
+/**
+ * @brief PID gains of one loop. The speed loop works on Q15 speeds and
+ * puts out a Q15 duty, the position loop works on encoder counts and puts
+ * out a Q15 speed.
+ */
+typedef struct {
+	int32_t Kp;					/**< Proportional gain, Q15 */
+	int32_t Ki;					/**< Integral gain per sample, Q31, see DCM_KI() */
+	int32_t Kd;					/**< Derivative gain per sample, Q15, see DCM_KD().
+									 Acts on the measurement only. */
+	int32_t Kff;				/**< Feed-forward gain on the reference, Q15 */
+	int32_t Offset;				/**< Feed-forward offset with the sign of the
+									 reference (static friction), Q15 */
+	int32_t OutMax;				/**< Output limit, the output spans -OutMax
+									 to OutMax, Q15. The integrator is held
+									 inside it (anti-windup). */
+} DCM_PID_CFG_Type;
+
+/**
+ * @brief Control loop counters
+ */
+typedef struct {
+	uint32_t Samples;			/**< Loop runs */
+	uint32_t Saturated;			/**< Samples with the speed loop output
+									 on its limit */
+	uint32_t OverBudget;		/**< Samples over DCM_CYCLE_BUDGET */
+	uint32_t MaxCycles;			/**< Longest run (CPU cycles) */
+} DCM_STATS_Type;
+
+/**
+ * @}
+ */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @defgroup DC_MOTOR_Public_Functions DC_MOTOR Public Functions
+ * @{
+ */
+
+void DCM_Init (void);
+Status DCM_SetGains (uint8_t loop, const DCM_PID_CFG_Type *cfg);
+void DCM_SetDuty (int32_t duty);
+void DCM_SetSpeed (int32_t rpm);
+void DCM_SetPosition (int32_t pos);
+void DCM_Stop (void);
+uint8_t DCM_GetMode (void);
+int32_t DCM_GetSpeed (void);
+int32_t DCM_GetPosition (void);
+void DCM_IntHandler (void);
+void DCM_GetStats (DCM_STATS_Type *stats);
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LPC_DC_MOTOR_H_ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
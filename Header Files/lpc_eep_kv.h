@@ -0,0 +1,151 @@
+/******************************************************************//**
+* @file		lpc_eep_kv.h
+* @brief	Contains all macro definitions and function prototypes
+* 			support for the log structured key/value store on the
+* 			serial E2PROMs
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @defgroup KV KV
+ * @ingroup LPC1700CMSIS_FwLib_Drivers
+ * @{
+ */
+
+#ifndef LPC_EEP_KV_H_
+#define LPC_EEP_KV_H_
+
+/* Includes ------------------------------------------------------------------- */
+#include "LPC17xx.h"
+#include "lpc_types.h"
+#include "lpc_eep_writer.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Public Macros -------------------------------------------------------------- */
+/** @defgroup KV_Public_Macros KV Public Macros
+ * @{
+ */
+
+/** Keys are 0 .. KV_MAX_KEYS-1, the RAM index has one entry per key */
+#define KV_MAX_KEYS			64
+/** Largest value in bytes */
+#define KV_VALUE_MAX		32
+/** Segments of a store, and the largest segment in bytes */
+#define KV_MAX_SEGS			32
+#define KV_SEG_MAX			512
+
+/** Segment header: magic "KV", sequence number, CRC32 */
+#define KV_SEG_HDR			10
+/** Record: key, length, value, CRC32 over the segment sequence number
+ * and the record, so records left from an older use of the segment fail */
+#define KV_REC_SIZE(len)	(6 + (len))
+
+/** Index entry of a key without record, and length of a delete record */
+#define KV_NONE				0xFFFF
+#define KV_TOMBSTONE		0xFF
+
+/** Store descriptor initialiser, nsegs segments of seg bytes from base */
+#define KV_STORE(dev, base, seg, nsegs) \
+	{ .Dev = (dev), .Base = (base), .SegSize = (seg), .NumSegs = (nsegs), .Stats = {0} }
+
+/**
+ * @}
+ */
+
+
+/* Public Types --------------------------------------------------------------- */
+/** @defgroup KV_Public_Types KV Public Types
+ * @{
+ */
+
+typedef enum _kv_error
+{
+	KV_OK,
+	KV_ERROR_DISK,				/* E2PROM write or read failed */
+	KV_ERROR_NO_STORE,			/* No valid segment, KV_Format() first */
+	KV_ERROR_NOT_MOUNTED,
+	KV_ERROR_NOT_FOUND,			/* Key never written or deleted */
+	KV_ERROR_PARAM,				/* Key, length or store geometry out of range */
+	KV_ERROR_FULL				/* Live records do not fit the store */
+}kv_error;
+
+/**
+ * @brief RAM index entry, where the newest record of a key lives
+ */
+typedef struct {
+	uint16_t Addr;				/**< Record offset in the store, KV_NONE when absent */
+	uint8_t Len;				/**< Value length, KV_TOMBSTONE when deleted */
+} KV_INDEX_Type;
+
+/**
+ * @brief Store counters
+ */
+typedef struct {
+	uint32_t Records;			/**< Records appended, copies included */
+	uint32_t Bytes;				/**< Record bytes written */
+	uint32_t Segments;			/**< Segments opened, the ring moves on by one */
+	uint32_t Compactions;		/**< Segments emptied by copying their live records */
+	uint32_t Copied;			/**< Records copied by compaction */
+	uint32_t Replayed;			/**< Records read by KV_Mount() to build the index */
+	uint32_t LiveBytes;			/**< Bytes held by the newest record of every key */
+	uint32_t FreeBytes;			/**< Live bytes that can still be added */
+} KV_STATS_Type;
+
+/**
+ * @brief Key/value store on a serial E2PROM, set up with KV_STORE()
+ */
+typedef struct {
+	EEPW_DEV_Type *Dev;			/**< Part holding the store */
+	uint32_t Base;				/**< First E2PROM address of the store */
+	uint16_t SegSize;			/**< Segment size, a multiple of the page size */
+	uint8_t NumSegs;			/**< Segments, 3 .. KV_MAX_SEGS */
+	KV_STATS_Type Stats;
+	/* Built by KV_Mount() */
+	Bool mounted;
+	uint8_t head;				/* Segment appended to */
+	uint16_t fill;				/* Append offset in the head segment */
+	uint32_t seq[KV_MAX_SEGS];	/* Sequence number, 0 when no valid header */
+	uint16_t live[KV_MAX_SEGS];	/* Bytes of records still in the index */
+	KV_INDEX_Type index[KV_MAX_KEYS];
+} KV_STORE_Type;
+
+/**
+ * @}
+ */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @defgroup KV_Public_Functions KV Public Functions
+ * @{
+ */
+
+kv_error KV_Format (KV_STORE_Type *kv);
+kv_error KV_Mount (KV_STORE_Type *kv);
+kv_error KV_Set (KV_STORE_Type *kv, uint8_t key, const void *data, uint8_t len);
+kv_error KV_Get (KV_STORE_Type *kv, uint8_t key, void *buf, uint8_t size, uint8_t *len);
+kv_error KV_Delete (KV_STORE_Type *kv, uint8_t key);
+void KV_GetStats (KV_STORE_Type *kv, KV_STATS_Type *stats);
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LPC_EEP_KV_H_ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
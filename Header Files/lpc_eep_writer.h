@@ -0,0 +1,195 @@
+/******************************************************************//**
+* @file		lpc_eep_writer.h
+* @brief	Contains all macro definitions and function prototypes
+* 			support for the page writer shared by the serial E2PROMs
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @defgroup EEPW EEPW
+ * @ingroup LPC1700CMSIS_FwLib_Drivers
+ * @{
+ */
+
+#ifndef LPC_EEP_WRITER_H_
+#define LPC_EEP_WRITER_H_
+
+/* Includes ------------------------------------------------------------------- */
+#include "LPC17xx.h"
+#include "lpc_types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Public Macros -------------------------------------------------------------- */
+/** @defgroup EEPW_Public_Macros EEPW Public Macros
+ * @{
+ */
+
+#ifndef ENABLE
+#define	ENABLE		1
+#endif
+#ifndef DISABLE
+#define DISABLE		0
+#endif
+
+/******************************************************************************/
+/*                       Bus Select                                           */
+/******************************************************************************/
+#define 	EEPW_I2C_SEL       ENABLE       // AT24C16, M24256
+#define 	EEPW_SSP_SEL       ENABLE       // 25AA160A on SSP
+#define 	EEPW_SPI_SEL       ENABLE       // 25AA160A on SPI
+
+#if EEPW_I2C_SEL
+	#include "lpc17xx_i2c.h"
+#endif
+#if EEPW_SSP_SEL
+	#include "lpc17xx_ssp.h"
+#endif
+#if EEPW_SPI_SEL
+	#include "lpc17xx_spi.h"
+#endif
+
+/** Largest page of a supported part */
+#define EEPW_PAGE_MAX		64
+/** Busy checks (I2C address NACKs or SPI WIP reads) before a write
+ * cycle counts as failed, covers a 5 ms tWR up to 1 MHz */
+#define EEPW_POLL_MAX		10000
+
+/** Device descriptor initialisers, the writer state starts zeroed */
+#define EEPW_I2C_DEVICE(i2c, sla, abytes, page, size) \
+	{ .Bus = EEPW_BUS_I2C, .Periph = (void *)(i2c), .SlaveAddr = (sla), \
+	  .AddrBytes = (abytes), .PageSize = (page), .Size = (size), .Stats = {0} }
+#define EEPW_SPI_DEVICE(spi, abytes, page, size) \
+	{ .Bus = EEPW_BUS_SPI, .Periph = (void *)(spi), .SlaveAddr = 0, \
+	  .AddrBytes = (abytes), .PageSize = (page), .Size = (size), .Stats = {0} }
+#define EEPW_SSP_DEVICE(ssp, abytes, page, size) \
+	{ .Bus = EEPW_BUS_SSP, .Periph = (void *)(ssp), .SlaveAddr = 0, \
+	  .AddrBytes = (abytes), .PageSize = (page), .Size = (size), .Stats = {0} }
+
+/**
+ * @}
+ */
+
+
+/* Public Types --------------------------------------------------------------- */
+/** @defgroup EEPW_Public_Types EEPW Public Types
+ * @{
+ */
+
+typedef enum {
+	EEPW_BUS_I2C = 0,
+	EEPW_BUS_SPI,
+	EEPW_BUS_SSP
+} EEPW_BUS_Type;
+
+/**
+ * @brief Queued write state
+ */
+typedef enum {
+	EEPW_JOB_IDLE = 0,				/**< Never submitted */
+	EEPW_JOB_QUEUED,				/**< Waiting for the device */
+	EEPW_JOB_BUSY,					/**< Pages being written */
+	EEPW_JOB_DONE,					/**< Written, verified if asked */
+	EEPW_JOB_FAILED					/**< Bus error, time out or verify mismatch */
+} EEPW_JOB_STATE_Type;
+
+/**
+ * @brief Throughput counters, diff two snapshots over a timed run
+ */
+typedef struct {
+	uint32_t BytesWritten;			/**< Bytes accepted by the device */
+	uint32_t PagesWritten;			/**< Page write commands */
+	uint32_t BusyPolls;				/**< Ready checks that found a write cycle running */
+	uint32_t BytesVerified;			/**< Bytes read back and compared */
+	uint32_t VerifyErrors;			/**< Pages that read back different */
+	uint32_t Timeouts;				/**< Write cycles longer than EEPW_POLL_MAX checks */
+} EEPW_STATS_Type;
+
+typedef struct EEPW_JOB_Tag EEPW_JOB_Type;
+
+/** Completion callback, called from the I2C interrupt for I2C parts and
+ * from EEPW_Process() for SPI parts */
+typedef void (*EEPW_JOB_CB_Type)(EEPW_JOB_Type *job);
+
+/**
+ * @brief Queued write for EEPW_Submit(), the job and its data must stay
+ * valid until the callback
+ */
+struct EEPW_JOB_Tag
+{
+	uint32_t Addr;					/**< First E2PROM address */
+	const uint8_t *Data;			/**< Data to write */
+	uint32_t Length;				/**< Bytes to write */
+	Bool Verify;					/**< Read every page back after its write cycle */
+	EEPW_JOB_CB_Type Callback;		/**< Called when done or failed, NULL for none */
+	void *Arg;						/**< Free for the caller */
+	__IO uint8_t State;				/**< EEPW_JOB_STATE_Type */
+	uint32_t Done;					/**< Bytes written, and verified with Verify */
+	EEPW_JOB_Type *Next;			/**< Queue link, used by the writer */
+};
+
+/**
+ * @brief Serial E2PROM, one per part, set up with EEPW_xxx_DEVICE()
+ */
+typedef struct {
+	EEPW_BUS_Type Bus;
+	void *Periph;					/**< LPC_I2Cx, LPC_SPI or LPC_SSPx */
+	uint8_t SlaveAddr;				/**< I2C 7-bit address, address bits above
+										 AddrBytes go to its low bits */
+	uint8_t AddrBytes;				/**< Word address bytes sent after SLA+W or the opcode */
+	uint16_t PageSize;				/**< Write page, power of two up to EEPW_PAGE_MAX */
+	uint32_t Size;					/**< Capacity in bytes */
+	EEPW_STATS_Type Stats;
+	/* Writer state */
+	EEPW_JOB_Type *head;
+	EEPW_JOB_Type *cur;
+	uint8_t phase;
+	uint16_t len;
+	uint32_t polls;
+#if EEPW_I2C_SEL
+	I2C_XFER_Type xfer;
+#endif
+	uint8_t buf[EEPW_PAGE_MAX + 3];
+	uint8_t vbuf[EEPW_PAGE_MAX];
+} EEPW_DEV_Type;
+
+/**
+ * @}
+ */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @defgroup EEPW_Public_Functions EEPW Public Functions
+ * @{
+ */
+
+Status EEPW_Write (EEPW_DEV_Type *dev, uint32_t addr, const uint8_t *data, uint32_t len, Bool verify);
+Status EEPW_Read (EEPW_DEV_Type *dev, uint32_t addr, uint8_t *buf, uint32_t len);
+Status EEPW_WaitReady (EEPW_DEV_Type *dev);
+Status EEPW_Submit (EEPW_DEV_Type *dev, EEPW_JOB_Type *job);
+uint32_t EEPW_Pending (EEPW_DEV_Type *dev);
+void EEPW_Process (EEPW_DEV_Type *dev);
+void EEPW_GetStats (EEPW_DEV_Type *dev, EEPW_STATS_Type *stats);
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LPC_EEP_WRITER_H_ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -0,0 +1,135 @@
+/******************************************************************//**
+* @file		lpc_fat32.h
+* @brief	Contains all macro definitions and function prototypes
+* 			support for the read optimised FAT32 file reader on SD
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @defgroup FAT32 FAT32
+ * @ingroup LPC1700CMSIS_FwLib_Drivers
+ * @{
+ */
+
+#ifndef LPC_FAT32_H_
+#define LPC_FAT32_H_
+
+/* Includes ------------------------------------------------------------------- */
+#include "LPC17xx.h"
+#include "lpc_types.h"
+#include "lpc_spi_sd.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Public Macros -------------------------------------------------------------- */
+/** @defgroup FAT32_Public_Macros FAT32 Public Macros
+ * @{
+ */
+
+#define FAT_SECTOR_SIZE		512
+/** Contiguous cluster runs cached per open file */
+#define FAT_EXTENTS			8
+
+/** Directory entry attributes */
+#define FAT_ATTR_READ_ONLY	0x01
+#define FAT_ATTR_HIDDEN		0x02
+#define FAT_ATTR_SYSTEM		0x04
+#define FAT_ATTR_VOLUME_ID	0x08
+#define FAT_ATTR_DIRECTORY	0x10
+#define FAT_ATTR_ARCHIVE	0x20
+#define FAT_ATTR_LFN		0x0F
+
+/**
+ * @}
+ */
+
+
+/* Public Types --------------------------------------------------------------- */
+/** @defgroup FAT32_Public_Types FAT32 Public Types
+ * @{
+ */
+
+typedef enum _fat_error
+{
+	FAT_OK,
+	FAT_ERROR_DISK,				/* SD block read or write failed */
+	FAT_ERROR_NO_FS,			/* No FAT32 volume on the card */
+	FAT_ERROR_NOT_MOUNTED,
+	FAT_ERROR_NOT_FOUND,		/* Path does not name a file */
+	FAT_ERROR_CHAIN,			/* Cluster chain broken or shorter than the file */
+	FAT_ERROR_RANGE				/* Seek past the end of the file */
+}fat_error;
+
+/**
+ * @brief Run of consecutive clusters of a file
+ */
+typedef struct {
+	uint32_t Index;				/**< Cluster number inside the file */
+	uint32_t Cluster;			/**< First cluster of the run */
+	uint32_t Count;				/**< Clusters in the run */
+} FAT_EXTENT_Type;
+
+/**
+ * @brief Open file, filled in by FAT_Open()
+ */
+typedef struct {
+	uint32_t Size;				/**< File size in bytes */
+	uint32_t Pos;				/**< Read/write position */
+	uint32_t FirstCluster;		/**< Start of the cluster chain */
+	uint8_t Attr;				/**< Directory entry attributes */
+	/* Cluster chain cache */
+	uint8_t NumExt;
+	Bool ChainEnd;				/**< Last run ends the chain */
+	FAT_EXTENT_Type Ext[FAT_EXTENTS];
+} FAT_FILE_Type;
+
+/**
+ * @brief Disk traffic counters
+ */
+typedef struct {
+	uint32_t DiskReads;			/**< SD_ReadBlocks() calls */
+	uint32_t DiskWrites;		/**< SD_WriteBlocks() calls */
+	uint32_t SectorsRead;		/**< Sectors read, FAT included */
+	uint32_t SectorsWritten;	/**< Sectors written */
+	uint32_t FatReads;			/**< FAT sectors loaded to follow a chain */
+} FAT_STATS_Type;
+
+/**
+ * @}
+ */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @defgroup FAT32_Public_Functions FAT32 Public Functions
+ * @{
+ */
+
+fat_error FAT_Mount (void);
+fat_error FAT_Open (FAT_FILE_Type *file, const char *path);
+fat_error FAT_Seek (FAT_FILE_Type *file, uint32_t pos);
+uint32_t FAT_Read (FAT_FILE_Type *file, void *buf, uint32_t len);
+uint32_t FAT_Write (FAT_FILE_Type *file, const void *buf, uint32_t len);
+void FAT_GetStats (FAT_STATS_Type *stats);
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LPC_FAT32_H_ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
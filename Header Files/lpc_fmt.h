@@ -0,0 +1,152 @@
+/******************************************************************//**
+* @file		lpc_fmt.h
+* @brief	Contains all macro definitions and function prototypes
+* 			support for the formatting core shared by the UART printf,
+* 			the GLCD gprintf and memory buffers
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @defgroup FMT FMT
+ * @ingroup LPC1700CMSIS_FwLib_Drivers
+ * @{
+ */
+
+#ifndef LPC_FMT_H_
+#define LPC_FMT_H_
+
+/* Includes ------------------------------------------------------------------- */
+#include "LPC17xx.h"
+#include "lpc_types.h"
+#include "stdarg.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Public Macros -------------------------------------------------------------- */
+/** @defgroup FMT_Public_Macros FMT Public Macros
+ * @{
+ */
+
+#ifndef ENABLE
+#define	ENABLE		1
+#endif
+#ifndef DISABLE
+#define DISABLE		0
+#endif
+
+#define 	FMT_BENCH_SEL      DISABLE      // Host benchmark (LPC_HOST_SIM only)
+
+#if (FMT_BENCH_SEL && defined(LPC_HOST_SIM))
+	#define FMT_BENCH_MODE
+#endif
+
+/** Longest number field without padding: "-2147483648" */
+#define FMT_NUM_MAX			11
+
+/** Field conversions */
+#define FMT_DEC				0x00		/**< Signed decimal */
+#define FMT_UDEC			0x01		/**< Unsigned decimal */
+#define FMT_HEX				0x02		/**< Upper case hexadecimal */
+
+/** Field flags */
+#define FMT_LEFT			0x01		/**< Pad on the right */
+#define FMT_DIGITS			0x02		/**< Width counts digits only, a sign
+											 goes in front (the "%d02" form) */
+
+/** Field spec folded into one word by the compiler, for FMT_Int() and
+ * FMT_Uint() calls that need no format string parsing at run time.
+ * Example: FMT_SPEC(FMT_DEC, 2, '0', 0) is "%02d". */
+#define FMT_SPEC(conv, width, fill, flags) \
+	((uint32_t)(conv) | ((uint32_t)(width) << 8) | ((uint32_t)(uint8_t)(fill) << 16) | ((uint32_t)(flags) << 24))
+
+/**
+ * @}
+ */
+
+
+/* Public Types --------------------------------------------------------------- */
+/** @defgroup FMT_Public_Types FMT Public Types
+ * @{
+ */
+
+typedef struct FMT_OUT_Tag FMT_OUT_Type;
+
+/** Sink callback: consume Buf[0..Len-1], then set Len to 0. It may also
+ * point Buf and Size at the next free span of its own storage. */
+typedef void (*FMT_FLUSH_Type)(FMT_OUT_Type *out);
+
+/**
+ * @brief Output of the formatter, characters are rendered into Buf and
+ * handed to Flush whenever Buf is full and at the end of a format
+ */
+struct FMT_OUT_Tag
+{
+	char *Buf;					/**< Caller supplied render buffer */
+	uint32_t Size;				/**< Size of Buf */
+	uint32_t Len;				/**< Characters in Buf */
+	uint32_t Total;				/**< Characters produced, dropped ones included */
+	FMT_FLUSH_Type Flush;		/**< Sink, NULL for a memory buffer that drops
+									 what does not fit */
+	void *Arg;					/**< Free for the sink */
+};
+
+#ifdef FMT_BENCH_MODE
+/**
+ * @brief Benchmark result of one field type against the code it replaces
+ */
+typedef struct {
+	uint32_t Fields;			/**< Fields formatted by each side */
+	uint64_t OldCycles;			/**< Host cycles of the divide and modulo loop */
+	uint64_t NewCycles;			/**< Host cycles of the formatting core */
+	Bool Match;					/**< Both produced the same text */
+} FMT_BENCH_Type;
+#endif
+
+/**
+ * @}
+ */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @defgroup FMT_Public_Functions FMT Public Functions
+ * @{
+ */
+
+uint32_t FMT_U32ToDec (char *buf, uint32_t val);
+uint32_t FMT_U32ToHex (char *buf, uint32_t val, uint8_t digits);
+
+void FMT_MemInit (FMT_OUT_Type *out, char *buf, uint32_t size);
+void FMT_Putc (FMT_OUT_Type *out, char c);
+void FMT_Str (FMT_OUT_Type *out, const char *s, uint32_t spec);
+void FMT_Int (FMT_OUT_Type *out, int32_t val, uint32_t spec);
+void FMT_Uint (FMT_OUT_Type *out, uint32_t val, uint32_t spec);
+uint32_t FMT_VFormat (FMT_OUT_Type *out, const char *format, va_list ap);
+uint32_t FMT_Format (FMT_OUT_Type *out, const char *format, ...);
+uint32_t FMT_Snprintf (char *buf, uint32_t size, const char *format, ...);
+
+#ifdef FMT_BENCH_MODE
+void FMT_Benchmark (FMT_BENCH_Type *dec, FMT_BENCH_Type *hex);
+#endif
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LPC_FMT_H_ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -0,0 +1,135 @@
+/******************************************************************//**
+* @file		lpc_freq_meter.h
+* @brief	Contains all macro definitions and function prototypes
+* 			support for the input capture frequency meter (TIMER1
+* 			capture with reciprocal and gated counting)
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @defgroup FREQ_METER FREQ_METER
+ * @ingroup LPC1700CMSIS_FwLib_Drivers
+ * @{
+ */
+
+#ifndef LPC_FREQ_METER_H_
+#define LPC_FREQ_METER_H_
+
+/* Includes ------------------------------------------------------------------- */
+#include "LPC17xx.h"
+#include "lpc_types.h"
+#include "lpc17xx_timer.h"
+#include "lpc17xx_rit.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Public Macros -------------------------------------------------------------- */
+/** @defgroup FREQ_METER_Public_Macros FREQ_METER Public Macros
+ * @{
+ */
+
+/** Inputs CAP1.0 (P1.18) and CAP1.1 (P1.19). P1.19 is also MCOA0 of the
+ * DC motor bridge. TIMER1_IRQHandler must call FREQ_IntHandler() and
+ * RIT_IRQHandler must call FREQ_GateHandler(). */
+#define FREQ_CHANNELS			2
+
+/** Default gate time (ms): results come once per gate */
+#define FREQ_GATE_MS			100
+/** Longest gate (ms), TIMER1 at CCLK wraps in 42 s */
+#define FREQ_GATE_MAX_MS		4000
+
+/** A channel above FREQ_GATED_HZ moves from period mode to gated
+ * counting, and back below FREQ_PERIOD_HZ */
+#define FREQ_GATED_HZ			20000
+#define FREQ_PERIOD_HZ			10000
+/** Gates without an edge before a channel in period mode reports 0 Hz */
+#define FREQ_TIMEOUT_GATES		10
+
+/** Fraction bits of FREQ_SAMPLE_Type.Freq, the meter reads up to 16 MHz */
+#define FREQ_FRAC_BITS			8
+/** Results kept until read, power of two */
+#define FREQ_QUEUE_SIZE			32
+
+/** Channel modes */
+#define FREQ_MODE_OFF			0	/**< Channel off */
+#define FREQ_MODE_PERIOD		1	/**< Reciprocal: timer captures of each
+										 edge, periods summed over the gate */
+#define FREQ_MODE_GATED			2	/**< TIMER1 counts the edges, the RIT
+										 sets the gate */
+#define FREQ_MODE_HOLD			3	/**< Waiting while another channel
+										 holds TIMER1 in gated counting */
+
+/**
+ * @}
+ */
+
+
+/* Public Types --------------------------------------------------------------- */
+/** @defgroup FREQ_METER_Public_Types FREQ_METER Public Types
+ * @{
+ */
+
+/**
+ * @brief One result
+ */
+typedef struct {
+	uint8_t Channel;			/**< Input 0..FREQ_CHANNELS-1 */
+	uint8_t Mode;				/**< FREQ_MODE_PERIOD or FREQ_MODE_GATED */
+	uint16_t Reserved;
+	uint32_t Edges;				/**< Periods measured (period mode) or
+									 edges counted in the gate (gated) */
+	uint32_t Freq;				/**< Frequency (Hz), FREQ_FRAC_BITS fraction
+									 bits. 0 if the input stopped. */
+} FREQ_SAMPLE_Type;
+
+/**
+ * @brief Meter counters
+ */
+typedef struct {
+	uint32_t Captures;			/**< Capture interrupts served */
+	uint32_t Gates;				/**< Gate interrupts served */
+	uint32_t Samples;			/**< Results queued */
+	uint32_t Dropped;			/**< Results lost to a full queue */
+	uint32_t Switches;			/**< Changes between period and gated mode */
+} FREQ_STATS_Type;
+
+/**
+ * @}
+ */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @defgroup FREQ_METER_Public_Functions FREQ_METER Public Functions
+ * @{
+ */
+
+void FREQ_Init (uint32_t gate_ms);
+Status FREQ_ChannelCmd (uint8_t ch, FunctionalState NewState);
+Status FREQ_Read (FREQ_SAMPLE_Type *sample);
+uint8_t FREQ_GetMode (uint8_t ch);
+void FREQ_IntHandler (void);
+void FREQ_GateHandler (void);
+void FREQ_GetStats (FREQ_STATS_Type *stats);
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LPC_FREQ_METER_H_ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
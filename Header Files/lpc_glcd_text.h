@@ -0,0 +1,127 @@
+/******************************************************************//**
+* @file		lpc_glcd_text.h
+* @brief	Contains all macro definitions and function prototypes
+* 			support for the GLCD text blitter (glyph cache and run
+* 			streaming for fixed and proportional fonts)
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @defgroup GTEXT GTEXT
+ * @ingroup LPC1700CMSIS_FwLib_Drivers
+ * @{
+ */
+
+#ifndef LPC_GLCD_TEXT_H_
+#define LPC_GLCD_TEXT_H_
+
+/* Includes ------------------------------------------------------------------- */
+#include "LPC17xx.h"
+#include "lpc_types.h"
+#include "lpc_ssp_glcd.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Public Macros -------------------------------------------------------------- */
+/** @defgroup GTEXT_Public_Macros GTEXT Public Macros
+ * @{
+ */
+
+/** Expanded glyphs kept, each slot costs GTEXT_SLOT_PIXELS * 2 bytes */
+#define GTEXT_CACHE_SLOTS		8
+/** Pixels of one cache slot, enough for a Font_24x16 glyph. Larger
+ * glyphs are expanded row by row while streaming. */
+#define GTEXT_SLOT_PIXELS		(16*24)
+/** Glyphs sent through one GRAM window, longer texts take more */
+#define GTEXT_RUN_MAX			64
+
+/** Font formats */
+#define GTEXT_FONT_ROW16		0	/**< One uint16_t per row, bit 0 is the left column */
+#define GTEXT_FONT_COL8			1	/**< One uint8_t per column, bit 0 is the top row */
+#define GTEXT_FONT_PACKED		2	/**< Proportional: rows of Widths[g] (up to 24) bits
+										 packed LSB first, glyph g starts at byte
+										 Offsets[g] */
+
+/**
+ * @}
+ */
+
+
+/* Public Types --------------------------------------------------------------- */
+/** @defgroup GTEXT_Public_Types GTEXT Public Types
+ * @{
+ */
+
+/**
+ * @brief Font descriptor
+ */
+typedef struct {
+	uint8_t Format;				/**< GTEXT_FONT_xxx */
+	uint8_t Width;				/**< Cell width, unused for GTEXT_FONT_PACKED */
+	uint8_t Height;				/**< Rows */
+	uint8_t Spacing;			/**< Background columns after each glyph */
+	uint8_t First;				/**< Character code of the first glyph */
+	uint8_t Count;				/**< Glyphs, other codes draw the first one */
+	const void *Bits;			/**< Glyph data */
+	const uint8_t *Widths;		/**< GTEXT_FONT_PACKED: width of each glyph */
+	const uint16_t *Offsets;	/**< GTEXT_FONT_PACKED: start of each glyph in Bits */
+} GTEXT_FONT_Type;
+
+/**
+ * @brief Blitter counters
+ */
+typedef struct {
+	uint32_t Runs;				/**< Strings drawn, one GRAM window each */
+	uint32_t Glyphs;			/**< Glyphs drawn */
+	uint32_t Hits;				/**< Glyphs found expanded in the cache */
+	uint32_t Misses;			/**< Glyphs expanded into a cache slot */
+	uint32_t Uncached;			/**< Glyphs expanded row by row, no slot free */
+	uint32_t Pixels;			/**< Pixels streamed */
+} GTEXT_STATS_Type;
+
+/**
+ * @}
+ */
+
+
+/* Public Variables ----------------------------------------------------------- */
+/** Font_24x16 (16 x 24 cells), default5x7 (5 x 7 plus one column) and
+ * the proportional Prop5x7 */
+extern const GTEXT_FONT_Type GTEXT_Font_24x16;
+extern const GTEXT_FONT_Type GTEXT_Font_5x7;
+extern const GTEXT_FONT_Type GTEXT_Font_Prop5x7;
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @defgroup GTEXT_Public_Functions GTEXT Public Functions
+ * @{
+ */
+
+uint16_t GTEXT_Width (const GTEXT_FONT_Type *font, const char *s, uint16_t len);
+int16_t GTEXT_DrawText (int16_t x, int16_t y, const GTEXT_FONT_Type *font, const char *s, uint16_t len, uint16_t fg, uint16_t bg);
+int16_t GTEXT_DrawString (int16_t x, int16_t y, const GTEXT_FONT_Type *font, const char *s, uint16_t fg, uint16_t bg);
+void GTEXT_CacheFlush (void);
+void GTEXT_GetStats (GTEXT_STATS_Type *stats);
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LPC_GLCD_TEXT_H_ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
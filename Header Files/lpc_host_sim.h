@@ -0,0 +1,269 @@
+/******************************************************************//**
+* @file		lpc_host_sim.h
+* @brief	Contains all macro definitions and function prototypes
+* 			support for the host side LPC17xx register simulator
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @defgroup HOSTSIM HOSTSIM
+ * @ingroup LPC1700CMSIS_FwLib_Drivers
+ * @{
+ */
+
+#ifndef LPC_HOST_SIM_H_
+#define LPC_HOST_SIM_H_
+
+/* Includes ------------------------------------------------------------------- */
+#include "LPC17xx.h"
+#include "lpc_types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+#ifdef LPC_HOST_SIM
+
+/* Private Macros ------------------------------------------------------------- */
+/** @defgroup HOSTSIM_Private_Macros HOSTSIM Private Macros
+ * @{
+ */
+/*********************************************************************//**
+ * Macro defines for the virtual clock
+ **********************************************************************/
+/** CPU cycles charged for every trapped peripheral register access */
+#define HOSTSIM_ACCESS_CYCLES		8
+/** Host CPU time between two idle ticks (us) */
+#define HOSTSIM_IDLE_TICK_US		100
+/** Virtual time granted to RAM only spin loops per idle tick (us) */
+#define HOSTSIM_IDLE_GRANT_US		1000
+
+/*********************************************************************//**
+ * Macro defines for the host side capture buffers
+ **********************************************************************/
+#define HOSTSIM_UART_CAPTURE_SIZE	0x10000
+#define HOSTSIM_UART_INJECT_SIZE	0x1000
+#define HOSTSIM_EMAC_RXQ_SIZE		32
+#define HOSTSIM_CAN_RXQ_SIZE		64
+
+/**
+ * @}
+ */
+
+/* Public Types --------------------------------------------------------------- */
+/** @defgroup HOSTSIM_Public_Types HOSTSIM Public Types
+ * @{
+ */
+
+/**
+ * @brief Simulator statistics
+ */
+typedef struct {
+	uint64_t Cycles;			/**< Virtual CPU cycles since HOSTSIM_Init() */
+	uint64_t Accesses;			/**< Trapped peripheral register accesses */
+	uint64_t Interrupts;		/**< Exception handlers dispatched */
+	uint64_t IdleTicks;			/**< Idle ticks granted to RAM spin loops */
+	uint64_t FramesDropped;		/**< UART/EMAC/CAN receive overruns */
+} HOSTSIM_STATS_Type;
+
+/**
+ * @brief SSP/SPI slave device, called once per frame shifted on the bus
+ */
+typedef uint16_t (*HOSTSIM_SSP_DEV_Type)(uint8_t port, uint16_t mosi);
+
+/**
+ * @brief I2C slave device attached to one of the I2C buses
+ */
+typedef struct HOSTSIM_I2C_SLAVE {
+	uint8_t Addr;				/**< 7-bit slave address */
+	uint8_t AddrMask;			/**< Address bits compared against Addr */
+	Bool (*Start)(struct HOSTSIM_I2C_SLAVE *dev, uint8_t sla);	/**< Address phase, return TRUE to ACK */
+	Bool (*Write)(struct HOSTSIM_I2C_SLAVE *dev, uint8_t data);	/**< Master write, return TRUE to ACK */
+	uint8_t (*Read)(struct HOSTSIM_I2C_SLAVE *dev);				/**< Master read */
+	void (*Stop)(struct HOSTSIM_I2C_SLAVE *dev);				/**< Stop condition */
+	struct HOSTSIM_I2C_SLAVE *Next;
+} HOSTSIM_I2C_SLAVE_Type;
+
+/**
+ * @brief Serial EEPROM model built on HOSTSIM_I2C_SLAVE_Type
+ */
+typedef struct {
+	HOSTSIM_I2C_SLAVE_Type Slave;
+	uint8_t *Mem;				/**< Backing store */
+	uint32_t Size;				/**< Size in bytes (power of two) */
+	uint16_t PageSize;			/**< Write page size in bytes */
+	uint8_t AddrBytes;			/**< Word address bytes sent after SLA+W */
+	uint32_t WriteTimeUs;		/**< Internal write cycle (tWR) */
+	/* Private state */
+	uint32_t ptr;
+	uint8_t phase;
+	uint8_t dirty;
+	uint8_t dead;
+	int32_t cut;
+	uint64_t busy_until;
+} HOSTSIM_EEPROM_Type;
+
+/**
+ * @brief CAN frame as seen on the simulated bus
+ */
+typedef struct {
+	uint32_t ID;				/**< 11 or 29 bit identifier */
+	uint8_t Ext;				/**< 1 = extended frame */
+	uint8_t RTR;				/**< 1 = remote frame */
+	uint8_t DLC;				/**< Data length code */
+	uint8_t Data[8];
+} HOSTSIM_CAN_FRAME_Type;
+
+/**
+ * @brief Host side sinks for transmitted data
+ */
+typedef void (*HOSTSIM_UART_SINK_Type)(uint8_t port, uint8_t data);
+typedef void (*HOSTSIM_EMAC_SINK_Type)(const uint8_t *frame, uint32_t len);
+typedef void (*HOSTSIM_CAN_SINK_Type)(uint8_t ctrl, const HOSTSIM_CAN_FRAME_Type *frame);
+
+/**
+ * @brief GPIO output watcher, port and its output latch after and before
+ * the change (equal when the direction changed)
+ */
+typedef void (*HOSTSIM_GPIO_SINK_Type)(uint8_t port, uint32_t out, uint32_t old);
+
+/**
+ * @brief Analog input of the ADC model, 12-bit result of channel ch at
+ * the given virtual time in CPU cycles
+ */
+typedef uint16_t (*HOSTSIM_ADC_SRC_Type)(uint8_t ch, uint64_t cycles);
+
+/**
+ * @brief DAC output watcher, 10-bit AOUT value from the given virtual
+ * time in CPU cycles on
+ */
+typedef void (*HOSTSIM_DAC_SINK_Type)(uint16_t value, uint64_t cycles);
+
+/**
+ * @brief PWM1 period watcher, match values MR0..MR6 in effect for the
+ * period starting at the given virtual time in CPU cycles
+ */
+typedef void (*HOSTSIM_PWM_SINK_Type)(const uint32_t *match, uint64_t cycles);
+
+/**
+ * @brief DC motor on MCPWM channel 0 (locked anti-phase full bridge) with
+ * a quadrature encoder on the QEI
+ */
+typedef struct {
+	double Vbus;				/**< Bridge supply (V) */
+	double R;					/**< Armature resistance (ohm) */
+	double L;					/**< Armature inductance (H), 0 to ignore */
+	double Ke;					/**< Back EMF constant (V s/rad) */
+	double Kt;					/**< Torque constant (N m/A) */
+	double J;					/**< Rotor and load inertia (kg m^2) */
+	double B;					/**< Viscous friction (N m s/rad) */
+	double Friction;			/**< Coulomb friction (N m) */
+	uint32_t Ppr;				/**< Encoder lines per revolution */
+} HOSTSIM_MOTOR_Type;
+
+/**
+ * @brief Firmware loop run by the pcap replay between frames
+ */
+typedef void (*HOSTSIM_POLL_Type)(void);
+
+/**
+ * @}
+ */
+
+/* Public Functions ----------------------------------------------------------- */
+/** @defgroup HOSTSIM_Public_Functions HOSTSIM Public Functions
+ * @{
+ */
+
+/* Simulator control */
+void HOSTSIM_Init(void);
+uint64_t HOSTSIM_GetCycles(void);
+uint64_t HOSTSIM_UsToCycles(uint32_t us);
+void HOSTSIM_Advance(uint64_t cycles);
+void HOSTSIM_GetStats(HOSTSIM_STATS_Type *stats);
+uint32_t HOSTSIM_BusAddr(const void *ptr);
+
+/* CPU core hooks used by core_cmFunc.h / core_cmInstr.h */
+void HOSTSIM_SetPrimask(uint32_t primask);
+uint32_t HOSTSIM_GetPrimask(void);
+uint32_t HOSTSIM_GetIpsr(void);
+void HOSTSIM_WaitForInterrupt(void);
+
+/* GPIO */
+void HOSTSIM_GPIOSetInput(uint8_t port, uint32_t mask, uint32_t value);
+uint32_t HOSTSIM_GPIOGetOutput(uint8_t port);
+uint32_t HOSTSIM_GPIOGetDir(uint8_t port);
+void HOSTSIM_GPIOSetSink(HOSTSIM_GPIO_SINK_Type sink);
+
+/* ADC */
+void HOSTSIM_ADCSetSource(HOSTSIM_ADC_SRC_Type src);
+
+/* DAC */
+void HOSTSIM_DACSetSink(HOSTSIM_DAC_SINK_Type sink);
+
+/* PWM */
+void HOSTSIM_PWMSetSink(HOSTSIM_PWM_SINK_Type sink);
+
+/* Timer capture inputs */
+void HOSTSIM_TimerSetInput(uint8_t timer, uint8_t cap, double hz);
+
+/* MCPWM + QEI motor plant */
+void HOSTSIM_MotorAttach(const HOSTSIM_MOTOR_Type *motor);
+void HOSTSIM_MotorSetLoad(double torque);
+double HOSTSIM_MotorGetSpeed(void);
+
+/* UART */
+uint32_t HOSTSIM_UARTInject(uint8_t port, const uint8_t *data, uint32_t len);
+uint32_t HOSTSIM_UARTCapture(uint8_t port, uint8_t *data, uint32_t len);
+void HOSTSIM_UARTSetSink(uint8_t port, HOSTSIM_UART_SINK_Type sink);
+void HOSTSIM_UARTSetEcho(uint8_t port, Bool echo);
+
+/* SSP */
+void HOSTSIM_SSPAttach(uint8_t port, HOSTSIM_SSP_DEV_Type dev);
+
+/* SPI and SD card */
+void HOSTSIM_SPIAttach(HOSTSIM_SSP_DEV_Type dev);
+Status HOSTSIM_SDCardOpen(const char *path, Bool sdhc);
+void HOSTSIM_SDCardClose(void);
+void HOSTSIM_SDCardInjectCrcError(uint32_t count);
+
+/* I2C */
+void HOSTSIM_I2CAttach(uint8_t bus, HOSTSIM_I2C_SLAVE_Type *dev);
+void HOSTSIM_EEPROMInit(HOSTSIM_EEPROM_Type *ee, uint8_t addr, uint8_t *mem,
+						uint32_t size, uint16_t page, uint8_t addr_bytes);
+void HOSTSIM_EEPROMPowerCut(HOSTSIM_EEPROM_Type *ee, uint32_t bytes);
+void HOSTSIM_EEPROMPowerOn(HOSTSIM_EEPROM_Type *ee);
+
+/* EMAC */
+Status HOSTSIM_EMACInject(const uint8_t *frame, uint32_t len);
+void HOSTSIM_EMACSetSink(HOSTSIM_EMAC_SINK_Type sink);
+void HOSTSIM_EMACSetLink(Bool up);
+int32_t HOSTSIM_EMACReplayPcap(const char *path, HOSTSIM_POLL_Type poll);
+Status HOSTSIM_EMACCapturePcap(const char *path);
+
+/* CAN */
+Status HOSTSIM_CANInject(uint8_t ctrl, const HOSTSIM_CAN_FRAME_Type *frame);
+void HOSTSIM_CANSetSink(HOSTSIM_CAN_SINK_Type sink);
+void HOSTSIM_CANJoinBuses(Bool join);
+
+/**
+ * @}
+ */
+
+#endif /* LPC_HOST_SIM */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LPC_HOST_SIM_H_ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -18,6 +18,7 @@
 /* Includes ------------------------------------------------------------------- */
 #include "LPC17xx.h"
 #include "lpc_system_init.h"
+#include "lpc_eep_writer.h"
 
 
 #ifdef __cplusplus
@@ -31,6 +32,11 @@ extern "C"
  * @{
  */
 #define  E2P24C16_ID    (0xA0>>1)
+#define  E2P24C16_PAGE  16
+#define  E2P24C16_SIZE  2048
+
+/* Page writer descriptor, for EEPW_Submit() and EEPW_GetStats() */
+extern EEPW_DEV_Type E2P24C16_Dev;
 
 
 /**
@@ -18,6 +18,7 @@
 /* Includes ------------------------------------------------------------------- */
 #include "LPC17xx.h"
 #include "lpc_system_init.h"
+#include "lpc_eep_writer.h"
 
 
 #ifdef __cplusplus
@@ -31,6 +32,11 @@ extern "C"
  * @{
  */
 #define  E2PM24256_ID    (0xAE>>1)
+#define  E2PM24256_PAGE  64
+#define  E2PM24256_SIZE  32768
+
+/* Page writer descriptor, for EEPW_Submit() and EEPW_GetStats() */
+extern EEPW_DEV_Type E2PM24256_Dev;
 
 
 /**
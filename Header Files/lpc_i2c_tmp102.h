@@ -85,6 +85,12 @@ typedef enum {
 	TLOW_VAL			/**< Low Threshold value */
 } THRES_Type;
 
+/**
+ * @brief TMP102_Read_Temp_Async() callback, called from the I2C interrupt
+ * with SUCCESS and the temperature in 1/16 degC, or ERROR and 0
+ */
+typedef void (*TMP102_CB_Type)(Status st, int16_t temp);
+
 /**
  * @}
  */
@@ -100,6 +106,7 @@ uchar TMP102_Set_Config(uint16_t val);
 uchar TMP102_Set_Threshold_Value(THRES_Type limit, int16_t deg, BIT_Type res);
 uchar TMP102_Read_Threshold_Value(THRES_Type limit, BIT_Type res);
 uchar TMP102_Read_Temp(BIT_Type res);
+Status TMP102_Read_Temp_Async(BIT_Type res, TMP102_CB_Type cb);
 
 /**
  * @}
@@ -32,9 +32,9 @@ extern "C"
 #define  TSC2004_ID    (0x90>>1)
 
 /* Control byte 0 (Non-Conversion read/write based configuration) */
-#define TSC2004_CMD0(addr, pnd, rw) ((addr<<3)|(pnd<<1)|rw)
+#define TSC2004_CMD0(addr, pnd, rw) (((addr)<<3)|((pnd)<<1)|(rw))
 /* Control byte 1 (Conversion related configuration) */
-#define TSC2004_CMD1(cmd, mode, rst) ((1<<7)|(cmd<<4)|(mode<<2)|(rst<<1))
+#define TSC2004_CMD1(cmd, mode, rst) ((1<<7)|((cmd)<<4)|((mode)<<2)|((rst)<<1))
 
 /* Command Bits */
 #define READ_REG 1
@@ -144,6 +144,9 @@ typedef struct
 	uint16_t z2;
 }ts_event;
 
+/* TSC2004_Read_Values_Async() callback, called from the I2C interrupt */
+typedef void (*TSC2004_CB_Type)(Status st, ts_event *tc);
+
 
 /**
  * @}
@@ -162,6 +165,7 @@ uint16_t I2C_TSC2004_Read_Word (uint8_t Command);
 
 uint16_t TSC2004_Read_Reg (register_address reg);
 void TSC2004_Read_Values (ts_event *tc);
+Status TSC2004_Read_Values_Async (ts_event *tc, TSC2004_CB_Type cb);
 
 void TSC2004_Read_Value_Test (void);
 void TSC2004_Draw_Test (void);
@@ -0,0 +1,134 @@
+/******************************************************************//**
+* @file		lpc_input.h
+* @brief	Contains all macro definitions and function prototypes
+* 			support for the key input subsystem (edge interrupt wake-up,
+* 			timer driven scan, debouncing and the key event queue)
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @defgroup INPUT INPUT
+ * @ingroup LPC1700CMSIS_FwLib_Drivers
+ * @{
+ */
+
+#ifndef LPC_INPUT_H_
+#define LPC_INPUT_H_
+
+/* Includes ------------------------------------------------------------------- */
+#include "LPC17xx.h"
+#include "lpc_types.h"
+#include "lpc_sched.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Public Macros -------------------------------------------------------------- */
+/** @defgroup INPUT_Public_Macros INPUT Public Macros
+ * @{
+ */
+
+/** Scan period while a key is down or bouncing (ms). A key changes state
+ * after 4 scans in a row that disagree with it. */
+#define INPUT_SCAN_MS			5
+/** Time a key is held before it repeats, and the repeat period (ms) */
+#define INPUT_REPEAT_DELAY_MS	500
+#define INPUT_REPEAT_MS			100
+/** Events kept until read, power of two */
+#define INPUT_QUEUE_SIZE		16
+/** Keys of all sources together */
+#define INPUT_KEYS_MAX			64
+
+/** Event types */
+#define INPUT_EV_DOWN			0x01	/**< Key pressed */
+#define INPUT_EV_UP				0x02	/**< Key released */
+#define INPUT_EV_REPEAT			0x03	/**< Key still held, sent for the last
+											 key pressed only */
+
+/**
+ * @}
+ */
+
+
+/* Public Types --------------------------------------------------------------- */
+/** @defgroup INPUT_Public_Types INPUT Public Types
+ * @{
+ */
+
+typedef struct INPUT_SRC_Tag INPUT_SRC_Type;
+
+/**
+ * @brief Key source, e.g. the switches or the matrix keypad. Idle keys
+ * read high on the wake-up pins, a pressed key pulls one of them low.
+ */
+struct INPUT_SRC_Tag
+{
+	uint8_t Keys;				/**< Keys of the source */
+	uint8_t Port;				/**< Port of the wake-up pins, 0 or 2 */
+	uint32_t WakePins;			/**< Pins with a falling edge interrupt */
+	void (*Idle)(void);			/**< Set up the pins so that any key pulls a
+									 wake-up pin low, NULL if nothing to do */
+	uint64_t (*Scan)(void);		/**< Keys down, bit 0 is the first key of
+									 the source. Called from SysTick_Handler. */
+	/* Set by INPUT_Attach() */
+	uint8_t Base;				/**< Number of the first key in events */
+	INPUT_SRC_Type *Next;
+};
+
+/**
+ * @brief Key event
+ */
+typedef struct {
+	uint8_t Key;				/**< Source Base plus key of the source */
+	uint8_t Type;				/**< INPUT_EV_xxx */
+} INPUT_EVENT_Type;
+
+/**
+ * @brief Input counters
+ */
+typedef struct {
+	uint32_t Wakeups;			/**< Edge interrupts that started the scanner */
+	uint32_t Scans;				/**< Scans, none while all keys are up */
+	uint32_t Events;			/**< Events queued */
+	uint32_t Dropped;			/**< Events lost to a full queue */
+} INPUT_STATS_Type;
+
+/**
+ * @}
+ */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @defgroup INPUT_Public_Functions INPUT Public Functions
+ * @{
+ */
+
+void INPUT_Init (SCHED_TASK_Type *task);
+Status INPUT_Attach (INPUT_SRC_Type *src);
+Status INPUT_GetEvent (INPUT_EVENT_Type *ev);
+Bool INPUT_KeyDown (uint8_t key);
+uint64_t INPUT_GetKeys (void);
+void INPUT_IntHandler (void);
+void INPUT_GetStats (INPUT_STATS_Type *stats);
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LPC_INPUT_H_ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -57,7 +57,7 @@ extern "C"
 #define		LCD_DEC_ADD_DISP_SHIFT_OFF  0x04   //decrement address & display shift off
 #define		LCD_DEC_ADD_DISP_SHIFT_ON   0x05   //decrement address & display shift on
 #define		LCD_INC_ADD_DISP_SHIFT_OFF  0X06   //increment address & display shift off
-#define		LCD_INC_ADD_DISP_SHIFT_ON   0X0    //increment address & display shift on
+#define		LCD_INC_ADD_DISP_SHIFT_ON   0X07   //increment address & display shift on
 
 #define		LCD_4BIT_1LINE		0x20		   //4-bit interface, 1 line,  5*7 Pixels
 #define		LCD_4BIT_2LINE		0x28	  	   //4-bit interface, 2 lines, 5*7 Pixels
@@ -114,18 +114,21 @@ typedef enum
 	#define		ROWADDR3		0x94
 	#define		ROWADDR4		0xD4
 	#define 	COLUMNSIZE		20
+	#define 	ROWSIZE			(LCD20X2 ? 2 : 4)
 #elif LCD40X2|LCD40X4
 	#define		ROWADDR1		0x80
 	#define		ROWADDR2		0xC0
 	#define		ROWADDR3		0x80
 	#define		ROWADDR4		0xC0
 	#define 	COLUMNSIZE		40
+	#define 	ROWSIZE			2		// Lines 3, 4 of a 40x4 sit on a second controller
 #elif (LCD16X1|LCD16X2|LCD16X4)
 	#define		ROWADDR1		0x80
 	#define		ROWADDR2		0xC0
 	#define		ROWADDR3		0x90
 	#define		ROWADDR4		0xD0
 	#define 	COLUMNSIZE		16
+	#define 	ROWSIZE			(LCD16X1 ? 1 : (LCD16X2 ? 2 : 4))
 #else
 	#error LCD not selected
 #endif
@@ -161,6 +164,23 @@ typedef enum
 #endif
 
 
+/******************************************************************************/
+/*                       LCD Shadow Buffer                                    */
+/******************************************************************************/
+/* Display functions only write a RAM copy of DDRAM, a periodic task sends
+ * the changed cells to the LCD. Lcd_Flush() sends them at once. */
+#define 	LCD_FLUSH_MS		20			// Flush period in ms
+
+typedef struct
+{
+	uint32_t Flushes;			// Flushes that found something to send
+	uint32_t Cells;				// Characters written to DDRAM
+	uint32_t Moves;				// DDRAM address commands
+	uint32_t Polls;				// Busy flag reads
+	uint32_t Timeouts;			// Busy flag stuck, fixed delays are used after the first
+}LCD_STATS_Type;
+
+
 /**
  * @}
  */
@@ -182,6 +202,9 @@ void Display_String (uchar *String, uchar LineNum, uchar Position, CursorType_e
 void Display_Shift (ShiftDir_e Direction, CursorType_e CursorType);
 void CGRAM_Char_Gen (uchar loc,uchar *p);
 void Display_Decimal_Lcd (uint16 VarData, uchar Row, uchar Col);
+void Lcd_Clear (void);
+void Lcd_Flush (void);
+void Lcd_GetStats (LCD_STATS_Type *stats);
 
 
 /**
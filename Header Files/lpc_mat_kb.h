@@ -18,6 +18,7 @@
 /* Includes ------------------------------------------------------------------- */
 #include "LPC17xx.h"
 #include "lpc_types.h"
+#include "lpc_input.h"
 
 
 #ifdef __cplusplus
@@ -40,32 +41,25 @@ extern "C"
 /******************************************************************************/
 /*                           MAT_KB Selection                                 */
 /******************************************************************************/
-#define		MATKB_2X2			ENABLE
-#define		MATKB_3X3			DISABLE
-#define		MATKB_4X4			DISABLE
-#define		MATKB_5X5			DISABLE
-#define		MATKB_6X6			DISABLE
-#define		MATKB_7X7			DISABLE
-#define		MATKB_8X8			DISABLE
+#define		MATKB_ROWS			2			// Rows, driven low one at a time
+#define		MATKB_COLS			2			// Columns, read with the pull-ups on
+
+#define		MATKB_ROW_PORT		0			// Rows on consecutive pins
+#define		MATKB_ROW_PIN		19			// of this port from this pin on
+#define		MATKB_COL_PORT		0			// Columns likewise, port 0 or 2
+#define		MATKB_COL_PIN		21			// which have edge interrupts
 
 /******************************************************************************/
-/*                           MAT_KB Selection                                 */
+/*                       MAT_KB Selection Validation                          */
 /******************************************************************************/
-#if MATKB_2X2
-	#define ROW 	2
-	#undef ROW3
-	#undef ROW4
-	#undef ROW5
-	#undef ROW6
-	#undef ROW7
-	#undef ROW8
-
-	#undef COL3
-	#undef COL4
-	#undef COL5
-	#undef COL6
-	#undef COL7
-	#undef COL8
+#if ((MATKB_ROWS * MATKB_COLS) > 64) || (MATKB_ROWS < 1) || (MATKB_COLS < 1)
+	#error Matrix size not correctly defined
+#endif
+#if ((MATKB_COL_PORT != 0) && (MATKB_COL_PORT != 2))
+	#error Columns need a port with edge interrupts
+#endif
+#if ((MATKB_ROW_PIN + MATKB_ROWS) > 32) || ((MATKB_COL_PIN + MATKB_COLS) > 32)
+	#error Matrix pins not correctly defined
 #endif
 
 
@@ -81,6 +75,7 @@ extern "C"
 
 void Mat_Kb_Init(void);
 uint16 Detect_Mat_Key(void);
+uint16 Mat_Kb_Code(uint8_t key);
 
 
 /**
@@ -0,0 +1,141 @@
+/******************************************************************//**
+* @file		lpc_net.h
+* @brief	Contains all macro definitions and function prototypes
+* 			support for the ARP/IPv4/ICMP/UDP stack on the EMAC rings
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @defgroup NET NET
+ * @ingroup LPC1700CMSIS_FwLib_Drivers
+ * @{
+ */
+
+#ifndef LPC_NET_H_
+#define LPC_NET_H_
+
+/* Includes ------------------------------------------------------------------- */
+#include "LPC17xx.h"
+#include "lpc_types.h"
+#include "lpc17xx_emac.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Public Macros -------------------------------------------------------------- */
+/** @defgroup NET_Public_Macros NET Public Macros
+ * @{
+ */
+
+/** Stack sizes, all tables are static */
+#define NET_ARP_ENTRIES			8		/**< ARP cache entries */
+#define NET_ARP_MAX_AGE			1200	/**< ARP entry lifetime (s) */
+#define NET_ARP_WAIT			3		/**< Seconds a frame waits for ARP */
+#define NET_UDP_SOCKETS			4		/**< Bound UDP ports */
+#define NET_IP_TTL				64		/**< TTL of sent datagrams */
+
+/** IPv4 address a.b.c.d as stored in a frame (network order word) */
+#define NET_IP4(a, b, c, d)		((uint32_t)(a) | ((uint32_t)(b) << 8) | \
+								((uint32_t)(c) << 16) | ((uint32_t)(d) << 24))
+#define NET_IP_BROADCAST		((uint32_t)0xFFFFFFFF)
+
+/** Header lengths of a UDP datagram without IP options */
+#define NET_ETH_HLEN			14
+#define NET_IP_HLEN				20
+#define NET_UDP_HLEN			(NET_ETH_HLEN + NET_IP_HLEN + 8)
+/** Largest UDP payload that fits an unfragmented frame */
+#define NET_UDP_MAX_DATA		(1500 - NET_IP_HLEN - 8)
+/** Payload area of a buffer claimed by NET_UdpClaim() */
+#define NET_UDP_DATA(pbuf)		((pbuf)->pbData + NET_UDP_HLEN)
+
+/**
+ * @}
+ */
+
+
+/* Public Types --------------------------------------------------------------- */
+/** @defgroup NET_Public_Types NET Public Types
+ * @{
+ */
+
+/**
+ * @brief Interface configuration, addresses in NET_IP4() form
+ */
+typedef struct {
+	uint8_t Mac[6];				/**< MAC address, same as given to EMAC_Init() */
+	uint32_t Ip;				/**< Own address */
+	uint32_t Mask;				/**< Subnet mask */
+	uint32_t Gateway;			/**< Default gateway, 0 for none */
+} NET_CFG_Type;
+
+/**
+ * @brief UDP receive callback
+ * Data points into the Rx ring and is only valid during the call.
+ * Ports are in host order.
+ */
+typedef void (*NET_UDP_CB_Type)(uint32_t srcIp, uint16_t srcPort, uint16_t dstPort,
+		const uint8_t *data, uint16_t len);
+
+/**
+ * @brief Stack statistics
+ */
+typedef struct {
+	uint32_t RxFrames;			/**< Frames taken from the Rx ring */
+	uint32_t RxDropped;			/**< Malformed, unsupported or not for us */
+	uint32_t ChecksumErrors;	/**< IP, ICMP or UDP checksum mismatches */
+	uint32_t ArpReplies;		/**< ARP replies sent */
+	uint32_t EchoReplies;		/**< ICMP echo replies sent */
+	uint32_t UdpReceived;		/**< Datagrams passed to a socket */
+	uint32_t UdpSent;			/**< Datagrams queued on the EMAC */
+	uint32_t TxBusy;			/**< Replies lost for lack of a Tx buffer */
+} NET_STATS_Type;
+
+/**
+ * @}
+ */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @defgroup NET_Public_Functions NET Public Functions
+ * @{
+ */
+
+void NET_Init(const NET_CFG_Type *cfg);
+uint32_t NET_Poll(void);
+void NET_SecondTick(void);
+void NET_GetStats(NET_STATS_Type *stats);
+
+Status NET_ArpLookup(uint32_t ip, uint8_t *mac);
+void NET_ArpRequest(uint32_t ip);
+
+uint32_t NET_ChecksumAdd(uint32_t sum, const uint8_t *data, uint32_t len);
+
+Status NET_UdpBind(uint16_t port, NET_UDP_CB_Type cb);
+void NET_UdpUnbind(uint16_t port);
+Status NET_UdpClaim(EMAC_PBUF_Type *pbuf);
+Status NET_UdpSend(EMAC_PBUF_Type *pbuf, uint32_t dstIp, uint16_t srcPort,
+		uint16_t dstPort, uint16_t len);
+Status NET_UdpSendTo(uint32_t dstIp, uint16_t srcPort, uint16_t dstPort,
+		const uint8_t *data, uint16_t len);
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LPC_NET_H_ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -0,0 +1,179 @@
+/******************************************************************//**
+* @file		lpc_prof.h
+* @brief	Contains all macro definitions and function prototypes
+* 			support for the cycle profiler (DWT CYCCNT scoped counters,
+* 			per-ISR latency and duration histograms, binary dump)
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @defgroup PROF PROF
+ * @ingroup LPC1700CMSIS_FwLib_Drivers
+ * @{
+ */
+
+#ifndef LPC_PROF_H_
+#define LPC_PROF_H_
+
+/* Includes ------------------------------------------------------------------- */
+#include "LPC17xx.h"
+#include "lpc_types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Public Macros -------------------------------------------------------------- */
+/** @defgroup PROF_Public_Macros PROF Public Macros
+ * @{
+ */
+
+#ifndef ENABLE
+#define	ENABLE		1
+#endif
+#ifndef DISABLE
+#define DISABLE		0
+#endif
+
+/******************************************************************************/
+/*                       Profiler Select                                      */
+/******************************************************************************/
+/* With PROF_SEL disabled the PROF_xxx() hooks below expand to nothing and
+ * lpc_prof.c builds no target code: the drivers compile exactly as without
+ * the profiler. Enabled it takes about 4.5 KB of RAM. */
+#ifndef PROF_SEL
+#define 	PROF_SEL           DISABLE      // Cycle profiler
+#endif
+
+#if PROF_SEL
+	#define PROF_MODE
+#endif
+
+/** DWT cycle counter, not described by this core_cm3.h */
+#define PROF_DWT_CTRL			(*(__IO uint32_t *)0xE0001000UL)
+#define PROF_DWT_CYCCNT			(*(__IO uint32_t *)0xE0001004UL)
+#define PROF_DWT_CYCCNTENA		((uint32_t)(1<<0))
+
+/** CPU cycles now, wraps every 43 s at 100 MHz */
+#define PROF_Cycles()			(PROF_DWT_CYCCNT)
+
+/** Call tree nodes (distinct call paths) */
+#define PROF_NODES				48
+/** Deepest nesting of scopes and interrupts */
+#define PROF_DEPTH				16
+/** Interrupts with histograms, slots are taken on first entry */
+#define PROF_ISR_SLOTS			16
+/** Log2 histogram: bucket 0 counts 0..7 cycles, bucket n (n >= 1) counts
+ * 2^(n+2) .. 2^(n+3)-1 cycles, the last one everything above */
+#define PROF_HIST_BUCKETS		16
+#define PROF_HIST_SHIFT			3
+
+/** Scope ids of the instrumented driver paths. Application scopes use
+ * PROF_ID_USER and up, interrupts PROF_ID_IRQ(). */
+#define PROF_ID_UART_SEND		0
+#define PROF_ID_SSP_RW			1
+#define PROF_ID_I2C_XFER		2
+#define PROF_ID_GLCD_CLEAR		3
+#define PROF_ID_GLCD_FILL		4
+#define PROF_ID_GLCD_BITMAP		5
+#define PROF_ID_GLCD_LINE		6
+#define PROF_ID_GLCD_RECT		7
+#define PROF_ID_GLCD_CIRCLE		8
+#define PROF_ID_GLCD_TEXT		9
+#define PROF_ID_GLCD_FLUSH		10
+#define PROF_ID_GLCD_PIXELS		11
+#define PROF_ID_GLCD_RUN		12
+#define PROF_ID_CALIBRATE		31
+#define PROF_ID_USER			32
+#define PROF_ID_IRQ(irq)		((uint8_t)(0x80 | (irq)))
+
+/** Profiler hooks, see PROF_Begin() and PROF_IsrEnter() */
+#ifdef PROF_MODE
+#define PROF_BEGIN(id)			PROF_Begin(id)
+#define PROF_END(id)			PROF_End(id)
+#define PROF_ISR_ENTER(irq)		PROF_IsrEnter(irq)
+#define PROF_ISR_EXIT(irq)		PROF_IsrExit(irq)
+#define PROF_ISR_PEND(irq)		PROF_IsrPend(irq)
+#else
+#define PROF_BEGIN(id)			((void)0)
+#define PROF_END(id)			((void)0)
+#define PROF_ISR_ENTER(irq)		((void)0)
+#define PROF_ISR_EXIT(irq)		((void)0)
+#define PROF_ISR_PEND(irq)		((void)0)
+#endif
+
+/** Dump frame: "PROF", PROF_DUMP_VERSION, then LEB128 varints and a
+ * CRC-16 (CCITT, as CRC16_Calc()) of everything before it, low byte first */
+#define PROF_DUMP_VERSION		1
+
+/**
+ * @}
+ */
+
+
+/* Public Types --------------------------------------------------------------- */
+/** @defgroup PROF_Public_Types PROF Public Types
+ * @{
+ */
+
+/**
+ * @brief Profiler counters
+ */
+typedef struct {
+	uint32_t Overhead;			/**< Cycles of an empty PROF_Begin()/PROF_End()
+									 pair, measured by PROF_Init() */
+	uint32_t Overflow;			/**< Scopes not timed, nesting over PROF_DEPTH */
+	uint32_t Mismatch;			/**< PROF_End()/PROF_IsrExit() not matching
+									 the innermost scope */
+	uint32_t NodeFull;			/**< Scopes not timed, no free call tree node */
+	uint32_t IsrFull;			/**< Interrupt entries without a histogram slot */
+} PROF_STATS_Type;
+
+/**
+ * @}
+ */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @defgroup PROF_Public_Functions PROF Public Functions
+ * @{
+ */
+
+#ifdef PROF_MODE
+void PROF_Init (void);
+void PROF_Cmd (FunctionalState NewState);
+void PROF_Reset (void);
+void PROF_Begin (uint8_t id);
+void PROF_End (uint8_t id);
+void PROF_IsrEnter (uint8_t irq);
+void PROF_IsrExit (uint8_t irq);
+void PROF_IsrPend (uint8_t irq);
+uint32_t PROF_Dump (LPC_UART_TypeDef *UARTx);
+void PROF_GetStats (PROF_STATS_Type *stats);
+#endif
+
+#ifdef LPC_HOST_SIM
+Status PROF_Decode (const uint8_t *buf, uint32_t len);
+Status PROF_DecodeFile (const char *path);
+#endif
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LPC_PROF_H_ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -0,0 +1,135 @@
+/******************************************************************//**
+* @file		lpc_pwm_seq.h
+* @brief	Contains all macro definitions and function prototypes
+* 			support for the PWM1 duty engine (latched multi-channel
+* 			updates, gamma corrected levels and duty sequences)
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @defgroup PWMSEQ PWMSEQ
+ * @ingroup LPC1700CMSIS_FwLib_Drivers
+ * @{
+ */
+
+#ifndef LPC_PWM_SEQ_H_
+#define LPC_PWM_SEQ_H_
+
+/* Includes ------------------------------------------------------------------- */
+#include "LPC17xx.h"
+#include "lpc_types.h"
+#include "lpc17xx_pwm.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Public Macros -------------------------------------------------------------- */
+/** @defgroup PWMSEQ_Public_Macros PWMSEQ Public Macros
+ * @{
+ */
+
+/** PWM1 counter clock: PCLK, which PWM_Init() sets to CCLK/4 */
+#define PWMSEQ_PCLK_HZ			25000000UL
+/** Default PWM frequency (Hz) */
+#define PWMSEQ_FREQ_HZ			1000
+
+/** Duty in percent, 8 fraction bits: PWMSEQ_PCT(12.5) is 12.5% */
+#define PWMSEQ_PCT(pct)			((uint16_t)((pct) * 256))
+#define PWMSEQ_DUTY_FULL		PWMSEQ_PCT(100)
+
+/** Counter clocks per period of a frequency, MR0 is one less */
+#define PWMSEQ_COUNTS(hz)		(PWMSEQ_PCLK_HZ / (hz))
+/** Match value of a duty at a frequency. PWMSEQ_DUTY_FULL gives a match
+ * past MR0, so the output never goes low. */
+#define PWMSEQ_MATCH(hz, duty)	((uint32_t)(((uint64_t)PWMSEQ_COUNTS(hz) * (duty)) / PWMSEQ_DUTY_FULL))
+/** Periods in a time at a frequency, for PWMSEQ_SEQ_Type.Periods */
+#define PWMSEQ_PERIODS(hz, ms)	((uint16_t)(((uint32_t)(hz) * (ms)) / 1000))
+
+#if (PWMSEQ_COUNTS(PWMSEQ_FREQ_HZ) < 256)
+#error "PWMSEQ_FREQ_HZ too high: fewer than 256 duty steps"
+#endif
+
+/** Channels PWM1.1 to PWM1.6, on P2.0 to P2.5 */
+#define PWMSEQ_CHANNELS			6
+
+/**
+ * @}
+ */
+
+
+/* Public Types --------------------------------------------------------------- */
+/** @defgroup PWMSEQ_Public_Types PWMSEQ Public Types
+ * @{
+ */
+
+/**
+ * @brief Level sequence. The level moves linearly from each entry to
+ * the next in Periods PWM periods, levels go through the gamma curve.
+ */
+typedef struct {
+	const uint8_t *Level;		/**< Levels 0..255 */
+	uint16_t Count;				/**< Entries, at least 2 */
+	uint16_t Periods;			/**< PWM periods from one entry to the next */
+	Bool Loop;					/**< Start over at the end, the last entry
+									 should equal the first. Otherwise hold
+									 the last level. */
+} PWMSEQ_SEQ_Type;
+
+/**
+ * @brief Engine counters
+ */
+typedef struct {
+	uint32_t Periods;			/**< MR0 interrupts served */
+	uint32_t Latches;			/**< Sets of match registers latched */
+} PWMSEQ_STATS_Type;
+
+/**
+ * @}
+ */
+
+
+/* Public Variables ----------------------------------------------------------- */
+/** Breathing curve, 32 levels that loop */
+extern const PWMSEQ_SEQ_Type PWMSEQ_Breathe;
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @defgroup PWMSEQ_Public_Functions PWMSEQ Public Functions
+ * @{
+ */
+
+void PWMSEQ_Init (uint32_t hz);
+void PWMSEQ_SetFreq (uint32_t hz);
+void PWMSEQ_ChannelCmd (uint8_t ch, FunctionalState NewState);
+void PWMSEQ_SetDuty (uint8_t ch, uint16_t duty);
+void PWMSEQ_SetLevel (uint8_t ch, uint8_t level);
+void PWMSEQ_Latch (void);
+uint16_t PWMSEQ_Gamma (uint8_t level);
+Status PWMSEQ_Play (uint8_t ch, const PWMSEQ_SEQ_Type *seq);
+Status PWMSEQ_Fade (uint8_t ch, uint8_t level, uint16_t periods);
+void PWMSEQ_Hold (uint8_t ch);
+Bool PWMSEQ_Busy (uint8_t ch);
+void PWMSEQ_IntHandler (void);
+void PWMSEQ_GetStats (PWMSEQ_STATS_Type *stats);
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LPC_PWM_SEQ_H_ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
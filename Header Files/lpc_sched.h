@@ -0,0 +1,146 @@
+/******************************************************************//**
+* @file		lpc_sched.h
+* @brief	Contains all macro definitions and function prototypes
+* 			support for the SysTick timer wheel and the cooperative
+* 			task scheduler
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @defgroup SCHED SCHED
+ * @ingroup LPC1700CMSIS_FwLib_Drivers
+ * @{
+ */
+
+#ifndef LPC_SCHED_H_
+#define LPC_SCHED_H_
+
+/* Includes ------------------------------------------------------------------- */
+#include "LPC17xx.h"
+#include "lpc_types.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Public Macros -------------------------------------------------------------- */
+/** @defgroup SCHED_Public_Macros SCHED Public Macros
+ * @{
+ */
+
+/** Timer wheel: SCHED_WHEEL_LEVELS levels of 2^SCHED_WHEEL_BITS slots, a
+ * level slot spans all slots of the level below. With 1 ms ticks four
+ * levels of 64 reach 4.6 hours, longer timers are cascaded again. */
+#define SCHED_WHEEL_BITS	6
+#define SCHED_WHEEL_LEVELS	4
+#define SCHED_WHEEL_SLOTS	(1 << SCHED_WHEEL_BITS)
+
+/** Task priorities, 0 is the highest */
+#define SCHED_PRIO_LEVELS	8
+#define SCHED_PRIO_HIGH		0
+#define SCHED_PRIO_LOW		(SCHED_PRIO_LEVELS - 1)
+
+/**
+ * @}
+ */
+
+
+/* Public Types --------------------------------------------------------------- */
+/** @defgroup SCHED_Public_Types SCHED Public Types
+ * @{
+ */
+
+typedef struct SCHED_TIMER_Tag SCHED_TIMER_Type;
+typedef struct SCHED_TASK_Tag SCHED_TASK_Type;
+
+/** Timer expiry, called from SysTick_Handler: keep it short and post a
+ * task for anything longer */
+typedef void (*SCHED_TIMER_CB_Type)(SCHED_TIMER_Type *tmr);
+/** Task body, runs to completion in thread mode */
+typedef void (*SCHED_TASK_CB_Type)(SCHED_TASK_Type *task);
+
+/**
+ * @brief Software timer, set up with SCHED_TimerInit()
+ */
+struct SCHED_TIMER_Tag
+{
+	SCHED_TIMER_CB_Type Callback;	/**< Called on expiry */
+	void *Arg;						/**< Free for the caller */
+	uint32_t Expires;				/**< Tick of the next expiry */
+	uint32_t Period;				/**< Reload in ticks, 0 for one shot, may be
+										 changed by the callback */
+	/* Wheel slot link */
+	SCHED_TIMER_Type *next;
+	SCHED_TIMER_Type **pprev;		/* NULL when not pending */
+};
+
+/**
+ * @brief Run to completion task, set up with SCHED_TaskInit()
+ */
+struct SCHED_TASK_Tag
+{
+	SCHED_TASK_CB_Type Func;		/**< Task body */
+	void *Arg;						/**< Free for the caller */
+	uint8_t Prio;					/**< 0 .. SCHED_PRIO_LEVELS-1, 0 runs first */
+	__IO uint8_t Posted;			/**< Waiting in a ready queue */
+	SCHED_TASK_Type *Next;			/**< Ready queue link, used by the scheduler */
+};
+
+/**
+ * @brief Scheduler counters
+ */
+typedef struct {
+	uint32_t Ticks;					/**< SysTick ticks since SCHED_Init() */
+	uint32_t Expired;				/**< Timer callbacks */
+	uint32_t Cascaded;				/**< Timers moved down a wheel level */
+	uint32_t Dispatched;			/**< Task runs */
+	uint32_t Yields;				/**< SCHED_Yield() calls, e.g. from delay_ms() */
+	uint32_t Sleeps;				/**< Yields that found nothing to run and waited */
+} SCHED_STATS_Type;
+
+/**
+ * @}
+ */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @defgroup SCHED_Public_Functions SCHED Public Functions
+ * @{
+ */
+
+void SCHED_Init (void);
+void SCHED_Tick (void);
+uint32_t SCHED_GetTicks (void);
+
+void SCHED_TimerInit (SCHED_TIMER_Type *tmr, SCHED_TIMER_CB_Type cb, void *arg);
+void SCHED_TimerStart (SCHED_TIMER_Type *tmr, uint32_t delay, uint32_t period);
+void SCHED_TimerStop (SCHED_TIMER_Type *tmr);
+Bool SCHED_TimerPending (SCHED_TIMER_Type *tmr);
+
+void SCHED_TaskInit (SCHED_TASK_Type *task, SCHED_TASK_CB_Type func, void *arg, uint8_t prio);
+void SCHED_Post (SCHED_TASK_Type *task);
+Bool SCHED_Dispatch (void);
+void SCHED_Yield (void);
+void SCHED_Run (void);
+void SCHED_GetStats (SCHED_STATS_Type *stats);
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LPC_SCHED_H_ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -18,6 +18,8 @@
 /* Includes ------------------------------------------------------------------- */
 #include "LPC17xx.h"
 #include "lpc_system_init.h"
+#include "lpc17xx_spi.h"
+#include "lpc_crc.h"
 
 
 #ifdef __cplusplus
@@ -48,16 +50,30 @@ typedef enum _sd_error
 	SD_ERROR_CMD0,
 	SD_ERROR_CMD55,
 	SD_ERROR_ACMD41,
-	SD_ERROR_CMD59
+	SD_ERROR_CMD59,
+	SD_ERROR_CMD8,
+	SD_ERROR_CMD58,
+	SD_ERROR_CRC,
+	SD_ERROR_DATA,
+	SD_ERROR_RANGE
 }sd_error;
 
+typedef enum _sd_card_type
+{
+	SD_CARD_NONE,
+	SD_CARD_V1,					/* SD v1.x, byte addressed */
+	SD_CARD_V2,					/* SD v2.0 standard capacity, byte addressed */
+	SD_CARD_HC					/* SDHC/SDXC, block addressed */
+}sd_card_type;
+
 //SD command code
 #define 	CMD0_GO_IDLE_STATE            0x00
 #define		CMD1_SEND_OPCOND              0x01
+#define 	CMD8_SEND_IF_COND             0x08
 #define 	CMD9_SEND_CSD                 0x09
 #define 	CMD10_SEND_CID                0x0a
-#define  	CMD12_STOP_TRANSMISSION       0x0b
-#define 	CMD13_SEND_STATUS             0x0c
+#define  	CMD12_STOP_TRANSMISSION       0x0c
+#define 	CMD13_SEND_STATUS             0x0d
 #define 	CMD16_SET_BLOCKLEN            0x10
 #define 	CMD17_READ_SINGLE_BLOCK       0x11
 #define 	CMD18_READ_MULTIPLE_BLOCK     0x12
@@ -99,15 +115,52 @@ typedef enum _sd_error
 #define 	R2_WP_VIOL     				  0x20
 #define 	R2_ERASE_PARAM 				  0x40
 #define 	R2_RANGE_ERR   				  0x80
+/* Data tokens and data response */
+#define 	SD_TOKEN_START				  0xFE
+#define 	SD_TOKEN_MULTI_START		  0xFC
+#define 	SD_TOKEN_STOP_TRAN			  0xFD
+#define 	SD_DATA_RESP_MASK			  0x1F
+#define 	SD_DATA_ACCEPTED			  0x05
+#define 	SD_DATA_CRC_ERR				  0x0B
+#define 	SD_DATA_WRITE_ERR			  0x0D
 
 #define GETBIT(in, bit) ((in & (1<<bit)) >> bit)
 #define SD_CMD_BLOCK_LENGTH		6
 #define SD_DATA_BLOCK_LENGTH	515
 #define SD_WAIT_R1_TIMEOUT		100000
 
+/* Block layer */
+#define SD_BLOCK_SIZE			512
+#define SD_CLOCK_INIT			400000		/* Identification clock (Hz) */
+#define SD_CLOCK_MAX			25000000	/* Transfer clock limit (Hz) */
+#define SD_CRC_RETRIES			3			/* Retries of a block failing CRC */
+#define SD_INIT_TIMEOUT			10000		/* ACMD41 polls */
+#define SD_TOKEN_TIMEOUT		200000		/* Byte times waiting for a data token */
+#define SD_BUSY_TIMEOUT			500000		/* Byte times waiting for DO high */
 
-uint8_t sd_cmd_buf[SD_CMD_BLOCK_LENGTH];
-uint8_t sd_data_buf[SD_DATA_BLOCK_LENGTH];
+
+extern uint8_t sd_cmd_buf[SD_CMD_BLOCK_LENGTH];
+extern uint8_t sd_data_buf[SD_DATA_BLOCK_LENGTH];
+
+/**
+ * @}
+ */
+
+
+/* Public Types --------------------------------------------------------------- */
+/** @defgroup SD_Public_Types SD Public Types
+ * @{
+ */
+
+/**
+ * @brief Card found by SD_Init()
+ */
+typedef struct {
+	sd_card_type Type;			/**< Card version and addressing */
+	uint32_t Blocks;			/**< Capacity in 512 byte blocks */
+	uint32_t Clock;				/**< SPI clock after the ramp up (Hz) */
+	uint32_t CrcErrors;			/**< Blocks sent again after a CRC mismatch */
+} SD_INFO_Type;
 
 /**
  * @}
@@ -120,8 +173,6 @@ uint8_t sd_data_buf[SD_DATA_BLOCK_LENGTH];
  */
 
 sd_connect_status SD_GetCardConnectStatus (void);
-uint8_t CRC_7 (uint8_t old_crc, uint8_t data);
-uint8_t CRC_7Final (uint8_t old_crc);
 uint32_t SD_SendReceiveData_Polling (void* tx_buf, void* rx_buf, uint32_t length);
 void SD_SendCommand(uint8_t cmd, uint8_t *arg);
 sd_error SD_WaitR1 (uint8_t *buffer, uint32_t length, uint32_t timeout);
@@ -130,6 +181,10 @@ sd_error SD_Init (uint8_t retries);
 sd_error SD_GetCID (void);
 void SD_ErrorMsg (sd_error sd_status);
 
+sd_error SD_ReadBlocks (uint32_t block, uint8_t *buf, uint32_t count);
+sd_error SD_WriteBlocks (uint32_t block, const uint8_t *buf, uint32_t count);
+void SD_GetInfo (SD_INFO_Type *info);
+
 
 
 
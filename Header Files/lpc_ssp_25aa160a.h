@@ -18,6 +18,7 @@
 /* Includes ------------------------------------------------------------------- */
 #include "LPC17xx.h"
 #include "lpc_system_init.h"
+#include "lpc_eep_writer.h"
 
 
 #ifdef __cplusplus
@@ -38,6 +39,12 @@ extern "C"
 #define EEP_RDSR   0x05;  /* Read Status Reg     */
 #define EEP_WRSR   0x01;  /* Write Status Reg    */
 
+#define E2P25AA160A_PAGE   16
+#define E2P25AA160A_SIZE   2048
+
+/* Page writer descriptor, for EEPW_Submit() and EEPW_GetStats() */
+extern EEPW_DEV_Type E2P25AA160A_Dev;
+
 /**
  * @}
  */
@@ -19,6 +19,7 @@
 #include "LPC17xx.h"
 #include "lpc_system_init.h"
 #include "stdarg.h"
+#include "lpc_fmt.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -71,6 +72,24 @@ extern "C"
 #define BPP         16                  /* Bits per pixel                     */
 #define BYPP        ((BPP+7)/8)         /* Bytes per pixel                    */
 
+/*---------------------- Pixel stream configuration --------------------------*/
+
+/* GPDMA streaming needs GPDMA_Init() before GLCD_Init()                      */
+#define GLCD_DMA_SEL            DISABLE     /* Stream long runs through GPDMA  */
+#define GLCD_DMA_MIN_PIXELS     256         /* Shorter runs are sent by the CPU */
+#define GLCD_DIRTY_MAX          8           /* Dirty rectangles tracked        */
+#define GLCD_DIRTY_MERGE_COST   64          /* Window setup cost in pixels     */
+/* Opaque text paints each cell in BackColor over what is behind it and wraps
+ * by the glyph height, keep it DISABLE for the transparent GLCD_Text()      */
+#define GLCD_TEXT_OPAQUE_SEL    DISABLE     /* GLCD_Text cells in BackColor    */
+
+#if GLCD_DMA_SEL
+	#define GLCD_DMA_MODE
+	#include "lpc17xx_gpdma.h"
+	/* Transfer chain long enough for a full screen */
+	#define GLCD_DMA_LLI_NUM    ((WIDTH*HEIGHT + GPDMA_MAX_XFER - 1)/GPDMA_MAX_XFER)
+#endif
+
 /**
  * @brief GLCD Driver Output Type definitions
  */
@@ -108,6 +127,22 @@ typedef struct
 	uint16_t fill_color;
 }COLORCFG_Type;
 
+/* Rectangle Type */
+typedef struct
+{
+	uint16_t x;
+	uint16_t y;
+	uint16_t w;
+	uint16_t h;
+}GLCD_RECT_Type;
+
+/* Dirty Rectangle List Type */
+typedef struct
+{
+	GLCD_RECT_Type rect[GLCD_DIRTY_MAX];
+	uint8_t num;
+}GLCD_DIRTY_Type;
+
 /**
  * @}
  */
@@ -135,6 +170,13 @@ void GLCD_Display_String (uint16_t ln, uint16_t col, uchar *s);
 void GLCD_ClearLn (uint16_t ln);
 void GLCD_Bitmap (uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t *bitmap);
 void GLCD_Window_Fill (uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+void GLCD_Stream_Start (uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+void GLCD_Stream_Pixels (const uint16_t *p, uint32_t count);
+void GLCD_Stream_Fill (uint16_t color, uint32_t count);
+void GLCD_Stream_Stop (void);
+void GLCD_Dirty_Init (GLCD_DIRTY_Type *d);
+void GLCD_Dirty_Add (GLCD_DIRTY_Type *d, uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+uint32_t GLCD_Dirty_Flush (GLCD_DIRTY_Type *d, const uint16_t *fb, const GLCD_RECT_Type *area);
 void GLCD_Line(int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color);
 void GLCD_Rect(COORDINATE_Type *p1, COORDINATE_Type *p2, Bool fill, uint16_t color, uint16_t fill_color);
 void GLCD_Frame(COORDINATE_Type *p1, COORDINATE_Type *p2, int16_t frame_width, uint16_t color, uint16_t fill_color);
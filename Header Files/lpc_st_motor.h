@@ -0,0 +1,141 @@
+/******************************************************************//**
+* @file		lpc_st_motor.h
+* @brief	Contains all macro definitions and function prototypes
+* 			support for the Stepper Motor motion engine (timer match
+* 			stepping, trapezoidal ramps and the move queue)
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @defgroup ST_MOTOR ST_MOTOR
+ * @ingroup LPC1700CMSIS_FwLib_Drivers
+ * @{
+ */
+
+#ifndef LPC_ST_MOTOR_H_
+#define LPC_ST_MOTOR_H_
+
+/* Includes ------------------------------------------------------------------- */
+#include "LPC17xx.h"
+#include "lpc_types.h"
+#include "lpc17xx_timer.h"
+#include "lpc_sched.h"
+
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/* Public Macros -------------------------------------------------------------- */
+/** @defgroup ST_MOTOR_Public_Macros ST_MOTOR Public Macros
+ * @{
+ */
+
+/** Step timer. Its MR0 interrupt steps the motor, TIMERn_IRQHandler
+ * must call STM_IntHandler(). */
+#define STM_TIM					LPC_TIM2
+#define STM_TIM_IRQn			TIMER2_IRQn
+/** Step timer count rate (Hz), the timer counts microseconds */
+#define STM_TICK_HZ				1000000UL
+
+/** Coil outputs: P1.19, P1.21, P1.23 and P1.25 drive coils A, B, A' and B' */
+#define STM_PORT				1
+#define STM_PIN_SHIFT			18
+#define STM_PINS				_SBF(STM_PIN_SHIFT, 0xAA)
+
+/** Full steps per revolution of the motor */
+#define STM_STEPS_REV			200
+/** Moves waiting behind the running one, power of two */
+#define STM_QUEUE_SIZE			8
+/** Highest step rate accepted (steps/s) */
+#define STM_SPEED_MAX			5000
+
+/** Step modes */
+#define STM_FULL_STEP			0	/**< Two coils on, STM_STEPS_REV steps per turn */
+#define STM_HALF_STEP			1	/**< One and two coils on in turn, twice the steps */
+
+/**
+ * @}
+ */
+
+
+/* Public Types --------------------------------------------------------------- */
+/** @defgroup ST_MOTOR_Public_Types ST_MOTOR Public Types
+ * @{
+ */
+
+/**
+ * @brief Direction of rotation
+ */
+typedef enum {
+	StMotorClockwise = 0,
+	StMotorAntiClockwise
+} StMotorDirection_e;
+
+/**
+ * @brief Move. Every move starts and ends at rest.
+ */
+typedef struct {
+	int32_t Steps;				/**< Steps of the current step mode, negative
+									 turns anti-clockwise */
+	uint32_t Speed;				/**< Cruise speed (steps/s) */
+	uint32_t Accel;				/**< Acceleration (steps/s^2), 0 starts and
+									 stops at cruise speed */
+	uint32_t Decel;				/**< Deceleration (steps/s^2), 0 uses Accel */
+} STM_MOVE_Type;
+
+/**
+ * @brief Motion counters
+ */
+typedef struct {
+	uint32_t Moves;				/**< Moves completed or stopped */
+	uint32_t Steps;				/**< Steps sent to the coils */
+	uint32_t Late;				/**< Steps sent after their time, the step
+									 interrupt was held off too long */
+} STM_STATS_Type;
+
+/**
+ * @}
+ */
+
+
+/* Public Variables ----------------------------------------------------------- */
+/** Half step phase table in clockwise order, anti-clockwise walks it
+ * backwards. Full stepping uses the odd entries. */
+extern const uint8_t SmClk[8];
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @defgroup ST_MOTOR_Public_Functions ST_MOTOR Public Functions
+ * @{
+ */
+
+void STM_Init (uint8_t mode, SCHED_TASK_Type *task);
+Status STM_Move (const STM_MOVE_Type *move);
+void STM_Stop (Bool now);
+Bool STM_Busy (void);
+int32_t STM_GetPosition (void);
+Status STM_SetPosition (int32_t pos);
+void STM_IntHandler (void);
+void STM_GetStats (STM_STATS_Type *stats);
+Status Rotate_Stepper_Motor (StMotorDirection_e StMotorDirection, uint16_t Angle, uint16_t Speed);
+
+/**
+ * @}
+ */
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LPC_ST_MOTOR_H_ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -18,6 +18,7 @@
 /* Includes ------------------------------------------------------------------- */
 #include "LPC17xx.h"
 #include "lpc_types.h"
+#include "lpc_input.h"
 
 
 #ifdef __cplusplus
@@ -26,12 +27,27 @@ extern "C"
 #endif
 
 
+/* Public Macros -------------------------------------------------------------- */
+/** @defgroup SWITCH_Public_Macros SWITCH Public Macros
+ * @{
+ */
+
+#define		SWITCH_PIN			19		// Switch 1 on P0.19, the others follow
+#define		SWITCH_KEYS			4
+
+/**
+ * @}
+ */
+
+
 /* Public Functions ----------------------------------------------------------- */
 /** @defgroup SWITCH_Public_Functions SWITCH Public Functions
  * @{
  */
 
+void Switch_Init (void);
 uchar Detect_Key (void);
+uchar Switch_Number (uint8_t key);
 
 /**
  * @}
@@ -24,6 +24,7 @@
 
 /* Peripherals Include----------------------------------------------------------*/
 #include "lpc17xx_systick.h"
+#include "lpc_sched.h"
 #include "lpc17xx_gpio.h"
 #include "lpc17xx_wdt.h"
 #include "lpc17xx_uart.h"
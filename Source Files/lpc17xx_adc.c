@@ -118,7 +118,7 @@ void ADC_Channel_Config(LPC_ADC_TypeDef *ADCx, ADC_CHANNEL_SELECTION PCfg, Funct
 			 PinCfg.Funcnum = 1;
 			 PinCfg.OpenDrain = 0;
 			 PinCfg.Pinmode = 0;
-			 PinCfg.Pinnum = 23;
+			 PinCfg.Pinnum = 26;
 			 PinCfg.Portnum = 0;
 			 PINSEL_ConfigPin(&PinCfg);
 
@@ -197,8 +197,9 @@ void ADC_Init(LPC_ADC_TypeDef *ADCx, uint32_t rate)
 	 * A fully conversion requires 65 of these clocks.
 	 * ADC clock = PCLK_ADC0 / (CLKDIV + 1);
 	 * ADC rate = ADC clock / 65;
+	 * Round the divider up so the rate never exceeds the request.
 	 */
-	temp = (temp /(rate * 65)) - 1;
+	temp = ((temp + (rate * 65) - 1) / (rate * 65)) - 1;
 	tmp |=  ADC_CR_CLKDIV(temp);
 
 	ADCx->ADCR = tmp;
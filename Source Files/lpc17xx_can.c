@@ -13,6 +13,7 @@
 
 /* Includes ------------------------------------------------------------------- */
 #include "lpc17xx_can.h"
+#include "lpc_prof.h"
 
 /* If this source file built with example, the LPC17xx FW library configuration
  * file in each example directory ("lpc17xx_libcfg.h") must be included,
@@ -34,40 +35,205 @@ uint16_t CANAF_gstd_cnt = 0;
 uint16_t CANAF_ext_cnt = 0;
 uint16_t CANAF_gext_cnt = 0;
 
+/* Receive rings: head is written by CAN_IRQHandler only, tail by
+ * CAN_RxDequeue() only, the indices run free and are masked on access */
+typedef struct {
+	__IO uint32_t head;
+	__IO uint32_t tail;
+	CAN_RX_STATS_Type stats;
+	CAN_RX_FRAME_Type buf[CAN_RX_RING_SIZE];
+} CAN_RX_RING_T;
+
+static CAN_RX_RING_T can_rx_ring[2];
+
+/* LUT image built by CAN_AFLoadTable() and CAN_AFUpdateTable() before
+ * the words that differ are copied to the acceptance filter RAM */
+typedef struct {
+	uint32_t *img;
+	uint16_t cnt[5];		/* entries per section */
+	uint16_t sa[6];			/* first word of each section, then the end */
+	uint16_t pos;			/* next free word */
+	uint8_t type;			/* section being filled */
+} CAN_AF_BUILD_T;
+
+static uint32_t can_af_image[CAN_AF_RAM_WORDS];
+
 /* End of Private Variables ----------------------------------------------------*/
 /**
  * @}
  */
 
 /*----------------- INTERRUPT SERVICE ROUTINES --------------------------*/
+static void can_rx_drain(LPC_CAN_TypeDef *CANx, CAN_RX_RING_T *ring);
+static void can_fullcan_drain(void);
+
 /*********************************************************************//**
- * @brief		CAN_IRQ Handler, control receive message operation
+ * @brief		CAN_IRQ Handler, queue every pending frame of CAN1, CAN2
+ * 				and the FullCAN object area in one pass
  * param[in]	none
  * @return 		none
  **********************************************************************/
 void CAN_IRQHandler()
 {
-	uint8_t IntStatus;
-//	uint32_t data1;
-	/* Get CAN status */
-	IntStatus = CAN_GetCTRLStatus(LPC_CAN1, CANCTRL_STS);
-	//check receive buffer status
-	if((IntStatus>>0)&0x01)
-	{
-		CAN_ReceiveMsg(LPC_CAN1,&RXMsg);
-		printf(LPC_UART0,"\n\rReceived buffer:\n\r");
-		PrintMessage(&RXMsg);
-		//Validate received and transmited message
-		if(Check_Message(&TXMsg, &RXMsg))
-			printf(LPC_UART0,"\n\rSelf test is SUCCESSFUL!!!");
-		else
-			printf(LPC_UART0,"\n\rSelf test is FAIL!!!");
+	PROF_ISR_ENTER(CAN_IRQn);
+	if (LPC_SC->PCONP & CLKPWR_PCONP_PCAN1)
+	{
+		can_rx_drain(LPC_CAN1, &can_rx_ring[CAN1_CTRL]);
+	}
+	if (LPC_SC->PCONP & CLKPWR_PCONP_PCAN2)
+	{
+		can_rx_drain(LPC_CAN2, &can_rx_ring[CAN2_CTRL]);
+	}
+	if (FULLCAN_ENABLE)
+	{
+		can_fullcan_drain();
+	}
+	PROF_ISR_EXIT(CAN_IRQn);
+}
+
+/*********************************************************************//**
+ * @brief		Queue the frames waiting in a controller receive buffer
+ * @param[in]	CANx	LPC_CAN1 or LPC_CAN2
+ * @param[in]	ring	Receive ring of the controller
+ * @return 		none
+ **********************************************************************/
+static void can_rx_drain(LPC_CAN_TypeDef *CANx, CAN_RX_RING_T *ring)
+{
+	CAN_RX_FRAME_Type *f;
+	uint32_t head = ring->head;
+	uint32_t rfs, data, used;
+
+	/* Reading ICR acknowledges the Tx and error interrupts */
+	if (CANx->ICR & (1 << 3))
+	{
+		ring->stats.DataOverrun++;
+		CANx->CMR = (1 << 3);
+	}
+
+	while (CANx->SR & 0x01)
+	{
+		if ((head - ring->tail) >= CAN_RX_RING_SIZE)
+		{
+			ring->stats.RingOverflow++;
+			CANx->CMR = 0x04;
+			continue;
+		}
+		f = &ring->buf[head & CAN_RX_RING_MASK];
+		f->TimeStamp = CAN_TSTAMP_TIM->TC;
+		rfs = CANx->RFS;
+		f->Msg.format = (uint8_t)(rfs >> 31);
+		f->Msg.type = (uint8_t)((rfs >> 30) & 0x01);
+		f->Msg.len = (uint8_t)((rfs >> 16) & 0x0F);
+		f->Msg.id = CANx->RID;
+		data = CANx->RDA;
+		f->Msg.dataA[0] = (uint8_t)data;
+		f->Msg.dataA[1] = (uint8_t)(data >> 8);
+		f->Msg.dataA[2] = (uint8_t)(data >> 16);
+		f->Msg.dataA[3] = (uint8_t)(data >> 24);
+		data = CANx->RDB;
+		f->Msg.dataB[0] = (uint8_t)data;
+		f->Msg.dataB[1] = (uint8_t)(data >> 8);
+		f->Msg.dataB[2] = (uint8_t)(data >> 16);
+		f->Msg.dataB[3] = (uint8_t)(data >> 24);
+		f->FullCAN = 0;
+		/*release receive buffer*/
+		CANx->CMR = 0x04;
+		head++;
+	}
+
+	used = head - ring->tail;
+	ring->stats.Frames += head - ring->head;
+	if (used > ring->stats.HighWater)
+	{
+		ring->stats.HighWater = used;
+	}
+	ring->head = head;
+}
+
+/*********************************************************************//**
+ * @brief		Queue every updated FullCAN object on the ring of the
+ * 				controller named in its look-up table entry
+ * @param[in]	None
+ * @return 		none
+ **********************************************************************/
+static void can_fullcan_drain(void)
+{
+	CAN_RX_RING_T *ring;
+	CAN_RX_FRAME_Type *f;
+	__IO uint32_t *obj;
+	uint32_t pend, idx, w0, a, b, used;
+	uint8_t w;
+
+	for (w = 0; w < 2; w++)
+	{
+		pend = w ? LPC_CANAF->FCANIC1 : LPC_CANAF->FCANIC0;
+		while (pend)
+		{
+			idx = 31 - __CLZ(pend & -pend);
+			pend &= pend - 1;
+			idx += w * 32;
+			obj = (__IO uint32_t *)(LPC_CANAF_RAM_BASE + LPC_CANAF->ENDofTable + idx * 12);
+			ring = &can_rx_ring[((LPC_CANAF_RAM->mask[idx >> 1] >> ((idx & 1) ? 13 : 29)) & 0x01)];
+
+			/* SEM 11: update done. Clear it, copy, and retry if the
+			 * hardware started a new update meanwhile */
+			do
+			{
+				w0 = obj[0];
+				if ((w0 & 0x03000000) != 0x03000000)
+				{
+					break;
+				}
+				obj[0] = w0 & ~0x03000000;
+				a = obj[1];
+				b = obj[2];
+			} while (obj[0] & 0x03000000);
+			if ((w0 & 0x03000000) != 0x03000000)
+			{
+				continue;
+			}
+
+			if ((ring->head - ring->tail) >= CAN_RX_RING_SIZE)
+			{
+				ring->stats.RingOverflow++;
+				continue;
+			}
+			f = &ring->buf[ring->head & CAN_RX_RING_MASK];
+			f->TimeStamp = CAN_TSTAMP_TIM->TC;
+			f->Msg.id = w0 & 0x7FF;
+			f->Msg.len = (uint8_t)((w0 >> 16) & 0x0F);
+			f->Msg.format = STD_ID_FORMAT;
+			f->Msg.type = (uint8_t)((w0 >> 30) & 0x01);
+			f->Msg.dataA[0] = (uint8_t)a;
+			f->Msg.dataA[1] = (uint8_t)(a >> 8);
+			f->Msg.dataA[2] = (uint8_t)(a >> 16);
+			f->Msg.dataA[3] = (uint8_t)(a >> 24);
+			f->Msg.dataB[0] = (uint8_t)b;
+			f->Msg.dataB[1] = (uint8_t)(b >> 8);
+			f->Msg.dataB[2] = (uint8_t)(b >> 16);
+			f->Msg.dataB[3] = (uint8_t)(b >> 24);
+			f->FullCAN = 1;
+			ring->head++;
+			ring->stats.Frames++;
+			used = ring->head - ring->tail;
+			if (used > ring->stats.HighWater)
+			{
+				ring->stats.HighWater = used;
+			}
+		}
 	}
 }
 
 
 /* Private Variables ---------------------------------------------------------- */
 static void can_SetBaudrate (LPC_CAN_TypeDef *CANx, uint32_t baudrate);
+static int32_t can_af_cmp (const CAN_AF_ID_Type *a, const CAN_AF_ID_Type *b);
+static Bool can_af_valid (const CAN_AF_ID_Type *e);
+static uint16_t can_af_sort (CAN_AF_ID_Type *ids, uint16_t num);
+static void can_af_get (uint8_t type, uint16_t index, CAN_AF_ID_Type *e);
+static CAN_ERROR can_af_put (CAN_AF_BUILD_T *b, const CAN_AF_ID_Type *e);
+static CAN_ERROR can_af_build (Bool keep, const CAN_AF_ID_Type *add, uint16_t numAdd,
+		const CAN_AF_ID_Type *del, uint16_t numDel);
 
 /*********************************************************************//**
  * @brief 		Setting CAN baud rate (bps)
@@ -124,6 +290,379 @@ static void can_SetBaudrate (LPC_CAN_TypeDef *CANx, uint32_t baudrate)
 	/* Return to normal operating */
 	CANx->MOD = 0;
 }
+
+/*********************************************************************//**
+ * @brief 		Order two acceptance filter IDs the way the LUT holds them:
+ * 				by section, then controller, then ID
+ * @param[in] 	a, b: IDs to compare
+ * @return 		<0, 0 or >0 as a sorts before, equal to or after b
+ ***********************************************************************/
+static int32_t can_af_cmp (const CAN_AF_ID_Type *a, const CAN_AF_ID_Type *b)
+{
+	uint32_t ka, kb;
+
+	if (a->Type != b->Type)
+	{
+		return (int32_t)a->Type - (int32_t)b->Type;
+	}
+	ka = ((uint32_t)a->Ctrl << 29) | a->LowerID;
+	kb = ((uint32_t)b->Ctrl << 29) | b->LowerID;
+	if (ka == kb)
+	{
+		if ((a->Type != GROUP_STANDARD_ENTRY) && (a->Type != GROUP_EXTEND_ENTRY))
+		{
+			return 0;
+		}
+		ka = a->UpperID;
+		kb = b->UpperID;
+		if (ka == kb)
+		{
+			return 0;
+		}
+	}
+	return (ka < kb) ? -1 : 1;
+}
+
+/*********************************************************************//**
+ * @brief 		Check one acceptance filter ID
+ * @param[in] 	e: ID to check
+ * @return 		TRUE if it can be placed in the LUT
+ ***********************************************************************/
+static Bool can_af_valid (const CAN_AF_ID_Type *e)
+{
+	if ((e->Type > GROUP_EXTEND_ENTRY) || (e->Ctrl > CAN2_CTRL))
+	{
+		return FALSE;
+	}
+	if (e->Type <= GROUP_STANDARD_ENTRY)
+	{
+		if (!PARAM_ID_11(e->LowerID))
+		{
+			return FALSE;
+		}
+	}
+	else if (!PARAM_ID_29(e->LowerID))
+	{
+		return FALSE;
+	}
+	if ((e->Type == GROUP_STANDARD_ENTRY) || (e->Type == GROUP_EXTEND_ENTRY))
+	{
+		if ((e->UpperID < e->LowerID) || ((e->Type == GROUP_STANDARD_ENTRY) &&
+				!PARAM_ID_11(e->UpperID)) || !PARAM_ID_29(e->UpperID))
+		{
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/*********************************************************************//**
+ * @brief 		Heap sort a list of IDs in place and drop duplicates,
+ * 				O(n log n) without recursion or extra memory
+ * @param[in] 	ids: list to sort
+ * @param[in]	num: number of IDs in the list
+ * @return 		Number of distinct IDs left at the start of the list
+ ***********************************************************************/
+static uint16_t can_af_sort (CAN_AF_ID_Type *ids, uint16_t num)
+{
+	CAN_AF_ID_Type tmp;
+	uint32_t start, end, root, child;
+
+	if (num < 2)
+	{
+		return num;
+	}
+	start = num >> 1;
+	end = num;
+	while (end > 1)
+	{
+		if (start > 0)
+		{
+			/* Build the heap */
+			start--;
+		}
+		else
+		{
+			/* Move the largest ID behind the heap */
+			end--;
+			tmp = ids[end];
+			ids[end] = ids[0];
+			ids[0] = tmp;
+		}
+		root = start;
+		while ((child = (root << 1) + 1) < end)
+		{
+			if ((child + 1 < end) && (can_af_cmp(&ids[child], &ids[child + 1]) < 0))
+			{
+				child++;
+			}
+			if (can_af_cmp(&ids[root], &ids[child]) >= 0)
+			{
+				break;
+			}
+			tmp = ids[root];
+			ids[root] = ids[child];
+			ids[child] = tmp;
+			root = child;
+		}
+	}
+
+	end = 1;
+	for (root = 1; root < num; root++)
+	{
+		if (can_af_cmp(&ids[root], &ids[end - 1]) != 0)
+		{
+			ids[end++] = ids[root];
+		}
+	}
+	return (uint16_t)end;
+}
+
+/*********************************************************************//**
+ * @brief 		Read back one entry of the current LUT
+ * @param[in] 	type: section, one of AFLUT_ENTRY_Type
+ * @param[in]	index: entry position in the section
+ * @param[out]	e: entry, Ctrl is 0xFF if the entry is disabled
+ * @return 		None
+ ***********************************************************************/
+static void can_af_get (uint8_t type, uint16_t index, CAN_AF_ID_Type *e)
+{
+	uint32_t w, half;
+
+	e->Type = type;
+	switch (type)
+	{
+	case FULLCAN_ENTRY:
+	case EXPLICIT_STANDARD_ENTRY:
+		w = (type == FULLCAN_ENTRY) ? 0 : (LPC_CANAF->SFF_sa >> 2);
+		w = LPC_CANAF_RAM->mask[w + (index >> 1)];
+		half = (index & 1) ? (w & 0xFFFF) : (w >> 16);
+		e->Ctrl = (half & (1 << 12)) ? 0xFF : (uint8_t)(half >> 13);
+		e->LowerID = e->UpperID = half & 0x7FF;
+		break;
+	case GROUP_STANDARD_ENTRY:
+		w = LPC_CANAF_RAM->mask[(LPC_CANAF->SFF_GRP_sa >> 2) + index];
+		e->Ctrl = (w & ((1 << 28) | (1 << 12))) ? 0xFF : (uint8_t)(w >> 29);
+		e->LowerID = (w >> 16) & 0x7FF;
+		e->UpperID = w & 0x7FF;
+		break;
+	case EXPLICIT_EXTEND_ENTRY:
+		w = LPC_CANAF_RAM->mask[(LPC_CANAF->EFF_sa >> 2) + index];
+		e->Ctrl = (uint8_t)(w >> 29);
+		e->LowerID = e->UpperID = w & 0x1FFFFFFF;
+		break;
+	default:
+		w = (LPC_CANAF->EFF_GRP_sa >> 2) + (index << 1);
+		e->Ctrl = (uint8_t)(LPC_CANAF_RAM->mask[w] >> 29);
+		e->LowerID = LPC_CANAF_RAM->mask[w] & 0x1FFFFFFF;
+		e->UpperID = LPC_CANAF_RAM->mask[w + 1] & 0x1FFFFFFF;
+		break;
+	}
+}
+
+/*********************************************************************//**
+ * @brief 		Append one entry to the LUT image, entries must arrive in
+ * 				can_af_cmp() order
+ * @param[in] 	b: image being built
+ * @param[in]	e: entry to append
+ * @return 		CAN_OK, or CAN_OBJECTS_FULL_ERROR if the image is full
+ ***********************************************************************/
+static CAN_ERROR can_af_put (CAN_AF_BUILD_T *b, const CAN_AF_ID_Type *e)
+{
+	uint32_t half;
+
+	/* Close the sections before this one */
+	while (b->type < e->Type)
+	{
+		b->type++;
+		b->sa[b->type] = b->pos;
+	}
+	half = (e->Type == GROUP_EXTEND_ENTRY) ? 2 : 1;
+	if ((e->Type <= EXPLICIT_STANDARD_ENTRY) && (b->cnt[e->Type] & 1))
+	{
+		half = 0;
+	}
+	if (b->pos + half > CAN_AF_RAM_WORDS)
+	{
+		return CAN_OBJECTS_FULL_ERROR;
+	}
+
+	switch (e->Type)
+	{
+	case FULLCAN_ENTRY:
+	case EXPLICIT_STANDARD_ENTRY:
+		half = ((uint32_t)e->Ctrl << 13) | e->LowerID;
+		if (e->Type == FULLCAN_ENTRY)
+		{
+			half |= (1 << 11);
+		}
+		if (b->cnt[e->Type] & 1)
+		{
+			/* Second entry of the word replaces the disabled filler */
+			b->img[b->pos - 1] = (b->img[b->pos - 1] & 0xFFFF0000) | half;
+		}
+		else
+		{
+			b->img[b->pos++] = (half << 16) | 0x0000FFFF;
+		}
+		break;
+	case GROUP_STANDARD_ENTRY:
+		b->img[b->pos++] = ((uint32_t)e->Ctrl << 29) | (e->LowerID << 16) |
+				((uint32_t)e->Ctrl << 13) | e->UpperID;
+		break;
+	case EXPLICIT_EXTEND_ENTRY:
+		b->img[b->pos++] = ((uint32_t)e->Ctrl << 29) | e->LowerID;
+		break;
+	default:
+		b->img[b->pos++] = ((uint32_t)e->Ctrl << 29) | e->LowerID;
+		b->img[b->pos++] = ((uint32_t)e->Ctrl << 29) | e->UpperID;
+		break;
+	}
+	b->cnt[e->Type]++;
+	return CAN_OK;
+}
+
+/*********************************************************************//**
+ * @brief 		Merge the current LUT (optional), a sorted list of IDs to
+ * 				add and a sorted list of IDs to remove into one new image,
+ * 				then write the words that differ from the current LUT
+ * @param[in] 	keep: TRUE to start from the current LUT, FALSE for empty
+ * @param[in]	add, numAdd: sorted and distinct IDs to add
+ * @param[in]	del, numDel: sorted and distinct IDs to remove
+ * @return 		CAN_OK, or CAN_OBJECTS_FULL_ERROR if the result would not
+ * 				fit (the LUT is left untouched)
+ ***********************************************************************/
+static CAN_ERROR can_af_build (Bool keep, const CAN_AF_ID_Type *add, uint16_t numAdd,
+		const CAN_AF_ID_Type *del, uint16_t numDel)
+{
+	CAN_AF_BUILD_T b;
+	CAN_AF_ID_Type cur;
+	const CAN_AF_ID_Type *next;
+	uint16_t old[5];
+	uint16_t type, i, a, d;
+	uint32_t end;
+	int32_t c;
+
+	old[FULLCAN_ENTRY] = keep ? CANAF_FullCAN_cnt : 0;
+	old[EXPLICIT_STANDARD_ENTRY] = keep ? CANAF_std_cnt : 0;
+	old[GROUP_STANDARD_ENTRY] = keep ? CANAF_gstd_cnt : 0;
+	old[EXPLICIT_EXTEND_ENTRY] = keep ? CANAF_ext_cnt : 0;
+	old[GROUP_EXTEND_ENTRY] = keep ? CANAF_gext_cnt : 0;
+
+	b.img = can_af_image;
+	b.pos = 0;
+	b.type = FULLCAN_ENTRY;
+	b.sa[FULLCAN_ENTRY] = 0;
+	for (type = 0; type < 5; type++)
+	{
+		b.cnt[type] = 0;
+	}
+
+	/* Both sources are in LUT order, so one merge pass per section */
+	a = 0;
+	d = 0;
+	for (type = FULLCAN_ENTRY; type <= GROUP_EXTEND_ENTRY; type++)
+	{
+		i = 0;
+		cur.Ctrl = 0xFF;
+		while (1)
+		{
+			/* Next enabled entry of the current LUT */
+			while ((cur.Ctrl == 0xFF) && (i < old[type]))
+			{
+				can_af_get(type, i++, &cur);
+			}
+			if ((a < numAdd) && (add[a].Type == type))
+			{
+				c = (cur.Ctrl == 0xFF) ? 1 : can_af_cmp(&cur, &add[a]);
+			}
+			else if (cur.Ctrl != 0xFF)
+			{
+				c = -1;
+			}
+			else
+			{
+				break;
+			}
+			if (c <= 0)
+			{
+				next = &cur;
+				if (c == 0)
+				{
+					a++;
+				}
+			}
+			else
+			{
+				next = &add[a++];
+			}
+
+			while ((d < numDel) && (can_af_cmp(&del[d], next) < 0))
+			{
+				d++;
+			}
+			if ((d >= numDel) || (can_af_cmp(&del[d], next) != 0))
+			{
+				if (can_af_put(&b, next) != CAN_OK)
+				{
+					return CAN_OBJECTS_FULL_ERROR;
+				}
+			}
+			if (next == &cur)
+			{
+				cur.Ctrl = 0xFF;
+			}
+		}
+	}
+	while (b.type < GROUP_EXTEND_ENTRY + 1)
+	{
+		b.type++;
+		b.sa[b.type] = b.pos;
+	}
+
+	/* FullCAN message objects, 3 words each, follow the table */
+	end = b.pos + b.cnt[FULLCAN_ENTRY] * 3;
+	if ((end > CAN_AF_RAM_WORDS) || (b.cnt[FULLCAN_ENTRY] > MAX_HW_FULLCAN_OBJ))
+	{
+		return CAN_OBJECTS_FULL_ERROR;
+	}
+	for (i = b.pos; i < end; i++)
+	{
+		b.img[i] = 0;
+	}
+
+	/* The filter is off only while the changed words are written */
+	LPC_CANAF->AFMR = 0x00000001;
+	for (i = 0; i < end; i++)
+	{
+		if (LPC_CANAF_RAM->mask[i] != b.img[i])
+		{
+			LPC_CANAF_RAM->mask[i] = b.img[i];
+		}
+	}
+	LPC_CANAF->SFF_sa = b.sa[EXPLICIT_STANDARD_ENTRY] << 2;
+	LPC_CANAF->SFF_GRP_sa = b.sa[GROUP_STANDARD_ENTRY] << 2;
+	LPC_CANAF->EFF_sa = b.sa[EXPLICIT_EXTEND_ENTRY] << 2;
+	LPC_CANAF->EFF_GRP_sa = b.sa[GROUP_EXTEND_ENTRY] << 2;
+	LPC_CANAF->ENDofTable = b.sa[GROUP_EXTEND_ENTRY + 1] << 2;
+
+	CANAF_FullCAN_cnt = b.cnt[FULLCAN_ENTRY];
+	CANAF_std_cnt = b.cnt[EXPLICIT_STANDARD_ENTRY];
+	CANAF_gstd_cnt = b.cnt[GROUP_STANDARD_ENTRY];
+	CANAF_ext_cnt = b.cnt[EXPLICIT_EXTEND_ENTRY];
+	CANAF_gext_cnt = b.cnt[GROUP_EXTEND_ENTRY];
+	if (CANAF_FullCAN_cnt)
+	{
+		FULLCAN_ENABLE = ENABLE;
+		LPC_CANAF->AFMR = 0x04;
+	}
+	else
+	{
+		FULLCAN_ENABLE = DISABLE;
+		LPC_CANAF->AFMR = 0x00;
+	}
+	return CAN_OK;
+}
 /* End of Private Functions ----------------------------------------------------*/
 
 
@@ -247,6 +786,7 @@ Bool Check_Message(CAN_MSG_Type* TX_Msg, CAN_MSG_Type* RX_Msg)
  *********************************************************************/
 void CAN_Init(LPC_CAN_TypeDef *CANx, uint32_t baudrate)
 {
+	CAN_RX_RING_T *ring;
 	uint32_t temp;
 	uint16_t i;
 	CHECK_PARAM(PARAM_CANx(CANx));
@@ -267,6 +807,19 @@ void CAN_Init(LPC_CAN_TypeDef *CANx, uint32_t baudrate)
 	CLKPWR_SetPCLKDiv (CLKPWR_PCLKSEL_CAN2, CLKPWR_PCLKSEL_CCLK_DIV_2);
 	CLKPWR_SetPCLKDiv (CLKPWR_PCLKSEL_ACF, CLKPWR_PCLKSEL_CCLK_DIV_2);
 
+	/* Empty the receive ring, start the time stamp timer once */
+	ring = &can_rx_ring[(CANx == LPC_CAN1) ? CAN1_CTRL : CAN2_CTRL];
+	ring->tail = ring->head;
+	ring->stats.Frames = ring->stats.HighWater = 0;
+	ring->stats.RingOverflow = ring->stats.DataOverrun = 0;
+	if (!(LPC_SC->PCONP & CAN_TSTAMP_PCONP) || !(CAN_TSTAMP_TIM->TCR & 0x01))
+	{
+		CLKPWR_ConfigPPWR(CAN_TSTAMP_PCONP, ENABLE);
+		CAN_TSTAMP_TIM->TCR = 0x02;
+		CAN_TSTAMP_TIM->PR = CLKPWR_GetPCLK(CAN_TSTAMP_PCLK) / CAN_TSTAMP_HZ - 1;
+		CAN_TSTAMP_TIM->TCR = 0x01;
+	}
+
 	CANx->MOD = 1; // Enter Reset Mode
 	CANx->IER = 0; // Disable All CAN Interrupts
 	CANx->GSR = 0;
@@ -1432,6 +1985,93 @@ CAN_ERROR CAN_RemoveEntry(AFLUT_ENTRY_Type EntryType, uint16_t position)
 	return CAN_OK;
 }
 
+/********************************************************************//**
+ * @brief		Load the whole acceptance filter LUT from one list of IDs.
+ * 				The list is sorted and deduplicated in place, all five
+ * 				sections are laid out in one pass and the LUT is written
+ * 				once, replacing every entry loaded before.
+ * @param[in]	ids: unsorted list of IDs, reordered on return
+ * @param[in]	num: number of IDs in the list
+ * @return 		CAN_ERROR, could be:
+ * 				- CAN_OK: the LUT holds the list
+ * 				- CAN_AF_ENTRY_ERROR: an ID is out of range, LUT untouched
+ * 				- CAN_OBJECTS_FULL_ERROR: the list does not fit in
+ * 				CAN_AF_RAM_WORDS, LUT untouched
+ *********************************************************************/
+CAN_ERROR CAN_AFLoadTable(CAN_AF_ID_Type *ids, uint16_t num)
+{
+	uint16_t i;
+
+	for (i = 0; i < num; i++)
+	{
+		if (!can_af_valid(&ids[i]))
+		{
+			return CAN_AF_ENTRY_ERROR;
+		}
+	}
+	num = can_af_sort(ids, num);
+	return can_af_build(FALSE, ids, num, NULL, 0);
+}
+
+/********************************************************************//**
+ * @brief		Add and remove IDs in the loaded LUT. Both lists are sorted
+ * 				in place and merged with the current table in one pass,
+ * 				then only the words that changed are written.
+ * @param[in]	add: unsorted IDs to add, reordered on return
+ * @param[in]	numAdd: number of IDs to add
+ * @param[in]	del: unsorted IDs to remove, reordered on return, an
+ * 				ID that is not loaded is ignored
+ * @param[in]	numDel: number of IDs to remove
+ * Note: 		disabled entries loaded by the other AFLUT functions
+ * 				are dropped from the table
+ * @return 		CAN_ERROR, could be:
+ * 				- CAN_OK: the LUT is updated
+ * 				- CAN_AF_ENTRY_ERROR: an ID is out of range, LUT untouched
+ * 				- CAN_OBJECTS_FULL_ERROR: the result does not fit in
+ * 				CAN_AF_RAM_WORDS, LUT untouched
+ *********************************************************************/
+CAN_ERROR CAN_AFUpdateTable(CAN_AF_ID_Type *add, uint16_t numAdd,
+		CAN_AF_ID_Type *del, uint16_t numDel)
+{
+	uint16_t i;
+
+	for (i = 0; i < numAdd; i++)
+	{
+		if (!can_af_valid(&add[i]))
+		{
+			return CAN_AF_ENTRY_ERROR;
+		}
+	}
+	for (i = 0; i < numDel; i++)
+	{
+		if (!can_af_valid(&del[i]))
+		{
+			return CAN_AF_ENTRY_ERROR;
+		}
+	}
+	numAdd = can_af_sort(add, numAdd);
+	numDel = can_af_sort(del, numDel);
+	return can_af_build(TRUE, add, numAdd, del, numDel);
+}
+
+/********************************************************************//**
+ * @brief		Get the free space of the acceptance filter RAM
+ * @param[in]	None
+ * @return 		Words left of CAN_AF_RAM_WORDS after the LUT and the
+ * 				FullCAN message objects (3 words each). An explicit ID
+ * 				takes half a word (standard) or one word (extended), a
+ * 				group one word (standard) or two words (extended).
+ *********************************************************************/
+uint16_t CAN_AFGetFreeWords(void)
+{
+	uint32_t used;
+
+	used = ((CANAF_FullCAN_cnt + 1) >> 1) + ((CANAF_std_cnt + 1) >> 1) +
+			CANAF_gstd_cnt + CANAF_ext_cnt + (CANAF_gext_cnt << 1) +
+			CANAF_FullCAN_cnt * 3;
+	return (used >= CAN_AF_RAM_WORDS) ? 0 : (uint16_t)(CAN_AF_RAM_WORDS - used);
+}
+
 /********************************************************************//**
  * @brief		Send message data
  * @param[in]	CANx pointer to LPC_CAN_TypeDef, should be:
@@ -1737,6 +2377,53 @@ CAN_ERROR FCAN_ReadObj (LPC_CANAF_TypeDef* CANAFx, CAN_MSG_Type *CAN_Msg)
 	}
 	return CAN_FULL_OBJ_NOT_RCV;
 }
+/********************************************************************//**
+ * @brief		Take up to max frames queued by CAN_IRQHandler
+ * @param[in]	ctrl	CAN1_CTRL or CAN2_CTRL
+ * @param[out]	frames	Destination array, oldest frame first
+ * @param[in]	max		Size of the array
+ * @return 		Number of frames copied
+ *********************************************************************/
+uint32_t CAN_RxDequeue(uint8_t ctrl, CAN_RX_FRAME_Type *frames, uint32_t max)
+{
+	CAN_RX_RING_T *ring = &can_rx_ring[ctrl & 0x01];
+	uint32_t tail = ring->tail;
+	uint32_t n = ring->head - tail;
+	uint32_t i;
+
+	if (n > max)
+	{
+		n = max;
+	}
+	for (i = 0; i < n; i++)
+	{
+		frames[i] = ring->buf[(tail + i) & CAN_RX_RING_MASK];
+	}
+	ring->tail = tail + n;
+	return n;
+}
+
+/********************************************************************//**
+ * @brief		Get the number of frames waiting in a receive ring
+ * @param[in]	ctrl	CAN1_CTRL or CAN2_CTRL
+ * @return 		Queued frames
+ *********************************************************************/
+uint32_t CAN_RxPending(uint8_t ctrl)
+{
+	return can_rx_ring[ctrl & 0x01].head - can_rx_ring[ctrl & 0x01].tail;
+}
+
+/********************************************************************//**
+ * @brief		Get the receive ring statistics of a controller
+ * @param[in]	ctrl	CAN1_CTRL or CAN2_CTRL
+ * @param[out]	stats	Counters since CAN_Init()
+ * @return 		None
+ *********************************************************************/
+void CAN_GetRxStats(uint8_t ctrl, CAN_RX_STATS_Type *stats)
+{
+	*stats = can_rx_ring[ctrl & 0x01].stats;
+}
+
 /********************************************************************//**
  * @brief		Get CAN Control Status
  * @param[in]	CANx pointer to LPC_CAN_TypeDef, should be:
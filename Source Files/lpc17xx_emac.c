@@ -13,6 +13,7 @@
 
 /* Includes ------------------------------------------------------------------- */
 #include "lpc17xx_emac.h"
+#include "lpc_prof.h"
 
 /* If this source file built with example, the LPC17xx FW library configuration
  * file in each example directory ("lpc17xx_libcfg.h") must be included,
@@ -42,6 +43,27 @@
 #define EMAC_DST_ADDR56		0x00001D0C
 #endif
 
+#if !(TX_ONLY || BOUNCE_RX)
+/* This is the MAC address of LPC1768 */
+#define EMAC_ADDR12		0x0000101F
+#define EMAC_ADDR34		0x0000E012
+#define EMAC_ADDR56		0x00001D0C
+/* Destination MAC address used by PacketGen() */
+#define EMAC_DST_ADDR12		0x0000E386
+#define EMAC_DST_ADDR34		0x00006BDA
+#define EMAC_DST_ADDR56		0x00005000
+#endif
+
+/* Public Variables ----------------------------------------------------------- */
+__IO uint32_t RXOverrunCount, RXErrorCount, RxFinishedCount, RxDoneCount;
+__IO uint32_t TXUnderrunCount, TXErrorCount, TxFinishedCount, TxDoneCount;
+__IO Bool PacketReceived;
+/* Global Tx Buffer data */
+uint8_t __attribute__ ((aligned (4))) gTxBuf[TX_PACKET_SIZE + 0x10];
+#if ENABLE_WOL
+__IO uint32_t WOLCount;
+#endif
+
 /* Private Variables ---------------------------------------------------------- */
 /** @defgroup EMAC_Private_Variables EMAC Private Variables
  * @{
@@ -50,41 +72,39 @@
 static unsigned short *rptr;
 static unsigned short *tptr;
 
-/*
- * NXP: Here AHBRAM1 section still not be used, so a mount of this section
- * will be used to store buffer data get from receive packet buffer of EMAC
- */
-static unsigned short *pgBuf = (unsigned short *)LPC_AHBRAM1_BASE;
-
 
 /* MII Mgmt Configuration register - Clock divider setting */
 const uint8_t EMAC_clkdiv[] = { 4, 6, 8, 10, 14, 20, 28 };
 
-/* EMAC local DMA Descriptors */
+/* EMAC DMA Descriptors and buffers, fixed in AHB SRAM */
 
 /** Rx Descriptor data array */
-static RX_Desc Rx_Desc[EMAC_NUM_RX_FRAG];
-
-/** Rx Status data array - Must be 8-Byte aligned */
-#if defined ( __CC_ARM   )
-static __align(8) RX_Stat Rx_Stat[EMAC_NUM_RX_FRAG];
-#elif defined ( __ICCARM__ )
-#pragma data_alignment=8
-static RX_Stat Rx_Stat[EMAC_NUM_RX_FRAG];
-#elif defined   (  __GNUC__  )
-static __attribute__ ((aligned (8))) RX_Stat Rx_Stat[EMAC_NUM_RX_FRAG];
-#endif
+static RX_Desc * const Rx_Desc = (RX_Desc *)EMAC_RX_DESC_BASE;
+/** Rx Status data array - 8-Byte aligned */
+static RX_Stat * const Rx_Stat = (RX_Stat *)EMAC_RX_STAT_BASE;
 
 /** Tx Descriptor data array */
-static TX_Desc Tx_Desc[EMAC_NUM_TX_FRAG];
+static TX_Desc * const Tx_Desc = (TX_Desc *)EMAC_TX_DESC_BASE;
 /** Tx Status data array */
-static TX_Stat Tx_Stat[EMAC_NUM_TX_FRAG];
+static TX_Stat * const Tx_Stat = (TX_Stat *)EMAC_TX_STAT_BASE;
 
-/* EMAC local DMA buffers */
 /** Rx buffer data */
-static uint32_t rx_buf[EMAC_NUM_RX_FRAG][EMAC_ETH_MAX_FLEN>>2];
+static uint8_t (* const rx_buf)[EMAC_ETH_MAX_FLEN] = (uint8_t (*)[EMAC_ETH_MAX_FLEN])EMAC_RX_BUF_BASE;
 /** Tx buffer data */
-static uint32_t tx_buf[EMAC_NUM_TX_FRAG][EMAC_ETH_MAX_FLEN>>2];
+static uint8_t (* const tx_buf)[EMAC_ETH_MAX_FLEN] = (uint8_t (*)[EMAC_ETH_MAX_FLEN])EMAC_TX_BUF_BASE;
+
+/* Zero-copy ownership */
+
+/** Next Rx descriptor to loan, runs ahead of RxConsumeIndex */
+static uint32_t rx_take;
+/** Loaned Rx descriptors handed back out of order */
+static uint8_t rx_released[EMAC_NUM_RX_FRAG];
+/** Tx buffers claimed by the caller or queued, one bit each */
+static __IO uint8_t tx_busy;
+/** Tx buffer queued on each descriptor, EMAC_PBUF_CALLER if none */
+static uint8_t tx_owner[EMAC_NUM_TX_FRAG];
+/** Next Tx descriptor whose buffer is not yet reclaimed */
+static uint32_t tx_clean;
 
 /**
  * @}
@@ -97,7 +117,9 @@ static int32_t write_PHY (uint32_t PhyReg, uint16_t Value);
 static int32_t  read_PHY (uint32_t PhyReg);
 
 static void setEmacAddr(uint8_t abStationAddr[]);
-static int32_t emac_CRCCalc(uint8_t frame_no_fcs[], int32_t frame_len);
+static void rx_release (uint32_t idx);
+static void tx_reclaim (void);
+static int32_t tx_alloc (void);
 
 
 /*----------------- INTERRUPT SERVICE ROUTINES --------------------------*/
@@ -108,11 +130,11 @@ static int32_t emac_CRCCalc(uint8_t frame_no_fcs[], int32_t frame_len);
  **********************************************************************/
 void ENET_IRQHandler (void)
 {
-	EMAC_PACKETBUF_Type RxDatbuf;
-	uint32_t RxLen;
-
-	/* EMAC Ethernet Controller Interrupt function. */
+	/* EMAC Ethernet Controller Interrupt function. Only counts the events,
+	 * the application reads the counters: nothing is printed from here */
 	uint32_t int_stat;
+
+	PROF_ISR_ENTER(ENET_IRQn);
 	// Get EMAC interrupt status
 	while ((int_stat = (LPC_EMAC->IntStatus & LPC_EMAC->IntEnable)) != 0) {
 		// Clear interrupt status
@@ -123,7 +145,6 @@ void ENET_IRQHandler (void)
 		if((int_stat & EMAC_INT_RX_OVERRUN))
 		{
 			RXOverrunCount++;
-			printf(LPC_UART0,"Rx overrun\n\r");
 		}
 
 		/*-----------  receive error -------------*/
@@ -139,7 +160,6 @@ void ENET_IRQHandler (void)
 		{
 			if (EMAC_CheckReceiveDataStatus(EMAC_RINFO_RANGE_ERR) == RESET){
 				RXErrorCount++;
-				printf(LPC_UART0,"Rx error: \n\r");
 			}
 		}
 
@@ -147,39 +167,16 @@ void ENET_IRQHandler (void)
 		if ((int_stat & EMAC_INT_RX_FIN))
 		{
 			RxFinishedCount++;
-			printf(LPC_UART0,"Rx finish\n\r");
 		}
 
 		/* ---------- Receive Done -----------------------------*/
-		/* Note: All packets are greater than (TX_PACKET_SIZE + 4)
-		 * will be ignore!
+		/* Note: Frames stay in the Rx ring until the application
+		 * takes them with EMAC_RxTake() and hands them back with
+		 * EMAC_RxRelease(), nothing is copied here
 		 */
 		if ((int_stat & EMAC_INT_RX_DONE))
 		{
-			/* Packet received, check if packet is valid. */
-			if (EMAC_CheckReceiveIndex()){
-				if (!EMAC_CheckReceiveDataStatus(EMAC_RINFO_LAST_FLAG)){
-					goto rel;
-				}
-				// Get data size, trip out 4-bytes CRC field, note that length in (-1) style format
-				RxLen = EMAC_GetReceiveDataSize() - 3;
-				// Note that packet added 4-bytes CRC created by yourself
-				if ((RxLen > (TX_PACKET_SIZE + 4)) || (EMAC_CheckReceiveDataStatus(EMAC_RINFO_ERR_MASK))) {
-					/* Invalid frame, ignore it and free buffer */
-					goto rel;
-				}
-				ReceiveLength = RxLen;
-				// Valid Frame, just copy it
-				RxDatbuf.pbDataBuf = (uint32_t *)gRxBuf;
-				RxDatbuf.ulDataLen = RxLen;
-				EMAC_ReadPacketBuffer(&RxDatbuf);
-				PacketReceived = TRUE;
-
-		rel:
-				/* Release frame from EMAC buffer */
-				EMAC_UpdateRxConsumeIndex();
-			}
-			printf(LPC_UART0,"Rx done\n\r");
+			PacketReceived = TRUE;
 			RxDoneCount++;
 		}
 
@@ -187,28 +184,24 @@ void ENET_IRQHandler (void)
 		if ((int_stat & EMAC_INT_TX_UNDERRUN))
 		{
 			TXUnderrunCount++;
-			printf(LPC_UART0,"Tx under-run\n\r");
 		}
 
 		/*------------------- Transmit Error --------------------------*/
 		if ((int_stat & EMAC_INT_TX_ERR))
 		{
 			TXErrorCount++;
-			printf(LPC_UART0,"Tx error\n\r");
 		}
 
 		/* ----------------- TX Finished Process Descriptors ----------*/
 		if ((int_stat & EMAC_INT_TX_FIN))
 		{
 			TxFinishedCount++;
-			printf(LPC_UART0,"Tx finish\n\r");
 		}
 
 		/* ----------------- Transmit Done ----------------------------*/
 		if ((int_stat & EMAC_INT_TX_DONE))
 		{
 			TxDoneCount++;
-			printf(LPC_UART0,"Tx done\n\r");
 		}
 #if ENABLE_WOL
 		/* ------------------ Wakeup Event Interrupt ------------------*/
@@ -221,6 +214,7 @@ void ENET_IRQHandler (void)
 		}
 #endif
 	}
+	PROF_ISR_EXIT(ENET_IRQn);
 }
 
 
@@ -231,7 +225,7 @@ void ENET_IRQHandler (void)
  **********************************************************************/
 void PacketGen(uint8_t *txptr)
 {
-	int i;
+	uint32_t i;
 	uint32_t crcValue;
 	uint32_t BodyLength = TX_PACKET_SIZE - 14;
 
@@ -262,7 +256,7 @@ void PacketGen(uint8_t *txptr)
 	}
 
 	// Calculate CRC
-	crcValue = crc32_bfr( txptr, TX_PACKET_SIZE );
+	crcValue = CRC32_Calc( txptr, TX_PACKET_SIZE );
 
 	// Add 4-byte CRC
 	*(txptr+TX_PACKET_SIZE) = (0xff & crcValue);
@@ -285,15 +279,17 @@ static void rx_descr_init (void)
 
 	for (i = 0; i < EMAC_NUM_RX_FRAG; i++)
 	{
-		Rx_Desc[i].Packet  = (uint32_t)&rx_buf[i];
+		Rx_Desc[i].Packet  = EMAC_BUS_ADDR(rx_buf[i]);
 		Rx_Desc[i].Ctrl    = EMAC_RCTRL_INT | (EMAC_ETH_MAX_FLEN - 1);
 		Rx_Stat[i].Info    = 0;
 		Rx_Stat[i].HashCRC = 0;
+		rx_released[i]     = FALSE;
 	}
+	rx_take = 0;
 
 	/* Set EMAC Receive Descriptor Registers. */
-	LPC_EMAC->RxDescriptor       = (uint32_t)&Rx_Desc[0];
-	LPC_EMAC->RxStatus           = (uint32_t)&Rx_Stat[0];
+	LPC_EMAC->RxDescriptor       = EMAC_BUS_ADDR(&Rx_Desc[0]);
+	LPC_EMAC->RxStatus           = EMAC_BUS_ADDR(&Rx_Stat[0]);
 	LPC_EMAC->RxDescriptorNumber = EMAC_NUM_RX_FRAG - 1;
 
 	/* Rx Descriptors Point to 0 */
@@ -313,14 +309,17 @@ static void tx_descr_init (void) {
 
 	for (i = 0; i < EMAC_NUM_TX_FRAG; i++)
 	{
-		Tx_Desc[i].Packet = (uint32_t)&tx_buf[i];
+		Tx_Desc[i].Packet = 0;
 		Tx_Desc[i].Ctrl   = 0;
 		Tx_Stat[i].Info   = 0;
+		tx_owner[i]       = EMAC_PBUF_CALLER;
 	}
+	tx_busy  = 0;
+	tx_clean = 0;
 
 	/* Set EMAC Transmit Descriptor Registers. */
-	LPC_EMAC->TxDescriptor       = (uint32_t)&Tx_Desc[0];
-	LPC_EMAC->TxStatus           = (uint32_t)&Tx_Stat[0];
+	LPC_EMAC->TxDescriptor       = EMAC_BUS_ADDR(&Tx_Desc[0]);
+	LPC_EMAC->TxStatus           = EMAC_BUS_ADDR(&Tx_Stat[0]);
 	LPC_EMAC->TxDescriptorNumber = EMAC_NUM_TX_FRAG - 1;
 
 	/* Tx Descriptors Point to 0 */
@@ -399,48 +398,68 @@ static void setEmacAddr(uint8_t abStationAddr[])
 
 
 /*********************************************************************//**
- * @brief		Calculates CRC code for number of bytes in the frame
- * @param[in]	frame_no_fcs	Pointer to the first byte of the frame
- * @param[in]	frame_len		length of the frame without the FCS
- * @return		the CRC as a 32 bit integer
+ * @brief		Hand a loaned Rx descriptor back and advance RxConsumeIndex
+ * 				over every descriptor released so far, in ring order
+ * @param[in]	idx		Rx descriptor index
+ * @return		None
  **********************************************************************/
-static int32_t emac_CRCCalc(uint8_t frame_no_fcs[], int32_t frame_len)
+static void rx_release (uint32_t idx)
 {
-	int i; 		// iterator
-	int j; 		// another iterator
-	char byte; 	// current byte
-	int crc; 	// CRC result
-	int q0, q1, q2, q3; // temporary variables
-	crc = 0xFFFFFFFF;
-	for (i = 0; i < frame_len; i++) {
-		byte = *frame_no_fcs++;
-		for (j = 0; j < 2; j++) {
-			if (((crc >> 28) ^ (byte >> 3)) & 0x00000001) {
-				q3 = 0x04C11DB7;
-			} else {
-				q3 = 0x00000000;
-			}
-			if (((crc >> 29) ^ (byte >> 2)) & 0x00000001) {
-				q2 = 0x09823B6E;
-			} else {
-				q2 = 0x00000000;
-			}
-			if (((crc >> 30) ^ (byte >> 1)) & 0x00000001) {
-				q1 = 0x130476DC;
-			} else {
-				q1 = 0x00000000;
-			}
-			if (((crc >> 31) ^ (byte >> 0)) & 0x00000001) {
-				q0 = 0x2608EDB8;
-			} else {
-				q0 = 0x00000000;
-			}
-			crc = (crc << 4) ^ q3 ^ q2 ^ q1 ^ q0;
-			byte >>= 4;
+	uint32_t cons = LPC_EMAC->RxConsumeIndex;
+
+	rx_released[idx] = TRUE;
+	while ((cons != rx_take) && rx_released[cons])
+	{
+		rx_released[cons] = FALSE;
+		if (++cons == EMAC_NUM_RX_FRAG) cons = 0;
+	}
+	LPC_EMAC->RxConsumeIndex = cons;
+}
+
+
+/*********************************************************************//**
+ * @brief		Free the Tx buffers of every descriptor the EMAC has sent
+ * @param[in]	None
+ * @return		None
+ **********************************************************************/
+static void tx_reclaim (void)
+{
+	uint32_t cons = LPC_EMAC->TxConsumeIndex;
+
+	while (tx_clean != cons)
+	{
+		if (tx_owner[tx_clean] != EMAC_PBUF_CALLER)
+		{
+			tx_busy &= ~(1 << tx_owner[tx_clean]);
+			tx_owner[tx_clean] = EMAC_PBUF_CALLER;
 		}
+		if (++tx_clean == EMAC_NUM_TX_FRAG) tx_clean = 0;
 	}
-	return crc;
 }
+
+
+/*********************************************************************//**
+ * @brief		Allocate a free Tx buffer
+ * @param[in]	None
+ * @return		Buffer number, (-1) if all are claimed or queued
+ **********************************************************************/
+static int32_t tx_alloc (void)
+{
+	int32_t buf;
+
+	tx_reclaim();
+	for (buf = 0; buf < EMAC_NUM_TX_BUF; buf++)
+	{
+		if (!(tx_busy & (1 << buf)))
+		{
+			tx_busy |= (1 << buf);
+			return buf;
+		}
+	}
+	return (-1);
+}
+
+
 /* End of Private Functions --------------------------------------------------- */
 
 
@@ -578,7 +597,7 @@ Status EMAC_Init(EMAC_CFG_Type *EMAC_ConfigStruct)
 	 * Find the clock that close to desired target clock
 	 */
 	tmp = SystemCoreClock / EMAC_MCFG_MII_MAXCLK;
-	for (tout = 0; tout < sizeof (EMAC_clkdiv); tout++){
+	for (tout = 0; tout < (int32_t)sizeof (EMAC_clkdiv); tout++){
 		if (EMAC_clkdiv[tout] >= tmp) break;
 	}
 	tout++;
@@ -925,12 +944,10 @@ void EMAC_SetHashFilter(uint8_t dstMAC_addr[], FunctionalState NewState)
 {
 	uint32_t *pReg;
 	uint32_t tmp;
-	int32_t crc;
+	uint8_t crc;
 
-	// Calculate the CRC from the destination MAC address
-	crc = emac_CRCCalc(dstMAC_addr, 6);
-	// Extract the value from CRC to get index value for hash filter table
-	crc = (crc >> 23) & 0x3F;
+	// Get index value for hash filter table from CRC of destination MAC address
+	crc = CRC32_HashIndex(dstMAC_addr);
 
 	pReg = (crc > 31) ? ((uint32_t *)&LPC_EMAC->HashFilterH) \
 								: ((uint32_t *)&LPC_EMAC->HashFilterL);
@@ -1020,10 +1037,16 @@ void EMAC_WritePacketBuffer(EMAC_PACKETBUF_Type *pDataStruct)
 {
 	uint32_t idx,len;
 	uint32_t *sp,*dp;
+	int32_t buf;
+
+	// Wait for a buffer, queued frames always drain
+	while ((buf = tx_alloc()) < 0);
 
 	idx = LPC_EMAC->TxProduceIndex;
+	tx_owner[idx] = buf;
+	Tx_Desc[idx].Packet = EMAC_BUS_ADDR(tx_buf[buf]);
 	sp  = (uint32_t *)pDataStruct->pbDataBuf;
-	dp  = (uint32_t *)Tx_Desc[idx].Packet;
+	dp  = (uint32_t *)tx_buf[buf];
 	/* Copy frame data to EMAC packet buffers. */
 	for (len = (pDataStruct->ulDataLen + 3) >> 2; len; len--) {
 		*dp++ = *sp++;
@@ -1046,7 +1069,7 @@ void EMAC_ReadPacketBuffer(EMAC_PACKETBUF_Type *pDataStruct)
 
 	idx = LPC_EMAC->RxConsumeIndex;
 	dp = (uint32_t *)pDataStruct->pbDataBuf;
-	sp = (uint32_t *)Rx_Desc[idx].Packet;
+	sp = (uint32_t *)rx_buf[idx];
 
 	if (pDataStruct->pbDataBuf != NULL) {
 		for (len = (pDataStruct->ulDataLen + 3) >> 2; len; len--) {
@@ -1055,6 +1078,156 @@ void EMAC_ReadPacketBuffer(EMAC_PACKETBUF_Type *pDataStruct)
 	}
 }
 
+/*********************************************************************//**
+ * @brief		Take the next received frame in place, without copying
+ * @param[out]	pbuf	Loaned frame: data pointer into the Rx ring and
+ * 						length without FCS
+ * @return		SUCCESS if a frame was loaned, ERROR if none is pending
+ *
+ * Note: Frames are loaned in arrival order and may be released in any
+ * order. The EMAC stops receiving once all descriptors are on loan.
+ * Fragmented and errored frames are dropped here.
+ **********************************************************************/
+Status EMAC_RxTake(EMAC_PBUF_Type *pbuf)
+{
+	uint32_t idx, info;
+
+	while (rx_take != LPC_EMAC->RxProduceIndex)
+	{
+		idx = rx_take;
+		if (++rx_take == EMAC_NUM_RX_FRAG) rx_take = 0;
+
+		info = Rx_Stat[idx].Info;
+		// Size is in (-1) style format and includes the 4-bytes CRC field
+		if ((info & EMAC_RINFO_LAST_FLAG) && !(info & EMAC_RINFO_ERR_MASK)
+				&& ((info & EMAC_RINFO_SIZE) >= 4))
+		{
+			pbuf->pbData = rx_buf[idx];
+			pbuf->ulDataLen = (info & EMAC_RINFO_SIZE) - 3;
+			pbuf->bIndex = idx;
+			return SUCCESS;
+		}
+		rx_release(idx);
+	}
+	return ERROR;
+}
+
+/*********************************************************************//**
+ * @brief		Hand a frame loaned by EMAC_RxTake() back to the EMAC
+ * @param[in]	pbuf	Loaned frame
+ * @return		None
+ **********************************************************************/
+void EMAC_RxRelease(EMAC_PBUF_Type *pbuf)
+{
+	if (pbuf->bIndex < EMAC_NUM_RX_FRAG)
+	{
+		rx_release(pbuf->bIndex);
+		pbuf->bIndex = EMAC_PBUF_CALLER;
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Claim a Tx buffer to build a frame in place
+ * @param[out]	pbuf	Claimed buffer, ulDataLen holds its capacity
+ * @return		SUCCESS if a buffer was claimed, ERROR if all are in use
+ **********************************************************************/
+Status EMAC_TxClaim(EMAC_PBUF_Type *pbuf)
+{
+	int32_t buf = tx_alloc();
+
+	if (buf < 0)
+	{
+		return ERROR;
+	}
+	pbuf->pbData = tx_buf[buf];
+	pbuf->ulDataLen = EMAC_ETH_MAX_FLEN;
+	pbuf->bIndex = buf;
+	return SUCCESS;
+}
+
+/*********************************************************************//**
+ * @brief		Return a claimed Tx buffer without sending it
+ * @param[in]	pbuf	Claimed buffer
+ * @return		None
+ **********************************************************************/
+void EMAC_TxDiscard(EMAC_PBUF_Type *pbuf)
+{
+	if (pbuf->bIndex < EMAC_NUM_TX_BUF)
+	{
+		tx_busy &= ~(1 << pbuf->bIndex);
+		pbuf->bIndex = EMAC_PBUF_CALLER;
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Queue one frame made of one or more fragments
+ * @param[in]	frag	Fragments in frame order. Claimed buffers pass to
+ * 						the driver and are freed once sent. Caller owned
+ * 						data (bIndex = EMAC_PBUF_CALLER) must sit in AHB
+ * 						SRAM and stay unchanged until EMAC_TxPending()
+ * 						drops below the count seen after this call
+ * @param[in]	num		Number of fragments
+ * @return		SUCCESS, or ERROR if there are not enough free descriptors
+ * 				or a fragment is empty or runs past its buffer (a claimed
+ * 				one holds EMAC_ETH_MAX_FLEN bytes), the fragments stay
+ * 				with the caller
+ **********************************************************************/
+Status EMAC_TxSend(EMAC_PBUF_Type *frag, uint8_t num)
+{
+	uint32_t idx, ctrl, free, off, max;
+	uint8_t i;
+
+	tx_reclaim();
+	idx = LPC_EMAC->TxProduceIndex;
+	free = (LPC_EMAC->TxConsumeIndex + EMAC_NUM_TX_FRAG - idx - 1) % EMAC_NUM_TX_FRAG;
+	if ((num == 0) || (num > free))
+	{
+		return ERROR;
+	}
+	for (i = 0; i < num; i++)
+	{
+		max = EMAC_TCTRL_SIZE + 1;
+		if (frag[i].bIndex < EMAC_NUM_TX_BUF)
+		{
+			// A claimed buffer ends EMAC_ETH_MAX_FLEN bytes after its start
+			off = (uint32_t)(frag[i].pbData - tx_buf[frag[i].bIndex]);
+			max = (off < EMAC_ETH_MAX_FLEN) ? (EMAC_ETH_MAX_FLEN - off) : 0;
+		}
+		if ((frag[i].ulDataLen == 0) || (frag[i].ulDataLen > max))
+		{
+			return ERROR;
+		}
+	}
+
+	for (i = 0; i < num; i++)
+	{
+		ctrl = frag[i].ulDataLen - 1;
+		if (i == (num - 1))
+		{
+			ctrl |= EMAC_TCTRL_INT | EMAC_TCTRL_LAST;
+		}
+		Tx_Desc[idx].Packet = EMAC_BUS_ADDR(frag[i].pbData);
+		Tx_Desc[idx].Ctrl = ctrl;
+		tx_owner[idx] = (frag[i].bIndex < EMAC_NUM_TX_BUF) ? frag[i].bIndex : EMAC_PBUF_CALLER;
+		frag[i].bIndex = EMAC_PBUF_CALLER;
+		if (++idx == EMAC_NUM_TX_FRAG) idx = 0;
+	}
+	// Start frame transmission, all fragments at once
+	LPC_EMAC->TxProduceIndex = idx;
+	return SUCCESS;
+}
+
+/*********************************************************************//**
+ * @brief		Get the number of Tx descriptors not yet sent
+ * @param[in]	None
+ * @return		Queued descriptors
+ **********************************************************************/
+uint32_t EMAC_TxPending(void)
+{
+	tx_reclaim();
+	return (LPC_EMAC->TxProduceIndex + EMAC_NUM_TX_FRAG - LPC_EMAC->TxConsumeIndex) % EMAC_NUM_TX_FRAG;
+}
+
 /*********************************************************************//**
  * @brief 		Enable/Disable interrupt for each type in EMAC
  * @param[in]	ulIntType	Interrupt Type, should be:
@@ -1203,6 +1376,12 @@ void EMAC_UpdateRxConsumeIndex(void)
 	// Get current Rx consume index
 	uint32_t idx = LPC_EMAC->RxConsumeIndex;
 
+	// Keep the zero-copy loan index in step
+	if (rx_take == idx)
+	{
+		if (++rx_take == EMAC_NUM_RX_FRAG) rx_take = 0;
+	}
+
 	/* Release frame from EMAC buffer */
 	if (++idx == EMAC_NUM_RX_FRAG) idx = 0;
 	LPC_EMAC->RxConsumeIndex = idx;
@@ -1285,15 +1464,10 @@ void DummyReadFrame_EMAC(unsigned short Size)    // discards an EVEN number of b
 // returns the frame length
 unsigned short StartReadFrame(void) {
 	unsigned short RxLen;
-	EMAC_PACKETBUF_Type RxPack;
 
 	RxLen = EMAC_GetReceiveDataSize() - 3;
-	// Copy packet to data buffer
-	RxPack.pbDataBuf = (uint32_t *)pgBuf;
-	RxPack.ulDataLen = RxLen;
-	EMAC_ReadPacketBuffer(&RxPack);
-	// Point to the data buffer
-	rptr = (unsigned short *)pgBuf;
+	// Read straight from the Rx descriptor buffer
+	rptr = (unsigned short *)rx_buf[LPC_EMAC->RxConsumeIndex];
 	return(RxLen);
 }
 
@@ -1317,6 +1491,7 @@ unsigned int CheckFrameReceived(void) {             // Packet received ?
 void RequestSend(unsigned short FrameSize)
 {
 	// Nothing to do here, just implemented in CopyToFrame_EMAC()
+	(void)FrameSize;
 }
 
 // check if ethernet controller is ready to accept the
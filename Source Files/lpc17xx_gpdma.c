@@ -0,0 +1,785 @@
+/******************************************************************//**
+* @file		lpc17xx_gpdma.c
+* @brief	Contains all functions support for GPDMA firmware library on LPC17xx
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @addtogroup GPDMA
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc17xx_gpdma.h"
+#include "lpc_prof.h"
+
+/* If this source file built with example, the LPC17xx FW library configuration
+ * file in each example directory ("lpc17xx_libcfg.h") must be included,
+ * otherwise the default FW library configuration file must be included instead
+ */
+
+/* Private Variables ---------------------------------------------------------- */
+/**
+ * @brief Lookup Table of Connection Type matched with
+ * Peripheral Data (FIFO) register base address
+ */
+static const uint32_t GPDMA_LUTPerAddr[] = {
+		(LPC_SSP0_BASE + 0x08),		// SSP0 Tx		DR
+		(LPC_SSP0_BASE + 0x08),		// SSP0 Rx		DR
+		(LPC_SSP1_BASE + 0x08),		// SSP1 Tx		DR
+		(LPC_SSP1_BASE + 0x08),		// SSP1 Rx		DR
+		(LPC_ADC_BASE + 0x04),		// ADC			ADGDR
+		(LPC_I2S_BASE + 0x08),		// I2S Tx		I2STXFIFO
+		(LPC_I2S_BASE + 0x0C),		// I2S Rx		I2SRXFIFO
+		(LPC_DAC_BASE + 0x00),		// DAC			DACR
+		(LPC_UART0_BASE + 0x00),	// UART0 Tx		THR
+		(LPC_UART0_BASE + 0x00),	// UART0 Rx		RBR
+		(LPC_UART1_BASE + 0x00),	// UART1 Tx		THR
+		(LPC_UART1_BASE + 0x00),	// UART1 Rx		RBR
+		(LPC_UART2_BASE + 0x00),	// UART2 Tx		THR
+		(LPC_UART2_BASE + 0x00),	// UART2 Rx		RBR
+		(LPC_UART3_BASE + 0x00),	// UART3 Tx		THR
+		(LPC_UART3_BASE + 0x00),	// UART3 Rx		RBR
+		(LPC_TIM0_BASE + 0x18),		// MAT0.0		MR0
+		(LPC_TIM0_BASE + 0x1C),		// MAT0.1		MR1
+		(LPC_TIM1_BASE + 0x18),		// MAT1.0		MR0
+		(LPC_TIM1_BASE + 0x1C),		// MAT1.1		MR1
+		(LPC_TIM2_BASE + 0x18),		// MAT2.0		MR0
+		(LPC_TIM2_BASE + 0x1C),		// MAT2.1		MR1
+		(LPC_TIM3_BASE + 0x18),		// MAT3.0		MR0
+		(LPC_TIM3_BASE + 0x1C)		// MAT3.1		MR1
+};
+
+/**
+ * @brief Lookup Table of GPDMA Channel Number matched with
+ * GPDMA channel pointer
+ */
+static LPC_GPDMACH_TypeDef * const pGPDMACh[GPDMA_NUM_CHANNELS] = {
+		LPC_GPDMACH0,	// GPDMA Channel 0
+		LPC_GPDMACH1,	// GPDMA Channel 1
+		LPC_GPDMACH2,	// GPDMA Channel 2
+		LPC_GPDMACH3,	// GPDMA Channel 3
+		LPC_GPDMACH4,	// GPDMA Channel 4
+		LPC_GPDMACH5,	// GPDMA Channel 5
+		LPC_GPDMACH6,	// GPDMA Channel 6
+		LPC_GPDMACH7	// GPDMA Channel 7
+};
+
+/**
+ * @brief Optimized Peripheral Source and Destination burst size
+ */
+static const uint8_t GPDMA_LUTPerBurst[] = {
+		GPDMA_BSIZE_4,	// SSP0 Tx
+		GPDMA_BSIZE_4,	// SSP0 Rx
+		GPDMA_BSIZE_4,	// SSP1 Tx
+		GPDMA_BSIZE_4,	// SSP1 Rx
+		GPDMA_BSIZE_1,	// ADC
+		GPDMA_BSIZE_32, // I2S channel 0
+		GPDMA_BSIZE_32, // I2S channel 1
+		GPDMA_BSIZE_1,	// DAC
+		GPDMA_BSIZE_1,	// UART0 Tx
+		GPDMA_BSIZE_1,	// UART0 Rx
+		GPDMA_BSIZE_1,	// UART1 Tx
+		GPDMA_BSIZE_1,	// UART1 Rx
+		GPDMA_BSIZE_1,	// UART2 Tx
+		GPDMA_BSIZE_1,	// UART2 Rx
+		GPDMA_BSIZE_1,	// UART3 Tx
+		GPDMA_BSIZE_1,	// UART3 Rx
+		GPDMA_BSIZE_1,	// MAT0.0
+		GPDMA_BSIZE_1,	// MAT0.1
+		GPDMA_BSIZE_1,	// MAT1.0
+		GPDMA_BSIZE_1,	// MAT1.1
+		GPDMA_BSIZE_1,	// MAT2.0
+		GPDMA_BSIZE_1,	// MAT2.1
+		GPDMA_BSIZE_1,	// MAT3.0
+		GPDMA_BSIZE_1	// MAT3.1
+};
+
+/**
+ * @brief Optimized Peripheral Source and Destination transfer width
+ */
+static const uint8_t GPDMA_LUTPerWid[] = {
+		GPDMA_WIDTH_BYTE,	// SSP0 Tx
+		GPDMA_WIDTH_BYTE,	// SSP0 Rx
+		GPDMA_WIDTH_BYTE,	// SSP1 Tx
+		GPDMA_WIDTH_BYTE,	// SSP1 Rx
+		GPDMA_WIDTH_WORD,	// ADC
+		GPDMA_WIDTH_WORD, 	// I2S channel 0
+		GPDMA_WIDTH_WORD, 	// I2S channel 1
+		GPDMA_WIDTH_WORD,	// DAC
+		GPDMA_WIDTH_BYTE,	// UART0 Tx
+		GPDMA_WIDTH_BYTE,	// UART0 Rx
+		GPDMA_WIDTH_BYTE,	// UART1 Tx
+		GPDMA_WIDTH_BYTE,	// UART1 Rx
+		GPDMA_WIDTH_BYTE,	// UART2 Tx
+		GPDMA_WIDTH_BYTE,	// UART2 Rx
+		GPDMA_WIDTH_BYTE,	// UART3 Tx
+		GPDMA_WIDTH_BYTE,	// UART3 Rx
+		GPDMA_WIDTH_WORD,	// MAT0.0
+		GPDMA_WIDTH_WORD,	// MAT0.1
+		GPDMA_WIDTH_WORD,	// MAT1.0
+		GPDMA_WIDTH_WORD,	// MAT1.1
+		GPDMA_WIDTH_WORD,	// MAT2.0
+		GPDMA_WIDTH_WORD,	// MAT2.1
+		GPDMA_WIDTH_WORD,	// MAT3.0
+		GPDMA_WIDTH_WORD	// MAT3.1
+};
+
+/** Completion callbacks installed by GPDMA_Setup() */
+static GPDMA_CALLBACK_Type GPDMA_Callback[GPDMA_NUM_CHANNELS];
+/** Channels handed out by GPDMA_AllocChannel() */
+static uint8_t GPDMA_AllocMask;
+
+/* Private Functions ---------------------------------------------------------- */
+/*********************************************************************//**
+ * @brief		Transfer width of a peripheral connection. SSP connections
+ * 				follow the frame size currently set in CR0 so 16-bit
+ * 				frames are moved as half words.
+ * @param[in]	conn	GPDMA_CONN_xxx
+ * @return 		GPDMA_WIDTH_xxx
+ **********************************************************************/
+static uint32_t gpdma_per_width(uint32_t conn)
+{
+	if (conn <= GPDMA_CONN_SSP1_Rx)
+	{
+		LPC_SSP_TypeDef *SSPx = (conn <= GPDMA_CONN_SSP0_Rx) ? LPC_SSP0 : LPC_SSP1;
+
+		if ((SSPx->CR0 & 0x0F) > 7)
+		{
+			return GPDMA_WIDTH_HALFWORD;
+		}
+	}
+	return GPDMA_LUTPerWid[conn];
+}
+
+/*********************************************************************//**
+ * @brief		Build the channel control word for one linked list item
+ * @param[in]	cfg		Channel configuration
+ * @param[in]	size	Transfer size of this item
+ * @return 		DMACCControl value without the terminal count bit
+ **********************************************************************/
+static uint32_t gpdma_control(GPDMA_Channel_CFG_Type *cfg, uint32_t size)
+{
+	uint32_t ctrl = GPDMA_DMACCxControl_TransferSize(size);
+	uint32_t sinc = (cfg->Options & GPDMA_OPT_SRC_FIXED) ? 0 : GPDMA_DMACCxControl_SI;
+	uint32_t dinc = (cfg->Options & GPDMA_OPT_DST_FIXED) ? 0 : GPDMA_DMACCxControl_DI;
+	uint32_t width;
+
+	switch (cfg->TransferType)
+	{
+	// Memory to memory
+	case GPDMA_TRANSFERTYPE_M2M:
+		ctrl |= GPDMA_DMACCxControl_SBSize(GPDMA_BSIZE_32) \
+				| GPDMA_DMACCxControl_DBSize(GPDMA_BSIZE_32) \
+				| GPDMA_DMACCxControl_SWidth(cfg->TransferWidth) \
+				| GPDMA_DMACCxControl_DWidth(cfg->TransferWidth) \
+				| sinc | dinc;
+		break;
+	// Memory to peripheral
+	case GPDMA_TRANSFERTYPE_M2P:
+		width = gpdma_per_width(cfg->DstConn);
+		ctrl |= GPDMA_DMACCxControl_SBSize(GPDMA_LUTPerBurst[cfg->DstConn]) \
+				| GPDMA_DMACCxControl_DBSize(GPDMA_LUTPerBurst[cfg->DstConn]) \
+				| GPDMA_DMACCxControl_SWidth(width) \
+				| GPDMA_DMACCxControl_DWidth(width) \
+				| sinc;
+		break;
+	// Peripheral to memory
+	case GPDMA_TRANSFERTYPE_P2M:
+		width = gpdma_per_width(cfg->SrcConn);
+		ctrl |= GPDMA_DMACCxControl_SBSize(GPDMA_LUTPerBurst[cfg->SrcConn]) \
+				| GPDMA_DMACCxControl_DBSize(GPDMA_LUTPerBurst[cfg->SrcConn]) \
+				| GPDMA_DMACCxControl_SWidth(width) \
+				| GPDMA_DMACCxControl_DWidth(width) \
+				| dinc;
+		break;
+	// Peripheral to peripheral
+	default:
+		ctrl |= GPDMA_DMACCxControl_SBSize(GPDMA_LUTPerBurst[cfg->SrcConn]) \
+				| GPDMA_DMACCxControl_DBSize(GPDMA_LUTPerBurst[cfg->DstConn]) \
+				| GPDMA_DMACCxControl_SWidth(gpdma_per_width(cfg->SrcConn)) \
+				| GPDMA_DMACCxControl_DWidth(gpdma_per_width(cfg->DstConn));
+		break;
+	}
+	return ctrl;
+}
+
+/*********************************************************************//**
+ * @brief		Size in bytes of one transfer of a control word
+ * @param[in]	ctrl	DMACCControl value
+ * @return 		1, 2 or 4
+ **********************************************************************/
+static uint32_t gpdma_item_bytes(uint32_t ctrl)
+{
+	return 1UL << ((ctrl >> 18) & 0x07);
+}
+
+/*********************************************************************//**
+ * @brief		Check a channel configuration
+ * @param[in]	cfg		Channel configuration
+ * @return 		SUCCESS if the channel can be programmed
+ **********************************************************************/
+static Status gpdma_check(GPDMA_Channel_CFG_Type *cfg)
+{
+	CHECK_PARAM(PARAM_GPDMA_CHANNEL(cfg->ChannelNum));
+	CHECK_PARAM(PARAM_GPDMA_TRANSFERTYPE(cfg->TransferType));
+
+	if ((cfg->ChannelNum >= GPDMA_NUM_CHANNELS) || (cfg->TransferSize == 0))
+	{
+		return ERROR;
+	}
+	if (((cfg->TransferType == GPDMA_TRANSFERTYPE_P2M) || (cfg->TransferType == GPDMA_TRANSFERTYPE_P2P)) \
+			&& (cfg->SrcConn > GPDMA_CONN_MAT3_1))
+	{
+		return ERROR;
+	}
+	if (((cfg->TransferType == GPDMA_TRANSFERTYPE_M2P) || (cfg->TransferType == GPDMA_TRANSFERTYPE_P2P)) \
+			&& (cfg->DstConn > GPDMA_CONN_MAT3_1))
+	{
+		return ERROR;
+	}
+	// Channel is still running
+	if (LPC_GPDMA->DMACEnbldChns & GPDMA_DMACIntStat_Ch(cfg->ChannelNum))
+	{
+		return ERROR;
+	}
+	return SUCCESS;
+}
+
+/*********************************************************************//**
+ * @brief		Map a connection to its DMA request line, selecting UART
+ * 				or timer match requests in DMAREQSEL
+ * @param[in]	conn	GPDMA_CONN_xxx
+ * @return 		Request line number for DMACCConfig
+ **********************************************************************/
+static uint32_t gpdma_request(uint32_t conn)
+{
+	if (conn >= GPDMA_CONN_MAT0_0)
+	{
+		LPC_SC->DMAREQSEL |= (1UL << (conn - GPDMA_CONN_MAT0_0));
+		return conn - 8;
+	}
+	if (conn >= GPDMA_CONN_UART0_Tx)
+	{
+		LPC_SC->DMAREQSEL &= ~(1UL << (conn - GPDMA_CONN_UART0_Tx));
+	}
+	return conn;
+}
+
+/*********************************************************************//**
+ * @brief		Program a channel with its first linked list item
+ * @param[in]	cfg		Channel configuration
+ * @param[in]	src		Source address of the first item
+ * @param[in]	dst		Destination address of the first item
+ * @param[in]	lli		Next linked list item, 0 if none
+ * @param[in]	ctrl	Control word of the first item
+ * @return 		None
+ **********************************************************************/
+static void gpdma_program(GPDMA_Channel_CFG_Type *cfg, uint32_t src, uint32_t dst, \
+		uint32_t lli, uint32_t ctrl)
+{
+	LPC_GPDMACH_TypeDef *pDMAch = pGPDMACh[cfg->ChannelNum];
+	uint32_t srcper = 0, dstper = 0;
+
+	// Reset the Interrupt status
+	LPC_GPDMA->DMACIntTCClear = GPDMA_DMACIntStat_Ch(cfg->ChannelNum);
+	LPC_GPDMA->DMACIntErrClr = GPDMA_DMACIntStat_Ch(cfg->ChannelNum);
+
+	// Clear DMA configure
+	pDMAch->DMACCControl = 0x00;
+	pDMAch->DMACCConfig = 0x00;
+
+	GPDMA_Callback[cfg->ChannelNum] = cfg->Callback;
+
+	/* Assign Linker List Item value */
+	pDMAch->DMACCLLI = lli & GPDMA_DMACCxLLI_BITMASK;
+	pDMAch->DMACCSrcAddr = src;
+	pDMAch->DMACCDestAddr = dst;
+	pDMAch->DMACCControl = ctrl;
+
+	if ((cfg->TransferType == GPDMA_TRANSFERTYPE_P2M) || (cfg->TransferType == GPDMA_TRANSFERTYPE_P2P))
+	{
+		srcper = gpdma_request(cfg->SrcConn);
+	}
+	if ((cfg->TransferType == GPDMA_TRANSFERTYPE_M2P) || (cfg->TransferType == GPDMA_TRANSFERTYPE_P2P))
+	{
+		dstper = gpdma_request(cfg->DstConn);
+	}
+
+	/* Configure DMA Channel, enable Error Counter and Terminate counter */
+	pDMAch->DMACCConfig = GPDMA_DMACCxConfig_IE | GPDMA_DMACCxConfig_ITC \
+		| GPDMA_DMACCxConfig_TransferType(cfg->TransferType) \
+		| GPDMA_DMACCxConfig_SrcPeripheral(srcper) \
+		| GPDMA_DMACCxConfig_DestPeripheral(dstper);
+}
+
+/*********************************************************************//**
+ * @brief		Source address of a transfer
+ * @param[in]	cfg		Channel configuration
+ * @return 		Memory address or peripheral data register address
+ **********************************************************************/
+static uint32_t gpdma_src(GPDMA_Channel_CFG_Type *cfg)
+{
+	if ((cfg->TransferType == GPDMA_TRANSFERTYPE_P2M) || (cfg->TransferType == GPDMA_TRANSFERTYPE_P2P))
+	{
+		return GPDMA_LUTPerAddr[cfg->SrcConn];
+	}
+	return cfg->SrcMemAddr;
+}
+
+/*********************************************************************//**
+ * @brief		Destination address of a transfer
+ * @param[in]	cfg		Channel configuration
+ * @return 		Memory address or peripheral data register address
+ **********************************************************************/
+static uint32_t gpdma_dst(GPDMA_Channel_CFG_Type *cfg)
+{
+	if ((cfg->TransferType == GPDMA_TRANSFERTYPE_M2P) || (cfg->TransferType == GPDMA_TRANSFERTYPE_P2P))
+	{
+		return GPDMA_LUTPerAddr[cfg->DstConn];
+	}
+	return cfg->DstMemAddr;
+}
+
+/* Public Functions ----------------------------------------------------------- */
+/** @addtogroup GPDMA_Public_Functions
+ * @{
+ */
+
+/********************************************************************//**
+ * @brief 		Initialize GPDMA controller
+ * 					- Power up the GPDMA block
+ * 					- Reset all eight channels and their callbacks
+ * 					- Enable the controller and the DMA interrupt
+ * @param 		None
+ * @return 		None
+ *********************************************************************/
+void GPDMA_Init(void)
+{
+	uint32_t ch;
+
+	/* Enable GPDMA clock */
+	CLKPWR_ConfigPPWR (CLKPWR_PCONP_PCGPDMA, ENABLE);
+
+	// Reset all channel configuration register
+	for (ch = 0; ch < GPDMA_NUM_CHANNELS; ch++)
+	{
+		pGPDMACh[ch]->DMACCConfig = 0;
+		GPDMA_Callback[ch] = NULL;
+	}
+	GPDMA_AllocMask = 0;
+
+	/* Clear all DMA interrupt and error flag */
+	LPC_GPDMA->DMACIntTCClear = 0xFF;
+	LPC_GPDMA->DMACIntErrClr = 0xFF;
+
+	/* Enable DMA channels, little endian */
+	LPC_GPDMA->DMACConfig = GPDMA_DMACConfig_E;
+	while (!(LPC_GPDMA->DMACConfig & GPDMA_DMACConfig_E));
+
+	NVIC_SetPriority(DMA_IRQn, 1);
+	NVIC_EnableIRQ(DMA_IRQn);
+}
+
+/********************************************************************//**
+ * @brief 		Reserve a free GPDMA channel. Channels are handed out
+ * 				from 0 upwards, so drivers allocating first get the
+ * 				higher bus priority.
+ * @param 		None
+ * @return 		Channel number, or -1 when all channels are in use
+ *********************************************************************/
+int32_t GPDMA_AllocChannel(void)
+{
+	uint32_t primask = __get_PRIMASK();
+	int32_t ch;
+
+	__disable_irq();
+	for (ch = 0; ch < GPDMA_NUM_CHANNELS; ch++)
+	{
+		if (!(GPDMA_AllocMask & (1 << ch)))
+		{
+			GPDMA_AllocMask |= (1 << ch);
+			break;
+		}
+	}
+	__set_PRIMASK(primask);
+
+	return (ch < GPDMA_NUM_CHANNELS) ? ch : -1;
+}
+
+/********************************************************************//**
+ * @brief 		Stop a channel and return it to the free pool
+ * @param[in]	ChannelNum	Channel number returned by GPDMA_AllocChannel()
+ * @return 		None
+ *********************************************************************/
+void GPDMA_FreeChannel(uint32_t ChannelNum)
+{
+	uint32_t primask;
+
+	CHECK_PARAM(PARAM_GPDMA_CHANNEL(ChannelNum));
+
+	GPDMA_ChannelCmd(ChannelNum, DISABLE);
+	GPDMA_Callback[ChannelNum] = NULL;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	GPDMA_AllocMask &= ~(1 << ChannelNum);
+	__set_PRIMASK(primask);
+}
+
+/********************************************************************//**
+ * @brief 		Setup GPDMA channel peripheral according to the specified
+ *               parameters in the GPDMAChannelConfig.
+ * @param[in]	GPDMAChannelConfig Pointer to a GPDMA_Channel_CFG_Type
+ * 									structure that contains the configuration
+ * 									information for the specified GPDMA channel
+ * 									peripheral, TransferSize must not exceed
+ * 									GPDMA_MAX_XFER.
+ * @return		ERROR if selected channel is enabled before
+ * 				or SUCCESS if channel is configured successfully
+ *********************************************************************/
+Status GPDMA_Setup(GPDMA_Channel_CFG_Type *GPDMAChannelConfig)
+{
+	uint32_t ctrl;
+
+	if ((gpdma_check(GPDMAChannelConfig) == ERROR) || (GPDMAChannelConfig->TransferSize > GPDMA_MAX_XFER))
+	{
+		return ERROR;
+	}
+
+	ctrl = gpdma_control(GPDMAChannelConfig, GPDMAChannelConfig->TransferSize) | GPDMA_DMACCxControl_I;
+	gpdma_program(GPDMAChannelConfig, gpdma_src(GPDMAChannelConfig), gpdma_dst(GPDMAChannelConfig), \
+			GPDMAChannelConfig->DMALLI, ctrl);
+
+	return SUCCESS;
+}
+
+/********************************************************************//**
+ * @brief 		Setup a GPDMA channel for a transfer of any length. The
+ * 				transfer is split into linked list items of at most
+ * 				GPDMA_MAX_XFER units which the controller walks on its
+ * 				own. With GPDMA_OPT_CIRCULAR the last item links back to
+ * 				the first one and every item raises a terminal count,
+ * 				otherwise only the last item does and DMALLI is appended.
+ * @param[in]	GPDMAChannelConfig	Channel configuration
+ * @param[in]	LLIList	Word aligned storage for the chain, must stay
+ * 						valid until the transfer has finished
+ * @param[in]	LLINum	Number of entries in LLIList, at least
+ * 						GPDMA_ChainLength(TransferSize)
+ * @return		ERROR if the channel is busy or LLIList is too short,
+ * 				SUCCESS otherwise
+ *********************************************************************/
+Status GPDMA_SetupChain(GPDMA_Channel_CFG_Type *GPDMAChannelConfig, GPDMA_LLI_Type *LLIList, uint32_t LLINum)
+{
+	GPDMA_Channel_CFG_Type *cfg = GPDMAChannelConfig;
+	uint32_t num, i, left, chunk, ctrl, src, dst;
+
+	num = GPDMA_ChainLength(cfg->TransferSize);
+	if ((gpdma_check(cfg) == ERROR) || (num > LLINum))
+	{
+		return ERROR;
+	}
+
+	src = gpdma_src(cfg);
+	dst = gpdma_dst(cfg);
+	left = cfg->TransferSize;
+	for (i = 0; i < num; i++)
+	{
+		chunk = (left > GPDMA_MAX_XFER) ? GPDMA_MAX_XFER : left;
+		ctrl = gpdma_control(cfg, chunk);
+		if ((i == num - 1) || (cfg->Options & GPDMA_OPT_CIRCULAR))
+		{
+			ctrl |= GPDMA_DMACCxControl_I;
+		}
+
+		LLIList[i].SrcAddr = src;
+		LLIList[i].DstAddr = dst;
+		LLIList[i].Control = ctrl;
+		if (i < num - 1)
+		{
+			LLIList[i].NextLLI = GPDMA_BUS_ADDR(&LLIList[i + 1]);
+		}
+		else if (cfg->Options & GPDMA_OPT_CIRCULAR)
+		{
+			LLIList[i].NextLLI = GPDMA_BUS_ADDR(&LLIList[0]);
+		}
+		else
+		{
+			LLIList[i].NextLLI = cfg->DMALLI;
+		}
+
+		// Advance the incrementing side(s)
+		if (ctrl & GPDMA_DMACCxControl_SI)
+		{
+			src += chunk * gpdma_item_bytes(ctrl);
+		}
+		if (ctrl & GPDMA_DMACCxControl_DI)
+		{
+			dst += chunk * gpdma_item_bytes(ctrl);
+		}
+		left -= chunk;
+	}
+
+	gpdma_program(cfg, LLIList[0].SrcAddr, LLIList[0].DstAddr, LLIList[0].NextLLI, LLIList[0].Control);
+
+	return SUCCESS;
+}
+
+/********************************************************************//**
+ * @brief 		Setup a GPDMA channel for a circular transfer split into
+ * 				LLINum equal linked list items which all raise a terminal
+ * 				count. With two items the channel ping-pongs over the two
+ * 				halves of the buffer: the callback of one half runs while
+ * 				the controller fills or drains the other one.
+ * @param[in]	GPDMAChannelConfig	Channel configuration, TransferSize
+ * 						covers the whole ring
+ * @param[in]	LLIList	Word aligned storage for LLINum items, must stay
+ * 						valid while the channel runs
+ * @param[in]	LLINum	Number of items, must divide TransferSize into
+ * 						items of at most GPDMA_MAX_XFER units
+ * @return		ERROR if the channel is busy or the ring cannot be split,
+ * 				SUCCESS otherwise
+ *********************************************************************/
+Status GPDMA_SetupRing(GPDMA_Channel_CFG_Type *GPDMAChannelConfig, GPDMA_LLI_Type *LLIList, uint32_t LLINum)
+{
+	GPDMA_Channel_CFG_Type *cfg = GPDMAChannelConfig;
+	uint32_t i, chunk, ctrl, src, dst;
+
+	if ((gpdma_check(cfg) == ERROR) || (LLINum == 0) || (cfg->TransferSize % LLINum))
+	{
+		return ERROR;
+	}
+	chunk = cfg->TransferSize / LLINum;
+	if (chunk > GPDMA_MAX_XFER)
+	{
+		return ERROR;
+	}
+
+	ctrl = gpdma_control(cfg, chunk) | GPDMA_DMACCxControl_I;
+	src = gpdma_src(cfg);
+	dst = gpdma_dst(cfg);
+	for (i = 0; i < LLINum; i++)
+	{
+		LLIList[i].SrcAddr = src;
+		LLIList[i].DstAddr = dst;
+		LLIList[i].Control = ctrl;
+		LLIList[i].NextLLI = GPDMA_BUS_ADDR(&LLIList[(i + 1) % LLINum]);
+
+		if (ctrl & GPDMA_DMACCxControl_SI)
+		{
+			src += chunk * gpdma_item_bytes(ctrl);
+		}
+		if (ctrl & GPDMA_DMACCxControl_DI)
+		{
+			dst += chunk * gpdma_item_bytes(ctrl);
+		}
+	}
+
+	gpdma_program(cfg, LLIList[0].SrcAddr, LLIList[0].DstAddr, LLIList[0].NextLLI, LLIList[0].Control);
+
+	return SUCCESS;
+}
+
+/********************************************************************//**
+ * @brief 		Number of linked list items GPDMA_SetupChain() needs
+ * @param[in]	TransferSize	Transfer size in transfer width units
+ * @return		Number of GPDMA_LLI_Type entries
+ *********************************************************************/
+uint32_t GPDMA_ChainLength(uint32_t TransferSize)
+{
+	return (TransferSize + GPDMA_MAX_XFER - 1) / GPDMA_MAX_XFER;
+}
+
+/*********************************************************************//**
+ * @brief		Enable/Disable DMA channel. A channel being disabled is
+ * 				halted first so data already read from the source is
+ * 				not lost.
+ * @param[in]	channelNum	GPDMA channel, should be in range from 0 to 7
+ * @param[in]	NewState	New State of this command, should be:
+ * 					- ENABLE.
+ * 					- DISABLE.
+ * @return		None
+ **********************************************************************/
+void GPDMA_ChannelCmd(uint8_t channelNum, FunctionalState NewState)
+{
+	LPC_GPDMACH_TypeDef *pDMAch;
+	uint32_t timeout = 0xFFFF;
+
+	CHECK_PARAM(PARAM_GPDMA_CHANNEL(channelNum));
+	CHECK_PARAM(PARAM_FUNCTIONALSTATE(NewState));
+
+	// Get Channel pointer
+	pDMAch = pGPDMACh[channelNum];
+
+	if (NewState == ENABLE)
+	{
+		pDMAch->DMACCConfig |= GPDMA_DMACCxConfig_E;
+	}
+	else
+	{
+		pDMAch->DMACCConfig |= GPDMA_DMACCxConfig_H;
+		while ((pDMAch->DMACCConfig & GPDMA_DMACCxConfig_A) && --timeout);
+		pDMAch->DMACCConfig &= ~(GPDMA_DMACCxConfig_E | GPDMA_DMACCxConfig_H);
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Transfers still to be done in the current linked list item
+ * @param[in]	channelNum	GPDMA channel, should be in range from 0 to 7
+ * @return		Remaining transfer count
+ **********************************************************************/
+uint32_t GPDMA_GetTransferCount(uint8_t channelNum)
+{
+	CHECK_PARAM(PARAM_GPDMA_CHANNEL(channelNum));
+
+	return pGPDMACh[channelNum]->DMACCControl & 0xFFF;
+}
+
+/*********************************************************************//**
+ * @brief		Address the channel writes to next, tells the consumer of
+ * 				a GPDMA_SetupRing() ring which item the controller is in
+ * @param[in]	channelNum	GPDMA channel, should be in range from 0 to 7
+ * @return		Current destination address
+ **********************************************************************/
+uint32_t GPDMA_GetDestAddr(uint8_t channelNum)
+{
+	CHECK_PARAM(PARAM_GPDMA_CHANNEL(channelNum));
+
+	return pGPDMACh[channelNum]->DMACCDestAddr;
+}
+
+/*********************************************************************//**
+ * @brief		Address the channel reads from next, the counterpart of
+ * 				GPDMA_GetDestAddr() for a ring feeding a peripheral
+ * @param[in]	channelNum	GPDMA channel, should be in range from 0 to 7
+ * @return		Current source address
+ **********************************************************************/
+uint32_t GPDMA_GetSrcAddr(uint8_t channelNum)
+{
+	CHECK_PARAM(PARAM_GPDMA_CHANNEL(channelNum));
+
+	return pGPDMACh[channelNum]->DMACCSrcAddr;
+}
+
+/*********************************************************************//**
+ * @brief		Check if corresponding channel does have an active interrupt
+ * 				request or not
+ * @param[in]	type		type of status, should be:
+ * 					- GPDMA_STAT_INT:		GP DMA status interrupt
+ * 					- GPDMA_STAT_INTTC:		GP DMA terminal count interrupt status
+ * 					- GPDMA_STAT_INTERR:	GP DMA error interrupt status
+ * 					- GPDMA_STAT_RAWINTTC:	GP DMA raw terminal count interrupt status
+ * 					- GPDMA_STAT_RAWINTERR:	GP DMA raw error interrupt status
+ * 					- GPDMA_STAT_ENABLED_CH:GP DMA enabled channel status
+ * @param[in]	channel		GPDMA channel, should be in range from 0 to 7
+ * @return		IntStatus	status of DMA channel interrupt after masking
+ * 				Should be:
+ * 					- SET: the corresponding channel has no active interrupt request
+ * 					- RESET: the corresponding channel does have an active interrupt request
+ **********************************************************************/
+IntStatus GPDMA_IntGetStatus(GPDMA_Status_Type type, uint8_t channel)
+{
+	CHECK_PARAM(PARAM_GPDMA_STAT(type));
+	CHECK_PARAM(PARAM_GPDMA_CHANNEL(channel));
+
+	switch (type)
+	{
+	case GPDMA_STAT_INT: //check status of DMA channel interrupts
+		if (LPC_GPDMA->DMACIntStat & (GPDMA_DMACIntStat_Ch(channel)))
+			return SET;
+		return RESET;
+	case GPDMA_STAT_INTTC: // check terminal count interrupt request status for DMA
+		if (LPC_GPDMA->DMACIntTCStat & GPDMA_DMACIntStat_Ch(channel))
+			return SET;
+		return RESET;
+	case GPDMA_STAT_INTERR: //check interrupt status for DMA channels
+		if (LPC_GPDMA->DMACIntErrStat & GPDMA_DMACIntStat_Ch(channel))
+			return SET;
+		return RESET;
+	case GPDMA_STAT_RAWINTTC: //check status of the terminal count interrupt for DMA channels
+		if (LPC_GPDMA->DMACRawIntTCStat & GPDMA_DMACIntStat_Ch(channel))
+			return SET;
+		return RESET;
+	case GPDMA_STAT_RAWINTERR: //check status of the error interrupt for DMA channels
+		if (LPC_GPDMA->DMACRawIntErrStat & GPDMA_DMACIntStat_Ch(channel))
+			return SET;
+		return RESET;
+	default: //check enable status for DMA channels
+		if (LPC_GPDMA->DMACEnbldChns & GPDMA_DMACIntStat_Ch(channel))
+			return SET;
+		return RESET;
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Clear one or more interrupt requests on DMA channels
+ * @param[in]	type		type of interrupt request, should be:
+ * 					- GPDMA_STATCLR_INTTC: GP DMA Interrupt Terminal Count Request Clear
+ * 					- GPDMA_STATCLR_INTERR: GP DMA Interrupt Error Clear
+ * @param[in]	channel		GPDMA channel, should be in range from 0 to 7
+ * @return		None
+ **********************************************************************/
+void GPDMA_ClearIntPending(GPDMA_StateClear_Type type, uint8_t channel)
+{
+	CHECK_PARAM(PARAM_GPDMA_STATCLR(type));
+	CHECK_PARAM(PARAM_GPDMA_CHANNEL(channel));
+
+	if (type == GPDMA_STATCLR_INTTC) // clears the terminal count interrupt request on DMA channel
+		LPC_GPDMA->DMACIntTCClear = GPDMA_DMACIntStat_Ch(channel);
+	else // clear the error interrupt request
+		LPC_GPDMA->DMACIntErrClr = GPDMA_DMACIntStat_Ch(channel);
+}
+
+/*********************************************************************//**
+ * @brief		GPDMA interrupt handler. Status registers are read once,
+ * 				the pending flags cleared and the channel callbacks run
+ * 				in priority order.
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void DMA_IRQHandler (void)
+{
+	uint32_t stat, tc, err, ch;
+
+	PROF_ISR_ENTER(DMA_IRQn);
+	stat = LPC_GPDMA->DMACIntStat;
+	tc = LPC_GPDMA->DMACIntTCStat;
+	err = LPC_GPDMA->DMACIntErrStat;
+	LPC_GPDMA->DMACIntTCClear = tc;
+	LPC_GPDMA->DMACIntErrClr = err;
+
+	for (ch = 0; stat && (ch < GPDMA_NUM_CHANNELS); ch++)
+	{
+		if (!(stat & GPDMA_DMACIntStat_Ch(ch)))
+		{
+			continue;
+		}
+		stat &= ~GPDMA_DMACIntStat_Ch(ch);
+		if (GPDMA_Callback[ch] == NULL)
+		{
+			continue;
+		}
+		if (err & GPDMA_DMACIntStat_Ch(ch))
+		{
+			GPDMA_Callback[ch](ch, GPDMA_STAT_INTERR);
+		}
+		if (tc & GPDMA_DMACIntStat_Ch(ch))
+		{
+			GPDMA_Callback[ch](ch, GPDMA_STAT_INTTC);
+		}
+	}
+	PROF_ISR_EXIT(DMA_IRQn);
+}
+
+/**
+ * @}
+ */
+
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
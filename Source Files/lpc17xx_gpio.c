@@ -15,8 +15,13 @@
 /* Includes ------------------------------------------------------------------- */
 #include "lpc_system_init.h"
 #include "lpc17xx_gpio.h"
+#include "lpc_prof.h"
 
 
+/* Private Variables ---------------------------------------------------------- */
+/** GPIO interrupt callback, see GPIO_SetIntCallback() */
+static GPIO_INT_CB_Type gpio_int_cb = NULL;
+
 
 /* Public Functions ----------------------------------------------------------- */
 /** @addtogroup GPIO_Interrupt_Functions
@@ -31,19 +36,13 @@
  **********************************************************************/
 void EINT3_IRQHandler(void)
 {
-/*	int j;
-	if(GPIO_GetIntStatus(0, 19, 0)) //Rising Edge
+	PROF_ISR_ENTER(EINT3_IRQn);
+	/* e.g. key wake-up of the input subsystem */
+	if (gpio_int_cb != NULL)
 	{
-		GPIO_ClearInt(0,_BIT(19));
-
-		for (j= 0; j<10; j++)
-		{
-			GPIO_ClearValue(0,_BIT(10));
-			delay_ms(250);
-			GPIO_SetValue(0,_BIT(10));
-			delay_ms(250);
-		}
-    }*/
+		gpio_int_cb();
+	}
+	PROF_ISR_EXIT(EINT3_IRQn);
 }
 
 /**
@@ -332,6 +331,17 @@ void GPIO_ClearInt(uint8_t portNum, uint32_t bitValue)
 		while(1);
 }
 
+/*********************************************************************//**
+ * @brief		Set the function EINT3_IRQHandler calls on GPIO interrupts
+ * @param[in]	cb		Callback, it checks and clears its own pins.
+ * 						NULL for none.
+ * @return		None
+ **********************************************************************/
+void GPIO_SetIntCallback(GPIO_INT_CB_Type cb)
+{
+	gpio_int_cb = cb;
+}
+
 /* FIO word accessible ----------------------------------------------------------------- */
 /* Stub function for FIO (word-accessible) style */
 
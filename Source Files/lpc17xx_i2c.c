@@ -13,6 +13,8 @@
 
 /* Includes ------------------------------------------------------------------- */
 #include "lpc17xx_i2c.h"
+#include "lpc_sched.h"
+#include "lpc_prof.h"
 
 
 /* If this source file built with example, the LPC17xx FW library configuration
@@ -20,6 +22,15 @@
  * otherwise the default FW library configuration file must be included instead
  */
 
+/* Public Variables ----------------------------------------------------------- */
+#if (I2C_DATABIT_SIZE == 8)
+uint8_t I2C_Tx_Buf[BUFFER_SIZE];
+uint8_t I2C_Rx_Buf[BUFFER_SIZE];
+#else
+uint16_t I2C_Tx_Buf[BUFFER_SIZE];
+uint16_t I2C_Rx_Buf[BUFFER_SIZE];
+#endif
+
 /* Private Types -------------------------------------------------------------- */
 /** @defgroup I2C_Private_Types I2C Private Types
  * @{
@@ -30,10 +41,24 @@
  */
 typedef struct
 {
-  uint32_t      txrx_setup; 						/* Transmission setup */
+  void          *txrx_setup;						/* Transmission setup */
   int32_t		dir;								/* Current direction phase, 0 - write, 1 - read */
+  int32_t		slave;								/* 1 - interrupt transfer is in slave mode */
 } I2C_CFG_T;
 
+/**
+ * @brief I2C transaction queue of one bus
+ */
+typedef struct
+{
+  I2C_XFER_Type		*head;							/* Waiting transactions, by priority */
+  I2C_XFER_Type		*cur;							/* Transaction on the bus */
+  I2C_M_SETUP_Type	setup;							/* I2C_MasterHandler state of cur */
+  int32_t			phase;							/* 1 - read part of a stop-start transaction */
+  __IO uint32_t		ticks;							/* I2C_QueueTick() calls since last start */
+  SCHED_TIMER_Type	wdt;							/* Watchdog, calls I2C_QueueTick() every tick */
+} I2C_QUEUE_T;
+
 /**
  * @}
  */
@@ -49,6 +74,11 @@ static uint32_t I2C_SlaveComplete[3];
 
 static uint32_t I2C_MonitorBufferIndex;
 
+/**
+ * @brief Transaction queues for I2C0, I2C1 and I2C2
+ */
+static I2C_QUEUE_T i2cq[3];
+
 /* Private Functions ---------------------------------------------------------- */
 
 /* Get I2C number */
@@ -69,6 +99,22 @@ static uint32_t I2C_GetByte (LPC_I2C_TypeDef *I2Cx, uint8_t *retdat, Bool ack);
 /* I2C set clock (hz) */
 static void I2C_SetClock (LPC_I2C_TypeDef *I2Cx, uint32_t target_clock);
 
+/* Start the current part of the queued transaction on the bus */
+static void I2C_QueueRun (LPC_I2C_TypeDef *I2Cx, int32_t num);
+
+/* Finish the queued transaction on the bus and start the next one */
+static void I2C_QueueDone (LPC_I2C_TypeDef *I2Cx, int32_t num);
+
+/* Start the bus watchdog on the first queued transaction */
+static void I2C_QueueInit (LPC_I2C_TypeDef *I2Cx, int32_t num);
+
+/* Bus watchdog timer expiry */
+static void I2C_QueueWatchdog (SCHED_TIMER_Type *tmr);
+
+/* Master transfer, polled or interrupt started */
+static Status I2C_MasterTransfer (LPC_I2C_TypeDef *I2Cx, I2C_M_SETUP_Type *TransferCfg, \
+								I2C_TRANSFER_OPT_Type Opt);
+
 /*--------------------------------------------------------------------------------*/
 /********************************************************************//**
  * @brief		Convert from I2C peripheral to number
@@ -216,8 +262,194 @@ static void I2C_SetClock (LPC_I2C_TypeDef *I2Cx, uint32_t target_clock)
 	I2Cx->I2SCLH = (uint32_t)(temp / 2);
 	I2Cx->I2SCLL = (uint32_t)(temp - I2Cx->I2SCLH);
 }
+
+/********************************************************************//**
+ * @brief		Start the current part of the queued transaction, taking
+ * 				the next waiting one if the bus is free. Called with the
+ * 				I2C interrupt masked.
+ * @param[in]	I2Cx: I2C peripheral selected, should be:
+ * 				- LPC_I2C0
+ * 				- LPC_I2C1
+ * 				- LPC_I2C2
+ * @param[in]	num: I2C number of I2Cx
+ * @return 		None
+ *********************************************************************/
+static void I2C_QueueRun (LPC_I2C_TypeDef *I2Cx, int32_t num)
+{
+	I2C_QUEUE_T *q = &i2cq[num];
+	I2C_XFER_Type *x;
+
+	if (q->cur == NULL)
+	{
+		x = q->head;
+		if (x == NULL)
+		{
+			return;
+		}
+		q->head = x->next;
+		q->cur = x;
+		q->phase = 0;
+		q->setup.retransmissions_count = 0;
+		x->state = I2C_XFER_BUSY;
+	}
+	x = q->cur;
+
+	q->setup.sl_addr7bit = x->sl_addr7bit;
+	q->setup.tx_data = NULL;
+	q->setup.tx_length = 0;
+	q->setup.rx_data = NULL;
+	q->setup.rx_length = 0;
+	if (q->phase == 0)
+	{
+		q->setup.tx_data = x->tx_data;
+		q->setup.tx_length = x->tx_length;
+	}
+	if ((q->phase == 1) || (x->restart) || (x->tx_length == 0))
+	{
+		q->setup.rx_data = x->rx_data;
+		q->setup.rx_length = x->rx_length;
+	}
+	q->setup.tx_count = 0;
+	q->setup.rx_count = 0;
+	q->setup.retransmissions_max = x->retries;
+	q->setup.status = 0;
+	q->setup.callback = NULL;
+	q->ticks = 0;
+
+	i2cdat[num].txrx_setup = &q->setup;
+	i2cdat[num].dir = 0;
+	i2cdat[num].slave = 0;
+	// A STOP still pending from the last transaction goes out first
+	I2Cx->I2CONSET = I2C_I2CONSET_STA;
+	I2C_IntCmd(I2Cx, 1);
+}
+
+/********************************************************************//**
+ * @brief		Finish the queued transaction on the bus, call its
+ * 				callback and start the next one. Called with the I2C
+ * 				interrupt masked.
+ * @param[in]	I2Cx: I2C peripheral selected, should be:
+ * 				- LPC_I2C0
+ * 				- LPC_I2C1
+ * 				- LPC_I2C2
+ * @param[in]	num: I2C number of I2Cx
+ * @return 		None
+ *********************************************************************/
+static void I2C_QueueDone (LPC_I2C_TypeDef *I2Cx, int32_t num)
+{
+	I2C_QUEUE_T *q = &i2cq[num];
+	I2C_XFER_Type *x = q->cur;
+
+	x->status = q->setup.status;
+	if ((q->setup.status & I2C_SETUP_STATUS_DONE) && (q->phase == 0) &&
+		(!x->restart) && (x->tx_length != 0) && (x->rx_length != 0))
+	{
+		// Write part done, read after a stop
+		q->phase = 1;
+		q->setup.retransmissions_count = 0;
+		I2C_QueueRun(I2Cx, num);
+		return;
+	}
+
+	q->cur = NULL;
+	x->state = (q->setup.status & I2C_SETUP_STATUS_DONE) ? I2C_XFER_DONE : I2C_XFER_FAILED;
+	if (x->callback != NULL)
+	{
+		x->callback(x);
+	}
+	// The callback may have submitted and started a transaction already
+	if (q->cur == NULL)
+	{
+		I2C_QueueRun(I2Cx, num);
+	}
+}
+
+/********************************************************************//**
+ * @brief		Set up the watchdog of a bus queue, a periodic SCHED
+ * 				timer calling I2C_QueueTick() every tick. Only buses
+ * 				that queue transactions run one.
+ * @param[in]	I2Cx: I2C peripheral selected, should be:
+ * 				- LPC_I2C0
+ * 				- LPC_I2C1
+ * 				- LPC_I2C2
+ * @param[in]	num: I2C number of I2Cx
+ * @return 		None
+ *********************************************************************/
+static void I2C_QueueInit (LPC_I2C_TypeDef *I2Cx, int32_t num)
+{
+	SCHED_TimerInit(&i2cq[num].wdt, I2C_QueueWatchdog, I2Cx);
+	SCHED_TimerStart(&i2cq[num].wdt, 1, 1);
+}
+
+/********************************************************************//**
+ * @brief		Bus watchdog timer expiry, from SysTick_Handler
+ * @param[in]	tmr: watchdog timer, Arg is the I2C peripheral
+ * @return 		None
+ *********************************************************************/
+static void I2C_QueueWatchdog (SCHED_TIMER_Type *tmr)
+{
+	I2C_QueueTick((LPC_I2C_TypeDef *)tmr->Arg);
+}
 /* End of Private Functions --------------------------------------------------- */
 
+/*----------------- INTERRUPT SERVICE ROUTINES --------------------------*/
+/*********************************************************************//**
+ * @brief 		I2C0 interrupt handler
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void I2C0_IRQHandler (void)
+{
+	PROF_ISR_ENTER(I2C0_IRQn);
+	if (i2cdat[0].slave)
+	{
+		I2C_SlaveHandler(LPC_I2C0);
+	}
+	else
+	{
+		I2C_MasterHandler(LPC_I2C0);
+	}
+	PROF_ISR_EXIT(I2C0_IRQn);
+}
+
+/*********************************************************************//**
+ * @brief 		I2C1 interrupt handler
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void I2C1_IRQHandler (void)
+{
+	PROF_ISR_ENTER(I2C1_IRQn);
+	if (i2cdat[1].slave)
+	{
+		I2C_SlaveHandler(LPC_I2C1);
+	}
+	else
+	{
+		I2C_MasterHandler(LPC_I2C1);
+	}
+	PROF_ISR_EXIT(I2C1_IRQn);
+}
+
+/*********************************************************************//**
+ * @brief 		I2C2 interrupt handler
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void I2C2_IRQHandler (void)
+{
+	PROF_ISR_ENTER(I2C2_IRQn);
+	if (i2cdat[2].slave)
+	{
+		I2C_SlaveHandler(LPC_I2C2);
+	}
+	else
+	{
+		I2C_MasterHandler(LPC_I2C2);
+	}
+	PROF_ISR_EXIT(I2C2_IRQn);
+}
+
 
 /* Public Functions ----------------------------------------------------------- */
 /** @addtogroup I2C_Public_Functions
@@ -460,12 +692,21 @@ void I2C_MasterHandler (LPC_I2C_TypeDef  *I2Cx)
 	returnCode = (I2Cx->I2STAT & I2C_STAT_CODE_BITMASK);
 	// Save current status
 	txrx_setup->status = returnCode;
+	// Bus is alive, restart the queue watchdog
+	i2cq[tmp].ticks = 0;
 	// there's no relevant information
 	if (returnCode == I2C_I2STAT_NO_INF)
 	{
 		I2Cx->I2CONCLR = I2C_I2CONCLR_SIC;
 		return;
 	}
+	// bus error, STO releases the interface without a STOP on the bus
+	if (returnCode == I2C_I2STAT_BUS_ERROR)
+	{
+		I2Cx->I2CONSET = I2C_I2CONSET_STO;
+		txrx_setup->status |= I2C_SETUP_STATUS_ARBF;
+		goto retry;
+	}
 
 	/* ----------------------------- TRANSMIT PHASE --------------------------*/
 	if (i2cdat[tmp].dir == 0)
@@ -639,13 +880,16 @@ send_slar:
 		case I2C_I2STAT_M_RX_ARB_LOST:
 			// update status
 			txrx_setup->status |= I2C_SETUP_STATUS_ARBF;
+			// fall through
 		default:
 retry:
 			// check if retransmission is available
 			if (txrx_setup->retransmissions_count < txrx_setup->retransmissions_max)
 			{
-				// Clear tx count
+				// Clear counters, start over with the write phase
 				txrx_setup->tx_count = 0;
+				txrx_setup->rx_count = 0;
+				i2cdat[tmp].dir = 0;
 				I2Cx->I2CONSET = I2C_I2CONSET_STA;
 				I2Cx->I2CONCLR = I2C_I2CONCLR_AAC | I2C_I2CONCLR_SIC;
 				txrx_setup->retransmissions_count++;
@@ -660,6 +904,14 @@ end_stage:
 				I2C_Stop(I2Cx);
 
 				I2C_MasterComplete[tmp] = TRUE;
+				if (txrx_setup == &i2cq[tmp].setup)
+				{
+					I2C_QueueDone(I2Cx, tmp);
+				}
+				else if (txrx_setup->callback != NULL)
+				{
+					txrx_setup->callback();
+				}
 			}
 			break;
 		}
@@ -821,28 +1073,10 @@ s_int_end:
 }
 
 /*********************************************************************//**
- * @brief 		Transmit and Receive data in master mode
- * @param[in]	I2Cx			I2C peripheral selected, should be:
- *  			- LPC_I2C0
- * 				- LPC_I2C1
- * 				- LPC_I2C2
- * @param[in]	TransferCfg		Pointer to a I2C_M_SETUP_Type structure that
- * 								contains specified information about the
- * 								configuration for master transfer.
- * @param[in]	Opt				a I2C_TRANSFER_OPT_Type type that selected for
- * 								interrupt or polling mode.
- * @return 		SUCCESS or ERROR
- *
- * Note:
- * - In case of using I2C to transmit data only, either transmit length set to 0
- * or transmit data pointer set to NULL.
- * - In case of using I2C to receive data only, either receive length set to 0
- * or receive data pointer set to NULL.
- * - In case of using I2C to transmit followed by receive data, transmit length,
- * transmit data pointer, receive length and receive data pointer should be set
- * corresponding.
+ * @brief 		Transfer of I2C_MasterTransferData(), kept apart so the
+ * 				profiler scope covers all of its returns
  **********************************************************************/
-Status I2C_MasterTransferData(LPC_I2C_TypeDef *I2Cx, I2C_M_SETUP_Type *TransferCfg, \
+static Status I2C_MasterTransfer (LPC_I2C_TypeDef *I2Cx, I2C_M_SETUP_Type *TransferCfg, \
 								I2C_TRANSFER_OPT_Type Opt)
 {
 	uint8_t *txdat;
@@ -858,6 +1092,13 @@ Status I2C_MasterTransferData(LPC_I2C_TypeDef *I2Cx, I2C_M_SETUP_Type *TransferC
 	TransferCfg->rx_count = 0;
 	TransferCfg->status = 0;
 
+	// The bus belongs to the transaction queue until it runs empty
+	tmp = I2C_getNum(I2Cx);
+	if ((i2cq[tmp].cur != NULL) || (i2cq[tmp].head != NULL))
+	{
+		return ERROR;
+	}
+
 	if (Opt == I2C_TRANSFER_POLLING)
 	{
 		/* First Start condition -------------------------------------------------------------- */
@@ -1039,9 +1280,10 @@ error:
 	{
 		// Setup tx_rx data, callback and interrupt handler
 		tmp = I2C_getNum(I2Cx);
-		i2cdat[tmp].txrx_setup = (uint32_t) TransferCfg;
+		i2cdat[tmp].txrx_setup = TransferCfg;
 		// Set direction phase, write first
 		i2cdat[tmp].dir = 0;
+		i2cdat[tmp].slave = 0;
 
 		/* First Start condition -------------------------------------------------------------- */
 		I2Cx->I2CONCLR = I2C_I2CONCLR_SIC;
@@ -1054,6 +1296,40 @@ error:
 	return ERROR;
 }
 
+/*********************************************************************//**
+ * @brief 		Transmit and Receive data in master mode
+ * @param[in]	I2Cx			I2C peripheral selected, should be:
+ *  			- LPC_I2C0
+ * 				- LPC_I2C1
+ * 				- LPC_I2C2
+ * @param[in]	TransferCfg		Pointer to a I2C_M_SETUP_Type structure that
+ * 								contains specified information about the
+ * 								configuration for master transfer.
+ * @param[in]	Opt				a I2C_TRANSFER_OPT_Type type that selected for
+ * 								interrupt or polling mode.
+ * @return 		SUCCESS or ERROR
+ *
+ * Note:
+ * - In case of using I2C to transmit data only, either transmit length set to 0
+ * or transmit data pointer set to NULL.
+ * - In case of using I2C to receive data only, either receive length set to 0
+ * or receive data pointer set to NULL.
+ * - In case of using I2C to transmit followed by receive data, transmit length,
+ * transmit data pointer, receive length and receive data pointer should be set
+ * corresponding.
+ **********************************************************************/
+Status I2C_MasterTransferData(LPC_I2C_TypeDef *I2Cx, I2C_M_SETUP_Type *TransferCfg, \
+								I2C_TRANSFER_OPT_Type Opt)
+{
+	Status ret;
+
+	PROF_BEGIN(PROF_ID_I2C_XFER);
+	ret = I2C_MasterTransfer(I2Cx, TransferCfg, Opt);
+	PROF_END(PROF_ID_I2C_XFER);
+
+	return ret;
+}
+
 /*********************************************************************//**
  * @brief 		Receive and Transmit data in slave mode
  * @param[in]	I2Cx			I2C peripheral selected, should be
@@ -1254,9 +1530,10 @@ s_error:
 	{
 		// Setup tx_rx data, callback and interrupt handler
 		tmp = I2C_getNum(I2Cx);
-		i2cdat[tmp].txrx_setup = (uint32_t) TransferCfg;
+		i2cdat[tmp].txrx_setup = TransferCfg;
 		// Set direction phase, read first
 		i2cdat[tmp].dir = 1;
+		i2cdat[tmp].slave = 1;
 
 		// Enable AA
 		I2Cx->I2CONSET = I2C_I2CONSET_AA;
@@ -1468,6 +1745,174 @@ uint32_t I2C_SlaveTransferComplete(LPC_I2C_TypeDef *I2Cx)
 	return retval;
 }
 
+/*********************************************************************//**
+ * @brief 		Queue a transaction, the bus works through the queue in
+ * 				interrupt mode: highest priority first, FIFO within one
+ * 				priority. A transaction on the bus is never preempted.
+ * @param[in]	I2Cx	I2C peripheral selected, should be:
+ *  			- LPC_I2C0
+ * 				- LPC_I2C1
+ * 				- LPC_I2C2
+ * @param[in]	xfer	Transaction descriptor, owned by the driver until
+ * 						its callback runs (or state leaves QUEUED/BUSY)
+ * @return 		SUCCESS, or ERROR if xfer is already queued or on the bus
+ *
+ * Note:
+ * - May be called from the completion callback to chain transactions.
+ * - The first transaction on a bus starts its watchdog, a periodic
+ *   SCHED timer that recovers a stuck bus (see I2C_QueueTick()).
+ **********************************************************************/
+Status I2C_QueueSubmit (LPC_I2C_TypeDef *I2Cx, I2C_XFER_Type *xfer)
+{
+	I2C_QUEUE_T *q;
+	I2C_XFER_Type **link;
+	uint32_t primask;
+	int32_t tmp;
+
+	CHECK_PARAM(PARAM_I2Cx(I2Cx));
+
+	tmp = I2C_getNum(I2Cx);
+	q = &i2cq[tmp];
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if ((xfer->state == I2C_XFER_QUEUED) || (xfer->state == I2C_XFER_BUSY))
+	{
+		__set_PRIMASK(primask);
+		return ERROR;
+	}
+	// Behind every waiting transaction of the same or higher priority
+	link = &q->head;
+	while ((*link != NULL) && ((*link)->priority <= xfer->priority))
+	{
+		link = &(*link)->next;
+	}
+	xfer->next = *link;
+	*link = xfer;
+	xfer->state = I2C_XFER_QUEUED;
+	xfer->status = 0;
+	if (q->wdt.Callback == NULL)
+	{
+		I2C_QueueInit(I2Cx, tmp);
+	}
+	if (q->cur == NULL)
+	{
+		I2C_QueueRun(I2Cx, tmp);
+	}
+	__set_PRIMASK(primask);
+	return SUCCESS;
+}
+
+/*********************************************************************//**
+ * @brief 		Take a waiting transaction off the queue, its callback
+ * 				is not called
+ * @param[in]	I2Cx	I2C peripheral selected, should be:
+ *  			- LPC_I2C0
+ * 				- LPC_I2C1
+ * 				- LPC_I2C2
+ * @param[in]	xfer	Transaction descriptor
+ * @return 		SUCCESS, or ERROR if xfer is on the bus or not queued
+ **********************************************************************/
+Status I2C_QueueCancel (LPC_I2C_TypeDef *I2Cx, I2C_XFER_Type *xfer)
+{
+	I2C_XFER_Type **link;
+	uint32_t primask;
+	Status ret = ERROR;
+
+	CHECK_PARAM(PARAM_I2Cx(I2Cx));
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	for (link = &i2cq[I2C_getNum(I2Cx)].head; *link != NULL; link = &(*link)->next)
+	{
+		if (*link == xfer)
+		{
+			*link = xfer->next;
+			xfer->state = I2C_XFER_IDLE;
+			ret = SUCCESS;
+			break;
+		}
+	}
+	__set_PRIMASK(primask);
+	return ret;
+}
+
+/*********************************************************************//**
+ * @brief 		Get number of queued transactions
+ * @param[in]	I2Cx	I2C peripheral selected, should be:
+ *  			- LPC_I2C0
+ * 				- LPC_I2C1
+ * 				- LPC_I2C2
+ * @return 		Waiting transactions plus the one on the bus
+ **********************************************************************/
+uint32_t I2C_QueuePending (LPC_I2C_TypeDef *I2Cx)
+{
+	I2C_QUEUE_T *q;
+	I2C_XFER_Type *x;
+	uint32_t primask, cnt;
+
+	CHECK_PARAM(PARAM_I2Cx(I2Cx));
+
+	q = &i2cq[I2C_getNum(I2Cx)];
+	primask = __get_PRIMASK();
+	__disable_irq();
+	cnt = (q->cur != NULL) ? 1 : 0;
+	for (x = q->head; x != NULL; x = x->next)
+	{
+		cnt++;
+	}
+	__set_PRIMASK(primask);
+	return cnt;
+}
+
+/*********************************************************************//**
+ * @brief 		Bus watchdog for the transaction queue, called every
+ * 				tick by the SCHED timer of the bus. When the transaction on the
+ * 				bus makes no progress for I2C_QUEUE_TIMEOUT ticks (slave
+ * 				holding SCL/SDA, lost interrupt) the interface is reset
+ * 				and the transaction retried or failed with
+ * 				I2C_SETUP_STATUS_TIMEOUT.
+ * @param[in]	I2Cx	I2C peripheral selected, should be:
+ *  			- LPC_I2C0
+ * 				- LPC_I2C1
+ * 				- LPC_I2C2
+ * @return 		None
+ **********************************************************************/
+void I2C_QueueTick (LPC_I2C_TypeDef *I2Cx)
+{
+	I2C_QUEUE_T *q;
+	uint32_t primask;
+	int32_t tmp;
+
+	CHECK_PARAM(PARAM_I2Cx(I2Cx));
+
+	tmp = I2C_getNum(I2Cx);
+	q = &i2cq[tmp];
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if ((q->cur != NULL) && (++q->ticks > I2C_QUEUE_TIMEOUT))
+	{
+		// Reset the interface, STO leaves it in not addressed slave mode
+		I2C_IntCmd(I2Cx, 0);
+		I2Cx->I2CONCLR = I2C_I2CONCLR_I2ENC | I2C_I2CONCLR_AAC | \
+						 I2C_I2CONCLR_SIC | I2C_I2CONCLR_STAC;
+		I2Cx->I2CONSET = I2C_I2CONSET_I2EN;
+		I2Cx->I2CONSET = I2C_I2CONSET_STO;
+		if (q->setup.retransmissions_count < q->setup.retransmissions_max)
+		{
+			q->setup.retransmissions_count++;
+			I2C_QueueRun(I2Cx, tmp);
+		}
+		else
+		{
+			q->setup.status |= I2C_SETUP_STATUS_TIMEOUT;
+			q->setup.status &= ~I2C_SETUP_STATUS_DONE;
+			I2C_QueueDone(I2Cx, tmp);
+		}
+	}
+	__set_PRIMASK(primask);
+}
+
 
 
 /**
@@ -25,27 +25,15 @@ void MCPWM_Channel_Config(LPC_MCPWM_TypeDef *MCPWMx, MCPWM_PCFG_TYPE PCfg, MCPWM
 
 /*----------------- INTERRUPT SERVICE ROUTINES --------------------------*/
 /*********************************************************************//**
- * @brief		MCPWM interrupt handler sub-routine
+ * @brief		MCPWM interrupt handler sub-routine. The DC motor loop
+ * 				runs from the QEI and uses no MCPWM interrupts, any flag
+ * 				left enabled is cleared here.
  * @param[in]	None
  * @return 		None
  **********************************************************************/
 void MCPWM_IRQHandler(void)
 {
-	// Check whether if capture event interrupt is set
-	if (MCPWM_GetIntStatus(LPC_MCPWM, MCPWM_INTFLAG_CAP0))
-	{
-		if (CapFlag == RESET)
-		{
-			// Store capture value
-			CapVal = MCPWM_GetCapture(LPC_MCPWM, 0);
-			// toggle capture flag
-			CapFlag = SET;
-			// Disable interrupt for capture event
-			MCPWM_IntConfig(LPC_MCPWM, MCPWM_INTFLAG_CAP0, DISABLE);
-		}
-		// Clear pending interrupt
-		MCPWM_IntClear(LPC_MCPWM, MCPWM_INTFLAG_CAP0);
-	}
+	MCPWM_IntClear(LPC_MCPWM, LPC_MCPWM->MCINTFLAG);
 }
 
 
@@ -145,9 +133,6 @@ void MCPWM_Channel_Config(LPC_MCPWM_TypeDef *MCPWMx, MCPWM_PCFG_TYPE PCfg, MCPWM
 			 captureCfg.timerReset = DISABLE;
 			 MCPWM_ConfigCapture(MCPWMx, 0, &captureCfg);
 
-			// Reset flag for the first time
-			 CapFlag = RESET;
-
             // Enable interrupt for capture event on MCI0 (MCFB0)
 			 MCPWM_IntConfig(MCPWMx, MCPWM_INTFLAG_CAP0, ENABLE);
 			 break;
@@ -14,6 +14,8 @@
 /* Includes ------------------------------------------------------------------- */
 #include "lpc_system_init.h"
 #include "lpc17xx_pwm.h"
+#include "lpc_pwm_seq.h"
+#include "lpc_prof.h"
 
 /* If this source file built with example, the LPC17xx FW library configuration
  * file in each example directory ("lpc17xx_libcfg.h") must be included,
@@ -29,29 +31,9 @@
  **********************************************************************/
 void PWM1_IRQHandler(void)
 {
-	/* Check whether if match flag for channel 0 is set or not */
-	if (PWM_GetIntStatus(LPC_PWM1, PWM_INTSTAT_MR0))
-	{
-		match_cnt++;
-		/* Clear the interrupt flag */
-
-		if (match_cnt >= 0x1000)
-		{
-			match_cnt = 0;
-			long_duty++;
-			if (long_duty >= 256)
-			{
-				// Reset duty
-				long_duty = 0;
-				// Print info
-		//		printf(LPC_UART0,"PWM1.1 is reset!");
-			}
-			// Update PWM1.1 duty
-			PWM_MatchUpdate(LPC_PWM1, 1, long_duty, PWM_MATCH_UPDATE_NOW);
-		}
-
-		PWM_ClearIntPending(LPC_PWM1, PWM_INTSTAT_MR0);
-	}
+	PROF_ISR_ENTER(PWM1_IRQn);
+	PWMSEQ_IntHandler();
+	PROF_ISR_EXIT(PWM1_IRQn);
 }
 
 
@@ -665,12 +647,13 @@ uint32_t PWM_GetCaptureValue(LPC_PWM_TypeDef *PWMx, uint8_t CaptureChannel)
  * @param[in]	PWMx	PWM peripheral selected, should be LPC_PWM1
  * @param[in]	MatchChannel Match channel
  * @param[in]	MatchValue Match value
- * @param[in]	UpdateType Type of Update, should be:
- * 				- PWM_MATCH_UPDATE_NOW: The update value will be updated for
- * 					this channel immediately
- * 				- PWM_MATCH_UPDATE_NEXT_RST: The update value will be updated for
- * 					this channel on next reset by a PWM Match event.
+ * @param[in]	UpdateType Deprecated, kept for source compatibility and
+ * 				ignored. PWM_MATCH_UPDATE_NOW and PWM_MATCH_UPDATE_NEXT_RST
+ * 				both latch the new value at the next MR0 match through LER.
  * @return		None
+ * Note: the match registers are shadowed, LER is set at once but they only
+ * 		load on MR0. The counter is not reset for PWM_MATCH_UPDATE_NOW any
+ * 		more, that cut the running period short on every channel.
  *********************************************************************/
 void PWM_MatchUpdate(LPC_PWM_TypeDef *PWMx, uint8_t MatchChannel, \
 					uint32_t MatchValue, uint8_t UpdateType)
@@ -678,6 +661,7 @@ void PWM_MatchUpdate(LPC_PWM_TypeDef *PWMx, uint8_t MatchChannel, \
 	CHECK_PARAM(PARAM_PWMx(PWMx));
 	CHECK_PARAM(PARAM_PWM1_MATCH_CHANNEL(MatchChannel));
 	CHECK_PARAM(PARAM_PWM_MATCH_UPDATE(UpdateType));
+	(void)UpdateType;
 
 	switch (MatchChannel)
 	{
@@ -712,13 +696,6 @@ void PWM_MatchUpdate(LPC_PWM_TypeDef *PWMx, uint8_t MatchChannel, \
 
 	// Write Latch register
 	PWMx->LER |= PWM_LER_EN_MATCHn_LATCH(MatchChannel);
-
-	// In case of update now
-	if (UpdateType == PWM_MATCH_UPDATE_NOW)
-	{
-		PWMx->TCR |= PWM_TCR_COUNTER_RESET;
-		PWMx->TCR &= (~PWM_TCR_COUNTER_RESET) & PWM_TCR_BITMASK;
-	}
 }
 
 /********************************************************************//**
@@ -726,20 +703,28 @@ void PWM_MatchUpdate(LPC_PWM_TypeDef *PWMx, uint8_t MatchChannel, \
  * 				at the same time
  * @param[in]	PWMx	PWM peripheral selected, should be LPC_PWM1
  * @param[in]	MatchStruct Structure that contents match value of 7 pwm channels
- * @param[in]	UpdateType Type of Update, should be:
- * 				- PWM_MATCH_UPDATE_NOW: The update value will be updated for
- * 					this channel immediately
- * 				- PWM_MATCH_UPDATE_NEXT_RST: The update value will be updated for
- * 					this channel on next reset by a PWM Match event.
+ * @param[in]	UpdateType Deprecated, kept for source compatibility and
+ * 				ignored. PWM_MATCH_UPDATE_NOW and PWM_MATCH_UPDATE_NEXT_RST
+ * 				both latch the new value at the next MR0 match through LER.
  * @return		None
+ * Note: the match registers are shadowed, LER is set at once but they only
+ * 		load on MR0. The counter is not reset for PWM_MATCH_UPDATE_NOW any
+ * 		more, that cut the running period short on every channel.
  *********************************************************************/
 void PWM_MultiMatchUpdate(LPC_PWM_TypeDef *PWMx, PWM_Match_T *MatchStruct , uint8_t UpdateType)
 {
 	uint8_t LatchValue = 0;
+	uint8_t PendValue;
 	uint8_t i;
 
 	CHECK_PARAM(PARAM_PWMx(PWMx));
 	CHECK_PARAM(PARAM_PWM_MATCH_UPDATE(UpdateType));
+	(void)UpdateType;
+
+	//Hold back latches still pending, so the next MR0 cannot take a part
+	//of the new values
+	PendValue = PWMx->LER & PWM_LER_BITMASK;
+	PWMx->LER = 0;
 
 	//Update match value
 	for(i=0;i<7;i++)
@@ -756,14 +741,7 @@ void PWM_MultiMatchUpdate(LPC_PWM_TypeDef *PWMx, PWM_Match_T *MatchStruct , uint
 		}
 	}
 	//set update for multi-channel at the same time
-	PWMx->LER = LatchValue;
-
-	// In case of update now
-	if (UpdateType == PWM_MATCH_UPDATE_NOW)
-	{
-		PWMx->TCR |= PWM_TCR_COUNTER_RESET;
-		PWMx->TCR &= (~PWM_TCR_COUNTER_RESET) & PWM_TCR_BITMASK;
-	}
+	PWMx->LER = PendValue | LatchValue;
 }
 /********************************************************************//**
  * @brief 		Configure Edge mode for each PWM channel
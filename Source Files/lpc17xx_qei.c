@@ -13,6 +13,8 @@
 
 /* Includes ------------------------------------------------------------------- */
 #include "lpc17xx_qei.h"
+#include "lpc_dc_motor.h"
+#include "lpc_prof.h"
 
 
 /* If this source file built with example, the LPC17xx FW library configuration
@@ -39,55 +41,16 @@ typedef union {
  */
 
 /*********************************************************************//**
- * @brief		QEI interrupt handler. This sub-routine will update current
- * 				value of captured velocity in to velocity accumulate.
+ * @brief		QEI interrupt handler. The velocity timer paces the DC
+ * 				motor control loop, which handles and clears the flags.
  * @param[in]	None
  * @return 		None
  **********************************************************************/
 void QEI_IRQHandler(void)
 {
-	uint8_t read;
-	uint32_t rpm, averageVelo;
-
-	// Check whether if velocity timer overflow
-	if (QEI_GetIntStatus(LPC_QEI, QEI_INTFLAG_TIM_Int) == SET)
-	{
-		if (VeloAccFlag == RESET)
-		{
-			// Get current velocity captured and update to accumulate
-			VeloAcc += QEI_GetVelocityCap(LPC_QEI);
-
-			// Update Velocity capture times
-			VeloAccFlag = ((VeloCapCnt++) >= MAX_CAP_TIMES) ? SET : RESET;
-		}
-		// Reset Interrupt flag pending
-		QEI_IntClear(LPC_QEI, QEI_INTFLAG_TIM_Int);
-	}
-
-	// Check whether if direction change occurred
-	if (QEI_GetIntStatus(LPC_QEI, QEI_INTFLAG_DIR_Int) == SET)
-	{
-		// Print direction status
-		printf(LPC_UART0,"\r\nDirection has changed: ");
-		printf(LPC_UART0,(QEI_GetStatus(LPC_QEI, QEI_STATUS_DIR) == SET) ? "1" : "0");
-		// Reset Interrupt flag pending
-		QEI_IntClear(LPC_QEI, QEI_INTFLAG_DIR_Int);
-	}
-
-	// Check VeloAccFlag continuously
-	if (VeloAccFlag == SET)
-	{
-		// Get Acc
-		averageVelo = (uint32_t)(VeloAcc / VeloCapCnt);
-		rpm = QEI_CalculateRPM(LPC_QEI, averageVelo, ENC_RES);
-		// Disp the result
-		printf(LPC_UART0,"\r\nSampling Speed: %d06 RPM",rpm);
-		// Reset VeloAccFlag
-		VeloAccFlag = RESET;
-		// Reset value of Acc and Acc count to default
-		VeloAcc = 0;
-		VeloCapCnt = 0;
-	}
+	PROF_ISR_ENTER(QEI_IRQn);
+	DCM_IntHandler();
+	PROF_ISR_EXIT(QEI_IRQn);
 }
 
 /* Public Functions ----------------------------------------------------------- */
@@ -150,16 +113,8 @@ void QEI_Config (void)
 	/* Enable interrupt for QEI  */
 	NVIC_EnableIRQ(QEI_IRQn);
 
-	// Reset VeloAccFlag
-	VeloAccFlag = RESET;
-	// Reset value of Acc and Acc count to default
-	VeloAcc = 0;
-	VeloCapCnt = 0;
-
-	// Enable interrupt for velocity Timer overflow for capture velocity into Acc */
+	// Enable interrupt for velocity Timer overflow */
 	QEI_IntCmd(LPC_QEI, QEI_INTFLAG_TIM_Int, ENABLE);
-	// Enable interrupt for direction change */
-	QEI_IntCmd(LPC_QEI, QEI_INTFLAG_DIR_Int, ENABLE);
 }
 
 
@@ -235,6 +190,7 @@ void QEI_Init(LPC_QEI_TypeDef *QEIx, QEI_CFG_Type *QEI_ConfigStruct)
 void QEI_DeInit(LPC_QEI_TypeDef *QEIx)
 {
 	CHECK_PARAM(PARAM_QEIx(QEIx));
+	(void)QEIx;
 
 	/* Turn off clock and power for QEI module */
 	CLKPWR_ConfigPPWR (CLKPWR_PCONP_PCQEI, DISABLE);
@@ -564,7 +520,9 @@ void QEI_IntClear(LPC_QEI_TypeDef *QEIx, uint32_t ulIntType)
 /*********************************************************************//**
  * @brief		Calculates the actual velocity in RPM passed via velocity
  * 				capture value and Pulse Per Round (of the encoder) value
- * 				parameter input.
+ * 				parameter input. The RPM per captured edge is worked out
+ * 				with 16 fraction bits when the clock, reload, capture mode
+ * 				or PPR change, each call after that is one multiply.
  * @param[in]	QEIx			QEI peripheral, should be LPC_QEI
  * @param[in]	ulVelCapValue	Velocity capture input value that can
  * 								be got from QEI_GetVelocityCap() function
@@ -573,18 +531,29 @@ void QEI_IntClear(LPC_QEI_TypeDef *QEIx, uint32_t ulIntType)
  **********************************************************************/
 uint32_t QEI_CalculateRPM(LPC_QEI_TypeDef *QEIx, uint32_t ulVelCapValue, uint32_t ulPPR)
 {
-	uint64_t rpm, clock, Load, edges;
+	static uint32_t rpm_clock, rpm_load, rpm_conf, rpm_ppr;
+	static uint64_t rpm_k;
+	uint32_t clock, Load, conf;
 
 	// Get current Clock rate for timer input
-	clock = (uint64_t)CLKPWR_GetPCLK(CLKPWR_PCLKSEL_QEI);
+	clock = CLKPWR_GetPCLK(CLKPWR_PCLKSEL_QEI);
 	// Get Timer load value (velocity capture period)
-	Load  = (uint64_t)(QEIx->QEILOAD + 1);
+	Load = QEIx->QEILOAD;
 	// Get Edge
-	edges = (uint64_t)((QEIx->QEICONF & QEI_CONF_CAPMODE) ? 4 : 2);
-	// Calculate RPM
-	rpm = ((clock * ulVelCapValue * 60) / (Load * ulPPR * edges));
+	conf = QEIx->QEICONF & QEI_CONF_CAPMODE;
+
+	if ((clock != rpm_clock) || (Load != rpm_load) || (conf != rpm_conf)
+			|| (ulPPR != rpm_ppr) || (rpm_k == 0))
+	{
+		rpm_clock = clock;
+		rpm_load = Load;
+		rpm_conf = conf;
+		rpm_ppr = ulPPR;
+		rpm_k = (((uint64_t)clock * 60) << 16) /
+				((uint64_t)(Load + 1) * (ulPPR ? ulPPR : 1) * (conf ? 4 : 2));
+	}
 
-	return (uint32_t)(rpm);
+	return (uint32_t)((ulVelCapValue * rpm_k) >> 16);
 }
 
 
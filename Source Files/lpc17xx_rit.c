@@ -13,24 +13,27 @@
 
 /* Includes ------------------------------------------------------------------- */
 #include "lpc17xx_rit.h"
+#include "lpc_freq_meter.h"
+#include "lpc_prof.h"
 
 /* If this source file built with example, the LPC17xx FW library configuration
  * file in each example directory ("lpc17xx_libcfg.h") must be included,
  * otherwise the default FW library configuration file must be included instead
  */
-#if 0
+
 /*----------------- INTERRUPT SERVICE ROUTINES --------------------------*/
 /*********************************************************************//**
- * @brief		RIT interrupt handler sub-routine
+ * @brief		RIT interrupt handler sub-routine, the RIT is the gate of
+ * 				the frequency meter
  * @param[in]	None
  * @return 		None
  **********************************************************************/
 void RIT_IRQHandler(void)
 {
-	RIT_GetIntStatus(LPC_RIT); //call this to clear interrupt flag
-    LPC_GPIO0->FIOPIN ^= _BIT(10); //Toggle P0.10 led
+	PROF_ISR_ENTER(RIT_IRQn);
+	FREQ_GateHandler();
+	PROF_ISR_EXIT(RIT_IRQn);
 }
-#endif
 
 /* Public Functions ----------------------------------------------------------- */
 /** @addtogroup RIT_Public_Functions
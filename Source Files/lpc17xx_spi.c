@@ -19,6 +19,15 @@
  * otherwise the default FW library configuration file must be included instead
  */
 
+/* Public Variables ----------------------------------------------------------- */
+#if (SPI_DATABIT_SIZE == 8)
+uint8_t Tx_Buf[BUFFER_SIZE];
+uint8_t Rx_Buf[BUFFER_SIZE];
+#else
+uint16_t Tx_Buf[BUFFER_SIZE];
+uint16_t Rx_Buf[BUFFER_SIZE];
+#endif
+
 
 /* Public Functions ----------------------------------------------------------- */
 /** @addtogroup SPI_Public_Functions
@@ -64,7 +73,7 @@ void CS_Force (FunctionalState state)
  * @param[in]	None
  * @return 		None
  **********************************************************************/
-void Buffer_Init (void)
+void SPI_Buffer_Init (void)
 {
 	uint8_t i;
 #if (SPI_DATABIT_SIZE == 8)
@@ -138,7 +147,7 @@ void SPI_Config (LPC_SPI_TypeDef *SPIx)
 
 	CS_Init();     // Chip Select Init
 
-	Buffer_Init(); // Empty Buffer
+	SPI_Buffer_Init(); // Empty Buffer
 }
 
 
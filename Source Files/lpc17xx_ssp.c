@@ -13,6 +13,7 @@
 
 /* Includes ------------------------------------------------------------------- */
 #include "lpc17xx_ssp.h"
+#include "lpc_prof.h"
 
 
 /* If this source file built with example, the LPC17xx FW library configuration
@@ -20,6 +21,15 @@
  * otherwise the default FW library configuration file must be included instead
  */
 
+/* Public Variables ----------------------------------------------------------- */
+#if (SSP_DATABIT_SIZE == 8)
+uint8_t Tx_Buf1[BUFFER_SIZE1];
+uint8_t Rx_Buf1[BUFFER_SIZE1];
+#else
+uint16_t Tx_Buf1[BUFFER_SIZE1];
+uint16_t Rx_Buf1[BUFFER_SIZE1];
+#endif
+
 
 /* Public Functions ----------------------------------------------------------- */
 /** @addtogroup SSP_Public_Functions
@@ -27,6 +37,8 @@
  */
 
 static void setSSPclock (LPC_SSP_TypeDef *SSPx, uint32_t target_clock);
+static int32_t ssp_read_write (LPC_SSP_TypeDef *SSPx, SSP_DATA_SETUP_Type *dataCfg, \
+						SSP_TRANSFER_Type xfType);
 
 
 /*********************************************************************//**
@@ -464,22 +476,10 @@ uint16_t SSP_ReceiveData(LPC_SSP_TypeDef* SSPx)
 }
 
 /*********************************************************************//**
- * @brief 		SSP Read write data function
- * @param[in]	SSPx 	Pointer to SSP peripheral, should be
- * 						- LPC_SSP0: SSP0 peripheral
- * 						- LPC_SSP1: SSP1 peripheral
- * @param[in]	dataCfg	Pointer to a SSP_DATA_SETUP_Type structure that
- * 						contains specified information about transmit
- * 						data configuration.
- * @param[in]	xfType	Transfer type, should be:
- * 						- SSP_TRANSFER_POLLING: Polling mode
- * 						- SSP_TRANSFER_INTERRUPT: Interrupt mode
- * @return 		Actual Data length has been transferred in polling mode.
- * 				In interrupt mode, always return (0)
- * 				Return (-1) if error.
- * Note: This function can be used in both master and slave mode.
- ***********************************************************************/
-int32_t SSP_ReadWrite (LPC_SSP_TypeDef *SSPx, SSP_DATA_SETUP_Type *dataCfg, \
+ * @brief 		Transfer of SSP_ReadWrite(), kept apart so the profiler
+ * 				scope covers all of its returns
+ **********************************************************************/
+static int32_t ssp_read_write (LPC_SSP_TypeDef *SSPx, SSP_DATA_SETUP_Type *dataCfg, \
 						SSP_TRANSFER_Type xfType)
 {
 	uint8_t *rdata8;
@@ -650,6 +650,34 @@ int32_t SSP_ReadWrite (LPC_SSP_TypeDef *SSPx, SSP_DATA_SETUP_Type *dataCfg, \
 	return (-1);
 }
 
+/*********************************************************************//**
+ * @brief 		SSP Read write data function
+ * @param[in]	SSPx 	Pointer to SSP peripheral, should be
+ * 						- LPC_SSP0: SSP0 peripheral
+ * 						- LPC_SSP1: SSP1 peripheral
+ * @param[in]	dataCfg	Pointer to a SSP_DATA_SETUP_Type structure that
+ * 						contains specified information about transmit
+ * 						data configuration.
+ * @param[in]	xfType	Transfer type, should be:
+ * 						- SSP_TRANSFER_POLLING: Polling mode
+ * 						- SSP_TRANSFER_INTERRUPT: Interrupt mode
+ * @return 		Actual Data length has been transferred in polling mode.
+ * 				In interrupt mode, always return (0)
+ * 				Return (-1) if error.
+ * Note: This function can be used in both master and slave mode.
+ ***********************************************************************/
+int32_t SSP_ReadWrite (LPC_SSP_TypeDef *SSPx, SSP_DATA_SETUP_Type *dataCfg, \
+						SSP_TRANSFER_Type xfType)
+{
+	int32_t ret;
+
+	PROF_BEGIN(PROF_ID_SSP_RW);
+	ret = ssp_read_write(SSPx, dataCfg, xfType);
+	PROF_END(PROF_ID_SSP_RW);
+
+	return ret;
+}
+
 /*********************************************************************//**
  * @brief		Checks whether the specified SSP status flag is set or not
  * @param[in]	SSPx	SSP peripheral selected, should be:
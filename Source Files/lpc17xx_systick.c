@@ -15,12 +15,6 @@
 /* Includes ------------------------------------------------------------------- */
 #include "lpc_system_init.h"
 
-/*
- * Variables
- */
-__IO uint32_t delay_timer;
-uint32_t led_timer;
-
 /*----------------- INTERRUPT SERVICE ROUTINES --------------------------*/
 /*********************************************************************//**
  * @brief 		SysTick interrupt handler
@@ -29,20 +23,8 @@ uint32_t led_timer;
  ***********************************************************************/
 void SysTick_Handler(void)
 {
-    if(led_timer)
-    {
-    	--led_timer;
-    }
-    else
-    {
-    	LPC_GPIO3->FIOPIN ^= _BIT(25); //Toggle P3.25 Hearbeat led
-    	led_timer=led_delay;
-    }
-
-	if(delay_timer)
-    {
-      --delay_timer;           /*decrement Delay Timer */
-    }
+	/* Timer wheel, the heartbeat LED is one of its timers */
+	SCHED_Tick();
 	
 	//Clear System Tick counter flag
 	SYSTICK_ClearCounterFlag();
@@ -53,16 +35,18 @@ void SysTick_Handler(void)
  * @{
  */
 /*********************************************************************//**
- * @brief 		Delay Function
+ * @brief 		Delay Function, a yield point: ready tasks run and the
+ * 				CPU sleeps between ticks while waiting
  * @param		value in ms
  * @return 		None
  ***********************************************************************/
 void delay_ms (uint32_t dly_ticks) 
 {
-  delay_timer = dly_ticks;
-  while(delay_timer)
+  uint32_t start = SCHED_GetTicks();
+
+  while((SCHED_GetTicks() - start) < dly_ticks)
   {
-    /* do nothing */
+    SCHED_Yield();
   } 
 }
 
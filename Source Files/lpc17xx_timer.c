@@ -14,6 +14,9 @@
 /* Includes ------------------------------------------------------------------- */
 #include "lpc_system_init.h"
 #include "lpc17xx_timer.h"
+#include "lpc_st_motor.h"
+#include "lpc_freq_meter.h"
+#include "lpc_prof.h"
 
 /* If this source file built with example, the LPC17xx FW library configuration
  * file in each example directory ("lpc17xx_libcfg.h") must be included,
@@ -34,7 +37,9 @@ static uint32_t converPtrToTimeNum (LPC_TIM_TypeDef *TIMx);
  **********************************************************************/
 void TIMER0_IRQHandler(void)
 {
+	PROF_ISR_ENTER(TIMER0_IRQn);
 	TIM_ClearIntPending(LPC_TIM0, TIM_MR1_INT);  // clear Interrupt
+	PROF_ISR_EXIT(TIMER0_IRQn);
 }
 
 
@@ -45,24 +50,9 @@ void TIMER0_IRQHandler(void)
  **********************************************************************/
 void TIMER1_IRQHandler(void)
 {
-	if (TIM_GetIntCaptureStatus(LPC_TIM1,0))
-	{
-		TIM_ClearIntCapturePending(LPC_TIM1,0);
-		if(first_capture==TRUE)
-		{
-			TIM_Cmd(LPC_TIM1,DISABLE);
-			TIM_ResetCounter(LPC_TIM1);
-			TIM_Cmd(LPC_TIM1,ENABLE);
-			count++;
-			if(count==20)first_capture=FALSE; //stable
-		}
-		else
-		{
-			count=0; //reset count for next use
-			done=TRUE;
-			capture = TIM_GetCaptureValue(LPC_TIM1,0);
-		}
-	}
+	PROF_ISR_ENTER(TIMER1_IRQn);
+	FREQ_IntHandler();                           // Frequency meter captures
+	PROF_ISR_EXIT(TIMER1_IRQn);
 }
 
 
@@ -73,7 +63,9 @@ void TIMER1_IRQHandler(void)
  **********************************************************************/
 void TIMER2_IRQHandler(void)
 {
-	TIM_ClearIntPending(LPC_TIM2, TIM_MR0_INT);  // clear Interrupt
+	PROF_ISR_ENTER(TIMER2_IRQn);
+	STM_IntHandler();                            // Stepper Motor steps
+	PROF_ISR_EXIT(TIMER2_IRQn);
 }
 
 
@@ -741,8 +733,8 @@ void TIM_Init(LPC_TIM_TypeDef *TIMx, TIM_MODE_OPT TimerCounterMode, void *TIM_Co
 
 	}
 
-	TIMx->CCR &= ~TIM_CTCR_MODE_MASK;
-	TIMx->CCR |= TIM_TIMER_MODE;
+	TIMx->CTCR &= ~TIM_CTCR_MODE_MASK;
+	TIMx->CTCR |= TimerCounterMode;
 
 	TIMx->TC =0;
 	TIMx->PC =0;
@@ -765,9 +757,9 @@ void TIM_Init(LPC_TIM_TypeDef *TIMx, TIM_MODE_OPT TimerCounterMode, void *TIM_Co
 	{
 
 		pCounterCfg = (TIM_COUNTERCFG_Type *)TIM_ConfigStruct;
-		TIMx->CCR  &= ~TIM_CTCR_INPUT_MASK;
+		TIMx->CTCR  &= ~TIM_CTCR_INPUT_MASK;
 		if (pCounterCfg->CountInputSelect == TIM_COUNTER_INCAP1)
-			TIMx->CCR |= _BIT(2);
+			TIMx->CTCR |= _BIT(2);
 	}
 
 	// Clear interrupt pending
@@ -13,17 +13,108 @@
 
 /* Includes ------------------------------------------------------------------- */
 #include "lpc_system_init.h"
+#include "lpc_prof.h"
 
 /* Global Variables------------------------------------------------------------ */
 uint16 EscFlag=0;
 uchar TrgLvlU0=0,TrgLvlU2=0;
 Bool UART0_RxReady=0,UART2_RxReady=0;
 
+// UART Ring buffer
+UART_RING_BUFFER_T rb0;
+UART_RING_BUFFER_T rb2;
+
+/* Private Types -------------------------------------------------------------- */
+/** @defgroup UART_Private_Types UART Private Types
+ * @{
+ */
+
+/**
+ * @brief Interrupt driven UART port state (UART0 and UART2)
+ */
+typedef struct
+{
+	LPC_UART_TypeDef *UARTx;			/* UART peripheral */
+	UART_RING_BUFFER_T *rb;				/* Tx/Rx ring buffer */
+	IRQn_Type IRQn;						/* UART interrupt number */
+	uint8_t TxPolicy;					/* Tx overflow policy, UART_OVERFLOW_Type */
+	uint8_t RxPolicy;					/* Rx overflow policy, UART_OVERFLOW_Type */
+	__IO FlagStatus TxActive;			/* THR burst in flight, THRE interrupt refills */
+	__IO FlagStatus RxHold;				/* RBR interrupt masked by the BLOCK policy */
+	UART_RING_STATS_Type Stats;			/* Ring buffer statistics */
+} UART_PORT_T;
+
+/**
+ * @brief Producer side view of the Tx ring, used by UART_Send() and printf()
+ */
+typedef struct
+{
+	UART_PORT_T *port;					/* Ring port, NULL for polled output */
+	LPC_UART_TypeDef *UARTx;			/* UART peripheral */
+	__IO uint8_t *buf;					/* Tx ring storage */
+	uint32_t head;						/* Head index not yet published */
+	uint32_t room;						/* Free ring slots */
+	uint32_t fifo;						/* Polled output: free THR FIFO slots */
+	TRANSFER_BLOCK_Type flag;			/* NONE_BLOCKING never waits for room */
+} UART_TX_CTX_T;
+
+/**
+ * @brief printf() output: the formatter renders into the free span of the
+ * Tx ring, or into a small stage when the ring is full or not used
+ */
+typedef struct
+{
+	FMT_OUT_Type out;					/* Formatter output, must be first */
+	UART_TX_CTX_T tx;					/* Tx ring producer */
+	char stage[16];						/* Characters for uart_putc_slow() */
+} UART_FMT_T;
+
+/**
+ * @}
+ */
+
+/* Private Variables ---------------------------------------------------------- */
+#ifdef INTERRUPT_MODE
+/**
+ * @brief Ring port state for UART0 and UART2
+ */
+static UART_PORT_T uart_port[2] = {
+	{ LPC_UART0, &rb0, UART0_IRQn, UART_OVERFLOW_BLOCK, UART_OVERFLOW_DROP, RESET, RESET, {0} },
+	{ LPC_UART2, &rb2, UART2_IRQn, UART_OVERFLOW_BLOCK, UART_OVERFLOW_DROP, RESET, RESET, {0} }
+};
+#endif
+
 /* Private Functions ---------------------------------------------------------- */
 static Status uart_set_divisors(LPC_UART_TypeDef *UARTx, uint32_t baudrate);
+static UART_PORT_T *uart_get_port(LPC_UART_TypeDef *UARTx);
+static void uart_tx_begin(UART_TX_CTX_T *ctx, LPC_UART_TypeDef *UARTx, TRANSFER_BLOCK_Type flag);
+static void uart_tx_commit(UART_TX_CTX_T *ctx);
+static Bool uart_putc_slow(UART_TX_CTX_T *ctx, uint8_t c);
+static void uart_fmt_span(UART_FMT_T *f);
+static void uart_fmt_flush(FMT_OUT_Type *out);
 void UART_IntTransmit(LPC_UART_TypeDef *UARTx);
 void UART_IntReceive(LPC_UART_TypeDef *UARTx);
 
+/*********************************************************************//**
+ * @brief		Queue one character for transmission. The fast path is a
+ * 				single store into the Tx ring, the ring state is published
+ * 				by uart_tx_commit()
+ * @param[in]	ctx		Producer context set up by uart_tx_begin()
+ * @param[in]	c		Character to send
+ * @return		TRUE if queued, FALSE if dropped
+ **********************************************************************/
+static __INLINE Bool uart_putc(UART_TX_CTX_T *ctx, uint8_t c)
+{
+	if (ctx->room)
+	{
+		ctx->buf[ctx->head & __BUF_MASK] = c;
+		ctx->head++;
+		ctx->room--;
+		return TRUE;
+	}
+	return uart_putc_slow(ctx, c);
+}
+
 #ifdef INTERRUPT_MODE
 /*********************************************************************//**
  * @brief	UART0 interrupt handler sub-routine
@@ -35,6 +126,7 @@ void UART0_IRQHandler(void)
 	// Call Standard UART 0 interrupt handler
 	uint32_t intsrc, tmp, tmp1;
 
+	PROF_ISR_ENTER(UART0_IRQn);
 	// Determine the interrupt source
 	intsrc = UART_GetIntId(LPC_UART0);
 	tmp = intsrc & UART_IIR_INTID_MASK;
@@ -49,10 +141,7 @@ void UART0_IRQHandler(void)
 		// If any error exist
 		if (tmp1)
 		{
-			while(tmp1)
-			{
-				; //implement error handling here
-			}
+			uart_port[0].Stats.RxErrors++;
 		}
 	}
 
@@ -99,6 +188,7 @@ void UART0_IRQHandler(void)
 		UART_IntTransmit(LPC_UART0);
 	}
 
+	PROF_ISR_EXIT(UART0_IRQn);
 }
 
 
@@ -112,6 +202,7 @@ void UART2_IRQHandler(void)
 	// Call Standard UART 2 interrupt handler
 	uint32_t intsrc, tmp, tmp1;
 
+	PROF_ISR_ENTER(UART2_IRQn);
 	/* Determine the interrupt source */
 	intsrc = UART_GetIntId(LPC_UART2);
 	tmp = intsrc & UART_IIR_INTID_MASK;
@@ -126,10 +217,7 @@ void UART2_IRQHandler(void)
 		// If any error exist
 		if (tmp1)
 		{
-			while(tmp1)
-			{
-				; //implement error handling here
-			}
+			uart_port[1].Stats.RxErrors++;
 		}
 	}
 
@@ -175,6 +263,7 @@ void UART2_IRQHandler(void)
 	{
 		UART_IntTransmit(LPC_UART2);
 	}
+	PROF_ISR_EXIT(UART2_IRQn);
 }
 
 #endif
@@ -300,6 +389,345 @@ static Status uart_set_divisors(LPC_UART_TypeDef *UARTx, uint32_t baudrate)
 		return errorStatus;
 }
 
+/*********************************************************************//**
+ * @brief		Get the ring port of an interrupt driven UART
+ * @param[in]	UARTx	Pointer to selected UART peripheral
+ * @return 		Ring port, NULL if UARTx has no interrupt driven ring
+ **********************************************************************/
+static UART_PORT_T *uart_get_port(LPC_UART_TypeDef *UARTx)
+{
+#ifdef INTERRUPT_MODE
+	if (UARTx == LPC_UART0)
+	{
+		return &uart_port[0];
+	}
+	if (UARTx == LPC_UART2)
+	{
+		return &uart_port[1];
+	}
+#endif
+	return NULL;
+}
+
+#ifdef INTERRUPT_MODE
+/*********************************************************************//**
+ * @brief		Move up to UART_TX_FIFO_SIZE bytes from the Tx ring into
+ * 				the THR FIFO. Must be called with the THR FIFO empty and
+ * 				with the port interrupt unable to run
+ * @param[in]	port	Ring port
+ * @return 		None
+ **********************************************************************/
+static void uart_tx_burst(UART_PORT_T *port)
+{
+	UART_RING_BUFFER_T *rb = port->rb;
+	uint32_t tail = rb->tx_tail;
+	uint32_t cnt;
+
+	/* Clear the active flag before sampling head, a producer that
+	 * publishes after this point sees RESET and starts the next burst */
+	port->TxActive = RESET;
+	cnt = __BUF_COUNT(rb->tx_head, tail);
+	if (cnt == 0)
+	{
+		return;
+	}
+	if (cnt > UART_TX_FIFO_SIZE)
+	{
+		cnt = UART_TX_FIFO_SIZE;
+	}
+
+	port->TxActive = SET;
+	port->Stats.TxBursts++;
+	while (cnt--)
+	{
+		port->UARTx->/*RBTHDLR.*/THR = rb->tx[tail & __BUF_MASK];
+		tail++;
+	}
+	rb->tx_tail = tail;
+}
+
+/*********************************************************************//**
+ * @brief		Start transmission if the Tx interrupt is idle
+ * @param[in]	port	Ring port
+ * @return 		None
+ **********************************************************************/
+static void uart_tx_start(UART_PORT_T *port)
+{
+	uint32_t primask;
+	uint8_t lsr;
+
+	if (port->TxActive == SET)
+	{
+		return;
+	}
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if (port->TxActive == RESET)
+	{
+		lsr = port->UARTx->LSR;
+		if (lsr & (UART_LSR_OE | UART_LSR_PE | UART_LSR_FE | UART_LSR_BI))
+		{
+			port->Stats.RxErrors++;
+		}
+		/* THR not empty: the pending THRE interrupt starts the burst */
+		if (lsr & UART_LSR_THRE)
+		{
+			uart_tx_burst(port);
+		}
+	}
+	__set_PRIMASK(primask);
+}
+
+/*********************************************************************//**
+ * @brief		Wait until the Tx interrupt has freed ring space. When the
+ * 				interrupt cannot preempt the caller (interrupts disabled or
+ * 				called from a handler) the ring is drained by polling
+ * @param[in]	port	Ring port
+ * @return 		None
+ **********************************************************************/
+static void uart_tx_wait(UART_PORT_T *port)
+{
+	uint32_t primask;
+
+	if ((__get_PRIMASK() == 0) && (__get_IPSR() == 0))
+	{
+		return;
+	}
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if (port->UARTx->LSR & UART_LSR_THRE)
+	{
+		uart_tx_burst(port);
+	}
+	__set_PRIMASK(primask);
+}
+
+/*********************************************************************//**
+ * @brief		Move received characters from the Rx FIFO into the Rx ring
+ * @param[in]	port	Ring port
+ * @return 		None
+ **********************************************************************/
+static void uart_rx_fill(UART_PORT_T *port)
+{
+	UART_RING_BUFFER_T *rb = port->rb;
+	uint32_t head = rb->rx_head;
+	uint32_t cnt;
+	uint8_t lsr;
+
+	while ((lsr = port->UARTx->LSR) & UART_LSR_RDR)
+	{
+		if (lsr & (UART_LSR_OE | UART_LSR_PE | UART_LSR_FE | UART_LSR_BI))
+		{
+			port->Stats.RxErrors++;
+		}
+
+		if (__BUF_IS_FULL(head, rb->rx_tail))
+		{
+			if (port->RxPolicy == UART_OVERFLOW_BLOCK)
+			{
+				/* Leave the data in the FIFO until UART_Receive() makes room */
+				port->RxHold = SET;
+				UART_IntConfig(port->UARTx, UART_INTCFG_RBR, DISABLE);
+				break;
+			}
+			port->Stats.RxOverflow++;
+			if (port->RxPolicy == UART_OVERFLOW_DROP)
+			{
+				(void)port->UARTx->/*RBTHDLR.*/RBR;
+				continue;
+			}
+			/* UART_OVERFLOW_OVERWRITE: discard the oldest character */
+			rb->rx_tail++;
+		}
+		rb->rx[head & __BUF_MASK] = port->UARTx->/*RBTHDLR.*/RBR;
+		head++;
+	}
+	rb->rx_head = head;
+
+	cnt = __BUF_COUNT(head, rb->rx_tail);
+	if (cnt > port->Stats.RxHighWater)
+	{
+		port->Stats.RxHighWater = cnt;
+	}
+}
+#endif
+
+/*********************************************************************//**
+ * @brief		Set up a producer context on the Tx ring of UARTx. The
+ * 				context caches tx_head until uart_tx_commit(), so only
+ * 				thread code may own it: output from a handler, which may
+ * 				have preempted a thread producer, goes polled to the THR.
+ * @param[out]	ctx		Producer context
+ * @param[in]	UARTx	Pointer to selected UART peripheral
+ * @param[in]	flag	NONE_BLOCKING or BLOCKING
+ * @return 		None
+ **********************************************************************/
+static void uart_tx_begin(UART_TX_CTX_T *ctx, LPC_UART_TypeDef *UARTx, TRANSFER_BLOCK_Type flag)
+{
+	ctx->UARTx = UARTx;
+	ctx->flag = flag;
+	ctx->port = (__get_IPSR() == 0) ? uart_get_port(UARTx) : NULL;
+	ctx->room = 0;
+	ctx->fifo = 0;
+	if (ctx->port != NULL)
+	{
+		ctx->buf = ctx->port->rb->tx;
+		ctx->head = ctx->port->rb->tx_head;
+		ctx->room = UART_RING_BUFSIZE - __BUF_COUNT(ctx->head, ctx->port->rb->tx_tail);
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Publish the characters queued through ctx and start the
+ * 				Tx interrupt if it is idle
+ * @param[in]	ctx		Producer context
+ * @return 		None
+ **********************************************************************/
+static void uart_tx_commit(UART_TX_CTX_T *ctx)
+{
+#ifdef INTERRUPT_MODE
+	UART_PORT_T *port = ctx->port;
+	uint32_t cnt;
+
+	if ((port == NULL) || (port->rb->tx_head == ctx->head))
+	{
+		return;
+	}
+
+	port->rb->tx_head = ctx->head;
+	cnt = __BUF_COUNT(ctx->head, port->rb->tx_tail);
+	if (cnt > port->Stats.TxHighWater)
+	{
+		port->Stats.TxHighWater = cnt;
+	}
+	uart_tx_start(port);
+#endif
+}
+
+/*********************************************************************//**
+ * @brief		uart_putc() slow path: Tx ring full or polled output
+ * @param[in]	ctx		Producer context
+ * @param[in]	c		Character to send
+ * @return		TRUE if queued, FALSE if dropped
+ **********************************************************************/
+static Bool uart_putc_slow(UART_TX_CTX_T *ctx, uint8_t c)
+{
+	uint32_t timeOut;
+#ifdef INTERRUPT_MODE
+	UART_PORT_T *port = ctx->port;
+	uint32_t primask;
+
+	if (port != NULL)
+	{
+		uart_tx_commit(ctx);
+		ctx->room = UART_RING_BUFSIZE - __BUF_COUNT(ctx->head, port->rb->tx_tail);
+		if (ctx->room == 0)
+		{
+			if ((port->TxPolicy == UART_OVERFLOW_DROP) || \
+				((port->TxPolicy == UART_OVERFLOW_BLOCK) && (ctx->flag == NONE_BLOCKING)))
+			{
+				port->Stats.TxOverflow++;
+				return FALSE;
+			}
+			if (port->TxPolicy == UART_OVERFLOW_OVERWRITE)
+			{
+				/* Discard the oldest character not yet moved to the THR */
+				primask = __get_PRIMASK();
+				__disable_irq();
+				if (__BUF_IS_FULL(ctx->head, port->rb->tx_tail))
+				{
+					port->rb->tx_tail++;
+					port->Stats.TxOverflow++;
+				}
+				__set_PRIMASK(primask);
+			}
+			else
+			{
+				while (__BUF_IS_FULL(ctx->head, port->rb->tx_tail))
+				{
+					uart_tx_wait(port);
+				}
+			}
+			ctx->room = UART_RING_BUFSIZE - __BUF_COUNT(ctx->head, port->rb->tx_tail);
+		}
+		ctx->buf[ctx->head & __BUF_MASK] = c;
+		ctx->head++;
+		ctx->room--;
+		return TRUE;
+	}
+#endif
+
+	/* Polled output: wait for THR empty once per UART_TX_FIFO_SIZE characters */
+	if (ctx->fifo == 0)
+	{
+		timeOut = (ctx->flag == NONE_BLOCKING) ? 1 : UART_BLOCKING_TIMEOUT;
+		while (!(ctx->UARTx->LSR & UART_LSR_THRE))
+		{
+			if (--timeOut == 0)
+			{
+				return FALSE;
+			}
+		}
+		ctx->fifo = UART_TX_FIFO_SIZE;
+	}
+	UART_SendByte(ctx->UARTx, c);
+	ctx->fifo--;
+	return TRUE;
+}
+
+/*********************************************************************//**
+ * @brief		Point the printf() output at the next contiguous free span
+ * 				of the Tx ring, or at the stage when there is no room
+ * @param[in]	f		printf() output
+ * @return		None
+ **********************************************************************/
+static void uart_fmt_span(UART_FMT_T *f)
+{
+	uint32_t idx = f->tx.head & __BUF_MASK;
+	uint32_t span = UART_RING_BUFSIZE - idx;
+
+	f->out.Len = 0;
+	if (f->tx.room)
+	{
+		f->out.Buf = (char *)&f->tx.buf[idx];
+		f->out.Size = (f->tx.room < span) ? f->tx.room : span;
+	}
+	else
+	{
+		f->out.Buf = f->stage;
+		f->out.Size = sizeof(f->stage);
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Formatter flush for printf(): characters rendered in the
+ * 				ring are only counted, staged ones go through the
+ * 				blocking uart_putc() path
+ * @param[in]	out		Formatter output, first member of a UART_FMT_T
+ * @return		None
+ **********************************************************************/
+static void uart_fmt_flush(FMT_OUT_Type *out)
+{
+	UART_FMT_T *f = (UART_FMT_T *)out;
+	uint32_t i;
+
+	if (out->Buf == f->stage)
+	{
+		for (i = 0; i < out->Len; i++)
+		{
+			uart_putc(&f->tx, f->stage[i]);
+		}
+	}
+	else
+	{
+		f->tx.head += out->Len;
+		f->tx.room -= out->Len;
+	}
+	uart_fmt_span(f);
+}
+
 /* End of Private Functions ---------------------------------------------------- */
 
 /************************** PUBLIC FUNCTIONS *************************/
@@ -440,19 +868,6 @@ void UART_Config(LPC_UART_TypeDef *UARTx, long int baud)
 	/* Enable UART line status interrupt */
 	UART_IntConfig(UARTx, UART_INTCFG_RLS, ENABLE);
 
-	/**
-	 * Do not enable transmit interrupt here, since it is handled by
-	 * UART_Send() function, just to reset Tx Interrupt state for the
-	 * first time
-	 */
-	TxIntStat = RESET;
-
-	// Reset ring buf head and tail idx
-//	__BUF_RESET(rb.rx_head);
-//	__BUF_RESET(rb.rx_tail);
-//	__BUF_RESET(rb.tx_head);
-//	__BUF_RESET(rb.tx_tail);
-
 	if(UARTx == LPC_UART0)
 	{
 		// Reset ring buf head and tail idx
@@ -460,6 +875,8 @@ void UART_Config(LPC_UART_TypeDef *UARTx, long int baud)
 		__BUF_RESET(rb0.rx_tail);
 		__BUF_RESET(rb0.tx_head);
 		__BUF_RESET(rb0.tx_tail);
+		uart_port[0].TxActive = RESET;
+		uart_port[0].RxHold = RESET;
 		/* preemption = 1, sub-priority = 1 */
 		NVIC_SetPriority(UART0_IRQn, ((0x01<<3)|0x01));
 		/* Enable Interrupt for UART0 channel */
@@ -472,12 +889,21 @@ void UART_Config(LPC_UART_TypeDef *UARTx, long int baud)
 		__BUF_RESET(rb2.rx_tail);
 		__BUF_RESET(rb2.tx_head);
 		__BUF_RESET(rb2.tx_tail);
+		uart_port[1].TxActive = RESET;
+		uart_port[1].RxHold = RESET;
 		/* preemption = 1, sub-priority = 1 */
 		NVIC_SetPriority(UART2_IRQn, 2);
 		/* Enable Interrupt for UART2 channel */
 		NVIC_EnableIRQ(UART2_IRQn);
 	}
 
+	/**
+	 * The transmit interrupt stays enabled, it fires once per emptied
+	 * THR FIFO and the handler refills it from the Tx ring. When the ring
+	 * is empty the next UART_Send()/printf() writes the first burst
+	 */
+	UART_IntConfig(UARTx, UART_INTCFG_THRE, ENABLE);
+
 #ifdef AB_MODE
     /* ---------------------- Auto baud rate section ----------------------- */
         // Reset Synchronous flag for auto-baudrate mode
@@ -846,6 +1272,7 @@ uint32_t UART_Send(LPC_UART_TypeDef *UARTx, uint8_t *txbuf, uint32_t buflen, TRA
 	uint32_t bToSend, bSent, timeOut, fifo_cnt;
 	uint8_t *pChar = txbuf;
 
+	PROF_BEGIN(PROF_ID_UART_SEND);
 	bToSend = buflen;
 
 	// blocking mode
@@ -885,6 +1312,7 @@ uint32_t UART_Send(LPC_UART_TypeDef *UARTx, uint8_t *txbuf, uint32_t buflen, TRA
 			}
 		}
 	}
+	PROF_END(PROF_ID_UART_SEND);
 	return bSent;
 }
 
@@ -1091,7 +1519,7 @@ uchar get_line(LPC_UART_TypeDef *UARTx, schar s[], uchar lim)
 			s[pointer] = kb;               /* save character and increment pointer */
 			pointer++;
 			count++;                       /* increment count */
-			UART_Send(UARTx,&kb,1,BLOCKING);       /* echo character */
+			UART_Send(UARTx,(uint8_t *)&kb,1,BLOCKING); /* echo character */
 
 			continue;                      /* and get some more */
 		}
@@ -1108,19 +1536,16 @@ uchar get_line(LPC_UART_TypeDef *UARTx, schar s[], uchar lim)
 /*********************************************************************//**
  * @brief		Modified version of Standard Printf statement
  *
- * @par			Supports standard formats "%c %s %d %x"
- * 				"%d" and "%x" requires non-standard qualifiers,"%dfn, %xfn":-
- *		        f supplies a fill character
- *		        n supplies a field width
+ * @par			Formats with FMT_VFormat(), see lpc_fmt.c:
+ * 				standard "%c %s %d %i %u %x %%" with flags and width,
+ * 				the library forms "%dfn, %xfn" (f = '0' fill character,
+ * 				n = field width) and the custom formats "%b %t %y %a"
  *
  *		        ENABLE RTC_SUPPORT in lpc17xx_uart.h for RTC Features
  *
- *				Supports custom formats  "%b  %u %t %y %a"
- *				"%b"	prints a 2 digit BCD value with leading zero
- *				"%u"	prints the 16 bit unsigned integer in hex format
- *				"%t"    prints current time
- *				"%y"    prints current date
- *				"%a"    prints alarm time and date
+ *				On UART0/UART2 in INTERRUPT_MODE the output is formatted
+ *				straight into the Tx ring and the ring is published once
+ *				per call, the UART interrupt sends it in THR bursts
  * @param[in]	UARTx	Selected UART peripheral used to send data,
  * 				should be:
  *  			- LPC_UART0: UART0 peripheral
@@ -1134,132 +1559,20 @@ uchar get_line(LPC_UART_TypeDef *UARTx, schar s[], uchar lim)
  **********************************************************************/
 int16 printf(LPC_UART_TypeDef *UARTx, const char *format, ...)
 {
-	uchar hex[]= "0123456789ABCDEF";
-	unsigned int width_dec[10] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000};
-	unsigned int width_hex[10] = { 0x1, 0x10, 0x100, 0x1000, 0x10000, 0x100000, 0x1000000, 0x10000000};
-	unsigned int temp;
-
-	schar format_flag, fill_char;
-	ulong32 u_val, div_val;
-	uint16 base;
-
-	schar *ptr;
-#ifdef RTC_MODE
-	RTC_TIME_Type FullTime;
-#endif
+	UART_FMT_T f;
 	va_list ap;
-	va_start(ap, format);
-
-	for(;;)
-	{
-		while((format_flag = *format++) != '%')      /* until full format string read */
-		{
-			if(!format_flag)
-			{                        /* until '%' or '\0' */
-				return (0);
-			}
-			UART_Send(UARTx,&format_flag,1,BLOCKING);
-		}
-
-		switch(format_flag = *format++)
-		{
-			case 'c':
-				format_flag = va_arg(ap, int);
-				UART_Send(UARTx,&format_flag,1,BLOCKING);
-
-				continue;
-
-			default:
-				UART_Send(UARTx,&format_flag,1,BLOCKING);
 
-        		continue;
+	/* Characters are formatted straight into the Tx ring */
+	uart_tx_begin(&f.tx, UARTx, BLOCKING);
+	FMT_MemInit(&f.out, NULL, 0);
+	f.out.Flush = uart_fmt_flush;
+	uart_fmt_span(&f);
 
-			case 'b':
-				format_flag = va_arg(ap,int);
-				UART_Send(UARTx,&(hex[(uint16)format_flag >> 4]),1,BLOCKING);
-				UART_Send(UARTx,&(hex[(uint16)format_flag & 0x0F]),1,BLOCKING);
-
-				continue;
-
-			case 's':
-				ptr = va_arg(ap, schar *);
-				while(*ptr)
-				{
-					UART_Send(UARTx,&(*ptr++),1,BLOCKING);
-				}
-
-				continue;
-#ifdef RTC_MODE
-			case 't':
-				RTC_GetFullTime (LPC_RTC, &FullTime);
-			    printf(UARTx, "%d02:%d02:%d02",FullTime.HOUR,FullTime.MIN,FullTime.SEC);
-
-				continue;
-
-			case 'y':
-				RTC_GetFullTime (LPC_RTC, &FullTime);
-			    printf(UARTx, "%d02/%d02/%d04",FullTime.DOM,FullTime.MONTH,FullTime.YEAR);
-
-				continue;
-
-			case 'a':
-				RTC_GetFullAlarmTime (LPC_RTC, &FullTime);
-				printf(UARTx, "Time: %d02:%d02:%d02",FullTime.HOUR,FullTime.MIN,FullTime.SEC);
-				printf(UARTx, "  Date: %d02/%d02/%d04",FullTime.DOM,FullTime.MONTH,FullTime.YEAR);
-
-				continue;
-#endif
-			case 'u':
-				base = 16;
-				div_val = 0x100000;
-				u_val = va_arg(ap, uint32_t);
-				do
-				{
-					UART_Send(UARTx,&(hex[u_val/div_val]),1,BLOCKING);
-					u_val %= div_val;
-					div_val /= base;
-				}while(div_val);
-
-				continue;
-
-			case 'd':
-				base = 10;
-				fill_char = *format++;
-				format_flag = ( *format++ ) - '1';
-				div_val = width_dec[format_flag];
-				u_val = va_arg(ap,int);
-
-				if(((int)u_val) < 0)
-				{
-					u_val = - u_val;    /* applied to unsigned type, result still unsigned */
-					temp = '-';
-				    UART_Send(UARTx,&temp,1,BLOCKING);
-				}
-
-				goto  CONVERSION_LOOP;
-
-			case 'x':
-				base = 16;
-				fill_char = *format++;
-				format_flag = (*format++) - '1';
-				div_val = width_hex[format_flag];
-				u_val = va_arg(ap, int);
-
-				CONVERSION_LOOP:
-				while(div_val > 1 && div_val > u_val)
-				{
-					div_val /= base;
-					UART_Send(UARTx,&fill_char,1,BLOCKING);
-				}
+	va_start(ap, format);
+	FMT_VFormat(&f.out, format, ap);
+	va_end(ap);
 
-				do
-				{
-					UART_Send(UARTx,&(hex[u_val/div_val]),1,BLOCKING);
-					u_val %= div_val;
-					div_val /= base;
-				}while(div_val);
-		}/* end of switch statement */
-	}
+	uart_tx_commit(&f.tx);
 	return(0);
 }
 
@@ -2013,214 +2326,48 @@ uint32_t UART_RS485SendData(LPC_UART1_TypeDef *UARTx, uint8_t *pData, uint32_t s
 #ifdef INTERRUPT_MODE
 
 /********************************************************************//**
- * @brief 		UART0 receive function (ring buffer used)
- * @param[in]	None
+ * @brief 		UART receive function (ring buffer used), drains the Rx
+ * 				FIFO into the Rx ring while data is available
+ * @param[in]	UARTx	UART peripheral selected, should be:
+ *  			- LPC_UART0: UART0 peripheral
+ * 				- LPC_UART2: UART2 peripheral
  * @return 		None
  *********************************************************************/
 void UART_IntReceive(LPC_UART_TypeDef *UARTx)
 {
-	uint8_t tmpc=0;
-
-	if(UARTx==LPC_UART0)
-	{
-		while(1)
-		{
-			// Call UART read function in UART driver
-			tmpc = UART_ReceiveByte(LPC_UART0);
-
-			if (tmpc)
-			{
-				/* Check if buffer is more space
-				 * If no more space, remaining character will be trimmed out
-				 */
-				if (!__BUF_IS_FULL(rb0.rx_head,rb0.rx_tail))
-				{
-					rb0.rx[rb0.rx_head] = tmpc;
-					__BUF_INCR(rb0.rx_head);
-				}
-			}
-			// no more data
-			else
-			{
-				break;
-			}
-		}
-	}
+	UART_PORT_T *port = uart_get_port(UARTx);
 
-	if(UARTx==LPC_UART2)
+	if (port != NULL)
 	{
-		while(1)
-		{
-			// Call UART read function in UART driver
-
-			tmpc = UART_ReceiveByte(LPC_UART2);
-
-			if (tmpc)
-			{
-				/* Check if buffer is more space
-				 * If no more space, remaining character will be trimmed out
-				 */
-				if (!__BUF_IS_FULL(rb2.rx_head,rb2.rx_tail))
-				{
-					rb2.rx[rb2.rx_head] = tmpc;
-					__BUF_INCR(rb2.rx_head);
-				}
-			}
-			// no more data
-			else
-			{
-				break;
-			}
-		}
+		uart_rx_fill(port);
 	}
 }
 
 
 /********************************************************************//**
- * @brief 		UART transmit function (ring buffer used)
- * @param[in]	None
+ * @brief 		UART transmit function (ring buffer used), refills the
+ * 				emptied THR FIFO with a burst of up to UART_TX_FIFO_SIZE
+ * 				bytes from the Tx ring
+ * @param[in]	UARTx	UART peripheral selected, should be:
+ *  			- LPC_UART0: UART0 peripheral
+ * 				- LPC_UART2: UART2 peripheral
  * @return 		None
  *********************************************************************/
 void UART_IntTransmit(LPC_UART_TypeDef *UARTx)
 {
-	uint32_t bToSend, bSent, timeOut, fifo_cnt;
-	uint8_t *pChar;
-
-	if(UARTx==LPC_UART0)
-	{
-		// Disable THRE interrupt
-		UART_IntConfig(UARTx, UART_INTCFG_THRE, DISABLE);
-
-		/* Wait for FIFO buffer empty, transfer UART_TX_FIFO_SIZE bytes
-		 * of data or break whenever ring buffers are empty */
-		/* Wait until THR empty */
-		while (UART_CheckBusy(UARTx) == SET);
-
-		while (!__BUF_IS_EMPTY(rb0.tx_head,rb0.tx_tail))
-		{
-			/* Move a piece of data into the transmit FIFO */
-			// None blocking mode
-			pChar = &rb0.tx[rb0.tx_tail];
-			bToSend = 1;
-			bSent = 0;
-			while (bToSend)
-			{
-				timeOut = UART_BLOCKING_TIMEOUT;
-				// Wait for THR empty with timeout
-				while (!(UARTx->LSR & UART_LSR_THRE))
-				{
-					if (timeOut == 0) break;
-					timeOut--;
-				}
-				// Time out!
-				if(timeOut == 0) break;
-				fifo_cnt = UART_TX_FIFO_SIZE;
-				while (fifo_cnt && bToSend)
-				{
-					UART_SendByte(UARTx, (*pChar++));
-					fifo_cnt--;
-					bToSend--;
-					bSent++;
-				}
-			}
-
-			if(bSent)
-			{
-				/* Update transmit ring FIFO tail pointer */
-				__BUF_INCR(rb0.tx_tail);
-			}
-			else
-			{
-				break;
-			}
-		}
-
-		/* If there is no more data to send, disable the transmit
-		   interrupt - else enable it or keep it enabled */
-		if (__BUF_IS_EMPTY(rb0.tx_head, rb0.tx_tail))
-		{
-			UART_IntConfig(UARTx, UART_INTCFG_THRE, DISABLE);
-			// Reset Tx Interrupt state
-			TxIntStat = RESET;
-		}
-		else
-		{
-			// Set Tx Interrupt state
-			TxIntStat = SET;
-			UART_IntConfig(UARTx, UART_INTCFG_THRE, ENABLE);
-		}
-	}
+	UART_PORT_T *port = uart_get_port(UARTx);
 
-	if(UARTx==LPC_UART2)
+	if (port != NULL)
 	{
-		// Disable THRE interrupt
-		UART_IntConfig(UARTx, UART_INTCFG_THRE, DISABLE);
-
-		/* Wait for FIFO buffer empty, transfer UART_TX_FIFO_SIZE bytes
-		 * of data or break whenever ring buffers are empty */
-		/* Wait until THR empty */
-		while (UART_CheckBusy(UARTx) == SET);
-
-		while (!__BUF_IS_EMPTY(rb2.tx_head,rb2.tx_tail))
-		{
-			/* Move a piece of data into the transmit FIFO */
-			// None blocking mode
-			pChar = &rb2.tx[rb2.tx_tail];
-			bToSend = 1;
-			bSent = 0;
-			while (bToSend)
-			{
-				timeOut = UART_BLOCKING_TIMEOUT;
-				// Wait for THR empty with timeout
-				while (!(UARTx->LSR & UART_LSR_THRE))
-				{
-					if (timeOut == 0) break;
-					timeOut--;
-				}
-				// Time out!
-				if(timeOut == 0) break;
-				fifo_cnt = UART_TX_FIFO_SIZE;
-				while (fifo_cnt && bToSend)
-				{
-					UART_SendByte(UARTx, (*pChar++));
-					fifo_cnt--;
-					bToSend--;
-					bSent++;
-				}
-			}
-
-			if(bSent)
-			{
-				/* Update transmit ring FIFO tail pointer */
-				__BUF_INCR(rb2.tx_tail);
-			}
-			else
-			{
-				break;
-			}
-		}
-
-		/* If there is no more data to send, disable the transmit
-		   interrupt - else enable it or keep it enabled */
-		if (__BUF_IS_EMPTY(rb2.tx_head, rb2.tx_tail))
-		{
-			UART_IntConfig(UARTx, UART_INTCFG_THRE, DISABLE);
-			// Reset Tx Interrupt state
-			TxIntStat = RESET;
-		}
-		else
-		{
-			// Set Tx Interrupt state
-			TxIntStat = SET;
-			UART_IntConfig(UARTx, UART_INTCFG_THRE, ENABLE);
-		}
+		uart_tx_burst(port);
 	}
-
 }
 
 
 /*********************************************************************//**
- * @brief		Send a block of data via UART peripheral
+ * @brief		Send a block of data via UART peripheral. On UART0 and
+ * 				UART2 the data is copied into the Tx ring and sent by the
+ * 				UART interrupt, UART1 and UART3 are polled
  * @param[in]	UARTx	Selected UART peripheral used to send data, should be:
  *   			- LPC_UART0: UART0 peripheral
  * 				- LPC_UART1: UART1 peripheral
@@ -2232,83 +2379,25 @@ void UART_IntTransmit(LPC_UART_TypeDef *UARTx)
  * 						NONE_BLOCKING or BLOCKING
  * @return 		Number of bytes sent.
  *
- * Note: when using UART in BLOCKING mode, a time-out condition is used
- * via defined symbol UART_BLOCKING_TIMEOUT.
+ * Note: when the Tx ring is full the port overflow policy applies, see
+ * UART_SetOverflowPolicy(). NONE_BLOCKING never waits for ring space.
  **********************************************************************/
 uint32_t UART_Send(LPC_UART_TypeDef *UARTx, uint8_t *txbuf, uint32_t buflen, TRANSFER_BLOCK_Type flag)
 {
-	uint8_t *data = (uint8_t *) txbuf;
+	UART_TX_CTX_T tx;
 	uint32_t bytes = 0;
 
-	if(UARTx==LPC_UART0)
+	PROF_BEGIN(PROF_ID_UART_SEND);
+	uart_tx_begin(&tx, UARTx, flag);
+	while (buflen--)
 	{
-
-		/* Temporarily lock out UART transmit interrupts during this
-		   read so the UART transmit interrupt won't cause problems
-		   with the index values */
-		UART_IntConfig(UARTx, UART_INTCFG_THRE, DISABLE);
-
-		/* Loop until transmit run buffer is full or until n_bytes
-		   expires */
-		while ((buflen > 0) && (!__BUF_IS_FULL(rb0.tx_head, rb0.tx_tail)))
+		if (uart_putc(&tx, *txbuf++))
 		{
-			/* Write data from buffer into ring buffer */
-			rb0.tx[rb0.tx_head] = *data;
-			data++;
-
-			/* Increment head pointer */
-			__BUF_INCR(rb0.tx_head);
-
-			/* Increment data count and decrement buffer size count */
-			bytes++;
-			buflen--;
-		}
-
-	}
-
-	if(UARTx==LPC_UART2)
-	{
-		/* Temporarily lock out UART transmit interrupts during this
-		   read so the UART transmit interrupt won't cause problems
-		   with the index values */
-		UART_IntConfig(UARTx, UART_INTCFG_THRE, DISABLE);
-
-		/* Loop until transmit run buffer is full or until n_bytes
-		   expires */
-		while ((buflen > 0) && (!__BUF_IS_FULL(rb2.tx_head, rb2.tx_tail)))
-		{
-			/* Write data from buffer into ring buffer */
-			rb2.tx[rb2.tx_head] = *data;
-			data++;
-
-			/* Increment head pointer */
-			__BUF_INCR(rb2.tx_head);
-
-			/* Increment data count and decrement buffer size count */
 			bytes++;
-			buflen--;
 		}
 	}
-
-	/**
-	 * Check if current Tx interrupt enable is reset,
-	 * that means the Tx interrupt must be re-enabled
-	 * due to call UART_IntTransmit() function to trigger
-	 * this interrupt type
-	 */
-
-
-	if (TxIntStat == RESET)
-	{
-		UART_IntTransmit(UARTx);
-	}
-	/**
-	 * Otherwise, re-enables Tx Interrupt
-	 */
-	else
-	{
-		UART_IntConfig(UARTx, UART_INTCFG_THRE, ENABLE);
-	}
+	uart_tx_commit(&tx);
+	PROF_END(PROF_ID_UART_SEND);
 
 	return bytes;
 }
@@ -2318,152 +2407,198 @@ uint32_t UART_Send(LPC_UART_TypeDef *UARTx, uint8_t *txbuf, uint32_t buflen, TRA
  * @param[in]	UARTx	Selected UART peripheral used to send data,
  * 				should be:
  *   			- LPC_UART0: UART0 peripheral
- * 				- LPC_UART1: UART1 peripheral
  * 				- LPC_UART2: UART2 peripheral
- * 				- LPC_UART3: UART3 peripheral
  * @param[out]	rxbuf 	Pointer to Received buffer
  * @param[in]	buflen 	Length of Received buffer
- * @param[in] 	flag 	Flag mode, should be NONE_BLOCKING or BLOCKING
+ * @param[in] 	flag 	Flag mode, should be NONE_BLOCKING, TIME_BLOCKING
+ * 						or BLOCKING
 
  * @return 		Number of bytes received
  *
- * Note: when using UART in BLOCKING mode, a time-out condition is used
+ * Note: when using UART in TIME_BLOCKING mode, a time-out condition is used
  * via defined symbol UART_BLOCKING_TIMEOUT.
  **********************************************************************/
 uint32_t UART_Receive(LPC_UART_TypeDef *UARTx, uint8_t *rxbuf, uint32_t buflen, TRANSFER_BLOCK_Type flag)
 {
-	uint8_t *data = (uint8_t *) rxbuf,ind=0;
-	uint32_t bytes = 0,time=0;
-	if(UARTx==LPC_UART0)
+	UART_PORT_T *port = uart_get_port(UARTx);
+	UART_RING_BUFFER_T *rb;
+	uint32_t bytes = 0, time = UART_BLOCKING_TIMEOUT;
+	uint32_t tail, cnt, primask = 0;
+
+	if (port == NULL)
 	{
-		ind=buflen/TrgLvlU0;
-		if((buflen%TrgLvlU0!=0) && (buflen>8))
-			ind++;
-		else if((buflen%TrgLvlU0!=0) && (buflen<8))
-			ind++;
+		return 0;
+	}
+	rb = port->rb;
 
-		if(flag==TIME_BLOCKING)
+	while (bytes < buflen)
+	{
+		tail = rb->rx_tail;
+		cnt = __BUF_COUNT(rb->rx_head, tail);
+		if (cnt == 0)
 		{
-			time=UART_BLOCKING_TIMEOUT;
-			while((time!=0))
+			if ((flag == NONE_BLOCKING) || ((flag == TIME_BLOCKING) && (--time == 0)))
 			{
-				time--;
-				if(UART0_RxReady==1)
-				{
-					ind--;
-					UART0_RxReady=0;
-				}
-				if(ind==0)
-					break;
+				break;
 			}
+			continue;
 		}
-		else if(flag==BLOCKING)
+		if (cnt > (buflen - bytes))
 		{
-			while(1)
+			cnt = buflen - bytes;
+		}
+
+		/* The OVERWRITE policy lets the interrupt move rx_tail */
+		if (port->RxPolicy == UART_OVERFLOW_OVERWRITE)
+		{
+			primask = __get_PRIMASK();
+			__disable_irq();
+			tail = rb->rx_tail;
+			cnt = __BUF_COUNT(rb->rx_head, tail);
+			if (cnt > (buflen - bytes))
 			{
-				while(UART0_RxReady!=1);
-				ind--;
-				UART0_RxReady=0;
-				if(ind==0)
-					break;
+				cnt = buflen - bytes;
 			}
 		}
-		else if(flag==NONE_BLOCKING)
+
+		/* Read data from ring buffer into user buffer */
+		bytes += cnt;
+		while (cnt--)
 		{
-			UART0_RxReady=0;
+			*rxbuf++ = rb->rx[tail & __BUF_MASK];
+			tail++;
 		}
-		/* Temporarily lock out UART receive interrupts during this
-		   read so the UART receive interrupt won't cause problems
-		   with the index values */
-		UART_IntConfig(UARTx, UART_INTCFG_RBR, DISABLE);
-		/* Loop until receive buffer ring is empty or
-			until max_bytes expires */
-
-		while ((buflen > 0) && (!(__BUF_IS_EMPTY(rb0.rx_head, rb0.rx_tail))))
-		{
-			/* Read data from ring buffer into user buffer */
-			*data = rb0.rx[rb0.rx_tail];
-			data++;
-
-			/* Update tail pointer */
-			__BUF_INCR(rb0.rx_tail);
+		/* Update tail pointer */
+		rb->rx_tail = tail;
 
-			/* Increment data count and decrement buffer size count */
-			bytes++;
-			buflen--;
+		if (port->RxPolicy == UART_OVERFLOW_OVERWRITE)
+		{
+			__set_PRIMASK(primask);
 		}
 
-		/* Re-enable UART interrupts */
-		UART_IntConfig(UARTx, UART_INTCFG_RBR, ENABLE);
+		/* Ring has room again: collect the data held back in the FIFO */
+		if (port->RxHold == SET)
+		{
+			primask = __get_PRIMASK();
+			__disable_irq();
+			port->RxHold = RESET;
+			uart_rx_fill(port);
+			if (port->RxHold == RESET)
+			{
+				UART_IntConfig(UARTx, UART_INTCFG_RBR, ENABLE);
+			}
+			__set_PRIMASK(primask);
+		}
 	}
 
-	if((UARTx==LPC_UART2))
+	if (UARTx == LPC_UART0)
+	{
+		UART0_RxReady = 0;
+	}
+	else
 	{
-		ind=buflen/TrgLvlU2;
+		UART2_RxReady = 0;
+	}
 
-		if((buflen%TrgLvlU2!=0) && (buflen>8))
-			ind++;
-		else if((buflen%TrgLvlU2!=0) && (buflen<8))
-			ind++;
+    return bytes;
+}
 
-		if(flag==TIME_BLOCKING)
-		{
-			time=UART_BLOCKING_TIMEOUT;
-			while((time!=0))
-			{
-				time--;
-				if(UART2_RxReady==1)
-				{
-					ind--;
-					UART2_RxReady=0;
-				}
-				if(ind==0)
-					break;
-			}
-		}
-		else if(flag==BLOCKING)
-		{
-			while(1)
-			{
-				while(UART2_RxReady!=1);
-				ind--;
-				UART2_RxReady=0;
-				if(ind==0)
-					break;
-			}
-		}
-		else if(flag==NONE_BLOCKING)
-		{
-			UART2_RxReady=0;
-		}
+/*********************************************************************//**
+ * @brief		Select what happens when a ring buffer is full
+ * @param[in]	UARTx	UART peripheral selected, should be:
+ *  			- LPC_UART0: UART0 peripheral
+ * 				- LPC_UART2: UART2 peripheral
+ * @param[in]	TxPolicy	Tx ring policy (default UART_OVERFLOW_BLOCK):
+ * 				- UART_OVERFLOW_DROP: new data is discarded
+ * 				- UART_OVERFLOW_BLOCK: caller waits for room
+ * 				- UART_OVERFLOW_OVERWRITE: oldest unsent data is discarded
+ * @param[in]	RxPolicy	Rx ring policy (default UART_OVERFLOW_DROP):
+ * 				- UART_OVERFLOW_DROP: new data is discarded
+ * 				- UART_OVERFLOW_BLOCK: data is held in the Rx FIFO until
+ * 				  UART_Receive() makes room (hardware overrun after 16 bytes)
+ * 				- UART_OVERFLOW_OVERWRITE: oldest unread data is discarded
+ * @return 		None
+ *
+ * Note: OVERWRITE on Tx must not be used by a producer that can preempt
+ * the UART interrupt handler.
+ **********************************************************************/
+void UART_SetOverflowPolicy(LPC_UART_TypeDef *UARTx, UART_OVERFLOW_Type TxPolicy, \
+				UART_OVERFLOW_Type RxPolicy)
+{
+	UART_PORT_T *port = uart_get_port(UARTx);
 
-		/* Temporarily lock out UART receive interrupts during this
-		   read so the UART receive interrupt won't cause problems
-		   with the index values */
+	if (port != NULL)
+	{
+		port->TxPolicy = TxPolicy;
+		port->RxPolicy = RxPolicy;
+	}
+}
 
-		UART_IntConfig(UARTx, UART_INTCFG_RBR, DISABLE);
-		/* Loop until receive buffer ring is empty or
-			until max_bytes expires */
-		while ((buflen > 0) && (!(__BUF_IS_EMPTY(rb2.rx_head, rb2.rx_tail))))
-		{
-			/* Read data from ring buffer into user buffer */
-			*data = rb2.rx[rb2.rx_tail];
-			data++;
+/*********************************************************************//**
+ * @brief		Get ring buffer statistics
+ * @param[in]	UARTx	UART peripheral selected, should be:
+ *  			- LPC_UART0: UART0 peripheral
+ * 				- LPC_UART2: UART2 peripheral
+ * @param[out]	Stats	Pointer to a UART_RING_STATS_Type structure
+ * @return 		None
+ **********************************************************************/
+void UART_GetRingStats(LPC_UART_TypeDef *UARTx, UART_RING_STATS_Type *Stats)
+{
+	UART_PORT_T *port = uart_get_port(UARTx);
 
-			/* Update tail pointer */
-			__BUF_INCR(rb2.rx_tail);
+	if (port != NULL)
+	{
+		*Stats = port->Stats;
+	}
+}
 
-			/* Increment data count and decrement buffer size count */
-			bytes++;
-			buflen--;
-		}
+/*********************************************************************//**
+ * @brief		Clear ring buffer statistics, the high-water marks restart
+ * 				from the current ring levels
+ * @param[in]	UARTx	UART peripheral selected, should be:
+ *  			- LPC_UART0: UART0 peripheral
+ * 				- LPC_UART2: UART2 peripheral
+ * @return 		None
+ **********************************************************************/
+void UART_ResetRingStats(LPC_UART_TypeDef *UARTx)
+{
+	UART_PORT_T *port = uart_get_port(UARTx);
+	uint32_t primask;
 
-		/* Re-enable UART interrupts */
-		UART_IntConfig(UARTx, UART_INTCFG_RBR, ENABLE);
-		UART2_RxReady=0;
+	if (port != NULL)
+	{
+		primask = __get_PRIMASK();
+		__disable_irq();
+		port->Stats.TxHighWater = __BUF_COUNT(port->rb->tx_head, port->rb->tx_tail);
+		port->Stats.RxHighWater = __BUF_COUNT(port->rb->rx_head, port->rb->rx_tail);
+		port->Stats.TxOverflow = 0;
+		port->Stats.RxOverflow = 0;
+		port->Stats.RxErrors = 0;
+		port->Stats.TxBursts = 0;
+		__set_PRIMASK(primask);
 	}
+}
 
-    return bytes;
+/*********************************************************************//**
+ * @brief		Wait until the Tx ring is empty and the last character has
+ * 				left the shift register
+ * @param[in]	UARTx	UART peripheral selected, should be:
+ *  			- LPC_UART0: UART0 peripheral
+ * 				- LPC_UART2: UART2 peripheral
+ * @return 		None
+ **********************************************************************/
+void UART_TxFlush(LPC_UART_TypeDef *UARTx)
+{
+	UART_PORT_T *port = uart_get_port(UARTx);
+
+	if (port != NULL)
+	{
+		while (!__BUF_IS_EMPTY(port->rb->tx_head, port->rb->tx_tail))
+		{
+			uart_tx_wait(port);
+		}
+	}
+	while (UART_CheckBusy(UARTx) == SET);
 }
 #endif
 
@@ -0,0 +1,611 @@
+/******************************************************************//**
+* @file		lpc_adc_acq.c
+* @brief	Contains all functions support for the continuous ADC
+*           acquisition engine: burst or MAT0.1 started conversions
+*           are moved by DMA into a ping-pong ring, each completed
+*           half is run through per channel statistics and CIC/FIR
+*           decimation filters
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @addtogroup ACQ
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc_adc_acq.h"
+#include <string.h>
+
+/* If this source file built with example, the LPC17xx FW library configuration
+ * file in each example directory ("lpc17xx_libcfg.h") must be included,
+ * otherwise the default FW library configuration file must be included instead
+ */
+
+/* Private Macros ------------------------------------------------------------- */
+/** @defgroup ACQ_Private_Macros ACQ Private Macros
+ * @{
+ */
+
+#define ACQ_CHANNELS		8
+/** Statistics stop accumulating when the count would wrap */
+#define ACQ_COUNT_MAX		0xFFFFFFFFUL
+
+/**
+ * @}
+ */
+
+
+/* Private Types -------------------------------------------------------------- */
+/** @defgroup ACQ_Private_Types ACQ Private Types
+ * @{
+ */
+
+typedef struct {
+	/* Raw statistics since the last reset */
+	uint32_t n;
+	uint16_t min, max;
+	uint64_t sum, sumsq;
+	/* CIC integrators and comb delays, wrapping arithmetic */
+	uint32_t integ[ACQ_CIC_ORDER];
+	uint32_t comb[ACQ_CIC_ORDER];
+	uint8_t cic_phase;
+	/* FIR history, stored twice so the window never wraps */
+	uint8_t fir_pos, fir_phase;
+	uint16_t hist[2 * ACQ_FIR_MAX_TAPS];
+	/* Filtered output, written by the DMA interrupt only */
+	__IO uint16_t head, tail;
+	uint16_t out[ACQ_OUT_SIZE];
+} ACQ_CHAN_T;
+
+/**
+ * @}
+ */
+
+
+/* Private Variables ---------------------------------------------------------- */
+static ACQ_CFG_Type acq_cfg;
+static ACQ_STATS_Type acq_stats;
+static ACQ_CHAN_T acq_chan[ACQ_CHANNELS];
+static Bool acq_ready, acq_running;
+static int32_t acq_dma_ch = -1;
+static uint8_t acq_next;				/* Half the next terminal count completes */
+
+/* Ping-pong ring filled by the DMA from ADGDR */
+static uint32_t acq_dma[2 * ACQ_DMA_HALF];
+static GPDMA_LLI_Type acq_lli[2];
+
+
+/* Private Functions ---------------------------------------------------------- */
+static void acq_put(ACQ_CHAN_T *c, uint32_t v);
+static void acq_fir(ACQ_CHAN_T *c, uint32_t v);
+static void acq_sample(ACQ_CHAN_T *c, uint32_t x);
+static void acq_block(const uint32_t *w);
+static void acq_halt(void);
+static void acq_dma_done(uint32_t ChannelNum, GPDMA_Status_Type Status);
+static uint32_t acq_isqrt(uint32_t v);
+
+/*********************************************************************//**
+ * @brief		Append a filtered sample to the output ring of a channel
+ * @param[in]	c		Channel state
+ * @param[in]	v		Sample in 12.4 fixed point
+ * @return		None
+ **********************************************************************/
+static void acq_put(ACQ_CHAN_T *c, uint32_t v)
+{
+	uint16_t head = c->head;
+
+	if ((uint16_t)(head - c->tail) >= ACQ_OUT_SIZE)
+	{
+		acq_stats.Dropped++;
+		return;
+	}
+	c->out[head & (ACQ_OUT_SIZE - 1)] = (uint16_t)v;
+	c->head = head + 1;
+}
+
+/*********************************************************************//**
+ * @brief		FIR stage, only the outputs kept by the decimation are
+ * 				computed
+ * @param[in]	c		Channel state
+ * @param[in]	v		CIC output in 12.4 fixed point
+ * @return		None
+ **********************************************************************/
+static void acq_fir(ACQ_CHAN_T *c, uint32_t v)
+{
+	uint32_t taps = acq_cfg.FirTaps;
+	const int16_t *h = acq_cfg.FirCoef;
+	const uint16_t *x;
+	int64_t acc = 0;
+	uint32_t k;
+
+	if (taps == 0)
+	{
+		acq_put(c, v);
+		return;
+	}
+
+	c->hist[c->fir_pos] = (uint16_t)v;
+	c->hist[c->fir_pos + taps] = (uint16_t)v;
+	if (++c->fir_pos == taps)
+	{
+		c->fir_pos = 0;
+	}
+	if (++c->fir_phase < acq_cfg.FirDecim)
+	{
+		return;
+	}
+	c->fir_phase = 0;
+
+	// Newest sample first, each product fits 32 bits
+	x = &c->hist[c->fir_pos + taps - 1];
+	for (k = 0; k < taps; k++)
+	{
+		acc += (int32_t)h[k] * (int32_t)*x--;
+	}
+	acc = (acc + (1 << 14)) >> 15;
+	if (acc < 0)
+	{
+		acc = 0;
+	}
+	else if (acc > 0xFFFF)
+	{
+		acc = 0xFFFF;
+	}
+	acq_put(c, (uint32_t)acc);
+}
+
+/*********************************************************************//**
+ * @brief		Run one conversion through the statistics and the CIC
+ * @param[in]	c		Channel state
+ * @param[in]	x		12-bit conversion result
+ * @return		None
+ **********************************************************************/
+static void acq_sample(ACQ_CHAN_T *c, uint32_t x)
+{
+	uint32_t shift = acq_cfg.CicShift;
+	uint32_t y, t, i;
+	int32_t norm;
+
+	if (c->n != ACQ_COUNT_MAX)
+	{
+		c->n++;
+		c->sum += x;
+		c->sumsq += x * x;
+		if (x < c->min)
+		{
+			c->min = (uint16_t)x;
+		}
+		if (x > c->max)
+		{
+			c->max = (uint16_t)x;
+		}
+	}
+
+	if (shift == 0)
+	{
+		acq_fir(c, x << ACQ_FRAC_BITS);
+		return;
+	}
+
+	c->integ[0] += x;
+	for (i = 1; i < ACQ_CIC_ORDER; i++)
+	{
+		c->integ[i] += c->integ[i - 1];
+	}
+	if (++c->cic_phase < (1UL << shift))
+	{
+		return;
+	}
+	c->cic_phase = 0;
+
+	y = c->integ[ACQ_CIC_ORDER - 1];
+	for (i = 0; i < ACQ_CIC_ORDER; i++)
+	{
+		t = y - c->comb[i];
+		c->comb[i] = y;
+		y = t;
+	}
+
+	// Remove the R^N gain, keeping ACQ_FRAC_BITS of the extra resolution
+	norm = (int32_t)(ACQ_CIC_ORDER * shift) - ACQ_FRAC_BITS;
+	if (norm > 0)
+	{
+		y = (y + (1UL << (norm - 1))) >> norm;
+	}
+	else
+	{
+		y <<= -norm;
+	}
+	acq_fir(c, y);
+}
+
+/*********************************************************************//**
+ * @brief		Process one completed DMA half buffer
+ * @param[in]	w		ADGDR words
+ * @return		None
+ **********************************************************************/
+static void acq_block(const uint32_t *w)
+{
+	uint32_t i, v, ch;
+
+	for (i = 0; i < ACQ_DMA_HALF; i++)
+	{
+		v = w[i];
+		if (v & ADC_GDR_OVERRUN_FLAG)
+		{
+			acq_stats.Overruns++;
+		}
+		ch = ADC_GDR_CH(v);
+		if ((v & ADC_GDR_DONE_FLAG) && (acq_cfg.ChannelMask & (1 << ch)))
+		{
+			acq_sample(&acq_chan[ch], ADC_GDR_RESULT(v));
+			acq_stats.Samples++;
+		}
+	}
+	acq_stats.Blocks++;
+}
+
+/*********************************************************************//**
+ * @brief		Stop the conversions and the DMA channel
+ * @param		None
+ * @return		None
+ **********************************************************************/
+static void acq_halt(void)
+{
+	if (acq_cfg.Trigger == ACQ_TRIG_MAT01)
+	{
+		TIM_Cmd(LPC_TIM0, DISABLE);
+		ADC_StartCmd(LPC_ADC, ADC_START_CONTINUOUS);
+	}
+	else
+	{
+		ADC_BurstCmd(LPC_ADC, DISABLE);
+	}
+	GPDMA_ChannelCmd(acq_dma_ch, DISABLE);
+	acq_running = FALSE;
+}
+
+/*********************************************************************//**
+ * @brief		DMA terminal count of a ring half. The destination the
+ * 				controller is writing tells which half is complete, so a
+ * 				half overwritten while the interrupt was held off is
+ * 				counted instead of being processed out of order. A hold
+ * 				off of a whole ring lap or more can go unnoticed.
+ * @param[in]	ChannelNum	DMA channel
+ * @param[in]	Status		GPDMA_STAT_INTTC or GPDMA_STAT_INTERR
+ * @return		None
+ **********************************************************************/
+static void acq_dma_done(uint32_t ChannelNum, GPDMA_Status_Type Status)
+{
+	uint32_t busy;
+
+	if (Status == GPDMA_STAT_INTERR)
+	{
+		acq_stats.Errors++;
+		acq_halt();
+		return;
+	}
+
+	busy = ((GPDMA_GetDestAddr(ChannelNum) - GPDMA_BUS_ADDR(acq_dma)) / (ACQ_DMA_HALF * 4)) & 1;
+	if ((busy ^ 1) != acq_next)
+	{
+		acq_stats.LostBlocks++;
+	}
+	acq_block(&acq_dma[(busy ^ 1) * ACQ_DMA_HALF]);
+	acq_next = (uint8_t)busy;
+}
+
+/*********************************************************************//**
+ * @brief		Integer square root
+ * @param[in]	v		Radicand
+ * @return		floor(sqrt(v))
+ **********************************************************************/
+static uint32_t acq_isqrt(uint32_t v)
+{
+	uint32_t res = 0, bit = 1UL << 30;
+
+	while (bit > v)
+	{
+		bit >>= 2;
+	}
+	while (bit)
+	{
+		if (v >= res + bit)
+		{
+			v -= res + bit;
+			res = (res >> 1) + bit;
+		}
+		else
+		{
+			res >>= 1;
+		}
+		bit >>= 2;
+	}
+	return res;
+}
+
+/* End of Private Functions --------------------------------------------------- */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @addtogroup ACQ_Public_Functions
+ * @{
+ */
+
+/*********************************************************************//**
+ * @brief		Set up the ADC, the trigger and a DMA channel for an
+ * 				acquisition and clear all filter states, statistics and
+ * 				output rings. GPDMA_Init() must have been called.
+ * @param[in]	cfg		Acquisition configuration, copied
+ * @return		ERROR if the configuration is out of range or no DMA
+ * 				channel is free, SUCCESS otherwise
+ **********************************************************************/
+Status ACQ_Init(ACQ_CFG_Type *cfg)
+{
+	TIM_TIMERCFG_Type tim;
+	TIM_MATCHCFG_Type mat;
+	uint32_t ch, pclk, half;
+
+	if ((cfg->ChannelMask == 0) || (cfg->Rate == 0) || (cfg->Rate > ACQ_MAX_RATE) \
+			|| (cfg->CicShift > ACQ_CIC_SHIFT_MAX) || (cfg->FirTaps > ACQ_FIR_MAX_TAPS) \
+			|| (cfg->FirTaps && (cfg->FirCoef == NULL)))
+	{
+		return ERROR;
+	}
+	// Timer started conversions convert one channel each
+	if ((cfg->Trigger != ACQ_TRIG_BURST) && ((cfg->Trigger != ACQ_TRIG_MAT01) \
+			|| (cfg->ChannelMask & (cfg->ChannelMask - 1))))
+	{
+		return ERROR;
+	}
+
+	if (acq_running)
+	{
+		acq_halt();
+	}
+	if (acq_dma_ch < 0)
+	{
+		acq_dma_ch = GPDMA_AllocChannel();
+		if (acq_dma_ch < 0)
+		{
+			return ERROR;
+		}
+	}
+
+	acq_cfg = *cfg;
+	if (acq_cfg.FirDecim == 0)
+	{
+		acq_cfg.FirDecim = 1;
+	}
+	memset(acq_chan, 0, sizeof(acq_chan));
+	memset(&acq_stats, 0, sizeof(acq_stats));
+	for (ch = 0; ch < ACQ_CHANNELS; ch++)
+	{
+		acq_chan[ch].min = 0xFFFF;
+	}
+
+	/* Burst mode converts at the requested rate, timer started
+	 * conversions at the fastest rate so each ends before the next edge */
+	ADC_Init(LPC_ADC, (acq_cfg.Trigger == ACQ_TRIG_BURST) ? acq_cfg.Rate : ACQ_MAX_RATE);
+	for (ch = 0; ch < ACQ_CHANNELS; ch++)
+	{
+		if (acq_cfg.ChannelMask & (1 << ch))
+		{
+			ADC_Channel_Config(LPC_ADC, (ADC_CHANNEL_SELECTION)ch, DISABLE);
+			// A done channel with its interrupt enabled raises the DMA request
+			ADC_IntConfig(LPC_ADC, (ADC_TYPE_INT_OPT)ch, ENABLE);
+		}
+	}
+	ADC_IntConfig(LPC_ADC, ADC_ADGINTEN, DISABLE);
+	NVIC_DisableIRQ(ADC_IRQn);
+
+	if (acq_cfg.Trigger == ACQ_TRIG_MAT01)
+	{
+		tim.PrescaleOption = TIM_PRESCALE_TICKVAL;
+		tim.PrescaleValue = 1;
+		TIM_Init(LPC_TIM0, TIM_TIMER_MODE, &tim);
+
+		// MAT0.1 toggles, one rising edge every second match
+		pclk = CLKPWR_GetPCLK(CLKPWR_PCLKSEL_TIMER0);
+		half = pclk / (2 * acq_cfg.Rate);
+		if (half == 0)
+		{
+			half = 1;
+		}
+		mat.MatchChannel = 1;
+		mat.IntOnMatch = DISABLE;
+		mat.StopOnMatch = DISABLE;
+		mat.ResetOnMatch = ENABLE;
+		mat.ExtMatchOutputType = TIM_EXTMATCH_TOGGLE;
+		mat.MatchValue = half - 1;
+		TIM_ConfigMatch(LPC_TIM0, &mat);
+		ADC_EdgeStartConfig(LPC_ADC, ADC_START_ON_RISING);
+		acq_stats.Rate = pclk / (2 * half);
+	}
+	else
+	{
+		pclk = CLKPWR_GetPCLK(CLKPWR_PCLKSEL_ADC);
+		acq_stats.Rate = pclk / ((((LPC_ADC->ADCR >> 8) & 0xFF) + 1) * 65);
+	}
+
+	acq_ready = TRUE;
+	return SUCCESS;
+}
+
+/*********************************************************************//**
+ * @brief		Start converting into the DMA ring
+ * @param		None
+ * @return		ERROR if ACQ_Init() was not successful or the DMA
+ * 				channel could not be set up, SUCCESS otherwise
+ **********************************************************************/
+Status ACQ_Start(void)
+{
+	GPDMA_Channel_CFG_Type dma;
+
+	if (!acq_ready)
+	{
+		return ERROR;
+	}
+	if (acq_running)
+	{
+		return SUCCESS;
+	}
+
+	dma.ChannelNum = acq_dma_ch;
+	dma.TransferSize = 2 * ACQ_DMA_HALF;
+	dma.TransferWidth = 0;
+	dma.SrcMemAddr = 0;
+	dma.DstMemAddr = GPDMA_BUS_ADDR(acq_dma);
+	dma.TransferType = GPDMA_TRANSFERTYPE_P2M;
+	dma.SrcConn = GPDMA_CONN_ADC;
+	dma.DstConn = 0;
+	dma.DMALLI = 0;
+	dma.Options = GPDMA_OPT_CIRCULAR;
+	dma.Callback = acq_dma_done;
+	if (GPDMA_SetupRing(&dma, acq_lli, 2) == ERROR)
+	{
+		return ERROR;
+	}
+
+	// Drop a result left from before, it would be the first transfer
+	(void)ADC_GlobalGetData(LPC_ADC);
+	acq_next = 0;
+	acq_running = TRUE;
+	GPDMA_ChannelCmd(acq_dma_ch, ENABLE);
+
+	if (acq_cfg.Trigger == ACQ_TRIG_MAT01)
+	{
+		ADC_StartCmd(LPC_ADC, ADC_START_ON_MAT01);
+		TIM_ResetCounter(LPC_TIM0);
+		TIM_Cmd(LPC_TIM0, ENABLE);
+	}
+	else
+	{
+		ADC_StartCmd(LPC_ADC, ADC_START_CONTINUOUS);
+		ADC_BurstCmd(LPC_ADC, ENABLE);
+	}
+	return SUCCESS;
+}
+
+/*********************************************************************//**
+ * @brief		Stop converting. The half buffer being filled is
+ * 				discarded, filtered samples stay readable.
+ * @param		None
+ * @return		None
+ **********************************************************************/
+void ACQ_Stop(void)
+{
+	if (acq_running)
+	{
+		acq_halt();
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Read filtered samples of a channel
+ * @param[in]	ch		ADC channel 0..7
+ * @param[out]	buf		Samples in 12.4 fixed point, oldest first
+ * @param[in]	len		Size of buf in samples
+ * @return		Number of samples copied
+ **********************************************************************/
+uint32_t ACQ_Read(uint8_t ch, uint16_t *buf, uint32_t len)
+{
+	ACQ_CHAN_T *c;
+	uint16_t tail;
+	uint32_t n = 0;
+
+	if (ch >= ACQ_CHANNELS)
+	{
+		return 0;
+	}
+	c = &acq_chan[ch];
+	tail = c->tail;
+	while ((n < len) && (tail != c->head))
+	{
+		buf[n++] = c->out[tail & (ACQ_OUT_SIZE - 1)];
+		tail++;
+	}
+	c->tail = tail;
+	return n;
+}
+
+/*********************************************************************//**
+ * @brief		Get the running statistics of a channel
+ * @param[in]	ch		ADC channel 0..7
+ * @param[out]	stats	Count, extremes, mean and RMS of the conversions
+ * 						since ACQ_Init() or the last reset
+ * @param[in]	reset	TRUE to restart the statistics
+ * @return		None
+ **********************************************************************/
+void ACQ_GetChannelStats(uint8_t ch, ACQ_CHAN_STATS_Type *stats, Bool reset)
+{
+	ACQ_CHAN_T *c;
+	uint32_t primask, n, msq;
+	uint16_t min, max;
+	uint64_t sum, sumsq;
+
+	memset(stats, 0, sizeof(*stats));
+	if (ch >= ACQ_CHANNELS)
+	{
+		return;
+	}
+	c = &acq_chan[ch];
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	n = c->n;
+	min = c->min;
+	max = c->max;
+	sum = c->sum;
+	sumsq = c->sumsq;
+	if (reset)
+	{
+		c->n = 0;
+		c->sum = 0;
+		c->sumsq = 0;
+		c->min = 0xFFFF;
+		c->max = 0;
+	}
+	__set_PRIMASK(primask);
+
+	if (n == 0)
+	{
+		return;
+	}
+	stats->Count = n;
+	stats->Min = min;
+	stats->Max = max;
+	stats->Mean = (uint16_t)(((sum << ACQ_FRAC_BITS) + (n / 2)) / n);
+	// Mean square in 24.8, the remainder keeps the fraction exact
+	msq = (uint32_t)(((sumsq / n) << (2 * ACQ_FRAC_BITS)) + (((sumsq % n) << (2 * ACQ_FRAC_BITS)) / n));
+	stats->Rms = (uint16_t)acq_isqrt(msq);
+}
+
+/*********************************************************************//**
+ * @brief		Get the engine counters
+ * @param[out]	stats	Copy of the counters
+ * @return		None
+ **********************************************************************/
+void ACQ_GetStats(ACQ_STATS_Type *stats)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	*stats = acq_stats;
+	__set_PRIMASK(primask);
+}
+
+/**
+ * @}
+ */
+
+/* End of Public Functions ---------------------------------------------------- */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -15,18 +15,12 @@
 /* Includes ------------------------------------------------------------------- */
 #include "lpc_buzzer.h"
 
-/* Buzzer */
-uint16_t timeout;     /* timeout for note */
-uint16_t on_time;
-uint16_t off_time;
-
-uint16_t on_timer;
-uint16_t off_timer;
-
-Bool play_note;
+/* Single note played by Play_Frequency() */
+static uint16_t beep_freq;
+static uint16_t beep_dur;
 
 /************************** LOCAL CONSTANTS *************************/
-const uchar note[MELODY_LENGTH] =
+const uint16_t note[MELODY_LENGTH] =
 {
   E5, SILENT_NOTE, E5, SILENT_NOTE, E5, SILENT_NOTE,
 
@@ -70,41 +64,6 @@ const uint16_t duration[MELODY_LENGTH] =
 };
 
 
-/*----------------- INTERRUPT SERVICE ROUTINES --------------------------*/
-/*********************************************************************//**
- * @brief       RIT interrupt handler sub-routine
- * @param[in]   None
- * @return      None
- **********************************************************************/
-void RIT_IRQHandler(void)
-{
-    RIT_GetIntStatus(LPC_RIT); //call this to clear interrupt flag
-
-    /* generate one note; freq + duration */
-    if(play_note) /* Flag to play note */
-    {
-        if(timeout)  /* Note Duration */
-        {
-            if(on_timer)
-            {
-                GPIO_SetValue(BUZZER_PORT, BUZZER_PIN);    // Buzzer On
-                --on_timer;
-            }
-            else if(off_timer)
-            {
-                GPIO_ClearValue(BUZZER_PORT, BUZZER_PIN);  // Buzzer Off
-                --off_timer;
-            }
-            else
-            {
-                on_timer = on_time;     /* Reload on_time  */
-                off_timer = off_time;   /* Reload off_time */
-            }
-            --timeout;  /*decrement timer */
-        }
-    }/* end of buzzer's code */
-}
-
 /************************** PUBLIC FUNCTIONS *************************/
 /* Public Functions ----------------------------------------------------------- */
 /** @addtogroup BUZZER_Public_Functions
@@ -112,65 +71,65 @@ void RIT_IRQHandler(void)
  */
  
 /*-------------------------PUBLIC FUNCTIONS------------------------------*/
+/*********************************************************************//**
+ * @brief	Set up the DAC synthesis engine and give BUZZER_VOICE a
+ *          buzzer like square tone. GPDMA_Init() must have been called.
+ * @param	None
+ * @return	None
+ **********************************************************************/
 void Buzzer_Config(void)
 {
-    GPIO_SetDir(BUZZER_PORT, BUZZER_PIN, 1);        // Buzzer Output
-    GPIO_ClearValue(BUZZER_PORT, BUZZER_PIN);       // Buzzer Off
+	SYNTH_VOICE_CFG_Type cfg;
 
-    RIT_Config(LPC_RIT, 50, RIT_US);
+	if (SYNTH_Init() == ERROR)
+	{
+		return;
+	}
+	cfg.Wave = SYNTH_WAVE_SQUARE;
+	cfg.Level = 96;
+	cfg.Sustain = 180;
+	cfg.Attack = 2;
+	cfg.Decay = 40;
+	cfg.Release = 15;
+	SYNTH_VoiceConfig(BUZZER_VOICE, &cfg);
+	SYNTH_Start();
 }
 
 /*********************************************************************//**
- * @brief	Set up timer 1 to play the desired frequency (in Hz) and for the the
- *          desired duration (in ms). Allowed frequencies are from 40 Hz to 5 kHz.
- * @param	freq : Frequency of the note
+ * @brief	Play the desired frequency (in Hz) for the desired duration
+ *          (in ms), returns at once. Allowed frequencies are from 40 Hz
+ *          to 5 kHz.
+ * @param	freq : Frequency of the note, SILENT_NOTE for a rest
  * @param   dur  : Duration of the note
  * @return	None
  **********************************************************************/
 void Play_Frequency(uint16_t freq, uint16_t dur)
 {
-	if(freq == SILENT_NOTE)
-	{
-		on_time = 0;               /* ON time of period */
-		off_time = 0;              /* OFF time of period */
-
-		timeout = dur * 20;        /* set timeout (duration); multiply by 20 if 20kHz */
-	}
-	else
-	{
-		on_time = freq / 2;        /* 50% duty cycle */
-		off_time = freq - on_time;
-		timeout = dur * 20;        /* set timeout (duration); multiply by 20 if 20kHz */
-	}
-
-	on_timer = on_time;          /* Load on_time  */
-	off_timer = off_time;        /* Load off_time */
+	beep_freq = freq;
+	beep_dur = dur;
+	SYNTH_Play(BUZZER_VOICE, &beep_freq, &beep_dur, 1, FALSE);
 }
 
 
 /*********************************************************************//**
- * @brief	This tune will be play at the end of the program
+ * @brief	Start the tune, the sequencer plays it from the DMA interrupt
+ *          while the caller goes on. Buzzer_Busy() tells when it ended.
  * @param	None
  * @return	None
  **********************************************************************/
 void Play_Melody(void)
 {
-	uchar i;
-	uint16_t freq;
-	uint16_t dur;
-
-	play_note = ON;   /* start tune */
-
-	for ( i = 0; i < MELODY_LENGTH; i++)
-	{
-		freq = note[i];
-		dur = duration[i];
-		Play_Frequency(freq, dur);
-		while(timeout){ /* wait */};
-	}
-	play_note = OFF; /* stop tune */
+	SYNTH_Play(BUZZER_VOICE, note, duration, MELODY_LENGTH, FALSE);
+}
 
-	GPIO_ClearValue(BUZZER_PORT, BUZZER_PIN); // Buzzer Off
+/*********************************************************************//**
+ * @brief	Check whether a tone or the tune is still playing
+ * @param	None
+ * @return	TRUE while playing, FALSE otherwise
+ **********************************************************************/
+Bool Buzzer_Busy(void)
+{
+	return SYNTH_Playing(BUZZER_VOICE);
 }
 
 
@@ -0,0 +1,439 @@
+/******************************************************************//**
+* @file		lpc_crc.c
+* @brief	Contains all functions support for table driven CRC-32,
+*           CRC-16 and CRC-7 library on LPC17xx
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @addtogroup CRC
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc_crc.h"
+
+/* If this source file built with example, the LPC17xx FW library configuration
+ * file in each example directory ("lpc17xx_libcfg.h") must be included,
+ * otherwise the default FW library configuration file must be included instead
+ */
+
+/* Private Macros ------------------------------------------------------------- */
+/** @defgroup CRC_Private_Macros CRC Private Macros
+ * @{
+ */
+
+/*********************************************************************//**
+ * Table generation
+ * A CRC without init/final xor is linear, so table[n] is the xor of the
+ * entries for the bits set in n. Each table below is given by its eight
+ * single bit entries and the compiler folds the remaining 248 into
+ * constants. Slice k holds the CRC of byte n followed by k zero bytes.
+ **********************************************************************/
+#define CRC_BIT(n, b, k)	((((n) >> (b)) & 1) ? (k) : 0)
+#define CRC_ENTRY(n, k0, k1, k2, k3, k4, k5, k6, k7) \
+	(CRC_BIT(n, 0, k0) ^ CRC_BIT(n, 1, k1) ^ CRC_BIT(n, 2, k2) ^ CRC_BIT(n, 3, k3) ^ \
+	 CRC_BIT(n, 4, k4) ^ CRC_BIT(n, 5, k5) ^ CRC_BIT(n, 6, k6) ^ CRC_BIT(n, 7, k7))
+
+#define CRC_ROW4(f, n)		f(n), f((n) + 1), f((n) + 2), f((n) + 3)
+#define CRC_ROW16(f, n)		CRC_ROW4(f, n), CRC_ROW4(f, (n) + 4), \
+							CRC_ROW4(f, (n) + 8), CRC_ROW4(f, (n) + 12)
+#define CRC_TABLE(f)		{ CRC_ROW16(f, 0x00), CRC_ROW16(f, 0x10), CRC_ROW16(f, 0x20), CRC_ROW16(f, 0x30), \
+							  CRC_ROW16(f, 0x40), CRC_ROW16(f, 0x50), CRC_ROW16(f, 0x60), CRC_ROW16(f, 0x70), \
+							  CRC_ROW16(f, 0x80), CRC_ROW16(f, 0x90), CRC_ROW16(f, 0xA0), CRC_ROW16(f, 0xB0), \
+							  CRC_ROW16(f, 0xC0), CRC_ROW16(f, 0xD0), CRC_ROW16(f, 0xE0), CRC_ROW16(f, 0xF0) }
+
+/** CRC-32, reflected polynomial 0xEDB88320 */
+#define CRC32_T0(n)		CRC_ENTRY(n, 0x77073096UL, 0xEE0E612CUL, 0x076DC419UL, 0x0EDB8832UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x76DC4190UL, 0xEDB88320UL)
+#define CRC32_T1(n)		CRC_ENTRY(n, 0x191B3141UL, 0x32366282UL, 0x646CC504UL, 0xC8D98A08UL, 0x4AC21251UL, 0x958424A2UL, 0xF0794F05UL, 0x3B83984BUL)
+#define CRC32_T2(n)		CRC_ENTRY(n, 0x01C26A37UL, 0x0384D46EUL, 0x0709A8DCUL, 0x0E1351B8UL, 0x1C26A370UL, 0x384D46E0UL, 0x709A8DC0UL, 0xE1351B80UL)
+#define CRC32_T3(n)		CRC_ENTRY(n, 0xB8BC6765UL, 0xAA09C88BUL, 0x8F629757UL, 0xC5B428EFUL, 0x5019579FUL, 0xA032AF3EUL, 0x9B14583DUL, 0xED59B63BUL)
+#define CRC32_T4(n)		CRC_ENTRY(n, 0x3D6029B0UL, 0x7AC05360UL, 0xF580A6C0UL, 0x30704BC1UL, 0x60E09782UL, 0xC1C12F04UL, 0x58F35849UL, 0xB1E6B092UL)
+#define CRC32_T5(n)		CRC_ENTRY(n, 0xCB5CD3A5UL, 0x4DC8A10BUL, 0x9B914216UL, 0xEC53826DUL, 0x03D6029BUL, 0x07AC0536UL, 0x0F580A6CUL, 0x1EB014D8UL)
+#define CRC32_T6(n)		CRC_ENTRY(n, 0xA6770BB4UL, 0x979F1129UL, 0xF44F2413UL, 0x33EF4E67UL, 0x67DE9CCEUL, 0xCFBD399CUL, 0x440B7579UL, 0x8816EAF2UL)
+#define CRC32_T7(n)		CRC_ENTRY(n, 0xCCAA009EUL, 0x4225077DUL, 0x844A0EFAUL, 0xD3E51BB5UL, 0x7CBB312BUL, 0xF9766256UL, 0x299DC2EDUL, 0x533B85DAUL)
+
+/** CRC-16-CCITT, polynomial 0x1021, MSB first */
+#define CRC16_T0(n)		CRC_ENTRY(n, 0x1021, 0x2042, 0x4084, 0x8108, 0x1231, 0x2462, 0x48C4, 0x9188)
+#define CRC16_T1(n)		CRC_ENTRY(n, 0x3331, 0x6662, 0xCCC4, 0x89A9, 0x0373, 0x06E6, 0x0DCC, 0x1B98)
+#define CRC16_T2(n)		CRC_ENTRY(n, 0x3730, 0x6E60, 0xDCC0, 0xA9A1, 0x4363, 0x86C6, 0x1DAD, 0x3B5A)
+#define CRC16_T3(n)		CRC_ENTRY(n, 0x76B4, 0xED68, 0xCAF1, 0x85C3, 0x1BA7, 0x374E, 0x6E9C, 0xDD38)
+#define CRC16_T4(n)		CRC_ENTRY(n, 0xAA51, 0x4483, 0x8906, 0x022D, 0x045A, 0x08B4, 0x1168, 0x22D0)
+#define CRC16_T5(n)		CRC_ENTRY(n, 0x45A0, 0x8B40, 0x06A1, 0x0D42, 0x1A84, 0x3508, 0x6A10, 0xD420)
+#define CRC16_T6(n)		CRC_ENTRY(n, 0xB861, 0x60E3, 0xC1C6, 0x93AD, 0x377B, 0x6EF6, 0xDDEC, 0xABF9)
+#define CRC16_T7(n)		CRC_ENTRY(n, 0x47D3, 0x8FA6, 0x0F6D, 0x1EDA, 0x3DB4, 0x7B68, 0xF6D0, 0xFD81)
+
+/** CRC-7, polynomial 0x09, kept left aligned in bits 7..1 */
+#define CRC7_T0(n)		CRC_ENTRY(n, 0x12, 0x24, 0x48, 0x90, 0x32, 0x64, 0xC8, 0x82)
+
+/**
+ * @}
+ */
+
+
+/* Private Variables ---------------------------------------------------------- */
+/** @defgroup CRC_Private_Variables CRC Private Variables
+ * @{
+ */
+
+static const uint32_t crc32_table[CRC_SLICES][256] = {
+	CRC_TABLE(CRC32_T0),
+#if (CRC_SLICES > 1)
+	CRC_TABLE(CRC32_T1), CRC_TABLE(CRC32_T2), CRC_TABLE(CRC32_T3),
+#endif
+#if (CRC_SLICES > 4)
+	CRC_TABLE(CRC32_T4), CRC_TABLE(CRC32_T5), CRC_TABLE(CRC32_T6), CRC_TABLE(CRC32_T7),
+#endif
+};
+
+static const uint16_t crc16_table[CRC_SLICES][256] = {
+	CRC_TABLE(CRC16_T0),
+#if (CRC_SLICES > 1)
+	CRC_TABLE(CRC16_T1), CRC_TABLE(CRC16_T2), CRC_TABLE(CRC16_T3),
+#endif
+#if (CRC_SLICES > 4)
+	CRC_TABLE(CRC16_T4), CRC_TABLE(CRC16_T5), CRC_TABLE(CRC16_T6), CRC_TABLE(CRC16_T7),
+#endif
+};
+
+static const uint8_t crc7_table[256] = CRC_TABLE(CRC7_T0);
+
+/**
+ * @}
+ */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @addtogroup CRC_Public_Functions
+ * @{
+ */
+
+/*********************************************************************//**
+ * @brief		Add bytes to a running CRC-32 (Ethernet, reflected)
+ * @param[in]	crc		CRC32_INIT to start or value from previous call
+ * @param[in]	data	pointer to data
+ * @param[in]	len		number of bytes
+ * @return		CRC register, complement it for the FCS
+ *
+ * Note: The sliced loops read aligned little endian words.
+ **********************************************************************/
+uint32_t CRC32_Update (uint32_t crc, const uint8_t *data, uint32_t len)
+{
+#if (CRC_SLICES > 1)
+	const uint32_t *word;
+#if (CRC_SLICES > 4)
+	uint32_t next;
+#endif
+
+	// Bytes up to the first word boundary
+	while (len && ((uint32_t)data & 3))
+	{
+		crc = (crc >> 8) ^ crc32_table[0][(crc ^ *data++) & 0xFF];
+		len--;
+	}
+
+	word = (const uint32_t *)data;
+#if (CRC_SLICES > 4)
+	for (; len >= 8; len -= 8)
+	{
+		crc ^= *word++;
+		next = *word++;
+		crc = crc32_table[7][crc & 0xFF] ^ crc32_table[6][(crc >> 8) & 0xFF]
+			^ crc32_table[5][(crc >> 16) & 0xFF] ^ crc32_table[4][crc >> 24]
+			^ crc32_table[3][next & 0xFF] ^ crc32_table[2][(next >> 8) & 0xFF]
+			^ crc32_table[1][(next >> 16) & 0xFF] ^ crc32_table[0][next >> 24];
+	}
+#endif
+	for (; len >= 4; len -= 4)
+	{
+		crc ^= *word++;
+		crc = crc32_table[3][crc & 0xFF] ^ crc32_table[2][(crc >> 8) & 0xFF]
+			^ crc32_table[1][(crc >> 16) & 0xFF] ^ crc32_table[0][crc >> 24];
+	}
+	data = (const uint8_t *)word;
+#endif
+
+	while (len--)
+	{
+		crc = (crc >> 8) ^ crc32_table[0][(crc ^ *data++) & 0xFF];
+	}
+	return crc;
+}
+
+
+/*********************************************************************//**
+ * @brief		Calculate the Ethernet frame check sequence
+ * @param[in]	data	pointer to frame without FCS
+ * @param[in]	len		frame length
+ * @return		FCS, sent LSB first
+ **********************************************************************/
+uint32_t CRC32_Calc (const uint8_t *data, uint32_t len)
+{
+	return ~CRC32_Update(CRC32_INIT, data, len);
+}
+
+
+/*********************************************************************//**
+ * @brief		Get the EMAC hash filter bit of a destination address
+ * @param[in]	mac		pointer to 6 byte MAC address
+ * @return		Bit number 0..63 in HashFilterL/HashFilterH
+ *
+ * Note: The EMAC takes bits [28:23] of the CRC register shifted MSB
+ * first, which is the bit reversed reflected register.
+ **********************************************************************/
+uint8_t CRC32_HashIndex (const uint8_t *mac)
+{
+	return (uint8_t)((__RBIT(CRC32_Update(CRC32_INIT, mac, 6)) >> 23) & 0x3F);
+}
+
+
+/*********************************************************************//**
+ * @brief		Add bytes to a running CRC-16-CCITT (SD data blocks)
+ * @param[in]	crc		CRC16_INIT to start or value from previous call
+ * @param[in]	data	pointer to data
+ * @param[in]	len		number of bytes
+ * @return		CRC-16, sent MSB first after the block
+ **********************************************************************/
+uint16_t CRC16_Update (uint16_t crc, const uint8_t *data, uint32_t len)
+{
+#if (CRC_SLICES > 4)
+	for (; len >= 8; len -= 8, data += 8)
+	{
+		crc = crc16_table[7][(crc >> 8) ^ data[0]] ^ crc16_table[6][(crc & 0xFF) ^ data[1]]
+			^ crc16_table[5][data[2]] ^ crc16_table[4][data[3]]
+			^ crc16_table[3][data[4]] ^ crc16_table[2][data[5]]
+			^ crc16_table[1][data[6]] ^ crc16_table[0][data[7]];
+	}
+#endif
+#if (CRC_SLICES > 1)
+	for (; len >= 4; len -= 4, data += 4)
+	{
+		crc = crc16_table[3][(crc >> 8) ^ data[0]] ^ crc16_table[2][(crc & 0xFF) ^ data[1]]
+			^ crc16_table[1][data[2]] ^ crc16_table[0][data[3]];
+	}
+#endif
+
+	while (len--)
+	{
+		crc = (uint16_t)(crc << 8) ^ crc16_table[0][(crc >> 8) ^ *data++];
+	}
+	return crc;
+}
+
+
+/*********************************************************************//**
+ * @brief		Calculate CRC-16 of a SD data block
+ * @param[in]	data	pointer to block
+ * @param[in]	len		block length
+ * @return		CRC-16
+ **********************************************************************/
+uint16_t CRC16_Calc (const uint8_t *data, uint32_t len)
+{
+	return CRC16_Update(CRC16_INIT, data, len);
+}
+
+
+/*********************************************************************//**
+ * @brief		Add bytes to a running CRC-7 (SD commands)
+ * @param[in]	crc		CRC7_INIT to start or value from previous call
+ * @param[in]	data	pointer to data
+ * @param[in]	len		number of bytes
+ * @return		CRC-7 in bits 6..0
+ **********************************************************************/
+uint8_t CRC7_Update (uint8_t crc, const uint8_t *data, uint32_t len)
+{
+	crc <<= 1;
+	while (len--)
+	{
+		crc = crc7_table[crc ^ *data++];
+	}
+	return crc >> 1;
+}
+
+
+/*********************************************************************//**
+ * @brief		Calculate CRC-7 of a SD command
+ * @param[in]	data	pointer to command and argument bytes
+ * @param[in]	len		number of bytes (5 for a command)
+ * @return		CRC-7, send as (crc << 1) | 1
+ **********************************************************************/
+uint8_t CRC7_Calc (const uint8_t *data, uint32_t len)
+{
+	return CRC7_Update(CRC7_INIT, data, len);
+}
+
+/**
+ * @}
+ */
+
+
+#ifdef CRC_BENCH_MODE
+/* Private Functions ---------------------------------------------------------- */
+/** @defgroup CRC_Private_Functions CRC Private Functions
+ * @{
+ */
+
+#define CRC_BENCH_BYTES		1518
+#define CRC_BENCH_RUNS		200
+
+static uint8_t crc_bench_buf[CRC_BENCH_BYTES];
+
+/*********************************************************************//**
+ * @brief		Host time stamp counter
+ **********************************************************************/
+static __INLINE uint64_t crc_bench_cycles (void)
+{
+	return __builtin_ia32_rdtsc();
+}
+
+
+/*********************************************************************//**
+ * @brief		Nibble serial CRC-32 formerly used by the EMAC driver
+ **********************************************************************/
+static uint32_t crc32_nibble (const uint8_t *data, uint32_t len)
+{
+	uint32_t crc = 0xFFFFFFFF;
+	uint32_t q0, q1, q2, q3;
+	uint8_t byte, j;
+
+	while (len--)
+	{
+		byte = *data++;
+		for (j = 0; j < 2; j++)
+		{
+			q3 = (((crc >> 28) ^ (byte >> 3)) & 1) ? 0x04C11DB7 : 0;
+			q2 = (((crc >> 29) ^ (byte >> 2)) & 1) ? 0x09823B6E : 0;
+			q1 = (((crc >> 30) ^ (byte >> 1)) & 1) ? 0x130476DC : 0;
+			q0 = (((crc >> 31) ^ (byte >> 0)) & 1) ? 0x2608EDB8 : 0;
+			crc = (crc << 4) ^ q3 ^ q2 ^ q1 ^ q0;
+			byte >>= 4;
+		}
+	}
+	return crc;
+}
+
+
+/*********************************************************************//**
+ * @brief		Bit serial CRC-16-CCITT
+ **********************************************************************/
+static uint16_t crc16_bitwise (const uint8_t *data, uint32_t len)
+{
+	uint16_t crc = 0;
+	uint8_t x;
+
+	while (len--)
+	{
+		crc ^= (uint16_t)(*data++) << 8;
+		for (x = 0; x < 8; x++)
+		{
+			crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+		}
+	}
+	return crc;
+}
+
+
+/*********************************************************************//**
+ * @brief		Bit serial CRC-7 formerly used by the SD driver
+ **********************************************************************/
+static uint8_t crc7_bitwise (const uint8_t *data, uint32_t len)
+{
+	uint8_t crc = 0, x;
+
+	while (len--)
+	{
+		for (x = 8; x > 0; x--)
+		{
+			crc = (crc << 1) | ((*data >> (x - 1)) & 1);
+			if (crc & 0x80)
+			{
+				crc ^= 0x89;
+			}
+		}
+		data++;
+	}
+	for (x = 0; x < 7; x++)
+	{
+		crc <<= 1;
+		if (crc & 0x80)
+		{
+			crc ^= 0x89;
+		}
+	}
+	return crc;
+}
+
+/**
+ * @}
+ */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @addtogroup CRC_Public_Functions
+ * @{
+ */
+
+/*********************************************************************//**
+ * @brief		Time the table CRCs against the serial code on the host,
+ * 				over one full size Ethernet frame
+ * @param[out]	crc32	CRC-32 result
+ * @param[out]	crc16	CRC-16 result
+ * @param[out]	crc7	CRC-7 result
+ * @return		None
+ **********************************************************************/
+void CRC_Benchmark (CRC_BENCH_Type *crc32, CRC_BENCH_Type *crc16, CRC_BENCH_Type *crc7)
+{
+	volatile uint32_t old_crc = 0, new_crc = 0;
+	uint64_t start;
+	uint32_t i, run;
+
+	for (i = 0; i < CRC_BENCH_BYTES; i++)
+	{
+		crc_bench_buf[i] = (uint8_t)((i * 167) ^ (i >> 3));
+	}
+
+	crc32->Bytes = crc16->Bytes = crc7->Bytes = CRC_BENCH_BYTES * CRC_BENCH_RUNS;
+
+	start = crc_bench_cycles();
+	for (run = 0; run < CRC_BENCH_RUNS; run++)
+		old_crc = crc32_nibble(crc_bench_buf, CRC_BENCH_BYTES);
+	crc32->OldCycles = crc_bench_cycles() - start;
+	start = crc_bench_cycles();
+	for (run = 0; run < CRC_BENCH_RUNS; run++)
+		new_crc = CRC32_Update(CRC32_INIT, crc_bench_buf, CRC_BENCH_BYTES);
+	crc32->NewCycles = crc_bench_cycles() - start;
+	crc32->Match = (old_crc == __RBIT(new_crc)) ? TRUE : FALSE;
+
+	start = crc_bench_cycles();
+	for (run = 0; run < CRC_BENCH_RUNS; run++)
+		old_crc = crc16_bitwise(crc_bench_buf, CRC_BENCH_BYTES);
+	crc16->OldCycles = crc_bench_cycles() - start;
+	start = crc_bench_cycles();
+	for (run = 0; run < CRC_BENCH_RUNS; run++)
+		new_crc = CRC16_Calc(crc_bench_buf, CRC_BENCH_BYTES);
+	crc16->NewCycles = crc_bench_cycles() - start;
+	crc16->Match = (old_crc == new_crc) ? TRUE : FALSE;
+
+	start = crc_bench_cycles();
+	for (run = 0; run < CRC_BENCH_RUNS; run++)
+		old_crc = crc7_bitwise(crc_bench_buf, CRC_BENCH_BYTES);
+	crc7->OldCycles = crc_bench_cycles() - start;
+	start = crc_bench_cycles();
+	for (run = 0; run < CRC_BENCH_RUNS; run++)
+		new_crc = CRC7_Calc(crc_bench_buf, CRC_BENCH_BYTES);
+	crc7->NewCycles = crc_bench_cycles() - start;
+	crc7->Match = (old_crc == new_crc) ? TRUE : FALSE;
+}
+
+/**
+ * @}
+ */
+#endif /* CRC_BENCH_MODE */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
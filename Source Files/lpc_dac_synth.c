@@ -0,0 +1,723 @@
+/******************************************************************//**
+* @file		lpc_dac_synth.c
+* @brief	Contains all functions support for the DAC waveform
+*           synthesis engine: phase accumulator oscillators with
+*           envelopes are mixed into a ping-pong ring that the DMA
+*           feeds to the DAC at the pace of its timeout counter, one
+*           interrupt per half buffer renders the next half and steps
+*           the melody sequencers
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @addtogroup SYNTH
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc_dac_synth.h"
+#include <string.h>
+
+/* If this source file built with example, the LPC17xx FW library configuration
+ * file in each example directory ("lpc17xx_libcfg.h") must be included,
+ * otherwise the default FW library configuration file must be included instead
+ */
+
+/* Private Macros ------------------------------------------------------------- */
+/** @defgroup SYNTH_Private_Macros SYNTH Private Macros
+ * @{
+ */
+
+/** Envelope full scale, Q24 */
+#define SYNTH_ENV_FULL		(1UL << 24)
+
+/** Envelope stages */
+#define SYNTH_ENV_IDLE		0
+#define SYNTH_ENV_ATTACK	1
+#define SYNTH_ENV_DECAY		2
+#define SYNTH_ENV_SUSTAIN	3
+#define SYNTH_ENV_RELEASE	4
+
+/** DAC code of silence */
+#define SYNTH_MID			512
+
+/**
+ * @}
+ */
+
+
+/* Private Types -------------------------------------------------------------- */
+/** @defgroup SYNTH_Private_Types SYNTH Private Types
+ * @{
+ */
+
+typedef struct {
+	SYNTH_VOICE_CFG_Type cfg;
+	/* Oscillator, a phase step of 2^32 is one cycle per sample */
+	uint32_t phase, step;
+	/* Envelope level and per sample slopes in Q24 */
+	uint8_t stage;
+	uint32_t env, sus, att_inc, dec_inc, rel_inc;
+	/* Sequencer, running while seq_count is not 0 */
+	const uint16_t *seq_freq, *seq_dur;
+	uint32_t seq_count, seq_pos;
+	Bool seq_loop, seq_gated;
+	uint32_t seq_left;				/* Samples to the next event */
+	uint32_t seq_tail;				/* Samples between release and the next note */
+} SYNTH_VOICE_T;
+
+/**
+ * @}
+ */
+
+
+/* Private Variables ---------------------------------------------------------- */
+/** One sine cycle in Q15, the extra entry closes the interpolation */
+static const int16_t synth_sine[(1 << SYNTH_SINE_BITS) + 1] =
+{
+	     0,    804,   1608,   2410,   3212,   4011,   4808,   5602,
+	  6393,   7179,   7962,   8739,   9512,  10278,  11039,  11793,
+	 12539,  13279,  14010,  14732,  15446,  16151,  16846,  17530,
+	 18204,  18868,  19519,  20159,  20787,  21403,  22005,  22594,
+	 23170,  23731,  24279,  24811,  25329,  25832,  26319,  26790,
+	 27245,  27683,  28105,  28510,  28898,  29268,  29621,  29956,
+	 30273,  30571,  30852,  31113,  31356,  31580,  31785,  31971,
+	 32137,  32285,  32412,  32521,  32609,  32678,  32728,  32757,
+	 32767,  32757,  32728,  32678,  32609,  32521,  32412,  32285,
+	 32137,  31971,  31785,  31580,  31356,  31113,  30852,  30571,
+	 30273,  29956,  29621,  29268,  28898,  28510,  28105,  27683,
+	 27245,  26790,  26319,  25832,  25329,  24811,  24279,  23731,
+	 23170,  22594,  22005,  21403,  20787,  20159,  19519,  18868,
+	 18204,  17530,  16846,  16151,  15446,  14732,  14010,  13279,
+	 12539,  11793,  11039,  10278,   9512,   8739,   7962,   7179,
+	  6393,   5602,   4808,   4011,   3212,   2410,   1608,    804,
+	     0,   -804,  -1608,  -2410,  -3212,  -4011,  -4808,  -5602,
+	 -6393,  -7179,  -7962,  -8739,  -9512, -10278, -11039, -11793,
+	-12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530,
+	-18204, -18868, -19519, -20159, -20787, -21403, -22005, -22594,
+	-23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790,
+	-27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956,
+	-30273, -30571, -30852, -31113, -31356, -31580, -31785, -31971,
+	-32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+	-32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285,
+	-32137, -31971, -31785, -31580, -31356, -31113, -30852, -30571,
+	-30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683,
+	-27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731,
+	-23170, -22594, -22005, -21403, -20787, -20159, -19519, -18868,
+	-18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+	-12539, -11793, -11039, -10278,  -9512,  -8739,  -7962,  -7179,
+	 -6393,  -5602,  -4808,  -4011,  -3212,  -2410,  -1608,   -804,
+	     0
+};
+
+static SYNTH_VOICE_T synth_voice[SYNTH_VOICES];
+static SYNTH_STATS_Type synth_stats;
+static Bool synth_ready, synth_running;
+static int32_t synth_dma_ch = -1;
+static uint8_t synth_next;				/* Half the next terminal count completes */
+static uint16_t synth_cnt;				/* DAC timeout count per sample */
+static uint32_t synth_bias;				/* DACR bias bit kept in every sample */
+
+/* Ping-pong ring of DACR words read by the DMA, and the mix of one half */
+static uint32_t synth_dma[2 * SYNTH_DMA_HALF];
+static int32_t synth_mix[SYNTH_DMA_HALF];
+static GPDMA_LLI_Type synth_lli[2];
+
+
+/* Private Functions ---------------------------------------------------------- */
+static uint32_t synth_samples(uint32_t ms);
+static void synth_slopes(SYNTH_VOICE_T *v);
+static void synth_attack(SYNTH_VOICE_T *v, uint16_t freq);
+static void synth_release(SYNTH_VOICE_T *v);
+static void synth_seq_next(SYNTH_VOICE_T *v);
+static void synth_osc(SYNTH_VOICE_T *v, int32_t *mix, uint32_t n);
+static void synth_render(SYNTH_VOICE_T *v);
+static void synth_block(uint32_t *out);
+static void synth_halt(void);
+static void synth_dma_done(uint32_t ChannelNum, GPDMA_Status_Type Status);
+
+/*********************************************************************//**
+ * @brief		Convert a time to output samples
+ * @param[in]	ms		Time in ms
+ * @return		Samples, at least 1
+ **********************************************************************/
+static uint32_t synth_samples(uint32_t ms)
+{
+	uint32_t n = (ms * synth_stats.Rate + 500) / 1000;
+
+	return n ? n : 1;
+}
+
+/*********************************************************************//**
+ * @brief		Work out the per sample envelope slopes of a voice, the
+ * 				interrupt only adds and compares
+ * @param[in]	v		Voice
+ * @return		None
+ **********************************************************************/
+static void synth_slopes(SYNTH_VOICE_T *v)
+{
+	v->sus = (SYNTH_ENV_FULL / 255) * v->cfg.Sustain;
+	v->att_inc = SYNTH_ENV_FULL / synth_samples(v->cfg.Attack);
+	v->dec_inc = (SYNTH_ENV_FULL - v->sus) / synth_samples(v->cfg.Decay);
+	v->rel_inc = SYNTH_ENV_FULL / synth_samples(v->cfg.Release);
+	if (v->dec_inc == 0)
+	{
+		v->dec_inc = 1;
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Start a note. The phase runs on and the attack starts
+ * 				from the current level, so a retriggered voice does
+ * 				not click.
+ * @param[in]	v		Voice
+ * @param[in]	freq	Frequency in Hz
+ * @return		None
+ **********************************************************************/
+static void synth_attack(SYNTH_VOICE_T *v, uint16_t freq)
+{
+	v->step = (uint32_t)(((uint64_t)freq << 32) / synth_stats.Rate);
+	v->stage = SYNTH_ENV_ATTACK;
+	synth_stats.Notes++;
+}
+
+/*********************************************************************//**
+ * @brief		Let a sounding note fade out
+ * @param[in]	v		Voice
+ * @return		None
+ **********************************************************************/
+static void synth_release(SYNTH_VOICE_T *v)
+{
+	if (v->stage != SYNTH_ENV_IDLE)
+	{
+		v->stage = SYNTH_ENV_RELEASE;
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Sequencer event: release the gated note or start the
+ * 				next entry of the melody
+ * @param[in]	v		Voice with a running sequence
+ * @return		None
+ **********************************************************************/
+static void synth_seq_next(SYNTH_VOICE_T *v)
+{
+	uint32_t len;
+	uint16_t freq;
+
+	if (v->seq_gated)
+	{
+		synth_release(v);
+		v->seq_gated = FALSE;
+		v->seq_left = v->seq_tail;
+		if (v->seq_left)
+		{
+			return;
+		}
+	}
+	if (v->seq_pos == v->seq_count)
+	{
+		if (!v->seq_loop)
+		{
+			v->seq_count = 0;
+			return;
+		}
+		v->seq_pos = 0;
+	}
+
+	freq = v->seq_freq[v->seq_pos];
+	len = synth_samples(v->seq_dur[v->seq_pos]);
+	v->seq_pos++;
+	if (freq == 0)
+	{
+		// Rest, a note still releasing fades out during it
+		v->seq_left = len;
+		return;
+	}
+	synth_attack(v, freq);
+	v->seq_left = (len * SYNTH_SEQ_GATE) >> 8;
+	if (v->seq_left == 0)
+	{
+		v->seq_left = 1;
+	}
+	v->seq_tail = len - v->seq_left;
+	v->seq_gated = TRUE;
+}
+
+/*********************************************************************//**
+ * @brief		Add n samples of a voice to the mix
+ * @param[in]	v		Voice
+ * @param[in]	mix		Mix accumulator in Q15
+ * @param[in]	n		Number of samples
+ * @return		None
+ **********************************************************************/
+static void synth_osc(SYNTH_VOICE_T *v, int32_t *mix, uint32_t n)
+{
+	uint32_t phase = v->phase, env = v->env, amp, idx;
+	int32_t s, a;
+
+	while (n--)
+	{
+		switch (v->stage)
+		{
+		case SYNTH_ENV_ATTACK:
+			env += v->att_inc;
+			if (env >= SYNTH_ENV_FULL)
+			{
+				env = SYNTH_ENV_FULL;
+				v->stage = SYNTH_ENV_DECAY;
+			}
+			break;
+		case SYNTH_ENV_DECAY:
+			if (env > v->sus + v->dec_inc)
+			{
+				env -= v->dec_inc;
+			}
+			else
+			{
+				env = v->sus;
+				v->stage = SYNTH_ENV_SUSTAIN;
+			}
+			break;
+		case SYNTH_ENV_RELEASE:
+			if (env > v->rel_inc)
+			{
+				env -= v->rel_inc;
+			}
+			else
+			{
+				env = 0;
+				v->stage = SYNTH_ENV_IDLE;
+			}
+			break;
+		default:
+			break;
+		}
+
+		switch (v->cfg.Wave)
+		{
+		case SYNTH_WAVE_SQUARE:
+			s = (phase & 0x80000000UL) ? -32767 : 32767;
+			break;
+		case SYNTH_WAVE_SAW:
+			s = (int32_t)(phase >> 16) - 32768;
+			break;
+		default:
+			// Table entry and linear interpolation on the next 16 phase bits
+			idx = phase >> (32 - SYNTH_SINE_BITS);
+			a = synth_sine[idx];
+			s = a + (((synth_sine[idx + 1] - a) * (int32_t)((phase >> (16 - SYNTH_SINE_BITS)) & 0xFFFF)) >> 16);
+			break;
+		}
+
+		// Envelope to Q16, scaled by the voice level
+		amp = ((env >> 8) * v->cfg.Level) >> 8;
+		*mix++ += (s * (int32_t)amp) >> 16;
+		phase += v->step;
+	}
+	v->phase = phase;
+	v->env = env;
+}
+
+/*********************************************************************//**
+ * @brief		Render one half buffer of a voice, split at the events of
+ * 				its sequencer so notes start and stop on the sample
+ * @param[in]	v		Voice
+ * @return		None
+ **********************************************************************/
+static void synth_render(SYNTH_VOICE_T *v)
+{
+	uint32_t i = 0, n;
+
+	while (i < SYNTH_DMA_HALF)
+	{
+		n = SYNTH_DMA_HALF - i;
+		if (v->seq_count && (v->seq_left < n))
+		{
+			n = v->seq_left;
+		}
+		if (v->stage != SYNTH_ENV_IDLE)
+		{
+			synth_osc(v, &synth_mix[i], n);
+		}
+		i += n;
+		if (v->seq_count)
+		{
+			v->seq_left -= n;
+			if (v->seq_left == 0)
+			{
+				synth_seq_next(v);
+			}
+		}
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Mix all voices into a half of the DMA ring
+ * @param[in]	out		Half buffer of DACR words
+ * @return		None
+ **********************************************************************/
+static void synth_block(uint32_t *out)
+{
+	uint32_t i;
+	int32_t s;
+
+	memset(synth_mix, 0, sizeof(synth_mix));
+	for (i = 0; i < SYNTH_VOICES; i++)
+	{
+		synth_render(&synth_voice[i]);
+	}
+	for (i = 0; i < SYNTH_DMA_HALF; i++)
+	{
+		// Q15 to the 10-bit DAC range around mid scale
+		s = SYNTH_MID + (synth_mix[i] >> 6);
+		if ((s < 0) || (s > 1023))
+		{
+			s = (s < 0) ? 0 : 1023;
+			synth_stats.Clipped++;
+		}
+		out[i] = DAC_VALUE(s) | synth_bias;
+	}
+	synth_stats.Blocks++;
+}
+
+/*********************************************************************//**
+ * @brief		Stop the DAC timer and the DMA, the output rests at mid
+ * 				scale
+ * @param		None
+ * @return		None
+ **********************************************************************/
+static void synth_halt(void)
+{
+	DAC_CONVERTER_CFG_Type ctrl;
+
+	GPDMA_ChannelCmd(synth_dma_ch, DISABLE);
+	memset(&ctrl, 0, sizeof(ctrl));
+	DAC_ConfigDAConverterControl(LPC_DAC, &ctrl);
+	DAC_UpdateValue(LPC_DAC, SYNTH_MID);
+	synth_running = FALSE;
+}
+
+/*********************************************************************//**
+ * @brief		DMA terminal count of a ring half. The source the
+ * 				controller reads tells which half it is playing, the
+ * 				other one is rendered. A half the DMA played again
+ * 				because the interrupt was held off is counted.
+ * @param[in]	ChannelNum	DMA channel
+ * @param[in]	Status		GPDMA_STAT_INTTC or GPDMA_STAT_INTERR
+ * @return		None
+ **********************************************************************/
+static void synth_dma_done(uint32_t ChannelNum, GPDMA_Status_Type Status)
+{
+	uint32_t busy;
+
+	if (Status == GPDMA_STAT_INTERR)
+	{
+		synth_stats.Errors++;
+		synth_halt();
+		return;
+	}
+
+	busy = ((GPDMA_GetSrcAddr(ChannelNum) - GPDMA_BUS_ADDR(synth_dma)) / (SYNTH_DMA_HALF * 4)) & 1;
+	if ((busy ^ 1) != synth_next)
+	{
+		synth_stats.LateBlocks++;
+	}
+	synth_block(&synth_dma[(busy ^ 1) * SYNTH_DMA_HALF]);
+	synth_next = (uint8_t)busy;
+}
+
+/* End of Private Functions --------------------------------------------------- */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @addtogroup SYNTH_Public_Functions
+ * @{
+ */
+
+/*********************************************************************//**
+ * @brief		Set up the DAC on P0.26 (shared with AD0.3), its sample
+ * 				timer and a DMA channel, and reset all voices to a sine
+ * 				with a short attack and release. GPDMA_Init() must have
+ * 				been called.
+ * @param		None
+ * @return		ERROR if no DMA channel is free, SUCCESS otherwise
+ **********************************************************************/
+Status SYNTH_Init(void)
+{
+	SYNTH_VOICE_CFG_Type cfg;
+	uint32_t pclk, cnt, i;
+
+	if (synth_running)
+	{
+		synth_halt();
+	}
+	if (synth_dma_ch < 0)
+	{
+		synth_dma_ch = GPDMA_AllocChannel();
+		if (synth_dma_ch < 0)
+		{
+			return ERROR;
+		}
+	}
+
+	DAC_Config(LPC_DAC);
+	DAC_UpdateValue(LPC_DAC, SYNTH_MID);
+	synth_bias = LPC_DAC->DACR & DAC_BIAS_EN;
+
+	pclk = CLKPWR_GetPCLK(CLKPWR_PCLKSEL_DAC);
+	cnt = (pclk + (SYNTH_RATE / 2)) / SYNTH_RATE;
+	if (cnt > 0xFFFF)
+	{
+		cnt = 0xFFFF;
+	}
+	synth_cnt = (uint16_t)cnt;
+
+	memset(&synth_stats, 0, sizeof(synth_stats));
+	synth_stats.Rate = pclk / cnt;
+	memset(synth_voice, 0, sizeof(synth_voice));
+
+	cfg.Wave = SYNTH_WAVE_SINE;
+	cfg.Level = 255;
+	cfg.Sustain = 255;
+	cfg.Attack = 5;
+	cfg.Decay = 0;
+	cfg.Release = 20;
+	for (i = 0; i < SYNTH_VOICES; i++)
+	{
+		SYNTH_VoiceConfig(i, &cfg);
+	}
+
+	synth_ready = TRUE;
+	return SUCCESS;
+}
+
+/*********************************************************************//**
+ * @brief		Start streaming to the DAC. Both halves of the ring are
+ * 				rendered before the DMA starts.
+ * @param		None
+ * @return		ERROR if SYNTH_Init() was not successful or the DMA
+ * 				channel could not be set up, SUCCESS otherwise
+ **********************************************************************/
+Status SYNTH_Start(void)
+{
+	GPDMA_Channel_CFG_Type dma;
+	DAC_CONVERTER_CFG_Type ctrl;
+	uint32_t primask;
+
+	if (!synth_ready)
+	{
+		return ERROR;
+	}
+	if (synth_running)
+	{
+		return SUCCESS;
+	}
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	synth_block(&synth_dma[0]);
+	synth_block(&synth_dma[SYNTH_DMA_HALF]);
+	__set_PRIMASK(primask);
+
+	dma.ChannelNum = synth_dma_ch;
+	dma.TransferSize = 2 * SYNTH_DMA_HALF;
+	dma.TransferWidth = 0;
+	dma.SrcMemAddr = GPDMA_BUS_ADDR(synth_dma);
+	dma.DstMemAddr = 0;
+	dma.TransferType = GPDMA_TRANSFERTYPE_M2P;
+	dma.SrcConn = 0;
+	dma.DstConn = GPDMA_CONN_DAC;
+	dma.DMALLI = 0;
+	dma.Options = GPDMA_OPT_CIRCULAR;
+	dma.Callback = synth_dma_done;
+	if (GPDMA_SetupRing(&dma, synth_lli, 2) == ERROR)
+	{
+		return ERROR;
+	}
+
+	synth_next = 0;
+	synth_running = TRUE;
+	GPDMA_ChannelCmd(synth_dma_ch, ENABLE);
+
+	// Double buffered DACR: each sample reaches AOUT on a timeout, free of jitter
+	DAC_SetDMATimeOut(LPC_DAC, synth_cnt);
+	ctrl.DBLBUF_ENA = 1;
+	ctrl.CNT_ENA = 1;
+	ctrl.DMA_ENA = 1;
+	ctrl.RESERVED = 0;
+	DAC_ConfigDAConverterControl(LPC_DAC, &ctrl);
+	return SUCCESS;
+}
+
+/*********************************************************************//**
+ * @brief		Stop streaming, voices and sequencers hold where they are
+ * @param		None
+ * @return		None
+ **********************************************************************/
+void SYNTH_Stop(void)
+{
+	if (synth_running)
+	{
+		synth_halt();
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Set waveform, level and envelope of a voice, after
+ * 				SYNTH_Init(). A sounding note takes the new settings.
+ * @param[in]	voice	Voice 0 .. SYNTH_VOICES-1
+ * @param[in]	cfg		Voice configuration, copied
+ * @return		None
+ **********************************************************************/
+void SYNTH_VoiceConfig(uint8_t voice, SYNTH_VOICE_CFG_Type *cfg)
+{
+	SYNTH_VOICE_T *v;
+	uint32_t primask;
+
+	if (voice >= SYNTH_VOICES)
+	{
+		return;
+	}
+	v = &synth_voice[voice];
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	v->cfg = *cfg;
+	synth_slopes(v);
+	__set_PRIMASK(primask);
+}
+
+/*********************************************************************//**
+ * @brief		Start a note on a voice, a running sequence of the voice
+ * 				is cancelled. The note sounds until SYNTH_NoteOff().
+ * @param[in]	voice	Voice 0 .. SYNTH_VOICES-1
+ * @param[in]	freq	Frequency in Hz, below SYNTH_RATE / 2; 0 releases
+ * @return		None
+ **********************************************************************/
+void SYNTH_NoteOn(uint8_t voice, uint16_t freq)
+{
+	SYNTH_VOICE_T *v;
+	uint32_t primask;
+
+	if (voice >= SYNTH_VOICES)
+	{
+		return;
+	}
+	v = &synth_voice[voice];
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	v->seq_count = 0;
+	if (freq)
+	{
+		synth_attack(v, freq);
+	}
+	else
+	{
+		synth_release(v);
+	}
+	__set_PRIMASK(primask);
+}
+
+/*********************************************************************//**
+ * @brief		Release the note of a voice
+ * @param[in]	voice	Voice 0 .. SYNTH_VOICES-1
+ * @return		None
+ **********************************************************************/
+void SYNTH_NoteOff(uint8_t voice)
+{
+	SYNTH_NoteOn(voice, 0);
+}
+
+/*********************************************************************//**
+ * @brief		Play a melody on a voice without waiting for it. Each
+ * 				note sounds for SYNTH_SEQ_GATE/256 of its duration and
+ * 				is released for the rest, timing is sample accurate.
+ * @param[in]	voice	Voice 0 .. SYNTH_VOICES-1
+ * @param[in]	freq	Note frequencies in Hz, 0 is a rest
+ * @param[in]	dur		Note durations in ms
+ * @param[in]	count	Number of notes, both tables must stay valid
+ * 						while the melody plays
+ * @param[in]	loop	TRUE to repeat the melody until SYNTH_Cancel()
+ * @return		ERROR if voice or count is out of range, SUCCESS otherwise
+ **********************************************************************/
+Status SYNTH_Play(uint8_t voice, const uint16_t *freq, const uint16_t *dur, uint32_t count, Bool loop)
+{
+	SYNTH_VOICE_T *v;
+	uint32_t primask;
+
+	if ((voice >= SYNTH_VOICES) || (count == 0))
+	{
+		return ERROR;
+	}
+	v = &synth_voice[voice];
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	v->seq_freq = freq;
+	v->seq_dur = dur;
+	v->seq_count = count;
+	v->seq_pos = 0;
+	v->seq_loop = loop;
+	v->seq_gated = FALSE;
+	synth_seq_next(v);
+	__set_PRIMASK(primask);
+	return SUCCESS;
+}
+
+/*********************************************************************//**
+ * @brief		Stop the melody of a voice and release its note
+ * @param[in]	voice	Voice 0 .. SYNTH_VOICES-1
+ * @return		None
+ **********************************************************************/
+void SYNTH_Cancel(uint8_t voice)
+{
+	SYNTH_NoteOff(voice);
+}
+
+/*********************************************************************//**
+ * @brief		Check whether a voice is still sounding
+ * @param[in]	voice	Voice 0 .. SYNTH_VOICES-1
+ * @return		TRUE while its melody runs or its last note has not
+ * 				faded out, FALSE otherwise
+ **********************************************************************/
+Bool SYNTH_Playing(uint8_t voice)
+{
+	SYNTH_VOICE_T *v;
+
+	if (voice >= SYNTH_VOICES)
+	{
+		return FALSE;
+	}
+	v = &synth_voice[voice];
+	return (v->seq_count || (v->stage != SYNTH_ENV_IDLE)) ? TRUE : FALSE;
+}
+
+/*********************************************************************//**
+ * @brief		Get the engine counters
+ * @param[out]	stats	Copy of the counters
+ * @return		None
+ **********************************************************************/
+void SYNTH_GetStats(SYNTH_STATS_Type *stats)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	*stats = synth_stats;
+	__set_PRIMASK(primask);
+}
+
+/**
+ * @}
+ */
+
+/* End of Public Functions ---------------------------------------------------- */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -0,0 +1,519 @@
+/******************************************************************//**
+* @file		lpc_dc_motor.c
+* @brief	Contains all functions support for the DC motor control
+* 			loop on LPC17xx
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @addtogroup DC_MOTOR
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc_system_init.h"
+#include "lpc_dc_motor.h"
+
+/* If this source file built with example, the LPC17xx FW library configuration
+ * file in each example directory ("lpc17xx_libcfg.h") must be included,
+ * otherwise the default FW library configuration file must be included instead
+ */
+
+/* Private Macros ------------------------------------------------------------- */
+/** @defgroup DC_MOTOR_Private_Macros DC_MOTOR Private Macros
+ * @{
+ */
+
+#define DCM_VEL_MASK			(DCM_VEL_WINDOW - 1)
+/** Pulse width of standstill, half the period */
+#define DCM_PWM_HALF			(DCM_PWM_PERIOD / 2)
+
+/**
+ * @}
+ */
+
+
+/* Private Types -------------------------------------------------------------- */
+/** @defgroup DC_MOTOR_Private_Types DC_MOTOR Private Types
+ * @{
+ */
+
+/** One PID loop: gains, integrator with 16 fraction bits below the Q15
+ * output and the last measurement for the derivative */
+typedef struct {
+	DCM_PID_CFG_Type cfg;
+	int32_t integ;
+	int32_t meas;
+	Bool sat;
+} DCM_PID_Type;
+
+/**
+ * @}
+ */
+
+
+/* Private Variables ---------------------------------------------------------- */
+static DCM_PID_Type dcm_speed_pid, dcm_pos_pid;
+/** MCPWM channel 0 set up, the pulse width is rewritten every sample */
+static MCPWM_CHANNEL_CFG_Type dcm_ch;
+
+/** Positions of the last DCM_VEL_WINDOW samples */
+static uint32_t dcm_hist[DCM_VEL_WINDOW];
+static uint32_t dcm_hi;
+
+static volatile uint8_t dcm_mode;
+static uint8_t dcm_div;
+/** References: duty in open loop, speed and position target */
+static volatile int32_t dcm_duty, dcm_ref, dcm_target;
+/** Measurements: counts over the window, Q15 speed and position */
+static volatile int32_t dcm_cnt, dcm_speed, dcm_pos;
+
+static DCM_STATS_Type dcm_stats;
+
+
+/* Private Functions ---------------------------------------------------------- */
+static int32_t dcm_pid (DCM_PID_Type *pid, int32_t ref, int32_t meas);
+static void dcm_pid_reset (DCM_PID_Type *pid, int32_t meas);
+static void dcm_write (int32_t duty);
+static void dcm_mode_set (uint8_t mode);
+
+/*********************************************************************//**
+ * @brief		One PID step
+ * @param[in]	pid: loop
+ * @param[in]	ref: reference
+ * @param[in]	meas: measurement
+ * @return 		Output, -OutMax..OutMax
+ **********************************************************************/
+static int32_t dcm_pid (DCM_PID_Type *pid, int32_t ref, int32_t meas)
+{
+	const DCM_PID_CFG_Type *k = &pid->cfg;
+	int32_t e = ref - meas;
+	int64_t lim = (int64_t)k->OutMax << 16;
+	int64_t u, i;
+
+	// Feed-forward, the friction offset takes the sign of the reference
+	u = ((int64_t)k->Kff * ref) >> 15;
+	if (ref > 0)
+	{
+		u += k->Offset;
+	}
+	else if (ref < 0)
+	{
+		u -= k->Offset;
+	}
+	u += ((int64_t)k->Kp * e) >> 15;
+	// Derivative on the measurement, a reference step does not kick it
+	u -= ((int64_t)k->Kd * (meas - pid->meas)) >> 15;
+	pid->meas = meas;
+
+	// Anti-windup: the integrator stays inside the output span and holds
+	// while the output is on a limit the error pushes it further into
+	i = pid->integ + (((int64_t)k->Ki * e) >> 15);
+	if (i > lim)
+	{
+		i = lim;
+	}
+	else if (i < -lim)
+	{
+		i = -lim;
+	}
+	u += i >> 16;
+	pid->sat = TRUE;
+	if (u > k->OutMax)
+	{
+		u = k->OutMax;
+		if (e > 0)
+		{
+			i = pid->integ;
+		}
+	}
+	else if (u < -k->OutMax)
+	{
+		u = -k->OutMax;
+		if (e < 0)
+		{
+			i = pid->integ;
+		}
+	}
+	else
+	{
+		pid->sat = FALSE;
+	}
+	pid->integ = (int32_t)i;
+
+	return (int32_t)u;
+}
+
+
+/*********************************************************************//**
+ * @brief		Clear the integrator and take up the measurement, so the
+ * 				loop starts without a derivative step
+ * @param[in]	pid: loop
+ * @param[in]	meas: current measurement
+ * @return 		None
+ **********************************************************************/
+static void dcm_pid_reset (DCM_PID_Type *pid, int32_t meas)
+{
+	pid->integ = 0;
+	pid->meas = meas;
+	pid->sat = FALSE;
+}
+
+
+/*********************************************************************//**
+ * @brief		Write a duty to the MCPWM shadow registers, it takes
+ * 				effect at the end of the running PWM period
+ * @param[in]	duty: Q15 duty, -32768 full reverse to 32767 full forward
+ * @return 		None
+ **********************************************************************/
+static void dcm_write (int32_t duty)
+{
+	dcm_ch.channelPulsewidthValue = DCM_PWM_HALF + ((duty * DCM_PWM_HALF) >> 15);
+	MCPWM_WriteToShadow(LPC_MCPWM, 0, &dcm_ch);
+}
+
+
+/*********************************************************************//**
+ * @brief		Change the control mode. Loops coming into use start from
+ * 				the current measurement, the bridge starts at standstill
+ * 				duty. Called with the QEI interrupt held off.
+ * @param[in]	mode: DCM_MODE_xxx
+ * @return 		None
+ **********************************************************************/
+static void dcm_mode_set (uint8_t mode)
+{
+	if (mode == dcm_mode)
+	{
+		return;
+	}
+	if ((mode >= DCM_MODE_SPEED) && (dcm_mode < DCM_MODE_SPEED))
+	{
+		dcm_pid_reset(&dcm_speed_pid, dcm_speed);
+	}
+	if (mode == DCM_MODE_POSITION)
+	{
+		dcm_pid_reset(&dcm_pos_pid, 0);
+		dcm_div = DCM_POS_DIV - 1;
+	}
+	if (mode == DCM_MODE_OFF)
+	{
+		MCPWM_Stop(LPC_MCPWM, ENABLE, DISABLE, DISABLE);
+	}
+	else if (dcm_mode == DCM_MODE_OFF)
+	{
+		dcm_write(0);
+		MCPWM_Start(LPC_MCPWM, ENABLE, DISABLE, DISABLE);
+	}
+	dcm_mode = mode;
+}
+
+/* End of Private Functions --------------------------------------------------- */
+
+
+/** @addtogroup DC_MOTOR_Public_Functions
+ * @{
+ */
+
+/* Public Functions ----------------------------------------------------------- */
+/*********************************************************************//**
+ * @brief		Initialize the bridge drive on MCPWM channel 0 (stopped)
+ * 				and the QEI with its velocity timer at DCM_LOOP_HZ. The
+ * 				loop measures from then on, gains are all zero until
+ * 				DCM_SetGains().
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void DCM_Init (void)
+{
+	static const DCM_PID_CFG_Type none = { 0, 0, 0, 0, 0, 0 };
+	PINSEL_CFG_Type pin;
+	QEI_RELOADCFG_Type reload;
+	uint32_t n;
+
+	NVIC_DisableIRQ(QEI_IRQn);
+	dcm_mode = DCM_MODE_OFF;
+	dcm_speed_pid.cfg = none;
+	dcm_pos_pid.cfg = none;
+
+	// P1.19 MCOA0 and P1.22 MCOB0
+	pin.Funcnum = 1;
+	pin.OpenDrain = 0;
+	pin.Pinmode = 0;
+	pin.Portnum = 1;
+	pin.Pinnum = 19;
+	PINSEL_ConfigPin(&pin);
+	pin.Pinnum = 22;
+	PINSEL_ConfigPin(&pin);
+
+	// Edge aligned, MCOA0 high for the pulse width, MCOB0 its complement
+	// with dead time. New widths are taken at the end of each period.
+	MCPWM_Init(LPC_MCPWM);
+	dcm_ch.channelType = MCPWM_CHANNEL_EDGE_MODE;
+	dcm_ch.channelPolarity = MCPWM_CHANNEL_PASSIVE_HI;
+	dcm_ch.channelDeadtimeEnable = ENABLE;
+	dcm_ch.channelDeadtimeValue = DCM_DEADTIME;
+	dcm_ch.channelUpdateEnable = ENABLE;
+	dcm_ch.channelTimercounterValue = 0;
+	dcm_ch.channelPeriodValue = DCM_PWM_PERIOD - 1;
+	dcm_ch.channelPulsewidthValue = DCM_PWM_HALF;
+	MCPWM_ConfigChannel(LPC_MCPWM, 0, &dcm_ch);
+
+	// Free running position count, the velocity timer paces the loop
+	QEI_Config();
+	QEI_SetMaxPosition(LPC_QEI, 0xFFFFFFFF);
+	reload.ReloadOption = QEI_TIMERRELOAD_TICKVAL;
+	reload.ReloadValue = DCM_QEI_PCLK_HZ / DCM_LOOP_HZ;
+	QEI_SetTimerReload(LPC_QEI, &reload);
+	QEI_Reset(LPC_QEI, QEI_RESET_VEL);
+
+	dcm_hi = 0;
+	dcm_pos = (int32_t)QEI_GetPosition(LPC_QEI);
+	for (n = 0; n < DCM_VEL_WINDOW; n++)
+	{
+		dcm_hist[n] = (uint32_t)dcm_pos;
+	}
+	dcm_cnt = 0;
+	dcm_speed = 0;
+
+	QEI_IntClear(LPC_QEI, QEI_INTFLAG_TIM_Int);
+	NVIC_SetPriority(QEI_IRQn, 1);
+	NVIC_EnableIRQ(QEI_IRQn);
+}
+
+
+/*********************************************************************//**
+ * @brief		Set the gains of a loop
+ * @param[in]	loop: DCM_LOOP_SPEED or DCM_LOOP_POSITION
+ * @param[in]	cfg: gains, copied
+ * @return 		SUCCESS, or ERROR if the loop or output limit is invalid
+ **********************************************************************/
+Status DCM_SetGains (uint8_t loop, const DCM_PID_CFG_Type *cfg)
+{
+	DCM_PID_Type *pid;
+	uint32_t primask;
+
+	if ((loop > DCM_LOOP_POSITION) || (cfg->OutMax < 0) || (cfg->OutMax > 32767))
+	{
+		return ERROR;
+	}
+	pid = (loop == DCM_LOOP_SPEED) ? &dcm_speed_pid : &dcm_pos_pid;
+	primask = __get_PRIMASK();
+	__disable_irq();
+	pid->cfg = *cfg;
+	__set_PRIMASK(primask);
+
+	return SUCCESS;
+}
+
+
+/*********************************************************************//**
+ * @brief		Drive the bridge open loop
+ * @param[in]	duty: Q15 duty, negative reverses
+ * @return 		None
+ **********************************************************************/
+void DCM_SetDuty (int32_t duty)
+{
+	uint32_t primask;
+
+	if (duty > 32767)
+	{
+		duty = 32767;
+	}
+	else if (duty < -32767)
+	{
+		duty = -32767;
+	}
+	primask = __get_PRIMASK();
+	__disable_irq();
+	dcm_duty = duty;
+	dcm_mode_set(DCM_MODE_OPEN);
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		Run the speed loop
+ * @param[in]	rpm: speed, negative reverses. Limited to DCM_RPM_MAX.
+ * @return 		None
+ **********************************************************************/
+void DCM_SetSpeed (int32_t rpm)
+{
+	uint32_t primask;
+
+	if (rpm > DCM_RPM_MAX)
+	{
+		rpm = DCM_RPM_MAX;
+	}
+	else if (rpm < -DCM_RPM_MAX)
+	{
+		rpm = -DCM_RPM_MAX;
+	}
+	primask = __get_PRIMASK();
+	__disable_irq();
+	dcm_ref = DCM_RPM(rpm);
+	if (dcm_ref > 32767)
+	{
+		dcm_ref = 32767;
+	}
+	dcm_mode_set(DCM_MODE_SPEED);
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		Run the position loop, which sets the speed reference
+ * @param[in]	pos: target position, QEI counts
+ * @return 		None
+ **********************************************************************/
+void DCM_SetPosition (int32_t pos)
+{
+	uint32_t primask;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	dcm_target = pos;
+	dcm_mode_set(DCM_MODE_POSITION);
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		Stop the bridge, both outputs go to their passive state
+ * 				and the motor coasts
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void DCM_Stop (void)
+{
+	uint32_t primask;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	dcm_mode_set(DCM_MODE_OFF);
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		Get the control mode
+ * @param[in]	None
+ * @return 		DCM_MODE_xxx
+ **********************************************************************/
+uint8_t DCM_GetMode (void)
+{
+	return dcm_mode;
+}
+
+
+/*********************************************************************//**
+ * @brief		Get the measured speed
+ * @param[in]	None
+ * @return 		Speed over the last DCM_VEL_WINDOW samples (RPM)
+ **********************************************************************/
+int32_t DCM_GetSpeed (void)
+{
+	return (int32_t)(((int64_t)dcm_cnt * DCM_RPM_K) >> 16);
+}
+
+
+/*********************************************************************//**
+ * @brief		Get the position at the last sample
+ * @param[in]	None
+ * @return 		Position, QEI counts
+ **********************************************************************/
+int32_t DCM_GetPosition (void)
+{
+	return dcm_pos;
+}
+
+
+/*********************************************************************//**
+ * @brief		Velocity timer interrupt, called from QEI_IRQHandler:
+ * 				measure, run the loops of the mode and write the duty to
+ * 				the MCPWM shadow registers. Its run time is taken from
+ * 				SysTick, which counts CPU cycles.
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void DCM_IntHandler (void)
+{
+	uint32_t t0 = SysTick->VAL;
+	uint32_t pos, t1;
+	int32_t duty;
+
+	if (QEI_GetIntStatus(LPC_QEI, QEI_INTFLAG_TIM_Int) == RESET)
+	{
+		return;
+	}
+	QEI_IntClear(LPC_QEI, QEI_INTFLAG_TIM_Int);
+
+	// Speed from the position moved over the window, scaled by a
+	// multiply: no divide and no direction bookkeeping
+	pos = QEI_GetPosition(LPC_QEI);
+	dcm_cnt = (int32_t)(pos - dcm_hist[dcm_hi]);
+	dcm_hist[dcm_hi] = pos;
+	dcm_hi = (dcm_hi + 1) & DCM_VEL_MASK;
+	dcm_pos = (int32_t)pos;
+	dcm_speed = (int32_t)(((int64_t)dcm_cnt * DCM_SPEED_K) >> 16);
+	dcm_stats.Samples++;
+
+	switch (dcm_mode)
+	{
+	case DCM_MODE_POSITION:
+		if (++dcm_div >= DCM_POS_DIV)
+		{
+			dcm_div = 0;
+			dcm_ref = dcm_pid(&dcm_pos_pid, 0, (int32_t)(pos - (uint32_t)dcm_target));
+		}
+		// Fall through - the position loop feeds the speed loop
+	case DCM_MODE_SPEED:
+		duty = dcm_pid(&dcm_speed_pid, dcm_ref, dcm_speed);
+		if (dcm_speed_pid.sat == TRUE)
+		{
+			dcm_stats.Saturated++;
+		}
+		dcm_write(duty);
+		break;
+	case DCM_MODE_OPEN:
+		dcm_write(dcm_duty);
+		break;
+	default:
+		break;
+	}
+
+	t1 = SysTick->VAL;
+	t1 = (t0 >= t1) ? (t0 - t1) : (t0 + (SysTick->LOAD & 0x00FFFFFF) + 1 - t1);
+	if (t1 > dcm_stats.MaxCycles)
+	{
+		dcm_stats.MaxCycles = t1;
+	}
+	if (t1 > DCM_CYCLE_BUDGET)
+	{
+		dcm_stats.OverBudget++;
+	}
+}
+
+
+/*********************************************************************//**
+ * @brief		Get the loop counters
+ * @param[out]	stats: pointer to DCM_STATS_Type
+ * @return 		None
+ **********************************************************************/
+void DCM_GetStats (DCM_STATS_Type *stats)
+{
+	*stats = dcm_stats;
+}
+
+/**
+ * @}
+ */
+
+/* End of Public Functions ---------------------------------------------------- */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
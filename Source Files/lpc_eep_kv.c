@@ -0,0 +1,517 @@
+/******************************************************************//**
+* @file		lpc_eep_kv.c
+* @brief	Contains all functions support for the log structured
+*           key/value store on the serial E2PROMs
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @addtogroup KV
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc_eep_kv.h"
+#include "lpc_crc.h"
+#include <string.h>
+
+/* If this source file built with example, the LPC17xx FW library configuration
+ * file in each example directory ("lpc17xx_libcfg.h") must be included,
+ * otherwise the default FW library configuration file must be included instead
+ */
+
+/* Private Macros ------------------------------------------------------------- */
+/** @defgroup KV_Private_Macros KV Private Macros
+ * @{
+ */
+
+#define KV_MAGIC0			'K'
+#define KV_MAGIC1			'V'
+
+/** Little endian fields of headers and records */
+#define KV_LD32(p)			((uint32_t)(p)[0] | ((uint32_t)(p)[1] << 8) | \
+							 ((uint32_t)(p)[2] << 16) | ((uint32_t)(p)[3] << 24))
+
+/** Segment of a store offset, and store offset of a segment */
+#define KV_SEG_OF(kv, ofs)	((ofs) / (kv)->SegSize)
+#define KV_SEG_OFS(kv, s)	((uint32_t)(s) * (kv)->SegSize)
+
+/** Value bytes of a record with length field len */
+#define KV_LEN(len)			(((len) == KV_TOMBSTONE) ? 0 : (len))
+
+/**
+ * @}
+ */
+
+
+/* Private Variables ---------------------------------------------------------- */
+/** Segment scanned by KV_Mount(), record read back or copied */
+static uint8_t kv_buf[KV_SEG_MAX];
+/** Record being appended */
+static uint8_t kv_rec[KV_REC_SIZE(KV_VALUE_MAX)];
+
+
+/* Private Functions ---------------------------------------------------------- */
+/*********************************************************************//**
+ * @brief		Store a little endian word
+ * @param[in]	- p: destination
+ * 				- val: value
+ * @return 		None
+ **********************************************************************/
+static void kv_st32 (uint8_t *p, uint32_t val)
+{
+	p[0] = (uint8_t)val;
+	p[1] = (uint8_t)(val >> 8);
+	p[2] = (uint8_t)(val >> 16);
+	p[3] = (uint8_t)(val >> 24);
+}
+
+
+/*********************************************************************//**
+ * @brief		CRC of a header or record, seeded with the sequence
+ * 				number of its segment
+ * @param[in]	- seq: segment sequence number
+ * 				- data: bytes before the CRC field
+ * 				- len: number of bytes
+ * @return 		CRC32
+ **********************************************************************/
+static uint32_t kv_crc (uint32_t seq, const uint8_t *data, uint32_t len)
+{
+	uint8_t s[4];
+
+	kv_st32(s, seq);
+	return ~CRC32_Update(CRC32_Update(CRC32_INIT, s, 4), data, len);
+}
+
+
+/*********************************************************************//**
+ * @brief		Check a record
+ * @param[in]	- seq: sequence number of its segment
+ * 				- p: record
+ * 				- room: bytes up to the end of the segment
+ * @return 		Record size, 0 when p holds no valid record
+ **********************************************************************/
+static uint32_t kv_check (uint32_t seq, const uint8_t *p, uint32_t room)
+{
+	uint32_t n;
+
+	if (room < KV_REC_SIZE(0)) return 0;
+	if (p[0] >= KV_MAX_KEYS) return 0;
+	if ((p[1] > KV_VALUE_MAX) && (p[1] != KV_TOMBSTONE)) return 0;
+	n = KV_LEN(p[1]);
+	if (KV_REC_SIZE(n) > room) return 0;
+	if (kv_crc(seq, p, 2 + n) != KV_LD32(p + 2 + n)) return 0;
+	return KV_REC_SIZE(n);
+}
+
+
+/*********************************************************************//**
+ * @brief		Check the store geometry against its part
+ * @param[in]	- kv: store
+ * @return 		TRUE when usable
+ **********************************************************************/
+static Bool kv_geometry (KV_STORE_Type *kv)
+{
+	if ((kv->NumSegs < 3) || (kv->NumSegs > KV_MAX_SEGS)) return FALSE;
+	if ((kv->SegSize > KV_SEG_MAX) || (kv->SegSize % kv->Dev->PageSize)) return FALSE;
+	if (kv->SegSize < KV_SEG_HDR + KV_REC_SIZE(KV_VALUE_MAX)) return FALSE;
+	return (kv->Base + KV_SEG_OFS(kv, kv->NumSegs) <= kv->Dev->Size) ? TRUE : FALSE;
+}
+
+
+/*********************************************************************//**
+ * @brief		Empty the index
+ * @param[in]	- kv: store
+ * @return 		None
+ **********************************************************************/
+static void kv_clear (KV_STORE_Type *kv)
+{
+	uint32_t i;
+
+	for (i = 0; i < KV_MAX_KEYS; i++)
+	{
+		kv->index[i].Addr = KV_NONE;
+		kv->index[i].Len = 0;
+	}
+	memset(kv->live, 0, sizeof(kv->live));
+}
+
+
+/*********************************************************************//**
+ * @brief		Point the index at the newest record of a key and move
+ * 				its size between the live counts of the segments
+ * @param[in]	- kv: store
+ * 				- key: key
+ * 				- ofs: store offset of the record
+ * 				- len: length field of the record
+ * @return 		None
+ **********************************************************************/
+static void kv_index (KV_STORE_Type *kv, uint8_t key, uint32_t ofs, uint8_t len)
+{
+	KV_INDEX_Type *e = &kv->index[key];
+
+	if (e->Addr != KV_NONE)
+	{
+		kv->live[KV_SEG_OF(kv, e->Addr)] -= KV_REC_SIZE(KV_LEN(e->Len));
+	}
+	e->Addr = (uint16_t)ofs;
+	e->Len = len;
+	kv->live[KV_SEG_OF(kv, ofs)] += KV_REC_SIZE(KV_LEN(len));
+}
+
+
+/*********************************************************************//**
+ * @brief		Sum of the live counts
+ * @param[in]	- kv: store
+ * @return 		Bytes held by the newest record of every key
+ **********************************************************************/
+static uint32_t kv_used (KV_STORE_Type *kv)
+{
+	uint32_t i, used = 0;
+
+	for (i = 0; i < kv->NumSegs; i++)
+	{
+		used += kv->live[i];
+	}
+	return used;
+}
+
+
+/*********************************************************************//**
+ * @brief		Write a record at the append offset of the head segment
+ * @param[in]	- kv: store
+ * 				- key: key
+ * 				- data: value, may be NULL for a delete record
+ * 				- len: length field, KV_TOMBSTONE for a delete record
+ * @return 		KV_OK or KV_ERROR_DISK
+ * Note: The caller checked that the record fits the segment.
+ **********************************************************************/
+static kv_error kv_put (KV_STORE_Type *kv, uint8_t key, const uint8_t *data, uint8_t len)
+{
+	uint32_t n = KV_LEN(len);
+	uint32_t ofs = KV_SEG_OFS(kv, kv->head) + kv->fill;
+
+	kv_rec[0] = key;
+	kv_rec[1] = len;
+	if (n) memcpy(kv_rec + 2, data, n);
+	kv_st32(kv_rec + 2 + n, kv_crc(kv->seq[kv->head], kv_rec, 2 + n));
+	if (EEPW_Write(kv->Dev, kv->Base + ofs, kv_rec, KV_REC_SIZE(n), FALSE) != SUCCESS)
+	{
+		return KV_ERROR_DISK;
+	}
+	kv_index(kv, key, ofs, len);
+	kv->fill += KV_REC_SIZE(n);
+	kv->Stats.Records++;
+	kv->Stats.Bytes += KV_REC_SIZE(n);
+	return KV_OK;
+}
+
+
+/*********************************************************************//**
+ * @brief		Copy the live records of a segment to the head segment
+ * @param[in]	- kv: store
+ * 				- seg: segment to empty
+ * @return 		KV_OK, KV_ERROR_DISK or KV_ERROR_FULL
+ **********************************************************************/
+static kv_error kv_compact (KV_STORE_Type *kv, uint8_t seg)
+{
+	KV_INDEX_Type *e;
+	kv_error rc;
+	uint32_t key, n;
+
+	for (key = 0; key < KV_MAX_KEYS; key++)
+	{
+		e = &kv->index[key];
+		if ((e->Addr == KV_NONE) || (KV_SEG_OF(kv, e->Addr) != seg)) continue;
+
+		// Delete records are copied too, an older record of the key
+		// may still sit in a segment that was emptied but not reused
+		n = KV_LEN(e->Len);
+		if (kv->fill + KV_REC_SIZE(n) > kv->SegSize) return KV_ERROR_FULL;
+		if (n && (EEPW_Read(kv->Dev, kv->Base + e->Addr + 2, kv_buf, n) != SUCCESS))
+		{
+			return KV_ERROR_DISK;
+		}
+		rc = kv_put(kv, (uint8_t)key, kv_buf, e->Len);
+		if (rc != KV_OK) return rc;
+		kv->Stats.Copied++;
+	}
+	kv->Stats.Compactions++;
+	return KV_OK;
+}
+
+
+/*********************************************************************//**
+ * @brief		Start the next segment of the ring and empty the one
+ * 				after it, so there is always a free segment to move to
+ * @param[in]	- kv: store
+ * @return 		KV_OK, KV_ERROR_DISK or KV_ERROR_FULL
+ **********************************************************************/
+static kv_error kv_open (KV_STORE_Type *kv)
+{
+	uint8_t next = (kv->head + 1) % kv->NumSegs;
+	uint8_t hdr[KV_SEG_HDR];
+	uint32_t seq = kv->seq[kv->head] + 1;
+
+	if (kv->live[next]) return KV_ERROR_FULL;
+
+	// A reused segment keeps its old records, they fail the CRC
+	// from here on as it is seeded with the new sequence number
+	hdr[0] = KV_MAGIC0;
+	hdr[1] = KV_MAGIC1;
+	kv_st32(hdr + 2, seq);
+	kv_st32(hdr + 6, kv_crc(seq, hdr, 6));
+	if (EEPW_Write(kv->Dev, kv->Base + KV_SEG_OFS(kv, next), hdr, KV_SEG_HDR, FALSE) != SUCCESS)
+	{
+		return KV_ERROR_DISK;
+	}
+	kv->seq[next] = seq;
+	kv->head = next;
+	kv->fill = KV_SEG_HDR;
+	kv->Stats.Segments++;
+
+	next = (next + 1) % kv->NumSegs;
+	return kv->live[next] ? kv_compact(kv, next) : KV_OK;
+}
+
+
+/*********************************************************************//**
+ * @brief		Append a record, moving on through the ring as needed
+ * @param[in]	- kv: store
+ * 				- key: key
+ * 				- data: value
+ * 				- len: length field, KV_TOMBSTONE for a delete record
+ * @return 		KV_OK, KV_ERROR_DISK or KV_ERROR_FULL
+ **********************************************************************/
+static kv_error kv_append (KV_STORE_Type *kv, uint8_t key, const uint8_t *data, uint8_t len)
+{
+	uint8_t next = (kv->head + 1) % kv->NumSegs;
+	uint32_t size = KV_REC_SIZE(KV_LEN(len));
+	uint32_t tries = 0;
+	kv_error rc;
+
+	// Finish a compaction cut short by a reset or a bus error first,
+	// it needs the head room the new record would take
+	if (kv->live[next])
+	{
+		rc = kv_compact(kv, next);
+		if (rc != KV_OK) return rc;
+	}
+	while (kv->fill + size > kv->SegSize)
+	{
+		if (++tries > kv->NumSegs) return KV_ERROR_FULL;
+		rc = kv_open(kv);
+		if (rc != KV_OK) return rc;
+	}
+	return kv_put(kv, key, data, len);
+}
+
+/* End of Private Functions --------------------------------------------------- */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @addtogroup KV_Public_Functions
+ * @{
+ */
+
+/*********************************************************************//**
+ * @brief		Erase the store area and start an empty store
+ * @param[in]	kv: store set up with KV_STORE()
+ * @return 		KV_OK, KV_ERROR_DISK or KV_ERROR_PARAM
+ * Note: Every segment is overwritten once, old records cannot come back.
+ **********************************************************************/
+kv_error KV_Format (KV_STORE_Type *kv)
+{
+	kv_error rc;
+	uint32_t s;
+
+	kv->mounted = FALSE;
+	if (!kv_geometry(kv)) return KV_ERROR_PARAM;
+
+	memset(kv_buf, 0xFF, kv->SegSize);
+	for (s = 0; s < kv->NumSegs; s++)
+	{
+		if (EEPW_Write(kv->Dev, kv->Base + KV_SEG_OFS(kv, s), kv_buf, kv->SegSize, FALSE) != SUCCESS)
+		{
+			return KV_ERROR_DISK;
+		}
+	}
+	memset(kv->seq, 0, sizeof(kv->seq));
+	kv_clear(kv);
+	kv->head = kv->NumSegs - 1;
+	rc = kv_open(kv);
+	if (rc == KV_OK) kv->mounted = TRUE;
+	return rc;
+}
+
+
+/*********************************************************************//**
+ * @brief		Mount the store, the RAM index is built by replaying the
+ * 				records of every segment from oldest to newest. A record
+ * 				torn by a reset ends its segment, the key keeps the
+ * 				value of its previous record.
+ * @param[in]	kv: store set up with KV_STORE()
+ * @return 		KV_OK, KV_ERROR_DISK, KV_ERROR_PARAM or KV_ERROR_NO_STORE
+ **********************************************************************/
+kv_error KV_Mount (KV_STORE_Type *kv)
+{
+	uint32_t s, seg, ofs, n, last;
+
+	kv->mounted = FALSE;
+	if (!kv_geometry(kv)) return KV_ERROR_PARAM;
+
+	kv->head = 0;
+	for (s = 0; s < kv->NumSegs; s++)
+	{
+		if (EEPW_Read(kv->Dev, kv->Base + KV_SEG_OFS(kv, s), kv_buf, KV_SEG_HDR) != SUCCESS)
+		{
+			return KV_ERROR_DISK;
+		}
+		kv->seq[s] = KV_LD32(kv_buf + 2);
+		if ((kv_buf[0] != KV_MAGIC0) || (kv_buf[1] != KV_MAGIC1) ||
+			(kv_crc(kv->seq[s], kv_buf, 6) != KV_LD32(kv_buf + 6)))
+		{
+			kv->seq[s] = 0;
+		}
+		if (kv->seq[s] > kv->seq[kv->head]) kv->head = s;
+	}
+	if (kv->seq[kv->head] == 0) return KV_ERROR_NO_STORE;
+
+	kv_clear(kv);
+	for (last = 0; ; last = kv->seq[seg])
+	{
+		// Oldest segment not replayed yet
+		seg = kv->NumSegs;
+		for (s = 0; s < kv->NumSegs; s++)
+		{
+			if ((kv->seq[s] > last) && ((seg == kv->NumSegs) || (kv->seq[s] < kv->seq[seg]))) seg = s;
+		}
+		if (seg == kv->NumSegs) break;
+
+		if (EEPW_Read(kv->Dev, kv->Base + KV_SEG_OFS(kv, seg), kv_buf, kv->SegSize) != SUCCESS)
+		{
+			return KV_ERROR_DISK;
+		}
+		ofs = KV_SEG_HDR;
+		while ((n = kv_check(kv->seq[seg], kv_buf + ofs, kv->SegSize - ofs)) != 0)
+		{
+			kv_index(kv, kv_buf[ofs], KV_SEG_OFS(kv, seg) + ofs, kv_buf[ofs + 1]);
+			kv->Stats.Replayed++;
+			ofs += n;
+		}
+		if (seg == kv->head) kv->fill = ofs;
+	}
+	kv->mounted = TRUE;
+	return KV_OK;
+}
+
+
+/*********************************************************************//**
+ * @brief		Write a value, appended as a new record
+ * @param[in]	- kv: mounted store
+ * 				- key: 0 .. KV_MAX_KEYS-1
+ * 				- data: value
+ * 				- len: value length, up to KV_VALUE_MAX
+ * @return 		KV_OK, KV_ERROR_DISK, KV_ERROR_FULL, KV_ERROR_PARAM or
+ * 				KV_ERROR_NOT_MOUNTED
+ * Note: The old value stays valid until the new record is complete.
+ **********************************************************************/
+kv_error KV_Set (KV_STORE_Type *kv, uint8_t key, const void *data, uint8_t len)
+{
+	KV_INDEX_Type *e;
+	uint32_t used;
+
+	if (!kv->mounted) return KV_ERROR_NOT_MOUNTED;
+	if ((key >= KV_MAX_KEYS) || (len > KV_VALUE_MAX)) return KV_ERROR_PARAM;
+
+	// Keep one segment free to move to and one for the head
+	e = &kv->index[key];
+	used = kv_used(kv) + KV_REC_SIZE(len);
+	if (e->Addr != KV_NONE) used -= KV_REC_SIZE(KV_LEN(e->Len));
+	if (used > (uint32_t)(kv->NumSegs - 2) * (kv->SegSize - KV_SEG_HDR)) return KV_ERROR_FULL;
+
+	return kv_append(kv, key, (const uint8_t *)data, len);
+}
+
+
+/*********************************************************************//**
+ * @brief		Read a value, straight from the record the index points at
+ * @param[in]	- kv: mounted store
+ * 				- key: 0 .. KV_MAX_KEYS-1
+ * 				- buf: value buffer
+ * 				- size: size of buf
+ * @param[out]	len: value length, may be NULL
+ * @return 		KV_OK, KV_ERROR_NOT_FOUND, KV_ERROR_DISK, KV_ERROR_PARAM
+ * 				or KV_ERROR_NOT_MOUNTED
+ **********************************************************************/
+kv_error KV_Get (KV_STORE_Type *kv, uint8_t key, void *buf, uint8_t size, uint8_t *len)
+{
+	KV_INDEX_Type *e;
+	uint32_t n;
+
+	if (!kv->mounted) return KV_ERROR_NOT_MOUNTED;
+	if (key >= KV_MAX_KEYS) return KV_ERROR_PARAM;
+	e = &kv->index[key];
+	if ((e->Addr == KV_NONE) || (e->Len == KV_TOMBSTONE)) return KV_ERROR_NOT_FOUND;
+	if (e->Len > size) return KV_ERROR_PARAM;
+
+	n = KV_REC_SIZE(e->Len);
+	if ((EEPW_Read(kv->Dev, kv->Base + e->Addr, kv_buf, n) != SUCCESS) ||
+		(kv_check(kv->seq[KV_SEG_OF(kv, e->Addr)], kv_buf, n) != n))
+	{
+		return KV_ERROR_DISK;
+	}
+	memcpy(buf, kv_buf + 2, e->Len);
+	if (len != NULL) *len = e->Len;
+	return KV_OK;
+}
+
+
+/*********************************************************************//**
+ * @brief		Delete a key, a delete record is appended
+ * @param[in]	- kv: mounted store
+ * 				- key: 0 .. KV_MAX_KEYS-1
+ * @return 		KV_OK, KV_ERROR_NOT_FOUND, KV_ERROR_DISK, KV_ERROR_FULL,
+ * 				KV_ERROR_PARAM or KV_ERROR_NOT_MOUNTED
+ **********************************************************************/
+kv_error KV_Delete (KV_STORE_Type *kv, uint8_t key)
+{
+	KV_INDEX_Type *e;
+
+	if (!kv->mounted) return KV_ERROR_NOT_MOUNTED;
+	if (key >= KV_MAX_KEYS) return KV_ERROR_PARAM;
+	e = &kv->index[key];
+	if ((e->Addr == KV_NONE) || (e->Len == KV_TOMBSTONE)) return KV_ERROR_NOT_FOUND;
+
+	return kv_append(kv, key, NULL, KV_TOMBSTONE);
+}
+
+
+/*********************************************************************//**
+ * @brief		Get the store counters
+ * @param[in]	kv: store
+ * @param[out]	stats: pointer to KV_STATS_Type
+ * @return 		None
+ **********************************************************************/
+void KV_GetStats (KV_STORE_Type *kv, KV_STATS_Type *stats)
+{
+	uint32_t cap = (uint32_t)(kv->NumSegs - 2) * (kv->SegSize - KV_SEG_HDR);
+
+	*stats = kv->Stats;
+	stats->LiveBytes = kv_used(kv);
+	stats->FreeBytes = (stats->LiveBytes < cap) ? (cap - stats->LiveBytes) : 0;
+}
+
+/**
+ * @}
+ */
+
+/* End of Public Functions ---------------------------------------------------- */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -0,0 +1,829 @@
+/******************************************************************//**
+* @file		lpc_eep_writer.c
+* @brief	Contains all functions support for the page writer shared by
+*           the AT24C16, M24256 and 25AA160A E2PROM drivers
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @addtogroup EEPW
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc_eep_writer.h"
+#include <string.h>
+
+/* If this source file built with example, the LPC17xx FW library configuration
+ * file in each example directory ("lpc17xx_libcfg.h") must be included,
+ * otherwise the default FW library configuration file must be included instead
+ */
+
+/* Private Macros ------------------------------------------------------------- */
+/** @defgroup EEPW_Private_Macros EEPW Private Macros
+ * @{
+ */
+
+#define EEPW_SPI_BUS		(EEPW_SPI_SEL || EEPW_SSP_SEL)
+
+/** 25AAxxx instruction set */
+#define EEPW_OP_WRITE		0x02
+#define EEPW_OP_READ		0x03
+#define EEPW_OP_RDSR		0x05
+#define EEPW_OP_WREN		0x06
+#define EEPW_SR_WIP			0x01		/**< Write in progress */
+
+/** Queued job phases */
+#define EEPW_PH_PAGE		0			/* Next step writes a page */
+#define EEPW_PH_WRITTEN		1			/* Page in its write cycle */
+#define EEPW_PH_VERIFY		2			/* Page in its write cycle, read back next */
+#define EEPW_PH_PROBE		3			/* I2C: last page written, poll until ready */
+
+/** I2C address of the block holding addr, e.g. the 24C16 takes the
+ * top three of its eleven address bits in the slave address */
+#define EEPW_SLA(dev, addr)	((dev)->SlaveAddr | (((addr) >> ((dev)->AddrBytes * 8)) & 0x07))
+
+/**
+ * @}
+ */
+
+
+/* Private Functions ---------------------------------------------------------- */
+/*********************************************************************//**
+ * @brief		Bytes from addr up to the end of its page
+ * @param[in]	- dev: E2PROM
+ * 				- addr: E2PROM address
+ * 				- left: bytes still to write
+ * @return 		Length of the next page write
+ **********************************************************************/
+static uint32_t eepw_chunk (EEPW_DEV_Type *dev, uint32_t addr, uint32_t left)
+{
+	uint32_t n;
+
+	n = dev->PageSize - (addr & (dev->PageSize - 1));
+	return (n < left) ? n : left;
+}
+
+
+/*********************************************************************//**
+ * @brief		Store the word address, most significant byte first
+ * @param[in]	- dev: E2PROM
+ * 				- addr: E2PROM address
+ * 				- p: destination
+ * @return 		Number of bytes stored
+ **********************************************************************/
+static uint32_t eepw_addr (EEPW_DEV_Type *dev, uint32_t addr, uint8_t *p)
+{
+	uint32_t i;
+
+	for (i = 0; i < dev->AddrBytes; i++)
+	{
+		p[i] = (uint8_t)(addr >> ((dev->AddrBytes - 1 - i) * 8));
+	}
+	return i;
+}
+
+
+/*********************************************************************//**
+ * @brief		Compare the page read back into vbuf
+ * @param[in]	- dev: E2PROM, len bytes in vbuf
+ * 				- data: what was written
+ * @return 		SUCCESS or ERROR on mismatch
+ **********************************************************************/
+static Status eepw_compare (EEPW_DEV_Type *dev, const uint8_t *data)
+{
+	dev->Stats.BytesVerified += dev->len;
+	if (memcmp(dev->vbuf, data, dev->len) != 0)
+	{
+		dev->Stats.VerifyErrors++;
+		return ERROR;
+	}
+	return SUCCESS;
+}
+
+
+#if EEPW_I2C_SEL
+/*********************************************************************//**
+ * @brief		Polled I2C transfer of buf, then read. A part busy with
+ * 				its write cycle NACKs its address, each retry is an
+ * 				acknowledge poll.
+ * @param[in]	- dev: E2PROM
+ * 				- addr: E2PROM address, selects the block
+ * 				- txlen: bytes of buf to write
+ * 				- rx: read buffer, NULL for none
+ * 				- rxlen: bytes to read
+ * @return 		SUCCESS or ERROR
+ **********************************************************************/
+static Status eepw_i2c (EEPW_DEV_Type *dev, uint32_t addr, uint32_t txlen,
+		uint8_t *rx, uint32_t rxlen)
+{
+	I2C_M_SETUP_Type setup;
+	Status ret;
+
+	setup.sl_addr7bit = EEPW_SLA(dev, addr);
+	setup.tx_data = dev->buf;
+	setup.tx_length = txlen;
+	setup.rx_data = rx;
+	setup.rx_length = rxlen;
+	setup.retransmissions_max = EEPW_POLL_MAX;
+	setup.retransmissions_count = 0;
+	ret = I2C_MasterTransferData((LPC_I2C_TypeDef *)dev->Periph, &setup, I2C_TRANSFER_POLLING);
+	dev->Stats.BusyPolls += setup.retransmissions_count;
+	if (setup.retransmissions_count > EEPW_POLL_MAX)
+	{
+		dev->Stats.Timeouts++;
+	}
+	return ret;
+}
+#endif
+
+
+#if EEPW_SPI_BUS
+/*********************************************************************//**
+ * @brief		Drive the chip select of the SPI/SSP part
+ * @param[in]	- dev: E2PROM
+ * 				- sel: TRUE to select
+ * @return 		None
+ **********************************************************************/
+static void eepw_cs (EEPW_DEV_Type *dev, Bool sel)
+{
+	// CS_Force(ENABLE) drives the pin high, i.e. deselects
+#if EEPW_SSP_SEL
+	if (dev->Bus == EEPW_BUS_SSP)
+	{
+		CS_Force1((LPC_SSP_TypeDef *)dev->Periph, sel ? DISABLE : ENABLE);
+	}
+#endif
+#if EEPW_SPI_SEL
+	if (dev->Bus == EEPW_BUS_SPI)
+	{
+		CS_Force(sel ? DISABLE : ENABLE);
+	}
+#endif
+}
+
+
+/*********************************************************************//**
+ * @brief		Shift bytes with the part selected
+ * @param[in]	- dev: E2PROM
+ * 				- tx: bytes to send, NULL to send 0xFF
+ * 				- rx: received bytes, NULL to drop them
+ * 				- len: number of bytes
+ * @return 		TRUE when all bytes were shifted
+ **********************************************************************/
+static Bool eepw_spi_xfer (EEPW_DEV_Type *dev, const uint8_t *tx, uint8_t *rx, uint32_t len)
+{
+#if EEPW_SSP_SEL
+	SSP_DATA_SETUP_Type ssp;
+#endif
+#if EEPW_SPI_SEL
+	SPI_DATA_SETUP_Type spi;
+#endif
+
+	if (len == 0)
+	{
+		return TRUE;
+	}
+#if EEPW_SSP_SEL
+	if (dev->Bus == EEPW_BUS_SSP)
+	{
+		ssp.tx_data = (void *)tx;
+		ssp.rx_data = rx;
+		ssp.length = len;
+		return (SSP_ReadWrite((LPC_SSP_TypeDef *)dev->Periph, &ssp,
+				SSP_TRANSFER_POLLING) == (int32_t)len) ? TRUE : FALSE;
+	}
+#endif
+#if EEPW_SPI_SEL
+	if (dev->Bus == EEPW_BUS_SPI)
+	{
+		spi.tx_data = (void *)tx;
+		spi.rx_data = rx;
+		spi.length = len;
+		return (SPI_ReadWrite((LPC_SPI_TypeDef *)dev->Periph, &spi,
+				SPI_TRANSFER_POLLING) == (int32_t)len) ? TRUE : FALSE;
+	}
+#endif
+	return FALSE;
+}
+
+
+/*********************************************************************//**
+ * @brief		One instruction frame: opcode, address for READ/WRITE,
+ * 				then data out or data in
+ * @param[in]	- dev: E2PROM
+ * 				- op: EEPW_OP_xxx
+ * 				- addr: E2PROM address
+ * 				- tx: data to send after the header, NULL for none
+ * 				- rx: data to receive after the header, NULL for none
+ * 				- len: data length
+ * @return 		SUCCESS or ERROR
+ **********************************************************************/
+static Status eepw_spi_cmd (EEPW_DEV_Type *dev, uint8_t op, uint32_t addr,
+		const uint8_t *tx, uint8_t *rx, uint32_t len)
+{
+	uint8_t hdr[4];
+	uint32_t n = 1;
+	Bool ok;
+
+	hdr[0] = op;
+	if ((op == EEPW_OP_WRITE) || (op == EEPW_OP_READ))
+	{
+		n += eepw_addr(dev, addr, &hdr[1]);
+	}
+	eepw_cs(dev, TRUE);
+	ok = eepw_spi_xfer(dev, hdr, NULL, n);
+	if (ok && (tx != NULL))
+	{
+		ok = eepw_spi_xfer(dev, tx, NULL, len);
+	}
+	if (ok && (rx != NULL))
+	{
+		ok = eepw_spi_xfer(dev, NULL, rx, len);
+	}
+	eepw_cs(dev, FALSE);
+	return ok ? SUCCESS : ERROR;
+}
+
+
+/*********************************************************************//**
+ * @brief		Poll the status register until the write cycle ends
+ * @param[in]	dev: E2PROM
+ * @return 		SUCCESS, or ERROR on bus error or time out
+ **********************************************************************/
+static Status eepw_spi_wait (EEPW_DEV_Type *dev)
+{
+	uint32_t polls;
+	uint8_t sr;
+
+	for (polls = 0; polls <= EEPW_POLL_MAX; polls++)
+	{
+		if (eepw_spi_cmd(dev, EEPW_OP_RDSR, 0, NULL, &sr, 1) == ERROR)
+		{
+			return ERROR;
+		}
+		if (!(sr & EEPW_SR_WIP))
+		{
+			return SUCCESS;
+		}
+		dev->Stats.BusyPolls++;
+	}
+	dev->Stats.Timeouts++;
+	return ERROR;
+}
+
+
+/*********************************************************************//**
+ * @brief		Start the write cycle of one page, the part must be ready
+ * @param[in]	- dev: E2PROM
+ * 				- addr: E2PROM address
+ * 				- data: page data
+ * 				- len: bytes, not crossing the page
+ * @return 		SUCCESS or ERROR
+ **********************************************************************/
+static Status eepw_spi_page (EEPW_DEV_Type *dev, uint32_t addr, const uint8_t *data, uint32_t len)
+{
+	if ((eepw_spi_cmd(dev, EEPW_OP_WREN, 0, NULL, NULL, 0) == ERROR) ||
+		(eepw_spi_cmd(dev, EEPW_OP_WRITE, addr, data, NULL, len) == ERROR))
+	{
+		return ERROR;
+	}
+	dev->Stats.BytesWritten += len;
+	dev->Stats.PagesWritten++;
+	return SUCCESS;
+}
+#endif
+
+
+/*********************************************************************//**
+ * @brief		Write one page as soon as the part is ready for it
+ * @param[in]	- dev: E2PROM
+ * 				- addr: E2PROM address
+ * 				- data: page data
+ * 				- len: bytes, not crossing the page
+ * @return 		SUCCESS or ERROR
+ **********************************************************************/
+static Status eepw_page (EEPW_DEV_Type *dev, uint32_t addr, const uint8_t *data, uint32_t len)
+{
+#if EEPW_I2C_SEL
+	uint32_t n;
+
+	if (dev->Bus == EEPW_BUS_I2C)
+	{
+		n = eepw_addr(dev, addr, dev->buf);
+		memcpy(&dev->buf[n], data, len);
+		if (eepw_i2c(dev, addr, n + len, NULL, 0) == ERROR)
+		{
+			return ERROR;
+		}
+		dev->Stats.BytesWritten += len;
+		dev->Stats.PagesWritten++;
+		return SUCCESS;
+	}
+#endif
+#if EEPW_SPI_BUS
+	if (dev->Bus != EEPW_BUS_I2C)
+	{
+		if (eepw_spi_wait(dev) == ERROR)
+		{
+			return ERROR;
+		}
+		return eepw_spi_page(dev, addr, data, len);
+	}
+#endif
+	return ERROR;
+}
+
+
+/*********************************************************************//**
+ * @brief		Read as soon as the part is ready
+ * @param[in]	- dev: E2PROM
+ * 				- addr: E2PROM address
+ * 				- buf: destination
+ * 				- len: bytes, I2C reads must not leave the block of addr
+ * @return 		SUCCESS or ERROR
+ **********************************************************************/
+static Status eepw_read (EEPW_DEV_Type *dev, uint32_t addr, uint8_t *buf, uint32_t len)
+{
+#if EEPW_I2C_SEL
+	if (dev->Bus == EEPW_BUS_I2C)
+	{
+		return eepw_i2c(dev, addr, eepw_addr(dev, addr, dev->buf), buf, len);
+	}
+#endif
+#if EEPW_SPI_BUS
+	if (dev->Bus != EEPW_BUS_I2C)
+	{
+		if (eepw_spi_wait(dev) == ERROR)
+		{
+			return ERROR;
+		}
+		return eepw_spi_cmd(dev, EEPW_OP_READ, addr, NULL, buf, len);
+	}
+#endif
+	return ERROR;
+}
+
+
+static void eepw_start (EEPW_DEV_Type *dev);
+
+
+/*********************************************************************//**
+ * @brief		Finish the current job, call its callback and start the
+ * 				next one
+ * @param[in]	- dev: E2PROM
+ * 				- state: EEPW_JOB_DONE or EEPW_JOB_FAILED
+ * @return 		None
+ **********************************************************************/
+static void eepw_finish (EEPW_DEV_Type *dev, uint8_t state)
+{
+	EEPW_JOB_Type *job = dev->cur;
+
+	dev->cur = NULL;
+	job->State = state;
+	if (job->Callback != NULL)
+	{
+		job->Callback(job);
+	}
+	// The callback may have submitted and started a job already
+	eepw_start(dev);
+}
+
+
+#if EEPW_I2C_SEL
+/*********************************************************************//**
+ * @brief		Queue the next transaction of the current job: a page
+ * 				write, the read back of the last page or, once all is
+ * 				written, an address only probe. Transactions are not
+ * 				retried by the queue, their NACKs are counted here.
+ * @param[in]	dev: E2PROM
+ * @return 		None
+ **********************************************************************/
+static void eepw_i2c_step (EEPW_DEV_Type *dev)
+{
+	EEPW_JOB_Type *job = dev->cur;
+	I2C_XFER_Type *x = &dev->xfer;
+	uint32_t addr, n;
+
+	addr = job->Addr + job->Done;
+	n = eepw_addr(dev, addr, dev->buf);
+	x->sl_addr7bit = EEPW_SLA(dev, addr);
+	x->priority = I2C_PRIO_LOW;
+	x->retries = 0;
+	x->restart = TRUE;
+	x->tx_data = dev->buf;
+	x->tx_length = n;
+	x->rx_data = NULL;
+	x->rx_length = 0;
+	if (dev->phase == EEPW_PH_VERIFY)
+	{
+		x->rx_data = dev->vbuf;
+		x->rx_length = dev->len;
+	}
+	else if (dev->phase == EEPW_PH_PAGE)
+	{
+		dev->len = eepw_chunk(dev, addr, job->Length - job->Done);
+		memcpy(&dev->buf[n], &job->Data[job->Done], dev->len);
+		x->tx_length = n + dev->len;
+	}
+	if (I2C_QueueSubmit((LPC_I2C_TypeDef *)dev->Periph, x) == ERROR)
+	{
+		eepw_finish(dev, EEPW_JOB_FAILED);
+	}
+}
+
+
+/*********************************************************************//**
+ * @brief		I2C queue callback, advances the current job
+ * @param[in]	x: transaction of the job
+ * @return 		None
+ **********************************************************************/
+static void eepw_i2c_done (I2C_XFER_Type *x)
+{
+	EEPW_DEV_Type *dev = (EEPW_DEV_Type *)x->arg;
+	EEPW_JOB_Type *job = dev->cur;
+
+	if (x->state == I2C_XFER_FAILED)
+	{
+		// A NACK means the last write cycle is still running, poll again
+		if ((x->status & I2C_SETUP_STATUS_NOACKF) && (dev->polls < EEPW_POLL_MAX))
+		{
+			dev->polls++;
+			dev->Stats.BusyPolls++;
+			if (I2C_QueueSubmit((LPC_I2C_TypeDef *)dev->Periph, x) == SUCCESS)
+			{
+				return;
+			}
+		}
+		else if (x->status & I2C_SETUP_STATUS_NOACKF)
+		{
+			dev->Stats.Timeouts++;
+		}
+		eepw_finish(dev, EEPW_JOB_FAILED);
+		return;
+	}
+	dev->polls = 0;
+
+	switch (dev->phase)
+	{
+	case EEPW_PH_PAGE:
+		dev->Stats.BytesWritten += dev->len;
+		dev->Stats.PagesWritten++;
+		if (job->Verify)
+		{
+			dev->phase = EEPW_PH_VERIFY;
+			break;
+		}
+		job->Done += dev->len;
+		if (job->Done == job->Length)
+		{
+			dev->phase = EEPW_PH_PROBE;
+		}
+		break;
+
+	case EEPW_PH_VERIFY:
+		if (eepw_compare(dev, &job->Data[job->Done]) == ERROR)
+		{
+			eepw_finish(dev, EEPW_JOB_FAILED);
+			return;
+		}
+		job->Done += dev->len;
+		if (job->Done == job->Length)
+		{
+			eepw_finish(dev, EEPW_JOB_DONE);
+			return;
+		}
+		dev->phase = EEPW_PH_PAGE;
+		break;
+
+	default:
+		// Probe acknowledged, the last page is programmed
+		eepw_finish(dev, EEPW_JOB_DONE);
+		return;
+	}
+	eepw_i2c_step(dev);
+}
+#endif
+
+
+/*********************************************************************//**
+ * @brief		Make the next queued job current and, for I2C parts,
+ * 				queue its first transaction
+ * @param[in]	dev: E2PROM
+ * @return 		None
+ **********************************************************************/
+static void eepw_start (EEPW_DEV_Type *dev)
+{
+	EEPW_JOB_Type *job;
+	uint32_t primask;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	job = dev->head;
+	if ((dev->cur != NULL) || (job == NULL))
+	{
+		__set_PRIMASK(primask);
+		return;
+	}
+	dev->head = job->Next;
+	dev->cur = job;
+	dev->phase = EEPW_PH_PAGE;
+	dev->polls = 0;
+	job->State = EEPW_JOB_BUSY;
+#if EEPW_I2C_SEL
+	if (dev->Bus == EEPW_BUS_I2C)
+	{
+		dev->xfer.callback = eepw_i2c_done;
+		dev->xfer.arg = dev;
+		dev->xfer.state = I2C_XFER_IDLE;
+		eepw_i2c_step(dev);
+	}
+#endif
+	__set_PRIMASK(primask);
+}
+
+/* End of Private Functions --------------------------------------------------- */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @addtogroup EEPW_Public_Functions
+ * @{
+ */
+
+/*********************************************************************//**
+ * @brief		Write a buffer page by page. Each page goes out as soon
+ * 				as the part finished the last one: I2C parts are
+ * 				acknowledge polled, SPI parts have their WIP bit polled.
+ * @param[in]	- dev: E2PROM
+ * 				- addr: first E2PROM address
+ * 				- data: data to write
+ * 				- len: number of bytes
+ * 				- verify: TRUE to read every page back after its write cycle
+ * @return 		SUCCESS once the last page is programmed, ERROR on bus
+ * 				error, time out, verify mismatch, range error or when
+ * 				queued jobs are pending on the part
+ **********************************************************************/
+Status EEPW_Write (EEPW_DEV_Type *dev, uint32_t addr, const uint8_t *data, uint32_t len, Bool verify)
+{
+	uint32_t n;
+
+	if ((addr > dev->Size) || (len > dev->Size - addr) ||
+		(dev->cur != NULL) || (dev->head != NULL))
+	{
+		return ERROR;
+	}
+	while (len)
+	{
+		n = eepw_chunk(dev, addr, len);
+		if (eepw_page(dev, addr, data, n) == ERROR)
+		{
+			return ERROR;
+		}
+		if (verify)
+		{
+			dev->len = n;
+			if ((eepw_read(dev, addr, dev->vbuf, n) == ERROR) ||
+				(eepw_compare(dev, data) == ERROR))
+			{
+				return ERROR;
+			}
+		}
+		addr += n;
+		data += n;
+		len -= n;
+	}
+	return verify ? SUCCESS : EEPW_WaitReady(dev);
+}
+
+
+/*********************************************************************//**
+ * @brief		Read a buffer, waiting for a running write cycle first
+ * @param[in]	- dev: E2PROM
+ * 				- addr: first E2PROM address
+ * 				- buf: destination
+ * 				- len: number of bytes
+ * @return 		SUCCESS, ERROR on bus error, range error or when queued
+ * 				jobs are pending on the part
+ **********************************************************************/
+Status EEPW_Read (EEPW_DEV_Type *dev, uint32_t addr, uint8_t *buf, uint32_t len)
+{
+	uint32_t n, block;
+
+	if ((addr > dev->Size) || (len > dev->Size - addr) ||
+		(dev->cur != NULL) || (dev->head != NULL))
+	{
+		return ERROR;
+	}
+	// I2C: the block bits in the slave address do not count up
+	block = (dev->Bus == EEPW_BUS_I2C) ? (1UL << (dev->AddrBytes * 8)) : dev->Size;
+	while (len)
+	{
+		n = block - (addr & (block - 1));
+		if (n > len)
+		{
+			n = len;
+		}
+		if (eepw_read(dev, addr, buf, n) == ERROR)
+		{
+			return ERROR;
+		}
+		addr += n;
+		buf += n;
+		len -= n;
+	}
+	return SUCCESS;
+}
+
+
+/*********************************************************************//**
+ * @brief		Wait until the part finished its write cycle
+ * @param[in]	dev: E2PROM
+ * @return 		SUCCESS, or ERROR on bus error or time out
+ **********************************************************************/
+Status EEPW_WaitReady (EEPW_DEV_Type *dev)
+{
+#if EEPW_I2C_SEL
+	if (dev->Bus == EEPW_BUS_I2C)
+	{
+		// Address only write, the part ACKs it once ready and programs nothing
+		return eepw_i2c(dev, 0, eepw_addr(dev, 0, dev->buf), NULL, 0);
+	}
+#endif
+#if EEPW_SPI_BUS
+	if (dev->Bus != EEPW_BUS_I2C)
+	{
+		return eepw_spi_wait(dev);
+	}
+#endif
+	return ERROR;
+}
+
+
+/*********************************************************************//**
+ * @brief		Queue a write, jobs of one part run in submission order
+ * @param[in]	- dev: E2PROM
+ * 				- job: write job, owned by the writer until its callback
+ * 				  runs (or its state leaves QUEUED/BUSY)
+ * @return 		SUCCESS, or ERROR if job is already queued, empty or out
+ * 				of range
+ *
+ * Note:
+ * - I2C parts run from the I2C transaction queue, its watchdog runs on
+ *   the SCHED timer wheel. SPI parts advance in EEPW_Process().
+ * - May be called from the completion callback to chain jobs.
+ **********************************************************************/
+Status EEPW_Submit (EEPW_DEV_Type *dev, EEPW_JOB_Type *job)
+{
+	EEPW_JOB_Type **link;
+	uint32_t primask;
+
+	if ((job->Length == 0) || (job->Addr > dev->Size) ||
+		(job->Length > dev->Size - job->Addr))
+	{
+		return ERROR;
+	}
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if ((job->State == EEPW_JOB_QUEUED) || (job->State == EEPW_JOB_BUSY))
+	{
+		__set_PRIMASK(primask);
+		return ERROR;
+	}
+	for (link = &dev->head; *link != NULL; link = &(*link)->Next);
+	job->Next = NULL;
+	job->Done = 0;
+	job->State = EEPW_JOB_QUEUED;
+	*link = job;
+	eepw_start(dev);
+	__set_PRIMASK(primask);
+	return SUCCESS;
+}
+
+
+/*********************************************************************//**
+ * @brief		Get number of queued jobs
+ * @param[in]	dev: E2PROM
+ * @return 		Waiting jobs plus the one being written
+ **********************************************************************/
+uint32_t EEPW_Pending (EEPW_DEV_Type *dev)
+{
+	EEPW_JOB_Type *job;
+	uint32_t primask, cnt;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	cnt = (dev->cur != NULL) ? 1 : 0;
+	for (job = dev->head; job != NULL; job = job->Next)
+	{
+		cnt++;
+	}
+	__set_PRIMASK(primask);
+	return cnt;
+}
+
+
+/*********************************************************************//**
+ * @brief		Advance the queued jobs of an SPI part by one bus step:
+ * 				a status read while the write cycle runs, else the read
+ * 				back or the next page. Call from the main loop, does
+ * 				nothing for I2C parts.
+ * @param[in]	dev: E2PROM
+ * @return 		None
+ **********************************************************************/
+void EEPW_Process (EEPW_DEV_Type *dev)
+{
+#if EEPW_SPI_BUS
+	EEPW_JOB_Type *job;
+	uint32_t addr;
+	uint8_t sr;
+
+	if (dev->Bus == EEPW_BUS_I2C)
+	{
+		return;
+	}
+	eepw_start(dev);
+	job = dev->cur;
+	if (job == NULL)
+	{
+		return;
+	}
+	addr = job->Addr + job->Done;
+
+	if (dev->phase != EEPW_PH_PAGE)
+	{
+		if (eepw_spi_cmd(dev, EEPW_OP_RDSR, 0, NULL, &sr, 1) == ERROR)
+		{
+			eepw_finish(dev, EEPW_JOB_FAILED);
+			return;
+		}
+		if (sr & EEPW_SR_WIP)
+		{
+			dev->Stats.BusyPolls++;
+			if (++dev->polls > EEPW_POLL_MAX)
+			{
+				dev->Stats.Timeouts++;
+				eepw_finish(dev, EEPW_JOB_FAILED);
+			}
+			return;
+		}
+		dev->polls = 0;
+		if (dev->phase == EEPW_PH_VERIFY)
+		{
+			if ((eepw_spi_cmd(dev, EEPW_OP_READ, addr, NULL, dev->vbuf, dev->len) == ERROR) ||
+				(eepw_compare(dev, &job->Data[job->Done]) == ERROR))
+			{
+				eepw_finish(dev, EEPW_JOB_FAILED);
+				return;
+			}
+		}
+		job->Done += dev->len;
+		addr += dev->len;
+		dev->phase = EEPW_PH_PAGE;
+		if (job->Done == job->Length)
+		{
+			eepw_finish(dev, EEPW_JOB_DONE);
+			return;
+		}
+	}
+
+	dev->len = eepw_chunk(dev, addr, job->Length - job->Done);
+	if (eepw_spi_page(dev, addr, &job->Data[job->Done], dev->len) == ERROR)
+	{
+		eepw_finish(dev, EEPW_JOB_FAILED);
+		return;
+	}
+	dev->phase = job->Verify ? EEPW_PH_VERIFY : EEPW_PH_WRITTEN;
+#endif
+}
+
+
+/*********************************************************************//**
+ * @brief		Get the throughput counters of a part
+ * @param[in]	dev: E2PROM
+ * @param[out]	stats: pointer to EEPW_STATS_Type
+ * @return 		None
+ **********************************************************************/
+void EEPW_GetStats (EEPW_DEV_Type *dev, EEPW_STATS_Type *stats)
+{
+	uint32_t primask;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	*stats = dev->Stats;
+	__set_PRIMASK(primask);
+}
+
+/**
+ * @}
+ */
+
+/* End of Public Functions ---------------------------------------------------- */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
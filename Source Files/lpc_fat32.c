@@ -0,0 +1,550 @@
+/******************************************************************//**
+* @file		lpc_fat32.c
+* @brief	Contains all functions support for the read optimised FAT32
+*           file reader on the SD block layer
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @addtogroup FAT32
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc_fat32.h"
+#include <string.h>
+
+/* If this source file built with example, the LPC17xx FW library configuration
+ * file in each example directory ("lpc17xx_libcfg.h") must be included,
+ * otherwise the default FW library configuration file must be included instead
+ */
+
+/* Private Macros ------------------------------------------------------------- */
+/** @defgroup FAT32_Private_Macros FAT32 Private Macros
+ * @{
+ */
+
+/** Little endian fields of on-disk structures */
+#define FAT_LD16(p)			((uint16_t)((p)[0] | ((p)[1] << 8)))
+#define FAT_LD32(p)			((uint32_t)FAT_LD16(p) | ((uint32_t)FAT_LD16((p) + 2) << 16))
+
+#define FAT_NO_SECTOR		0xFFFFFFFF
+#define FAT_ENTRY_MASK		0x0FFFFFFF
+#define FAT_EOC				0x0FFFFFF8		/**< Entries from here on end a chain */
+#define FAT_DIR_ENTRY		32
+
+/**
+ * @}
+ */
+
+
+/* Private Variables ---------------------------------------------------------- */
+/** Volume geometry, in sectors from the start of the card */
+static Bool fat_mounted;
+static uint32_t fat_lba_fat;			/* First FAT */
+static uint32_t fat_lba_data;			/* Cluster 2 */
+static uint32_t fat_root;				/* Root directory cluster */
+static uint32_t fat_clusters;			/* Data clusters on the volume */
+static uint8_t fat_shift;				/* log2 sectors per cluster */
+
+/** One sector of the FAT and one of data or directory, both write through */
+static uint8_t fat_buf[FAT_SECTOR_SIZE];
+static uint32_t fat_buf_lba = FAT_NO_SECTOR;
+static uint8_t fat_dbuf[FAT_SECTOR_SIZE];
+static uint32_t fat_dbuf_lba = FAT_NO_SECTOR;
+
+static FAT_STATS_Type fat_stats;
+
+
+/* Private Functions ---------------------------------------------------------- */
+/*********************************************************************//**
+ * @brief		Read sectors from the card
+ * @param[in]	- lba: first sector
+ * 				- buf: pointer to n * FAT_SECTOR_SIZE bytes
+ * 				- n: number of sectors
+ * @return 		FAT_OK or FAT_ERROR_DISK
+ **********************************************************************/
+static fat_error fat_disk_read (uint32_t lba, uint8_t *buf, uint32_t n)
+{
+	fat_stats.DiskReads++;
+	fat_stats.SectorsRead += n;
+	return (SD_ReadBlocks(lba, buf, n) == SD_OK) ? FAT_OK : FAT_ERROR_DISK;
+}
+
+
+/*********************************************************************//**
+ * @brief		Write sectors to the card
+ * @param[in]	- lba: first sector
+ * 				- buf: pointer to n * FAT_SECTOR_SIZE bytes
+ * 				- n: number of sectors
+ * @return 		FAT_OK or FAT_ERROR_DISK
+ **********************************************************************/
+static fat_error fat_disk_write (uint32_t lba, const uint8_t *buf, uint32_t n)
+{
+	fat_stats.DiskWrites++;
+	fat_stats.SectorsWritten += n;
+	return (SD_WriteBlocks(lba, buf, n) == SD_OK) ? FAT_OK : FAT_ERROR_DISK;
+}
+
+
+/*********************************************************************//**
+ * @brief		Get a data or directory sector through the sector cache
+ * @param[in]	lba: sector number
+ * @return 		pointer to the cached sector, NULL on disk error
+ **********************************************************************/
+static uint8_t *fat_sector (uint32_t lba)
+{
+	if (fat_dbuf_lba != lba)
+	{
+		fat_dbuf_lba = FAT_NO_SECTOR;
+		if (fat_disk_read(lba, fat_dbuf, 1) != FAT_OK) return NULL;
+		fat_dbuf_lba = lba;
+	}
+	return fat_dbuf;
+}
+
+
+/*********************************************************************//**
+ * @brief		First sector of a cluster
+ * @param[in]	cluster: cluster number, 2 or above
+ * @return 		sector number
+ **********************************************************************/
+static uint32_t fat_cluster_lba (uint32_t cluster)
+{
+	return fat_lba_data + ((cluster - 2) << fat_shift);
+}
+
+
+/*********************************************************************//**
+ * @brief		Follow one link of a cluster chain
+ * @param[in]	- cluster: cluster number
+ * 				- next: returns the FAT entry, FAT_EOC or above ends the chain
+ * 				- cached: TRUE to fail with FAT_ERROR_DISK instead of
+ * 						  loading another FAT sector
+ * @return 		FAT_OK, FAT_ERROR_DISK or FAT_ERROR_CHAIN
+ **********************************************************************/
+static fat_error fat_next (uint32_t cluster, uint32_t *next, Bool cached)
+{
+	uint32_t lba = fat_lba_fat + (cluster / (FAT_SECTOR_SIZE / 4));
+
+	if (fat_buf_lba != lba)
+	{
+		if (cached) return FAT_ERROR_DISK;
+		fat_buf_lba = FAT_NO_SECTOR;
+		fat_stats.FatReads++;
+		if (fat_disk_read(lba, fat_buf, 1) != FAT_OK) return FAT_ERROR_DISK;
+		fat_buf_lba = lba;
+	}
+	*next = FAT_LD32(&fat_buf[(cluster % (FAT_SECTOR_SIZE / 4)) * 4]) & FAT_ENTRY_MASK;
+	if ((*next < FAT_EOC) && ((*next < 2) || (*next >= fat_clusters + 2))) return FAT_ERROR_CHAIN;
+	return FAT_OK;
+}
+
+
+/*********************************************************************//**
+ * @brief		Find the cluster holding a part of a file. The chain
+ * 				is walked from the cached runs, a new run is started only
+ * 				where the chain jumps. After the wanted cluster the walk
+ * 				goes on to the end of the FAT sector already loaded so
+ * 				that the run grows as long as possible for free.
+ * @param[in]	- file: open file
+ * 				- index: cluster number inside the file
+ * 				- cluster: returns the cluster
+ * 				- run: returns the consecutive clusters from there on
+ * @return 		FAT_OK, FAT_ERROR_DISK or FAT_ERROR_CHAIN
+ **********************************************************************/
+static fat_error fat_map (FAT_FILE_Type *file, uint32_t index, uint32_t *cluster, uint32_t *run)
+{
+	FAT_EXTENT_Type *ext;
+	uint32_t i, cur, next;
+	fat_error ret;
+
+	if ((file->NumExt == 0) || (index < file->Ext[0].Index))
+	{
+		// Restart from the head of the chain
+		if (file->FirstCluster < 2) return FAT_ERROR_CHAIN;
+		file->Ext[0].Index = 0;
+		file->Ext[0].Cluster = file->FirstCluster;
+		file->Ext[0].Count = 1;
+		file->NumExt = 1;
+		file->ChainEnd = FALSE;
+	}
+
+	for (i = 0; i < file->NumExt; i++)
+	{
+		ext = &file->Ext[i];
+		if (index - ext->Index < ext->Count) break;
+	}
+
+	if (i == file->NumExt)
+	{
+		// Walk on from the end of the last run
+		ext = &file->Ext[file->NumExt - 1];
+		cur = ext->Cluster + ext->Count - 1;
+		while (index >= ext->Index + ext->Count)
+		{
+			if (file->ChainEnd) return FAT_ERROR_CHAIN;
+			ret = fat_next(cur, &next, FALSE);
+			if (ret != FAT_OK) return ret;
+			if (next >= FAT_EOC)
+			{
+				file->ChainEnd = TRUE;
+				return FAT_ERROR_CHAIN;
+			}
+			if (next != cur + 1)
+			{
+				// Jump: open a new run, the window slides when full
+				if (file->NumExt == FAT_EXTENTS)
+				{
+					file->Ext[0] = *ext;
+					file->NumExt = 1;
+				}
+				file->Ext[file->NumExt].Index = ext->Index + ext->Count;
+				file->Ext[file->NumExt].Cluster = next;
+				file->Ext[file->NumExt].Count = 0;
+				ext = &file->Ext[file->NumExt++];
+			}
+			ext->Count++;
+			cur = next;
+		}
+	}
+
+	// Grow the run while its links are in the FAT sector at hand
+	cur = ext->Cluster + ext->Count - 1;
+	while ((ext == &file->Ext[file->NumExt - 1]) && !file->ChainEnd &&
+		   (fat_next(cur, &next, TRUE) == FAT_OK) && (next == cur + 1))
+	{
+		ext->Count++;
+		cur = next;
+	}
+	if ((ext == &file->Ext[file->NumExt - 1]) && (fat_next(cur, &next, TRUE) == FAT_OK) && (next >= FAT_EOC))
+	{
+		file->ChainEnd = TRUE;
+	}
+
+	*cluster = ext->Cluster + (index - ext->Index);
+	*run = ext->Count - (index - ext->Index);
+	return FAT_OK;
+}
+
+
+/*********************************************************************//**
+ * @brief		Convert a path element to a directory entry name
+ * @param[in]	- path: element, ends at '/' or '\0'
+ * 				- name: returns 11 characters, blank padded 8.3
+ * @return 		characters used from path, 0 if not a valid 8.3 name
+ **********************************************************************/
+static uint32_t fat_make_name (const char *path, uint8_t *name)
+{
+	uint32_t i = 0, n = 0, limit = 8;
+	char c;
+
+	memset(name, ' ', 11);
+	while (((c = path[i]) != '\0') && (c != '/'))
+	{
+		i++;
+		if (c == '.')
+		{
+			if (limit == 11) return 0;
+			n = 8;
+			limit = 11;
+			continue;
+		}
+		if (n >= limit) return 0;
+		if ((c >= 'a') && (c <= 'z')) c -= 'a' - 'A';
+		name[n++] = (uint8_t)c;
+	}
+	return (name[0] == ' ') ? 0 : i;
+}
+
+
+/*********************************************************************//**
+ * @brief		Look a name up in a directory
+ * @param[in]	- dir: first cluster of the directory
+ * 				- name: 11 character 8.3 name
+ * 				- entry: returns a copy of the 32 byte directory entry
+ * @return 		FAT_OK, FAT_ERROR_NOT_FOUND, FAT_ERROR_DISK or FAT_ERROR_CHAIN
+ **********************************************************************/
+static fat_error fat_find (uint32_t dir, const uint8_t *name, uint8_t *entry)
+{
+	uint32_t sec, off;
+	uint8_t *p;
+	fat_error ret;
+
+	while (dir < FAT_EOC)
+	{
+		for (sec = 0; sec < (1UL << fat_shift); sec++)
+		{
+			p = fat_sector(fat_cluster_lba(dir) + sec);
+			if (p == NULL) return FAT_ERROR_DISK;
+			for (off = 0; off < FAT_SECTOR_SIZE; off += FAT_DIR_ENTRY)
+			{
+				if (p[off] == 0x00) return FAT_ERROR_NOT_FOUND;	// End of directory
+				if ((p[off] == 0xE5) || (p[off + 11] == FAT_ATTR_LFN) ||
+					(p[off + 11] & FAT_ATTR_VOLUME_ID)) continue;
+				if (memcmp(&p[off], name, 11) == 0)
+				{
+					memcpy(entry, &p[off], FAT_DIR_ENTRY);
+					return FAT_OK;
+				}
+			}
+		}
+		ret = fat_next(dir, &dir, FALSE);
+		if (ret != FAT_OK) return ret;
+	}
+	return FAT_ERROR_NOT_FOUND;
+}
+
+
+/*********************************************************************//**
+ * @brief		Check a boot sector for a FAT32 BPB
+ * @param[in]	p: pointer to the sector
+ * @return 		TRUE if it describes a FAT32 volume with 512 byte sectors
+ **********************************************************************/
+static Bool fat_is_vbr (const uint8_t *p)
+{
+	return ((p[510] == 0x55) && (p[511] == 0xAA) &&
+			(memcmp(&p[0x52], "FAT32   ", 8) == 0) &&
+			(FAT_LD16(&p[0x0B]) == FAT_SECTOR_SIZE) &&
+			(FAT_LD16(&p[0x11]) == 0) && (p[0x0D] != 0) &&
+			((p[0x0D] & (p[0x0D] - 1)) == 0)) ? TRUE : FALSE;
+}
+
+/* End of Private Functions --------------------------------------------------- */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @addtogroup FAT32_Public_Functions
+ * @{
+ */
+
+/*********************************************************************//**
+ * @brief		Mount the FAT32 volume of the card. The card is either
+ * 				partitioned (first FAT32 partition of the MBR is used)
+ * 				or formatted without a partition table.
+ * @param[in]	none
+ * @return 		FAT_OK, FAT_ERROR_DISK or FAT_ERROR_NO_FS
+ * Note: SD_Init() must have succeeded before.
+ **********************************************************************/
+fat_error FAT_Mount (void)
+{
+	uint32_t part = 0, total, i;
+	uint8_t *p, type;
+
+	fat_mounted = FALSE;
+	fat_buf_lba = FAT_NO_SECTOR;
+	fat_dbuf_lba = FAT_NO_SECTOR;
+
+	p = fat_sector(0);
+	if (p == NULL) return FAT_ERROR_DISK;
+	if (!fat_is_vbr(p))
+	{
+		if ((p[510] != 0x55) || (p[511] != 0xAA)) return FAT_ERROR_NO_FS;
+		for (i = 0; i < 4; i++)
+		{
+			type = p[0x1BE + i * 16 + 4];
+			if ((type == 0x0B) || (type == 0x0C)) break;
+		}
+		if (i == 4) return FAT_ERROR_NO_FS;
+		part = FAT_LD32(&p[0x1BE + i * 16 + 8]);
+		p = fat_sector(part);
+		if (p == NULL) return FAT_ERROR_DISK;
+		if (!fat_is_vbr(p)) return FAT_ERROR_NO_FS;
+	}
+
+	for (fat_shift = 0; (1U << fat_shift) < p[0x0D]; fat_shift++);
+	fat_lba_fat = part + FAT_LD16(&p[0x0E]);
+	fat_lba_data = fat_lba_fat + p[0x10] * FAT_LD32(&p[0x24]);
+	fat_root = FAT_LD32(&p[0x2C]);
+	total = FAT_LD32(&p[0x20]);
+	if (total <= fat_lba_data - part) return FAT_ERROR_NO_FS;
+	fat_clusters = (total - (fat_lba_data - part)) >> fat_shift;
+	if ((fat_root < 2) || (fat_root >= fat_clusters + 2)) return FAT_ERROR_NO_FS;
+
+	fat_mounted = TRUE;
+	return FAT_OK;
+}
+
+
+/*********************************************************************//**
+ * @brief		Open a file for reading (and overwriting)
+ * @param[in]	- file: pointer to FAT_FILE_Type to fill in
+ * 				- path: 8.3 names separated by '/', e.g. "LOG/RUN01.BIN",
+ * 						case is ignored. Long names are not looked at.
+ * @return 		FAT_OK or error code
+ **********************************************************************/
+fat_error FAT_Open (FAT_FILE_Type *file, const char *path)
+{
+	uint8_t name[11], entry[FAT_DIR_ENTRY];
+	uint32_t dir, n;
+	fat_error ret;
+
+	if (!fat_mounted) return FAT_ERROR_NOT_MOUNTED;
+
+	dir = fat_root;
+	while (1)
+	{
+		while (*path == '/') path++;
+		n = fat_make_name(path, name);
+		if (n == 0) return FAT_ERROR_NOT_FOUND;
+		path += n;
+
+		ret = fat_find(dir, name, entry);
+		if (ret != FAT_OK) return ret;
+		dir = ((uint32_t)FAT_LD16(&entry[20]) << 16) | FAT_LD16(&entry[26]);
+
+		while (*path == '/') path++;
+		if (*path == '\0') break;
+		if (!(entry[11] & FAT_ATTR_DIRECTORY)) return FAT_ERROR_NOT_FOUND;
+	}
+	if (entry[11] & FAT_ATTR_DIRECTORY) return FAT_ERROR_NOT_FOUND;
+
+	file->Size = FAT_LD32(&entry[28]);
+	file->Pos = 0;
+	file->FirstCluster = dir;
+	file->Attr = entry[11];
+	file->NumExt = 0;
+	file->ChainEnd = FALSE;
+	return FAT_OK;
+}
+
+
+/*********************************************************************//**
+ * @brief		Set the read/write position
+ * @param[in]	- file: open file
+ * 				- pos: byte offset, up to the file size
+ * @return 		FAT_OK or FAT_ERROR_RANGE
+ **********************************************************************/
+fat_error FAT_Seek (FAT_FILE_Type *file, uint32_t pos)
+{
+	if (pos > file->Size) return FAT_ERROR_RANGE;
+	file->Pos = pos;
+	return FAT_OK;
+}
+
+
+/*********************************************************************//**
+ * @brief		Read from a file. Whole sectors go straight from the card
+ * 				into buf, one multi block read per run of consecutive
+ * 				clusters; only a partial first and last sector pass
+ * 				through the sector cache.
+ * @param[in]	- file: open file
+ * 				- buf: pointer to receive buffer
+ * 				- len: bytes to read
+ * @return 		bytes read, less than len at the end of the file or on error
+ **********************************************************************/
+uint32_t FAT_Read (FAT_FILE_Type *file, void *buf, uint32_t len)
+{
+	uint8_t *dst = (uint8_t *)buf;
+	uint32_t done = 0, off, cluster, run, sec, n;
+	uint8_t *p;
+
+	if (!fat_mounted) return 0;
+	if (len > file->Size - file->Pos) len = file->Size - file->Pos;
+
+	while (done < len)
+	{
+		if (fat_map(file, file->Pos >> (fat_shift + 9), &cluster, &run) != FAT_OK) break;
+		sec = (file->Pos >> 9) & ((1UL << fat_shift) - 1);
+		off = file->Pos & (FAT_SECTOR_SIZE - 1);
+
+		if ((off == 0) && (len - done >= FAT_SECTOR_SIZE))
+		{
+			n = (len - done) / FAT_SECTOR_SIZE;
+			if (n > (run << fat_shift) - sec) n = (run << fat_shift) - sec;
+			if (fat_disk_read(fat_cluster_lba(cluster) + sec, dst + done, n) != FAT_OK) break;
+			n *= FAT_SECTOR_SIZE;
+		}
+		else
+		{
+			p = fat_sector(fat_cluster_lba(cluster) + sec);
+			if (p == NULL) break;
+			n = FAT_SECTOR_SIZE - off;
+			if (n > len - done) n = len - done;
+			memcpy(dst + done, p + off, n);
+		}
+		done += n;
+		file->Pos += n;
+	}
+	return done;
+}
+
+
+/*********************************************************************//**
+ * @brief		Overwrite part of a file in place. The file is not
+ * 				extended, logs are written into files created with their
+ * 				final size. Whole sectors go to the card with one multi
+ * 				block write per run of consecutive clusters.
+ * @param[in]	- file: open file
+ * 				- buf: pointer to data
+ * 				- len: bytes to write
+ * @return 		bytes written, less than len at the end of the file or on error
+ **********************************************************************/
+uint32_t FAT_Write (FAT_FILE_Type *file, const void *buf, uint32_t len)
+{
+	const uint8_t *src = (const uint8_t *)buf;
+	uint32_t done = 0, off, cluster, run, sec, lba, n;
+	uint8_t *p;
+
+	if (!fat_mounted || (file->Attr & FAT_ATTR_READ_ONLY)) return 0;
+	if (len > file->Size - file->Pos) len = file->Size - file->Pos;
+
+	while (done < len)
+	{
+		if (fat_map(file, file->Pos >> (fat_shift + 9), &cluster, &run) != FAT_OK) break;
+		sec = (file->Pos >> 9) & ((1UL << fat_shift) - 1);
+		off = file->Pos & (FAT_SECTOR_SIZE - 1);
+		lba = fat_cluster_lba(cluster) + sec;
+
+		if ((off == 0) && (len - done >= FAT_SECTOR_SIZE))
+		{
+			n = (len - done) / FAT_SECTOR_SIZE;
+			if (n > (run << fat_shift) - sec) n = (run << fat_shift) - sec;
+			if ((fat_dbuf_lba >= lba) && (fat_dbuf_lba < lba + n)) fat_dbuf_lba = FAT_NO_SECTOR;
+			if (fat_disk_write(lba, src + done, n) != FAT_OK) break;
+			n *= FAT_SECTOR_SIZE;
+		}
+		else
+		{
+			// Read, modify, write through the sector cache
+			p = fat_sector(lba);
+			if (p == NULL) break;
+			n = FAT_SECTOR_SIZE - off;
+			if (n > len - done) n = len - done;
+			memcpy(p + off, src + done, n);
+			if (fat_disk_write(lba, p, 1) != FAT_OK)
+			{
+				fat_dbuf_lba = FAT_NO_SECTOR;
+				break;
+			}
+		}
+		done += n;
+		file->Pos += n;
+	}
+	return done;
+}
+
+
+/*********************************************************************//**
+ * @brief		Get the disk traffic counters
+ * @param[out]	stats: pointer to FAT_STATS_Type
+ * @return 		None
+ **********************************************************************/
+void FAT_GetStats (FAT_STATS_Type *stats)
+{
+	*stats = fat_stats;
+}
+
+/**
+ * @}
+ */
+
+/* End of Public Functions ---------------------------------------------------- */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -0,0 +1,830 @@
+/******************************************************************//**
+* @file		lpc_fmt.c
+* @brief	Contains all functions support for the formatting core:
+*           number fields are rendered without divide instructions
+*           into a caller supplied buffer that a sink drains (UART
+*           ring, GLCD text or plain memory)
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @addtogroup FMT
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc_system_init.h"
+#include "lpc_fmt.h"
+#include <string.h>
+
+/* If this source file built with example, the LPC17xx FW library configuration
+ * file in each example directory ("lpc17xx_libcfg.h") must be included,
+ * otherwise the default FW library configuration file must be included instead
+ */
+
+/* Private Macros ------------------------------------------------------------- */
+/** @defgroup FMT_Private_Macros FMT Private Macros
+ * @{
+ */
+
+#define FMT_WIDTH(spec)		(((spec) >> 8) & 0xFF)
+#define FMT_FILL(spec)		(((spec) >> 16) & 0xFF)
+#define FMT_FLAGS(spec)		((spec) >> 24)
+
+/** Number field rendered in place, sign and padding included */
+#define FMT_FIELD_MAX		32
+
+/** Quotient of v / 100 for any 32-bit v, by a reciprocal multiply */
+#define FMT_DIV100(v)		((uint32_t)(((uint64_t)(v) * 0x51EB851FULL) >> 37))
+
+/**
+ * @}
+ */
+
+
+/* Private Variables ---------------------------------------------------------- */
+static const char fmt_hex[16] = "0123456789ABCDEF";
+
+/** Two digit groups "00" .. "99", halves the multiply steps */
+static const char fmt_pairs[200] =
+	"0001020304050607080910111213141516171819"
+	"2021222324252627282930313233343536373839"
+	"4041424344454647484950515253545556575859"
+	"6061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899";
+
+
+/* Private Functions ---------------------------------------------------------- */
+static void fmt_putc_slow(FMT_OUT_Type *out, char c);
+static void fmt_write(FMT_OUT_Type *out, const char *s, uint32_t len);
+static void fmt_pad(FMT_OUT_Type *out, char c, uint32_t n);
+static char *fmt_dec(char *end, uint32_t val);
+static char *fmt_hexs(char *end, uint32_t val, uint8_t digits);
+static void fmt_field(FMT_OUT_Type *out, const char *s, uint32_t len, char sign, uint32_t spec);
+static void fmt_num(FMT_OUT_Type *out, char *buf, char *s, char sign, uint32_t spec);
+#ifdef RTC_MODE
+static void fmt_time(FMT_OUT_Type *out, RTC_TIME_Type *t);
+static void fmt_date(FMT_OUT_Type *out, RTC_TIME_Type *t);
+#endif
+
+/*********************************************************************//**
+ * @brief		Append one character, the fast path is a single store
+ * @param[in]	out		Formatter output
+ * @param[in]	c		Character
+ * @return		None
+ **********************************************************************/
+static __INLINE void fmt_putc(FMT_OUT_Type *out, char c)
+{
+	if (out->Len < out->Size)
+	{
+		out->Buf[out->Len++] = c;
+		out->Total++;
+		return;
+	}
+	fmt_putc_slow(out, c);
+}
+
+/*********************************************************************//**
+ * @brief		fmt_putc() slow path: hand the full buffer to the sink
+ * @param[in]	out		Formatter output
+ * @param[in]	c		Character
+ * @return		None
+ **********************************************************************/
+static void fmt_putc_slow(FMT_OUT_Type *out, char c)
+{
+	if (out->Flush)
+	{
+		out->Flush(out);
+	}
+	if (out->Len < out->Size)
+	{
+		out->Buf[out->Len++] = c;
+	}
+	out->Total++;
+}
+
+/*********************************************************************//**
+ * @brief		Append a run of characters
+ * @param[in]	out		Formatter output
+ * @param[in]	s		Characters
+ * @param[in]	len		Number of characters
+ * @return		None
+ **********************************************************************/
+static void fmt_write(FMT_OUT_Type *out, const char *s, uint32_t len)
+{
+	uint32_t n;
+
+	out->Total += len;
+	if (len <= (out->Size - out->Len))
+	{
+		// Short runs are the common case, copy them without a call
+		char *d = &out->Buf[out->Len];
+		out->Len += len;
+		while (len--)
+		{
+			*d++ = *s++;
+		}
+		return;
+	}
+	while (len)
+	{
+		if ((out->Len == out->Size) && out->Flush)
+		{
+			out->Flush(out);
+		}
+		n = out->Size - out->Len;
+		if (n == 0)
+		{
+			return;
+		}
+		if (n > len)
+		{
+			n = len;
+		}
+		memcpy(&out->Buf[out->Len], s, n);
+		out->Len += n;
+		s += n;
+		len -= n;
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Append n copies of a fill character
+ * @param[in]	out		Formatter output
+ * @param[in]	c		Fill character
+ * @param[in]	n		Count
+ * @return		None
+ **********************************************************************/
+static void fmt_pad(FMT_OUT_Type *out, char c, uint32_t n)
+{
+	while (n--)
+	{
+		fmt_putc(out, c);
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Render decimal digits backwards, two per reciprocal
+ * 				multiply
+ * @param[in]	end		One past the last digit
+ * @param[in]	val		Value
+ * @return		First digit
+ **********************************************************************/
+static char *fmt_dec(char *end, uint32_t val)
+{
+	uint32_t q, r;
+
+	while (val >= 100)
+	{
+		q = FMT_DIV100(val);
+		r = (val - (q * 100)) * 2;
+		*--end = fmt_pairs[r + 1];
+		*--end = fmt_pairs[r];
+		val = q;
+	}
+	if (val >= 10)
+	{
+		*--end = fmt_pairs[(val * 2) + 1];
+		*--end = fmt_pairs[val * 2];
+	}
+	else
+	{
+		*--end = (char)('0' + val);
+	}
+	return end;
+}
+
+/*********************************************************************//**
+ * @brief		Render hexadecimal digits backwards
+ * @param[in]	end		One past the last digit
+ * @param[in]	val		Value
+ * @param[in]	digits	Exact number of digits 1..8, 0 for as many as
+ * 						the value needs
+ * @return		First digit
+ **********************************************************************/
+static char *fmt_hexs(char *end, uint32_t val, uint8_t digits)
+{
+	if (digits == 0)
+	{
+		do
+		{
+			*--end = fmt_hex[val & 0x0F];
+			val >>= 4;
+		} while (val);
+		return end;
+	}
+	while (digits--)
+	{
+		*--end = fmt_hex[val & 0x0F];
+		val >>= 4;
+	}
+	return end;
+}
+
+/*********************************************************************//**
+ * @brief		Append a rendered field with its sign and padding
+ * @param[in]	out		Formatter output
+ * @param[in]	s		Field text
+ * @param[in]	len		Length of the text
+ * @param[in]	sign	'-' or 0
+ * @param[in]	spec	FMT_SPEC() of the field
+ * @return		None
+ **********************************************************************/
+static void fmt_field(FMT_OUT_Type *out, const char *s, uint32_t len, char sign, uint32_t spec)
+{
+	uint32_t width = FMT_WIDTH(spec), used = len;
+	char fill = (char)FMT_FILL(spec);
+
+	if (sign && !(FMT_FLAGS(spec) & FMT_DIGITS))
+	{
+		used++;
+	}
+	width = (width > used) ? (width - used) : 0;
+	if (fill == 0)
+	{
+		fill = ' ';
+	}
+
+	if (FMT_FLAGS(spec) & FMT_LEFT)
+	{
+		if (sign)
+		{
+			fmt_putc(out, sign);
+		}
+		fmt_write(out, s, len);
+		fmt_pad(out, ' ', width);
+		return;
+	}
+	// Zeros go between the sign and the digits, spaces in front of both
+	if (sign && (fill == '0'))
+	{
+		fmt_putc(out, sign);
+		sign = 0;
+	}
+	fmt_pad(out, fill, width);
+	if (sign)
+	{
+		fmt_putc(out, sign);
+	}
+	fmt_write(out, s, len);
+}
+
+/*********************************************************************//**
+ * @brief		Append a number field. Right aligned fields are padded in
+ * 				place in front of the digits and written with one copy.
+ * @param[in]	out		Formatter output
+ * @param[in]	buf		FMT_FIELD_MAX characters, the digits end it
+ * @param[in]	s		First digit
+ * @param[in]	sign	'-' or 0
+ * @param[in]	spec	FMT_SPEC() of the field
+ * @return		None
+ **********************************************************************/
+static void fmt_num(FMT_OUT_Type *out, char *buf, char *s, char sign, uint32_t spec)
+{
+	char *end = &buf[FMT_FIELD_MAX], *stop;
+	uint32_t width = FMT_WIDTH(spec);
+	char fill = (char)FMT_FILL(spec);
+
+	if ((FMT_FLAGS(spec) & FMT_LEFT) || (width >= FMT_FIELD_MAX))
+	{
+		fmt_field(out, s, end - s, sign, spec);
+		return;
+	}
+	stop = end - width;
+	if (sign && (FMT_FLAGS(spec) & FMT_DIGITS))
+	{
+		stop--;
+	}
+	if (fill == '0')
+	{
+		if (sign)
+		{
+			stop++;
+		}
+		while (s > stop)
+		{
+			*--s = '0';
+		}
+		if (sign)
+		{
+			*--s = sign;
+		}
+	}
+	else
+	{
+		if (sign)
+		{
+			*--s = sign;
+		}
+		if (fill == 0)
+		{
+			fill = ' ';
+		}
+		while (s > stop)
+		{
+			*--s = fill;
+		}
+	}
+	fmt_write(out, s, end - s);
+}
+
+#ifdef RTC_MODE
+/*********************************************************************//**
+ * @brief		Append "hh:mm:ss"
+ * @param[in]	out		Formatter output
+ * @param[in]	t		Time
+ * @return		None
+ **********************************************************************/
+static void fmt_time(FMT_OUT_Type *out, RTC_TIME_Type *t)
+{
+	FMT_Uint(out, t->HOUR, FMT_SPEC(FMT_UDEC, 2, '0', 0));
+	fmt_putc(out, ':');
+	FMT_Uint(out, t->MIN, FMT_SPEC(FMT_UDEC, 2, '0', 0));
+	fmt_putc(out, ':');
+	FMT_Uint(out, t->SEC, FMT_SPEC(FMT_UDEC, 2, '0', 0));
+}
+
+/*********************************************************************//**
+ * @brief		Append "dd/mm/yyyy"
+ * @param[in]	out		Formatter output
+ * @param[in]	t		Date
+ * @return		None
+ **********************************************************************/
+static void fmt_date(FMT_OUT_Type *out, RTC_TIME_Type *t)
+{
+	FMT_Uint(out, t->DOM, FMT_SPEC(FMT_UDEC, 2, '0', 0));
+	fmt_putc(out, '/');
+	FMT_Uint(out, t->MONTH, FMT_SPEC(FMT_UDEC, 2, '0', 0));
+	fmt_putc(out, '/');
+	FMT_Uint(out, t->YEAR, FMT_SPEC(FMT_UDEC, 4, '0', 0));
+}
+#endif
+
+/* End of Private Functions --------------------------------------------------- */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @addtogroup FMT_Public_Functions
+ * @{
+ */
+
+/*********************************************************************//**
+ * @brief		Render an unsigned value in decimal
+ * @param[out]	buf		At least 10 characters, not terminated
+ * @param[in]	val		Value
+ * @return		Number of digits
+ **********************************************************************/
+uint32_t FMT_U32ToDec(char *buf, uint32_t val)
+{
+	char tmp[FMT_NUM_MAX];
+	char *s = fmt_dec(&tmp[FMT_NUM_MAX], val);
+	uint32_t len = &tmp[FMT_NUM_MAX] - s;
+
+	memcpy(buf, s, len);
+	return len;
+}
+
+/*********************************************************************//**
+ * @brief		Render a value in upper case hexadecimal
+ * @param[out]	buf		At least 8 characters, not terminated
+ * @param[in]	val		Value
+ * @param[in]	digits	Exact number of digits 1..8, 0 for as many as
+ * 						the value needs
+ * @return		Number of digits
+ **********************************************************************/
+uint32_t FMT_U32ToHex(char *buf, uint32_t val, uint8_t digits)
+{
+	char tmp[8];
+	char *s;
+	uint32_t len;
+
+	if (digits > 8)
+	{
+		digits = 8;
+	}
+	s = fmt_hexs(&tmp[8], val, digits);
+	len = &tmp[8] - s;
+	memcpy(buf, s, len);
+	return len;
+}
+
+/*********************************************************************//**
+ * @brief		Set up an output on a memory buffer, what does not fit
+ * 				is dropped but still counted in Total
+ * @param[out]	out		Formatter output
+ * @param[in]	buf		Buffer
+ * @param[in]	size	Size of buf
+ * @return		None
+ **********************************************************************/
+void FMT_MemInit(FMT_OUT_Type *out, char *buf, uint32_t size)
+{
+	out->Buf = buf;
+	out->Size = size;
+	out->Len = 0;
+	out->Total = 0;
+	out->Flush = NULL;
+	out->Arg = NULL;
+}
+
+/*********************************************************************//**
+ * @brief		Append one character
+ * @param[in]	out		Formatter output
+ * @param[in]	c		Character
+ * @return		None
+ **********************************************************************/
+void FMT_Putc(FMT_OUT_Type *out, char c)
+{
+	fmt_putc(out, c);
+}
+
+/*********************************************************************//**
+ * @brief		Append a string field
+ * @param[in]	out		Formatter output
+ * @param[in]	s		Terminated string
+ * @param[in]	spec	FMT_SPEC() width and FMT_LEFT, conversion and
+ * 						fill are ignored
+ * @return		None
+ **********************************************************************/
+void FMT_Str(FMT_OUT_Type *out, const char *s, uint32_t spec)
+{
+	fmt_field(out, s, strlen(s), 0, spec & ~(0xFFUL << 16));
+}
+
+/*********************************************************************//**
+ * @brief		Append a signed decimal field
+ * @param[in]	out		Formatter output
+ * @param[in]	val		Value
+ * @param[in]	spec	FMT_SPEC() of the field, the conversion is ignored
+ * @return		None
+ **********************************************************************/
+void FMT_Int(FMT_OUT_Type *out, int32_t val, uint32_t spec)
+{
+	char tmp[FMT_FIELD_MAX];
+	char *s;
+	// Negate as unsigned so INT32_MIN converts too
+	uint32_t u = (val < 0) ? (0U - (uint32_t)val) : (uint32_t)val;
+
+	s = fmt_dec(&tmp[FMT_FIELD_MAX], u);
+	fmt_num(out, tmp, s, (val < 0) ? '-' : 0, spec);
+}
+
+/*********************************************************************//**
+ * @brief		Append an unsigned decimal or hexadecimal field
+ * @param[in]	out		Formatter output
+ * @param[in]	val		Value
+ * @param[in]	spec	FMT_SPEC() of the field: FMT_HEX, otherwise
+ * 						decimal
+ * @return		None
+ **********************************************************************/
+void FMT_Uint(FMT_OUT_Type *out, uint32_t val, uint32_t spec)
+{
+	char tmp[FMT_FIELD_MAX];
+	char *s;
+
+	if ((spec & 0xFF) == FMT_HEX)
+	{
+		s = fmt_hexs(&tmp[FMT_FIELD_MAX], val, 0);
+	}
+	else
+	{
+		s = fmt_dec(&tmp[FMT_FIELD_MAX], val);
+	}
+	fmt_num(out, tmp, s, 0, spec);
+}
+
+/*********************************************************************//**
+ * @brief		Format into an output
+ *
+ * @par			Standard conversions "%c %s %d %i %u %x %X %%" with the
+ * 				'-' and '0' flags, a width or '*' and an ignored 'l'.
+ * 				Hexadecimal is always upper case.
+ *
+ * 				The library forms "%dfn" and "%xfn" (fill '0', width n
+ * 				1..9 digits, sign not counted) are still accepted, so
+ * 				"%d02" and "%02d" print the same for positive values.
+ *
+ * 				Custom conversions "%b %t %y %a"
+ *				"%b"	prints a byte as two hex digits
+ *				"%t"    prints current time (RTC_MODE)
+ *				"%y"    prints current date (RTC_MODE)
+ *				"%a"    prints alarm time and date (RTC_MODE)
+ *
+ * 				An unknown conversion character is printed as it is.
+ * @param[in]	out		Formatter output, flushed at the end
+ * @param[in]	format	Format string
+ * @param[in]	ap		Arguments
+ * @return		Number of characters produced
+ **********************************************************************/
+uint32_t FMT_VFormat(FMT_OUT_Type *out, const char *format, va_list ap)
+{
+	uint32_t start = out->Total, width, flags;
+	char c, fill;
+	char tmp[2];
+	const char *lit;
+#ifdef RTC_MODE
+	RTC_TIME_Type FullTime;
+#endif
+
+	for (;;)
+	{
+		// Literal run up to the next '%'
+		lit = format;
+		while (*format && (*format != '%'))
+		{
+			format++;
+		}
+		if (format != lit)
+		{
+			fmt_write(out, lit, format - lit);
+		}
+		if (*format == 0)
+		{
+			break;
+		}
+		format++;
+
+		flags = 0;
+		fill = ' ';
+		width = 0;
+		for (;; format++)
+		{
+			if (*format == '-')
+			{
+				flags |= FMT_LEFT;
+			}
+			else if (*format == '0')
+			{
+				fill = '0';
+			}
+			else
+			{
+				break;
+			}
+		}
+		if (*format == '*')
+		{
+			width = (uint32_t)va_arg(ap, int);
+			format++;
+		}
+		while ((*format >= '0') && (*format <= '9'))
+		{
+			width = (width * 10) + (*format++ - '0');
+		}
+		if (*format == 'l')
+		{
+			format++;
+		}
+		if (width > 0xFF)
+		{
+			width = 0xFF;
+		}
+
+		c = *format++;
+		// Library form "%d02": fill '0' and a digit count after the conversion
+		if (((c == 'd') || (c == 'x')) && (format[0] == '0') && (format[1] >= '1') && (format[1] <= '9'))
+		{
+			fill = '0';
+			width = format[1] - '0';
+			flags |= FMT_DIGITS;
+			format += 2;
+		}
+
+		switch (c)
+		{
+		case 'd':
+		case 'i':
+			FMT_Int(out, va_arg(ap, int32_t), FMT_SPEC(FMT_DEC, width, fill, flags));
+			break;
+		case 'u':
+			FMT_Uint(out, va_arg(ap, uint32_t), FMT_SPEC(FMT_UDEC, width, fill, flags));
+			break;
+		case 'x':
+		case 'X':
+			FMT_Uint(out, va_arg(ap, uint32_t), FMT_SPEC(FMT_HEX, width, fill, flags));
+			break;
+		case 'c':
+			tmp[0] = (char)va_arg(ap, int);
+			fmt_field(out, tmp, 1, 0, FMT_SPEC(0, width, ' ', flags));
+			break;
+		case 's':
+			FMT_Str(out, va_arg(ap, const char *), FMT_SPEC(0, width, 0, flags));
+			break;
+		case 'b':
+			fmt_hexs(&tmp[2], (uint8_t)va_arg(ap, int), 2);
+			fmt_write(out, tmp, 2);
+			break;
+#ifdef RTC_MODE
+		case 't':
+			RTC_GetFullTime(LPC_RTC, &FullTime);
+			fmt_time(out, &FullTime);
+			break;
+		case 'y':
+			RTC_GetFullTime(LPC_RTC, &FullTime);
+			fmt_date(out, &FullTime);
+			break;
+		case 'a':
+			RTC_GetFullAlarmTime(LPC_RTC, &FullTime);
+			fmt_write(out, "Time: ", 6);
+			fmt_time(out, &FullTime);
+			fmt_write(out, "  Date: ", 8);
+			fmt_date(out, &FullTime);
+			break;
+#endif
+		case 0:
+			format--;
+			break;
+		default:
+			fmt_putc(out, c);
+			break;
+		}
+	}
+
+	if (out->Flush && out->Len)
+	{
+		out->Flush(out);
+	}
+	return out->Total - start;
+}
+
+/*********************************************************************//**
+ * @brief		Format into an output, see FMT_VFormat()
+ * @param[in]	out		Formatter output
+ * @param[in]	format	Format string
+ * @param[in]   ...		Arguments
+ * @return		Number of characters produced
+ **********************************************************************/
+uint32_t FMT_Format(FMT_OUT_Type *out, const char *format, ...)
+{
+	uint32_t n;
+	va_list ap;
+
+	va_start(ap, format);
+	n = FMT_VFormat(out, format, ap);
+	va_end(ap);
+	return n;
+}
+
+/*********************************************************************//**
+ * @brief		Format into a memory buffer, see FMT_VFormat()
+ * @param[out]	buf		Buffer, always terminated when size is not 0
+ * @param[in]	size	Size of buf
+ * @param[in]	format	Format string
+ * @param[in]   ...		Arguments
+ * @return		Length of the full text, a result of size or more means
+ * 				it was cut short
+ **********************************************************************/
+uint32_t FMT_Snprintf(char *buf, uint32_t size, const char *format, ...)
+{
+	FMT_OUT_Type out;
+	uint32_t n;
+	va_list ap;
+
+	FMT_MemInit(&out, buf, size ? (size - 1) : 0);
+	va_start(ap, format);
+	n = FMT_VFormat(&out, format, ap);
+	va_end(ap);
+	if (size)
+	{
+		buf[out.Len] = 0;
+	}
+	return n;
+}
+
+/**
+ * @}
+ */
+
+/* End of Public Functions ---------------------------------------------------- */
+
+
+#ifdef FMT_BENCH_MODE
+/* Private Functions ---------------------------------------------------------- */
+/** @defgroup FMT_Private_Functions FMT Private Functions
+ * @{
+ */
+
+#define FMT_BENCH_FIELDS	4096
+#define FMT_BENCH_RUNS		20
+
+static int32_t fmt_bench_val[FMT_BENCH_FIELDS];
+static char fmt_bench_old[FMT_BENCH_FIELDS * 9];
+static char fmt_bench_new[FMT_BENCH_FIELDS * 9];
+
+/*********************************************************************//**
+ * @brief		Host time stamp counter
+ **********************************************************************/
+static __INLINE uint64_t fmt_bench_cycles (void)
+{
+	return __builtin_ia32_rdtsc();
+}
+
+/*********************************************************************//**
+ * @brief		Divide and modulo conversion loop formerly used by printf
+ * 				and gprintf for "%dfn" and "%xfn"
+ **********************************************************************/
+static char *fmt_bench_legacy (char *p, uint32_t u_val, uint32_t base, uint32_t width, Bool neg)
+{
+	static const unsigned int width_dec[8] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000};
+	static const unsigned int width_hex[8] = { 0x1, 0x10, 0x100, 0x1000, 0x10000, 0x100000, 0x1000000, 0x10000000};
+	volatile uint32_t vbase = base;
+	uint32_t div_val = (base == 10) ? width_dec[width - 1] : width_hex[width - 1];
+
+	if (neg)
+	{
+		u_val = -u_val;
+		*p++ = '-';
+	}
+	while (div_val > 1 && div_val > u_val)
+	{
+		div_val /= vbase;
+		*p++ = '0';
+	}
+	do
+	{
+		*p++ = fmt_hex[u_val / div_val];
+		u_val %= div_val;
+		div_val /= vbase;
+	} while (div_val);
+	return p;
+}
+
+/**
+ * @}
+ */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @addtogroup FMT_Public_Functions
+ * @{
+ */
+
+/*********************************************************************//**
+ * @brief		Time "%d08" and "%x08" fields against the divide and
+ * 				modulo loop on the host
+ * @param[out]	dec		Signed decimal result
+ * @param[out]	hex		Hexadecimal result
+ * @return		None
+ **********************************************************************/
+void FMT_Benchmark (FMT_BENCH_Type *dec, FMT_BENCH_Type *hex)
+{
+	FMT_OUT_Type out;
+	char *p = fmt_bench_old;
+	uint64_t start;
+	uint32_t i, run, seed = 1;
+
+	for (i = 0; i < FMT_BENCH_FIELDS; i++)
+	{
+		seed = (seed * 1103515245) + 12345;
+		// Spread over all lengths, "%d08" holds 8 digits
+		fmt_bench_val[i] = (int32_t)((seed >> 8) % (1UL << (1 + (i % 26)))) * ((i & 4) ? -1 : 1);
+	}
+
+	dec->Fields = hex->Fields = FMT_BENCH_FIELDS * FMT_BENCH_RUNS;
+
+	start = fmt_bench_cycles();
+	for (run = 0; run < FMT_BENCH_RUNS; run++)
+	{
+		for (p = fmt_bench_old, i = 0; i < FMT_BENCH_FIELDS; i++)
+			p = fmt_bench_legacy(p, fmt_bench_val[i], 10, 8, (fmt_bench_val[i] < 0) ? TRUE : FALSE);
+	}
+	dec->OldCycles = fmt_bench_cycles() - start;
+	start = fmt_bench_cycles();
+	for (run = 0; run < FMT_BENCH_RUNS; run++)
+	{
+		FMT_MemInit(&out, fmt_bench_new, sizeof(fmt_bench_new));
+		for (i = 0; i < FMT_BENCH_FIELDS; i++)
+			FMT_Int(&out, fmt_bench_val[i], FMT_SPEC(FMT_DEC, 8, '0', FMT_DIGITS));
+	}
+	dec->NewCycles = fmt_bench_cycles() - start;
+	dec->Match = ((uint32_t)(p - fmt_bench_old) == out.Len) && !memcmp(fmt_bench_old, fmt_bench_new, out.Len) ? TRUE : FALSE;
+
+	start = fmt_bench_cycles();
+	for (run = 0; run < FMT_BENCH_RUNS; run++)
+	{
+		for (p = fmt_bench_old, i = 0; i < FMT_BENCH_FIELDS; i++)
+			p = fmt_bench_legacy(p, fmt_bench_val[i], 16, 8, FALSE);
+	}
+	hex->OldCycles = fmt_bench_cycles() - start;
+	start = fmt_bench_cycles();
+	for (run = 0; run < FMT_BENCH_RUNS; run++)
+	{
+		FMT_MemInit(&out, fmt_bench_new, sizeof(fmt_bench_new));
+		for (i = 0; i < FMT_BENCH_FIELDS; i++)
+			FMT_Uint(&out, fmt_bench_val[i], FMT_SPEC(FMT_HEX, 8, '0', 0));
+	}
+	hex->NewCycles = fmt_bench_cycles() - start;
+	hex->Match = ((uint32_t)(p - fmt_bench_old) == out.Len) && !memcmp(fmt_bench_old, fmt_bench_new, out.Len) ? TRUE : FALSE;
+}
+
+/**
+ * @}
+ */
+#endif /* FMT_BENCH_MODE */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -0,0 +1,493 @@
+/******************************************************************//**
+* @file		lpc_freq_meter.c
+* @brief	Contains all functions support for the input capture
+* 			frequency meter on LPC17xx
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @addtogroup FREQ_METER
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc_system_init.h"
+#include "lpc_freq_meter.h"
+
+/* If this source file built with example, the LPC17xx FW library configuration
+ * file in each example directory ("lpc17xx_libcfg.h") must be included,
+ * otherwise the default FW library configuration file must be included instead
+ */
+
+/* Private Macros ------------------------------------------------------------- */
+/** @defgroup FREQ_METER_Private_Macros FREQ_METER Private Macros
+ * @{
+ */
+
+#define FREQ_QUEUE_MASK			(FREQ_QUEUE_SIZE - 1)
+/** No channel holds TIMER1 in counter mode */
+#define FREQ_COUNTER_NONE		0xFF
+/** Periods after which a block is checked for a rate that needs gated
+ * counting, so a fast input does not flood the CPU for a whole gate */
+#define FREQ_RATE_EDGES			16
+/** Capture interrupt flags of all channels in TIMER1 IR */
+#define FREQ_IR_CAP				(TIM_IR_CLR(4) | TIM_IR_CLR(5))
+
+/**
+ * @}
+ */
+
+
+/* Private Types -------------------------------------------------------------- */
+/** @defgroup FREQ_METER_Private_Types FREQ_METER Private Types
+ * @{
+ */
+
+/** Channel state. In period mode start is the capture the running block
+ * began at, in gated mode the edge count at the last gate. */
+typedef struct {
+	uint8_t mode;
+	Bool armed;					/**< start is valid */
+	Bool seen;					/**< An edge came in this gate */
+	uint8_t idle;				/**< Gates without an edge */
+	uint32_t start;
+	uint32_t edges;				/**< Periods in the running block */
+} FREQ_CH_Type;
+
+/**
+ * @}
+ */
+
+
+/* Private Variables ---------------------------------------------------------- */
+static FREQ_CH_Type freq_ch[FREQ_CHANNELS];
+static uint8_t freq_counter = FREQ_COUNTER_NONE;
+
+/** TIMER1 clock, block length and rate check in TIMER1 clocks */
+static uint32_t freq_pclk, freq_gate_ticks, freq_rate_ticks;
+/** Edges in a gate to Hz with 8 fraction bits, 16 more fraction bits */
+static uint64_t freq_gate_k;
+/** Edges in a gate below FREQ_PERIOD_HZ */
+static uint32_t freq_gate_low;
+
+/** Result queue, written from the TIMER1 and RIT interrupts (same
+ * priority, so one never preempts the other), read in thread mode */
+static FREQ_SAMPLE_Type freq_queue[FREQ_QUEUE_SIZE];
+static __IO uint32_t freq_head, freq_tail;
+
+static FREQ_STATS_Type freq_stats;
+
+
+/* Private Functions ---------------------------------------------------------- */
+static void freq_put (uint8_t ch, uint8_t mode, uint32_t edges, uint64_t freq);
+static void freq_capture (void);
+static void freq_to_gated (uint8_t ch);
+static void freq_to_period (void);
+
+/*********************************************************************//**
+ * @brief		Queue one result
+ * @param[in]	ch: channel
+ * @param[in]	mode: FREQ_MODE_PERIOD or FREQ_MODE_GATED
+ * @param[in]	edges: periods or edges measured
+ * @param[in]	freq: frequency, FREQ_FRAC_BITS fraction bits
+ * @return 		None
+ **********************************************************************/
+static void freq_put (uint8_t ch, uint8_t mode, uint32_t edges, uint64_t freq)
+{
+	uint32_t head = freq_head;
+	FREQ_SAMPLE_Type *s;
+
+	if (((head + 1) & FREQ_QUEUE_MASK) == freq_tail)
+	{
+		freq_stats.Dropped++;
+		return;
+	}
+	s = &freq_queue[head];
+	s->Channel = ch;
+	s->Mode = mode;
+	s->Reserved = 0;
+	s->Edges = edges;
+	s->Freq = (freq > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32_t)freq;
+	freq_head = (head + 1) & FREQ_QUEUE_MASK;
+	freq_stats.Samples++;
+}
+
+
+/*********************************************************************//**
+ * @brief		Capture the rising edges of the channels in period mode,
+ * 				with an interrupt each
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+static void freq_capture (void)
+{
+	TIM_CAPTURECFG_Type cap;
+	uint8_t ch;
+
+	for (ch = 0; ch < FREQ_CHANNELS; ch++)
+	{
+		cap.CaptureChannel = ch;
+		cap.RisingEdge = (freq_ch[ch].mode == FREQ_MODE_PERIOD) ? ENABLE : DISABLE;
+		cap.FallingEdge = DISABLE;
+		cap.IntOnCaption = cap.RisingEdge;
+		TIM_ConfigCapture(LPC_TIM1, &cap);
+	}
+}
+
+
+/*********************************************************************//**
+ * @brief		Give TIMER1 to a channel as an edge counter. The other
+ * 				channels hold, TC no longer counts time for them.
+ * @param[in]	ch: channel
+ * @return 		None
+ **********************************************************************/
+static void freq_to_gated (uint8_t ch)
+{
+	uint8_t n;
+
+	for (n = 0; n < FREQ_CHANNELS; n++)
+	{
+		if (freq_ch[n].mode == FREQ_MODE_PERIOD)
+		{
+			freq_ch[n].mode = FREQ_MODE_HOLD;
+		}
+	}
+	freq_ch[ch].mode = FREQ_MODE_GATED;
+	freq_ch[ch].armed = FALSE;
+	freq_counter = ch;
+	freq_capture();
+	LPC_TIM1->CTCR = TIM_COUNTER_RISING_MODE | ((uint32_t)ch << 2);
+	LPC_TIM1->IR = FREQ_IR_CAP;
+	freq_stats.Switches++;
+}
+
+
+/*********************************************************************//**
+ * @brief		Put TIMER1 back to counting time and all channels that
+ * 				are on into period mode
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+static void freq_to_period (void)
+{
+	FREQ_CH_Type *c;
+	uint8_t n;
+
+	LPC_TIM1->CTCR = TIM_TIMER_MODE;
+	freq_counter = FREQ_COUNTER_NONE;
+	for (n = 0; n < FREQ_CHANNELS; n++)
+	{
+		c = &freq_ch[n];
+		if (c->mode != FREQ_MODE_OFF)
+		{
+			c->mode = FREQ_MODE_PERIOD;
+			c->armed = FALSE;
+			c->seen = FALSE;
+			c->idle = 0;
+		}
+	}
+	freq_capture();
+	LPC_TIM1->IR = FREQ_IR_CAP;
+	freq_stats.Switches++;
+}
+
+/* End of Private Functions --------------------------------------------------- */
+
+
+/** @addtogroup FREQ_METER_Public_Functions
+ * @{
+ */
+
+/* Public Functions ----------------------------------------------------------- */
+/*********************************************************************//**
+ * @brief		Initialize the meter: TIMER1 free running at CCLK as the
+ * 				capture time base and the RIT as the gate. All channels
+ * 				start off.
+ * @param[in]	gate_ms: gate time (ms), 0 for FREQ_GATE_MS. Up to
+ * 				FREQ_GATE_MAX_MS.
+ * @return 		None
+ **********************************************************************/
+void FREQ_Init (uint32_t gate_ms)
+{
+	TIM_TIMERCFG_Type tim;
+	uint32_t rit_pclk, ticks;
+	uint8_t ch;
+
+	if (gate_ms == 0)
+	{
+		gate_ms = FREQ_GATE_MS;
+	}
+	else if (gate_ms > FREQ_GATE_MAX_MS)
+	{
+		gate_ms = FREQ_GATE_MAX_MS;
+	}
+
+	NVIC_DisableIRQ(TIMER1_IRQn);
+	NVIC_DisableIRQ(RIT_IRQn);
+	for (ch = 0; ch < FREQ_CHANNELS; ch++)
+	{
+		freq_ch[ch].mode = FREQ_MODE_OFF;
+	}
+	freq_counter = FREQ_COUNTER_NONE;
+	freq_head = 0;
+	freq_tail = 0;
+
+	// Free running, never reset: periods are differences of captures.
+	// Counting at CCLK gives the finest period resolution.
+	tim.PrescaleOption = TIM_PRESCALE_TICKVAL;
+	tim.PrescaleValue = 1;
+	TIM_Init(LPC_TIM1, TIM_TIMER_MODE, &tim);
+	CLKPWR_SetPCLKDiv(CLKPWR_PCLKSEL_TIMER1, CLKPWR_PCLKSEL_CCLK_DIV_1);
+	freq_pclk = CLKPWR_GetPCLK(CLKPWR_PCLKSEL_TIMER1);
+	freq_gate_ticks = (freq_pclk / 1000) * gate_ms;
+	freq_rate_ticks = FREQ_RATE_EDGES * (freq_pclk / FREQ_GATED_HZ);
+	freq_capture();
+
+	// The gate, the counts of one gate are scaled by a multiply
+	RIT_Init(LPC_RIT);
+	RIT_TimerConfig(LPC_RIT, gate_ms);
+	rit_pclk = CLKPWR_GetPCLK(CLKPWR_PCLKSEL_RIT);
+	ticks = LPC_RIT->RICOMPVAL + 1;
+	freq_gate_k = ((uint64_t)rit_pclk << (FREQ_FRAC_BITS + 16)) / ticks;
+	freq_gate_low = (uint32_t)(((uint64_t)FREQ_PERIOD_HZ * ticks) / rit_pclk);
+
+	NVIC_SetPriority(TIMER1_IRQn, 2);
+	NVIC_SetPriority(RIT_IRQn, 2);
+	NVIC_EnableIRQ(TIMER1_IRQn);
+	NVIC_EnableIRQ(RIT_IRQn);
+	TIM_Cmd(LPC_TIM1, ENABLE);
+}
+
+
+/*********************************************************************//**
+ * @brief		Turn a channel on or off. A channel starts in period mode,
+ * 				or holds while another channel is gated.
+ * @param[in]	ch: channel 0..FREQ_CHANNELS-1
+ * @param[in]	NewState: ENABLE or DISABLE
+ * @return 		SUCCESS, or ERROR if the channel does not exist
+ **********************************************************************/
+Status FREQ_ChannelCmd (uint8_t ch, FunctionalState NewState)
+{
+	PINSEL_CFG_Type pin;
+	FREQ_CH_Type *c;
+	uint32_t primask;
+
+	if (ch >= FREQ_CHANNELS)
+	{
+		return ERROR;
+	}
+	c = &freq_ch[ch];
+	if (NewState == ENABLE)
+	{
+		// P1.18 CAP1.0, P1.19 CAP1.1
+		pin.Funcnum = 3;
+		pin.OpenDrain = 0;
+		pin.Pinmode = 0;
+		pin.Portnum = 1;
+		pin.Pinnum = 18 + ch;
+		PINSEL_ConfigPin(&pin);
+	}
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if (NewState == ENABLE)
+	{
+		if (c->mode == FREQ_MODE_OFF)
+		{
+			c->mode = (freq_counter == FREQ_COUNTER_NONE) ? FREQ_MODE_PERIOD : FREQ_MODE_HOLD;
+			c->armed = FALSE;
+			c->seen = FALSE;
+			c->idle = 0;
+		}
+	}
+	else
+	{
+		c->mode = FREQ_MODE_OFF;
+		if (freq_counter == ch)
+		{
+			freq_to_period();
+		}
+	}
+	if (freq_counter == FREQ_COUNTER_NONE)
+	{
+		freq_capture();
+	}
+	__set_PRIMASK(primask);
+
+	return SUCCESS;
+}
+
+
+/*********************************************************************//**
+ * @brief		Take the oldest result
+ * @param[out]	sample: result
+ * @return 		SUCCESS, or ERROR if the queue is empty
+ **********************************************************************/
+Status FREQ_Read (FREQ_SAMPLE_Type *sample)
+{
+	uint32_t tail = freq_tail;
+
+	if (tail == freq_head)
+	{
+		return ERROR;
+	}
+	*sample = freq_queue[tail];
+	freq_tail = (tail + 1) & FREQ_QUEUE_MASK;
+	return SUCCESS;
+}
+
+
+/*********************************************************************//**
+ * @brief		Get the mode of a channel
+ * @param[in]	ch: channel
+ * @return 		FREQ_MODE_xxx
+ **********************************************************************/
+uint8_t FREQ_GetMode (uint8_t ch)
+{
+	return (ch < FREQ_CHANNELS) ? freq_ch[ch].mode : FREQ_MODE_OFF;
+}
+
+
+/*********************************************************************//**
+ * @brief		TIMER1 capture interrupt, called from TIMER1_IRQHandler.
+ * 				Sums the periods of each channel in period mode from the
+ * 				difference of successive captures (wrap safe) and queues
+ * 				a result when a block spans the gate time.
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void FREQ_IntHandler (void)
+{
+	FREQ_CH_Type *c;
+	uint32_t cap, span;
+	uint8_t ch;
+
+	for (ch = 0; ch < FREQ_CHANNELS; ch++)
+	{
+		if (TIM_GetIntCaptureStatus(LPC_TIM1, (TIM_INT_TYPE)ch) == RESET)
+		{
+			continue;
+		}
+		TIM_ClearIntCapturePending(LPC_TIM1, (TIM_INT_TYPE)ch);
+		cap = TIM_GetCaptureValue(LPC_TIM1, (TIM_COUNTER_INPUT_OPT)ch);
+		c = &freq_ch[ch];
+		if (c->mode != FREQ_MODE_PERIOD)
+		{
+			continue;
+		}
+		freq_stats.Captures++;
+		c->seen = TRUE;
+		if (c->armed == FALSE)
+		{
+			c->start = cap;
+			c->edges = 0;
+			c->armed = TRUE;
+			continue;
+		}
+
+		// Reciprocal counting: whole periods over at least the gate
+		// time, so the resolution is one TIMER1 clock per block
+		c->edges++;
+		span = cap - c->start;
+		if ((span >= freq_gate_ticks) ||
+			((c->edges == FREQ_RATE_EDGES) && (span < freq_rate_ticks)))
+		{
+			freq_put(ch, FREQ_MODE_PERIOD, c->edges,
+					 ((((uint64_t)c->edges * freq_pclk) << FREQ_FRAC_BITS) + span / 2) / span);
+			if ((uint64_t)c->edges * freq_pclk > (uint64_t)FREQ_GATED_HZ * span)
+			{
+				freq_to_gated(ch);
+				return;
+			}
+			c->start = cap;
+			c->edges = 0;
+		}
+	}
+}
+
+
+/*********************************************************************//**
+ * @brief		RIT gate interrupt, called from RIT_IRQHandler. Queues
+ * 				the edges the gated channel counted in the gate, and
+ * 				reports 0 Hz for inputs in period mode that stopped.
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void FREQ_GateHandler (void)
+{
+	FREQ_CH_Type *c;
+	uint32_t tc, n;
+	uint8_t ch;
+
+	if (RIT_GetIntStatus(LPC_RIT) == RESET)
+	{
+		return;
+	}
+	freq_stats.Gates++;
+
+	if (freq_counter != FREQ_COUNTER_NONE)
+	{
+		c = &freq_ch[freq_counter];
+		tc = LPC_TIM1->TC;
+		if (c->armed == FALSE)
+		{
+			// First gate after the switch is partial
+			c->start = tc;
+			c->armed = TRUE;
+			return;
+		}
+		n = tc - c->start;
+		c->start = tc;
+		freq_put(freq_counter, FREQ_MODE_GATED, n, ((uint64_t)n * freq_gate_k + 0x8000) >> 16);
+		if (n < freq_gate_low)
+		{
+			freq_to_period();
+		}
+		return;
+	}
+
+	for (ch = 0; ch < FREQ_CHANNELS; ch++)
+	{
+		c = &freq_ch[ch];
+		if (c->mode != FREQ_MODE_PERIOD)
+		{
+			continue;
+		}
+		if (c->seen == TRUE)
+		{
+			c->idle = 0;
+		}
+		else if (++c->idle >= FREQ_TIMEOUT_GATES)
+		{
+			freq_put(ch, FREQ_MODE_PERIOD, 0, 0);
+			c->idle = 0;
+			c->armed = FALSE;
+		}
+		c->seen = FALSE;
+	}
+}
+
+
+/*********************************************************************//**
+ * @brief		Get the meter counters
+ * @param[out]	stats: pointer to FREQ_STATS_Type
+ * @return 		None
+ **********************************************************************/
+void FREQ_GetStats (FREQ_STATS_Type *stats)
+{
+	*stats = freq_stats;
+}
+
+/**
+ * @}
+ */
+
+/* End of Public Functions ---------------------------------------------------- */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -0,0 +1,406 @@
+/******************************************************************//**
+* @file		lpc_glcd_text.c
+* @brief	Contains all functions support for the GLCD text blitter:
+*           glyphs are expanded once into 16-bit color spans per
+*           fg/bg pair and a string is sent as one GRAM window, one
+*           streamed line per pixel row
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @addtogroup GTEXT
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc_glcd_text.h"
+#include "Font_Prop5x7.h"
+#include <string.h>
+
+/* If this source file built with example, the LPC17xx FW library configuration
+ * file in each example directory ("lpc17xx_libcfg.h") must be included,
+ * otherwise the default FW library configuration file must be included instead
+ */
+
+/* Private Types -------------------------------------------------------------- */
+/** @defgroup GTEXT_Private_Types GTEXT Private Types
+ * @{
+ */
+
+/**
+ * @brief Expanded glyph
+ */
+typedef struct
+{
+	const GTEXT_FONT_Type *font;		/* NULL while the slot is empty */
+	uint16_t fg, bg;					/* Colors it was expanded with */
+	uint8_t glyph;						/* Glyph index in font */
+	uint32_t stamp;						/* Last use, least recent is evicted */
+	uint16_t pix[GTEXT_SLOT_PIXELS];	/* Rows of font width pixels */
+} GTEXT_SLOT_T;
+
+/**
+ * @brief One glyph of the run being drawn
+ */
+typedef struct
+{
+	uint8_t glyph;						/* Glyph index in font */
+	uint8_t w;							/* Glyph width */
+	uint8_t c0, c1;						/* Visible columns, spacing included */
+	GTEXT_SLOT_T *slot;					/* Expanded glyph, NULL to expand per row */
+} GTEXT_CELL_T;
+
+/**
+ * @}
+ */
+
+
+/* Private Variables ---------------------------------------------------------- */
+/* Glyph data of the fixed fonts, defined by Font_24x16.h and Font_5x7.h
+ * in lpc_ssp_glcd.c */
+extern const int16_t Font_24x16[];
+extern const uint8_t default5x7[99][5];
+
+static GTEXT_SLOT_T gtext_cache[GTEXT_CACHE_SLOTS];
+static uint32_t gtext_clock;
+static GTEXT_STATS_Type gtext_stats;
+
+/* Run of glyphs and the pixel row streamed for it */
+static GTEXT_CELL_T gtext_cell[GTEXT_RUN_MAX];
+static uint16_t gtext_line[WIDTH];
+
+
+/* Private Functions ---------------------------------------------------------- */
+static uint8_t gtext_glyph(const GTEXT_FONT_Type *font, char c);
+static uint8_t gtext_width(const GTEXT_FONT_Type *font, uint8_t glyph);
+static uint32_t gtext_row(const GTEXT_FONT_Type *font, uint8_t glyph, uint8_t row);
+static void gtext_expand(uint16_t *p, uint32_t mask, uint8_t w, uint16_t fg, uint16_t bg);
+static GTEXT_SLOT_T *gtext_lookup(const GTEXT_FONT_Type *font, uint8_t glyph, uint16_t fg, uint16_t bg, uint32_t run);
+
+/*********************************************************************//**
+ * @brief		Glyph index of a character
+ * @param[in]	font	Font
+ * @param[in]	c		Character
+ * @return		Glyph index, the first glyph for codes not in the font
+ **********************************************************************/
+static uint8_t gtext_glyph(const GTEXT_FONT_Type *font, char c)
+{
+	uint8_t g = (uint8_t)c - font->First;
+
+	return (g < font->Count) ? g : 0;
+}
+
+/*********************************************************************//**
+ * @brief		Width of a glyph without spacing
+ * @param[in]	font	Font
+ * @param[in]	glyph	Glyph index
+ * @return		Width in pixels
+ **********************************************************************/
+static uint8_t gtext_width(const GTEXT_FONT_Type *font, uint8_t glyph)
+{
+	return (font->Format == GTEXT_FONT_PACKED) ? font->Widths[glyph] : font->Width;
+}
+
+/*********************************************************************//**
+ * @brief		Read one glyph row as a mask, bit 0 is the left column
+ * @param[in]	font	Font
+ * @param[in]	glyph	Glyph index
+ * @param[in]	row		Row
+ * @return		Row mask
+ **********************************************************************/
+static uint32_t gtext_row(const GTEXT_FONT_Type *font, uint8_t glyph, uint8_t row)
+{
+	const uint8_t *b;
+	uint32_t mask = 0, bit, n, i;
+
+	switch (font->Format)
+	{
+	case GTEXT_FONT_ROW16:
+		return (uint16_t)((const int16_t *)font->Bits)[(glyph * font->Height) + row];
+
+	case GTEXT_FONT_COL8:
+		b = (const uint8_t *)font->Bits + (glyph * font->Width);
+		for (i = 0; i < font->Width; i++)
+		{
+			mask |= ((b[i] >> row) & 1) << i;
+		}
+		return mask;
+
+	default:
+		n = font->Widths[glyph];
+		bit = row * n;
+		b = (const uint8_t *)font->Bits + font->Offsets[glyph] + (bit >> 3);
+		// Only the bytes holding this row, the next glyph may start after them
+		for (i = 0; (i * 8) < ((bit & 7) + n); i++)
+		{
+			mask |= (uint32_t)b[i] << (i * 8);
+		}
+		return (mask >> (bit & 7)) & ((1UL << n) - 1);
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Expand a row mask into color pixels
+ * @param[out]	p		w pixels
+ * @param[in]	mask	Row mask
+ * @param[in]	w		Width
+ * @param[in]	fg		Color of set bits
+ * @param[in]	bg		Color of clear bits
+ * @return		None
+ **********************************************************************/
+static void gtext_expand(uint16_t *p, uint32_t mask, uint8_t w, uint16_t fg, uint16_t bg)
+{
+	while (w--)
+	{
+		*p++ = (mask & 1) ? fg : bg;
+		mask >>= 1;
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Find a glyph in the cache or expand it into the least
+ * 				recently used slot not taken by the current run
+ * @param[in]	font	Font
+ * @param[in]	glyph	Glyph index
+ * @param[in]	fg		Foreground color
+ * @param[in]	bg		Background color
+ * @param[in]	run		Clock value at the start of the run
+ * @return		Slot, NULL if the glyph has to be expanded row by row
+ **********************************************************************/
+static GTEXT_SLOT_T *gtext_lookup(const GTEXT_FONT_Type *font, uint8_t glyph, uint16_t fg, uint16_t bg, uint32_t run)
+{
+	GTEXT_SLOT_T *s, *victim = NULL;
+	uint8_t w = gtext_width(font, glyph), r;
+
+	for (s = gtext_cache; s < &gtext_cache[GTEXT_CACHE_SLOTS]; s++)
+	{
+		if ((s->font == font) && (s->glyph == glyph) && (s->fg == fg) && (s->bg == bg))
+		{
+			s->stamp = ++gtext_clock;
+			gtext_stats.Hits++;
+			return s;
+		}
+		if ((s->stamp <= run) && ((victim == NULL) || (s->stamp < victim->stamp)))
+		{
+			victim = s;
+		}
+	}
+
+	if ((victim == NULL) || (((uint32_t)w * font->Height) > GTEXT_SLOT_PIXELS))
+	{
+		gtext_stats.Uncached++;
+		return NULL;
+	}
+
+	victim->font = font;
+	victim->glyph = glyph;
+	victim->fg = fg;
+	victim->bg = bg;
+	victim->stamp = ++gtext_clock;
+	for (r = 0; r < font->Height; r++)
+	{
+		gtext_expand(&victim->pix[r * w], gtext_row(font, glyph, r), w, fg, bg);
+	}
+	gtext_stats.Misses++;
+	return victim;
+}
+
+/* End of Private Functions --------------------------------------------------- */
+
+
+/* Public Variables ----------------------------------------------------------- */
+const GTEXT_FONT_Type GTEXT_Font_24x16 =
+{
+	GTEXT_FONT_ROW16, 16, 24, 0, ' ', 112, Font_24x16, NULL, NULL
+};
+
+const GTEXT_FONT_Type GTEXT_Font_5x7 =
+{
+	GTEXT_FONT_COL8, 5, 7, 1, ' ', 99, default5x7, NULL, NULL
+};
+
+const GTEXT_FONT_Type GTEXT_Font_Prop5x7 =
+{
+	GTEXT_FONT_PACKED, 5, 7, 1, ' ', 95, Prop5x7_Bits, Prop5x7_Width, Prop5x7_Offset
+};
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @addtogroup GTEXT_Public_Functions
+ * @{
+ */
+
+/*********************************************************************//**
+ * @brief		Width of a text, spacing included
+ * @param[in]	font	Font
+ * @param[in]	s		Text
+ * @param[in]	len		Number of characters
+ * @return		Width in pixels
+ **********************************************************************/
+uint16_t GTEXT_Width(const GTEXT_FONT_Type *font, const char *s, uint16_t len)
+{
+	uint32_t w = 0;
+
+	while (len--)
+	{
+		w += gtext_width(font, gtext_glyph(font, *s++)) + font->Spacing;
+	}
+	return (w > 0xFFFF) ? 0xFFFF : (uint16_t)w;
+}
+
+/*********************************************************************//**
+ * @brief		Draw a text on one line with an opaque background. The
+ * 				GRAM window is set once per GTEXT_RUN_MAX glyphs and each
+ * 				pixel row is streamed as one line, glyphs are taken from
+ * 				the cache. The text is clipped to the screen.
+ * @param[in]	x		Left edge, may be negative
+ * @param[in]	y		Top edge
+ * @param[in]	font	Font
+ * @param[in]	s		Text
+ * @param[in]	len		Number of characters
+ * @param[in]	fg		Text color
+ * @param[in]	bg		Background color
+ * @return		x of the pixel after the text
+ **********************************************************************/
+int16_t GTEXT_DrawText(int16_t x, int16_t y, const GTEXT_FONT_Type *font, const char *s, uint16_t len, uint16_t fg, uint16_t bg)
+{
+	GTEXT_CELL_T *c, *end;
+	int32_t gx = x, wx, left, right;
+	uint32_t run, w, h = font->Height, r;
+	uint16_t *p;
+	uint8_t span;
+
+	if ((y < 0) || (y >= HEIGHT))
+	{
+		return x + GTEXT_Width(font, s, len);
+	}
+	if ((y + h) > HEIGHT)
+	{
+		h = HEIGHT - y;
+	}
+
+	while (len)
+	{
+		// Lay out a run and keep only the columns on the screen
+		run = gtext_clock;
+		end = gtext_cell;
+		w = 0;
+		wx = -1;
+		for (; len && (end < &gtext_cell[GTEXT_RUN_MAX]); len--, s++)
+		{
+			end->glyph = gtext_glyph(font, *s);
+			end->w = gtext_width(font, end->glyph);
+			span = end->w + font->Spacing;
+			left = (gx < 0) ? -gx : 0;
+			right = ((gx + span) > WIDTH) ? (WIDTH - gx) : span;
+			if (left < right)
+			{
+				if (wx < 0)
+				{
+					wx = gx + left;
+				}
+				end->c0 = left;
+				end->c1 = right;
+				w += right - left;
+				end++;
+			}
+			gx += span;
+		}
+		if (w == 0)
+		{
+			continue;
+		}
+
+		for (c = gtext_cell; c < end; c++)
+		{
+			c->slot = (c->c0 < c->w) ? gtext_lookup(font, c->glyph, fg, bg, run) : NULL;
+		}
+
+		GLCD_Stream_Start(wx, y, w, h);
+		for (r = 0; r < h; r++)
+		{
+			p = gtext_line;
+			for (c = gtext_cell; c < end; c++)
+			{
+				span = (c->c1 < c->w) ? c->c1 : c->w;
+				if (c->c0 < span)
+				{
+					if (c->slot != NULL)
+					{
+						memcpy(p, &c->slot->pix[(r * c->w) + c->c0], (span - c->c0) * 2);
+					}
+					else
+					{
+						gtext_expand(p, gtext_row(font, c->glyph, r) >> c->c0, span - c->c0, fg, bg);
+					}
+					p += span - c->c0;
+				}
+				// Spacing columns
+				span = (c->c0 > c->w) ? c->c0 : c->w;
+				while (span < c->c1)
+				{
+					*p++ = bg;
+					span++;
+				}
+			}
+			GLCD_Stream_Pixels(gtext_line, w);
+		}
+		GLCD_Stream_Stop();
+
+		gtext_stats.Runs++;
+		gtext_stats.Glyphs += end - gtext_cell;
+		gtext_stats.Pixels += w * h;
+	}
+	return gx;
+}
+
+/*********************************************************************//**
+ * @brief		Draw a terminated string, see GTEXT_DrawText()
+ * @param[in]	x		Left edge, may be negative
+ * @param[in]	y		Top edge
+ * @param[in]	font	Font
+ * @param[in]	s		String
+ * @param[in]	fg		Text color
+ * @param[in]	bg		Background color
+ * @return		x of the pixel after the text
+ **********************************************************************/
+int16_t GTEXT_DrawString(int16_t x, int16_t y, const GTEXT_FONT_Type *font, const char *s, uint16_t fg, uint16_t bg)
+{
+	return GTEXT_DrawText(x, y, font, s, strlen(s), fg, bg);
+}
+
+/*********************************************************************//**
+ * @brief		Drop all expanded glyphs, needed only when font data in
+ * 				RAM was changed
+ * @param[in]	None
+ * @return		None
+ **********************************************************************/
+void GTEXT_CacheFlush(void)
+{
+	memset(gtext_cache, 0, sizeof(gtext_cache));
+	gtext_clock = 0;
+}
+
+/*********************************************************************//**
+ * @brief		Get the blitter counters
+ * @param[out]	stats	Counters
+ * @return		None
+ **********************************************************************/
+void GTEXT_GetStats(GTEXT_STATS_Type *stats)
+{
+	*stats = gtext_stats;
+}
+
+/**
+ * @}
+ */
+
+/* End of Public Functions ---------------------------------------------------- */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -0,0 +1,5704 @@
+/******************************************************************//**
+* @file		lpc_host_sim.c
+* @brief	Contains the host side LPC17xx register simulator. Peripheral
+* 			blocks are mapped at their real bus addresses, every register
+* 			access is trapped and forwarded to a behavioural model which
+* 			is driven by a virtual CPU clock.
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @addtogroup HOSTSIM
+ * @{
+ */
+
+#ifdef LPC_HOST_SIM
+#define _GNU_SOURCE
+#endif
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc_host_sim.h"
+
+#ifdef LPC_HOST_SIM
+
+#include <signal.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <math.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+
+/* Private Macros ------------------------------------------------------------- */
+#define SIM_NEVER			(~(uint64_t)0)
+#define SIM_PAGE			0x1000
+#define SIM_NUM_IRQ			35
+#define SIM_EFLAGS_TF		0x100
+
+/** Backdoor access to a simulated register */
+#define SIM_DOOR(m, off)	(*(volatile uint32_t *)((m)->regs + (off)))
+/** Register offset inside a CMSIS peripheral structure */
+#define SIM_OFS(type, reg)	((uint32_t)offsetof(type, reg))
+
+/** Bus windows for host memory above 4 GB (stack, heap): a 16 MB aligned
+ * host block gets a 32 MB window in the range the LPC17xx leaves unused */
+#define SIM_BUSWIN_BASE		0x60000000UL
+#define SIM_BUSWIN_SHIFT	25
+#define SIM_BUSWIN_NUM		16
+#define SIM_BUSWIN_ALIGN	0xFFFFFFUL
+
+/* Private Types -------------------------------------------------------------- */
+typedef struct SIM_MODEL SIM_MODEL_T;
+
+/** Behavioural model of one peripheral block */
+struct SIM_MODEL {
+	uint32_t base;
+	uint32_t size;
+	uint32_t (*read)(SIM_MODEL_T *m, uint32_t off, Bool peek);
+	void (*write)(SIM_MODEL_T *m, uint32_t off, uint32_t val);
+	void (*tick)(SIM_MODEL_T *m);
+	uint64_t next;				/* Next event on the virtual clock */
+	uint8_t *regs;				/* Backdoor view of the register block */
+};
+
+/** Bus region mapped at its real address */
+typedef struct {
+	uint32_t base;
+	uint32_t size;
+	uint8_t shift;				/* log2 of the model slot size */
+	Bool trap;					/* FALSE for plain RAM */
+	uint8_t *door;
+	SIM_MODEL_T *slot[64];
+} SIM_REGION_T;
+
+/* Private Variables ---------------------------------------------------------- */
+static SIM_REGION_T sim_region[] = {
+	{ LPC_APB0_BASE,    0x100000, 14, TRUE,  NULL, { NULL } },	/* APB0 + APB1 */
+	{ LPC_AHB_BASE,     0x10000,  14, TRUE,  NULL, { NULL } },	/* EMAC, GPDMA, USB */
+	{ LPC_GPIO_BASE,    0x4000,   14, TRUE,  NULL, { NULL } },	/* Fast GPIO */
+	{ SCS_BASE & 0xFFFF0000, 0x10000, 12, TRUE,  NULL, { NULL } },	/* ITM, DWT, SCS */
+	{ LPC_AHBRAM0_BASE, 0x8000,   14, FALSE, NULL, { NULL } },	/* AHB SRAM banks */
+};
+#define SIM_NUM_REGION	(sizeof(sim_region) / sizeof(sim_region[0]))
+
+static SIM_MODEL_T *sim_model[40];
+static uint32_t sim_num_model;
+
+/* Host base of each bus window, 0 while free */
+static uintptr_t sim_buswin[SIM_BUSWIN_NUM];
+
+static volatile uint64_t sim_now;
+static HOSTSIM_STATS_Type sim_stats;
+static volatile int sim_lock, sim_in_irq, sim_ready;
+static volatile uint32_t sim_primask;
+static uint64_t sim_idle_mark, sim_traps;
+
+/* Trapped access waiting for its single step to complete */
+static struct {
+	volatile int active;
+	SIM_MODEL_T *model;
+	uint32_t off;
+	volatile uint32_t *door;
+	uint8_t *page;
+	Bool write;
+} sim_step;
+
+/* NVIC / SysTick state */
+static uint32_t sim_irq_en[2], sim_irq_pend[2], sim_irq_line[2];
+static int32_t sim_irq_active = -16;
+static uint8_t sim_st_pend, sim_st_flag;
+static uint64_t sim_st_next = SIM_NEVER;
+
+/* Exception handlers, resolved at link time when the application has them */
+#define SIM_HANDLER(name)	extern void name(void) __attribute__((weak));
+SIM_HANDLER(SysTick_Handler)
+SIM_HANDLER(WDT_IRQHandler)		SIM_HANDLER(TIMER0_IRQHandler)	SIM_HANDLER(TIMER1_IRQHandler)
+SIM_HANDLER(TIMER2_IRQHandler)	SIM_HANDLER(TIMER3_IRQHandler)	SIM_HANDLER(UART0_IRQHandler)
+SIM_HANDLER(UART1_IRQHandler)	SIM_HANDLER(UART2_IRQHandler)	SIM_HANDLER(UART3_IRQHandler)
+SIM_HANDLER(PWM1_IRQHandler)	SIM_HANDLER(I2C0_IRQHandler)	SIM_HANDLER(I2C1_IRQHandler)
+SIM_HANDLER(I2C2_IRQHandler)	SIM_HANDLER(SPI_IRQHandler)		SIM_HANDLER(SSP0_IRQHandler)
+SIM_HANDLER(SSP1_IRQHandler)	SIM_HANDLER(PLL0_IRQHandler)	SIM_HANDLER(RTC_IRQHandler)
+SIM_HANDLER(EINT0_IRQHandler)	SIM_HANDLER(EINT1_IRQHandler)	SIM_HANDLER(EINT2_IRQHandler)
+SIM_HANDLER(EINT3_IRQHandler)	SIM_HANDLER(ADC_IRQHandler)		SIM_HANDLER(BOD_IRQHandler)
+SIM_HANDLER(USB_IRQHandler)		SIM_HANDLER(CAN_IRQHandler)		SIM_HANDLER(DMA_IRQHandler)
+SIM_HANDLER(I2S_IRQHandler)		SIM_HANDLER(ENET_IRQHandler)	SIM_HANDLER(RIT_IRQHandler)
+SIM_HANDLER(MCPWM_IRQHandler)	SIM_HANDLER(QEI_IRQHandler)		SIM_HANDLER(PLL1_IRQHandler)
+SIM_HANDLER(USBActivity_IRQHandler)	SIM_HANDLER(CANActivity_IRQHandler)
+
+static void (* const sim_vector[SIM_NUM_IRQ])(void) = {
+	WDT_IRQHandler, TIMER0_IRQHandler, TIMER1_IRQHandler, TIMER2_IRQHandler,
+	TIMER3_IRQHandler, UART0_IRQHandler, UART1_IRQHandler, UART2_IRQHandler,
+	UART3_IRQHandler, PWM1_IRQHandler, I2C0_IRQHandler, I2C1_IRQHandler,
+	I2C2_IRQHandler, SPI_IRQHandler, SSP0_IRQHandler, SSP1_IRQHandler,
+	PLL0_IRQHandler, RTC_IRQHandler, EINT0_IRQHandler, EINT1_IRQHandler,
+	EINT2_IRQHandler, EINT3_IRQHandler, ADC_IRQHandler, BOD_IRQHandler,
+	USB_IRQHandler, CAN_IRQHandler, DMA_IRQHandler, I2S_IRQHandler,
+	ENET_IRQHandler, RIT_IRQHandler, MCPWM_IRQHandler, QEI_IRQHandler,
+	PLL1_IRQHandler, USBActivity_IRQHandler, CANActivity_IRQHandler
+};
+
+/* Private Functions ---------------------------------------------------------- */
+static void sim_run(uint64_t cycles);
+static void sim_dma_poke(void);
+static uint64_t sim_next_event(void);
+static void sim_dispatch(void);
+
+/*********************************************************************//**
+ * @brief		Write a diagnostic message without going through stdio
+ * @param[in]	msg		Zero terminated message
+ * @return		None
+ **********************************************************************/
+static void sim_log(const char *msg)
+{
+	ssize_t r = write(2, msg, strlen(msg));
+	(void)r;
+}
+
+/*********************************************************************//**
+ * @brief		Report a fatal simulator error and terminate
+ * @param[in]	msg		Zero terminated message
+ * @return		None
+ **********************************************************************/
+static void sim_fatal(const char *msg)
+{
+	sim_log("hostsim: ");
+	sim_log(msg);
+	sim_log("\n");
+	_exit(1);
+}
+
+/*********************************************************************//**
+ * @brief		Drive the level of a peripheral interrupt line
+ * @param[in]	irq		Interrupt number
+ * @param[in]	level	TRUE while the peripheral requests service
+ * @return		None
+ **********************************************************************/
+static void sim_irq(IRQn_Type irq, Bool level)
+{
+	uint32_t bit = 1UL << (irq & 0x1F);
+
+	if (level)
+	{
+		sim_irq_line[irq >> 5] |= bit;
+		sim_irq_pend[irq >> 5] |= bit;
+	}
+	else
+	{
+		sim_irq_line[irq >> 5] &= ~bit;
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Host address of a bus address seen by a bus master
+ * @param[in]	addr	Bus address, from HOSTSIM_BusAddr() for memory
+ * @return		Host pointer
+ **********************************************************************/
+static void *sim_host_ptr(uint32_t addr)
+{
+	uint32_t win = (addr - SIM_BUSWIN_BASE) >> SIM_BUSWIN_SHIFT;
+
+	if ((addr >= SIM_BUSWIN_BASE) && (win < SIM_BUSWIN_NUM) && sim_buswin[win])
+	{
+		return (void *)(sim_buswin[win] + (addr & ((1UL << SIM_BUSWIN_SHIFT) - 1)));
+	}
+	return (void *)(uintptr_t)addr;
+}
+
+/*********************************************************************//**
+ * @brief		Find the model owning a bus address
+ * @param[in]	addr	Bus address
+ * @return		Model or NULL
+ **********************************************************************/
+static SIM_MODEL_T *sim_find(uint32_t addr)
+{
+	uint32_t i;
+
+	for (i = 0; i < SIM_NUM_REGION; i++)
+	{
+		SIM_REGION_T *r = &sim_region[i];
+
+		if ((addr >= r->base) && (addr - r->base < r->size))
+		{
+			return r->slot[(addr - r->base) >> r->shift];
+		}
+	}
+	return NULL;
+}
+
+/*********************************************************************//**
+ * @brief		Peripheral clock divider of a PCLKSEL field
+ * @param[in]	sel		0 for PCLKSEL0, 1 for PCLKSEL1
+ * @param[in]	bit		Position of the two bit field
+ * @return		CCLK cycles per PCLK cycle
+ **********************************************************************/
+static uint32_t sim_pclk_div(uint8_t sel, uint8_t bit)
+{
+	static const uint8_t div[4] = { 4, 1, 2, 8 };
+	uint32_t reg = sel ? LPC_SC_BASE + SIM_OFS(LPC_SC_TypeDef, PCLKSEL1)
+					   : LPC_SC_BASE + SIM_OFS(LPC_SC_TypeDef, PCLKSEL0);
+	SIM_MODEL_T *sc = sim_find(LPC_SC_BASE);
+
+	return div[(SIM_DOOR(sc, reg - LPC_SC_BASE) >> bit) & 0x03];
+}
+
+/* SC model ------------------------------------------------------------------- */
+static uint32_t sc_pll0con, sc_pll0cfg, sc_pll1con, sc_pll1cfg;
+static uint8_t sc_feed0, sc_feed1;
+
+/*********************************************************************//**
+ * @brief		Current CPU clock derived from CLKSRCSEL, PLL0 and CCLKCFG
+ * @param[in]	m		SC model
+ * @return		CCLK in Hz
+ **********************************************************************/
+static uint32_t sc_cclk(SIM_MODEL_T *m)
+{
+	uint64_t src, cclk;
+
+	switch (SIM_DOOR(m, SIM_OFS(LPC_SC_TypeDef, CLKSRCSEL)) & 0x03)
+	{
+	case 1:		src = 12000000; break;
+	case 2:		src = 32768;	break;
+	default:	src = 4000000;	break;
+	}
+	if ((sc_pll0con & 0x03) == 0x03)
+	{
+		cclk = 2 * ((sc_pll0cfg & 0x7FFF) + 1) * src / (((sc_pll0cfg >> 16) & 0xFF) + 1);
+	}
+	else
+	{
+		cclk = src;
+	}
+	return (uint32_t)(cclk / ((SIM_DOOR(m, SIM_OFS(LPC_SC_TypeDef, CCLKCFG)) & 0xFF) + 1));
+}
+
+static uint32_t sc_read(SIM_MODEL_T *m, uint32_t off, Bool peek)
+{
+	uint32_t v;
+	(void)peek;
+
+	switch (off)
+	{
+	case SIM_OFS(LPC_SC_TypeDef, PLL0STAT):
+		v = (sc_pll0cfg & 0x00FF7FFF) | ((sc_pll0con & 0x03) << 24);
+		if (sc_pll0con & 0x01)
+		{
+			v |= (1 << 26);
+		}
+		return v;
+	case SIM_OFS(LPC_SC_TypeDef, PLL1STAT):
+		v = (sc_pll1cfg & 0x7F) | ((sc_pll1con & 0x03) << 8);
+		if (sc_pll1con & 0x01)
+		{
+			v |= (1 << 10);
+		}
+		return v;
+	case SIM_OFS(LPC_SC_TypeDef, SCS):
+		v = SIM_DOOR(m, off) & ~(1 << 6);
+		return (v & (1 << 5)) ? (v | (1 << 6)) : v;
+	default:
+		return SIM_DOOR(m, off);
+	}
+}
+
+static void sc_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	switch (off)
+	{
+	case SIM_OFS(LPC_SC_TypeDef, PLL0FEED):
+		if ((val & 0xFF) == 0xAA)
+		{
+			sc_feed0 = 1;
+		}
+		else if (((val & 0xFF) == 0x55) && sc_feed0)
+		{
+			sc_pll0con = SIM_DOOR(m, SIM_OFS(LPC_SC_TypeDef, PLL0CON)) & 0x03;
+			sc_pll0cfg = SIM_DOOR(m, SIM_OFS(LPC_SC_TypeDef, PLL0CFG)) & 0x00FF7FFF;
+			sc_feed0 = 0;
+		}
+		else
+		{
+			sc_feed0 = 0;
+		}
+		break;
+	case SIM_OFS(LPC_SC_TypeDef, PLL1FEED):
+		if ((val & 0xFF) == 0xAA)
+		{
+			sc_feed1 = 1;
+		}
+		else if (((val & 0xFF) == 0x55) && sc_feed1)
+		{
+			sc_pll1con = SIM_DOOR(m, SIM_OFS(LPC_SC_TypeDef, PLL1CON)) & 0x03;
+			sc_pll1cfg = SIM_DOOR(m, SIM_OFS(LPC_SC_TypeDef, PLL1CFG)) & 0x7F;
+			sc_feed1 = 0;
+		}
+		else
+		{
+			sc_feed1 = 0;
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+static SIM_MODEL_T sim_sc = { LPC_SC_BASE, 0x4000, sc_read, sc_write, NULL, SIM_NEVER, NULL };
+
+/* GPIO model ----------------------------------------------------------------- */
+/* Every change of an output latch is reported to the sink set by
+ * HOSTSIM_GPIOSetSink(), so a host model can follow a parallel bus. */
+static uint32_t gpio_out[5], gpio_in[5], gpio_level[5];
+static HOSTSIM_GPIO_SINK_Type gpio_sink;
+static SIM_MODEL_T sim_gpio;
+static void gpioint_edges(uint32_t port);
+
+static uint32_t gpio_read(SIM_MODEL_T *m, uint32_t off, Bool peek)
+{
+	uint32_t port = off >> 5;
+	uint32_t dir, mask;
+	(void)peek;
+
+	if (port > 4)
+	{
+		return SIM_DOOR(m, off);
+	}
+	dir = SIM_DOOR(m, (port << 5) + 0x00);
+	mask = SIM_DOOR(m, (port << 5) + 0x10);
+	switch (off & 0x1F)
+	{
+	case 0x14:	return ((gpio_out[port] & dir) | (gpio_in[port] & ~dir)) & ~mask;
+	case 0x18:	return gpio_out[port];
+	case 0x1C:	return 0;
+	default:	return SIM_DOOR(m, off);
+	}
+}
+
+static void gpio_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	uint32_t port = off >> 5;
+	uint32_t mask, old;
+
+	if (port > 4)
+	{
+		return;
+	}
+	mask = SIM_DOOR(m, (port << 5) + 0x10);
+	old = gpio_out[port];
+	if (((off & 0x1F) == 0x00) && (gpio_sink != NULL))
+	{
+		gpio_sink((uint8_t)port, old, old);
+	}
+	switch (off & 0x1F)
+	{
+	case 0x14:	gpio_out[port] = (gpio_out[port] & mask) | (val & ~mask); break;
+	case 0x18:	gpio_out[port] |= (val & ~mask); break;
+	case 0x1C:	gpio_out[port] &= ~(val & ~mask); break;
+	default:	break;
+	}
+	if ((gpio_sink != NULL) && (gpio_out[port] != old))
+	{
+		gpio_sink((uint8_t)port, gpio_out[port], old);
+	}
+	gpioint_edges(port);
+}
+
+static SIM_MODEL_T sim_gpio = { LPC_GPIO_BASE, 0x4000, gpio_read, gpio_write, NULL, SIM_NEVER, NULL };
+
+/* GPIO interrupt model ------------------------------------------------------- */
+/* Edge detection on the pin levels of ports 0 and 2, EINT3 while any
+ * enabled edge is latched */
+#define GPIOINT_OFS(reg)	SIM_OFS(LPC_GPIOINT_TypeDef, reg)
+
+static uint32_t gpioint_stat[2][2];		/* [P0, P2][rising, falling] */
+
+static uint32_t gpioint_read(SIM_MODEL_T *m, uint32_t off, Bool peek)
+{
+	(void)peek;
+
+	switch (off)
+	{
+	case GPIOINT_OFS(IntStatus):
+		return ((gpioint_stat[0][0] | gpioint_stat[0][1]) ? 0x01 : 0) |
+			   ((gpioint_stat[1][0] | gpioint_stat[1][1]) ? 0x04 : 0);
+	case GPIOINT_OFS(IO0IntStatR):	return gpioint_stat[0][0];
+	case GPIOINT_OFS(IO0IntStatF):	return gpioint_stat[0][1];
+	case GPIOINT_OFS(IO2IntStatR):	return gpioint_stat[1][0];
+	case GPIOINT_OFS(IO2IntStatF):	return gpioint_stat[1][1];
+	case GPIOINT_OFS(IO0IntClr):
+	case GPIOINT_OFS(IO2IntClr):	return 0;
+	default:						return SIM_DOOR(m, off);
+	}
+}
+
+static void gpioint_update(void)
+{
+	sim_irq(EINT3_IRQn, (gpioint_stat[0][0] | gpioint_stat[0][1] |
+						 gpioint_stat[1][0] | gpioint_stat[1][1]) != 0);
+}
+
+static void gpioint_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	(void)m;
+
+	switch (off)
+	{
+	case GPIOINT_OFS(IO0IntClr):
+		gpioint_stat[0][0] &= ~val;
+		gpioint_stat[0][1] &= ~val;
+		break;
+	case GPIOINT_OFS(IO2IntClr):
+		gpioint_stat[1][0] &= ~val;
+		gpioint_stat[1][1] &= ~val;
+		break;
+	default:
+		break;
+	}
+	gpioint_update();
+}
+
+static SIM_MODEL_T sim_gpioint = { LPC_GPIOINT_BASE, 0x80, gpioint_read, gpioint_write, NULL, SIM_NEVER, NULL };
+
+static void gpioint_edges(uint32_t port)
+{
+	uint32_t dir, pins, old, i;
+
+	if (sim_gpio.regs == NULL)
+	{
+		return;
+	}
+	dir = SIM_DOOR(&sim_gpio, port << 5);
+	pins = (gpio_out[port] & dir) | (gpio_in[port] & ~dir);
+	old = gpio_level[port];
+	gpio_level[port] = pins;
+	if (((port != 0) && (port != 2)) || (sim_gpioint.regs == NULL))
+	{
+		return;
+	}
+	i = port >> 1;
+	gpioint_stat[i][0] |= ~old & pins & SIM_DOOR(&sim_gpioint, i ? GPIOINT_OFS(IO2IntEnR) : GPIOINT_OFS(IO0IntEnR));
+	gpioint_stat[i][1] |= old & ~pins & SIM_DOOR(&sim_gpioint, i ? GPIOINT_OFS(IO2IntEnF) : GPIOINT_OFS(IO0IntEnF));
+	gpioint_update();
+}
+
+/* SCS model (SysTick, NVIC, SCB) --------------------------------------------- */
+#define SCS_ST_CTRL		0x010
+#define SCS_ST_LOAD		0x014
+#define SCS_ST_VAL		0x018
+#define SCS_ISER		0x100
+#define SCS_ICER		0x180
+#define SCS_ISPR		0x200
+#define SCS_ICPR		0x280
+#define SCS_IABR		0x300
+#define SCS_IP			0x400
+#define SCS_ICSR		0xD04
+#define SCS_AIRCR		0xD0C
+#define SCS_SHP			0xD18
+#define SCS_STIR		0xF00
+
+static void scs_sched(SIM_MODEL_T *m)
+{
+	m->next = (SIM_DOOR(m, SCS_ST_CTRL) & 0x01) ? sim_st_next : SIM_NEVER;
+}
+
+static uint32_t scs_read(SIM_MODEL_T *m, uint32_t off, Bool peek)
+{
+	uint32_t v, n;
+
+	switch (off)
+	{
+	case SCS_ST_CTRL:
+		v = (SIM_DOOR(m, off) & 0x07) | (sim_st_flag ? (1UL << 16) : 0);
+		if (!peek)
+		{
+			sim_st_flag = 0;
+		}
+		return v;
+	case SCS_ST_VAL:
+		if (!(SIM_DOOR(m, SCS_ST_CTRL) & 0x01) || (sim_st_next == SIM_NEVER))
+		{
+			return SIM_DOOR(m, off);
+		}
+		v = (uint32_t)(sim_st_next - sim_now);
+		n = SIM_DOOR(m, SCS_ST_LOAD) & 0x00FFFFFF;
+		return (v > n) ? n : v;
+	case SCS_ISER: case SCS_ISER + 4:
+	case SCS_ICER: case SCS_ICER + 4:
+		return sim_irq_en[(off >> 2) & 1];
+	case SCS_ISPR: case SCS_ISPR + 4:
+	case SCS_ICPR: case SCS_ICPR + 4:
+		return sim_irq_pend[(off >> 2) & 1];
+	case SCS_IABR: case SCS_IABR + 4:
+		if ((sim_irq_active >= 0) && ((uint32_t)(sim_irq_active >> 5) == ((off >> 2) & 1)))
+		{
+			return 1UL << (sim_irq_active & 0x1F);
+		}
+		return 0;
+	case SCS_ICSR:
+		v = (uint32_t)(sim_irq_active + 16) & 0x1FF;
+		if (sim_st_pend)
+		{
+			v |= (1UL << 26);
+		}
+		if ((sim_irq_pend[0] & sim_irq_en[0]) || (sim_irq_pend[1] & sim_irq_en[1]))
+		{
+			v |= (1UL << 22);
+		}
+		return v;
+	default:
+		return SIM_DOOR(m, off);
+	}
+}
+
+static void scs_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	uint32_t load = SIM_DOOR(m, SCS_ST_LOAD) & 0x00FFFFFF;
+
+	switch (off)
+	{
+	case SCS_ST_CTRL:
+		SIM_DOOR(m, off) = val & 0x07;
+		if ((val & 0x01) && (sim_st_next == SIM_NEVER))
+		{
+			sim_st_next = sim_now + load + 1;
+		}
+		else if (!(val & 0x01))
+		{
+			sim_st_next = SIM_NEVER;
+		}
+		break;
+	case SCS_ST_LOAD:
+		SIM_DOOR(m, off) = val & 0x00FFFFFF;
+		break;
+	case SCS_ST_VAL:
+		SIM_DOOR(m, off) = 0;
+		sim_st_flag = 0;
+		if (SIM_DOOR(m, SCS_ST_CTRL) & 0x01)
+		{
+			sim_st_next = sim_now + load + 1;
+		}
+		break;
+	case SCS_ISER: case SCS_ISER + 4:
+		sim_irq_en[(off >> 2) & 1] |= val;
+		break;
+	case SCS_ICER: case SCS_ICER + 4:
+		sim_irq_en[(off >> 2) & 1] &= ~val;
+		break;
+	case SCS_ISPR: case SCS_ISPR + 4:
+		sim_irq_pend[(off >> 2) & 1] |= val;
+		break;
+	case SCS_ICPR: case SCS_ICPR + 4:
+		sim_irq_pend[(off >> 2) & 1] &= ~val;
+		break;
+	case SCS_ICSR:
+		if (val & (1UL << 26))
+		{
+			sim_st_pend = 1;
+		}
+		if (val & (1UL << 25))
+		{
+			sim_st_pend = 0;
+		}
+		break;
+	case SCS_AIRCR:
+		if ((val >> 16) == 0x05FA)
+		{
+			SIM_DOOR(m, off) = 0xFA050000 | (val & 0x700);
+		}
+		else
+		{
+			SIM_DOOR(m, off) = 0xFA050000;
+		}
+		break;
+	case SCS_STIR:
+		if ((val & 0x1FF) < SIM_NUM_IRQ)
+		{
+			sim_irq_pend[(val >> 5) & 1] |= 1UL << (val & 0x1F);
+		}
+		break;
+	default:
+		break;
+	}
+	scs_sched(m);
+}
+
+static void scs_tick(SIM_MODEL_T *m)
+{
+	uint32_t load = SIM_DOOR(m, SCS_ST_LOAD) & 0x00FFFFFF;
+
+	while (sim_now >= sim_st_next)
+	{
+		sim_st_flag = 1;
+		if (SIM_DOOR(m, SCS_ST_CTRL) & 0x02)
+		{
+			sim_st_pend = 1;
+		}
+		if (load == 0)
+		{
+			sim_st_next = SIM_NEVER;
+			break;
+		}
+		sim_st_next += load + 1;
+	}
+	scs_sched(m);
+}
+
+static SIM_MODEL_T sim_scs = { SCS_BASE, 0x1000, scs_read, scs_write, scs_tick, SIM_NEVER, NULL };
+
+/* DWT model (cycle counter) -------------------------------------------------- */
+#define DWT_CTRL		0x000
+#define DWT_CYCCNT		0x004
+#define SCS_DEMCR		0xDFC
+
+/* Virtual clock at which CYCCNT was zero, valid while it counts */
+static uint64_t dwt_zero;
+
+static Bool dwt_counting(SIM_MODEL_T *m)
+{
+	return ((SIM_DOOR(m, DWT_CTRL) & 0x01) && (SIM_DOOR(&sim_scs, SCS_DEMCR) & (1UL << 24))) ? TRUE : FALSE;
+}
+
+static uint32_t dwt_read(SIM_MODEL_T *m, uint32_t off, Bool peek)
+{
+	(void)peek;
+	if ((off == DWT_CYCCNT) && dwt_counting(m))
+	{
+		return (uint32_t)(sim_now - dwt_zero);
+	}
+	return SIM_DOOR(m, off);
+}
+
+static void dwt_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	switch (off)
+	{
+	case DWT_CTRL:
+		/* Four comparators, only CYCCNTENA does anything */
+		SIM_DOOR(m, off) = 0x40000000 | (val & 0x01);
+		dwt_zero = sim_now - SIM_DOOR(m, DWT_CYCCNT);
+		break;
+	case DWT_CYCCNT:
+		dwt_zero = sim_now - val;
+		break;
+	default:
+		break;
+	}
+}
+
+static SIM_MODEL_T sim_dwt = { 0xE0001000, 0x1000, dwt_read, dwt_write, NULL, SIM_NEVER, NULL };
+
+/*********************************************************************//**
+ * @brief		Priority of an exception as programmed in NVIC/SCB
+ * @param[in]	irq		Interrupt number, -1 for SysTick
+ * @return		Priority, lower value wins
+ **********************************************************************/
+static uint32_t scs_prio(int32_t irq)
+{
+	if (irq < 0)
+	{
+		return sim_scs.regs[SCS_SHP + 11] >> (8 - __NVIC_PRIO_BITS);
+	}
+	return sim_scs.regs[SCS_IP + irq] >> (8 - __NVIC_PRIO_BITS);
+}
+
+/* UART model ----------------------------------------------------------------- */
+typedef struct {
+	SIM_MODEL_T m;
+	IRQn_Type irq;
+	uint8_t sel, bit;
+	uint8_t dll, dlm, lcr, fcr, fdr, ter, scr, rbr;
+	uint32_t ier;
+	uint8_t rx[16], rx_rd, rx_cnt, oe;
+	uint8_t tx[16], tx_rd, tx_cnt;
+	Bool tsr_busy, thre;
+	uint8_t tsr;
+	uint64_t tsr_done, rx_next, rx_last;
+	uint8_t in[HOSTSIM_UART_INJECT_SIZE];
+	uint32_t in_rd, in_cnt;
+	uint8_t cap[HOSTSIM_UART_CAPTURE_SIZE];
+	uint32_t cap_rd, cap_cnt;
+	HOSTSIM_UART_SINK_Type sink;
+	Bool echo;
+} SIM_UART_T;
+
+static SIM_UART_T sim_uart[4];
+
+/*********************************************************************//**
+ * @brief		CCLK cycles needed to shift one character
+ * @param[in]	u		UART model
+ * @return		Cycles per character
+ **********************************************************************/
+static uint64_t uart_char(SIM_UART_T *u)
+{
+	uint64_t bits, dl, mul, div;
+
+	bits = 1 + 5 + (u->lcr & 0x03) + ((u->lcr >> 3) & 0x01) + 1 + ((u->lcr >> 2) & 0x01);
+	dl = ((uint32_t)u->dlm << 8) | u->dll;
+	if (dl == 0)
+	{
+		dl = 1;
+	}
+	mul = u->fdr >> 4;
+	div = u->fdr & 0x0F;
+	if ((mul == 0) || (div == 0))
+	{
+		mul = 1;
+		div = 0;
+	}
+	return bits * 16 * dl * (mul + div) * sim_pclk_div(u->sel, u->bit) / mul;
+}
+
+static uint8_t uart_iir(SIM_UART_T *u)
+{
+	static const uint8_t trig[4] = { 1, 4, 8, 14 };
+
+	if ((u->ier & 0x04) && u->oe)
+	{
+		return 0x06;
+	}
+	if ((u->ier & 0x01) && (u->rx_cnt >= trig[u->fcr >> 6]))
+	{
+		return 0x04;
+	}
+	if ((u->ier & 0x01) && u->rx_cnt && (sim_now >= u->rx_last + 4 * uart_char(u)))
+	{
+		return 0x0C;
+	}
+	if ((u->ier & 0x02) && u->thre)
+	{
+		return 0x02;
+	}
+	return 0x01;
+}
+
+static void uart_sched(SIM_UART_T *u)
+{
+	uint64_t t = SIM_NEVER, cti;
+
+	if (u->tsr_busy)
+	{
+		t = u->tsr_done;
+	}
+	if (u->in_cnt && (u->rx_next < t))
+	{
+		t = u->rx_next;
+	}
+	if (u->rx_cnt && (u->ier & 0x01))
+	{
+		cti = u->rx_last + 4 * uart_char(u);
+		if ((cti > sim_now) && (cti < t))
+		{
+			t = cti;
+		}
+	}
+	u->m.next = t;
+	sim_irq(u->irq, uart_iir(u) != 0x01);
+	sim_dma_poke();
+}
+
+static void uart_kick(SIM_UART_T *u)
+{
+	if (!u->tsr_busy && u->tx_cnt && (u->ter & 0x80))
+	{
+		u->tsr = u->tx[u->tx_rd];
+		u->tx_rd = (u->tx_rd + 1) & 0x0F;
+		if (--u->tx_cnt == 0)
+		{
+			u->thre = TRUE;
+		}
+		u->tsr_busy = TRUE;
+		u->tsr_done = sim_now + uart_char(u);
+	}
+}
+
+static void uart_emit(SIM_UART_T *u, uint8_t c)
+{
+	if (u->cap_cnt == HOSTSIM_UART_CAPTURE_SIZE)
+	{
+		u->cap_rd = (u->cap_rd + 1) % HOSTSIM_UART_CAPTURE_SIZE;
+		u->cap_cnt--;
+	}
+	u->cap[(u->cap_rd + u->cap_cnt++) % HOSTSIM_UART_CAPTURE_SIZE] = c;
+	if (u->echo)
+	{
+		ssize_t r = write(1, &c, 1);
+		(void)r;
+	}
+	if (u->sink)
+	{
+		u->sink((uint8_t)(u - sim_uart), c);
+	}
+}
+
+static uint32_t uart_read(SIM_MODEL_T *m, uint32_t off, Bool peek)
+{
+	SIM_UART_T *u = (SIM_UART_T *)m;
+	uint32_t v;
+
+	switch (off)
+	{
+	case 0x00:
+		if (u->lcr & 0x80)
+		{
+			return u->dll;
+		}
+		if (!peek && u->rx_cnt)
+		{
+			u->rbr = u->rx[u->rx_rd];
+			u->rx_rd = (u->rx_rd + 1) & 0x0F;
+			u->rx_cnt--;
+			u->rx_last = sim_now;
+			uart_sched(u);
+		}
+		return u->rbr;
+	case 0x04:
+		return (u->lcr & 0x80) ? u->dlm : u->ier;
+	case 0x08:
+		v = uart_iir(u);
+		if (!peek && (v == 0x02))
+		{
+			u->thre = FALSE;
+			uart_sched(u);
+		}
+		return v | ((u->fcr & 0x01) ? 0xC0 : 0);
+	case 0x0C:
+		return u->lcr;
+	case 0x14:
+		v = (u->rx_cnt ? 0x01 : 0) | (u->oe ? 0x02 : 0);
+		if (u->tx_cnt == 0)
+		{
+			v |= u->tsr_busy ? 0x20 : 0x60;
+		}
+		if (!peek && u->oe)
+		{
+			u->oe = 0;
+			uart_sched(u);
+		}
+		return v;
+	case 0x1C:
+		return u->scr;
+	case 0x28:
+		return u->fdr;
+	case 0x30:
+		return u->ter;
+	case 0x58:
+		return u->rx_cnt | ((uint32_t)u->tx_cnt << 8);
+	default:
+		return SIM_DOOR(m, off);
+	}
+}
+
+static void uart_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	SIM_UART_T *u = (SIM_UART_T *)m;
+
+	switch (off)
+	{
+	case 0x00:
+		if (u->lcr & 0x80)
+		{
+			u->dll = (uint8_t)val;
+			break;
+		}
+		if (u->tx_cnt < 16)
+		{
+			u->tx[(u->tx_rd + u->tx_cnt++) & 0x0F] = (uint8_t)val;
+		}
+		u->thre = FALSE;
+		uart_kick(u);
+		break;
+	case 0x04:
+		if (u->lcr & 0x80)
+		{
+			u->dlm = (uint8_t)val;
+			break;
+		}
+		if ((val & 0x02) && !(u->ier & 0x02) && (u->tx_cnt == 0))
+		{
+			u->thre = TRUE;
+		}
+		u->ier = val & 0x307;
+		break;
+	case 0x08:
+		u->fcr = (uint8_t)(val & 0xC9);
+		if (val & 0x02)
+		{
+			u->rx_cnt = 0;
+		}
+		if (val & 0x04)
+		{
+			u->tx_cnt = 0;
+		}
+		break;
+	case 0x0C:
+		u->lcr = (uint8_t)val;
+		break;
+	case 0x1C:
+		u->scr = (uint8_t)val;
+		break;
+	case 0x28:
+		u->fdr = (uint8_t)val;
+		break;
+	case 0x30:
+		u->ter = (uint8_t)(val & 0x80);
+		uart_kick(u);
+		break;
+	default:
+		break;
+	}
+	uart_sched(u);
+}
+
+static void uart_tick(SIM_MODEL_T *m)
+{
+	SIM_UART_T *u = (SIM_UART_T *)m;
+	uint8_t c;
+
+	if (u->tsr_busy && (sim_now >= u->tsr_done))
+	{
+		u->tsr_busy = FALSE;
+		uart_emit(u, u->tsr);
+	}
+	uart_kick(u);
+	if (u->in_cnt && (sim_now >= u->rx_next))
+	{
+		c = u->in[u->in_rd];
+		u->in_rd = (u->in_rd + 1) % HOSTSIM_UART_INJECT_SIZE;
+		u->in_cnt--;
+		if (u->rx_cnt < 16)
+		{
+			u->rx[(u->rx_rd + u->rx_cnt++) & 0x0F] = c;
+		}
+		else
+		{
+			u->oe = 1;
+			sim_stats.FramesDropped++;
+		}
+		u->rx_last = sim_now;
+		u->rx_next = sim_now + uart_char(u);
+	}
+	uart_sched(u);
+}
+
+/* SSP model ------------------------------------------------------------------ */
+#define SSP_CR0		0x00
+#define SSP_CR1		0x04
+#define SSP_DR		0x08
+#define SSP_SR		0x0C
+#define SSP_CPSR	0x10
+#define SSP_IMSC	0x14
+#define SSP_RIS		0x18
+#define SSP_MIS		0x1C
+#define SSP_ICR		0x20
+
+typedef struct {
+	SIM_MODEL_T m;
+	IRQn_Type irq;
+	uint8_t sel, bit, port;
+	uint16_t tx[8], rx[8];
+	uint8_t tx_rd, tx_cnt, rx_rd, rx_cnt;
+	Bool busy, ror;
+	uint16_t shift;
+	uint64_t done, rx_last;
+	HOSTSIM_SSP_DEV_Type dev;
+} SIM_SSP_T;
+
+static SIM_SSP_T sim_ssp[2];
+
+/*********************************************************************//**
+ * @brief		CCLK cycles of one SCK period
+ * @param[in]	s		SSP model
+ * @return		Cycles per bit
+ **********************************************************************/
+static uint64_t ssp_bit(SIM_SSP_T *s)
+{
+	uint32_t cpsr = SIM_DOOR(&s->m, SSP_CPSR) & 0xFE;
+
+	if (cpsr < 2)
+	{
+		cpsr = 2;
+	}
+	return (uint64_t)cpsr * (((SIM_DOOR(&s->m, SSP_CR0) >> 8) & 0xFF) + 1) * sim_pclk_div(s->sel, s->bit);
+}
+
+static uint32_t ssp_ris(SIM_SSP_T *s)
+{
+	uint32_t v = s->ror ? 0x01 : 0;
+
+	if (s->rx_cnt && (sim_now >= s->rx_last + 32 * ssp_bit(s)))
+	{
+		v |= 0x02;
+	}
+	if (s->rx_cnt >= 4)
+	{
+		v |= 0x04;
+	}
+	if (s->tx_cnt <= 4)
+	{
+		v |= 0x08;
+	}
+	return v;
+}
+
+static void ssp_sched(SIM_SSP_T *s)
+{
+	uint64_t t = s->busy ? s->done : SIM_NEVER;
+	uint64_t rt;
+
+	if (s->rx_cnt)
+	{
+		rt = s->rx_last + 32 * ssp_bit(s);
+		if ((rt > sim_now) && (rt < t))
+		{
+			t = rt;
+		}
+	}
+	s->m.next = t;
+	sim_irq(s->irq, (ssp_ris(s) & SIM_DOOR(&s->m, SSP_IMSC)) != 0);
+	sim_dma_poke();
+}
+
+static void ssp_kick(SIM_SSP_T *s)
+{
+	uint32_t bits = (SIM_DOOR(&s->m, SSP_CR0) & 0x0F) + 1;
+
+	if (!s->busy && s->tx_cnt && (SIM_DOOR(&s->m, SSP_CR1) & 0x02))
+	{
+		s->shift = s->tx[s->tx_rd];
+		s->tx_rd = (s->tx_rd + 1) & 0x07;
+		s->tx_cnt--;
+		s->busy = TRUE;
+		s->done = sim_now + bits * ssp_bit(s);
+	}
+}
+
+static uint32_t ssp_read(SIM_MODEL_T *m, uint32_t off, Bool peek)
+{
+	SIM_SSP_T *s = (SIM_SSP_T *)m;
+	uint32_t v;
+
+	switch (off)
+	{
+	case SSP_DR:
+		v = s->rx[s->rx_rd];
+		if (!peek && s->rx_cnt)
+		{
+			s->rx_rd = (s->rx_rd + 1) & 0x07;
+			s->rx_cnt--;
+			s->rx_last = sim_now;
+			ssp_sched(s);
+		}
+		return v;
+	case SSP_SR:
+		v = (s->tx_cnt == 0) ? 0x01 : 0;
+		v |= (s->tx_cnt < 8) ? 0x02 : 0;
+		v |= s->rx_cnt ? 0x04 : 0;
+		v |= (s->rx_cnt == 8) ? 0x08 : 0;
+		v |= (s->busy || s->tx_cnt) ? 0x10 : 0;
+		return v;
+	case SSP_RIS:
+		return ssp_ris(s);
+	case SSP_MIS:
+		return ssp_ris(s) & SIM_DOOR(m, SSP_IMSC);
+	case SSP_ICR:
+		return 0;
+	default:
+		return SIM_DOOR(m, off);
+	}
+}
+
+static void ssp_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	SIM_SSP_T *s = (SIM_SSP_T *)m;
+
+	switch (off)
+	{
+	case SSP_DR:
+		if (s->tx_cnt < 8)
+		{
+			s->tx[(s->tx_rd + s->tx_cnt++) & 0x07] = (uint16_t)val;
+		}
+		ssp_kick(s);
+		break;
+	case SSP_CR1:
+		ssp_kick(s);
+		break;
+	case SSP_ICR:
+		if (val & 0x01)
+		{
+			s->ror = FALSE;
+		}
+		if (val & 0x02)
+		{
+			s->rx_last = sim_now;
+		}
+		break;
+	default:
+		break;
+	}
+	ssp_sched(s);
+}
+
+static void ssp_tick(SIM_MODEL_T *m)
+{
+	SIM_SSP_T *s = (SIM_SSP_T *)m;
+	uint16_t mask = (uint16_t)((2UL << (SIM_DOOR(m, SSP_CR0) & 0x0F)) - 1);
+	uint16_t miso;
+
+	if (s->busy && (sim_now >= s->done))
+	{
+		if (SIM_DOOR(m, SSP_CR1) & 0x01)
+		{
+			miso = s->shift;
+		}
+		else if (s->dev)
+		{
+			miso = s->dev(s->port, s->shift & mask);
+		}
+		else
+		{
+			miso = 0xFFFF;
+		}
+		if (s->rx_cnt < 8)
+		{
+			s->rx[(s->rx_rd + s->rx_cnt++) & 0x07] = miso & mask;
+		}
+		else
+		{
+			s->ror = TRUE;
+		}
+		s->rx_last = sim_now;
+		s->busy = FALSE;
+		ssp_kick(s);
+	}
+	ssp_sched(s);
+}
+
+/* SPI model ------------------------------------------------------------------ */
+#define SPI_CR		0x00
+#define SPI_SR		0x04
+#define SPI_DR		0x08
+#define SPI_CCR		0x0C
+#define SPI_INT		0x1C
+
+typedef struct {
+	SIM_MODEL_T m;
+	Bool busy, spif, wcol, sr_read, intf;
+	uint16_t shift, rx;
+	uint64_t done;
+	HOSTSIM_SSP_DEV_Type dev;
+} SIM_SPI_T;
+
+static SIM_SPI_T sim_spi;
+
+/*********************************************************************//**
+ * @brief		CCLK cycles of one SCK period
+ * @param[in]	s		SPI model
+ * @return		Cycles per bit
+ **********************************************************************/
+static uint64_t spi_bit(SIM_SPI_T *s)
+{
+	uint32_t ccr = SIM_DOOR(&s->m, SPI_CCR) & 0xFE;
+
+	if (ccr < 8)
+	{
+		ccr = 8;
+	}
+	return (uint64_t)ccr * sim_pclk_div(0, 16);
+}
+
+static uint32_t spi_bits(SIM_SPI_T *s)
+{
+	uint32_t cr = SIM_DOOR(&s->m, SPI_CR);
+
+	if (!(cr & 0x04) || !(cr & 0xF00))
+	{
+		return (cr & 0x04) ? 16 : 8;
+	}
+	return (cr >> 8) & 0x0F;
+}
+
+static void spi_sched(SIM_SPI_T *s)
+{
+	s->m.next = s->busy ? s->done : SIM_NEVER;
+	sim_irq(SPI_IRQn, s->intf);
+}
+
+/* SPIF and WCOL clear on a data register access that follows a status read */
+static void spi_clear(SIM_SPI_T *s)
+{
+	if (s->sr_read)
+	{
+		s->spif = FALSE;
+		s->wcol = FALSE;
+		s->sr_read = FALSE;
+	}
+}
+
+static uint32_t spi_read(SIM_MODEL_T *m, uint32_t off, Bool peek)
+{
+	SIM_SPI_T *s = (SIM_SPI_T *)m;
+	uint32_t v;
+
+	switch (off)
+	{
+	case SPI_SR:
+		v = (s->spif ? 0x80 : 0) | (s->wcol ? 0x40 : 0);
+		if (!peek && v)
+		{
+			s->sr_read = TRUE;
+		}
+		return v;
+	case SPI_DR:
+		if (!peek)
+		{
+			spi_clear(s);
+		}
+		return s->rx;
+	case SPI_INT:
+		return s->intf ? 0x01 : 0;
+	default:
+		return SIM_DOOR(m, off);
+	}
+}
+
+static void spi_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	SIM_SPI_T *s = (SIM_SPI_T *)m;
+
+	switch (off)
+	{
+	case SPI_DR:
+		spi_clear(s);
+		if (s->busy)
+		{
+			s->wcol = TRUE;
+			break;
+		}
+		s->shift = (uint16_t)val;
+		s->busy = TRUE;
+		s->done = sim_now + spi_bits(s) * spi_bit(s);
+		break;
+	case SPI_INT:
+		if (val & 0x01)
+		{
+			s->intf = FALSE;
+		}
+		break;
+	default:
+		break;
+	}
+	spi_sched(s);
+}
+
+static void spi_tick(SIM_MODEL_T *m)
+{
+	SIM_SPI_T *s = (SIM_SPI_T *)m;
+	uint16_t mask = (uint16_t)((1UL << spi_bits(s)) - 1);
+
+	if (s->busy && (sim_now >= s->done))
+	{
+		s->rx = (s->dev ? s->dev(2, s->shift & mask) : 0xFFFF) & mask;
+		s->busy = FALSE;
+		s->spif = TRUE;
+		if (SIM_DOOR(m, SPI_CR) & 0x80)
+		{
+			s->intf = TRUE;
+		}
+	}
+	spi_sched(s);
+}
+
+/* SD card on the SPI --------------------------------------------------------- */
+/* SPI mode card with /CS on P0.16 and card detect on P4.29 */
+#define SDC_BLOCK		512
+#define SDC_PROG_US		250		/* Block programming time */
+#define SDC_INIT_POLLS	3		/* ACMD41 calls until the card leaves idle */
+#define SDC_OUT_SIZE	(SDC_BLOCK + 16)
+
+enum { SDC_CMD, SDC_READ, SDC_WTOKEN, SDC_WDATA };
+
+static struct {
+	uint8_t *img;
+	uint32_t blocks;
+	Bool hc, idle, app, crc, multi;
+	uint8_t polls, mode;
+	uint8_t cmd[6], cmd_len;
+	uint8_t out[SDC_OUT_SIZE];
+	uint16_t out_rd, out_len;
+	uint8_t in[SDC_BLOCK + 2];
+	uint16_t in_len;
+	uint32_t addr;				/* Next block of a multi block transfer */
+	uint64_t busy_until;
+	uint32_t crc_faults;
+} sim_sd;
+
+static uint8_t sdc_crc7(const uint8_t *data, uint32_t len)
+{
+	uint8_t crc = 0, d;
+	uint32_t i;
+
+	while (len--)
+	{
+		d = *data++;
+		for (i = 0; i < 8; i++)
+		{
+			crc <<= 1;
+			if ((d ^ crc) & 0x80)
+			{
+				crc ^= 0x09;
+			}
+			d <<= 1;
+		}
+	}
+	return crc & 0x7F;
+}
+
+static uint16_t sdc_crc16(const uint8_t *data, uint32_t len)
+{
+	uint16_t crc = 0;
+	uint32_t i;
+
+	while (len--)
+	{
+		crc ^= (uint16_t)(*data++ << 8);
+		for (i = 0; i < 8; i++)
+		{
+			crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+		}
+	}
+	return crc;
+}
+
+static void sdc_put(const uint8_t *data, uint32_t len)
+{
+	if (sim_sd.out_rd + sim_sd.out_len + len > SDC_OUT_SIZE)
+	{
+		memmove(sim_sd.out, sim_sd.out + sim_sd.out_rd, sim_sd.out_len);
+		sim_sd.out_rd = 0;
+	}
+	if (sim_sd.out_len + len <= SDC_OUT_SIZE)
+	{
+		memcpy(sim_sd.out + sim_sd.out_rd + sim_sd.out_len, data, len);
+		sim_sd.out_len += len;
+	}
+}
+
+static void sdc_put1(uint8_t b)
+{
+	sdc_put(&b, 1);
+}
+
+/* Data block: Nac gap, start token, payload, CRC16 */
+static void sdc_put_block(const uint8_t *data, uint32_t len)
+{
+	uint16_t crc = sdc_crc16(data, len);
+	uint8_t hdr[2] = { 0xFF, 0xFE };
+
+	sdc_put(hdr, 2);
+	sdc_put(data, len);
+	if (sim_sd.crc_faults)
+	{
+		/* Corrupt the copy on the wire, the CRC still covers the original */
+		sim_sd.out[sim_sd.out_rd + sim_sd.out_len - 1 - (len / 2)] ^= 0x10;
+		sim_sd.crc_faults--;
+	}
+	sdc_put1((uint8_t)(crc >> 8));
+	sdc_put1((uint8_t)crc);
+}
+
+static void sdc_read_block(void)
+{
+	if (sim_sd.addr >= sim_sd.blocks)
+	{
+		sdc_put1(0xFF);
+		sdc_put1(0x08);			/* Error token: out of range */
+		sim_sd.mode = SDC_CMD;
+		return;
+	}
+	sdc_put_block(sim_sd.img + (uint64_t)sim_sd.addr * SDC_BLOCK, SDC_BLOCK);
+	sim_sd.addr++;
+}
+
+static void sdc_csd(uint8_t *csd)
+{
+	uint32_t c_size;
+
+	memset(csd, 0, 16);
+	csd[1] = 0x0E;				/* TAAC 1ms */
+	csd[3] = 0x32;				/* TRAN_SPEED 25MHz */
+	csd[4] = 0x5B;				/* CCC */
+	if (sim_sd.hc)
+	{
+		c_size = sim_sd.blocks / 1024 - 1;
+		csd[0] = 0x40;
+		csd[5] = 0x59;
+		csd[7] = (uint8_t)((c_size >> 16) & 0x3F);
+		csd[8] = (uint8_t)(c_size >> 8);
+		csd[9] = (uint8_t)c_size;
+	}
+	else
+	{
+		/* C_SIZE_MULT = 7, READ_BL_LEN 9 or 10 */
+		uint8_t bl_len = (sim_sd.blocks > 4096 * 512) ? 10 : 9;
+
+		c_size = (sim_sd.blocks >> bl_len) - 1;
+		csd[5] = 0x50 | bl_len;
+		csd[6] = (uint8_t)((c_size >> 10) & 0x03);
+		csd[7] = (uint8_t)(c_size >> 2);
+		csd[8] = (uint8_t)(c_size << 6);
+		csd[9] = 0x03;
+		csd[10] = 0x80;
+	}
+	csd[15] = (uint8_t)((sdc_crc7(csd, 15) << 1) | 0x01);
+}
+
+static void sdc_exec(void)
+{
+	static const uint8_t cid[16] = { 0x03, 'S', 'D', 'S', 'I', 'M', 'C', 'A', 'R', 0x10,
+									 0x12, 0x34, 0x56, 0x78, 0x01, 0x1A };
+	uint8_t cmd = sim_sd.cmd[0] & 0x3F;
+	uint32_t arg = ((uint32_t)sim_sd.cmd[1] << 24) | ((uint32_t)sim_sd.cmd[2] << 16) |
+				   ((uint32_t)sim_sd.cmd[3] << 8) | sim_sd.cmd[4];
+	uint8_t r1 = sim_sd.idle ? 0x01 : 0x00;
+	Bool app = sim_sd.app;
+	uint8_t buf[16];
+
+	sim_sd.app = FALSE;
+	if (cmd == 12)
+	{
+		/* Stop transmission: drop the block in flight, one stuff byte */
+		sim_sd.out_len = 0;
+		sim_sd.out_rd = 0;
+		sim_sd.mode = SDC_CMD;
+		sdc_put1(0x5A);
+		sdc_put1(r1);
+		sim_sd.busy_until = sim_now + HOSTSIM_UsToCycles(10);
+		return;
+	}
+	sdc_put1(0xFF);
+	if ((sim_sd.crc || (cmd == 0) || (cmd == 8)) &&
+		(((sdc_crc7(sim_sd.cmd, 5) << 1) | 0x01) != sim_sd.cmd[5]))
+	{
+		sdc_put1(r1 | 0x08);
+		return;
+	}
+	if (app)
+	{
+		switch (cmd)
+		{
+		case 41:
+			if (sim_sd.idle && (!sim_sd.hc || (arg & 0x40000000)) && (++sim_sd.polls >= SDC_INIT_POLLS))
+			{
+				sim_sd.idle = FALSE;
+			}
+			sdc_put1(sim_sd.idle ? 0x01 : 0x00);
+			return;
+		case 23:
+			sdc_put1(r1);
+			return;
+		default:
+			sdc_put1(r1 | 0x04);
+			return;
+		}
+	}
+	if (sim_sd.idle && ((cmd == 9) || (cmd == 10) || (cmd == 13) || (cmd == 16) ||
+						(cmd == 17) || (cmd == 18) || (cmd == 24) || (cmd == 25)))
+	{
+		sdc_put1(r1 | 0x04);
+		return;
+	}
+	switch (cmd)
+	{
+	case 0:
+		sim_sd.idle = TRUE;
+		sim_sd.polls = 0;
+		sim_sd.crc = FALSE;
+		sim_sd.mode = SDC_CMD;
+		sdc_put1(0x01);
+		break;
+	case 8:
+		if (!sim_sd.hc)
+		{
+			sdc_put1(r1 | 0x04);
+			break;
+		}
+		buf[0] = r1;
+		buf[1] = 0x00;
+		buf[2] = 0x00;
+		buf[3] = (uint8_t)((arg >> 8) & 0x0F);
+		buf[4] = (uint8_t)arg;
+		sdc_put(buf, 5);
+		break;
+	case 9:
+		sdc_put1(r1);
+		sdc_csd(buf);
+		sdc_put_block(buf, 16);
+		break;
+	case 10:
+		sdc_put1(r1);
+		sdc_put_block(cid, 16);
+		break;
+	case 13:
+		sdc_put1(r1);
+		sdc_put1(0x00);
+		break;
+	case 16:
+		sdc_put1((arg == SDC_BLOCK) ? r1 : (r1 | 0x40));
+		break;
+	case 17:
+	case 18:
+	case 24:
+	case 25:
+		if (!sim_sd.hc && (arg % SDC_BLOCK))
+		{
+			sdc_put1(r1 | 0x20);
+			break;
+		}
+		sim_sd.addr = sim_sd.hc ? arg : (arg / SDC_BLOCK);
+		if (sim_sd.addr >= sim_sd.blocks)
+		{
+			sdc_put1(r1 | 0x40);
+			break;
+		}
+		sdc_put1(r1);
+		if (cmd == 17)
+		{
+			sdc_read_block();
+		}
+		else if (cmd == 18)
+		{
+			sim_sd.mode = SDC_READ;
+		}
+		else
+		{
+			sim_sd.multi = (cmd == 25);
+			sim_sd.mode = SDC_WTOKEN;
+		}
+		break;
+	case 55:
+		sim_sd.app = TRUE;
+		sdc_put1(r1);
+		break;
+	case 58:
+		buf[0] = r1;
+		buf[1] = (sim_sd.hc && !sim_sd.idle) ? 0xC0 : 0x80;
+		buf[2] = 0xFF;
+		buf[3] = 0x80;
+		buf[4] = 0x00;
+		sdc_put(buf, 5);
+		break;
+	case 59:
+		sim_sd.crc = (arg & 0x01) ? TRUE : FALSE;
+		sdc_put1(r1);
+		break;
+	default:
+		sdc_put1(r1 | 0x04);
+		break;
+	}
+}
+
+static void sdc_input(uint8_t mosi)
+{
+	uint16_t crc;
+
+	switch (sim_sd.mode)
+	{
+	case SDC_WTOKEN:
+		if ((mosi == 0xFE) || (sim_sd.multi && (mosi == 0xFC)))
+		{
+			sim_sd.in_len = 0;
+			sim_sd.mode = SDC_WDATA;
+		}
+		else if (sim_sd.multi && (mosi == 0xFD))
+		{
+			/* Stop tran token, busy after one byte */
+			sdc_put1(0xFF);
+			sim_sd.busy_until = sim_now + HOSTSIM_UsToCycles(SDC_PROG_US);
+			sim_sd.mode = SDC_CMD;
+		}
+		break;
+	case SDC_WDATA:
+		sim_sd.in[sim_sd.in_len++] = mosi;
+		if (sim_sd.in_len < SDC_BLOCK + 2)
+		{
+			break;
+		}
+		sim_sd.mode = sim_sd.multi ? SDC_WTOKEN : SDC_CMD;
+		crc = (uint16_t)((sim_sd.in[SDC_BLOCK] << 8) | sim_sd.in[SDC_BLOCK + 1]);
+		if (sim_sd.crc && (crc != sdc_crc16(sim_sd.in, SDC_BLOCK)))
+		{
+			sdc_put1(0x0B);
+			break;
+		}
+		if (sim_sd.addr >= sim_sd.blocks)
+		{
+			sdc_put1(0x0D);
+			break;
+		}
+		memcpy(sim_sd.img + (uint64_t)sim_sd.addr * SDC_BLOCK, sim_sd.in, SDC_BLOCK);
+		sim_sd.addr++;
+		sdc_put1(0x05);
+		sim_sd.busy_until = sim_now + HOSTSIM_UsToCycles(SDC_PROG_US);
+		break;
+	default:
+		if ((sim_sd.cmd_len == 0) && ((mosi & 0xC0) != 0x40))
+		{
+			break;
+		}
+		sim_sd.cmd[sim_sd.cmd_len++] = mosi;
+		if (sim_sd.cmd_len == 6)
+		{
+			sim_sd.cmd_len = 0;
+			sdc_exec();
+		}
+		break;
+	}
+}
+
+static uint16_t sdc_spi(uint8_t port, uint16_t mosi)
+{
+	uint8_t miso;
+	(void)port;
+
+	if ((sim_sd.img == NULL) || (gpio_out[0] & (1UL << 16)))
+	{
+		sim_sd.cmd_len = 0;
+		return 0xFF;
+	}
+	if ((sim_sd.out_len == 0) && (sim_sd.mode == SDC_READ))
+	{
+		sdc_read_block();
+	}
+	if (sim_sd.out_len)
+	{
+		miso = sim_sd.out[sim_sd.out_rd++];
+		if (--sim_sd.out_len == 0)
+		{
+			sim_sd.out_rd = 0;
+		}
+	}
+	else
+	{
+		miso = (sim_now < sim_sd.busy_until) ? 0x00 : 0xFF;
+	}
+	sdc_input((uint8_t)mosi);
+	return miso;
+}
+
+/* I2C model ------------------------------------------------------------------ */
+#define I2C_AA		0x04
+#define I2C_SI		0x08
+#define I2C_STO		0x10
+#define I2C_STA		0x20
+#define I2C_EN		0x40
+
+enum { I2C_ACT_NONE, I2C_ACT_START, I2C_ACT_ADDR, I2C_ACT_TX, I2C_ACT_RX, I2C_ACT_STOP };
+
+typedef struct {
+	SIM_MODEL_T m;
+	IRQn_Type irq;
+	uint8_t sel, bit;
+	uint8_t con, stat, dat;
+	uint8_t act;
+	Bool master;
+	uint64_t done;
+	HOSTSIM_I2C_SLAVE_Type *slaves, *cur;
+} SIM_I2C_T;
+
+static SIM_I2C_T sim_i2c[3];
+
+static uint64_t i2c_bit(SIM_I2C_T *c)
+{
+	uint32_t t = (SIM_DOOR(&c->m, 0x10) & 0xFFFF) + (SIM_DOOR(&c->m, 0x14) & 0xFFFF);
+
+	return (uint64_t)((t < 8) ? 8 : t) * sim_pclk_div(c->sel, c->bit);
+}
+
+static void i2c_sched(SIM_I2C_T *c)
+{
+	c->m.next = (c->act != I2C_ACT_NONE) ? c->done : SIM_NEVER;
+	sim_irq(c->irq, (c->con & (I2C_SI | I2C_EN)) == (I2C_SI | I2C_EN));
+}
+
+static void i2c_start_act(SIM_I2C_T *c, uint8_t act, uint32_t bits)
+{
+	c->act = act;
+	c->done = sim_now + bits * i2c_bit(c);
+}
+
+/*********************************************************************//**
+ * @brief		Start the bus action selected by CONSET once SI is clear
+ * @param[in]	c		I2C model
+ * @return		None
+ **********************************************************************/
+static void i2c_kick(SIM_I2C_T *c)
+{
+	if (!(c->con & I2C_EN) || (c->con & I2C_SI) || (c->act != I2C_ACT_NONE))
+	{
+		return;
+	}
+	if (c->con & I2C_STO)
+	{
+		if (c->master)
+		{
+			i2c_start_act(c, I2C_ACT_STOP, 1);
+		}
+		else
+		{
+			c->con &= ~I2C_STO;
+		}
+		return;
+	}
+	if (c->con & I2C_STA)
+	{
+		i2c_start_act(c, I2C_ACT_START, 1);
+		return;
+	}
+	if (!c->master)
+	{
+		return;
+	}
+	switch (c->stat)
+	{
+	case 0x08: case 0x10:	i2c_start_act(c, I2C_ACT_ADDR, 9); break;
+	case 0x18: case 0x28:	i2c_start_act(c, I2C_ACT_TX, 9); break;
+	case 0x40: case 0x50:	i2c_start_act(c, I2C_ACT_RX, 9); break;
+	default:				break;
+	}
+}
+
+static void i2c_tick(SIM_MODEL_T *m)
+{
+	SIM_I2C_T *c = (SIM_I2C_T *)m;
+	HOSTSIM_I2C_SLAVE_Type *d;
+	Bool ack;
+
+	if ((c->act == I2C_ACT_NONE) || (sim_now < c->done))
+	{
+		i2c_sched(c);
+		return;
+	}
+	switch (c->act)
+	{
+	case I2C_ACT_START:
+		c->stat = c->master ? 0x10 : 0x08;
+		c->master = TRUE;
+		c->con |= I2C_SI;
+		break;
+	case I2C_ACT_ADDR:
+		c->cur = NULL;
+		for (d = c->slaves; d; d = d->Next)
+		{
+			if (((c->dat >> 1) & d->AddrMask) == (d->Addr & d->AddrMask))
+			{
+				break;
+			}
+		}
+		ack = (d != NULL) && d->Start(d, c->dat);
+		if (ack)
+		{
+			c->cur = d;
+		}
+		if (c->dat & 0x01)
+		{
+			c->stat = ack ? 0x40 : 0x48;
+		}
+		else
+		{
+			c->stat = ack ? 0x18 : 0x20;
+		}
+		c->con |= I2C_SI;
+		break;
+	case I2C_ACT_TX:
+		ack = (c->cur != NULL) && c->cur->Write(c->cur, c->dat);
+		c->stat = ack ? 0x28 : 0x30;
+		c->con |= I2C_SI;
+		break;
+	case I2C_ACT_RX:
+		c->dat = c->cur ? c->cur->Read(c->cur) : 0xFF;
+		c->stat = (c->con & I2C_AA) ? 0x50 : 0x58;
+		c->con |= I2C_SI;
+		break;
+	case I2C_ACT_STOP:
+		if (c->cur)
+		{
+			c->cur->Stop(c->cur);
+			c->cur = NULL;
+		}
+		c->master = FALSE;
+		c->con &= ~I2C_STO;
+		c->stat = 0xF8;
+		break;
+	default:
+		break;
+	}
+	c->act = I2C_ACT_NONE;
+	i2c_kick(c);
+	i2c_sched(c);
+}
+
+static uint32_t i2c_read(SIM_MODEL_T *m, uint32_t off, Bool peek)
+{
+	SIM_I2C_T *c = (SIM_I2C_T *)m;
+	(void)peek;
+
+	switch (off)
+	{
+	case 0x00:	return c->con;
+	/* No relevant state information while SI is clear */
+	case 0x04:	return (c->con & I2C_SI) ? c->stat : 0xF8;
+	case 0x08:	return c->dat;
+	case 0x18:	return 0;
+	default:	return SIM_DOOR(m, off);
+	}
+}
+
+static void i2c_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	SIM_I2C_T *c = (SIM_I2C_T *)m;
+
+	switch (off)
+	{
+	case 0x00:
+		c->con |= val & (I2C_AA | I2C_SI | I2C_STO | I2C_STA | I2C_EN);
+		break;
+	case 0x08:
+		c->dat = (uint8_t)val;
+		break;
+	case 0x18:
+		c->con &= ~(val & (I2C_AA | I2C_SI | I2C_STA | I2C_EN));
+		if (!(c->con & I2C_EN))
+		{
+			c->master = FALSE;
+			c->act = I2C_ACT_NONE;
+			c->stat = 0xF8;
+		}
+		break;
+	default:
+		break;
+	}
+	i2c_kick(c);
+	i2c_sched(c);
+}
+
+/* I2C EEPROM slave ----------------------------------------------------------- */
+static Bool eeprom_start(HOSTSIM_I2C_SLAVE_Type *dev, uint8_t sla)
+{
+	HOSTSIM_EEPROM_Type *ee = (HOSTSIM_EEPROM_Type *)dev;
+
+	if (ee->dead || (sim_now < ee->busy_until))
+	{
+		return FALSE;
+	}
+	if (!(sla & 0x01))
+	{
+		ee->ptr = (sla >> 1) & ~dev->AddrMask & 0x7F;
+		ee->phase = 0;
+	}
+	return TRUE;
+}
+
+static Bool eeprom_write(HOSTSIM_I2C_SLAVE_Type *dev, uint8_t data)
+{
+	HOSTSIM_EEPROM_Type *ee = (HOSTSIM_EEPROM_Type *)dev;
+	uint32_t page = ee->PageSize - 1;
+
+	if (ee->phase < ee->AddrBytes)
+	{
+		ee->ptr = (ee->ptr << 8) | data;
+		if (++ee->phase == ee->AddrBytes)
+		{
+			ee->ptr &= ee->Size - 1;
+		}
+		return TRUE;
+	}
+	if (ee->cut >= 0)
+	{
+		/* Power lost, bytes already clocked in stay programmed */
+		if (ee->cut == 0)
+		{
+			ee->dead = 1;
+			return FALSE;
+		}
+		ee->cut--;
+	}
+	ee->Mem[ee->ptr] = data;
+	ee->ptr = (ee->ptr & ~page) | ((ee->ptr + 1) & page);
+	ee->dirty = 1;
+	return TRUE;
+}
+
+static uint8_t eeprom_read(HOSTSIM_I2C_SLAVE_Type *dev)
+{
+	HOSTSIM_EEPROM_Type *ee = (HOSTSIM_EEPROM_Type *)dev;
+	uint8_t data = ee->Mem[ee->ptr];
+
+	ee->ptr = (ee->ptr + 1) & (ee->Size - 1);
+	return data;
+}
+
+static void eeprom_stop(HOSTSIM_I2C_SLAVE_Type *dev)
+{
+	HOSTSIM_EEPROM_Type *ee = (HOSTSIM_EEPROM_Type *)dev;
+
+	if (ee->dirty)
+	{
+		ee->busy_until = sim_now + HOSTSIM_UsToCycles(ee->WriteTimeUs);
+		ee->dirty = 0;
+	}
+}
+
+/* Timer model ---------------------------------------------------------------- */
+/* TC and PC follow the virtual clock, or in counter mode the edges of the
+ * selected capture input. Matches set IR, reset or stop the counter and
+ * drive the EMR outputs. Capture inputs are square waves set with
+ * HOSTSIM_TimerSetInput(), sampled at PCLK: CRn takes TC at the last edge
+ * enabled in CCR. Captures in counter mode are not modelled, and TC does
+ * not see matches past its 32 bit wrap. */
+#define TIM_OFS(reg)	SIM_OFS(LPC_TIM_TypeDef, reg)
+
+/* Square wave on a capture input: rising edges at t0 + k * per (k >= 1),
+ * falling half way between them. per 0 holds the input low. */
+typedef struct {
+	double per, t0;
+} SIM_TIM_SIG_T;
+
+typedef struct {
+	SIM_MODEL_T m;
+	IRQn_Type irq;
+	uint8_t sel, bit;
+	uint64_t upd;				/* Virtual time TC/PC were last brought up to date */
+	uint32_t tc, pc, ir;
+	uint32_t tcr, pr;			/* Values TC/PC counted with since upd */
+	uint32_t ctcr, ccr;
+	SIM_TIM_SIG_T sig[2];
+} SIM_TIM_T;
+
+static SIM_TIM_T sim_tim[4];
+
+/* Spacing and offset of the edges in edge mask e (1 rising, 2 falling) */
+static double sig_step(const SIM_TIM_SIG_T *s, uint32_t e, double *ofs)
+{
+	*ofs = (e == 2) ? -s->per / 2 : 0;
+	return (e == 3) ? s->per / 2 : s->per;
+}
+
+/* Edges in mask e up to virtual time t */
+static uint64_t sig_edges(const SIM_TIM_SIG_T *s, uint32_t e, uint64_t t)
+{
+	double ofs, step, k;
+
+	if ((s->per == 0) || ((e &= 3) == 0))
+	{
+		return 0;
+	}
+	step = sig_step(s, e, &ofs);
+	k = floor(((double)t - s->t0 - ofs) / step);
+	return (k > 0) ? (uint64_t)k : 0;
+}
+
+/* Virtual time of edge number n (from 1) of mask e */
+static double sig_time(const SIM_TIM_SIG_T *s, uint32_t e, uint64_t n)
+{
+	double ofs, step;
+
+	step = sig_step(s, e & 3, &ofs);
+	return s->t0 + ofs + (double)n * step;
+}
+
+static uint32_t tim_mr(SIM_TIM_T *t, uint32_t n)
+{
+	return SIM_DOOR(&t->m, (n < 4) ? TIM_OFS(MR0) + 4 * n : TIM_OFS(MR0));
+}
+
+/* TRUE if TC sits on a match that resets it on the next count */
+static Bool tim_at_reset(SIM_TIM_T *t)
+{
+	uint32_t mcr = SIM_DOOR(&t->m, TIM_OFS(MCR));
+	uint32_t n;
+
+	for (n = 0; n < 4; n++)
+	{
+		if ((mcr & (2UL << (3 * n))) && (tim_mr(t, n) == t->tc))
+		{
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/* Counts until TC reaches the next match with an action, 0 if none */
+static uint32_t tim_next_match(SIM_TIM_T *t)
+{
+	uint32_t mcr = SIM_DOOR(&t->m, TIM_OFS(MCR));
+	uint32_t emr = SIM_DOOR(&t->m, TIM_OFS(EMR));
+	uint32_t cur = t->tc, add = 0, d = 0, mr, n;
+
+	if (tim_at_reset(t))
+	{
+		cur = 0;
+		add = 1;
+	}
+	for (n = 0; n < 4; n++)
+	{
+		if (!(mcr & (7UL << (3 * n))) && !(emr & (3UL << (4 + 2 * n))))
+		{
+			continue;
+		}
+		mr = tim_mr(t, n);
+		if ((mr > cur) || ((mr == cur) && add))
+		{
+			if ((d == 0) || (mr - cur + add < d))
+			{
+				d = mr - cur + add;
+			}
+		}
+	}
+	return d;
+}
+
+/* TC has reached a new value: act on the matches */
+static void tim_match(SIM_TIM_T *t)
+{
+	uint32_t mcr = SIM_DOOR(&t->m, TIM_OFS(MCR));
+	uint32_t emr = SIM_DOOR(&t->m, TIM_OFS(EMR));
+	uint32_t n;
+
+	for (n = 0; n < 4; n++)
+	{
+		if (tim_mr(t, n) != t->tc)
+		{
+			continue;
+		}
+		if (mcr & (1UL << (3 * n)))
+		{
+			t->ir |= 1UL << n;
+		}
+		switch ((emr >> (4 + 2 * n)) & 0x03)
+		{
+		case 1:
+			emr &= ~(1UL << n);
+			break;
+		case 2:
+			emr |= 1UL << n;
+			break;
+		case 3:
+			emr ^= 1UL << n;
+			break;
+		default:
+			break;
+		}
+		if (mcr & (4UL << (3 * n)))
+		{
+			t->tcr &= ~0x01UL;
+			SIM_DOOR(&t->m, TIM_OFS(TCR)) = t->tcr;
+			t->pc = 0;
+		}
+	}
+	SIM_DOOR(&t->m, TIM_OFS(EMR)) = emr;
+}
+
+/* Count n prescaler inputs */
+static void tim_count(SIM_TIM_T *t, uint64_t n)
+{
+	uint64_t pr = (uint64_t)t->pr + 1;
+	uint64_t k;
+	uint32_t d;
+
+	if (!(t->tcr & 0x01) || (t->tcr & 0x02))
+	{
+		return;
+	}
+	n += t->pc;
+	k = n / pr;
+	t->pc = (uint32_t)(n % pr);
+	while (k && (t->tcr & 0x01))
+	{
+		d = tim_next_match(t);
+		if ((d == 0) || (d > k))
+		{
+			t->tc = tim_at_reset(t) ? (uint32_t)(k - 1) : t->tc + (uint32_t)k;
+			break;
+		}
+		t->tc = tim_at_reset(t) ? d - 1 : t->tc + d;
+		k -= d;
+		tim_match(t);
+	}
+}
+
+static void tim_update(SIM_TIM_T *t)
+{
+	uint64_t div = sim_pclk_div(t->sel, t->bit);
+	uint64_t n = (sim_now - t->upd) / div;
+	uint64_t end = t->upd + n * div;
+	uint32_t ctcr = t->ctcr, ccr = t->ccr;
+	uint64_t at[2], done = 0, e;
+	uint32_t c, first;
+
+	if (n == 0)
+	{
+		return;
+	}
+	if (ctcr & 0x03)
+	{
+		/* Counter mode: count the edges of the selected input */
+		c = (ctcr >> 2) & 0x01;
+		tim_count(t, sig_edges(&t->sig[c], ctcr, end) - sig_edges(&t->sig[c], ctcr, t->upd));
+		t->upd = end;
+		return;
+	}
+
+	/* PCLK of the last enabled edge of each input, 0 if none */
+	for (c = 0; c < 2; c++)
+	{
+		at[c] = 0;
+		e = sig_edges(&t->sig[c], ccr >> (3 * c), end);
+		if (e > sig_edges(&t->sig[c], ccr >> (3 * c), t->upd))
+		{
+			at[c] = (uint64_t)ceil((sig_time(&t->sig[c], ccr >> (3 * c), e) - (double)t->upd) / (double)div);
+			at[c] = (at[c] == 0) ? 1 : ((at[c] > n) ? n : at[c]);
+		}
+	}
+	first = (at[1] && (!at[0] || (at[1] < at[0]))) ? 1 : 0;
+	for (c = first; c < first + 2; c++)
+	{
+		if (at[c & 1])
+		{
+			tim_count(t, at[c & 1] - done);
+			done = at[c & 1];
+			SIM_DOOR(&t->m, (c & 1) ? TIM_OFS(CR1) : TIM_OFS(CR0)) = t->tc;
+			if (ccr & (4UL << (3 * (c & 1))))
+			{
+				t->ir |= 0x10UL << (c & 1);
+			}
+		}
+	}
+	tim_count(t, n - done);
+	t->upd = end;
+}
+
+static void tim_sched(SIM_TIM_T *t)
+{
+	uint64_t div = sim_pclk_div(t->sel, t->bit);
+	uint32_t ctcr = t->ctcr, ccr = t->ccr;
+	uint64_t next, e;
+	double te;
+	uint32_t c, d;
+
+	t->m.next = SIM_NEVER;
+	if ((t->tcr & 0x01) && !(t->tcr & 0x02) && ((d = tim_next_match(t)) != 0))
+	{
+		e = (uint64_t)d * (t->pr + 1) - t->pc;
+		if (!(ctcr & 0x03))
+		{
+			t->m.next = t->upd + e * div;
+		}
+		else if (t->sig[(ctcr >> 2) & 0x01].per != 0)
+		{
+			c = (ctcr >> 2) & 0x01;
+			te = sig_time(&t->sig[c], ctcr, sig_edges(&t->sig[c], ctcr, t->upd) + e);
+			t->m.next = t->upd + (uint64_t)ceil((te - (double)t->upd) / (double)div) * div;
+		}
+	}
+
+	/* Next edge of an input with its capture interrupt armed */
+	for (c = 0; (c < 2) && !(ctcr & 0x03); c++)
+	{
+		if ((ccr & (4UL << (3 * c))) && (ccr & (3UL << (3 * c))) &&
+			!(t->ir & (0x10UL << c)) && (t->sig[c].per != 0))
+		{
+			te = sig_time(&t->sig[c], ccr >> (3 * c), sig_edges(&t->sig[c], ccr >> (3 * c), t->upd) + 1);
+			next = (uint64_t)ceil((te - (double)t->upd) / (double)div);
+			next = t->upd + ((next == 0) ? 1 : next) * div;
+			if (next < t->m.next)
+			{
+				t->m.next = next;
+			}
+		}
+	}
+	sim_irq(t->irq, (t->ir & 0x3F) != 0);
+}
+
+static uint32_t tim_read(SIM_MODEL_T *m, uint32_t off, Bool peek)
+{
+	SIM_TIM_T *t = (SIM_TIM_T *)m;
+	(void)peek;
+
+	tim_update(t);
+	tim_sched(t);
+	switch (off)
+	{
+	case TIM_OFS(IR):
+		return t->ir;
+	case TIM_OFS(TC):
+		return t->tc;
+	case TIM_OFS(PC):
+		return t->pc;
+	default:
+		return SIM_DOOR(m, off);
+	}
+}
+
+static void tim_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	SIM_TIM_T *t = (SIM_TIM_T *)m;
+
+	tim_update(t);
+	switch (off)
+	{
+	case TIM_OFS(IR):
+		t->ir &= ~val;
+		break;
+	case TIM_OFS(TCR):
+		t->tcr = val & 0x03;
+		if (val & 0x02)
+		{
+			t->tc = 0;
+			t->pc = 0;
+		}
+		break;
+	case TIM_OFS(PR):
+		t->pr = val;
+		break;
+	case TIM_OFS(CTCR):
+		t->ctcr = val & 0x0F;
+		break;
+	case TIM_OFS(CCR):
+		t->ccr = val & 0x3F;
+		break;
+	case TIM_OFS(TC):
+		t->tc = val;
+		break;
+	case TIM_OFS(PC):
+		t->pc = val;
+		break;
+	default:
+		break;
+	}
+	tim_sched(t);
+}
+
+static void tim_tick(SIM_MODEL_T *m)
+{
+	SIM_TIM_T *t = (SIM_TIM_T *)m;
+
+	tim_update(t);
+	tim_sched(t);
+}
+
+/* RIT model ------------------------------------------------------------------ */
+/* RICOUNTER follows the virtual clock at PCLK_RIT. Reaching RICOMPVAL sets
+ * RITINT and with RITENCLR clears the counter on the next count. RIMASK
+ * is not modelled. */
+#define RIT_OFS(reg)	SIM_OFS(LPC_RIT_TypeDef, reg)
+
+typedef struct {
+	SIM_MODEL_T m;
+	uint64_t upd;
+	uint32_t ctrl, cnt;
+} SIM_RIT_T;
+
+static SIM_RIT_T sim_rit;
+
+/* Counts from cnt to the next compare match, and the match period */
+static uint64_t rit_to_match(SIM_RIT_T *r, uint64_t *period)
+{
+	uint32_t cmp = SIM_DOOR(&r->m, RIT_OFS(RICOMPVAL));
+
+	*period = (r->ctrl & 0x02) ? (uint64_t)cmp + 1 : 0x100000000ULL;
+	if (r->cnt < cmp)
+	{
+		return cmp - r->cnt;
+	}
+	return (r->cnt == cmp) ? *period : 0x100000000ULL - r->cnt + cmp;
+}
+
+static void rit_update(SIM_RIT_T *r)
+{
+	uint64_t div = sim_pclk_div(1, 26);
+	uint64_t n = (sim_now - r->upd) / div;
+	uint32_t cmp = SIM_DOOR(&r->m, RIT_OFS(RICOMPVAL));
+	uint64_t h, period;
+
+	r->upd += n * div;
+	if (!(r->ctrl & 0x08) || (n == 0))
+	{
+		return;
+	}
+	h = rit_to_match(r, &period);
+	if (n < h)
+	{
+		/* Sitting on the match with RITENCLR, the next count is 0 */
+		r->cnt = ((r->ctrl & 0x02) && (r->cnt == cmp)) ? (uint32_t)(n - 1) : r->cnt + (uint32_t)n;
+		return;
+	}
+	r->ctrl |= 0x01;
+	n -= h;
+	r->cnt = (n == 0) ? cmp : (uint32_t)((n - 1) % period);
+}
+
+static void rit_sched(SIM_RIT_T *r)
+{
+	uint64_t period;
+
+	r->m.next = SIM_NEVER;
+	if ((r->ctrl & 0x08) && !(r->ctrl & 0x01))
+	{
+		r->m.next = r->upd + rit_to_match(r, &period) * sim_pclk_div(1, 26);
+	}
+	sim_irq(RIT_IRQn, (r->ctrl & 0x01) != 0);
+}
+
+static uint32_t rit_read(SIM_MODEL_T *m, uint32_t off, Bool peek)
+{
+	SIM_RIT_T *r = (SIM_RIT_T *)m;
+	(void)peek;
+
+	rit_update(r);
+	rit_sched(r);
+	switch (off)
+	{
+	case RIT_OFS(RICTRL):
+		return r->ctrl;
+	case RIT_OFS(RICOUNTER):
+		return r->cnt;
+	default:
+		return SIM_DOOR(m, off);
+	}
+}
+
+static void rit_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	SIM_RIT_T *r = (SIM_RIT_T *)m;
+
+	rit_update(r);
+	switch (off)
+	{
+	case RIT_OFS(RICTRL):
+		r->ctrl = (val & 0x0E) | (r->ctrl & ~val & 0x01);
+		break;
+	case RIT_OFS(RICOUNTER):
+		r->cnt = val;
+		break;
+	default:
+		break;
+	}
+	rit_sched(r);
+}
+
+static void rit_tick(SIM_MODEL_T *m)
+{
+	SIM_RIT_T *r = (SIM_RIT_T *)m;
+
+	rit_update(r);
+	rit_sched(r);
+}
+
+/* PWM model ------------------------------------------------------------------ */
+/* TC resets on MR0. With PWM mode on, match writes only take effect at that
+ * reset for the channels latched in LER. The sink set by HOSTSIM_PWMSetSink()
+ * sees the match values of each period as it starts. */
+#define PWM_OFS(reg)		SIM_OFS(LPC_PWM_TypeDef, reg)
+
+typedef struct {
+	SIM_MODEL_T m;
+	uint64_t upd;				/* Virtual time TC/PC were last brought up to date */
+	uint32_t tc, pc, ir;
+	uint32_t tcr, pr;
+	uint32_t act[7];			/* Match values in effect */
+	HOSTSIM_PWM_SINK_Type sink;
+} SIM_PWM_T;
+
+static SIM_PWM_T sim_pwm;
+
+static uint32_t pwm_mr_ofs(uint32_t n)
+{
+	return (n < 4) ? PWM_OFS(MR0) + 4 * n : PWM_OFS(MR4) + 4 * (n - 4);
+}
+
+/* Counts left in the period, 0 if TC does not reset on MR0 */
+static uint32_t pwm_left(SIM_PWM_T *p)
+{
+	if (!(SIM_DOOR(&p->m, PWM_OFS(MCR)) & 0x02) || (p->tc > p->act[0]))
+	{
+		return 0;
+	}
+	return p->act[0] + 1 - p->tc;
+}
+
+/* Counter reset with PWM mode on: the match registers enabled in LER
+ * take effect */
+static void pwm_latch(SIM_PWM_T *p)
+{
+	uint32_t ler = SIM_DOOR(&p->m, PWM_OFS(LER)) & 0x7F;
+	uint32_t n;
+
+	if (p->tcr & 0x08)
+	{
+		for (n = 0; n < 7; n++)
+		{
+			if (ler & (1UL << n))
+			{
+				p->act[n] = SIM_DOOR(&p->m, pwm_mr_ofs(n));
+			}
+		}
+		SIM_DOOR(&p->m, PWM_OFS(LER)) = 0;
+	}
+}
+
+/* Period boundary on MR0 */
+static void pwm_reset(SIM_PWM_T *p)
+{
+	p->tc = 0;
+	if (SIM_DOOR(&p->m, PWM_OFS(MCR)) & 0x01)
+	{
+		p->ir |= 0x01;
+	}
+	pwm_latch(p);
+	if (p->sink)
+	{
+		p->sink(p->act, sim_now);
+	}
+}
+
+static void pwm_update(SIM_PWM_T *p)
+{
+	uint64_t div = sim_pclk_div(0, 12);
+	uint64_t n = (sim_now - p->upd) / div;
+	uint64_t k;
+	uint32_t d;
+
+	p->upd += n * div;
+	if (!(p->tcr & 0x01) || (p->tcr & 0x02))
+	{
+		return;
+	}
+	n += p->pc;
+	k = n / ((uint64_t)p->pr + 1);
+	p->pc = (uint32_t)(n % ((uint64_t)p->pr + 1));
+	while (k)
+	{
+		d = pwm_left(p);
+		if ((d == 0) || (d > k))
+		{
+			p->tc += (uint32_t)k;
+			break;
+		}
+		k -= d;
+		pwm_reset(p);
+	}
+}
+
+static void pwm_sched(SIM_PWM_T *p)
+{
+	uint32_t d;
+
+	p->m.next = SIM_NEVER;
+	if ((p->tcr & 0x01) && !(p->tcr & 0x02) && ((d = pwm_left(p)) != 0))
+	{
+		p->m.next = p->upd + ((uint64_t)d * (p->pr + 1) - p->pc) * sim_pclk_div(0, 12);
+	}
+	sim_irq(PWM1_IRQn, (p->ir & 0x73F) != 0);
+}
+
+static uint32_t pwm_read(SIM_MODEL_T *m, uint32_t off, Bool peek)
+{
+	SIM_PWM_T *p = (SIM_PWM_T *)m;
+	(void)peek;
+
+	pwm_update(p);
+	pwm_sched(p);
+	switch (off)
+	{
+	case PWM_OFS(IR):
+		return p->ir;
+	case PWM_OFS(TC):
+		return p->tc;
+	case PWM_OFS(PC):
+		return p->pc;
+	default:
+		return SIM_DOOR(m, off);
+	}
+}
+
+static void pwm_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	SIM_PWM_T *p = (SIM_PWM_T *)m;
+	uint32_t n;
+
+	pwm_update(p);
+	switch (off)
+	{
+	case PWM_OFS(IR):
+		p->ir &= ~val;
+		break;
+	case PWM_OFS(TCR):
+		p->tcr = val & 0x0B;
+		if (val & 0x02)
+		{
+			p->tc = 0;
+			p->pc = 0;
+			pwm_latch(p);
+		}
+		break;
+	case PWM_OFS(PR):
+		p->pr = val;
+		break;
+	case PWM_OFS(TC):
+		p->tc = val;
+		break;
+	case PWM_OFS(PC):
+		p->pc = val;
+		break;
+	default:
+		// Match registers are written straight through until PWM mode is on
+		for (n = 0; n < 7; n++)
+		{
+			if ((off == pwm_mr_ofs(n)) && !(p->tcr & 0x08))
+			{
+				p->act[n] = val;
+			}
+		}
+		break;
+	}
+	pwm_sched(p);
+}
+
+static void pwm_tick(SIM_MODEL_T *m)
+{
+	SIM_PWM_T *p = (SIM_PWM_T *)m;
+
+	pwm_update(p);
+	pwm_sched(p);
+}
+
+/* Motor plant ---------------------------------------------------------------- */
+/* DC motor on a full bridge, MCPWM channel 0 in locked anti-phase: MCOA0
+ * drives one leg and MCOB0 the other, so the motor sees Vbus times twice
+ * the high fraction of MCOA0 less one. The plant is brought up to date in
+ * steps of MOTOR_STEP cycles whenever MCPWM or QEI need its state. */
+#define MOTOR_STEP			1000
+#define MOTOR_TWO_PI		6.283185307179586
+
+static struct {
+	HOSTSIM_MOTOR_Type p;
+	Bool on;					/* Attached */
+	Bool drive;					/* Bridge switching, otherwise no current flows */
+	uint64_t upd;
+	double volts, load;
+	double amps, w, theta;		/* Current (A), speed (rad/s), angle (rad) */
+	int64_t edges;				/* Angle in quadrature edges */
+	uint64_t travel;			/* Edges counted in either direction */
+	int8_t dir;					/* Direction of the last edge */
+} sim_motor;
+
+static void motor_advance(void)
+{
+	double dt, torque, w, x;
+	uint64_t n;
+	int64_t e;
+
+	if (!sim_motor.on)
+	{
+		sim_motor.upd = sim_now;
+		return;
+	}
+	while (sim_motor.upd < sim_now)
+	{
+		n = sim_now - sim_motor.upd;
+		if (n > MOTOR_STEP)
+		{
+			n = MOTOR_STEP;
+		}
+		sim_motor.upd += n;
+		dt = (double)n / sc_cclk(&sim_sc);
+
+		if (!sim_motor.drive)
+		{
+			sim_motor.amps = 0;
+		}
+		else if (sim_motor.p.L > 0)
+		{
+			// Implicit Euler, stable for any L/R
+			sim_motor.amps = (sim_motor.amps + dt / sim_motor.p.L * (sim_motor.volts - sim_motor.p.Ke * sim_motor.w))
+							 / (1 + dt * sim_motor.p.R / sim_motor.p.L);
+		}
+		else
+		{
+			sim_motor.amps = (sim_motor.volts - sim_motor.p.Ke * sim_motor.w) / sim_motor.p.R;
+		}
+
+		// Coulomb friction opposes motion and holds the rotor at rest
+		// until the rest of the torque beats it
+		torque = sim_motor.p.Kt * sim_motor.amps - sim_motor.p.B * sim_motor.w - sim_motor.load;
+		if ((sim_motor.w > 0) || ((sim_motor.w == 0) && (torque > sim_motor.p.Friction)))
+		{
+			torque -= sim_motor.p.Friction;
+		}
+		else if ((sim_motor.w < 0) || (torque < -sim_motor.p.Friction))
+		{
+			torque += sim_motor.p.Friction;
+		}
+		else
+		{
+			torque = 0;
+		}
+		w = sim_motor.w + dt * torque / sim_motor.p.J;
+		if (((sim_motor.w > 0) && (w < 0)) || ((sim_motor.w < 0) && (w > 0)))
+		{
+			w = 0;
+		}
+		sim_motor.theta += 0.5 * (sim_motor.w + w) * dt;
+		sim_motor.w = w;
+
+		x = sim_motor.theta * 4 * sim_motor.p.Ppr / MOTOR_TWO_PI;
+		e = (int64_t)x;
+		if (x < e)
+		{
+			e--;
+		}
+		if (e != sim_motor.edges)
+		{
+			sim_motor.travel += (e > sim_motor.edges) ? (uint64_t)(e - sim_motor.edges) : (uint64_t)(sim_motor.edges - e);
+			sim_motor.dir = (e > sim_motor.edges) ? 1 : -1;
+			sim_motor.edges = e;
+		}
+	}
+}
+
+/* MCPWM model ---------------------------------------------------------------- */
+/* Edge and center aligned timing of the three channels, write registers
+ * taken over at the end of each period unless DISUP is set, and the limit
+ * interrupts. Channel 0 drives the motor plant. Match, capture and count
+ * functions, dead time and the DC/AC modes are not modelled. */
+#define MC_OFS(reg)			SIM_OFS(LPC_MCPWM_TypeDef, reg)
+#define MC_RUN(n)			(1UL << ((n) * 8))
+#define MC_CENTER(n)		(1UL << ((n) * 8 + 1))
+#define MC_POLA(n)			(1UL << ((n) * 8 + 2))
+#define MC_DISUP(n)			(1UL << ((n) * 8 + 4))
+
+typedef struct {
+	SIM_MODEL_T m;
+	uint64_t upd;
+	uint32_t con, inten, flag;
+	uint32_t pos[3];			/* PCLK ticks into the period */
+	uint32_t per[3], pw[3];		/* Functional registers */
+} SIM_MCPWM_T;
+
+static SIM_MCPWM_T sim_mcpwm;
+
+/* Ticks in a period, 0 while the channel is stopped */
+static uint32_t mc_period(SIM_MCPWM_T *c, uint32_t n)
+{
+	if (!(c->con & MC_RUN(n)) || (c->per[n] == 0))
+	{
+		return 0;
+	}
+	return (c->con & MC_CENTER(n)) ? 2 * c->per[n] : c->per[n] + 1;
+}
+
+/* Motor voltage from channel 0 */
+static void mc_drive(SIM_MCPWM_T *c)
+{
+	uint32_t period = mc_period(c, 0);
+	uint32_t high;
+	double frac;
+
+	motor_advance();
+	sim_motor.drive = (period != 0) ? TRUE : FALSE;
+	if (period == 0)
+	{
+		return;
+	}
+	// MCOA0 sits in its passive state while TC < MCPW0
+	high = (c->con & MC_CENTER(0)) ? 2 * ((c->pw[0] < c->per[0]) ? c->pw[0] : c->per[0])
+								  : ((c->pw[0] < period) ? c->pw[0] : period);
+	frac = (double)high / period;
+	if (!(c->con & MC_POLA(0)))
+	{
+		frac = 1 - frac;
+	}
+	sim_motor.volts = sim_motor.p.Vbus * (2 * frac - 1);
+}
+
+/* Load the functional registers from the write registers */
+static void mc_load(SIM_MCPWM_T *c, uint32_t n)
+{
+	c->per[n] = SIM_DOOR(&c->m, MC_OFS(MCPER0) + 4 * n);
+	c->pw[n] = SIM_DOOR(&c->m, MC_OFS(MCPW0) + 4 * n);
+	if (n == 0)
+	{
+		mc_drive(c);
+	}
+}
+
+static void mc_update(SIM_MCPWM_T *c)
+{
+	uint64_t div = sim_pclk_div(1, 30);
+	uint64_t k = (sim_now - c->upd) / div;
+	uint32_t n, period;
+
+	c->upd += k * div;
+	for (n = 0; n < 3; n++)
+	{
+		if ((period = mc_period(c, n)) == 0)
+		{
+			continue;
+		}
+		if (c->pos[n] + k >= period)
+		{
+			c->pos[n] = (uint32_t)((c->pos[n] + k) % period);
+			c->flag |= 1UL << (n * 4);
+			if (!(c->con & MC_DISUP(n)))
+			{
+				mc_load(c, n);
+			}
+		}
+		else
+		{
+			c->pos[n] += (uint32_t)k;
+		}
+	}
+}
+
+static void mc_sched(SIM_MCPWM_T *c)
+{
+	uint64_t div = sim_pclk_div(1, 30);
+	uint64_t t;
+	uint32_t n, period;
+
+	c->m.next = SIM_NEVER;
+	for (n = 0; n < 3; n++)
+	{
+		if ((period = mc_period(c, n)) != 0)
+		{
+			t = c->upd + (uint64_t)(period - c->pos[n]) * div;
+			if (t < c->m.next)
+			{
+				c->m.next = t;
+			}
+		}
+	}
+	sim_irq(MCPWM_IRQn, (c->flag & c->inten) != 0);
+}
+
+static uint32_t mc_read(SIM_MODEL_T *m, uint32_t off, Bool peek)
+{
+	SIM_MCPWM_T *c = (SIM_MCPWM_T *)m;
+	uint32_t n;
+	(void)peek;
+
+	mc_update(c);
+	mc_sched(c);
+	switch (off)
+	{
+	case MC_OFS(MCCON):
+		return c->con;
+	case MC_OFS(MCINTEN):
+		return c->inten;
+	case MC_OFS(MCINTFLAG):
+		return c->flag;
+	case MC_OFS(MCTIM0): case MC_OFS(MCTIM1): case MC_OFS(MCTIM2):
+		n = (off - MC_OFS(MCTIM0)) / 4;
+		if ((c->con & MC_CENTER(n)) && (c->pos[n] > c->per[n]))
+		{
+			return 2 * c->per[n] - c->pos[n];
+		}
+		return c->pos[n];
+	default:
+		return SIM_DOOR(m, off);
+	}
+}
+
+static void mc_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	SIM_MCPWM_T *c = (SIM_MCPWM_T *)m;
+	uint32_t n, was = c->con;
+
+	mc_update(c);
+	switch (off)
+	{
+	case MC_OFS(MCCON_SET):
+	case MC_OFS(MCCON_CLR):
+		c->con = (off == MC_OFS(MCCON_SET)) ? (c->con | val) : (c->con & ~val);
+		for (n = 0; n < 3; n++)
+		{
+			if ((c->con ^ was) & MC_RUN(n) & c->con)
+			{
+				mc_load(c, n);
+			}
+		}
+		mc_drive(c);
+		break;
+	case MC_OFS(MCTIM0): case MC_OFS(MCTIM1): case MC_OFS(MCTIM2):
+		c->pos[(off - MC_OFS(MCTIM0)) / 4] = val;
+		break;
+	case MC_OFS(MCPER0): case MC_OFS(MCPER1): case MC_OFS(MCPER2):
+	case MC_OFS(MCPW0): case MC_OFS(MCPW1): case MC_OFS(MCPW2):
+		// Straight through while the channel is stopped
+		n = ((off - MC_OFS(MCPER0)) / 4) % 3;
+		if (!(c->con & MC_RUN(n)))
+		{
+			mc_load(c, n);
+		}
+		break;
+	case MC_OFS(MCINTEN_SET):
+		c->inten |= val;
+		break;
+	case MC_OFS(MCINTEN_CLR):
+		c->inten &= ~val;
+		break;
+	case MC_OFS(MCINTFLAG_SET):
+		c->flag |= val;
+		break;
+	case MC_OFS(MCINTFLAG_CLR):
+		c->flag &= ~val;
+		break;
+	default:
+		break;
+	}
+	mc_sched(c);
+}
+
+static void mc_tick(SIM_MODEL_T *m)
+{
+	SIM_MCPWM_T *c = (SIM_MCPWM_T *)m;
+
+	mc_update(c);
+	mc_sched(c);
+}
+
+/* QEI model ------------------------------------------------------------------ */
+/* Position, index and velocity counters fed by the motor plant, the
+ * velocity timer with its capture and the TIM, VELC and DIR interrupts.
+ * The velocity timer is held while QEILOAD is 0. */
+#define QEI_OFS(reg)		SIM_OFS(LPC_QEI_TypeDef, reg)
+
+typedef struct {
+	SIM_MODEL_T m;
+	uint64_t upd;				/* Start of the velocity timer period */
+	int64_t base, ibase;		/* Counts at the last position and index reset */
+	uint64_t vbase;				/* Motor travel at the start of the period */
+	uint32_t cap, stat, ie;
+	int8_t dir;
+} SIM_QEI_T;
+
+static SIM_QEI_T sim_qei;
+
+/* Motor angle in counts of the capture mode */
+static int64_t qei_counts(SIM_QEI_T *q)
+{
+	uint32_t conf = SIM_DOOR(&q->m, QEI_OFS(QEICONF));
+	int64_t e = sim_motor.edges;
+
+	if (!(conf & 0x04))
+	{
+		e >>= 1;
+	}
+	return (conf & 0x01) ? -e : e;
+}
+
+static uint32_t qei_vel(SIM_QEI_T *q)
+{
+	uint64_t v = sim_motor.travel - q->vbase;
+
+	return (uint32_t)((SIM_DOOR(&q->m, QEI_OFS(QEICONF)) & 0x04) ? v : (v >> 1));
+}
+
+static uint64_t qei_period(SIM_QEI_T *q)
+{
+	uint32_t load = SIM_DOOR(&q->m, QEI_OFS(QEILOAD));
+
+	return (load == 0) ? 0 : ((uint64_t)load + 1) * sim_pclk_div(1, 0);
+}
+
+static void qei_update(SIM_QEI_T *q)
+{
+	uint64_t period;
+
+	motor_advance();
+	if ((sim_motor.dir != 0) && (sim_motor.dir != q->dir))
+	{
+		if (q->dir != 0)
+		{
+			q->stat |= 0x08;
+		}
+		q->dir = sim_motor.dir;
+	}
+	if (((period = qei_period(q)) != 0) && (sim_now - q->upd >= period))
+	{
+		q->upd += ((sim_now - q->upd) / period) * period;
+		q->cap = qei_vel(q);
+		q->vbase = sim_motor.travel;
+		q->stat |= 0x02;
+		if (q->cap < SIM_DOOR(&q->m, QEI_OFS(VELCOMP)))
+		{
+			q->stat |= 0x04;
+		}
+	}
+}
+
+static void qei_sched(SIM_QEI_T *q)
+{
+	uint64_t period = qei_period(q);
+
+	q->m.next = (period != 0) ? q->upd + period : SIM_NEVER;
+	sim_irq(QEI_IRQn, (q->stat & q->ie) != 0);
+}
+
+static uint32_t qei_read(SIM_MODEL_T *m, uint32_t off, Bool peek)
+{
+	SIM_QEI_T *q = (SIM_QEI_T *)m;
+	uint32_t max = SIM_DOOR(m, QEI_OFS(QEIMAXPOS));
+	uint32_t cpr = 4 * sim_motor.p.Ppr;
+	int64_t v;
+	(void)peek;
+
+	qei_update(q);
+	qei_sched(q);
+	switch (off)
+	{
+	case QEI_OFS(QEISTAT):
+		return (q->dir < 0) ? 1 : 0;
+	case QEI_OFS(QEIPOS):
+		v = qei_counts(q) - q->base;
+		if (max != 0xFFFFFFFF)
+		{
+			v %= (int64_t)max + 1;
+			if (v < 0)
+			{
+				v += (int64_t)max + 1;
+			}
+		}
+		return (uint32_t)v;
+	case QEI_OFS(INXCNT):
+		return (cpr == 0) ? 0 : (uint32_t)(sim_motor.edges / cpr - q->ibase);
+	case QEI_OFS(QEITIME):
+		return (uint32_t)((sim_now - q->upd) / sim_pclk_div(1, 0));
+	case QEI_OFS(QEIVEL):
+		return qei_vel(q);
+	case QEI_OFS(QEICAP):
+		return q->cap;
+	case QEI_OFS(QEIINTSTAT):
+		return q->stat;
+	case QEI_OFS(QEIIE):
+		return q->ie;
+	default:
+		return SIM_DOOR(m, off);
+	}
+}
+
+static void qei_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	SIM_QEI_T *q = (SIM_QEI_T *)m;
+	uint32_t cpr = 4 * sim_motor.p.Ppr;
+
+	qei_update(q);
+	switch (off)
+	{
+	case QEI_OFS(QEICON):
+		if (val & 0x01)
+		{
+			q->base = qei_counts(q);
+		}
+		if (val & 0x04)
+		{
+			q->upd = sim_now;
+			q->vbase = sim_motor.travel;
+		}
+		if ((val & 0x08) && (cpr != 0))
+		{
+			q->ibase = sim_motor.edges / cpr;
+		}
+		break;
+	case QEI_OFS(QEILOAD):
+		q->upd = sim_now;
+		break;
+	case QEI_OFS(QEIIES):
+		q->ie |= val;
+		break;
+	case QEI_OFS(QEIIEC):
+		q->ie &= ~val;
+		break;
+	case QEI_OFS(QEISET):
+		q->stat |= val;
+		break;
+	case QEI_OFS(QEICLR):
+		q->stat &= ~val;
+		break;
+	default:
+		break;
+	}
+	qei_sched(q);
+}
+
+static void qei_tick(SIM_MODEL_T *m)
+{
+	SIM_QEI_T *q = (SIM_QEI_T *)m;
+
+	qei_update(q);
+	qei_sched(q);
+}
+
+/* ADC model ------------------------------------------------------------------ */
+/* Software start and burst conversions, the edge started modes are not
+ * modelled. Results come from the source set by HOSTSIM_ADCSetSource(). */
+#define ADC_OFS(reg)		SIM_OFS(LPC_ADC_TypeDef, reg)
+#define ADC_DONE			(1UL << 31)
+#define ADC_OVERRUN			(1UL << 30)
+
+typedef struct {
+	SIM_MODEL_T m;
+	Bool busy;
+	uint8_t ch;					/* Channel converting or last converted */
+	uint64_t done;
+	uint32_t gdr, dr[8];
+	HOSTSIM_ADC_SRC_Type src;
+} SIM_ADC_T;
+
+static SIM_ADC_T sim_adc;
+
+/*********************************************************************//**
+ * @brief		CCLK cycles of one conversion, 65 ADC clocks
+ * @param[in]	a		ADC model
+ * @return		Cycles per conversion
+ **********************************************************************/
+static uint64_t adc_conv(SIM_ADC_T *a)
+{
+	return 65ULL * (((SIM_DOOR(&a->m, ADC_OFS(ADCR)) >> 8) & 0xFF) + 1) * sim_pclk_div(0, 24);
+}
+
+static void adc_sched(SIM_ADC_T *a)
+{
+	uint32_t inten = SIM_DOOR(&a->m, ADC_OFS(ADINTEN));
+	Bool irq;
+	uint32_t i;
+
+	a->m.next = a->busy ? a->done : SIM_NEVER;
+	irq = ((inten & 0x100) && (a->gdr & ADC_DONE)) ? TRUE : FALSE;
+	for (i = 0; i < 8; i++)
+	{
+		if ((inten & (1UL << i)) && (a->dr[i] & ADC_DONE))
+		{
+			irq = TRUE;
+		}
+	}
+	sim_irq(ADC_IRQn, irq);
+	sim_dma_poke();
+}
+
+/* Start a conversion on the next selected channel after the last one */
+static void adc_start(SIM_ADC_T *a, uint64_t at)
+{
+	uint32_t sel = SIM_DOOR(&a->m, ADC_OFS(ADCR)) & 0xFF;
+	uint32_t i;
+
+	if (!sel || !(SIM_DOOR(&a->m, ADC_OFS(ADCR)) & (1UL << 21)))
+	{
+		return;
+	}
+	for (i = 1; i <= 8; i++)
+	{
+		if (sel & (1UL << ((a->ch + i) & 7)))
+		{
+			break;
+		}
+	}
+	a->ch = (uint8_t)((a->ch + i) & 7);
+	a->busy = TRUE;
+	a->done = at + adc_conv(a);
+}
+
+/* DMA request: global result done on a channel with its interrupt enabled */
+static Bool adc_dma_request(void)
+{
+	SIM_ADC_T *a = &sim_adc;
+
+	return ((a->gdr & ADC_DONE) && (SIM_DOOR(&a->m, ADC_OFS(ADINTEN)) & (1UL << ((a->gdr >> 24) & 7))))
+		? TRUE : FALSE;
+}
+
+static uint32_t adc_read(SIM_MODEL_T *m, uint32_t off, Bool peek)
+{
+	SIM_ADC_T *a = (SIM_ADC_T *)m;
+	uint32_t v, i;
+
+	switch (off)
+	{
+	case ADC_OFS(ADGDR):
+		v = a->gdr;
+		if (!peek)
+		{
+			a->gdr &= ~(ADC_DONE | ADC_OVERRUN);
+			adc_sched(a);
+		}
+		return v;
+	case ADC_OFS(ADDR0): case ADC_OFS(ADDR1): case ADC_OFS(ADDR2): case ADC_OFS(ADDR3):
+	case ADC_OFS(ADDR4): case ADC_OFS(ADDR5): case ADC_OFS(ADDR6): case ADC_OFS(ADDR7):
+		i = (off - ADC_OFS(ADDR0)) / 4;
+		v = a->dr[i];
+		if (!peek)
+		{
+			a->dr[i] &= ~(ADC_DONE | ADC_OVERRUN);
+			adc_sched(a);
+		}
+		return v;
+	case ADC_OFS(ADSTAT):
+		for (v = 0, i = 0; i < 8; i++)
+		{
+			v |= (a->dr[i] & ADC_DONE) ? (1UL << i) : 0;
+			v |= (a->dr[i] & ADC_OVERRUN) ? (1UL << (i + 8)) : 0;
+		}
+		return v;
+	default:
+		return SIM_DOOR(m, off);
+	}
+}
+
+static void adc_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	SIM_ADC_T *a = (SIM_ADC_T *)m;
+
+	if (off == ADC_OFS(ADCR))
+	{
+		a->gdr &= ~ADC_DONE;
+		if (!a->busy && ((val & (1UL << 16)) || (((val >> 24) & 7) == 1)))
+		{
+			adc_start(a, sim_now);
+		}
+	}
+	adc_sched(a);
+}
+
+static void adc_tick(SIM_MODEL_T *m)
+{
+	SIM_ADC_T *a = (SIM_ADC_T *)m;
+	uint32_t v;
+
+	if (a->busy && (sim_now >= a->done))
+	{
+		a->busy = FALSE;
+		v = (a->src ? (a->src(a->ch, a->done) & 0xFFF) : 0) << 4;
+		a->dr[a->ch] = v | ADC_DONE | ((a->dr[a->ch] & ADC_DONE) ? ADC_OVERRUN : 0);
+		a->gdr = v | ((uint32_t)a->ch << 24) | ADC_DONE | ((a->gdr & ADC_DONE) ? ADC_OVERRUN : 0);
+		if (SIM_DOOR(m, ADC_OFS(ADCR)) & (1UL << 16))
+		{
+			adc_start(a, a->done);
+		}
+	}
+	adc_sched(a);
+}
+
+/* DAC model ------------------------------------------------------------------ */
+/* DACR, double buffering and the timeout counter with its DMA request.
+ * Every change of AOUT is reported to the sink set by HOSTSIM_DACSetSink(). */
+#define DAC_OFS(reg)		SIM_OFS(LPC_DAC_TypeDef, reg)
+#define DAC_INT_DMA_REQ		(1UL << 0)
+#define DAC_DBLBUF			(1UL << 1)
+#define DAC_CNT				(1UL << 2)
+#define DAC_DMA				(1UL << 3)
+
+typedef struct {
+	SIM_MODEL_T m;
+	uint32_t out;				/* DACR value on AOUT */
+	uint32_t pre;				/* Double buffer waiting for the timeout */
+	uint32_t req;				/* DAC_INT_DMA_REQ */
+	HOSTSIM_DAC_SINK_Type sink;
+} SIM_DAC_T;
+
+static SIM_DAC_T sim_dac;
+
+static void dac_out(SIM_DAC_T *d, uint32_t val, uint64_t at)
+{
+	d->out = val;
+	if (d->sink)
+	{
+		d->sink((uint16_t)((val >> 6) & 0x3FF), at);
+	}
+}
+
+/* The counter runs DACCNTVAL peripheral clocks per timeout */
+static void dac_sched(SIM_DAC_T *d, uint64_t from)
+{
+	uint32_t cnt = SIM_DOOR(&d->m, DAC_OFS(DACCNTVAL)) & 0xFFFF;
+
+	if (SIM_DOOR(&d->m, DAC_OFS(DACCTRL)) & DAC_CNT)
+	{
+		d->m.next = from + (uint64_t)(cnt ? cnt : 1) * sim_pclk_div(0, 22);
+	}
+	else
+	{
+		d->m.next = SIM_NEVER;
+	}
+}
+
+/* DMA request: timeout flagged with DMA access enabled */
+static Bool dac_dma_request(void)
+{
+	return (sim_dac.req && (SIM_DOOR(&sim_dac.m, DAC_OFS(DACCTRL)) & DAC_DMA)) ? TRUE : FALSE;
+}
+
+static uint32_t dac_read(SIM_MODEL_T *m, uint32_t off, Bool peek)
+{
+	SIM_DAC_T *d = (SIM_DAC_T *)m;
+	(void)peek;
+
+	if (off == DAC_OFS(DACCTRL))
+	{
+		return (SIM_DOOR(m, off) & 0x0E) | d->req;
+	}
+	return SIM_DOOR(m, off);
+}
+
+static void dac_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	SIM_DAC_T *d = (SIM_DAC_T *)m;
+	uint32_t ctrl = SIM_DOOR(m, DAC_OFS(DACCTRL));
+
+	if (off == DAC_OFS(DACR))
+	{
+		d->req = 0;
+		if ((ctrl & (DAC_DBLBUF | DAC_CNT)) == (DAC_DBLBUF | DAC_CNT))
+		{
+			d->pre = val;
+		}
+		else
+		{
+			dac_out(d, val, sim_now);
+		}
+	}
+	else if (off == DAC_OFS(DACCTRL))
+	{
+		// The double buffer starts out with the value on AOUT
+		d->pre = d->out;
+		if (!(val & DAC_CNT))
+		{
+			m->next = SIM_NEVER;
+		}
+		else if (m->next == SIM_NEVER)
+		{
+			dac_sched(d, sim_now);
+		}
+	}
+	sim_dma_poke();
+}
+
+static void dac_tick(SIM_MODEL_T *m)
+{
+	SIM_DAC_T *d = (SIM_DAC_T *)m;
+	uint64_t at = m->next;
+
+	if (SIM_DOOR(m, DAC_OFS(DACCTRL)) & DAC_DBLBUF)
+	{
+		SIM_DOOR(m, DAC_OFS(DACR)) = d->pre;
+		dac_out(d, d->pre, at);
+	}
+	d->req = DAC_INT_DMA_REQ;
+	dac_sched(d, at);
+	sim_dma_poke();
+}
+
+/* EMAC model ----------------------------------------------------------------- */
+#define EMAC_OFS(reg)	SIM_OFS(LPC_EMAC_TypeDef, reg)
+#define EMAC_INT_RX_OVERRUN		(1UL << 0)
+#define EMAC_INT_RX_FINISHED	(1UL << 2)
+#define EMAC_INT_RX_DONE		(1UL << 3)
+#define EMAC_INT_TX_FINISHED	(1UL << 6)
+#define EMAC_INT_TX_DONE		(1UL << 7)
+#define EMAC_FRAME_MAX			2048
+
+typedef struct {
+	SIM_MODEL_T m;
+	uint16_t phy[32];
+	Bool tx_busy;
+	uint32_t tx_nd, tx_len;
+	Bool tx_int;
+	uint64_t tx_done, rx_next;
+	uint8_t tx_buf[EMAC_FRAME_MAX];
+	uint8_t rxq[HOSTSIM_EMAC_RXQ_SIZE][EMAC_FRAME_MAX];
+	uint32_t rxq_len[HOSTSIM_EMAC_RXQ_SIZE];
+	uint32_t rxq_rd, rxq_cnt;
+	HOSTSIM_EMAC_SINK_Type sink;
+	Bool cap_open;
+	int cap_fd;
+} SIM_EMAC_T;
+
+static SIM_EMAC_T sim_emac;
+
+static uint32_t emac_crc32(const uint8_t *data, uint32_t len)
+{
+	uint32_t crc = 0xFFFFFFFF;
+	uint32_t i;
+
+	while (len--)
+	{
+		crc ^= *data++;
+		for (i = 0; i < 8; i++)
+		{
+			crc = (crc >> 1) ^ ((crc & 1) ? 0xEDB88320 : 0);
+		}
+	}
+	return ~crc;
+}
+
+/*********************************************************************//**
+ * @brief		CCLK cycles to put a frame on the wire incl. preamble/IFG
+ * @param[in]	len		Frame length without FCS
+ * @return		Cycles
+ **********************************************************************/
+static uint64_t emac_wire(uint32_t len)
+{
+	uint64_t bits = (uint64_t)((len < 60 ? 60 : len) + 4 + 8 + 12) * 8;
+	uint64_t rate = (SIM_DOOR(&sim_emac.m, EMAC_OFS(SUPP)) & 0x100) ? 100000000 : 10000000;
+
+	return bits * sc_cclk(&sim_sc) / rate;
+}
+
+static void emac_sched(SIM_EMAC_T *e)
+{
+	uint64_t t = e->tx_busy ? e->tx_done : SIM_NEVER;
+	uint32_t st = SIM_DOOR(&e->m, EMAC_OFS(IntStatus));
+
+	if (e->rxq_cnt && (e->rx_next < t))
+	{
+		t = e->rx_next;
+	}
+	e->m.next = t;
+	sim_irq(ENET_IRQn, (st & SIM_DOOR(&e->m, EMAC_OFS(IntEnable))) != 0);
+}
+
+static void emac_tx_kick(SIM_EMAC_T *e)
+{
+	uint32_t n, c, p, ctrl, sz, *d;
+
+	if (e->tx_busy || !(SIM_DOOR(&e->m, EMAC_OFS(Command)) & 0x02))
+	{
+		return;
+	}
+	n = SIM_DOOR(&e->m, EMAC_OFS(TxDescriptorNumber)) + 1;
+	c = SIM_DOOR(&e->m, EMAC_OFS(TxConsumeIndex));
+	p = SIM_DOOR(&e->m, EMAC_OFS(TxProduceIndex));
+	e->tx_nd = 0;
+	e->tx_len = 0;
+	e->tx_int = FALSE;
+	while (c != p)
+	{
+		d = (uint32_t *)(uintptr_t)(SIM_DOOR(&e->m, EMAC_OFS(TxDescriptor)) + c * 8);
+		ctrl = d[1];
+		sz = (ctrl & 0x7FF) + 1;
+		if (e->tx_len + sz <= EMAC_FRAME_MAX)
+		{
+			memcpy(&e->tx_buf[e->tx_len], sim_host_ptr(d[0]), sz);
+			e->tx_len += sz;
+		}
+		e->tx_int |= (ctrl & (1UL << 31)) ? TRUE : FALSE;
+		e->tx_nd++;
+		c = (c + 1) % n;
+		if (ctrl & (1UL << 30))
+		{
+			e->tx_busy = TRUE;
+			e->tx_done = sim_now + emac_wire(e->tx_len);
+			return;
+		}
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Append the frame just sent to the capture file, stamped
+ * 				with the virtual time
+ * @param[in]	e		EMAC model
+ * @return		None
+ **********************************************************************/
+static void emac_pcap_write(SIM_EMAC_T *e)
+{
+	uint64_t cclk = sc_cclk(&sim_sc);
+	uint32_t rec[4];
+
+	rec[0] = (uint32_t)(sim_now / cclk);
+	rec[1] = (uint32_t)((sim_now % cclk) * 1000000 / cclk);
+	rec[2] = e->tx_len;
+	rec[3] = e->tx_len;
+	if ((write(e->cap_fd, rec, sizeof(rec)) != sizeof(rec)) ||
+		(write(e->cap_fd, e->tx_buf, e->tx_len) != (ssize_t)e->tx_len))
+	{
+		close(e->cap_fd);
+		e->cap_open = FALSE;
+	}
+}
+
+static void emac_rx_deliver(SIM_EMAC_T *e)
+{
+	uint32_t n, c, p, i, free, need, left, sz, chunk, info, filt, sa;
+	uint32_t *d, *st;
+	uint8_t *f = e->rxq[e->rxq_rd];
+	uint32_t len = e->rxq_len[e->rxq_rd];
+	uint32_t crc;
+	Bool intr = FALSE, accept;
+
+	e->rxq_rd = (e->rxq_rd + 1) % HOSTSIM_EMAC_RXQ_SIZE;
+	e->rxq_cnt--;
+	e->rx_next = sim_now + emac_wire(len);
+
+	if (!(SIM_DOOR(&e->m, EMAC_OFS(Command)) & 0x01))
+	{
+		return;
+	}
+
+	/* Receive filter */
+	filt = SIM_DOOR(&e->m, EMAC_OFS(RxFilterCtrl));
+	if ((f[0] & f[1] & f[2] & f[3] & f[4] & f[5]) == 0xFF)
+	{
+		accept = (filt & 0x02) ? TRUE : FALSE;
+	}
+	else if (f[0] & 0x01)
+	{
+		accept = (filt & 0x14) ? TRUE : FALSE;
+	}
+	else
+	{
+		sa = SIM_DOOR(&e->m, EMAC_OFS(SA2));
+		accept = (filt & 0x09) ? TRUE : FALSE;
+		if ((f[0] == (sa & 0xFF)) && (f[1] == (sa >> 8)))
+		{
+			sa = SIM_DOOR(&e->m, EMAC_OFS(SA1));
+			if ((f[2] == (sa & 0xFF)) && (f[3] == (sa >> 8)))
+			{
+				sa = SIM_DOOR(&e->m, EMAC_OFS(SA0));
+				if ((f[4] == (sa & 0xFF)) && (f[5] == (sa >> 8)) && (filt & 0x20))
+				{
+					accept = TRUE;
+				}
+			}
+		}
+	}
+	if (!accept)
+	{
+		return;
+	}
+
+	/* Append FCS, the EMAC stores it with the frame */
+	crc = emac_crc32(f, len);
+	f[len++] = (uint8_t)crc;
+	f[len++] = (uint8_t)(crc >> 8);
+	f[len++] = (uint8_t)(crc >> 16);
+	f[len++] = (uint8_t)(crc >> 24);
+
+	n = SIM_DOOR(&e->m, EMAC_OFS(RxDescriptorNumber)) + 1;
+	c = SIM_DOOR(&e->m, EMAC_OFS(RxConsumeIndex)) % n;
+	p = SIM_DOOR(&e->m, EMAC_OFS(RxProduceIndex)) % n;
+	free = (c + n - p - 1) % n;
+
+	/* Count fragments needed */
+	need = 0;
+	left = len;
+	for (i = p; left && (need < free); i = (i + 1) % n)
+	{
+		d = (uint32_t *)(uintptr_t)(SIM_DOOR(&e->m, EMAC_OFS(RxDescriptor)) + i * 8);
+		sz = (d[1] & 0x7FF) + 1;
+		left = (left > sz) ? left - sz : 0;
+		need++;
+	}
+	if (left)
+	{
+		SIM_DOOR(&e->m, EMAC_OFS(IntStatus)) |= EMAC_INT_RX_OVERRUN;
+		sim_stats.FramesDropped++;
+		return;
+	}
+
+	left = len;
+	for (i = 0; i < need; i++)
+	{
+		d = (uint32_t *)(uintptr_t)(SIM_DOOR(&e->m, EMAC_OFS(RxDescriptor)) + p * 8);
+		st = (uint32_t *)(uintptr_t)(SIM_DOOR(&e->m, EMAC_OFS(RxStatus)) + p * 8);
+		sz = (d[1] & 0x7FF) + 1;
+		chunk = (left > sz) ? sz : left;
+		memcpy(sim_host_ptr(d[0]), &f[len - left], chunk);
+		left -= chunk;
+		info = (chunk - 1) & 0x7FF;
+		if (left == 0)
+		{
+			info |= (1UL << 30);
+		}
+		st[0] = info;
+		st[1] = 0;
+		intr |= (d[1] & (1UL << 31)) ? TRUE : FALSE;
+		p = (p + 1) % n;
+	}
+	SIM_DOOR(&e->m, EMAC_OFS(RxProduceIndex)) = p;
+	if (intr)
+	{
+		SIM_DOOR(&e->m, EMAC_OFS(IntStatus)) |= EMAC_INT_RX_DONE;
+	}
+	if ((p + 1) % n == c)
+	{
+		SIM_DOOR(&e->m, EMAC_OFS(IntStatus)) |= EMAC_INT_RX_FINISHED;
+	}
+}
+
+static uint32_t emac_read(SIM_MODEL_T *m, uint32_t off, Bool peek)
+{
+	(void)peek;
+
+	switch (off)
+	{
+	case EMAC_OFS(Status):
+		return SIM_DOOR(m, EMAC_OFS(Command)) & 0x03;
+	case EMAC_OFS(MIND):
+	case EMAC_OFS(MWTD):
+	case EMAC_OFS(IntClear):
+	case EMAC_OFS(IntSet):
+		return 0;
+	default:
+		return SIM_DOOR(m, off);
+	}
+}
+
+static void emac_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	SIM_EMAC_T *e = (SIM_EMAC_T *)m;
+	uint32_t reg = SIM_DOOR(m, EMAC_OFS(MADR)) & 0x1F;
+
+	switch (off)
+	{
+	case EMAC_OFS(Command):
+		if (val & 0x08)
+		{
+			SIM_DOOR(m, EMAC_OFS(IntStatus)) = 0;
+		}
+		if (val & 0x10)
+		{
+			SIM_DOOR(m, EMAC_OFS(TxProduceIndex)) = 0;
+			SIM_DOOR(m, EMAC_OFS(TxConsumeIndex)) = 0;
+			e->tx_busy = FALSE;
+		}
+		if (val & 0x20)
+		{
+			SIM_DOOR(m, EMAC_OFS(RxProduceIndex)) = 0;
+			SIM_DOOR(m, EMAC_OFS(RxConsumeIndex)) = 0;
+		}
+		SIM_DOOR(m, off) = val & ~0x38;
+		emac_tx_kick(e);
+		break;
+	case EMAC_OFS(TxProduceIndex):
+		emac_tx_kick(e);
+		break;
+	case EMAC_OFS(MCMD):
+		if (val & 0x01)
+		{
+			SIM_DOOR(m, EMAC_OFS(MRDD)) = e->phy[reg];
+		}
+		break;
+	case EMAC_OFS(MWTD):
+		if (reg == 0)
+		{
+			e->phy[0] = (val & 0x8000) ? 0x3100 : (val & ~0x0200);
+		}
+		else if (reg > 3)
+		{
+			e->phy[reg] = (uint16_t)val;
+		}
+		break;
+	case EMAC_OFS(IntClear):
+		SIM_DOOR(m, EMAC_OFS(IntStatus)) &= ~val;
+		break;
+	case EMAC_OFS(IntSet):
+		SIM_DOOR(m, EMAC_OFS(IntStatus)) |= val;
+		break;
+	default:
+		break;
+	}
+	emac_sched(e);
+}
+
+static void emac_tick(SIM_MODEL_T *m)
+{
+	SIM_EMAC_T *e = (SIM_EMAC_T *)m;
+	uint32_t n, c, i, *st;
+
+	if (e->tx_busy && (sim_now >= e->tx_done))
+	{
+		n = SIM_DOOR(m, EMAC_OFS(TxDescriptorNumber)) + 1;
+		c = SIM_DOOR(m, EMAC_OFS(TxConsumeIndex));
+		for (i = 0; i < e->tx_nd; i++)
+		{
+			st = (uint32_t *)(uintptr_t)(SIM_DOOR(m, EMAC_OFS(TxStatus)) + c * 4);
+			*st = 0;
+			c = (c + 1) % n;
+		}
+		SIM_DOOR(m, EMAC_OFS(TxConsumeIndex)) = c;
+		e->tx_busy = FALSE;
+		if (e->tx_int)
+		{
+			SIM_DOOR(m, EMAC_OFS(IntStatus)) |= EMAC_INT_TX_DONE;
+		}
+		if (c == SIM_DOOR(m, EMAC_OFS(TxProduceIndex)))
+		{
+			SIM_DOOR(m, EMAC_OFS(IntStatus)) |= EMAC_INT_TX_FINISHED;
+		}
+		if (e->sink)
+		{
+			e->sink(e->tx_buf, e->tx_len);
+		}
+		if (e->cap_open)
+		{
+			emac_pcap_write(e);
+		}
+		emac_tx_kick(e);
+	}
+	if (e->rxq_cnt && (sim_now >= e->rx_next))
+	{
+		emac_rx_deliver(e);
+	}
+	emac_sched(e);
+}
+
+/* CAN model ------------------------------------------------------------------ */
+#define CAN_MOD		0x00
+#define CAN_CMR		0x04
+#define CAN_GSR		0x08
+#define CAN_ICR		0x0C
+#define CAN_IER		0x10
+#define CAN_BTR		0x14
+#define CAN_SR		0x1C
+#define CAN_RFS		0x20
+#define CAN_TFI(b)	(0x30 + (b) * 0x10)
+
+#define AF_OFS(reg)	SIM_OFS(LPC_CANAF_TypeDef, reg)
+
+typedef struct {
+	SIM_MODEL_T m;
+	uint8_t unit, bit;
+	uint32_t icr;
+	uint8_t tx_pend, tx_srr, tx_tcs;
+	int8_t tx_cur;
+	uint64_t tx_done, rx_next;
+	HOSTSIM_CAN_FRAME_Type rxb[2];
+	uint32_t rxb_idx[2];
+	uint8_t rxb_cnt;
+	Bool dos;
+	HOSTSIM_CAN_FRAME_Type inq[HOSTSIM_CAN_RXQ_SIZE];
+	uint32_t in_rd, in_cnt;
+} SIM_CAN_T;
+
+static SIM_CAN_T sim_can[2];
+static HOSTSIM_CAN_SINK_Type sim_can_sink;
+static Bool sim_can_joined;
+
+static SIM_MODEL_T sim_canaf;
+static SIM_MODEL_T sim_canaf_ram;
+
+static void can_update_irq(void)
+{
+	uint32_t fc = SIM_DOOR(&sim_canaf, AF_OFS(FCANIC0)) | SIM_DOOR(&sim_canaf, AF_OFS(FCANIC1));
+
+	sim_irq(CAN_IRQn, (sim_can[0].icr | sim_can[1].icr | fc) != 0);
+}
+
+static uint64_t can_frame(SIM_CAN_T *c, const HOSTSIM_CAN_FRAME_Type *f)
+{
+	uint32_t btr = SIM_DOOR(&c->m, CAN_BTR);
+	uint64_t bit = (uint64_t)((btr & 0x3FF) + 1) * (((btr >> 16) & 0x0F) + ((btr >> 20) & 0x07) + 3);
+	uint32_t bits = (f->Ext ? 67 : 47) + (f->RTR ? 0 : 8 * ((f->DLC > 8) ? 8 : f->DLC)) + 3;
+
+	return bits * bit * sim_pclk_div(0, c->bit);
+}
+
+static void can_sched(SIM_CAN_T *c)
+{
+	uint64_t t = (c->tx_cur >= 0) ? c->tx_done : SIM_NEVER;
+
+	if (c->in_cnt && (c->rx_next < t))
+	{
+		t = c->rx_next;
+	}
+	c->m.next = t;
+	can_update_irq();
+}
+
+/*********************************************************************//**
+ * @brief		Mirror the head of the receive buffer into RFS/RID/RDA/RDB
+ * @param[in]	c		CAN model
+ * @return		None
+ **********************************************************************/
+static void can_mirror(SIM_CAN_T *c)
+{
+	HOSTSIM_CAN_FRAME_Type *f = &c->rxb[0];
+	uint32_t a = 0, b = 0, i;
+
+	for (i = 0; i < 4; i++)
+	{
+		a |= (uint32_t)f->Data[i] << (8 * i);
+		b |= (uint32_t)f->Data[i + 4] << (8 * i);
+	}
+	SIM_DOOR(&c->m, CAN_RFS) = c->rxb_idx[0] | ((uint32_t)(f->DLC & 0x0F) << 16)
+							 | ((uint32_t)f->RTR << 30) | ((uint32_t)f->Ext << 31);
+	SIM_DOOR(&c->m, CAN_RFS + 4) = f->ID;
+	SIM_DOOR(&c->m, CAN_RFS + 8) = a;
+	SIM_DOOR(&c->m, CAN_RFS + 12) = b;
+	if (SIM_DOOR(&c->m, CAN_IER) & 0x01)
+	{
+		c->icr |= 0x01;
+	}
+}
+
+static uint16_t af_half(uint32_t idx)
+{
+	uint32_t w = SIM_DOOR(&sim_canaf_ram, (idx >> 1) * 4);
+
+	return (idx & 1) ? (uint16_t)w : (uint16_t)(w >> 16);
+}
+
+/*********************************************************************//**
+ * @brief		Run a frame through the acceptance filter look-up table
+ * @param[in]	ctrl	Receiving controller (0 = CAN1)
+ * @param[in]	f		Frame
+ * @param[out]	idx		ID index for RFS
+ * @return		0 rejected, 1 accepted, 2 stored in a FullCAN object
+ **********************************************************************/
+static int af_filter(uint8_t ctrl, const HOSTSIM_CAN_FRAME_Type *f, uint32_t *idx)
+{
+	SIM_MODEL_T *af = &sim_canaf;
+	uint32_t afmr = SIM_DOOR(af, AF_OFS(AFMR));
+	uint32_t sff = SIM_DOOR(af, AF_OFS(SFF_sa)) & 0x7FC;
+	uint32_t sgrp = SIM_DOOR(af, AF_OFS(SFF_GRP_sa)) & 0x7FC;
+	uint32_t eff = SIM_DOOR(af, AF_OFS(EFF_sa)) & 0x7FC;
+	uint32_t egrp = SIM_DOOR(af, AF_OFS(EFF_GRP_sa)) & 0x7FC;
+	uint32_t end = SIM_DOOR(af, AF_OFS(ENDofTable)) & 0xFFC;
+	uint32_t i, n = 0, lo, hi, obj, a, b, j;
+	uint16_t e;
+
+	*idx = 0;
+	if (afmr & 0x02)
+	{
+		*idx = 1UL << 10;
+		return 1;
+	}
+	if (afmr & 0x01)
+	{
+		return 0;
+	}
+	if (!f->Ext)
+	{
+		if (afmr & 0x04)
+		{
+			for (i = 0; i < sff / 2; i++)
+			{
+				e = af_half(i);
+				if (((e >> 13) == ctrl) && !(e & 0x1000) && ((e & 0x7FF) == f->ID))
+				{
+					/* FullCAN message object: SEM 01 while updating, 11 when done */
+					obj = end + i * 12;
+					a = b = 0;
+					for (j = 0; j < 4; j++)
+					{
+						a |= (uint32_t)f->Data[j] << (8 * j);
+						b |= (uint32_t)f->Data[j + 4] << (8 * j);
+					}
+					SIM_DOOR(&sim_canaf_ram, obj) = (f->ID & 0x7FF) | ((uint32_t)(f->DLC & 0x0F) << 16)
+												  | (1UL << 24) | ((uint32_t)f->RTR << 30);
+					SIM_DOOR(&sim_canaf_ram, obj + 4) = a;
+					SIM_DOOR(&sim_canaf_ram, obj + 8) = b;
+					SIM_DOOR(&sim_canaf_ram, obj) |= (3UL << 24);
+					if ((SIM_DOOR(af, AF_OFS(FCANIE)) & 0x01) && (i < 64))
+					{
+						SIM_DOOR(af, (i < 32) ? AF_OFS(FCANIC0) : AF_OFS(FCANIC1)) |= 1UL << (i & 0x1F);
+					}
+					return 2;
+				}
+			}
+		}
+		for (i = sff / 2; i < sgrp / 2; i++, n++)
+		{
+			e = af_half(i);
+			if (((e >> 13) == ctrl) && !(e & 0x1000) && ((e & 0x7FF) == f->ID))
+			{
+				*idx = n;
+				return 1;
+			}
+		}
+		for (i = sgrp / 4; i < eff / 4; i++, n++)
+		{
+			lo = af_half(i * 2);
+			hi = af_half(i * 2 + 1);
+			if (((lo >> 13) == ctrl) && !(lo & 0x1000) && !(hi & 0x1000)
+				&& (f->ID >= (lo & 0x7FF)) && (f->ID <= (hi & 0x7FF)))
+			{
+				*idx = n;
+				return 1;
+			}
+		}
+		return 0;
+	}
+	n = (sgrp - sff) / 2 + (eff - sgrp) / 4;
+	for (i = eff; i < egrp; i += 4, n++)
+	{
+		lo = SIM_DOOR(&sim_canaf_ram, i);
+		if (((lo >> 29) == ctrl) && ((lo & 0x1FFFFFFF) == f->ID))
+		{
+			*idx = n;
+			return 1;
+		}
+	}
+	for (i = egrp; i + 4 < end + 4 && i + 8 <= end; i += 8, n++)
+	{
+		lo = SIM_DOOR(&sim_canaf_ram, i);
+		hi = SIM_DOOR(&sim_canaf_ram, i + 4);
+		if (((lo >> 29) == ctrl) && (f->ID >= (lo & 0x1FFFFFFF)) && (f->ID <= (hi & 0x1FFFFFFF)))
+		{
+			*idx = n;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static void can_receive(SIM_CAN_T *c, const HOSTSIM_CAN_FRAME_Type *f)
+{
+	uint32_t idx;
+
+	if (SIM_DOOR(&c->m, CAN_MOD) & 0x01)
+	{
+		return;
+	}
+	switch (af_filter(c->unit, f, &idx))
+	{
+	case 1:
+		if (c->rxb_cnt < 2)
+		{
+			c->rxb[c->rxb_cnt] = *f;
+			c->rxb_idx[c->rxb_cnt] = idx;
+			if (c->rxb_cnt++ == 0)
+			{
+				can_mirror(c);
+			}
+		}
+		else
+		{
+			c->dos = TRUE;
+			sim_stats.FramesDropped++;
+			if (SIM_DOOR(&c->m, CAN_IER) & 0x08)
+			{
+				c->icr |= 0x08;
+			}
+		}
+		break;
+	default:
+		break;
+	}
+	can_update_irq();
+}
+
+static void can_kick(SIM_CAN_T *c)
+{
+	uint32_t b, best = 0, id, best_id = 0xFFFFFFFF, key;
+	HOSTSIM_CAN_FRAME_Type f;
+
+	if ((c->tx_cur >= 0) || !c->tx_pend || (SIM_DOOR(&c->m, CAN_MOD) & 0x01))
+	{
+		return;
+	}
+	for (b = 0; b < 3; b++)
+	{
+		if (c->tx_pend & (1 << b))
+		{
+			id = SIM_DOOR(&c->m, CAN_TFI(b) + 4);
+			key = (SIM_DOOR(&c->m, CAN_MOD) & 0x08) ? (SIM_DOOR(&c->m, CAN_TFI(b)) & 0xFF) : id;
+			if (key < best_id)
+			{
+				best_id = key;
+				best = b;
+			}
+		}
+	}
+	c->tx_pend &= ~(1 << best);
+	c->tx_cur = (int8_t)best;
+	f.Ext = (SIM_DOOR(&c->m, CAN_TFI(best)) >> 31) & 1;
+	f.RTR = (SIM_DOOR(&c->m, CAN_TFI(best)) >> 30) & 1;
+	f.DLC = (SIM_DOOR(&c->m, CAN_TFI(best)) >> 16) & 0x0F;
+	c->tx_done = sim_now + can_frame(c, &f);
+}
+
+static uint32_t can_sr(SIM_CAN_T *c)
+{
+	uint32_t v = 0, b, s;
+
+	for (b = 0; b < 3; b++)
+	{
+		s = (c->rxb_cnt ? 0x01 : 0) | (c->dos ? 0x02 : 0);
+		if (!(c->tx_pend & (1 << b)) && (c->tx_cur != (int8_t)b))
+		{
+			s |= 0x04;
+		}
+		if (c->tx_tcs & (1 << b))
+		{
+			s |= 0x08;
+		}
+		if (c->tx_cur == (int8_t)b)
+		{
+			s |= 0x20;
+		}
+		v |= s << (8 * b);
+	}
+	return v;
+}
+
+static uint32_t can_read(SIM_MODEL_T *m, uint32_t off, Bool peek)
+{
+	SIM_CAN_T *c = (SIM_CAN_T *)m;
+	uint32_t v;
+
+	switch (off)
+	{
+	case CAN_CMR:
+		return 0;
+	case CAN_GSR:
+		v = can_sr(c);
+		return (v & 0x03) | (((v & (v >> 8) & (v >> 16)) & 0x0C)) | (((v | (v >> 8) | (v >> 16)) & 0x20));
+	case CAN_ICR:
+		v = c->icr;
+		if (!peek)
+		{
+			c->icr &= 0x01;
+			can_update_irq();
+		}
+		return v;
+	case CAN_SR:
+		return can_sr(c);
+	default:
+		return SIM_DOOR(m, off);
+	}
+}
+
+static void can_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	SIM_CAN_T *c = (SIM_CAN_T *)m;
+	uint8_t stb;
+
+	switch (off)
+	{
+	case CAN_MOD:
+		if (val & 0x01)
+		{
+			c->tx_pend = 0;
+			c->tx_cur = -1;
+			c->rxb_cnt = 0;
+			c->icr = 0;
+			c->dos = FALSE;
+		}
+		break;
+	case CAN_CMR:
+		if ((val & 0x04) && c->rxb_cnt)
+		{
+			c->icr &= ~0x01;
+			c->rxb[0] = c->rxb[1];
+			c->rxb_idx[0] = c->rxb_idx[1];
+			if (--c->rxb_cnt)
+			{
+				can_mirror(c);
+			}
+		}
+		if (val & 0x08)
+		{
+			c->dos = FALSE;
+		}
+		if (val & 0x02)
+		{
+			c->tx_pend = 0;
+		}
+		if (val & 0x11)
+		{
+			stb = (uint8_t)((val >> 5) & 0x07);
+			if (stb == 0)
+			{
+				stb = 0x01;
+			}
+			c->tx_pend |= stb;
+			c->tx_tcs &= ~stb;
+			if (val & 0x10)
+			{
+				c->tx_srr |= stb;
+			}
+			can_kick(c);
+		}
+		break;
+	case CAN_IER:
+		c->icr &= val | 0x01;
+		break;
+	default:
+		break;
+	}
+	can_sched(c);
+}
+
+static void can_tick(SIM_MODEL_T *m)
+{
+	static const uint32_t ti[3] = { 0x002, 0x200, 0x400 };
+	SIM_CAN_T *c = (SIM_CAN_T *)m;
+	HOSTSIM_CAN_FRAME_Type f;
+	uint32_t b, a, d, i;
+
+	if ((c->tx_cur >= 0) && (sim_now >= c->tx_done))
+	{
+		b = (uint32_t)c->tx_cur;
+		f.Ext = (SIM_DOOR(m, CAN_TFI(b)) >> 31) & 1;
+		f.RTR = (SIM_DOOR(m, CAN_TFI(b)) >> 30) & 1;
+		f.DLC = (SIM_DOOR(m, CAN_TFI(b)) >> 16) & 0x0F;
+		f.ID = SIM_DOOR(m, CAN_TFI(b) + 4) & (f.Ext ? 0x1FFFFFFF : 0x7FF);
+		a = SIM_DOOR(m, CAN_TFI(b) + 8);
+		d = SIM_DOOR(m, CAN_TFI(b) + 12);
+		for (i = 0; i < 4; i++)
+		{
+			f.Data[i] = (uint8_t)(a >> (8 * i));
+			f.Data[i + 4] = (uint8_t)(d >> (8 * i));
+		}
+		c->tx_cur = -1;
+		c->tx_tcs |= 1 << b;
+		if (SIM_DOOR(m, CAN_IER) & ti[b])
+		{
+			c->icr |= ti[b];
+		}
+		if (sim_can_sink)
+		{
+			sim_can_sink(c->unit, &f);
+		}
+		if (c->tx_srr & (1 << b))
+		{
+			c->tx_srr &= ~(1 << b);
+			can_receive(c, &f);
+		}
+		if (sim_can_joined)
+		{
+			can_receive(&sim_can[c->unit ^ 1], &f);
+		}
+		can_kick(c);
+	}
+	if (c->in_cnt && (sim_now >= c->rx_next))
+	{
+		f = c->inq[c->in_rd];
+		c->in_rd = (c->in_rd + 1) % HOSTSIM_CAN_RXQ_SIZE;
+		c->in_cnt--;
+		can_receive(c, &f);
+		if (c->in_cnt)
+		{
+			c->rx_next = sim_now + can_frame(c, &c->inq[c->in_rd]);
+		}
+	}
+	can_sched(c);
+}
+
+/* Acceptance filter RAM: clearing the SEM bits of a FullCAN object clears its
+   interrupt flag */
+static void canaf_ram_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	uint32_t end = SIM_DOOR(&sim_canaf, AF_OFS(ENDofTable)) & 0xFFC;
+	uint32_t obj;
+	(void)m;
+
+	if ((off >= end) && (((off - end) % 12) == 0) && !(val & (3UL << 24)))
+	{
+		obj = (off - end) / 12;
+		if (obj < 64)
+		{
+			SIM_DOOR(&sim_canaf, (obj < 32) ? AF_OFS(FCANIC0) : AF_OFS(FCANIC1)) &= ~(1UL << (obj & 0x1F));
+			can_update_irq();
+		}
+	}
+}
+
+static void canaf_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	(void)m;
+	(void)off;
+	(void)val;
+
+	can_update_irq();
+}
+
+static uint32_t cancr_read(SIM_MODEL_T *m, uint32_t off, Bool peek)
+{
+	uint32_t v = 0, c, sr;
+	(void)m;
+	(void)peek;
+
+	for (c = 0; c < 2; c++)
+	{
+		sr = can_sr(&sim_can[c]);
+		switch (off)
+		{
+		case 0x00:
+			v |= ((sr & 0x20) ? (1UL << c) : 0) | ((((sr & (sr >> 8) & (sr >> 16)) & 0x04) ? (1UL << (8 + c)) : 0))
+			   | ((((sr & (sr >> 8) & (sr >> 16)) & 0x08) ? (1UL << (16 + c)) : 0));
+			break;
+		case 0x04:
+			v |= ((sr & 0x01) ? (1UL << c) : 0) | ((sr & 0x02) ? (1UL << (8 + c)) : 0);
+			break;
+		default:
+			break;
+		}
+	}
+	return v;
+}
+
+static SIM_MODEL_T sim_canaf = { LPC_CANAF_BASE, 0x4000, NULL, canaf_write, NULL, SIM_NEVER, NULL };
+static SIM_MODEL_T sim_canaf_ram = { LPC_CANAF_RAM_BASE, 0x4000, NULL, canaf_ram_write, NULL, SIM_NEVER, NULL };
+static SIM_MODEL_T sim_cancr = { LPC_CANCR_BASE, 0x4000, cancr_read, NULL, NULL, SIM_NEVER, NULL };
+
+/* GPDMA model ---------------------------------------------------------------- */
+#define DMA_CH(n)			(0x100 + (n) * 0x20)
+#define DMA_CH_SRC			0x00
+#define DMA_CH_DST			0x04
+#define DMA_CH_LLI			0x08
+#define DMA_CH_CTRL			0x0C
+#define DMA_CH_CFG			0x10
+#define DMA_MEM_CYCLES		2		/* AHB to AHB transfer */
+#define DMA_PER_CYCLES		4		/* Transfer touching an APB peripheral */
+
+static uint32_t dma_raw_tc, dma_raw_err;
+
+/*********************************************************************//**
+ * @brief		Region holding a bus address
+ * @param[in]	addr	Bus address
+ * @return		Region or NULL for host memory
+ **********************************************************************/
+static SIM_REGION_T *sim_region_of(uint32_t addr)
+{
+	uint32_t i;
+
+	for (i = 0; i < SIM_NUM_REGION; i++)
+	{
+		if ((addr >= sim_region[i].base) && (addr - sim_region[i].base < sim_region[i].size))
+		{
+			return &sim_region[i];
+		}
+	}
+	return NULL;
+}
+
+/*********************************************************************//**
+ * @brief		Bus master read (DMA), peripheral registers go through
+ * 				their model like a CPU access
+ * @param[in]	addr	Bus address
+ * @param[in]	width	0 byte, 1 half word, 2 word
+ * @return		Data
+ **********************************************************************/
+static uint32_t sim_bus_read(uint32_t addr, uint32_t width)
+{
+	SIM_REGION_T *r = sim_region_of(addr);
+	SIM_MODEL_T *m;
+	uint32_t v, word;
+
+	if ((r == NULL) || !r->trap)
+	{
+		switch (width)
+		{
+		case 0:		return *(volatile uint8_t *)sim_host_ptr(addr);
+		case 1:		return *(volatile uint16_t *)sim_host_ptr(addr);
+		default:	return *(volatile uint32_t *)sim_host_ptr(addr);
+		}
+	}
+	word = (addr - r->base) & ~3UL;
+	m = r->slot[word >> r->shift];
+	v = *(volatile uint32_t *)(r->door + word);
+	if (m && m->read)
+	{
+		v = m->read(m, r->base + word - m->base, FALSE);
+	}
+	sim_stats.Accesses++;
+	v >>= 8 * (addr & 3);
+	return (width == 0) ? (v & 0xFF) : (width == 1) ? (v & 0xFFFF) : v;
+}
+
+/*********************************************************************//**
+ * @brief		Bus master write (DMA)
+ * @param[in]	addr	Bus address
+ * @param[in]	width	0 byte, 1 half word, 2 word
+ * @param[in]	val		Data
+ * @return		None
+ **********************************************************************/
+static void sim_bus_write(uint32_t addr, uint32_t width, uint32_t val)
+{
+	SIM_REGION_T *r = sim_region_of(addr);
+	SIM_MODEL_T *m;
+	uint32_t word;
+
+	if ((r == NULL) || !r->trap)
+	{
+		switch (width)
+		{
+		case 0:		*(volatile uint8_t *)sim_host_ptr(addr) = (uint8_t)val; break;
+		case 1:		*(volatile uint16_t *)sim_host_ptr(addr) = (uint16_t)val; break;
+		default:	*(volatile uint32_t *)sim_host_ptr(addr) = val; break;
+		}
+		return;
+	}
+	word = (addr - r->base) & ~3UL;
+	m = r->slot[word >> r->shift];
+	*(volatile uint32_t *)(r->door + word) = val;
+	if (m && m->write)
+	{
+		m->write(m, r->base + word - m->base, val);
+	}
+	sim_stats.Accesses++;
+}
+
+/*********************************************************************//**
+ * @brief		State of a peripheral DMA request line
+ * @param[in]	line	Request line 0..15
+ * @return		TRUE while the peripheral requests a transfer
+ **********************************************************************/
+static Bool sim_dma_request(uint32_t line)
+{
+	SIM_SSP_T *s;
+	SIM_UART_T *u;
+
+	if (line < 4)
+	{
+		s = &sim_ssp[(line < 2) ? 0 : 1];
+		if (line & 1)
+		{
+			return ((SIM_DOOR(&s->m, 0x24) & 0x01) && s->rx_cnt) ? TRUE : FALSE;
+		}
+		return ((SIM_DOOR(&s->m, 0x24) & 0x02) && (s->tx_cnt < 8)) ? TRUE : FALSE;
+	}
+	if (line == 4)
+	{
+		return adc_dma_request();
+	}
+	if (line == 7)
+	{
+		return dac_dma_request();
+	}
+	if ((line >= 8) && (line < 16)
+		&& !(SIM_DOOR(&sim_sc, SIM_OFS(LPC_SC_TypeDef, DMAREQSEL)) & (1UL << (line - 8))))
+	{
+		u = &sim_uart[(line - 8) >> 1];
+		if ((u->fcr & 0x09) != 0x09)
+		{
+			return FALSE;
+		}
+		if (line & 1)
+		{
+			return u->rx_cnt ? TRUE : FALSE;
+		}
+		return (u->tx_cnt < 16) ? TRUE : FALSE;
+	}
+	return FALSE;
+}
+
+static SIM_MODEL_T sim_gpdma;
+
+static uint32_t gpdma_mask(uint32_t bit)
+{
+	uint32_t ch, v = 0;
+
+	for (ch = 0; ch < 8; ch++)
+	{
+		if (SIM_DOOR(&sim_gpdma, DMA_CH(ch) + DMA_CH_CFG) & bit)
+		{
+			v |= 1UL << ch;
+		}
+	}
+	return v;
+}
+
+static void gpdma_update_irq(void)
+{
+	uint32_t st = (dma_raw_tc & gpdma_mask(1UL << 15)) | (dma_raw_err & gpdma_mask(1UL << 14));
+
+	sim_irq(DMA_IRQn, st != 0);
+}
+
+/* A peripheral changed state: let the DMA arbiter look at the request lines */
+static void sim_dma_poke(void)
+{
+	if (sim_gpdma.regs && (sim_gpdma.next > sim_now) && gpdma_mask(0x01))
+	{
+		sim_gpdma.next = sim_now;
+	}
+}
+
+static uint32_t gpdma_read(SIM_MODEL_T *m, uint32_t off, Bool peek)
+{
+	(void)peek;
+
+	switch (off)
+	{
+	case 0x000:	return (dma_raw_tc & gpdma_mask(1UL << 15)) | (dma_raw_err & gpdma_mask(1UL << 14));
+	case 0x004:	return dma_raw_tc & gpdma_mask(1UL << 15);
+	case 0x00C:	return dma_raw_err & gpdma_mask(1UL << 14);
+	case 0x014:	return dma_raw_tc;
+	case 0x018:	return dma_raw_err;
+	case 0x01C:	return gpdma_mask(0x01);
+	case 0x008:
+	case 0x010:	return 0;
+	default:	return SIM_DOOR(m, off) & ((((off & 0x1F) == DMA_CH_CFG) && (off >= 0x100)) ? ~(1UL << 17) : ~0UL);
+	}
+}
+
+static void gpdma_write(SIM_MODEL_T *m, uint32_t off, uint32_t val)
+{
+	switch (off)
+	{
+	case 0x008:	dma_raw_tc &= ~val; break;
+	case 0x010:	dma_raw_err &= ~val; break;
+	default:	break;
+	}
+	gpdma_update_irq();
+	m->next = sim_now;
+}
+
+/*********************************************************************//**
+ * @brief		Arbitrate and run one burst of the highest priority
+ * 				channel that has a request
+ **********************************************************************/
+static void gpdma_tick(SIM_MODEL_T *m)
+{
+	static const uint8_t burst[8] = { 1, 4, 8, 16, 32, 64, 128, 255 };
+	uint32_t ch, base, cfg, ctrl, type, src, dst, sw, dw, size, n, max, lli, cost = 0;
+	Bool sreq, dreq;
+
+	m->next = SIM_NEVER;
+	if (!(SIM_DOOR(m, 0x030) & 0x01))
+	{
+		return;
+	}
+	for (ch = 0; ch < 8; ch++)
+	{
+		base = DMA_CH(ch);
+		cfg = SIM_DOOR(m, base + DMA_CH_CFG);
+		if (!(cfg & 0x01) || (cfg & (1UL << 18)))
+		{
+			continue;
+		}
+		ctrl = SIM_DOOR(m, base + DMA_CH_CTRL);
+		type = (cfg >> 11) & 0x07;
+		sreq = ((type == 2) || (type == 3)) ? sim_dma_request((cfg >> 1) & 0x1F) : TRUE;
+		dreq = ((type == 1) || (type == 3)) ? sim_dma_request((cfg >> 6) & 0x1F) : TRUE;
+		size = ctrl & 0xFFF;
+		if (size && (!sreq || !dreq))
+		{
+			continue;
+		}
+
+		src = SIM_DOOR(m, base + DMA_CH_SRC);
+		dst = SIM_DOOR(m, base + DMA_CH_DST);
+		sw = (ctrl >> 18) & 0x07;
+		dw = (ctrl >> 21) & 0x07;
+		max = (type == 0) ? 16 : burst[(ctrl >> ((type == 2) ? 12 : 15)) & 0x07];
+		for (n = 0; size && (n < max); n++)
+		{
+			if ((n > 0) && (type != 0) && !(((type == 1) || sim_dma_request((cfg >> 1) & 0x1F))
+				&& ((type == 2) || sim_dma_request((cfg >> 6) & 0x1F))))
+			{
+				break;
+			}
+			sim_bus_write(dst, dw, sim_bus_read(src, sw));
+			if (ctrl & (1UL << 26))
+			{
+				src += 1UL << sw;
+			}
+			if (ctrl & (1UL << 27))
+			{
+				dst += 1UL << dw;
+			}
+			size--;
+			cost += (type == 0) ? DMA_MEM_CYCLES : DMA_PER_CYCLES;
+		}
+		SIM_DOOR(m, base + DMA_CH_SRC) = src;
+		SIM_DOOR(m, base + DMA_CH_DST) = dst;
+		SIM_DOOR(m, base + DMA_CH_CTRL) = (ctrl & ~0xFFFUL) | size;
+
+		if (size == 0)
+		{
+			if (ctrl & (1UL << 31))
+			{
+				dma_raw_tc |= 1UL << ch;
+			}
+			lli = SIM_DOOR(m, base + DMA_CH_LLI) & ~3UL;
+			if (lli)
+			{
+				SIM_DOOR(m, base + DMA_CH_SRC) = sim_bus_read(lli, 2);
+				SIM_DOOR(m, base + DMA_CH_DST) = sim_bus_read(lli + 4, 2);
+				SIM_DOOR(m, base + DMA_CH_LLI) = sim_bus_read(lli + 8, 2);
+				SIM_DOOR(m, base + DMA_CH_CTRL) = sim_bus_read(lli + 12, 2);
+				cost += 4 * DMA_MEM_CYCLES;
+			}
+			else
+			{
+				SIM_DOOR(m, base + DMA_CH_CFG) &= ~0x01UL;
+			}
+			gpdma_update_irq();
+		}
+		m->next = sim_now + (cost ? cost : 1);
+		return;
+	}
+}
+
+static SIM_MODEL_T sim_gpdma = { LPC_GPDMA_BASE, 0x4000, gpdma_read, gpdma_write, gpdma_tick, SIM_NEVER, NULL };
+
+/* Simulation engine ---------------------------------------------------------- */
+/*********************************************************************//**
+ * @brief		Map a region at its bus address, backed by a shared memfd
+ * 				so the models get an unprotected backdoor view
+ * @param[in]	r		Region
+ * @param[in]	fd		memfd, -1 for plain RAM
+ * @param[in]	pos		Offset inside the memfd
+ * @return		None
+ **********************************************************************/
+static void sim_map(SIM_REGION_T *r, int fd, off_t pos)
+{
+	void *bus;
+
+	if (!r->trap)
+	{
+		bus = mmap((void *)(uintptr_t)r->base, r->size, PROT_READ | PROT_WRITE,
+				   MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+		if (bus != (void *)(uintptr_t)r->base)
+		{
+			sim_fatal("cannot map AHB SRAM (link with -no-pie)");
+		}
+		r->door = bus;
+		return;
+	}
+	r->door = mmap(NULL, r->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, pos);
+	bus = mmap((void *)(uintptr_t)r->base, r->size, PROT_NONE,
+			   MAP_SHARED | MAP_FIXED_NOREPLACE, fd, pos);
+	if ((r->door == MAP_FAILED) || (bus != (void *)(uintptr_t)r->base))
+	{
+		sim_fatal("cannot map peripheral region (link with -no-pie)");
+	}
+}
+
+static void sim_attach(SIM_MODEL_T *m)
+{
+	uint32_t i, s;
+
+	for (i = 0; i < SIM_NUM_REGION; i++)
+	{
+		SIM_REGION_T *r = &sim_region[i];
+
+		if ((m->base >= r->base) && (m->base - r->base < r->size))
+		{
+			m->regs = r->door + (m->base - r->base);
+			for (s = (m->base - r->base) >> r->shift;
+				 s <= (m->base - r->base + m->size - 1) >> r->shift; s++)
+			{
+				r->slot[s] = m;
+			}
+			sim_model[sim_num_model++] = m;
+			return;
+		}
+	}
+}
+
+/*********************************************************************//**
+ * @brief		SIGSEGV handler: a peripheral register was touched. The
+ * 				model value is placed behind the page, which is opened
+ * 				for exactly one instruction (trap flag single step).
+ **********************************************************************/
+static void sim_segv(int sig, siginfo_t *si, void *ctx)
+{
+	ucontext_t *uc = (ucontext_t *)ctx;
+	uintptr_t addr = (uintptr_t)si->si_addr;
+	SIM_REGION_T *r = NULL;
+	SIM_MODEL_T *m;
+	uint32_t i, word;
+	(void)sig;
+
+	for (i = 0; i < SIM_NUM_REGION; i++)
+	{
+		if (sim_region[i].trap && (addr >= sim_region[i].base) && (addr - sim_region[i].base < sim_region[i].size))
+		{
+			r = &sim_region[i];
+		}
+	}
+	if ((r == NULL) || sim_step.active)
+	{
+		signal(SIGSEGV, SIG_DFL);
+		return;
+	}
+	word = (uint32_t)(addr - r->base) & ~3UL;
+	m = r->slot[word >> r->shift];
+	sim_step.write = (uc->uc_mcontext.gregs[REG_ERR] & 0x02) ? TRUE : FALSE;
+	sim_step.door = (volatile uint32_t *)(r->door + word);
+	sim_step.model = m;
+	sim_step.off = m ? (r->base + word - m->base) : 0;
+	sim_step.page = (uint8_t *)(uintptr_t)((r->base + word) & ~(SIM_PAGE - 1));
+	if (m && m->read)
+	{
+		*sim_step.door = m->read(m, sim_step.off, sim_step.write);
+	}
+	sim_step.active = 1;
+	mprotect(sim_step.page, SIM_PAGE, PROT_READ | PROT_WRITE);
+	uc->uc_mcontext.gregs[REG_EFL] |= SIM_EFLAGS_TF;
+}
+
+/*********************************************************************//**
+ * @brief		SIGTRAP handler: the access has retired. Close the page,
+ * 				hand a write to the model and advance the virtual clock.
+ **********************************************************************/
+static void sim_trap(int sig, siginfo_t *si, void *ctx)
+{
+	ucontext_t *uc = (ucontext_t *)ctx;
+	SIM_MODEL_T *m = sim_step.model;
+	(void)sig;
+	(void)si;
+
+	uc->uc_mcontext.gregs[REG_EFL] &= ~SIM_EFLAGS_TF;
+	if (!sim_step.active)
+	{
+		return;
+	}
+	mprotect(sim_step.page, SIM_PAGE, PROT_NONE);
+	sim_step.active = 0;
+	if (sim_step.write && m && m->write)
+	{
+		m->write(m, sim_step.off, *sim_step.door);
+	}
+	sim_stats.Accesses++;
+	sim_traps++;
+	sim_run(HOSTSIM_ACCESS_CYCLES);
+}
+
+/*********************************************************************//**
+ * @brief		SIGVTALRM handler: grant virtual time to code spinning on
+ * 				RAM only, e.g. delay_ms() waiting for SysTick_Handler
+ **********************************************************************/
+static void sim_idle(int sig)
+{
+	uint64_t grant = HOSTSIM_UsToCycles(HOSTSIM_IDLE_GRANT_US);
+	uint64_t next, end, irqs;
+	(void)sig;
+
+	if (sim_step.active || sim_lock || sim_in_irq)
+	{
+		return;
+	}
+	if (sim_traps != sim_idle_mark)
+	{
+		sim_idle_mark = sim_traps;
+		return;
+	}
+	/* RAM flags only change in handlers: stop right after the first one
+	   so polled completion flags keep their timing */
+	sim_stats.IdleTicks++;
+	end = sim_now + grant;
+	irqs = sim_stats.Interrupts;
+	while ((sim_now < end) && (irqs == sim_stats.Interrupts))
+	{
+		next = sim_next_event();
+		sim_run(((next >= sim_now) && (next < end)) ? (next - sim_now) : (end - sim_now));
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Advance the virtual clock, firing model events in order
+ * @param[in]	cycles	CPU cycles to advance
+ * @return		None
+ **********************************************************************/
+static void sim_run(uint64_t cycles)
+{
+	uint64_t target = sim_now + cycles;
+	SIM_MODEL_T *m;
+	uint32_t i;
+
+	sim_lock++;
+	for (;;)
+	{
+		m = NULL;
+		for (i = 0; i < sim_num_model; i++)
+		{
+			if ((sim_model[i]->next <= target) && ((m == NULL) || (sim_model[i]->next < m->next)))
+			{
+				m = sim_model[i];
+			}
+		}
+		if (m == NULL)
+		{
+			break;
+		}
+		if (m->next > sim_now)
+		{
+			sim_now = m->next;
+		}
+		m->tick(m);
+		sim_dispatch();
+	}
+	if (sim_now < target)
+	{
+		sim_now = target;
+	}
+	sim_lock--;
+	sim_dispatch();
+}
+
+/*********************************************************************//**
+ * @brief		Take pending exceptions, highest priority first. Handlers
+ * 				do not nest.
+ **********************************************************************/
+static void sim_dispatch(void)
+{
+	int32_t best, n;
+	uint32_t prio, p, bit;
+	void (*handler)(void);
+
+	while (!sim_in_irq && !sim_primask && sim_ready)
+	{
+		best = -16;
+		prio = 0x100;
+		if (sim_st_pend)
+		{
+			best = -1;
+			prio = scs_prio(-1);
+		}
+		for (n = 0; n < SIM_NUM_IRQ; n++)
+		{
+			bit = 1UL << (n & 0x1F);
+			if ((sim_irq_pend[n >> 5] & sim_irq_en[n >> 5] & bit) && ((p = scs_prio(n)) < prio))
+			{
+				prio = p;
+				best = n;
+			}
+		}
+		if (best == -16)
+		{
+			return;
+		}
+		if (best < 0)
+		{
+			sim_st_pend = 0;
+			handler = SysTick_Handler;
+		}
+		else
+		{
+			sim_irq_pend[best >> 5] &= ~(1UL << (best & 0x1F));
+			handler = sim_vector[best];
+		}
+		if (handler == NULL)
+		{
+			sim_log("hostsim: exception without handler disabled\n");
+			if (best >= 0)
+			{
+				sim_irq_en[best >> 5] &= ~(1UL << (best & 0x1F));
+			}
+			else
+			{
+				SIM_DOOR(&sim_scs, SCS_ST_CTRL) &= ~0x02;
+			}
+			continue;
+		}
+		sim_in_irq = 1;
+		sim_irq_active = best;
+		sim_stats.Interrupts++;
+		sim_now += 12;
+		handler();
+		sim_now += 12;
+		sim_irq_active = -16;
+		sim_in_irq = 0;
+		if ((best >= 0) && (sim_irq_line[best >> 5] & (1UL << (best & 0x1F))))
+		{
+			sim_irq_pend[best >> 5] |= 1UL << (best & 0x1F);
+		}
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Earliest pending model event
+ * @param		None
+ * @return		Virtual time of the event or SIM_NEVER
+ **********************************************************************/
+static uint64_t sim_next_event(void)
+{
+	uint64_t t = SIM_NEVER;
+	uint32_t i;
+
+	for (i = 0; i < sim_num_model; i++)
+	{
+		if (sim_model[i]->next < t)
+		{
+			t = sim_model[i]->next;
+		}
+	}
+	return t;
+}
+
+static void sim_reset(void)
+{
+	uint32_t i;
+
+	/* SC reset values */
+	SIM_DOOR(&sim_sc, SIM_OFS(LPC_SC_TypeDef, PCONP)) = 0x042887DE;
+	SIM_DOOR(&sim_sc, SIM_OFS(LPC_SC_TypeDef, FLASHCFG)) = 0x303A;
+
+	/* SCB */
+	SIM_DOOR(&sim_scs, 0xD00) = 0x412FC230;
+	SIM_DOOR(&sim_scs, SCS_AIRCR) = 0xFA050000;
+
+	for (i = 0; i < 4; i++)
+	{
+		SIM_UART_T *u = &sim_uart[i];
+
+		u->dll = 0x01;
+		u->fdr = 0x10;
+		u->ter = 0x80;
+	}
+
+	SIM_DOOR(&sim_adc.m, ADC_OFS(ADINTEN)) = 0x100;
+
+	SIM_DOOR(&sim_rit.m, RIT_OFS(RICOMPVAL)) = 0xFFFFFFFF;
+	sim_rit.ctrl = 0x0C;
+
+	/* CAN controllers come out of reset in reset mode */
+	for (i = 0; i < 2; i++)
+	{
+		SIM_DOOR(&sim_can[i].m, CAN_MOD) = 0x01;
+		SIM_DOOR(&sim_can[i].m, CAN_BTR) = 0x1C0000;
+		sim_can[i].tx_tcs = 0x07;
+		sim_can[i].tx_cur = -1;
+	}
+	SIM_DOOR(&sim_canaf, AF_OFS(AFMR)) = 0x01;
+
+	/* KSZ8031 PHY with link up, 100M full duplex */
+	sim_emac.phy[0] = 0x3100;
+	sim_emac.phy[1] = 0x786D;
+	sim_emac.phy[2] = 0x0022;
+	sim_emac.phy[3] = 0x1556;
+	sim_emac.phy[4] = 0x01E1;
+	sim_emac.phy[5] = 0x45E1;
+	SIM_DOOR(&sim_emac.m, EMAC_OFS(MAXF)) = 0x0600;
+	SIM_DOOR(&sim_emac.m, EMAC_OFS(Module_ID)) = 0x39022000;
+}
+
+static void sim_model_init(SIM_MODEL_T *m, uint32_t base,
+						   uint32_t (*rd)(SIM_MODEL_T *, uint32_t, Bool),
+						   void (*wr)(SIM_MODEL_T *, uint32_t, uint32_t),
+						   void (*tick)(SIM_MODEL_T *))
+{
+	m->base = base;
+	m->size = 0x4000;
+	m->read = rd;
+	m->write = wr;
+	m->tick = tick;
+	m->next = SIM_NEVER;
+}
+
+/* Constructor: the simulator is up before main() touches a register */
+static void sim_ctor(void) __attribute__((constructor));
+static void sim_ctor(void)
+{
+	HOSTSIM_Init();
+}
+
+/* Public Functions ----------------------------------------------------------- */
+/** @addtogroup HOSTSIM_Public_Functions
+ * @{
+ */
+
+/*********************************************************************//**
+ * @brief 		Map the peripheral regions and install the access trap.
+ * 				Called automatically before main(), repeated calls are
+ * 				ignored.
+ * @param		None
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_Init(void)
+{
+	static const uint32_t uart_base[4] = { LPC_UART0_BASE, LPC_UART1_BASE, LPC_UART2_BASE, LPC_UART3_BASE };
+	static const uint8_t uart_pclk[4][2] = { { 0, 6 }, { 0, 8 }, { 1, 16 }, { 1, 18 } };
+	static const uint32_t i2c_base[3] = { LPC_I2C0_BASE, LPC_I2C1_BASE, LPC_I2C2_BASE };
+	static const uint8_t i2c_pclk[3][2] = { { 0, 14 }, { 1, 6 }, { 1, 20 } };
+	static const uint32_t tim_base[4] = { LPC_TIM0_BASE, LPC_TIM1_BASE, LPC_TIM2_BASE, LPC_TIM3_BASE };
+	static const uint8_t tim_pclk[4][2] = { { 0, 2 }, { 0, 4 }, { 1, 12 }, { 1, 14 } };
+	struct sigaction sa;
+	struct itimerval it;
+	off_t pos = 0;
+	uint32_t i;
+	int fd;
+
+	if (sim_ready)
+	{
+		return;
+	}
+
+	fd = memfd_create("lpc17xx", 0);
+	for (i = 0; i < SIM_NUM_REGION; i++)
+	{
+		if (sim_region[i].trap)
+		{
+			pos += sim_region[i].size;
+		}
+	}
+	if ((fd < 0) || (ftruncate(fd, pos) != 0))
+	{
+		sim_fatal("cannot create register file");
+	}
+	for (pos = 0, i = 0; i < SIM_NUM_REGION; i++)
+	{
+		sim_map(&sim_region[i], fd, pos);
+		if (sim_region[i].trap)
+		{
+			pos += sim_region[i].size;
+		}
+	}
+
+	/* Behavioural models */
+	sim_attach(&sim_sc);
+	sim_attach(&sim_gpio);
+	sim_attach(&sim_gpioint);
+	sim_attach(&sim_scs);
+	sim_attach(&sim_dwt);
+	for (i = 0; i < 4; i++)
+	{
+		sim_model_init(&sim_uart[i].m, uart_base[i], uart_read, uart_write, uart_tick);
+		sim_uart[i].irq = (IRQn_Type)(UART0_IRQn + i);
+		sim_uart[i].sel = uart_pclk[i][0];
+		sim_uart[i].bit = uart_pclk[i][1];
+		sim_attach(&sim_uart[i].m);
+	}
+	sim_model_init(&sim_ssp[0].m, LPC_SSP0_BASE, ssp_read, ssp_write, ssp_tick);
+	sim_ssp[0].irq = SSP0_IRQn;
+	sim_ssp[0].sel = 1;
+	sim_ssp[0].bit = 10;
+	sim_ssp[0].port = 0;
+	sim_model_init(&sim_ssp[1].m, LPC_SSP1_BASE, ssp_read, ssp_write, ssp_tick);
+	sim_ssp[1].irq = SSP1_IRQn;
+	sim_ssp[1].sel = 0;
+	sim_ssp[1].bit = 20;
+	sim_ssp[1].port = 1;
+	sim_attach(&sim_ssp[0].m);
+	sim_attach(&sim_ssp[1].m);
+	sim_model_init(&sim_spi.m, LPC_SPI_BASE, spi_read, spi_write, spi_tick);
+	sim_attach(&sim_spi.m);
+	for (i = 0; i < 3; i++)
+	{
+		sim_model_init(&sim_i2c[i].m, i2c_base[i], i2c_read, i2c_write, i2c_tick);
+		sim_i2c[i].irq = (IRQn_Type)(I2C0_IRQn + i);
+		sim_i2c[i].sel = i2c_pclk[i][0];
+		sim_i2c[i].bit = i2c_pclk[i][1];
+		sim_i2c[i].stat = 0xF8;
+		sim_attach(&sim_i2c[i].m);
+	}
+	for (i = 0; i < 4; i++)
+	{
+		sim_model_init(&sim_tim[i].m, tim_base[i], tim_read, tim_write, tim_tick);
+		sim_tim[i].irq = (IRQn_Type)(TIMER0_IRQn + i);
+		sim_tim[i].sel = tim_pclk[i][0];
+		sim_tim[i].bit = tim_pclk[i][1];
+		sim_attach(&sim_tim[i].m);
+	}
+	sim_model_init(&sim_rit.m, LPC_RIT_BASE, rit_read, rit_write, rit_tick);
+	sim_attach(&sim_rit.m);
+	sim_model_init(&sim_pwm.m, LPC_PWM1_BASE, pwm_read, pwm_write, pwm_tick);
+	sim_attach(&sim_pwm.m);
+	sim_model_init(&sim_mcpwm.m, LPC_MCPWM_BASE, mc_read, mc_write, mc_tick);
+	sim_attach(&sim_mcpwm.m);
+	sim_model_init(&sim_qei.m, LPC_QEI_BASE, qei_read, qei_write, qei_tick);
+	sim_attach(&sim_qei.m);
+	sim_model_init(&sim_adc.m, LPC_ADC_BASE, adc_read, adc_write, adc_tick);
+	sim_attach(&sim_adc.m);
+	sim_model_init(&sim_dac.m, LPC_DAC_BASE, dac_read, dac_write, dac_tick);
+	sim_attach(&sim_dac.m);
+	sim_model_init(&sim_emac.m, LPC_EMAC_BASE, emac_read, emac_write, emac_tick);
+	sim_attach(&sim_emac.m);
+	sim_attach(&sim_gpdma);
+	for (i = 0; i < 2; i++)
+	{
+		sim_model_init(&sim_can[i].m, i ? LPC_CAN2_BASE : LPC_CAN1_BASE, can_read, can_write, can_tick);
+		sim_can[i].unit = (uint8_t)i;
+		sim_can[i].bit = i ? 28 : 26;
+		sim_attach(&sim_can[i].m);
+	}
+	sim_attach(&sim_canaf);
+	sim_attach(&sim_canaf_ram);
+	sim_attach(&sim_cancr);
+	sim_reset();
+
+	/* Access trap and idle clock */
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_flags = SA_SIGINFO | SA_NODEFER;
+	sigemptyset(&sa.sa_mask);
+	sigaddset(&sa.sa_mask, SIGVTALRM);
+	sa.sa_sigaction = sim_segv;
+	sigaction(SIGSEGV, &sa, NULL);
+	sa.sa_sigaction = sim_trap;
+	sigaction(SIGTRAP, &sa, NULL);
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_flags = SA_RESTART;
+	sigemptyset(&sa.sa_mask);
+	sa.sa_handler = sim_idle;
+	sigaction(SIGVTALRM, &sa, NULL);
+	it.it_interval.tv_sec = 0;
+	it.it_interval.tv_usec = HOSTSIM_IDLE_TICK_US;
+	it.it_value = it.it_interval;
+	setitimer(ITIMER_VIRTUAL, &it, NULL);
+
+	sim_ready = 1;
+}
+
+/*********************************************************************//**
+ * @brief 		Get the virtual CPU clock
+ * @param		None
+ * @return 		CPU cycles since HOSTSIM_Init()
+ **********************************************************************/
+uint64_t HOSTSIM_GetCycles(void)
+{
+	return sim_now;
+}
+
+/*********************************************************************//**
+ * @brief 		Convert a time to CPU cycles at the current CCLK
+ * @param[in]	us		Time in micro seconds
+ * @return 		CPU cycles
+ **********************************************************************/
+uint64_t HOSTSIM_UsToCycles(uint32_t us)
+{
+	return (uint64_t)us * sc_cclk(&sim_sc) / 1000000;
+}
+
+/*********************************************************************//**
+ * @brief 		Let the peripherals run, dispatching their interrupts
+ * @param[in]	cycles	CPU cycles to advance
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_Advance(uint64_t cycles)
+{
+	sim_run(cycles);
+}
+
+/*********************************************************************//**
+ * @brief 		Read the simulator statistics
+ * @param[out]	stats	Pointer to a HOSTSIM_STATS_Type structure
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_GetStats(HOSTSIM_STATS_Type *stats)
+{
+	*stats = sim_stats;
+	stats->Cycles = sim_now;
+}
+
+/*********************************************************************//**
+ * @brief 		Get the 32 bit bus address of host memory, for DMA
+ * 				registers, linked list items and EMAC descriptors
+ * @param[in]	ptr		Host pointer
+ * @return 		The pointer itself when below 4 GB (static data of a
+ * 				-no-pie build), otherwise an address in a bus window
+ * 				that the DMA and EMAC models map back. A buffer must
+ * 				not be longer than 16 MB.
+ **********************************************************************/
+uint32_t HOSTSIM_BusAddr(const void *ptr)
+{
+	uintptr_t p = (uintptr_t)ptr;
+	uint32_t win;
+
+	if ((p >> 16) >> 16 == 0)
+	{
+		return (uint32_t)p;
+	}
+	for (win = 0; (win < SIM_BUSWIN_NUM) && sim_buswin[win]; win++)
+	{
+		if (p - sim_buswin[win] < (1UL << SIM_BUSWIN_SHIFT) - SIM_BUSWIN_ALIGN)
+		{
+			break;
+		}
+	}
+	if (win == SIM_BUSWIN_NUM)
+	{
+		sim_fatal("out of bus windows for host memory");
+	}
+	if (!sim_buswin[win])
+	{
+		sim_buswin[win] = p & ~SIM_BUSWIN_ALIGN;
+	}
+	return SIM_BUSWIN_BASE + (win << SIM_BUSWIN_SHIFT) + (uint32_t)(p - sim_buswin[win]);
+}
+
+/*********************************************************************//**
+ * @brief 		Set PRIMASK, pending interrupts are taken on clear
+ * @param[in]	primask	1 to mask interrupts, 0 to unmask
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_SetPrimask(uint32_t primask)
+{
+	sim_primask = primask & 0x01;
+	if (!sim_primask && !sim_lock && !sim_step.active)
+	{
+		sim_dispatch();
+	}
+}
+
+/*********************************************************************//**
+ * @brief 		Get PRIMASK
+ * @param		None
+ * @return 		PRIMASK value
+ **********************************************************************/
+uint32_t HOSTSIM_GetPrimask(void)
+{
+	return sim_primask;
+}
+
+/*********************************************************************//**
+ * @brief 		Get IPSR
+ * @param		None
+ * @return 		Exception number of the running handler, 0 in thread mode
+ **********************************************************************/
+uint32_t HOSTSIM_GetIpsr(void)
+{
+	return (uint32_t)(sim_irq_active + 16) & 0x1FF;
+}
+
+/*********************************************************************//**
+ * @brief 		Sleep until an interrupt has been taken
+ * @param		None
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_WaitForInterrupt(void)
+{
+	uint64_t n = sim_stats.Interrupts;
+	uint64_t t;
+	uint32_t i;
+
+	for (i = 0; (i < 1000) && (n == sim_stats.Interrupts); i++)
+	{
+		if ((sim_irq_pend[0] & sim_irq_en[0]) || (sim_irq_pend[1] & sim_irq_en[1]) || sim_st_pend)
+		{
+			break;
+		}
+		t = sim_next_event();
+		if (t == SIM_NEVER)
+		{
+			t = sim_now + HOSTSIM_UsToCycles(HOSTSIM_IDLE_GRANT_US);
+		}
+		else if (t < sim_now)
+		{
+			// Fire the overdue event alone, a grant would run past its interrupt
+			t = sim_now;
+		}
+		sim_run(t - sim_now);
+	}
+}
+
+/*********************************************************************//**
+ * @brief 		Drive GPIO input pins from the host side
+ * @param[in]	port	GPIO port 0..4
+ * @param[in]	mask	Pins to change
+ * @param[in]	value	New pin levels
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_GPIOSetInput(uint8_t port, uint32_t mask, uint32_t value)
+{
+	if (port < 5)
+	{
+		gpio_in[port] = (gpio_in[port] & ~mask) | (value & mask);
+		gpioint_edges(port);
+	}
+}
+
+/*********************************************************************//**
+ * @brief 		Read the GPIO output latch
+ * @param[in]	port	GPIO port 0..4
+ * @return 		Output register value
+ **********************************************************************/
+uint32_t HOSTSIM_GPIOGetOutput(uint8_t port)
+{
+	return (port < 5) ? gpio_out[port] : 0;
+}
+
+/*********************************************************************//**
+ * @brief 		Read the GPIO direction register
+ * @param[in]	port	GPIO port 0..4
+ * @return 		FIODIR value
+ **********************************************************************/
+uint32_t HOSTSIM_GPIOGetDir(uint8_t port)
+{
+	return (port < 5) ? SIM_DOOR(&sim_gpio, (uint32_t)port << 5) : 0;
+}
+
+/*********************************************************************//**
+ * @brief 		Watch the GPIO outputs
+ * @param[in]	sink	Called with the port, the new and the old latch
+ * 						value each time an output latch changes, and with
+ * 						the same value twice when FIODIR is written. NULL
+ * 						to stop.
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_GPIOSetSink(HOSTSIM_GPIO_SINK_Type sink)
+{
+	gpio_sink = sink;
+}
+
+/*********************************************************************//**
+ * @brief 		Set the analog inputs of the ADC
+ * @param[in]	src		Called at the end of each conversion with the
+ * 						channel and the virtual time, returns the 12-bit
+ * 						result. NULL converts zero.
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_ADCSetSource(HOSTSIM_ADC_SRC_Type src)
+{
+	sim_adc.src = src;
+}
+
+/*********************************************************************//**
+ * @brief 		Watch the PWM1 periods
+ * @param[in]	sink	Called with the match values in effect each time
+ * 						a period starts, NULL to stop
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_PWMSetSink(HOSTSIM_PWM_SINK_Type sink)
+{
+	sim_pwm.sink = sink;
+}
+
+/*********************************************************************//**
+ * @brief 		Drive a timer capture input with a square wave. The wave
+ * 				starts high, its first rising edge comes a period after
+ * 				the current virtual time.
+ * @param[in]	timer	Timer 0..3
+ * @param[in]	cap		Capture input CAPn.0 or CAPn.1, 0..1
+ * @param[in]	hz		Frequency (Hz), 0 holds the input low
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_TimerSetInput(uint8_t timer, uint8_t cap, double hz)
+{
+	SIM_TIM_T *t;
+
+	if ((timer > 3) || (cap > 1))
+	{
+		return;
+	}
+	t = &sim_tim[timer];
+	sim_lock++;
+	tim_update(t);
+	t->sig[cap].per = (hz > 0) ? (double)sc_cclk(&sim_sc) / hz : 0;
+	t->sig[cap].t0 = (double)sim_now;
+	tim_sched(t);
+	sim_lock--;
+}
+
+/*********************************************************************//**
+ * @brief 		Connect a DC motor to MCPWM channel 0 and the QEI. The
+ * 				motor starts at rest at angle 0 without load.
+ * @param[in]	motor	Motor parameters, copied, NULL to disconnect
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_MotorAttach(const HOSTSIM_MOTOR_Type *motor)
+{
+	sim_lock++;
+	motor_advance();
+	memset(&sim_motor, 0, sizeof(sim_motor));
+	if (motor != NULL)
+	{
+		sim_motor.p = *motor;
+		sim_motor.on = TRUE;
+	}
+	sim_motor.upd = sim_now;
+	sim_qei.base = 0;
+	sim_qei.ibase = 0;
+	sim_qei.vbase = 0;
+	sim_qei.dir = 0;
+	mc_drive(&sim_mcpwm);
+	sim_lock--;
+}
+
+/*********************************************************************//**
+ * @brief 		Change the load torque on the motor shaft
+ * @param[in]	torque	Torque (N m) against forward rotation
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_MotorSetLoad(double torque)
+{
+	sim_lock++;
+	motor_advance();
+	sim_motor.load = torque;
+	sim_lock--;
+}
+
+/*********************************************************************//**
+ * @brief 		Speed of the motor plant
+ * @param		None
+ * @return 		Speed (RPM), negative in reverse
+ **********************************************************************/
+double HOSTSIM_MotorGetSpeed(void)
+{
+	double rpm;
+
+	sim_lock++;
+	motor_advance();
+	rpm = sim_motor.w * 60 / MOTOR_TWO_PI;
+	sim_lock--;
+	return rpm;
+}
+
+/*********************************************************************//**
+ * @brief 		Watch the DAC output
+ * @param[in]	sink	Called with the 10-bit value and the virtual time
+ * 						each time AOUT is updated, NULL to stop
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_DACSetSink(HOSTSIM_DAC_SINK_Type sink)
+{
+	sim_dac.sink = sink;
+}
+
+/*********************************************************************//**
+ * @brief 		Queue bytes on the RX line of a UART, they arrive at the
+ * 				programmed baud rate
+ * @param[in]	port	UART 0..3
+ * @param[in]	data	Bytes to send to the target
+ * @param[in]	len		Number of bytes
+ * @return 		Number of bytes queued
+ **********************************************************************/
+uint32_t HOSTSIM_UARTInject(uint8_t port, const uint8_t *data, uint32_t len)
+{
+	SIM_UART_T *u = &sim_uart[port & 0x03];
+	uint32_t i;
+
+	sim_lock++;
+	if (u->in_cnt == 0)
+	{
+		u->rx_next = sim_now + uart_char(u);
+	}
+	for (i = 0; (i < len) && (u->in_cnt < HOSTSIM_UART_INJECT_SIZE); i++)
+	{
+		u->in[(u->in_rd + u->in_cnt++) % HOSTSIM_UART_INJECT_SIZE] = data[i];
+	}
+	uart_sched(u);
+	sim_lock--;
+	return i;
+}
+
+/*********************************************************************//**
+ * @brief 		Drain the bytes transmitted by a UART
+ * @param[in]	port	UART 0..3
+ * @param[out]	data	Destination buffer
+ * @param[in]	len		Buffer size
+ * @return 		Number of bytes copied
+ **********************************************************************/
+uint32_t HOSTSIM_UARTCapture(uint8_t port, uint8_t *data, uint32_t len)
+{
+	SIM_UART_T *u = &sim_uart[port & 0x03];
+	uint32_t i;
+
+	sim_lock++;
+	for (i = 0; (i < len) && u->cap_cnt; i++)
+	{
+		data[i] = u->cap[u->cap_rd];
+		u->cap_rd = (u->cap_rd + 1) % HOSTSIM_UART_CAPTURE_SIZE;
+		u->cap_cnt--;
+	}
+	sim_lock--;
+	return i;
+}
+
+/*********************************************************************//**
+ * @brief 		Install a callback for every byte a UART transmits
+ * @param[in]	port	UART 0..3
+ * @param[in]	sink	Callback, NULL to remove
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_UARTSetSink(uint8_t port, HOSTSIM_UART_SINK_Type sink)
+{
+	sim_uart[port & 0x03].sink = sink;
+}
+
+/*********************************************************************//**
+ * @brief 		Copy the bytes a UART transmits to the host stdout
+ * @param[in]	port	UART 0..3
+ * @param[in]	echo	TRUE to enable
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_UARTSetEcho(uint8_t port, Bool echo)
+{
+	sim_uart[port & 0x03].echo = echo;
+}
+
+/*********************************************************************//**
+ * @brief 		Attach the slave device seen on an SSP port
+ * @param[in]	port	SSP 0..1
+ * @param[in]	dev		Frame exchange callback, NULL for MISO high
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_SSPAttach(uint8_t port, HOSTSIM_SSP_DEV_Type dev)
+{
+	sim_ssp[port & 0x01].dev = dev;
+}
+
+/*********************************************************************//**
+ * @brief 		Attach the slave device seen on the SPI port
+ * @param[in]	dev		Frame exchange callback, called with port 2,
+ * 						NULL for MISO high
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_SPIAttach(HOSTSIM_SSP_DEV_Type dev)
+{
+	sim_spi.dev = dev;
+}
+
+/*********************************************************************//**
+ * @brief 		Insert an SD card backed by an image file on the SPI.
+ * 				Writes go straight to the file.
+ * @param[in]	path	Image file, a multiple of 512 bytes
+ * @param[in]	sdhc	TRUE for a block addressed SDHC card, FALSE for
+ * 						a byte addressed v1 card (at most 2GB)
+ * @return 		SUCCESS or ERROR when the image cannot be mapped
+ **********************************************************************/
+Status HOSTSIM_SDCardOpen(const char *path, Bool sdhc)
+{
+	off_t size;
+	void *img;
+	int fd;
+
+	HOSTSIM_SDCardClose();
+	fd = open(path, O_RDWR);
+	if (fd < 0)
+	{
+		return ERROR;
+	}
+	size = lseek(fd, 0, SEEK_END);
+	if ((size < SDC_BLOCK * 1024) || (size % SDC_BLOCK) ||
+		(!sdhc && (size > 0x80000000LL)))
+	{
+		close(fd);
+		return ERROR;
+	}
+	img = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (img == MAP_FAILED)
+	{
+		return ERROR;
+	}
+	memset(&sim_sd, 0, sizeof(sim_sd));
+	sim_sd.img = img;
+	sim_sd.blocks = (uint32_t)(size / SDC_BLOCK);
+	sim_sd.hc = sdhc;
+	sim_sd.idle = TRUE;
+	sim_spi.dev = sdc_spi;
+	gpio_in[4] &= ~(1UL << 29);
+	return SUCCESS;
+}
+
+/*********************************************************************//**
+ * @brief 		Remove the SD card, flushing the image file
+ * @param		None
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_SDCardClose(void)
+{
+	if (sim_sd.img)
+	{
+		msync(sim_sd.img, (size_t)sim_sd.blocks * SDC_BLOCK, MS_SYNC);
+		munmap(sim_sd.img, (size_t)sim_sd.blocks * SDC_BLOCK);
+		sim_sd.img = NULL;
+	}
+	gpio_in[4] |= (1UL << 29);
+}
+
+/*********************************************************************//**
+ * @brief 		Corrupt data blocks sent by the SD card on the wire
+ * @param[in]	count	Number of following data blocks to corrupt
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_SDCardInjectCrcError(uint32_t count)
+{
+	sim_sd.crc_faults = count;
+}
+
+/*********************************************************************//**
+ * @brief 		Attach a slave device to an I2C bus
+ * @param[in]	bus		I2C 0..2
+ * @param[in]	dev		Slave device
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_I2CAttach(uint8_t bus, HOSTSIM_I2C_SLAVE_Type *dev)
+{
+	SIM_I2C_T *c = &sim_i2c[(bus < 3) ? bus : 0];
+
+	dev->Next = c->slaves;
+	c->slaves = dev;
+}
+
+/*********************************************************************//**
+ * @brief 		Set up a serial EEPROM slave (AT24Cxx / M24xxx style).
+ * 				Address bits above the word address are taken from the
+ * 				low bits of the slave address.
+ * @param[in]	ee			EEPROM model
+ * @param[in]	addr		7-bit slave address
+ * @param[in]	mem			Backing store of size bytes
+ * @param[in]	size		Size in bytes (power of two)
+ * @param[in]	page		Write page size in bytes (power of two)
+ * @param[in]	addr_bytes	Word address bytes (1 or 2)
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_EEPROMInit(HOSTSIM_EEPROM_Type *ee, uint8_t addr, uint8_t *mem,
+						uint32_t size, uint16_t page, uint8_t addr_bytes)
+{
+	uint32_t blocks = size >> (8 * addr_bytes);
+	uint8_t mask = 0x7F;
+
+	while (blocks > 1)
+	{
+		mask <<= 1;
+		blocks >>= 1;
+	}
+	memset(ee, 0, sizeof(*ee));
+	ee->Slave.Addr = addr;
+	ee->Slave.AddrMask = mask & 0x7F;
+	ee->Slave.Start = eeprom_start;
+	ee->Slave.Write = eeprom_write;
+	ee->Slave.Read = eeprom_read;
+	ee->Slave.Stop = eeprom_stop;
+	ee->Mem = mem;
+	ee->Size = size;
+	ee->PageSize = page;
+	ee->AddrBytes = addr_bytes;
+	ee->WriteTimeUs = 5000;
+	ee->cut = -1;
+}
+
+/*********************************************************************//**
+ * @brief 		Arm a power cut for fault injection. After the given
+ * 				number of data bytes the part stops responding, the
+ * 				bytes of the interrupted page write that were clocked
+ * 				in before stay programmed (torn write).
+ * @param[in]	ee			EEPROM model
+ * @param[in]	bytes		Data bytes still accepted before the cut
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_EEPROMPowerCut(HOSTSIM_EEPROM_Type *ee, uint32_t bytes)
+{
+	ee->cut = (int32_t)bytes;
+}
+
+/*********************************************************************//**
+ * @brief 		Power the part up again after HOSTSIM_EEPROMPowerCut(),
+ * 				the memory keeps its contents and no cut is armed
+ * @param[in]	ee			EEPROM model
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_EEPROMPowerOn(HOSTSIM_EEPROM_Type *ee)
+{
+	ee->dead = 0;
+	ee->cut = -1;
+	ee->phase = 0;
+	ee->dirty = 0;
+	ee->busy_until = 0;
+}
+
+/*********************************************************************//**
+ * @brief 		Put an Ethernet frame on the wire towards the EMAC
+ * @param[in]	frame	Frame without FCS
+ * @param[in]	len		Frame length
+ * @return 		SUCCESS or ERROR when the host queue is full
+ **********************************************************************/
+Status HOSTSIM_EMACInject(const uint8_t *frame, uint32_t len)
+{
+	SIM_EMAC_T *e = &sim_emac;
+
+	if ((e->rxq_cnt == HOSTSIM_EMAC_RXQ_SIZE) || (len > EMAC_FRAME_MAX - 4))
+	{
+		return ERROR;
+	}
+	sim_lock++;
+	memcpy(e->rxq[(e->rxq_rd + e->rxq_cnt) % HOSTSIM_EMAC_RXQ_SIZE], frame, len);
+	e->rxq_len[(e->rxq_rd + e->rxq_cnt) % HOSTSIM_EMAC_RXQ_SIZE] = len;
+	if ((e->rxq_cnt++ == 0) && (e->rx_next < sim_now))
+	{
+		e->rx_next = sim_now;
+	}
+	emac_sched(e);
+	sim_lock--;
+	return SUCCESS;
+}
+
+/*********************************************************************//**
+ * @brief 		Install the callback receiving frames sent by the EMAC
+ * @param[in]	sink	Callback, NULL to discard
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_EMACSetSink(HOSTSIM_EMAC_SINK_Type sink)
+{
+	sim_emac.sink = sink;
+}
+
+/*********************************************************************//**
+ * @brief 		Change the PHY link state
+ * @param[in]	up		TRUE for link up
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_EMACSetLink(Bool up)
+{
+	sim_emac.phy[1] = up ? 0x786D : 0x7849;
+}
+
+/*********************************************************************//**
+ * @brief 		Feed the frames of a pcap file to the EMAC
+ * @param[in]	path	Classic pcap file (Ethernet link type, micro or
+ * 						nano second stamps, either byte order), frames
+ * 						without FCS
+ * @param[in]	poll	Firmware receive loop, called after every frame
+ * 						and while the host queue is full. NULL lets the
+ * 						virtual clock run instead
+ * @return 		Number of frames injected, -1 if the file is unreadable
+ *
+ * Note: Frames are sent back to back at wire speed, the stamps in the
+ * file are not replayed. Returns once the host queue is empty.
+ **********************************************************************/
+int32_t HOSTSIM_EMACReplayPcap(const char *path, HOSTSIM_POLL_Type poll)
+{
+	uint8_t frame[EMAC_FRAME_MAX];
+	uint32_t hdr[6], rec[4], len;
+	Bool swap;
+	int32_t n = 0;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+	{
+		return -1;
+	}
+	if (read(fd, hdr, sizeof(hdr)) != sizeof(hdr))
+	{
+		close(fd);
+		return -1;
+	}
+	swap = ((hdr[0] == 0xD4C3B2A1) || (hdr[0] == 0x4D3CB2A1)) ? TRUE : FALSE;
+	if ((!swap && (hdr[0] != 0xA1B2C3D4) && (hdr[0] != 0xA1B23C4D)) ||
+		((swap ? __builtin_bswap32(hdr[5]) : hdr[5]) != 1))
+	{
+		close(fd);
+		return -1;
+	}
+
+	while (read(fd, rec, sizeof(rec)) == sizeof(rec))
+	{
+		len = swap ? __builtin_bswap32(rec[2]) : rec[2];
+		if (len > sizeof(frame))
+		{
+			break;
+		}
+		if (read(fd, frame, len) != (ssize_t)len)
+		{
+			break;
+		}
+		if ((len < 14) || (len > EMAC_FRAME_MAX - 4))
+		{
+			continue;
+		}
+		while (HOSTSIM_EMACInject(frame, len) == ERROR)
+		{
+			poll ? poll() : HOSTSIM_Advance(emac_wire(len));
+		}
+		n++;
+		if (poll)
+		{
+			poll();
+		}
+	}
+	close(fd);
+
+	while (sim_emac.rxq_cnt)
+	{
+		poll ? poll() : HOSTSIM_Advance(emac_wire(EMAC_FRAME_MAX));
+	}
+	if (poll)
+	{
+		poll();
+	}
+	return n;
+}
+
+/*********************************************************************//**
+ * @brief 		Write every frame sent by the EMAC to a pcap file
+ * @param[in]	path	File to create, NULL to stop capturing
+ * @return 		SUCCESS or ERROR when the file cannot be created
+ **********************************************************************/
+Status HOSTSIM_EMACCapturePcap(const char *path)
+{
+	/* magic, version 2.4, zone, accuracy, snap length, Ethernet */
+	static const uint32_t hdr[6] = {0xA1B2C3D4, 0x00040002, 0, 0, EMAC_FRAME_MAX, 1};
+	SIM_EMAC_T *e = &sim_emac;
+
+	if (e->cap_open)
+	{
+		close(e->cap_fd);
+		e->cap_open = FALSE;
+	}
+	if (path == NULL)
+	{
+		return SUCCESS;
+	}
+	e->cap_fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (e->cap_fd < 0)
+	{
+		return ERROR;
+	}
+	if (write(e->cap_fd, hdr, sizeof(hdr)) != sizeof(hdr))
+	{
+		close(e->cap_fd);
+		return ERROR;
+	}
+	e->cap_open = TRUE;
+	return SUCCESS;
+}
+
+/*********************************************************************//**
+ * @brief 		Put a CAN frame on the bus of a controller
+ * @param[in]	ctrl	0 for CAN1, 1 for CAN2
+ * @param[in]	frame	Frame
+ * @return 		SUCCESS or ERROR when the host queue is full
+ **********************************************************************/
+Status HOSTSIM_CANInject(uint8_t ctrl, const HOSTSIM_CAN_FRAME_Type *frame)
+{
+	SIM_CAN_T *c = &sim_can[ctrl & 0x01];
+
+	if (c->in_cnt == HOSTSIM_CAN_RXQ_SIZE)
+	{
+		return ERROR;
+	}
+	sim_lock++;
+	c->inq[(c->in_rd + c->in_cnt) % HOSTSIM_CAN_RXQ_SIZE] = *frame;
+	if (c->in_cnt++ == 0)
+	{
+		c->rx_next = sim_now + can_frame(c, frame);
+	}
+	can_sched(c);
+	sim_lock--;
+	return SUCCESS;
+}
+
+/*********************************************************************//**
+ * @brief 		Install the callback receiving frames sent by CAN1/CAN2
+ * @param[in]	sink	Callback, NULL to discard
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_CANSetSink(HOSTSIM_CAN_SINK_Type sink)
+{
+	sim_can_sink = sink;
+}
+
+/*********************************************************************//**
+ * @brief 		Connect CAN1 and CAN2 to the same bus
+ * @param[in]	join	TRUE to connect
+ * @return 		None
+ **********************************************************************/
+void HOSTSIM_CANJoinBuses(Bool join)
+{
+	sim_can_joined = join;
+}
+
+/**
+ * @}
+ */
+
+#endif /* LPC_HOST_SIM */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
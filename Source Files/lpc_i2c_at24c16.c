@@ -20,6 +20,8 @@
  * otherwise the default FW library configuration file must be included instead
  */
 
+/* Public Variables ----------------------------------------------------------- */
+EEPW_DEV_Type E2P24C16_Dev = EEPW_I2C_DEVICE(LPC_I2C0, E2P24C16_ID, 1, E2P24C16_PAGE, E2P24C16_SIZE);
 
 
 /** @addtogroup EEPROM_Public_Functions
@@ -36,25 +38,7 @@
  **********************************************************************/
 char I2C_Eeprom_Write_Byte (uint16 eep_address, uint8_t byte_data)
 {
-	/* Transmit setup */
-	I2C_M_SETUP_Type txsetup;
-	uint8_t set_addr;
-
-	set_addr =(eep_address & 0x7FF) >> 8;
- //   printf(LPC_UART0,"%x02",set_addr);
-
-    I2C_Tx_Buf[0] = (uchar)(eep_address & 0xFF);    // 2st byte extract
-    I2C_Tx_Buf[1] = byte_data;
-
-	txsetup.sl_addr7bit = E2P24C16_ID|set_addr;
-	txsetup.tx_data = I2C_Tx_Buf;
-	txsetup.tx_length = 2;
-	txsetup.rx_data = NULL;
-	txsetup.rx_length = 0;
-	txsetup.retransmissions_max = 3;
-
-	/* write byte to addr  */
-	if(I2C_MasterTransferData(LPC_I2C0, &txsetup, I2C_TRANSFER_POLLING)==SUCCESS) //return status
+	if(EEPW_Write(&E2P24C16_Dev, eep_address, &byte_data, 1, FALSE)==SUCCESS) //return status
 	{
 		return (0);
 	}
@@ -73,67 +57,14 @@ char I2C_Eeprom_Write_Byte (uint16 eep_address, uint8_t byte_data)
  **********************************************************************/
 char I2C_Eeprom_Write (uint16_t eep_address, uint8_t* byte_data, uint16_t length)
 {
-	/* Transmit setup */
-	I2C_M_SETUP_Type txsetup;
-	uint16_t ip_len,new_length,i;
-	uint16 new_address;
-	uint8_t set_addr;
-
-	/* Intern page length(ip_len) gives length from address that can be occupied in page */
-	ip_len = 0x10 - (eep_address % 0x10);
-	new_address = eep_address + ip_len;
-
-	set_addr =(eep_address & 0x7FF) >> 8;
-//    printf(LPC_UART0,"%x02",set_addr);
-
-    I2C_Tx_Buf[0] = (uchar)(eep_address & 0xFF);    // 2st byte extract
-
-	if(length > ip_len)
+	/* Page by page, each as soon as the part acknowledges again */
+	if(EEPW_Write(&E2P24C16_Dev, eep_address, byte_data, length, FALSE)==SUCCESS) //return status
 	{
-		new_length = length - ip_len;
-
-		for(i=1;i<(ip_len+1);i++)
-		{
-			I2C_Tx_Buf[i]=*byte_data++;
-		}
-		txsetup.sl_addr7bit = E2P24C16_ID|set_addr;
-		txsetup.tx_data = I2C_Tx_Buf;
-		txsetup.tx_length = ip_len+1;
-		txsetup.rx_data = NULL;
-		txsetup.rx_length = 0;
-		txsetup.retransmissions_max = 50;
-
-		if(I2C_MasterTransferData(LPC_I2C0, &txsetup, I2C_TRANSFER_POLLING)==ERROR) //return status
-		{
-			return (-1);
-		}
-
-		// Recursive function
-		delay_ms(5);
-		I2C_Eeprom_Write(new_address,byte_data,new_length);
+		return (0);
 	}
-
-	if(length <= ip_len)
+	else
 	{
-		for(i=1;i<(length+1);i++)
-		{
-			I2C_Tx_Buf[i]=*byte_data++;
-		}
-		txsetup.sl_addr7bit = E2P24C16_ID|set_addr;
-		txsetup.tx_data = I2C_Tx_Buf;
-		txsetup.tx_length = length+1;
-		txsetup.rx_data = NULL;
-		txsetup.rx_length = 0;
-		txsetup.retransmissions_max = 50;
-
-		if(I2C_MasterTransferData(LPC_I2C0, &txsetup, I2C_TRANSFER_POLLING)==SUCCESS) //return status
-		{
-			return (0);
-		}
-		else
-		{
-			return (-1);
-		}
+		return (-1);
 	}
 }
 
@@ -259,7 +190,7 @@ void Display_Eeprom_Loc (uint16 mem_start_address, uint16 mem_end_address)
 		{
 			printf(LPC_UART0,"\x1b[24;01HPress any key to continue.");
 			line = 0;
-			getche(LPC_UART0);
+			getche(LPC_UART0, BLOCKING);
 
 			clr_scr_rst_cur(LPC_UART0);
 		}
@@ -20,6 +20,8 @@
  * otherwise the default FW library configuration file must be included instead
  */
 
+/* Public Variables ----------------------------------------------------------- */
+EEPW_DEV_Type E2PM24256_Dev = EEPW_I2C_DEVICE(LPC_I2C0, E2PM24256_ID, 2, E2PM24256_PAGE, E2PM24256_SIZE);
 
 
 /** @addtogroup EEPROM_Public_Functions
@@ -36,24 +38,7 @@
  **********************************************************************/
 char I2C_IEeprom_Write_Byte (uint16_t eep_address, uint8_t byte_data)
 {
-	/* Transmit setup */
-	I2C_M_SETUP_Type txsetup;
-
-	I2C_Tx_Buf[0] =(eep_address & 0x8FFF) >> 8;     // 1st byte extract
- //   printf(LPC_UART0,"%x02",set_addr);
-
-    I2C_Tx_Buf[1] = (uchar)(eep_address & 0xFF);    // 2st byte extract
-    I2C_Tx_Buf[2] = byte_data;
-
-	txsetup.sl_addr7bit = E2PM24256_ID;
-	txsetup.tx_data = I2C_Tx_Buf;
-	txsetup.tx_length = 3;
-	txsetup.rx_data = NULL;
-	txsetup.rx_length = 0;
-	txsetup.retransmissions_max = 50;
-
-	/* write byte to addr  */
-	if(I2C_MasterTransferData(LPC_I2C0, &txsetup, I2C_TRANSFER_POLLING)==SUCCESS) //return status
+	if(EEPW_Write(&E2PM24256_Dev, eep_address, &byte_data, 1, FALSE)==SUCCESS) //return status
 	{
 		return (0);
 	}
@@ -72,66 +57,14 @@ char I2C_IEeprom_Write_Byte (uint16_t eep_address, uint8_t byte_data)
  **********************************************************************/
 char I2C_IEeprom_Write (uint16_t eep_address, uint8_t* byte_data, uint16_t length)
 {
-	/* Transmit setup */
-	I2C_M_SETUP_Type txsetup;
-	uint16_t ip_len,new_length,i;
-	uint16_t new_address;
-
-	/* Intern page length(ip_len) gives length from address that can be occupied in page */
-	ip_len = 0x40 - (eep_address % 0x40);
-	new_address = eep_address + ip_len;
-
-	I2C_Tx_Buf[0] =(eep_address & 0x8FFF) >> 8;     // 1st byte extract
-  //  printf(LPC_UART0,"%x02",I2C_Tx_Buf[0]);
-
-    I2C_Tx_Buf[1] = (uchar)(eep_address & 0xFF);    // 2st byte extract
-
-	if(length > ip_len)
+	/* Page by page, each as soon as the part acknowledges again */
+	if(EEPW_Write(&E2PM24256_Dev, eep_address, byte_data, length, FALSE)==SUCCESS) //return status
 	{
-		new_length = length - ip_len;
-
-		for(i=2;i<(ip_len+2);i++)
-		{
-			I2C_Tx_Buf[i]=*byte_data++;
-		}
-		txsetup.sl_addr7bit = E2PM24256_ID;
-		txsetup.tx_data = I2C_Tx_Buf;
-		txsetup.tx_length = ip_len+2;
-		txsetup.rx_data = NULL;
-		txsetup.rx_length = 0;
-		txsetup.retransmissions_max = 50;
-
-		if(I2C_MasterTransferData(LPC_I2C0, &txsetup, I2C_TRANSFER_POLLING)==ERROR) //return status
-		{
-			return (-1);
-		}
-
-		// Recursive function
-		delay_ms(5);
-		I2C_IEeprom_Write(new_address,byte_data,new_length);
+		return (0);
 	}
-
-	if(length <= ip_len)
+	else
 	{
-		for(i=2;i<(length+2);i++)
-		{
-			I2C_Tx_Buf[i]=*byte_data++;
-		}
-		txsetup.sl_addr7bit = E2PM24256_ID;
-		txsetup.tx_data = I2C_Tx_Buf;
-		txsetup.tx_length = length+2;
-		txsetup.rx_data = NULL;
-		txsetup.rx_length = 0;
-		txsetup.retransmissions_max = 50;
-
-		if(I2C_MasterTransferData(LPC_I2C0, &txsetup, I2C_TRANSFER_POLLING)==SUCCESS) //return status
-		{
-			return (0);
-		}
-		else
-		{
-			return (-1);
-		}
+		return (-1);
 	}
 }
 
@@ -254,7 +187,7 @@ void Display_IEeprom_Loc (uint16_t mem_start_address, uint16_t mem_end_address)
 		{
 			printf(LPC_UART0,"\x1b[24;01HPress any key to continue.");
 			line = 0;
-			getche(LPC_UART0);
+			getche(LPC_UART0, BLOCKING);
 
 			clr_scr_rst_cur(LPC_UART0);
 		}
@@ -20,6 +20,35 @@
  * otherwise the default FW library configuration file must be included instead
  */
 
+/* Private Variables ---------------------------------------------------------- */
+/* Queued temperature read, see TMP102_Read_Temp_Async() */
+static I2C_XFER_Type tmp102_xfer;
+static uint8_t tmp102_reg = TMP_REG;
+static uint8_t tmp102_buf[2];
+static BIT_Type tmp102_res;
+static TMP102_CB_Type tmp102_cb;
+
+/* Private Functions ---------------------------------------------------------- */
+/*********************************************************************//**
+ * @brief	    Completion of the queued temperature read
+ * @param[in]	xfer   finished transaction
+ * @return 		None
+ **********************************************************************/
+static void tmp102_done(I2C_XFER_Type *xfer)
+{
+	int16_t val;
+
+	if (xfer->state != I2C_XFER_DONE)
+	{
+		tmp102_cb(ERROR, 0);
+		return;
+	}
+	/* Left aligned two's complement, 12 or 13 bit */
+	val = (int16_t)((tmp102_buf[0] << 8) | tmp102_buf[1]);
+	val = (tmp102_res == TMP102_13B) ? (val >> 3) : (val >> 4);
+	tmp102_cb(SUCCESS, val);
+}
+
 /** @addtogroup TMP_Public_Functions
  * @{
  */
@@ -311,6 +340,35 @@ uchar TMP102_Read_Temp(BIT_Type res)
 }
 
 
+/*********************************************************************//**
+ * @brief	    Starts a temperature read on the I2C0 transaction queue,
+ *              the CPU is free until the callback
+ * @param[in]	res  -TMP102_12B
+ *                   -TMP102_13B
+ * @param[in]	cb   called from the I2C interrupt with the result
+ * @return 		SUCCESS, or ERROR if the last read is still queued
+ **********************************************************************/
+Status TMP102_Read_Temp_Async(BIT_Type res, TMP102_CB_Type cb)
+{
+	if ((tmp102_xfer.state == I2C_XFER_QUEUED) || (tmp102_xfer.state == I2C_XFER_BUSY))
+	{
+		return ERROR;
+	}
+	tmp102_res = res;
+	tmp102_cb = cb;
+
+	tmp102_xfer.sl_addr7bit = TMP102_ID;
+	tmp102_xfer.priority = I2C_PRIO_LOW;
+	tmp102_xfer.retries = 3;
+	tmp102_xfer.restart = TRUE;
+	tmp102_xfer.tx_data = &tmp102_reg;
+	tmp102_xfer.tx_length = 1;
+	tmp102_xfer.rx_data = tmp102_buf;
+	tmp102_xfer.rx_length = 2;
+	tmp102_xfer.callback = tmp102_done;
+	return I2C_QueueSubmit(LPC_I2C0, &tmp102_xfer);
+}
+
 /**
  * @}
  */
@@ -27,6 +27,38 @@
 
 
 
+/* Private Variables ---------------------------------------------------------- */
+/* Queued X, Y, Z1, Z2 reads, see TSC2004_Read_Values_Async() */
+static I2C_XFER_Type tsc_xfer[4];
+static uint8_t tsc_cmd[4];
+static uint8_t tsc_buf[4][2];
+static Status tsc_st;
+static ts_event *tsc_tc;
+static TSC2004_CB_Type tsc_cb;
+
+/* Private Functions ---------------------------------------------------------- */
+/*********************************************************************//**
+ * @brief	    Completion of one queued register read, the Z2 read is
+ *              queued last and reports the whole set
+ * @param[in]	xfer   finished transaction
+ * @return 		None
+ **********************************************************************/
+static void tsc_done(I2C_XFER_Type *xfer)
+{
+	if (xfer->state != I2C_XFER_DONE)
+	{
+		tsc_st = ERROR;
+	}
+	if (xfer == &tsc_xfer[3])
+	{
+		tsc_tc->x  = ((tsc_buf[0][0] << 8) | tsc_buf[0][1]) & MEAS_MASK;
+		tsc_tc->y  = ((tsc_buf[1][0] << 8) | tsc_buf[1][1]) & MEAS_MASK;
+		tsc_tc->z1 = ((tsc_buf[2][0] << 8) | tsc_buf[2][1]) & MEAS_MASK;
+		tsc_tc->z2 = ((tsc_buf[3][0] << 8) | tsc_buf[3][1]) & MEAS_MASK;
+		tsc_cb(tsc_st, tsc_tc);
+	}
+}
+
 /** @addtogroup TSC2004_Public_Functions
  * @{
  */
@@ -237,6 +269,42 @@ void TSC2004_Read_Values (ts_event *tc)
 }
 
 
+/*********************************************************************//**
+ * @brief	    Queue X,Y,Z1,Z2 reads at high priority on I2C0, the CPU
+ *              is free until the callback. TSC2004_Init() must have run.
+ * @param[in]	*tc    filled in before the callback
+ * @param[in]	cb     called from the I2C interrupt when all four are read
+ * @return 		SUCCESS, or ERROR if the last set is still queued
+ **********************************************************************/
+Status TSC2004_Read_Values_Async (ts_event *tc, TSC2004_CB_Type cb)
+{
+	uint8_t i;
+
+	if ((tsc_xfer[3].state == I2C_XFER_QUEUED) || (tsc_xfer[3].state == I2C_XFER_BUSY))
+	{
+		return ERROR;
+	}
+	tsc_st = SUCCESS;
+	tsc_tc = tc;
+	tsc_cb = cb;
+	for (i = 0; i < 4; i++)
+	{
+		tsc_cmd[i] = TSC2004_CMD0(X_REG + i, PND0_FALSE, READ_REG);
+		tsc_xfer[i].sl_addr7bit = TSC2004_ID;
+		tsc_xfer[i].priority = I2C_PRIO_HIGH;
+		tsc_xfer[i].retries = 3;
+		tsc_xfer[i].restart = TRUE;
+		tsc_xfer[i].tx_data = &tsc_cmd[i];
+		tsc_xfer[i].tx_length = 1;
+		tsc_xfer[i].rx_data = tsc_buf[i];
+		tsc_xfer[i].rx_length = 2;
+		tsc_xfer[i].callback = tsc_done;
+		/* Same priority is FIFO, Z2 completes last */
+		I2C_QueueSubmit(LPC_I2C0, &tsc_xfer[i]);
+	}
+	return SUCCESS;
+}
+
 /*********************************************************************//**
  * @brief	    Read X,Y,Z1,Z2 Values and Display on Terminal
  * @param[in]	None
@@ -0,0 +1,370 @@
+/******************************************************************//**
+* @file		lpc_input.c
+* @brief	Contains all functions support for the key input subsystem
+* 			on LPC17xx
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @addtogroup INPUT
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc_system_init.h"
+#include "lpc_input.h"
+
+/* If this source file built with example, the LPC17xx FW library configuration
+ * file in each example directory ("lpc17xx_libcfg.h") must be included,
+ * otherwise the default FW library configuration file must be included instead
+ */
+
+/* Private Macros ------------------------------------------------------------- */
+/** @defgroup INPUT_Private_Macros INPUT Private Macros
+ * @{
+ */
+
+#define INPUT_QUEUE_MASK		(INPUT_QUEUE_SIZE - 1)
+/** Repeat timing in scans */
+#define INPUT_REPEAT_DELAY		(INPUT_REPEAT_DELAY_MS / INPUT_SCAN_MS)
+#define INPUT_REPEAT			(INPUT_REPEAT_MS / INPUT_SCAN_MS)
+/** No key repeating */
+#define INPUT_KEY_NONE			0xFF
+
+/**
+ * @}
+ */
+
+
+/* Private Variables ---------------------------------------------------------- */
+/** Attached sources and their key count */
+static INPUT_SRC_Type *input_src;
+static uint8_t input_keys;
+/** Wake-up pins of ports 0 and 2 */
+static uint32_t input_wake[2];
+
+/** Debounced key state and the two bits of each key's vertical counter */
+static uint64_t input_state;
+static uint64_t input_cnt0, input_cnt1;
+
+/** Key that repeats and scans until its next repeat */
+static uint8_t input_rep_key = INPUT_KEY_NONE;
+static uint16_t input_rep_left;
+
+/** Event queue, written from SysTick_Handler, read in thread mode */
+static INPUT_EVENT_Type input_queue[INPUT_QUEUE_SIZE];
+static __IO uint32_t input_head, input_tail;
+
+static SCHED_TIMER_Type input_timer;
+static SCHED_TASK_Type *input_task;
+static INPUT_STATS_Type input_stats;
+
+
+/* Private Functions ---------------------------------------------------------- */
+static void input_put (uint8_t key, uint8_t type);
+static void input_events (uint64_t keys, uint8_t type);
+static Bool input_arm (void);
+static void input_scan (SCHED_TIMER_Type *tmr);
+
+/*********************************************************************//**
+ * @brief		Queue one event
+ * @param[in]	key: key number
+ * @param[in]	type: INPUT_EV_xxx
+ * @return 		None
+ **********************************************************************/
+static void input_put (uint8_t key, uint8_t type)
+{
+	uint32_t head = input_head;
+
+	if (((head + 1) & INPUT_QUEUE_MASK) == input_tail)
+	{
+		input_stats.Dropped++;
+		return;
+	}
+	input_queue[head].Key = key;
+	input_queue[head].Type = type;
+	input_head = (head + 1) & INPUT_QUEUE_MASK;
+	input_stats.Events++;
+}
+
+
+/*********************************************************************//**
+ * @brief		Queue one event for each key of a set
+ * @param[in]	keys: keys, bit n is key n
+ * @param[in]	type: INPUT_EV_DOWN or INPUT_EV_UP
+ * @return 		None
+ **********************************************************************/
+static void input_events (uint64_t keys, uint8_t type)
+{
+	uint8_t key;
+
+	for (key = 0; keys != 0; key++, keys >>= 1)
+	{
+		if ((keys & 1) == 0)
+		{
+			continue;
+		}
+		input_put(key, type);
+		if (type == INPUT_EV_DOWN)
+		{
+			input_rep_key = key;
+			input_rep_left = INPUT_REPEAT_DELAY;
+		}
+		else if (key == input_rep_key)
+		{
+			input_rep_key = INPUT_KEY_NONE;
+		}
+	}
+}
+
+
+/*********************************************************************//**
+ * @brief		Put the sources in their idle state and enable the
+ * 				falling edge interrupts of the wake-up pins
+ * @param[in]	None
+ * @return 		TRUE if a wake-up pin is low already, so a key went down
+ * 				before the interrupts were on
+ **********************************************************************/
+static Bool input_arm (void)
+{
+	INPUT_SRC_Type *src;
+
+	for (src = input_src; src != NULL; src = src->Next)
+	{
+		if (src->Idle != NULL)
+		{
+			src->Idle();
+		}
+	}
+	LPC_GPIOINT->IO0IntClr = input_wake[0];
+	LPC_GPIOINT->IO2IntClr = input_wake[1];
+	LPC_GPIOINT->IO0IntEnF |= input_wake[0];
+	LPC_GPIOINT->IO2IntEnF |= input_wake[1];
+
+	return (((LPC_GPIO0->FIOPIN & input_wake[0]) != input_wake[0]) ||
+			((LPC_GPIO2->FIOPIN & input_wake[1]) != input_wake[1])) ? TRUE : FALSE;
+}
+
+
+/*********************************************************************//**
+ * @brief		Scan timer callback: read all sources, debounce every key
+ * 				at once and queue the changes. Stops itself once all keys
+ * 				are up and stable, the edge interrupts take over.
+ * @param[in]	tmr: scan timer
+ * @return 		None
+ **********************************************************************/
+static void input_scan (SCHED_TIMER_Type *tmr)
+{
+	INPUT_SRC_Type *src;
+	uint64_t raw, delta, flip;
+	uint32_t head = input_head;
+
+	raw = 0;
+	for (src = input_src; src != NULL; src = src->Next)
+	{
+		raw |= src->Scan() << src->Base;
+	}
+	input_stats.Scans++;
+
+	// Integrate: a 2 bit counter per key counts the scans that disagree
+	// with its state and is cleared by one that agrees. Dump: the key
+	// flips when the counter wraps after 4.
+	delta = raw ^ input_state;
+	input_cnt1 = (input_cnt1 ^ input_cnt0) & delta;
+	input_cnt0 = ~input_cnt0 & delta;
+	flip = delta & ~(input_cnt0 | input_cnt1);
+	if (flip != 0)
+	{
+		input_state ^= flip;
+		input_events(flip & ~input_state, INPUT_EV_UP);
+		input_events(flip & input_state, INPUT_EV_DOWN);
+	}
+	else if ((input_rep_key != INPUT_KEY_NONE) && (--input_rep_left == 0))
+	{
+		input_put(input_rep_key, INPUT_EV_REPEAT);
+		input_rep_left = INPUT_REPEAT;
+	}
+
+	if ((input_task != NULL) && (input_head != head))
+	{
+		SCHED_Post(input_task);
+	}
+
+	if ((input_state | input_cnt0 | input_cnt1) == 0)
+	{
+		if (input_arm() == FALSE)
+		{
+			SCHED_TimerStop(tmr);
+		}
+	}
+}
+
+/* End of Private Functions --------------------------------------------------- */
+
+
+/** @addtogroup INPUT_Public_Functions
+ * @{
+ */
+
+/* Public Functions ----------------------------------------------------------- */
+/*********************************************************************//**
+ * @brief		Initialize the input subsystem. Sources are added with
+ * 				INPUT_Attach() afterwards.
+ * @param[in]	task: posted whenever events are queued, NULL to poll
+ * 				with INPUT_GetEvent()
+ * @return 		None
+ **********************************************************************/
+void INPUT_Init (SCHED_TASK_Type *task)
+{
+	SCHED_TimerStop(&input_timer);
+	SCHED_TimerInit(&input_timer, input_scan, NULL);
+	input_task = task;
+	input_src = NULL;
+	input_keys = 0;
+	input_wake[0] = 0;
+	input_wake[1] = 0;
+	input_state = 0;
+	input_cnt0 = 0;
+	input_cnt1 = 0;
+	input_rep_key = INPUT_KEY_NONE;
+	input_head = 0;
+	input_tail = 0;
+
+	GPIO_SetIntCallback(INPUT_IntHandler);
+	NVIC_EnableIRQ(EINT3_IRQn);
+}
+
+
+/*********************************************************************//**
+ * @brief		Add a key source. Its keys are numbered from the keys of
+ * 				the sources attached before it on.
+ * @param[in]	src: source, Keys, Port, WakePins and Scan filled in
+ * @return 		SUCCESS, or ERROR if the keys do not fit
+ **********************************************************************/
+Status INPUT_Attach (INPUT_SRC_Type *src)
+{
+	uint32_t primask;
+
+	if ((src->Keys == 0) || (input_keys + src->Keys > INPUT_KEYS_MAX) ||
+		((src->Port != 0) && (src->Port != 2)))
+	{
+		return ERROR;
+	}
+	src->Base = input_keys;
+	input_keys += src->Keys;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	src->Next = input_src;
+	input_src = src;
+	input_wake[src->Port >> 1] |= src->WakePins;
+	// Scan once, keys held at start up are picked up and the scanner
+	// stops by itself otherwise
+	SCHED_TimerStart(&input_timer, 1, INPUT_SCAN_MS);
+	__set_PRIMASK(primask);
+
+	return SUCCESS;
+}
+
+
+/*********************************************************************//**
+ * @brief		Take the oldest key event
+ * @param[out]	ev: event
+ * @return 		SUCCESS, or ERROR if the queue is empty
+ **********************************************************************/
+Status INPUT_GetEvent (INPUT_EVENT_Type *ev)
+{
+	uint32_t tail = input_tail;
+
+	if (tail == input_head)
+	{
+		return ERROR;
+	}
+	*ev = input_queue[tail];
+	input_tail = (tail + 1) & INPUT_QUEUE_MASK;
+	return SUCCESS;
+}
+
+
+/*********************************************************************//**
+ * @brief		Debounced state of one key
+ * @param[in]	key: key number
+ * @return 		TRUE while the key is down
+ **********************************************************************/
+Bool INPUT_KeyDown (uint8_t key)
+{
+	if (key >= INPUT_KEYS_MAX)
+	{
+		return FALSE;
+	}
+	return ((input_state >> key) & 1) ? TRUE : FALSE;
+}
+
+
+/*********************************************************************//**
+ * @brief		Debounced state of all keys
+ * @param[in]	None
+ * @return 		Keys down, bit n is key n
+ **********************************************************************/
+uint64_t INPUT_GetKeys (void)
+{
+	uint64_t keys;
+	uint32_t primask;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	keys = input_state;
+	__set_PRIMASK(primask);
+	return keys;
+}
+
+
+/*********************************************************************//**
+ * @brief		Wake-up on a falling edge of a key pin, the GPIO interrupt
+ * 				callback set by INPUT_Init(). Turns the edge interrupts
+ * 				off and starts the scanner.
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void INPUT_IntHandler (void)
+{
+	uint32_t p0, p2;
+
+	p0 = LPC_GPIOINT->IO0IntStatF & input_wake[0];
+	p2 = LPC_GPIOINT->IO2IntStatF & input_wake[1];
+	if ((p0 | p2) == 0)
+	{
+		return;
+	}
+	LPC_GPIOINT->IO0IntEnF &= ~input_wake[0];
+	LPC_GPIOINT->IO2IntEnF &= ~input_wake[1];
+	LPC_GPIOINT->IO0IntClr = p0;
+	LPC_GPIOINT->IO2IntClr = p2;
+	input_stats.Wakeups++;
+	SCHED_TimerStart(&input_timer, 1, INPUT_SCAN_MS);
+}
+
+
+/*********************************************************************//**
+ * @brief		Get the input counters
+ * @param[out]	stats: pointer to INPUT_STATS_Type
+ * @return 		None
+ **********************************************************************/
+void INPUT_GetStats (INPUT_STATS_Type *stats)
+{
+	*stats = input_stats;
+}
+
+/**
+ * @}
+ */
+
+/* End of Public Functions ---------------------------------------------------- */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -15,12 +15,299 @@
 /* Includes ------------------------------------------------------------------- */
 #include "lpc_system_init.h"
 #include "lpc_lcd.h"
+#include <string.h>
 
 /* If this source file built with example, the LPC17xx FW library configuration
  * file in each example directory ("lpc17xx_libcfg.h") must be included,
  * otherwise the default FW library configuration file must be included instead
  */
 
+/* Private Macros ------------------------------------------------------------- */
+#define		LCD_PIN_RS			_BIT(11)		// P2.11
+#define		LCD_PIN_RW			_BIT(12)		// P2.12
+#define		LCD_PIN_EN			_BIT(13)		// P2.13
+
+#define		LCD_DATA_SHIFT		(18 + LCD_DATA_START_PIN)	// First data line on port 1
+#ifdef LCD_4BIT
+	#define	LCD_DATA_PINS		(0x0FUL << LCD_DATA_SHIFT)	// D4..D7
+	#define	LCD_BF_PIN			(0x08UL << LCD_DATA_SHIFT)	// D7
+#endif
+#ifdef LCD_8BIT
+	#define	LCD_DATA_PINS		(0xFFUL << LCD_DATA_SHIFT)	// D0..D7
+	#define	LCD_BF_PIN			(0x80UL << LCD_DATA_SHIFT)	// D7
+#endif
+
+#define		LCD_SPIN_US			25			// Spin loop turns per us at 100 MHz
+#define		LCD_EXEC_US			40			// Instruction time when the busy flag is not read
+#define		LCD_EXEC_SLOW_US	1600		// LCD_CLEAR and CURSOR_HOME
+#define		LCD_BUSY_POLLS		2000		// Busy flag reads before giving up, > 1.6 ms
+#define		LCD_ADDR_NONE		0xFF		// Address counter unknown or in CGRAM
+#define		LCD_GAP_MAX			1			// Unchanged cells written through rather
+											// than skipped with an address command
+
+/* Private Variables ---------------------------------------------------------- */
+/** Wanted and displayed DDRAM contents */
+static uchar lcd_shadow[ROWSIZE][COLUMNSIZE];
+static uchar lcd_ddram[ROWSIZE][COLUMNSIZE];
+/** Rows where lcd_shadow may differ from lcd_ddram, one bit per row */
+static uint8_t lcd_dirty;
+/** DDRAM address of each row */
+static const uchar lcd_row_addr[4] = {ROWADDR1 & 0x7F, ROWADDR2 & 0x7F, ROWADDR3 & 0x7F, ROWADDR4 & 0x7F};
+/** Rows in DDRAM address order, line 3 continues line 1 on 4 line displays */
+#if (ROWSIZE == 4)
+static const uint8_t lcd_row_order[4] = {0, 2, 1, 3};
+#else
+static const uint8_t lcd_row_order[4] = {0, 1, 2, 3};
+#endif
+
+/** LCD address counter and its step after each data write */
+static uint8_t lcd_addr = LCD_ADDR_NONE;
+static int8_t lcd_step = 1;
+/** Cursor: position in the shadow, wanted and displayed type */
+static uchar lcd_row, lcd_col;
+static CursorType_e lcd_cursor, lcd_shown;
+static Bool lcd_cursor_dirty;
+
+/** Busy flag answers, last instruction was a slow one */
+static Bool lcd_bf_ok;
+static Bool lcd_slow;
+static Bool lcd_ready;
+static LCD_STATS_Type lcd_stats;
+
+/** Flush timer and task */
+static SCHED_TIMER_Type lcd_timer;
+static SCHED_TASK_Type lcd_task;
+
+
+/* Private Functions ---------------------------------------------------------- */
+static void lcd_spin (uint32_t us);
+static void lcd_put (uint32_t bits);
+static void lcd_write (uchar val, uint32_t rs);
+static void lcd_track (uchar Command);
+static void lcd_cell (uchar Character);
+static void lcd_move (uint8_t addr);
+static Bool lcd_goto (uchar LineNum, uchar Position, CursorType_e CursorType);
+static void lcd_flush_timer (SCHED_TIMER_Type *tmr);
+static void lcd_flush_task (SCHED_TASK_Type *task);
+
+/*********************************************************************//**
+ * @brief	    Busy wait
+ * @param[in]	us		microseconds
+ * @return 		None
+ **********************************************************************/
+static void lcd_spin (uint32_t us)
+{
+	volatile uint32_t n = us * LCD_SPIN_US;
+
+	while (n)
+	{
+		n--;
+	}
+}
+
+
+/*********************************************************************//**
+ * @brief	    Drive the data lines with one masked FIOPIN write, other
+ * 				pins of port 1 keep their level
+ * @param[in]	bits	byte, or nibble in 4 bit mode
+ * @return 		None
+ **********************************************************************/
+static void lcd_put (uint32_t bits)
+{
+	uint32_t primask, mask;
+
+	// FIOMASK is shared with the rest of port 1
+	primask = __get_PRIMASK();
+	__disable_irq();
+	mask = LPC_GPIO1->FIOMASK;
+	LPC_GPIO1->FIOMASK = (uint32_t)~LCD_DATA_PINS;
+	LPC_GPIO1->FIOPIN = bits << LCD_DATA_SHIFT;
+	LPC_GPIO1->FIOMASK = mask;
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief	    Send one instruction or data byte once the LCD is ready
+ * @param[in]	val		byte to send
+ * @param[in]	rs		0 for an instruction, LCD_PIN_RS for data
+ * @return 		None
+ **********************************************************************/
+static void lcd_write (uchar val, uint32_t rs)
+{
+	Check_Busy();
+	if (rs)
+	{
+		LPC_GPIO2->FIOSET = LCD_PIN_RS;
+	}
+	else
+	{
+		LPC_GPIO2->FIOCLR = LCD_PIN_RS;
+	}
+	#ifdef LCD_4BIT
+	{
+		lcd_put(val >> 4);
+		Lcd_Enable();
+		lcd_put(val & 0x0F);
+		Lcd_Enable();
+	}
+	#endif
+	#ifdef LCD_8BIT
+	{
+		lcd_put(val);
+		Lcd_Enable();
+	}
+	#endif
+	lcd_slow = ((rs == 0) && (val < 0x04)) ? TRUE : FALSE;
+}
+
+
+/*********************************************************************//**
+ * @brief	    Follow the effect of an instruction on the address
+ * 				counter, the entry mode and the cursor
+ * @param[in]	Command		instruction sent to the LCD
+ * @return 		None
+ **********************************************************************/
+static void lcd_track (uchar Command)
+{
+	if (Command & 0x80)                         // Set DDRAM address
+	{
+		lcd_addr = Command & 0x7F;
+	}
+	else if (Command & 0x40)                    // Set CGRAM address
+	{
+		lcd_addr = LCD_ADDR_NONE;
+	}
+	else if (Command & 0x20)                    // Function set
+	{
+	}
+	else if (Command & 0x10)                    // Cursor or display shift
+	{
+		if ((Command & 0x08) == 0)
+		{
+			lcd_addr = LCD_ADDR_NONE;
+		}
+	}
+	else if (Command & 0x08)                    // Display control
+	{
+		lcd_shown = (Command & 0x01) ? Blink : ((Command & 0x02) ? On : Off);
+		lcd_cursor = lcd_shown;
+	}
+	else if (Command & 0x04)                    // Entry mode
+	{
+		lcd_step = (Command & 0x02) ? 1 : -1;
+	}
+	else if (Command & 0x02)                    // Cursor home
+	{
+		lcd_addr = 0;
+	}
+	else if (Command & 0x01)                    // Clear, also sets increment
+	{
+		memset(lcd_shadow, ' ', sizeof(lcd_shadow));
+		memset(lcd_ddram, ' ', sizeof(lcd_ddram));
+		lcd_dirty = 0;
+		lcd_addr = 0;
+		lcd_step = 1;
+		lcd_row = 0;
+		lcd_col = 0;
+	}
+}
+
+
+/*********************************************************************//**
+ * @brief	    Write one character at the address counter
+ * @param[in]	Character	character to write
+ * @return 		None
+ **********************************************************************/
+static void lcd_cell (uchar Character)
+{
+	lcd_write(Character, LCD_PIN_RS);
+	lcd_stats.Cells++;
+
+	// Two line addressing: 0x00..0x27 and 0x40..0x67 follow each other
+	if (lcd_addr == LCD_ADDR_NONE)
+	{
+		return;
+	}
+	if (lcd_step > 0)
+	{
+		lcd_addr = (lcd_addr == 0x27) ? 0x40 : ((lcd_addr == 0x67) ? 0x00 : lcd_addr + 1);
+	}
+	else
+	{
+		lcd_addr = (lcd_addr == 0x40) ? 0x27 : ((lcd_addr == 0x00) ? 0x67 : lcd_addr - 1);
+	}
+}
+
+
+/*********************************************************************//**
+ * @brief	    Set the address counter unless it is there already
+ * @param[in]	addr	DDRAM address
+ * @return 		None
+ **********************************************************************/
+static void lcd_move (uint8_t addr)
+{
+	if (lcd_addr != addr)
+	{
+		Write_Command_Lcd(0x80 | addr);
+		lcd_stats.Moves++;
+	}
+}
+
+
+/*********************************************************************//**
+ * @brief	    Move the shadow cursor
+ * @param[in]	LineNum		line number, 1 based
+ * @param[in]	Position	column number, 1 based
+ * @param[in]	CursorType	cursor shown once the display is flushed
+ * @return 		TRUE if the position is on the display
+ **********************************************************************/
+static Bool lcd_goto (uchar LineNum, uchar Position, CursorType_e CursorType)
+{
+	if ((LineNum < 1) || (LineNum > ROWSIZE) || (Position < 1) || (Position > COLUMNSIZE))
+	{
+		return FALSE;
+	}
+	lcd_row = LineNum - 1;
+	lcd_col = Position - 1;
+	lcd_cursor = CursorType;
+	lcd_cursor_dirty = TRUE;
+	return TRUE;
+}
+
+
+/*********************************************************************//**
+ * @brief	    Flush timer callback, posts the flush task when the
+ * 				shadow changed
+ * @param[in]	tmr		flush timer
+ * @return 		None
+ **********************************************************************/
+static void lcd_flush_timer (SCHED_TIMER_Type *tmr)
+{
+	(void)tmr;
+
+	if (lcd_dirty || lcd_cursor_dirty)
+	{
+		SCHED_Post(&lcd_task);
+	}
+}
+
+
+/*********************************************************************//**
+ * @brief	    Flush task
+ * @param[in]	task	flush task
+ * @return 		None
+ **********************************************************************/
+static void lcd_flush_task (SCHED_TASK_Type *task)
+{
+	(void)task;
+
+	Lcd_Flush();
+}
+
+/* End of Private Functions --------------------------------------------------- */
+
+
 /** @addtogroup LCD_Public_Functions
  * @{
  */
@@ -33,22 +320,14 @@
  **********************************************************************/
 void Lcd_Config (void)
 {
-    #ifdef LCD_4BIT
-	{
-		GPIO_SetDir(1, _SBF(18,0xF0), 1);   // Set P1.18 to P1.21 as output
-	}
-    #endif
-    #ifdef LCD_8BIT
-	{
-		GPIO_SetDir(1, _SBF(18,0xFF), 1);   // Set P1.18 to P1.25 as output
-	}
-    #endif
+	GPIO_SetDir(1, LCD_DATA_PINS, 1);       // Set data lines of P1.18 to P1.25 as output
 	GPIO_SetDir(2, _SBF(11, 0x07), 1);      // Set P2.11 to P2.13 as Output
 }
 
 
 /*********************************************************************//**
- * @brief	    This function initializes LCD
+ * @brief	    This function initializes LCD and starts the periodic
+ * 				flush of the shadow buffer
  * @param[in]	AddrCount	select increment or decrement address counter
  *                          - Dec : 0
  *                          - Inc : 1
@@ -59,34 +338,44 @@ void Lcd_Config (void)
  **********************************************************************/
 void Lcd_Init (AddrCount_e AddrCount, DispShift_e DispShift)
 {
-	uint16 i;
-	Lcd_Config();                  // Configure Pins
+	lcd_ready = FALSE;
+	lcd_bf_ok = FALSE;                // No busy flag before the function set
+	Lcd_Config();                     // Configure Pins
 
-	GPIO_ClearValue(2, _BIT(11));  // Clear RS
-	GPIO_ClearValue(2, _BIT(12));  // Clear RW
-	GPIO_SetValue(2, _BIT(13));    // Set   EN
-	for(i=0;i<1500;i++);           // 15 us
+	LPC_GPIO2->FIOCLR = LCD_PIN_RS | LCD_PIN_RW | LCD_PIN_EN;
+	delay_ms(20);                     // Power on, > 15 ms
 
-	Write_Command_Lcd(LCD_CLEAR);
-	delay_ms(2);
-	Write_Command_Lcd(LCD_CLEAR);
-    delay_ms(4);
+	// Initialization by instruction: 8 bit function set three times
+	#ifdef LCD_4BIT
+		lcd_put(0x30 >> 4);
+	#endif
+	#ifdef LCD_8BIT
+		lcd_put(0x30);
+	#endif
+	Lcd_Enable();
+	delay_ms(5);
+	Lcd_Enable();
+	delay_ms(1);
+	Lcd_Enable();
+	delay_ms(1);
 
     #ifdef LCD_4BIT
     {
+        lcd_put(0x20 >> 4);           // Switch to 4 bit, still one transfer
+        Lcd_Enable();
+        delay_ms(1);
         Write_Command_Lcd(LCD_4BIT_2LINE);
-        for(i=0;i<5000;i++);             // 50 us
     }
     #endif
     #ifdef LCD_8BIT
     {
         Write_Command_Lcd(LCD_8BIT_2LINE);
-        delay_ms(1);
     }
     #endif
+    lcd_bf_ok = TRUE;
 
-    Write_Command_Lcd(CURSOR_HOME);
-    for(i=0;i<5000;i++);             // 50 us
+    Write_Command_Lcd(LCD_OFF);
+    Write_Command_Lcd(LCD_CLEAR);
 
     if(AddrCount == Dec)
     {
@@ -110,10 +399,16 @@ void Lcd_Init (AddrCount_e AddrCount, DispShift_e DispShift)
             Write_Command_Lcd(LCD_INC_ADD_DISP_SHIFT_ON);
         }
     }
-    Write_Command_Lcd(LCD_OFF);
-    Write_Command_Lcd(LCD_ON);
-    Write_Command_Lcd(CURSOR_OFF);
-    delay_ms(10);
+    Write_Command_Lcd(LCD_ON);        // Cursor off
+    lcd_cursor_dirty = FALSE;
+
+    if (lcd_task.Func == NULL)
+    {
+        SCHED_TaskInit(&lcd_task, lcd_flush_task, NULL, SCHED_PRIO_LOW);
+        SCHED_TimerInit(&lcd_timer, lcd_flush_timer, NULL);
+        SCHED_TimerStart(&lcd_timer, LCD_FLUSH_MS, LCD_FLUSH_MS);
+    }
+    lcd_ready = TRUE;
 }
 
 
@@ -124,98 +419,102 @@ void Lcd_Init (AddrCount_e AddrCount, DispShift_e DispShift)
  **********************************************************************/
 void Lcd_Enable (void)
 {
-    uint16 i;
-    GPIO_SetValue(2, _BIT(13));    // Set   EN
-    #ifdef LCD_4BIT
-        for(i=0;i<75;i++);         // 1 us
-    #endif
-    #ifdef LCD_8BIT
-        for(i=0;i<300;i++);        // 3 us
-    #endif
-    GPIO_ClearValue(2, _BIT(13));  // Clear   EN
+    LPC_GPIO2->FIOSET = LCD_PIN_EN;    // Set   EN
+    lcd_spin(1);                   // > 450 ns
+    LPC_GPIO2->FIOCLR = LCD_PIN_EN;    // Clear EN
+    lcd_spin(1);
 }
 
 
 /*********************************************************************//**
- * @brief	    This function writes commands to the LCD
- * @param[in]	Command		command to be written on LCD
+ * @brief	    This function waits until the LCD finished the last
+ * 				instruction. The busy flag is read on D7, if it never
+ * 				clears the LCD is taken to have R/W tied low and fixed
+ * 				delays are used from then on.
+ * @param[in]	None
  * @return 		None
  **********************************************************************/
-void Write_Command_Lcd (uchar Command)
+void Check_Busy (void)
 {
-	uint16 Mask;
-	uint16 LcdData = Command;
-	LcdData = LcdData << LCD_DATA_START_PIN;
-	Mask = (0x0F << (LCD_DATA_START_PIN));
+	uint32_t busy, n;
 
-	#ifdef LCD_4BIT
+	if (lcd_bf_ok == FALSE)
 	{
-		GPIO_ClearValue(2, _BIT(11));         // Clear RS
-	    GPIO_ClearValue(2, _BIT(12));         // Clear RW
-	    GPIO_ClearValue(1, _SBF(18, 0xF0));   // Clear Old Value
-	    GPIO_SetValue(1, _SBF(18,((LcdData >> 4) & Mask)));
-	    Lcd_Enable();
-
-	    GPIO_ClearValue(1, _SBF(18, 0xF0));   // Clear Old Value
-	    GPIO_SetValue(1, _SBF(18,(LcdData & Mask)));
-	    Lcd_Enable();
+		lcd_spin(lcd_slow ? LCD_EXEC_SLOW_US : LCD_EXEC_US);
+		return;
 	}
-	#endif
-	#ifdef LCD_8BIT
-	{
-		GPIO_ClearValue(2, _BIT(11));         // Clear RS
-		GPIO_ClearValue(2, _BIT(12));         // Clear RW
-		GPIO_ClearValue(1, _SBF(18, 0xFF));   // Clear Old Value
-	    GPIO_SetValue(1, _SBF(18,Command));   // Send Command
 
-	    Lcd_Enable();
+	LPC_GPIO1->FIODIR &= ~LCD_DATA_PINS;      // Release the data lines
+	LPC_GPIO2->FIOCLR = LCD_PIN_RS;
+	LPC_GPIO2->FIOSET = LCD_PIN_RW;
+	n = LCD_BUSY_POLLS;
+	do
+	{
+		LPC_GPIO2->FIOSET = LCD_PIN_EN;
+		lcd_spin(1);                          // Data valid after 360 ns
+		busy = LPC_GPIO1->FIOPIN & LCD_BF_PIN;
+		LPC_GPIO2->FIOCLR = LCD_PIN_EN;
+		lcd_spin(1);
+		#ifdef LCD_4BIT
+			Lcd_Enable();                     // Low nibble of the address counter
+		#endif
+		lcd_stats.Polls++;
+	} while (busy && --n);
+	LPC_GPIO2->FIOCLR = LCD_PIN_RW;
+	LPC_GPIO1->FIODIR |= LCD_DATA_PINS;
+
+	if (busy)
+	{
+		lcd_bf_ok = FALSE;
+		lcd_stats.Timeouts++;
 	}
-	#endif
 }
 
 
 /*********************************************************************//**
- * @brief	    This function writes data to the LCD
+ * @brief	    This function writes commands to the LCD
+ * @param[in]	Command		command to be written on LCD
+ * @return 		None
+ **********************************************************************/
+void Write_Command_Lcd (uchar Command)
+{
+	lcd_write(Command, 0);
+	lcd_track(Command);
+}
+
+
+/*********************************************************************//**
+ * @brief	    This function writes data at the cursor into the shadow
+ * 				buffer and moves the cursor on, to the next line after
+ * 				the last column
  * @param[in]	Character		data to be written on LCD
  * @return 		None
  **********************************************************************/
 void Write_Data_Lcd (uchar Character)
 {
-	 uint16 Mask;
-	 uint16 LcdData = Character;
-	 LcdData = LcdData << LCD_DATA_START_PIN;
-	 Mask = (0x0F << (LCD_DATA_START_PIN));
-
-	 Write_Command_Lcd(CURSOR_OFF); // Needed
-
-     #ifdef LCD_4BIT
-	 {
-	     GPIO_SetValue(2, _BIT(11));             // Set RS
-		 GPIO_ClearValue(2, _BIT(12));           // Clear RW
-		 GPIO_ClearValue(1, _SBF(18, 0xF0));     // Clear Old Value
-	     GPIO_SetValue(1, _SBF(18,((LcdData >> 4) & Mask)));
-	     Lcd_Enable();
-
-	     GPIO_ClearValue(1, _SBF(18, 0xF0));     // Clear Old Value
-	     GPIO_SetValue(1, _SBF(18,(LcdData & Mask)));
-	     Lcd_Enable();
-	 }
-	 #endif
-	 #ifdef LCD_8BIT
-	 {
-		 GPIO_SetValue(2, _BIT(11));             // Set RS
-		 GPIO_ClearValue(2, _BIT(12));           // Clear RW
-		 GPIO_ClearValue(1, _SBF(18, 0x0F));     // Clear Old Value
-		 GPIO_SetValue(1, _SBF(18,Character));   // Send Data
-
-	     Lcd_Enable();
-	 }
-	 #endif
+	if (lcd_shadow[lcd_row][lcd_col] != Character)
+	{
+		lcd_shadow[lcd_row][lcd_col] = Character;
+		lcd_dirty |= 1 << lcd_row;
+	}
+	if (++lcd_col == COLUMNSIZE)
+	{
+		lcd_col = 0;
+		if (++lcd_row == ROWSIZE)
+		{
+			lcd_row = 0;
+		}
+	}
+	if (lcd_cursor != Off)
+	{
+		lcd_cursor_dirty = TRUE;
+	}
 }
 
 
 /*********************************************************************//**
- * @brief	    This function sets coursor to desired Position
+ * @brief	    This function sets coursor to desired Position, shown
+ * 				on the next flush
  * @param[in]	LineNum		enter line number
  * @param[in]	Position	enter the Position ie. column number
  * @param[in]	CursorType	select cursor ON/OFF/BLINK
@@ -226,36 +525,7 @@ void Write_Data_Lcd (uchar Character)
  **********************************************************************/
 void Set_Cursor (uchar LineNum, uchar Position, CursorType_e CursorType)
 {
-	uchar LcdCmd=0;
-    switch(LineNum)
-	{
-	    case 1:
-	        LcdCmd = ROWADDR1 + (Position - 1);
-	        break;
-	    case 2:
-	        LcdCmd = ROWADDR2 + (Position - 1);
-	        break;
-	    case 3:
-	        LcdCmd = ROWADDR3 + (Position - 1);
-	        break;
-	    case 4:
-	        LcdCmd = ROWADDR4 + (Position - 1);
-	        break;
-	}
-	Write_Command_Lcd(LcdCmd);
-
-	if(CursorType == Off)
-	{
-		Write_Command_Lcd(CURSOR_OFF);
-	}
-	else if(CursorType == On)
-	{
-	    Write_Command_Lcd(CURSOR_ON);
-	}
-	else if(CursorType == Blink)
-	{
-	    Write_Command_Lcd(CURSOR_BLINK);
-	}
+	lcd_goto(LineNum, Position, CursorType);
 }
 
 
@@ -264,7 +534,8 @@ void Set_Cursor (uchar LineNum, uchar Position, CursorType_e CursorType)
  * @param[in]	Charater	string to be displayed
  * @param[in]	LineNum		enter line number
  * @param[in]	Position	enter the Position ie. column number
- * @param[in]	CursorType	select cursor ON/OFF/BLINK
+ * @param[in]	CursorType	select cursor ON/OFF/BLINK, shown after
+ * 							the character
  *              - Off   : 0
  *              - On    : 1
  *              - Blink : 2
@@ -272,17 +543,21 @@ void Set_Cursor (uchar LineNum, uchar Position, CursorType_e CursorType)
  **********************************************************************/
 void Display_Character (uchar Character, uchar LineNum, uchar Position, CursorType_e CursorType)
 {
-	Set_Cursor(LineNum, Position, CursorType);
-	Write_Data_Lcd(Character);
+	if (lcd_goto(LineNum, Position, CursorType))
+	{
+		Write_Data_Lcd(Character);
+	}
 }
 
 
 /*********************************************************************//**
- * @brief	    This function display string to desired Position
+ * @brief	    This function display string to desired Position, text
+ * 				past the last column goes on at the next line
  * @param[in]	String		string to be displayed
  * @param[in]	LineNum		enter line number
  * @param[in]	Position	enter the Position ie. column number
- * @param[in]	CursorType	select cursor ON/OFF/BLINK
+ * @param[in]	CursorType	select cursor ON/OFF/BLINK, shown after
+ * 							the string
  *              - Off   : 0
  *              - On    : 1
  *              - Blink : 2
@@ -290,15 +565,12 @@ void Display_Character (uchar Character, uchar LineNum, uchar Position, CursorTy
  **********************************************************************/
 void Display_String (uchar *String, uchar LineNum, uchar Position, CursorType_e CursorType)
 {
-	while (*String)
+	if (lcd_goto(LineNum, Position, CursorType))
 	{
-	    Display_Character(*String++,LineNum,Position++,CursorType);
-
-	    if(Position-1 == COLUMNSIZE)
-	    {
-	        LineNum++;
-	        Position =1;
-	    }
+		while (*String)
+		{
+			Write_Data_Lcd(*String++);
+		}
 	}
 }
 
@@ -339,7 +611,8 @@ void Display_Shift (ShiftDir_e Direction, CursorType_e CursorType)
 
 
 /*********************************************************************//**
- * @brief	    This function builds custom character
+ * @brief	    This function builds custom character, written to the
+ * 				LCD at once
  * @param[in]	loc		position
  * @param[in]	*p		Custom Character
  * @return 		None
@@ -353,7 +626,7 @@ void CGRAM_Char_Gen (uchar loc,uchar *p)
         Write_Command_Lcd(0x40+(loc*8));  // Access to CGRAM
         for(i=0;i<8;i++)
         {
-            Write_Data_Lcd(p[i]);         // Write Pattern
+            lcd_write(p[i], LCD_PIN_RS);      // Write Pattern
         }
     }
     Write_Command_Lcd(0x80);              // Shift to DDRAM location 0
@@ -381,6 +654,104 @@ void Display_Decimal_Lcd (uint16 VarData, uchar Row, uchar Col)
 }
 
 
+/*********************************************************************//**
+ * @brief	    This function blanks the shadow buffer, cheaper than
+ * 				LCD_CLEAR as only cells that were not blank are sent
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void Lcd_Clear (void)
+{
+	memset(lcd_shadow, ' ', sizeof(lcd_shadow));
+	lcd_dirty = (1 << ROWSIZE) - 1;
+	lcd_goto(1, 1, lcd_cursor);
+}
+
+
+/*********************************************************************//**
+ * @brief	    This function sends the cells that differ from the
+ * 				shadow buffer. A run of changed cells costs one address
+ * 				command, short unchanged gaps inside it are written again
+ * 				since that costs no more than a new address. Called by
+ * 				the flush task every LCD_FLUSH_MS.
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void Lcd_Flush (void)
+{
+	uint8_t i, r, dirty;
+	int16_t c, n, end;
+	uchar *want, *have;
+
+	if ((lcd_ready == FALSE) || ((lcd_dirty == 0) && (lcd_cursor_dirty == FALSE)))
+	{
+		return;
+	}
+	lcd_stats.Flushes++;
+	dirty = lcd_dirty;
+	lcd_dirty = 0;
+
+	for (i = 0; i < ROWSIZE; i++)
+	{
+		r = lcd_row_order[i];
+		if ((dirty & (1 << r)) == 0)
+		{
+			continue;
+		}
+		want = lcd_shadow[r];
+		have = lcd_ddram[r];
+		// Walk the row the way the address counter moves
+		c = (lcd_step > 0) ? 0 : COLUMNSIZE - 1;
+		end = (lcd_step > 0) ? COLUMNSIZE : -1;
+		while (c != end)
+		{
+			if (want[c] == have[c])
+			{
+				c += lcd_step;
+				continue;
+			}
+			lcd_move(lcd_row_addr[r] + c);
+			n = c;
+			do
+			{
+				while (c != n)                  // Unchanged gap
+				{
+					lcd_cell(want[c]);
+					c += lcd_step;
+				}
+				have[c] = want[c];
+				lcd_cell(want[c]);
+				c += lcd_step;
+				for (n = c; (n != end) && (want[n] == have[n]); n += lcd_step);
+			} while ((n != end) && ((n - c) * lcd_step <= LCD_GAP_MAX));
+			c = n;
+		}
+	}
+
+	// Leave the address counter under a visible cursor
+	if (lcd_cursor != Off)
+	{
+		lcd_move(lcd_row_addr[lcd_row] + lcd_col);
+	}
+	if (lcd_cursor != lcd_shown)
+	{
+		Write_Command_Lcd((lcd_cursor == Blink) ? CURSOR_BLINK : ((lcd_cursor == On) ? CURSOR_ON : CURSOR_OFF));
+	}
+	lcd_cursor_dirty = FALSE;
+}
+
+
+/*********************************************************************//**
+ * @brief	    This function reads the driver counters
+ * @param[out]	stats	pointer to LCD_STATS_Type
+ * @return 		None
+ **********************************************************************/
+void Lcd_GetStats (LCD_STATS_Type *stats)
+{
+	*stats = lcd_stats;
+}
+
+
 /**
  * @}
  */
@@ -21,194 +21,159 @@
  * otherwise the default FW library configuration file must be included instead
  */
 
-uchar Find_Column (void);
-uchar Find_Row (void);
-void Col_High (void);
-void Row_High (void);
-void Row_Low (void);
-
-
+/* Private Macros ------------------------------------------------------------- */
+#define		MATKB_ROW_GPIO		((LPC_GPIO_TypeDef *)(LPC_GPIO0_BASE + (MATKB_ROW_PORT) * 0x20))
+#define		MATKB_COL_GPIO		((LPC_GPIO_TypeDef *)(LPC_GPIO0_BASE + (MATKB_COL_PORT) * 0x20))
+#define		MATKB_ROW_MASK		(((1UL << MATKB_ROWS) - 1) << MATKB_ROW_PIN)
+#define		MATKB_COL_MASK		((1UL << MATKB_COLS) - 1)
+#define		MATKB_SETTLE		20			// Column settle loop after a row change, ~1 us
+
+/* Private Variables ---------------------------------------------------------- */
+static void Mat_Kb_Idle (void);
+static uint64_t Mat_Kb_Scan (void);
+
+/** Keypad as a source of the input subsystem */
+static INPUT_SRC_Type Mat_Kb_Src = {
+	MATKB_ROWS * MATKB_COLS, MATKB_COL_PORT, MATKB_COL_MASK << MATKB_COL_PIN,
+	Mat_Kb_Idle, Mat_Kb_Scan, 0, NULL
+};
+static Bool Mat_Kb_Attached;
+
+
+/* Private Functions ---------------------------------------------------------- */
 /*********************************************************************//**
- * @brief	    This routine configures pin assignment
+ * @brief	    Drives all rows low, any key then pulls its column low
  * @param[in]	None
  * @return 		None
  **********************************************************************/
-void Mat_Kb_Config (void)
+static void Mat_Kb_Idle (void)
 {
-	GPIO_SetDir(0, _SBF(19,0x03), 1);  // Set P0.19 & P0.20 as ROW output
-	GPIO_SetDir(0, _SBF(21,0x03), 0);  // Set P0.21 & P0.22 as COL input
+	MATKB_ROW_GPIO->FIOCLR = MATKB_ROW_MASK;
+	MATKB_ROW_GPIO->FIODIR |= MATKB_ROW_MASK;
 }
 
 
 /*********************************************************************//**
- * @brief	    This function initializes matrix keyboard.
- *              Make ROWs as o/p & Columns as an i/p.
+ * @brief	    Scans the matrix, input source scan. Only the row being
+ *              read drives low, the others float so two keys in one
+ *              column never short a high row to a low one.
  * @param[in]	None
- * @return 		None
+ * @return 		Keys down, bit (Row * MATKB_COLS + Col) with 0 based
+ *              Row and Col
  **********************************************************************/
-void Mat_Kb_Init (void)
+static uint64_t Mat_Kb_Scan (void)
 {
-	Mat_Kb_Config();
-
-    Col_High();
-	Row_Low();
-}
-
-
-/*********************************************************************//**
- * @brief	    This function will scan whether any key is pressed or not
- * @param[in]	None
- * @return 		Returns Status of Key Pressed
- **********************************************************************/
-uchar Scan_Key (void)
-{
-	uchar ReadValue = 0,COL1,COL2;
-	uint32_t col1,col2;
-	col1 = GPIO_ReadValue(0);
-	col2 = GPIO_ReadValue(0);
-	col1 &= 0x00200000;
-	col2 &= 0x00400000;
-	if(col1 == 0x00200000)
-	{
-		COL1 = 1;
-	}
-	else
-	{
-		COL1 = 0;
-	}
+	uint64_t keys = 0;
+	uint32_t dir, cols, row;
+	volatile uint32_t settle;
 
-	if(col2 == 0x00400000)
+	MATKB_ROW_GPIO->FIOCLR = MATKB_ROW_MASK;
+	dir = MATKB_ROW_GPIO->FIODIR & ~MATKB_ROW_MASK;
+	for (row = 0; row < MATKB_ROWS; row++)
 	{
-		COL2 = 1;
+		MATKB_ROW_GPIO->FIODIR = dir | (1UL << (MATKB_ROW_PIN + row));
+		for (settle = MATKB_SETTLE; settle; settle--);
+		cols = (~MATKB_COL_GPIO->FIOPIN >> MATKB_COL_PIN) & MATKB_COL_MASK;
+		keys |= (uint64_t)cols << (row * MATKB_COLS);
 	}
-	else
-	{
-		COL2 = 0;
-	}
-
-	#if MATKB_2X2
-	    ReadValue = (COL1 & COL2);
-	#endif
-
-	if((ReadValue != 1))
-	    return(1);
-	else
-	    return(0);
+	MATKB_ROW_GPIO->FIODIR = dir | MATKB_ROW_MASK;
+	return keys;
 }
 
-/*********************************************************************//**
- * @brief	    This function detects whether any key is pressed or
- *              not also returns its its location
- * @param[in]	None
- * @return 		Returns Pressed Key Code
- **********************************************************************/
-uint16 Detect_Mat_Key(void)
-{
-    uchar Col = 0,Row = 0,Key = 0;
+/* End of Private Functions --------------------------------------------------- */
 
-    Row = Find_Row();
-    Col = Find_Column();
-    Key = Col + (10 * Row);
-    return(Key);
-}
 
+/** @addtogroup MAT_KB_Public_Functions
+ * @{
+ */
 
+/* Public Functions ----------------------------------------------------------- */
 /*********************************************************************//**
- * @brief	    This function will find the column from where key is pressed
+ * @brief	    This routine configures pin assignment
  * @param[in]	None
- * @return 		Returns Column index
+ * @return 		None
  **********************************************************************/
-uchar Find_Column(void)
+void Mat_Kb_Config (void)
 {
-	uint32_t col;
-
-    if (Scan_Key() != 1)
-    {
-        return(0);
-    }
-    #if MATKB_2X2
-        col = GPIO_ReadValue(0);
-        col |= 0xFF9FFFFF;
-        if (col == 0xFFDFFFFF) // if COL1 = 0
-	    {
-            return(1);
-        }
-        if (col == 0xFFBFFFFF) // if COL2 = 0
-        {
-	        return(2);
-        }
-    #endif
-    return 0;
+	GPIO_SetDir(MATKB_COL_PORT, MATKB_COL_MASK << MATKB_COL_PIN, 0);  // Set COL input
+	Mat_Kb_Idle();                                                  // Set ROW output low
 }
 
 
 /*********************************************************************//**
- * @brief	    This function will find the row from where key is pressed
+ * @brief	    This function initializes matrix keyboard and hands it
+ *              to the input subsystem, which must be initialized with
+ *              INPUT_Init() first. Key presses then come as debounced
+ *              events from INPUT_GetEvent(), nothing is scanned while
+ *              all keys are up.
  * @param[in]	None
- * @return 		Returns Row Index
+ * @return 		None
  **********************************************************************/
-uchar Find_Row(void)
+void Mat_Kb_Init (void)
 {
-    uchar i;
-
-    for(i = 1; i <= ROW ;i++)
-    {
-        Row_High();
-        switch (i)
-        {
-            case 1:
-            	GPIO_ClearValue(0,_BIT(19)); // ROW1
-		        break;
-
-	        case 2:
-	        	GPIO_ClearValue(0,_BIT(20)); // ROW2
-                break;
-        }
-        if (Scan_Key() == 1)
-        {
-            Row_Low();
-            return(i);
-        }
-    }
-    return 0;
+	Mat_Kb_Config();
+	if (INPUT_Attach(&Mat_Kb_Src) == SUCCESS)
+	{
+		Mat_Kb_Attached = TRUE;
+	}
 }
 
 
 /*********************************************************************//**
- * @brief	    This function will set all columns
+ * @brief	    This function detects whether any key is pressed or
+ *              not also returns its its location, debounced once
+ *              Mat_Kb_Init() attached the keypad
  * @param[in]	None
- * @return 		None
+ * @return 		Returns Pressed Key Code, Col + (10 * Row) with 1 based
+ *              Row and Col, 0 if no key is down
  **********************************************************************/
-void Col_High (void)
+uint16 Detect_Mat_Key(void)
 {
-    GPIO_SetValue(0,_BIT(21));  // COL1 High
-    GPIO_SetValue(0,_BIT(22));  // COL2 High
+	uint64_t keys;
+	uint8_t key;
+
+	if (Mat_Kb_Attached)
+	{
+		keys = INPUT_GetKeys() >> Mat_Kb_Src.Base;
+	}
+	else
+	{
+		keys = Mat_Kb_Scan();
+	}
+	for (key = 0; key < MATKB_ROWS * MATKB_COLS; key++)
+	{
+		if ((keys >> key) & 1)
+		{
+			return(((key % MATKB_COLS) + 1) + (10 * ((key / MATKB_COLS) + 1)));
+		}
+	}
+	return(0);
 }
 
 
 /*********************************************************************//**
- * @brief	    This function will set all Rows
- * @param[in]	None
- * @return 		None
+ * @brief	    This function converts the key number of an input event
+ *              to the key code of Detect_Mat_Key()
+ * @param[in]	key		INPUT_EVENT_Type Key
+ * @return 		Key Code, 0 if the key is not on the keypad
  **********************************************************************/
-void Row_High (void)
+uint16 Mat_Kb_Code(uint8_t key)
 {
-    GPIO_SetValue(0,_BIT(19));  // ROW1 High
-    GPIO_SetValue(0,_BIT(20));  // ROW2 High
+	if ((Mat_Kb_Attached == FALSE) || (key < Mat_Kb_Src.Base) ||
+		(key >= Mat_Kb_Src.Base + MATKB_ROWS * MATKB_COLS))
+	{
+		return(0);
+	}
+	key -= Mat_Kb_Src.Base;
+	return(((key % MATKB_COLS) + 1) + (10 * ((key / MATKB_COLS) + 1)));
 }
 
 
-/*********************************************************************//**
- * @brief	    This function will clear all Rows
- * @param[in]	None
- * @return 		None
- **********************************************************************/
-void Row_Low (void)
-{
-    GPIO_ClearValue(0,_BIT(19));  // ROW1 Low
-    GPIO_ClearValue(0,_BIT(20));  // ROW2 Low
-}
+/**
+ * @}
+ */
 
+/* End of Public Functions ---------------------------------------------------- */
 
 /**
  * @}
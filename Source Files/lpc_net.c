@@ -0,0 +1,883 @@
+/******************************************************************//**
+* @file		lpc_net.c
+* @brief	Contains all functions support for the allocation free
+*           ARP/IPv4/ICMP/UDP stack on the EMAC descriptor rings
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @addtogroup NET
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc_net.h"
+#include <string.h>
+
+/* If this source file built with example, the LPC17xx FW library configuration
+ * file in each example directory ("lpc17xx_libcfg.h") must be included,
+ * otherwise the default FW library configuration file must be included instead
+ */
+
+/* Private Macros ------------------------------------------------------------- */
+/** @defgroup NET_Private_Macros NET Private Macros
+ * @{
+ */
+
+/* Ethernet header */
+#define ETH_DST				0
+#define ETH_SRC				6
+#define ETH_TYPE			12
+#define ETH_TYPE_IP			0x0800
+#define ETH_TYPE_ARP		0x0806
+
+/* ARP packet, from the start of the frame */
+#define ARP_HTYPE			14
+#define ARP_PTYPE			16
+#define ARP_HLEN			18
+#define ARP_PLEN			19
+#define ARP_OPER			20
+#define ARP_SHA				22
+#define ARP_SPA				28
+#define ARP_THA				32
+#define ARP_TPA				38
+#define ARP_FRAME_LEN		42
+#define ARP_REQUEST			1
+#define ARP_REPLY			2
+
+/* IPv4 header, from the start of the frame */
+#define IP_VHL				14
+#define IP_LEN				16
+#define IP_ID				18
+#define IP_FRAG				20
+#define IP_TTL				22
+#define IP_PROTO			23
+#define IP_CSUM				24
+#define IP_SRC				26
+#define IP_DST				30
+#define IP_FLAG_DF			0x4000
+#define IP_FRAG_MASK		0x3FFF		/**< More fragments flag and offset */
+#define IP_PROTO_ICMP		1
+#define IP_PROTO_UDP		17
+
+/* ICMP and UDP headers, from the start of the transport header */
+#define ICMP_TYPE			0
+#define ICMP_CSUM			2
+#define ICMP_ECHO_REPLY		0
+#define ICMP_ECHO_REQUEST	8
+#define UDP_SPORT			0
+#define UDP_DPORT			2
+#define UDP_LEN				4
+#define UDP_CSUM			6
+
+/** Big endian field access, frames may be at any alignment */
+#define NET_GET16(p)		((uint16_t)(((p)[0] << 8) | (p)[1]))
+#define NET_PUT16(p, v)		do { (p)[0] = (uint8_t)((v) >> 8); (p)[1] = (uint8_t)(v); } while (0)
+
+/** Host to memory order of a 16 bit word (the core is little endian) */
+#define NET_HTONS(v)		((uint16_t)((((v) & 0xFF) << 8) | (((v) >> 8) & 0xFF)))
+
+/** One's complement add with end around carry */
+#define NET_ADDC(acc, w)	do { (acc) += (w); if ((acc) < (w)) (acc)++; } while (0)
+
+/**
+ * @}
+ */
+
+
+/* Private Types -------------------------------------------------------------- */
+/** @defgroup NET_Private_Types NET Private Types
+ * @{
+ */
+
+typedef struct {
+	uint32_t Ip;				/**< 0 when the entry is free */
+	uint8_t Mac[6];
+	uint16_t Age;				/**< Seconds since last confirmed */
+} NET_ARP_T;
+
+typedef struct {
+	uint16_t Port;				/**< 0 when the socket is free */
+	NET_UDP_CB_Type Cb;
+} NET_UDP_T;
+
+/**
+ * @}
+ */
+
+
+/* Private Variables ---------------------------------------------------------- */
+static NET_CFG_Type net_cfg;
+static NET_STATS_Type net_stats;
+static NET_ARP_T net_arp[NET_ARP_ENTRIES];
+static NET_UDP_T net_udp[NET_UDP_SOCKETS];
+static uint16_t net_ip_id;
+
+/* One frame waiting for its next hop to answer ARP */
+static EMAC_PBUF_Type net_wait;
+static uint32_t net_wait_ip;
+static uint8_t net_wait_age;
+
+
+/* Private Functions ---------------------------------------------------------- */
+static NET_ARP_T *arp_find(uint32_t ip);
+static void arp_update(uint32_t ip, const uint8_t *mac, Bool insert);
+static void arp_send(uint16_t oper, const uint8_t *tha, uint32_t tpa);
+static void arp_input(const uint8_t *f, uint32_t len);
+static void ip_input(const uint8_t *f, uint32_t len);
+static void icmp_input(const uint8_t *f, uint32_t hlen, uint32_t tot);
+static void udp_input(const uint8_t *f, uint32_t hlen, uint32_t tot);
+static uint32_t udp_pseudo(uint32_t src, uint32_t dst, uint16_t len);
+static void net_eth_header(uint8_t *f, const uint8_t *dst, uint16_t type);
+static void net_flush(void);
+
+/*********************************************************************//**
+ * @brief		Find the ARP cache entry of an address
+ * @param[in]	ip		IPv4 address
+ * @return		Entry, NULL if not cached
+ **********************************************************************/
+static NET_ARP_T *arp_find(uint32_t ip)
+{
+	uint32_t i;
+
+	for (i = 0; i < NET_ARP_ENTRIES; i++)
+	{
+		if ((net_arp[i].Ip == ip) && (ip != 0))
+		{
+			return &net_arp[i];
+		}
+	}
+	return NULL;
+}
+
+/*********************************************************************//**
+ * @brief		Refresh an ARP cache entry (RFC 826 merge)
+ * @param[in]	ip		Sender protocol address
+ * @param[in]	mac		Sender hardware address
+ * @param[in]	insert	TRUE to add the address when not cached, the
+ * 						oldest entry is replaced when the cache is full
+ * @return		None
+ **********************************************************************/
+static void arp_update(uint32_t ip, const uint8_t *mac, Bool insert)
+{
+	NET_ARP_T *e = arp_find(ip);
+	uint32_t i;
+
+	if (e == NULL)
+	{
+		if (!insert)
+		{
+			return;
+		}
+		e = &net_arp[0];
+		for (i = 0; i < NET_ARP_ENTRIES; i++)
+		{
+			if (net_arp[i].Ip == 0)
+			{
+				e = &net_arp[i];
+				break;
+			}
+			if (net_arp[i].Age > e->Age)
+			{
+				e = &net_arp[i];
+			}
+		}
+		e->Ip = ip;
+	}
+	memcpy(e->Mac, mac, 6);
+	e->Age = 0;
+}
+
+/*********************************************************************//**
+ * @brief		Send an ARP request or reply
+ * @param[in]	oper	ARP_REQUEST (tha ignored, broadcast) or ARP_REPLY
+ * @param[in]	tha		Target hardware address
+ * @param[in]	tpa		Target protocol address
+ * @return		None
+ **********************************************************************/
+static void arp_send(uint16_t oper, const uint8_t *tha, uint32_t tpa)
+{
+	static const uint8_t bcast[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+	EMAC_PBUF_Type tx;
+	uint8_t *f;
+
+	if (EMAC_TxClaim(&tx) == ERROR)
+	{
+		net_stats.TxBusy++;
+		return;
+	}
+	f = tx.pbData;
+	net_eth_header(f, (oper == ARP_REQUEST) ? bcast : tha, ETH_TYPE_ARP);
+	NET_PUT16(&f[ARP_HTYPE], 1);
+	NET_PUT16(&f[ARP_PTYPE], ETH_TYPE_IP);
+	f[ARP_HLEN] = 6;
+	f[ARP_PLEN] = 4;
+	NET_PUT16(&f[ARP_OPER], oper);
+	memcpy(&f[ARP_SHA], net_cfg.Mac, 6);
+	memcpy(&f[ARP_SPA], &net_cfg.Ip, 4);
+	if (oper == ARP_REQUEST)
+	{
+		memset(&f[ARP_THA], 0, 6);
+	}
+	else
+	{
+		memcpy(&f[ARP_THA], tha, 6);
+	}
+	memcpy(&f[ARP_TPA], &tpa, 4);
+
+	// The MAC pads the frame to the 60 byte minimum
+	tx.ulDataLen = ARP_FRAME_LEN;
+	if (EMAC_TxSend(&tx, 1) == ERROR)
+	{
+		EMAC_TxDiscard(&tx);
+		net_stats.TxBusy++;
+	}
+	else if (oper == ARP_REPLY)
+	{
+		net_stats.ArpReplies++;
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Process a received ARP packet
+ * @param[in]	f		Frame
+ * @param[in]	len		Frame length
+ * @return		None
+ **********************************************************************/
+static void arp_input(const uint8_t *f, uint32_t len)
+{
+	uint32_t spa, tpa;
+	Bool for_us;
+
+	if ((len < ARP_FRAME_LEN) || (NET_GET16(&f[ARP_HTYPE]) != 1) ||
+		(NET_GET16(&f[ARP_PTYPE]) != ETH_TYPE_IP) || (f[ARP_HLEN] != 6) || (f[ARP_PLEN] != 4))
+	{
+		net_stats.RxDropped++;
+		return;
+	}
+	memcpy(&spa, &f[ARP_SPA], 4);
+	memcpy(&tpa, &f[ARP_TPA], 4);
+	for_us = ((tpa == net_cfg.Ip) && (net_cfg.Ip != 0)) ? TRUE : FALSE;
+
+	if (spa != 0)
+	{
+		arp_update(spa, &f[ARP_SHA], for_us);
+	}
+	if (for_us && (NET_GET16(&f[ARP_OPER]) == ARP_REQUEST))
+	{
+		arp_send(ARP_REPLY, &f[ARP_SHA], spa);
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Process a received IPv4 datagram
+ * @param[in]	f		Frame
+ * @param[in]	len		Frame length
+ * @return		None
+ **********************************************************************/
+static void ip_input(const uint8_t *f, uint32_t len)
+{
+	uint32_t hlen, tot, dst;
+
+	if ((len < NET_ETH_HLEN + NET_IP_HLEN) || ((f[IP_VHL] >> 4) != 4))
+	{
+		net_stats.RxDropped++;
+		return;
+	}
+	hlen = (f[IP_VHL] & 0x0F) * 4;
+	tot = NET_GET16(&f[IP_LEN]);
+	// Short frames carry padding, the IP length is the real size
+	if ((hlen < NET_IP_HLEN) || (tot < hlen) || (tot > len - NET_ETH_HLEN) ||
+		(NET_GET16(&f[IP_FRAG]) & IP_FRAG_MASK))
+	{
+		net_stats.RxDropped++;
+		return;
+	}
+	if (NET_ChecksumAdd(0, &f[IP_VHL], hlen) != 0xFFFF)
+	{
+		net_stats.ChecksumErrors++;
+		return;
+	}
+	memcpy(&dst, &f[IP_DST], 4);
+	if ((dst != net_cfg.Ip) && (dst != NET_IP_BROADCAST) && (dst != (net_cfg.Ip | ~net_cfg.Mask)))
+	{
+		net_stats.RxDropped++;
+		return;
+	}
+
+	switch (f[IP_PROTO])
+	{
+	case IP_PROTO_ICMP:
+		icmp_input(f, hlen, tot);
+		break;
+	case IP_PROTO_UDP:
+		udp_input(f, hlen, tot);
+		break;
+	default:
+		net_stats.RxDropped++;
+		break;
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Answer an ICMP echo request
+ * @param[in]	f		Frame
+ * @param[in]	hlen	IP header length
+ * @param[in]	tot		IP datagram length
+ * @return		None
+ *
+ * Note: The reply is the request copied into a Tx buffer with the
+ * addresses swapped. Only the type changes in the ICMP message, so its
+ * checksum is patched (RFC 1624) instead of summed again.
+ **********************************************************************/
+static void icmp_input(const uint8_t *f, uint32_t hlen, uint32_t tot)
+{
+	const uint8_t *icmp = &f[NET_ETH_HLEN + hlen];
+	EMAC_PBUF_Type tx;
+	uint8_t *r;
+	uint16_t old, csum;
+	uint32_t sum;
+
+	if ((tot - hlen < 8) || (icmp[ICMP_TYPE] != ICMP_ECHO_REQUEST))
+	{
+		net_stats.RxDropped++;
+		return;
+	}
+	if (NET_ChecksumAdd(0, icmp, tot - hlen) != 0xFFFF)
+	{
+		net_stats.ChecksumErrors++;
+		return;
+	}
+	if (EMAC_TxClaim(&tx) == ERROR)
+	{
+		net_stats.TxBusy++;
+		return;
+	}
+	r = tx.pbData;
+	memcpy(r, f, NET_ETH_HLEN + tot);
+	net_eth_header(r, &f[ETH_SRC], ETH_TYPE_IP);
+
+	// IP: answer from our own address, even to a broadcast ping
+	memcpy(&r[IP_DST], &f[IP_SRC], 4);
+	memcpy(&r[IP_SRC], &net_cfg.Ip, 4);
+	r[IP_TTL] = NET_IP_TTL;
+	r[IP_CSUM] = 0;
+	r[IP_CSUM + 1] = 0;
+	csum = (uint16_t)~NET_ChecksumAdd(0, &r[IP_VHL], hlen);
+	memcpy(&r[IP_CSUM], &csum, 2);
+
+	// ICMP: HC' = ~(~HC + ~m + m'), the type is the low byte of m = 8, m' = 0
+	r += NET_ETH_HLEN + hlen;
+	r[ICMP_TYPE] = ICMP_ECHO_REPLY;
+	memcpy(&old, &r[ICMP_CSUM], 2);
+	sum = (uint16_t)~old + (uint16_t)~ICMP_ECHO_REQUEST;
+	sum = (sum >> 16) + (sum & 0xFFFF);
+	csum = (uint16_t)~(sum + (sum >> 16));
+	memcpy(&r[ICMP_CSUM], &csum, 2);
+
+	tx.ulDataLen = NET_ETH_HLEN + tot;
+	if (EMAC_TxSend(&tx, 1) == ERROR)
+	{
+		EMAC_TxDiscard(&tx);
+		net_stats.TxBusy++;
+		return;
+	}
+	net_stats.EchoReplies++;
+}
+
+/*********************************************************************//**
+ * @brief		Deliver a UDP datagram to its socket
+ * @param[in]	f		Frame
+ * @param[in]	hlen	IP header length
+ * @param[in]	tot		IP datagram length
+ * @return		None
+ **********************************************************************/
+static void udp_input(const uint8_t *f, uint32_t hlen, uint32_t tot)
+{
+	const uint8_t *udp = &f[NET_ETH_HLEN + hlen];
+	uint32_t src, dst, ulen, i;
+	uint16_t dport;
+
+	ulen = (tot - hlen >= 8) ? NET_GET16(&udp[UDP_LEN]) : 0;
+	if ((ulen < 8) || (ulen > tot - hlen))
+	{
+		net_stats.RxDropped++;
+		return;
+	}
+	memcpy(&src, &f[IP_SRC], 4);
+	memcpy(&dst, &f[IP_DST], 4);
+	// A zero checksum means the sender did not compute one
+	if ((udp[UDP_CSUM] | udp[UDP_CSUM + 1]) &&
+		(NET_ChecksumAdd(udp_pseudo(src, dst, ulen), udp, ulen) != 0xFFFF))
+	{
+		net_stats.ChecksumErrors++;
+		return;
+	}
+
+	dport = NET_GET16(&udp[UDP_DPORT]);
+	for (i = 0; i < NET_UDP_SOCKETS; i++)
+	{
+		if (net_udp[i].Port == dport)
+		{
+			net_stats.UdpReceived++;
+			net_udp[i].Cb(src, NET_GET16(&udp[UDP_SPORT]), dport, &udp[8], ulen - 8);
+			return;
+		}
+	}
+	net_stats.RxDropped++;
+}
+
+/*********************************************************************//**
+ * @brief		Sum of the UDP pseudo header
+ * @param[in]	src		Source address
+ * @param[in]	dst		Destination address
+ * @param[in]	len		UDP length
+ * @return		Partial sum for NET_ChecksumAdd()
+ **********************************************************************/
+static uint32_t udp_pseudo(uint32_t src, uint32_t dst, uint16_t len)
+{
+	return (src >> 16) + (src & 0xFFFF) + (dst >> 16) + (dst & 0xFFFF) +
+			NET_HTONS(IP_PROTO_UDP) + NET_HTONS(len);
+}
+
+/*********************************************************************//**
+ * @brief		Write the Ethernet header of a frame
+ * @param[in]	f		Frame
+ * @param[in]	dst		Destination MAC address
+ * @param[in]	type	Ethernet type
+ * @return		None
+ **********************************************************************/
+static void net_eth_header(uint8_t *f, const uint8_t *dst, uint16_t type)
+{
+	memcpy(&f[ETH_DST], dst, 6);
+	memcpy(&f[ETH_SRC], net_cfg.Mac, 6);
+	NET_PUT16(&f[ETH_TYPE], type);
+}
+
+/*********************************************************************//**
+ * @brief		Send the frame waiting for ARP once its next hop is known
+ * @param[in]	None
+ * @return		None
+ **********************************************************************/
+static void net_flush(void)
+{
+	NET_ARP_T *e;
+
+	if (net_wait.bIndex == EMAC_PBUF_CALLER)
+	{
+		return;
+	}
+	e = arp_find(net_wait_ip);
+	if (e == NULL)
+	{
+		return;
+	}
+	memcpy(&net_wait.pbData[ETH_DST], e->Mac, 6);
+	if (EMAC_TxSend(&net_wait, 1) == SUCCESS)
+	{
+		net_stats.UdpSent++;
+	}
+}
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @addtogroup NET_Public_Functions
+ * @{
+ */
+
+/*********************************************************************//**
+ * @brief		Initialize the stack
+ * @param[in]	cfg		Interface addresses. The EMAC must be started
+ * 						with the same MAC address (EMAC_Init())
+ * @return		None
+ **********************************************************************/
+void NET_Init(const NET_CFG_Type *cfg)
+{
+	net_cfg = *cfg;
+	memset(&net_stats, 0, sizeof(net_stats));
+	memset(net_arp, 0, sizeof(net_arp));
+	memset(net_udp, 0, sizeof(net_udp));
+	net_ip_id = 0;
+	net_wait.bIndex = EMAC_PBUF_CALLER;
+}
+
+/*********************************************************************//**
+ * @brief		Process all frames waiting in the Rx ring
+ * @param[in]	None
+ * @return		Number of frames processed
+ *
+ * Note: Call from the main loop, e.g. when PacketReceived is set. Frames
+ * are handled in place and released as soon as they are done, UDP
+ * callbacks run from here.
+ **********************************************************************/
+uint32_t NET_Poll(void)
+{
+	EMAC_PBUF_Type rx;
+	uint32_t n = 0;
+
+	PacketReceived = FALSE;
+	while (EMAC_RxTake(&rx) == SUCCESS)
+	{
+		n++;
+		net_stats.RxFrames++;
+		if (rx.ulDataLen < NET_ETH_HLEN)
+		{
+			net_stats.RxDropped++;
+		}
+		else if (NET_GET16(&rx.pbData[ETH_TYPE]) == ETH_TYPE_ARP)
+		{
+			arp_input(rx.pbData, rx.ulDataLen);
+		}
+		else if (NET_GET16(&rx.pbData[ETH_TYPE]) == ETH_TYPE_IP)
+		{
+			ip_input(rx.pbData, rx.ulDataLen);
+		}
+		else
+		{
+			net_stats.RxDropped++;
+		}
+		EMAC_RxRelease(&rx);
+	}
+	net_flush();
+	return n;
+}
+
+/*********************************************************************//**
+ * @brief		Age the ARP cache and retry pending resolution
+ * @param[in]	None
+ * @return		None
+ *
+ * Note: Call once per second.
+ **********************************************************************/
+void NET_SecondTick(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < NET_ARP_ENTRIES; i++)
+	{
+		if ((net_arp[i].Ip != 0) && (++net_arp[i].Age > NET_ARP_MAX_AGE))
+		{
+			net_arp[i].Ip = 0;
+		}
+	}
+	if (net_wait.bIndex != EMAC_PBUF_CALLER)
+	{
+		if (++net_wait_age >= NET_ARP_WAIT)
+		{
+			EMAC_TxDiscard(&net_wait);
+		}
+		else
+		{
+			NET_ArpRequest(net_wait_ip);
+		}
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Get the stack statistics
+ * @param[out]	stats	Counters since NET_Init()
+ * @return		None
+ **********************************************************************/
+void NET_GetStats(NET_STATS_Type *stats)
+{
+	*stats = net_stats;
+}
+
+/*********************************************************************//**
+ * @brief		Look up the MAC address of a neighbour
+ * @param[in]	ip		IPv4 address
+ * @param[out]	mac		6 byte MAC address
+ * @return		SUCCESS, or ERROR if it is not in the ARP cache
+ **********************************************************************/
+Status NET_ArpLookup(uint32_t ip, uint8_t *mac)
+{
+	NET_ARP_T *e = arp_find(ip);
+
+	if (e == NULL)
+	{
+		return ERROR;
+	}
+	memcpy(mac, e->Mac, 6);
+	return SUCCESS;
+}
+
+/*********************************************************************//**
+ * @brief		Broadcast an ARP request, the answer is cached by NET_Poll()
+ * @param[in]	ip		IPv4 address to resolve
+ * @return		None
+ **********************************************************************/
+void NET_ArpRequest(uint32_t ip)
+{
+	arp_send(ARP_REQUEST, NULL, ip);
+}
+
+/*********************************************************************//**
+ * @brief		Add data to an Internet checksum (RFC 1071)
+ * @param[in]	sum		Partial sum of the preceding data, 0 to start
+ * @param[in]	data	Data at any alignment
+ * @param[in]	len		Length in bytes
+ * @return		Partial sum folded to 16 bits in memory byte order.
+ * 				Store ~sum to the checksum field; a block holding a valid
+ * 				checksum sums to 0xFFFF.
+ *
+ * Note: The bulk is added a 32 bit word at a time with end around carry.
+ * An odd start address is summed one byte off and swapped back.
+ **********************************************************************/
+uint32_t NET_ChecksumAdd(uint32_t sum, const uint8_t *data, uint32_t len)
+{
+	const uint32_t *w;
+	uint32_t acc = 0, odd, v;
+
+	odd = (uintptr_t)data & 1;
+	if (odd && len)
+	{
+		acc = (uint32_t)*data++ << 8;
+		len--;
+	}
+	if (((uintptr_t)data & 2) && (len >= 2))
+	{
+		acc += *(const uint16_t *)data;
+		data += 2;
+		len -= 2;
+	}
+
+	w = (const uint32_t *)data;
+	while (len >= 16)
+	{
+		v = w[0]; NET_ADDC(acc, v);
+		v = w[1]; NET_ADDC(acc, v);
+		v = w[2]; NET_ADDC(acc, v);
+		v = w[3]; NET_ADDC(acc, v);
+		w += 4;
+		len -= 16;
+	}
+	while (len >= 4)
+	{
+		v = *w++;
+		NET_ADDC(acc, v);
+		len -= 4;
+	}
+	data = (const uint8_t *)w;
+	if (len >= 2)
+	{
+		v = *(const uint16_t *)data;
+		NET_ADDC(acc, v);
+		data += 2;
+		len -= 2;
+	}
+	if (len)
+	{
+		v = *data;
+		NET_ADDC(acc, v);
+	}
+
+	acc = (acc >> 16) + (acc & 0xFFFF);
+	acc = (acc >> 16) + (acc & 0xFFFF);
+	if (odd)
+	{
+		acc = ((acc & 0xFF) << 8) | (acc >> 8);
+	}
+	sum += acc;
+	sum = (sum >> 16) + (sum & 0xFFFF);
+	return (sum >> 16) + (sum & 0xFFFF);
+}
+
+/*********************************************************************//**
+ * @brief		Open a UDP port
+ * @param[in]	port	Local port
+ * @param[in]	cb		Receive callback
+ * @return		SUCCESS, or ERROR if the port is taken or no socket is free
+ **********************************************************************/
+Status NET_UdpBind(uint16_t port, NET_UDP_CB_Type cb)
+{
+	NET_UDP_T *s = NULL;
+	uint32_t i;
+
+	if ((port == 0) || (cb == NULL))
+	{
+		return ERROR;
+	}
+	for (i = 0; i < NET_UDP_SOCKETS; i++)
+	{
+		if (net_udp[i].Port == port)
+		{
+			return ERROR;
+		}
+		if ((net_udp[i].Port == 0) && (s == NULL))
+		{
+			s = &net_udp[i];
+		}
+	}
+	if (s == NULL)
+	{
+		return ERROR;
+	}
+	s->Port = port;
+	s->Cb = cb;
+	return SUCCESS;
+}
+
+/*********************************************************************//**
+ * @brief		Close a UDP port
+ * @param[in]	port	Local port
+ * @return		None
+ **********************************************************************/
+void NET_UdpUnbind(uint16_t port)
+{
+	uint32_t i;
+
+	for (i = 0; i < NET_UDP_SOCKETS; i++)
+	{
+		if (net_udp[i].Port == port)
+		{
+			net_udp[i].Port = 0;
+		}
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Claim a Tx buffer for a datagram built in place
+ * @param[out]	pbuf	Claimed buffer, write the payload to
+ * 						NET_UDP_DATA(pbuf). ulDataLen holds the payload
+ * 						capacity
+ * @return		SUCCESS, or ERROR if all Tx buffers are in use
+ **********************************************************************/
+Status NET_UdpClaim(EMAC_PBUF_Type *pbuf)
+{
+	if (EMAC_TxClaim(pbuf) == ERROR)
+	{
+		return ERROR;
+	}
+	pbuf->ulDataLen = NET_UDP_MAX_DATA;
+	return SUCCESS;
+}
+
+/*********************************************************************//**
+ * @brief		Send a datagram built in a buffer from NET_UdpClaim()
+ * @param[in]	pbuf	Claimed buffer, passes to the stack on SUCCESS
+ * @param[in]	dstIp	Destination, NET_IP_BROADCAST for the local link
+ * @param[in]	srcPort	Source port
+ * @param[in]	dstPort	Destination port
+ * @param[in]	len		Payload length
+ * @return		SUCCESS if sent or parked until the next hop answers ARP,
+ * 				ERROR if it cannot be queued now (the buffer stays with
+ * 				the caller, to retry or discard)
+ *
+ * Note: One datagram at a time may wait for ARP. It is dropped when no
+ * answer came within NET_ARP_WAIT seconds of NET_SecondTick().
+ **********************************************************************/
+Status NET_UdpSend(EMAC_PBUF_Type *pbuf, uint32_t dstIp, uint16_t srcPort,
+		uint16_t dstPort, uint16_t len)
+{
+	static const uint8_t bcast[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+	uint8_t *f = pbuf->pbData;
+	uint8_t *udp = &f[NET_ETH_HLEN + NET_IP_HLEN];
+	uint32_t hop;
+	uint16_t csum;
+	NET_ARP_T *e = NULL;
+	Bool bc;
+
+	if (len > NET_UDP_MAX_DATA)
+	{
+		return ERROR;
+	}
+	bc = ((dstIp == NET_IP_BROADCAST) || (dstIp == (net_cfg.Ip | ~net_cfg.Mask))) ? TRUE : FALSE;
+	hop = ((dstIp ^ net_cfg.Ip) & net_cfg.Mask) ? net_cfg.Gateway : dstIp;
+	if (!bc)
+	{
+		if (hop == 0)
+		{
+			return ERROR;
+		}
+		e = arp_find(hop);
+		if ((e == NULL) && (net_wait.bIndex != EMAC_PBUF_CALLER))
+		{
+			return ERROR;
+		}
+	}
+
+	net_eth_header(f, (e != NULL) ? e->Mac : bcast, ETH_TYPE_IP);
+	f[IP_VHL] = 0x45;
+	f[IP_VHL + 1] = 0;
+	NET_PUT16(&f[IP_LEN], NET_IP_HLEN + 8 + len);
+	NET_PUT16(&f[IP_ID], net_ip_id);
+	net_ip_id++;
+	NET_PUT16(&f[IP_FRAG], IP_FLAG_DF);
+	f[IP_TTL] = NET_IP_TTL;
+	f[IP_PROTO] = IP_PROTO_UDP;
+	f[IP_CSUM] = 0;
+	f[IP_CSUM + 1] = 0;
+	memcpy(&f[IP_SRC], &net_cfg.Ip, 4);
+	memcpy(&f[IP_DST], &dstIp, 4);
+	csum = (uint16_t)~NET_ChecksumAdd(0, &f[IP_VHL], NET_IP_HLEN);
+	memcpy(&f[IP_CSUM], &csum, 2);
+
+	NET_PUT16(&udp[UDP_SPORT], srcPort);
+	NET_PUT16(&udp[UDP_DPORT], dstPort);
+	NET_PUT16(&udp[UDP_LEN], 8 + len);
+	udp[UDP_CSUM] = 0;
+	udp[UDP_CSUM + 1] = 0;
+	csum = (uint16_t)~NET_ChecksumAdd(udp_pseudo(net_cfg.Ip, dstIp, 8 + len), udp, 8 + len);
+	// A computed zero is sent as all ones, zero means no checksum
+	if (csum == 0)
+	{
+		csum = 0xFFFF;
+	}
+	memcpy(&udp[UDP_CSUM], &csum, 2);
+	pbuf->ulDataLen = NET_UDP_HLEN + len;
+
+	if (!bc && (e == NULL))
+	{
+		net_wait = *pbuf;
+		net_wait_ip = hop;
+		net_wait_age = 0;
+		pbuf->bIndex = EMAC_PBUF_CALLER;
+		NET_ArpRequest(hop);
+		return SUCCESS;
+	}
+	if (EMAC_TxSend(pbuf, 1) == ERROR)
+	{
+		return ERROR;
+	}
+	net_stats.UdpSent++;
+	return SUCCESS;
+}
+
+/*********************************************************************//**
+ * @brief		Copy a payload into a Tx buffer and send it
+ * @param[in]	dstIp	Destination, NET_IP_BROADCAST for the local link
+ * @param[in]	srcPort	Source port
+ * @param[in]	dstPort	Destination port
+ * @param[in]	data	Payload
+ * @param[in]	len		Payload length
+ * @return		SUCCESS, or ERROR as NET_UdpSend()
+ **********************************************************************/
+Status NET_UdpSendTo(uint32_t dstIp, uint16_t srcPort, uint16_t dstPort,
+		const uint8_t *data, uint16_t len)
+{
+	EMAC_PBUF_Type tx;
+
+	if ((len > NET_UDP_MAX_DATA) || (NET_UdpClaim(&tx) == ERROR))
+	{
+		return ERROR;
+	}
+	memcpy(NET_UDP_DATA(&tx), data, len);
+	if (NET_UdpSend(&tx, dstIp, srcPort, dstPort, len) == ERROR)
+	{
+		EMAC_TxDiscard(&tx);
+		return ERROR;
+	}
+	return SUCCESS;
+}
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -0,0 +1,1121 @@
+/******************************************************************//**
+* @file		lpc_prof.c
+* @brief	Contains all functions support for the cycle profiler on
+* 			LPC17xx: DWT CYCCNT scoped counters kept as a call tree,
+* 			per-ISR latency and duration histograms, a binary dump
+* 			over UART and its host side decoder
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @addtogroup PROF
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc_system_init.h"
+#include "lpc_prof.h"
+#include "lpc_crc.h"
+#ifdef LPC_HOST_SIM
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/* If this source file built with example, the LPC17xx FW library configuration
+ * file in each example directory ("lpc17xx_libcfg.h") must be included,
+ * otherwise the default FW library configuration file must be included instead
+ */
+
+/* Private Macros ------------------------------------------------------------- */
+/** @defgroup PROF_Private_Macros PROF Private Macros
+ * @{
+ */
+
+/** No node, slot or parent */
+#define PROF_NONE				0xFF
+/** Interrupts of the LPC17xx */
+#define PROF_NUM_IRQ			35
+/** Dump bytes gathered before each UART_Send() */
+#define PROF_OUT_SIZE			32
+
+/**
+ * @}
+ */
+
+
+/* Private Types -------------------------------------------------------------- */
+/** @defgroup PROF_Private_Types PROF Private Types
+ * @{
+ */
+
+/** Call tree node: one scope reached over one call path. Cycles exclude
+ * the interrupts that came in meanwhile. */
+typedef struct {
+	uint8_t id;
+	uint8_t parent;
+	uint8_t child;				/**< First child */
+	uint8_t next;				/**< Next sibling */
+	uint32_t count;
+	uint32_t max;				/**< Longest run, children included */
+	uint64_t total;				/**< Children included */
+	uint64_t self;				/**< Children excluded */
+} PROF_NODE_T;
+
+/** Scope or interrupt running */
+typedef struct {
+	uint8_t id;
+	uint8_t node;				/**< PROF_NONE when not timed */
+	uint32_t start;
+	uint32_t stolen;			/**< prof_isr_time at the start */
+	uint32_t child;				/**< Cycles of finished children */
+} PROF_FRAME_T;
+
+/** Interrupt histograms */
+typedef struct {
+	uint8_t irq;
+	uint32_t entries;
+	uint32_t immediate;			/**< Entries not seen pending before */
+	uint32_t max_lat;
+	uint32_t max_dur;
+	uint64_t total;
+	uint32_t lat[PROF_HIST_BUCKETS];
+	uint32_t dur[PROF_HIST_BUCKETS];
+} PROF_ISR_T;
+
+/** Dump output */
+typedef struct {
+	LPC_UART_TypeDef *UARTx;
+	uint8_t buf[PROF_OUT_SIZE];
+	uint32_t len;
+	uint32_t bytes;
+	uint16_t crc;
+} PROF_OUT_T;
+
+/**
+ * @}
+ */
+
+
+#ifdef PROF_MODE
+/* Private Variables ---------------------------------------------------------- */
+static PROF_NODE_T prof_node[PROF_NODES];
+static uint8_t prof_nodes, prof_root = PROF_NONE;
+
+static PROF_FRAME_T prof_stack[PROF_DEPTH];
+static uint8_t prof_depth;
+/** Interrupt cycles so far, frames subtract what came in while they ran */
+static uint32_t prof_isr_time;
+
+static PROF_ISR_T prof_isr[PROF_ISR_SLOTS];
+static uint8_t prof_isrs;
+static uint8_t prof_slot[PROF_NUM_IRQ];
+/** Interrupts with a slot, and those stamped pending at prof_pend[] */
+static uint32_t prof_irq_mask[2], prof_stamped[2];
+static uint32_t prof_pend[PROF_NUM_IRQ];
+
+static PROF_STATS_Type prof_stats;
+static __IO Bool prof_run;
+
+
+/* Private Functions ---------------------------------------------------------- */
+static uint32_t prof_bucket (uint32_t cycles);
+static uint8_t prof_find (uint8_t parent, uint8_t id);
+static void prof_enter (uint8_t id, Bool root);
+static PROF_FRAME_T *prof_leave (uint8_t id, uint32_t *net);
+static void prof_scan (uint32_t now);
+static void prof_put (PROF_OUT_T *o, uint8_t c);
+static void prof_varint (PROF_OUT_T *o, uint64_t v);
+static void prof_flush (PROF_OUT_T *o);
+
+/*********************************************************************//**
+ * @brief		Histogram bucket of a cycle count
+ * @param[in]	cycles: cycle count
+ * @return 		Bucket 0..PROF_HIST_BUCKETS-1
+ **********************************************************************/
+static uint32_t prof_bucket (uint32_t cycles)
+{
+	uint32_t b = 32 - __CLZ(cycles >> PROF_HIST_SHIFT);
+
+	return (b < PROF_HIST_BUCKETS) ? b : (PROF_HIST_BUCKETS - 1);
+}
+
+
+/*********************************************************************//**
+ * @brief		Node of a scope below a parent, added on its first run
+ * @param[in]	parent: parent node, PROF_NONE for a root
+ * @param[in]	id: scope id
+ * @return 		Node, PROF_NONE when the tree is full
+ **********************************************************************/
+static uint8_t prof_find (uint8_t parent, uint8_t id)
+{
+	uint8_t *link = (parent == PROF_NONE) ? &prof_root : &prof_node[parent].child;
+	PROF_NODE_T *n;
+	uint8_t i;
+
+	for (i = *link; i != PROF_NONE; i = prof_node[i].next)
+	{
+		if (prof_node[i].id == id)
+		{
+			return i;
+		}
+	}
+	if (prof_nodes == PROF_NODES)
+	{
+		prof_stats.NodeFull++;
+		return PROF_NONE;
+	}
+	i = prof_nodes++;
+	n = &prof_node[i];
+	n->id = id;
+	n->parent = parent;
+	n->child = PROF_NONE;
+	n->next = *link;
+	n->count = 0;
+	n->max = 0;
+	n->total = 0;
+	n->self = 0;
+	*link = i;
+	return i;
+}
+
+
+/*********************************************************************//**
+ * @brief		Push a frame, interrupts disabled
+ * @param[in]	id: scope id
+ * @param[in]	root: TRUE to start a new call path (interrupts)
+ * @return 		None
+ **********************************************************************/
+static void prof_enter (uint8_t id, Bool root)
+{
+	PROF_FRAME_T *f;
+	uint8_t parent = PROF_NONE;
+
+	if (prof_depth == PROF_DEPTH)
+	{
+		prof_stats.Overflow++;
+		return;
+	}
+	if (!root && prof_depth)
+	{
+		parent = prof_stack[prof_depth - 1].node;
+	}
+	f = &prof_stack[prof_depth++];
+	f->id = id;
+	// Below a scope that is not timed nothing is either
+	f->node = (!root && prof_depth > 1 && parent == PROF_NONE) ? PROF_NONE : prof_find(parent, id);
+	f->child = 0;
+	f->stolen = prof_isr_time;
+	f->start = PROF_Cycles();
+}
+
+
+/*********************************************************************//**
+ * @brief		Pop the innermost frame and account for it, interrupts
+ * 				disabled
+ * @param[in]	id: scope id, must match the innermost frame
+ * @param[out]	net: cycles of the frame less the interrupts inside it
+ * @return 		Frame, NULL when it does not match
+ **********************************************************************/
+static PROF_FRAME_T *prof_leave (uint8_t id, uint32_t *net)
+{
+	uint32_t now = PROF_Cycles();
+	PROF_FRAME_T *f;
+	PROF_NODE_T *n;
+	uint32_t c;
+
+	if ((prof_depth == 0) || (prof_stack[prof_depth - 1].id != id))
+	{
+		if (prof_run)
+		{
+			prof_stats.Mismatch++;
+		}
+		return NULL;
+	}
+	f = &prof_stack[--prof_depth];
+	c = (now - f->start) - (prof_isr_time - f->stolen);
+	if (f->node != PROF_NONE)
+	{
+		n = &prof_node[f->node];
+		n->count++;
+		n->total += c;
+		n->self += (c > f->child) ? (c - f->child) : 0;
+		if (c > n->max)
+		{
+			n->max = c;
+		}
+	}
+	// An interrupt is not a child of the scope it preempted
+	if (prof_depth && !(id & 0x80))
+	{
+		prof_stack[prof_depth - 1].child += c;
+	}
+	*net = c;
+	return f;
+}
+
+
+/*********************************************************************//**
+ * @brief		Stamp the profiled interrupts that are pending and not
+ * 				stamped yet: they wait from now on at the latest
+ * @param[in]	now: cycle counter
+ * @return 		None
+ **********************************************************************/
+static void prof_scan (uint32_t now)
+{
+	uint32_t i, p, b;
+
+	for (i = 0; i < 2; i++)
+	{
+		p = NVIC->ISPR[i] & prof_irq_mask[i] & ~prof_stamped[i];
+		prof_stamped[i] |= p;
+		while (p)
+		{
+			b = 31 - __CLZ(p);
+			prof_pend[(i << 5) + b] = now;
+			p &= ~(1UL << b);
+		}
+	}
+}
+
+
+/*********************************************************************//**
+ * @brief		Put one dump byte
+ * @param[in]	o: dump output
+ * @param[in]	c: byte
+ * @return 		None
+ **********************************************************************/
+static void prof_put (PROF_OUT_T *o, uint8_t c)
+{
+	o->buf[o->len++] = c;
+	if (o->len == PROF_OUT_SIZE)
+	{
+		prof_flush(o);
+	}
+}
+
+
+/*********************************************************************//**
+ * @brief		Put an unsigned LEB128 varint, 7 bits a byte, low first
+ * @param[in]	o: dump output
+ * @param[in]	v: value
+ * @return 		None
+ **********************************************************************/
+static void prof_varint (PROF_OUT_T *o, uint64_t v)
+{
+	while (v >= 0x80)
+	{
+		prof_put(o, (uint8_t)(v | 0x80));
+		v >>= 7;
+	}
+	prof_put(o, (uint8_t)v);
+}
+
+
+/*********************************************************************//**
+ * @brief		Send the gathered dump bytes
+ * @param[in]	o: dump output
+ * @return 		None
+ **********************************************************************/
+static void prof_flush (PROF_OUT_T *o)
+{
+	o->crc = CRC16_Update(o->crc, o->buf, o->len);
+	o->bytes += UART_Send(o->UARTx, o->buf, o->len, BLOCKING);
+	o->len = 0;
+}
+
+/* End of Private Functions --------------------------------------------------- */
+#endif /* PROF_MODE */
+
+
+/** @addtogroup PROF_Public_Functions
+ * @{
+ */
+
+#ifdef PROF_MODE
+/* Public Functions ----------------------------------------------------------- */
+/*********************************************************************//**
+ * @brief		Start the DWT cycle counter, measure the cost of a scope
+ * 				and start profiling with empty tables
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void PROF_Init (void)
+{
+	uint32_t primask, t;
+	uint8_t i;
+
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	PROF_DWT_CYCCNT = 0;
+	PROF_DWT_CTRL |= PROF_DWT_CYCCNTENA;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	prof_nodes = 0;
+	prof_root = PROF_NONE;
+	prof_depth = 0;
+	prof_isr_time = 0;
+	prof_isrs = 0;
+	for (i = 0; i < PROF_NUM_IRQ; i++)
+	{
+		prof_slot[i] = PROF_NONE;
+	}
+	prof_irq_mask[0] = prof_irq_mask[1] = 0;
+	prof_stamped[0] = prof_stamped[1] = 0;
+	prof_stats.Overflow = 0;
+	prof_stats.Mismatch = 0;
+	prof_stats.NodeFull = 0;
+	prof_stats.IsrFull = 0;
+	prof_run = TRUE;
+
+	// What a scope costs the code around it
+	t = PROF_Cycles();
+	PROF_Begin(PROF_ID_CALIBRATE);
+	PROF_End(PROF_ID_CALIBRATE);
+	prof_stats.Overhead = PROF_Cycles() - t;
+	prof_nodes = 0;
+	prof_root = PROF_NONE;
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		Start or pause profiling. Scopes running keep being
+ * 				timed to their end.
+ * @param[in]	NewState: ENABLE or DISABLE
+ * @return 		None
+ **********************************************************************/
+void PROF_Cmd (FunctionalState NewState)
+{
+	prof_run = (NewState == ENABLE) ? TRUE : FALSE;
+}
+
+
+/*********************************************************************//**
+ * @brief		Clear all counters and histograms. The call tree and the
+ * 				histogram slots are kept.
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void PROF_Reset (void)
+{
+	uint32_t primask, b;
+	uint8_t i;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	for (i = 0; i < prof_nodes; i++)
+	{
+		prof_node[i].count = 0;
+		prof_node[i].max = 0;
+		prof_node[i].total = 0;
+		prof_node[i].self = 0;
+	}
+	for (i = 0; i < prof_isrs; i++)
+	{
+		prof_isr[i].entries = 0;
+		prof_isr[i].immediate = 0;
+		prof_isr[i].max_lat = 0;
+		prof_isr[i].max_dur = 0;
+		prof_isr[i].total = 0;
+		for (b = 0; b < PROF_HIST_BUCKETS; b++)
+		{
+			prof_isr[i].lat[b] = 0;
+			prof_isr[i].dur[b] = 0;
+		}
+	}
+	prof_stats.Overflow = 0;
+	prof_stats.Mismatch = 0;
+	prof_stats.NodeFull = 0;
+	prof_stats.IsrFull = 0;
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		Start timing a scope. Use PROF_BEGIN(), which costs
+ * 				nothing without PROF_SEL.
+ *
+ * @par			Every PROF_Begin() needs a PROF_End() of the same id on
+ * 				each way out of the scope. A scope started inside another
+ * 				one is its child, the same scope reached over two call
+ * 				paths is counted twice.
+ * @param[in]	id: scope id, PROF_ID_xxx
+ * @return 		None
+ **********************************************************************/
+void PROF_Begin (uint8_t id)
+{
+	uint32_t primask;
+
+	if (!prof_run)
+	{
+		return;
+	}
+	primask = __get_PRIMASK();
+	__disable_irq();
+	prof_enter(id, FALSE);
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		End timing a scope. Use PROF_END().
+ * @param[in]	id: scope id given to PROF_Begin()
+ * @return 		None
+ **********************************************************************/
+void PROF_End (uint8_t id)
+{
+	uint32_t primask, net;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	prof_leave(id, &net);
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		First statement of an interrupt handler, use
+ * 				PROF_ISR_ENTER().
+ *
+ * @par			The latency is known when the request was seen pending
+ * 				before: raised with PROF_ISR_PEND(), or pending while
+ * 				another profiled handler ran (then it is the wait from
+ * 				that point on, a lower bound). Other entries count as
+ * 				immediate. Critical sections are not seen.
+ * @param[in]	irq: interrupt number, IRQn_Type
+ * @return 		None
+ **********************************************************************/
+void PROF_IsrEnter (uint8_t irq)
+{
+	uint32_t primask, now, bit, lat;
+	PROF_ISR_T *s;
+	uint8_t slot;
+
+	if (!prof_run || (irq >= PROF_NUM_IRQ))
+	{
+		return;
+	}
+	primask = __get_PRIMASK();
+	__disable_irq();
+	now = PROF_Cycles();
+	slot = prof_slot[irq];
+	if ((slot == PROF_NONE) && (prof_isrs < PROF_ISR_SLOTS))
+	{
+		slot = prof_isrs++;
+		prof_slot[irq] = slot;
+		prof_isr[slot].irq = irq;
+		prof_irq_mask[irq >> 5] |= 1UL << (irq & 0x1F);
+	}
+	if (slot != PROF_NONE)
+	{
+		s = &prof_isr[slot];
+		s->entries++;
+		bit = 1UL << (irq & 0x1F);
+		if (prof_stamped[irq >> 5] & bit)
+		{
+			prof_stamped[irq >> 5] &= ~bit;
+			lat = now - prof_pend[irq];
+			s->lat[prof_bucket(lat)]++;
+			if (lat > s->max_lat)
+			{
+				s->max_lat = lat;
+			}
+		}
+		else
+		{
+			s->immediate++;
+		}
+	}
+	else
+	{
+		prof_stats.IsrFull++;
+	}
+	prof_scan(now);
+	prof_enter(PROF_ID_IRQ(irq), TRUE);
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		Last statement of an interrupt handler, use
+ * 				PROF_ISR_EXIT(). The duration excludes nested interrupts.
+ * @param[in]	irq: interrupt number given to PROF_IsrEnter()
+ * @return 		None
+ **********************************************************************/
+void PROF_IsrExit (uint8_t irq)
+{
+	uint32_t primask, net;
+	PROF_ISR_T *s;
+
+	if (irq >= PROF_NUM_IRQ)
+	{
+		return;
+	}
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if (prof_leave(PROF_ID_IRQ(irq), &net) != NULL)
+	{
+		prof_isr_time += net;
+		if (prof_slot[irq] != PROF_NONE)
+		{
+			s = &prof_isr[prof_slot[irq]];
+			s->total += net;
+			s->dur[prof_bucket(net)]++;
+			if (net > s->max_dur)
+			{
+				s->max_dur = net;
+			}
+		}
+	}
+	if (prof_run)
+	{
+		prof_scan(PROF_Cycles());
+	}
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		Note the time an interrupt is requested, for code that
+ * 				raises it (software pend, starting a transfer). Use
+ * 				PROF_ISR_PEND().
+ * @param[in]	irq: interrupt number
+ * @return 		None
+ **********************************************************************/
+void PROF_IsrPend (uint8_t irq)
+{
+	uint32_t primask, bit;
+
+	if (!prof_run || (irq >= PROF_NUM_IRQ))
+	{
+		return;
+	}
+	bit = 1UL << (irq & 0x1F);
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if ((prof_irq_mask[irq >> 5] & bit) && !(prof_stamped[irq >> 5] & bit))
+	{
+		prof_stamped[irq >> 5] |= bit;
+		prof_pend[irq] = PROF_Cycles();
+	}
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		Send the tables as one binary frame, see
+ * 				PROF_DUMP_VERSION. Profiling pauses meanwhile, so the
+ * 				dump does not time itself.
+ * @param[in]	UARTx: UART to send on, initialized
+ * @return 		Bytes sent
+ **********************************************************************/
+uint32_t PROF_Dump (LPC_UART_TypeDef *UARTx)
+{
+	PROF_OUT_T o;
+	PROF_NODE_T n;
+	PROF_ISR_T *s;
+	uint32_t primask, b, entries, immediate, max_lat, max_dur;
+	uint64_t total;
+	Bool run = prof_run;
+	uint8_t i, nodes, isrs;
+
+	prof_run = FALSE;
+	o.UARTx = UARTx;
+	o.len = 0;
+	o.bytes = 0;
+	o.crc = CRC16_INIT;
+
+	prof_put(&o, 'P');
+	prof_put(&o, 'R');
+	prof_put(&o, 'O');
+	prof_put(&o, 'F');
+	prof_put(&o, PROF_DUMP_VERSION);
+	prof_varint(&o, SystemCoreClock);
+	prof_varint(&o, prof_stats.Overhead);
+	prof_varint(&o, prof_stats.Overflow);
+	prof_varint(&o, prof_stats.Mismatch);
+	prof_varint(&o, prof_stats.NodeFull);
+	prof_varint(&o, prof_stats.IsrFull);
+
+	// Nodes are only added, a parent always before its children
+	nodes = prof_nodes;
+	prof_varint(&o, nodes);
+	for (i = 0; i < nodes; i++)
+	{
+		primask = __get_PRIMASK();
+		__disable_irq();
+		n = prof_node[i];
+		__set_PRIMASK(primask);
+		prof_varint(&o, n.id);
+		prof_varint(&o, n.parent);
+		prof_varint(&o, n.count);
+		prof_varint(&o, n.max);
+		prof_varint(&o, n.total);
+		prof_varint(&o, n.self);
+	}
+
+	isrs = prof_isrs;
+	prof_varint(&o, isrs);
+	prof_varint(&o, PROF_HIST_BUCKETS);
+	for (i = 0; i < isrs; i++)
+	{
+		s = &prof_isr[i];
+		primask = __get_PRIMASK();
+		__disable_irq();
+		entries = s->entries;
+		immediate = s->immediate;
+		max_lat = s->max_lat;
+		max_dur = s->max_dur;
+		total = s->total;
+		__set_PRIMASK(primask);
+		prof_varint(&o, s->irq);
+		prof_varint(&o, entries);
+		prof_varint(&o, immediate);
+		prof_varint(&o, max_lat);
+		prof_varint(&o, max_dur);
+		prof_varint(&o, total);
+		for (b = 0; b < PROF_HIST_BUCKETS; b++)
+		{
+			prof_varint(&o, s->lat[b]);
+		}
+		for (b = 0; b < PROF_HIST_BUCKETS; b++)
+		{
+			prof_varint(&o, s->dur[b]);
+		}
+	}
+	prof_flush(&o);
+
+	o.buf[0] = (uint8_t)o.crc;
+	o.buf[1] = (uint8_t)(o.crc >> 8);
+	o.bytes += UART_Send(UARTx, o.buf, 2, BLOCKING);
+
+	prof_run = run;
+	return o.bytes;
+}
+
+
+/*********************************************************************//**
+ * @brief		Get the profiler counters
+ * @param[out]	stats: counters
+ * @return 		None
+ **********************************************************************/
+void PROF_GetStats (PROF_STATS_Type *stats)
+{
+	*stats = prof_stats;
+}
+#endif /* PROF_MODE */
+
+
+#ifdef LPC_HOST_SIM
+/* Host Decoder --------------------------------------------------------------- */
+/** Dump buffer of PROF_DecodeFile() */
+#define PROF_FILE_MAX			0x10000
+/** Width of the flame bars */
+#define PROF_BAR				24
+
+/** Decoded dump */
+typedef struct {
+	const uint8_t *p, *end;
+	Bool bad;
+} PROF_IN_T;
+
+typedef struct {
+	uint32_t id, parent, count, max;
+	uint64_t total, self;
+} PROF_DNODE_T;
+
+static const char *const prof_scope_name[] = {
+	"UART_Send", "SSP_ReadWrite", "I2C_MasterTransferData", "GLCD_Clear",
+	"GLCD_Window_Fill", "GLCD_Bitmap", "GLCD_Line", "GLCD_Rect",
+	"GLCD_Circle", "GLCD_Text", "GLCD_Dirty_Flush", "GLCD_Stream_Pixels",
+	"GLCD_Stream_Fill"
+};
+
+static const char *const prof_irq_name[PROF_NUM_IRQ] = {
+	"WDT", "TIMER0", "TIMER1", "TIMER2", "TIMER3", "UART0", "UART1", "UART2",
+	"UART3", "PWM1", "I2C0", "I2C1", "I2C2", "SPI", "SSP0", "SSP1", "PLL0",
+	"RTC", "EINT0", "EINT1", "EINT2", "EINT3", "ADC", "BOD", "USB", "CAN",
+	"DMA", "I2S", "ENET", "RIT", "MCPWM", "QEI", "PLL1", "USBActivity",
+	"CANActivity"
+};
+
+static PROF_DNODE_T prof_dnode[256];
+static char prof_text[256];
+static FMT_OUT_Type prof_stdout;
+
+static void prof_write (FMT_OUT_Type *out);
+static void prof_print (const char *format, ...);
+static uint64_t prof_get (PROF_IN_T *in);
+/*********************************************************************//**
+ * @brief		Name of a scope or interrupt id, buf holds 32 characters
+ **********************************************************************/
+static const char *prof_name (uint32_t id, char *buf);
+static const char *prof_u64 (uint64_t v, char *buf);
+/*********************************************************************//**
+ * @brief		Bar of PROF_BAR characters filled in the ratio v / full
+ **********************************************************************/
+static void prof_bar (uint64_t v, uint64_t full);
+static void prof_path (uint32_t n, uint32_t nodes);
+static const uint8_t *prof_frame (const uint8_t *buf, const uint8_t *end);
+
+/*********************************************************************//**
+ * @brief		Formatter sink writing to standard output
+ **********************************************************************/
+static void prof_write (FMT_OUT_Type *out)
+{
+	const char *p = out->Buf;
+	int n;
+
+	while ((out->Len > 0) && ((n = write(1, p, out->Len)) > 0))
+	{
+		p += n;
+		out->Len -= n;
+	}
+	out->Len = 0;
+}
+
+/*********************************************************************//**
+ * @brief		Format to standard output
+ **********************************************************************/
+static void prof_print (const char *format, ...)
+{
+	va_list ap;
+
+	va_start(ap, format);
+	FMT_VFormat(&prof_stdout, format, ap);
+	va_end(ap);
+}
+
+/*********************************************************************//**
+ * @brief		Read one varint, marks the input bad past its end
+ **********************************************************************/
+static uint64_t prof_get (PROF_IN_T *in)
+{
+	uint64_t v = 0;
+	uint32_t shift = 0;
+
+	while (in->p < in->end)
+	{
+		v |= (uint64_t)(*in->p & 0x7F) << shift;
+		if (!(*in->p++ & 0x80))
+		{
+			return v;
+		}
+		shift += 7;
+		if (shift > 63)
+		{
+			break;
+		}
+	}
+	in->bad = TRUE;
+	return 0;
+}
+
+/*********************************************************************//**
+ * @brief		Name of a scope or interrupt id, buf holds 32 characters
+ **********************************************************************/
+static const char *prof_name (uint32_t id, char *buf)
+{
+	if ((id & 0x80) && ((id & 0x7F) < PROF_NUM_IRQ))
+	{
+		FMT_Snprintf(buf, 32, "%s_IRQHandler", prof_irq_name[id & 0x7F]);
+	}
+	else if (id < sizeof(prof_scope_name) / sizeof(prof_scope_name[0]))
+	{
+		return prof_scope_name[id];
+	}
+	else if (id >= PROF_ID_USER)
+	{
+		FMT_Snprintf(buf, 32, "user%u", id - PROF_ID_USER);
+	}
+	else
+	{
+		FMT_Snprintf(buf, 32, "scope%u", id);
+	}
+	return buf;
+}
+
+/*********************************************************************//**
+ * @brief		64-bit count as text, the formatter stops at 32 bits
+ **********************************************************************/
+static const char *prof_u64 (uint64_t v, char *buf)
+{
+	char tmp[24];
+	uint32_t n = 0, i = 0;
+
+	do
+	{
+		tmp[n++] = (char)('0' + v % 10);
+		v /= 10;
+	} while (v);
+	while (n)
+	{
+		buf[i++] = tmp[--n];
+	}
+	buf[i] = 0;
+	return buf;
+}
+
+/*********************************************************************//**
+ * @brief		Bar of PROF_BAR characters filled in the ratio v / full
+ **********************************************************************/
+static void prof_bar (uint64_t v, uint64_t full)
+{
+	uint32_t i, w = full ? (uint32_t)((v * PROF_BAR + full / 2) / full) : 0;
+
+	for (i = 0; i < PROF_BAR; i++)
+	{
+		FMT_Putc(&prof_stdout, (i < w) ? '#' : ' ');
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Print the call path of a node, flamegraph.pl style
+ **********************************************************************/
+static void prof_path (uint32_t n, uint32_t nodes)
+{
+	char name[32];
+
+	if (prof_dnode[n].parent < nodes)
+	{
+		prof_path(prof_dnode[n].parent, nodes);
+	}
+	else
+	{
+		prof_print((prof_dnode[n].id & 0x80) ? "isr" : "main");
+	}
+	prof_print(";%s", prof_name(prof_dnode[n].id, name));
+}
+
+/*********************************************************************//**
+ * @brief		Decode and print one frame
+ * @param[in]	buf: frame, starting with "PROF"
+ * @param[in]	end: end of the data
+ * @return 		End of the frame, NULL if it is not a valid frame
+ **********************************************************************/
+static const uint8_t *prof_frame (const uint8_t *buf, const uint8_t *end)
+{
+	PROF_IN_T in;
+	uint32_t clk, over, lost[4], nodes, isrs, buckets, i, j, d, n;
+	uint32_t irq, entries, immediate, max_lat, max_dur, hist[2][32];
+	uint64_t total, all = 0;
+	uint16_t crc;
+	char name[32], num[3][24];
+
+	in.p = buf + 4;
+	in.end = end;
+	in.bad = (end - buf < 7) || (buf[4] != PROF_DUMP_VERSION);
+	if (in.bad)
+	{
+		return NULL;
+	}
+	in.p++;
+	clk = (uint32_t)prof_get(&in);
+	over = (uint32_t)prof_get(&in);
+	for (i = 0; i < 4; i++)
+	{
+		lost[i] = (uint32_t)prof_get(&in);
+	}
+	nodes = (uint32_t)prof_get(&in);
+	for (i = 0; (i < nodes) && (i < 256); i++)
+	{
+		prof_dnode[i].id = (uint32_t)prof_get(&in);
+		prof_dnode[i].parent = (uint32_t)prof_get(&in);
+		prof_dnode[i].count = (uint32_t)prof_get(&in);
+		prof_dnode[i].max = (uint32_t)prof_get(&in);
+		prof_dnode[i].total = prof_get(&in);
+		prof_dnode[i].self = prof_get(&in);
+		if (prof_dnode[i].parent >= i)
+		{
+			prof_dnode[i].parent = PROF_NONE;
+			all += prof_dnode[i].total;
+		}
+	}
+	isrs = (uint32_t)prof_get(&in);
+	buckets = (uint32_t)prof_get(&in);
+	if (in.bad || (nodes > 255) || (buckets > 32))
+	{
+		return NULL;
+	}
+
+	// The histograms are printed straight from the input, check it first
+	{
+		PROF_IN_T chk = in;
+
+		for (i = 0; i < isrs * (6 + 2 * buckets); i++)
+		{
+			prof_get(&chk);
+		}
+		if (chk.bad || (chk.end - chk.p < 2))
+		{
+			return NULL;
+		}
+		crc = CRC16_Calc(buf, (uint32_t)(chk.p - buf));
+		if ((chk.p[0] != (uint8_t)crc) || (chk.p[1] != (uint8_t)(crc >> 8)))
+		{
+			return NULL;
+		}
+	}
+
+	prof_print("PROF dump: %u Hz, scope overhead %u cycles\r\n", clk, over);
+	prof_print("lost: overflow %u, mismatch %u, node full %u, isr full %u\r\n\r\n",
+			   lost[0], lost[1], lost[2], lost[3]);
+
+	// Call tree depth first, children in the order they first ran
+	prof_print("Call tree (cycles less the interrupts that came in)\r\n");
+	prof_print("%10s %12s %12s %10s  %-*s  scope\r\n", "calls", "total", "self", "max", PROF_BAR, "share");
+	for (i = 0; i < nodes; i++)
+	{
+		if (prof_dnode[i].parent == PROF_NONE)
+		{
+			uint32_t stack[256], sp = 0;
+
+			stack[sp++] = i;
+			while (sp)
+			{
+				n = stack[--sp];
+				for (d = 0, j = n; prof_dnode[j].parent != PROF_NONE; j = prof_dnode[j].parent)
+				{
+					d++;
+				}
+				prof_print("%10u %12s %12s %10u  ", prof_dnode[n].count,
+						   prof_u64(prof_dnode[n].total, num[0]), prof_u64(prof_dnode[n].self, num[1]),
+						   prof_dnode[n].max);
+				prof_bar(prof_dnode[n].total, all);
+				prof_print("  %*s%s\r\n", 2 * d, "", prof_name(prof_dnode[n].id, name));
+				for (j = nodes; j-- > n + 1; )
+				{
+					if ((prof_dnode[j].parent == n) && (sp < 256))
+					{
+						stack[sp++] = j;
+					}
+				}
+			}
+		}
+	}
+
+	prof_print("\r\nFolded stacks (self cycles)\r\n");
+	for (i = 0; i < nodes; i++)
+	{
+		if (prof_dnode[i].self)
+		{
+			prof_path(i, nodes);
+			prof_print(" %s\r\n", prof_u64(prof_dnode[i].self, num[0]));
+		}
+	}
+
+	prof_print("\r\nInterrupts (cycles)\r\n");
+	for (i = 0; i < isrs; i++)
+	{
+		irq = (uint32_t)prof_get(&in);
+		entries = (uint32_t)prof_get(&in);
+		immediate = (uint32_t)prof_get(&in);
+		max_lat = (uint32_t)prof_get(&in);
+		max_dur = (uint32_t)prof_get(&in);
+		total = prof_get(&in);
+		for (j = 0; j < 2 * buckets; j++)
+		{
+			hist[j / buckets][j % buckets] = (uint32_t)prof_get(&in);
+		}
+		prof_print("%s: %u entries, %u immediate, max latency %u, max duration %u, mean %s\r\n",
+				   prof_name(PROF_ID_IRQ(irq), name), entries, immediate, max_lat, max_dur,
+				   prof_u64(entries ? total / entries : 0, num[0]));
+		prof_print("  %23s %10s %10s\r\n", "cycles", "latency", "duration");
+		for (j = 0; j < buckets; j++)
+		{
+			if (hist[0][j] || hist[1][j])
+			{
+				prof_u64(j ? (1ULL << (j + PROF_HIST_SHIFT - 1)) : 0, num[0]);
+				if (j == buckets - 1)
+				{
+					FMT_Snprintf(num[1], sizeof(num[1]), "%s+", num[0]);
+				}
+				else
+				{
+					FMT_Snprintf(num[1], sizeof(num[1]), "%s..%s", num[0],
+								 prof_u64((1ULL << (j + PROF_HIST_SHIFT)) - 1, num[2]));
+				}
+				prof_print("  %23s %10u %10u  ", num[1], hist[0][j], hist[1][j]);
+				prof_bar(hist[1][j], entries);
+				prof_print("\r\n");
+			}
+		}
+	}
+	prof_print("\r\n");
+	return in.p + 2;
+}
+
+/*********************************************************************//**
+ * @brief		Print every profiler dump found in a byte stream, for
+ * 				instance a UART capture with other output around it:
+ * 				the call tree with flame bars, folded stacks for
+ * 				flamegraph.pl and the interrupt histograms
+ * @param[in]	buf: captured bytes
+ * @param[in]	len: number of bytes
+ * @return 		SUCCESS if at least one dump was decoded
+ **********************************************************************/
+Status PROF_Decode (const uint8_t *buf, uint32_t len)
+{
+	const uint8_t *p = buf, *end = buf + len, *next;
+	Status ret = ERROR;
+
+	prof_stdout.Buf = prof_text;
+	prof_stdout.Size = sizeof(prof_text);
+	prof_stdout.Len = 0;
+	prof_stdout.Total = 0;
+	prof_stdout.Flush = prof_write;
+	prof_stdout.Arg = NULL;
+
+	while (end - p >= 4)
+	{
+		if ((p[0] == 'P') && (p[1] == 'R') && (p[2] == 'O') && (p[3] == 'F') &&
+			((next = prof_frame(p, end)) != NULL))
+		{
+			ret = SUCCESS;
+			p = next;
+		}
+		else
+		{
+			p++;
+		}
+	}
+	return ret;
+}
+
+/*********************************************************************//**
+ * @brief		PROF_Decode() of a file, such as a terminal log of the
+ * 				dump UART
+ * @param[in]	path: file name
+ * @return 		SUCCESS if at least one dump was decoded
+ **********************************************************************/
+Status PROF_DecodeFile (const char *path)
+{
+	static uint8_t buf[PROF_FILE_MAX];
+	int fd, n;
+	uint32_t len = 0;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+	{
+		return ERROR;
+	}
+	while ((len < sizeof(buf)) && ((n = read(fd, buf + len, sizeof(buf) - len)) > 0))
+	{
+		len += n;
+	}
+	close(fd);
+	return PROF_Decode(buf, len);
+}
+#endif /* LPC_HOST_SIM */
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -0,0 +1,567 @@
+/******************************************************************//**
+* @file		lpc_pwm_seq.c
+* @brief	Contains all functions support for the PWM1 duty engine
+* 			on LPC17xx
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @addtogroup PWMSEQ
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc_system_init.h"
+#include "lpc_pwm_seq.h"
+
+/* If this source file built with example, the LPC17xx FW library configuration
+ * file in each example directory ("lpc17xx_libcfg.h") must be included,
+ * otherwise the default FW library configuration file must be included instead
+ */
+
+/* Private Macros ------------------------------------------------------------- */
+/** @defgroup PWMSEQ_Private_Macros PWMSEQ Private Macros
+ * @{
+ */
+
+/** Brightness is kept as level 0..256 with 8 fraction bits */
+#define PWMSEQ_B(level)			((uint32_t)((level) + ((level) >> 7)) << 8)
+#define PWMSEQ_B_MAX			PWMSEQ_B(255)
+/** Gamma table: 33 points, 11 fraction bits of brightness between them */
+#define PWMSEQ_GAMMA_SHIFT		11
+
+/** Match register n of PWM1 */
+#define PWMSEQ_MR(n)			(*(((n) < 4) ? (&LPC_PWM1->MR0 + (n)) : (&LPC_PWM1->MR4 + ((n) - 4))))
+
+/**
+ * @}
+ */
+
+
+/* Private Types -------------------------------------------------------------- */
+/** @defgroup PWMSEQ_Private_Types PWMSEQ Private Types
+ * @{
+ */
+
+typedef struct {
+	/* Sequence, running while lv is not NULL */
+	const uint8_t *lv;
+	uint16_t count, idx;
+	uint16_t per, left;			/* Periods per entry and left to the next */
+	Bool loop;
+	uint8_t fade[2];			/* Sequence of PWMSEQ_Fade() */
+	/* Brightness and its change per period */
+	uint32_t b;
+	int32_t step;
+} PWMSEQ_CH_Type;
+
+/**
+ * @}
+ */
+
+
+/* Public Variables ----------------------------------------------------------- */
+static const uint8_t pwmseq_breathe[33] =
+{
+	  0,   2,  10,  21,  37,  57,  79, 103, 127, 152, 176, 198,
+	218, 234, 245, 253, 255, 253, 245, 234, 218, 198, 176, 152,
+	128, 103,  79,  57,  37,  21,  10,   2,   0
+};
+
+/** Breathing curve, 32 steps of 62 ms that loop */
+const PWMSEQ_SEQ_Type PWMSEQ_Breathe =
+{
+	pwmseq_breathe, 33, PWMSEQ_PERIODS(PWMSEQ_FREQ_HZ, 62), TRUE
+};
+
+
+/* Private Variables ---------------------------------------------------------- */
+/** Duty of brightness (i/32)^2.2, the extra entry closes the interpolation */
+static const uint16_t pwmseq_gamma[33] =
+{
+	    0,    12,    57,   140,   264,   431,   644,   904,
+	 1213,  1571,  1981,  2443,  2959,  3528,  4153,  4834,
+	 5572,  6366,  7220,  8131,  9103, 10134, 11226, 12380,
+	13595, 14872, 16213, 17616, 19083, 20615, 22211, 23873,
+	25600
+};
+
+static PWMSEQ_CH_Type pwmseq_ch[PWMSEQ_CHANNELS];
+/** Duty of each channel, index 0 unused, and the match values per duty
+ * step in 16 fraction bits */
+static uint16_t pwmseq_duty[PWMSEQ_CHANNELS + 1];
+static uint32_t pwmseq_counts, pwmseq_scale;
+/** Match registers to latch, bit n is MRn */
+static uint32_t pwmseq_dirty;
+
+static PWMSEQ_STATS_Type pwmseq_stats;
+
+
+/* Private Functions ---------------------------------------------------------- */
+static uint16_t pwmseq_gamma_b (uint32_t b);
+static void pwmseq_stage (uint8_t ch, uint16_t duty);
+static void pwmseq_latch (void);
+static void pwmseq_segment (PWMSEQ_CH_Type *c);
+static void pwmseq_start (uint8_t ch);
+
+/*********************************************************************//**
+ * @brief		Duty of a brightness, interpolated on the gamma table
+ * @param[in]	b: brightness, 0..PWMSEQ_B_MAX
+ * @return 		Duty
+ **********************************************************************/
+static uint16_t pwmseq_gamma_b (uint32_t b)
+{
+	uint32_t i = b >> PWMSEQ_GAMMA_SHIFT;
+	uint32_t f = b & ((1 << PWMSEQ_GAMMA_SHIFT) - 1);
+
+	if (i >= 32)
+	{
+		return pwmseq_gamma[32];
+	}
+	return (uint16_t)(pwmseq_gamma[i] + (((pwmseq_gamma[i + 1] - pwmseq_gamma[i]) * f) >> PWMSEQ_GAMMA_SHIFT));
+}
+
+
+/*********************************************************************//**
+ * @brief		Set the duty of a channel for the next latch
+ * @param[in]	ch: channel 1..6
+ * @param[in]	duty: duty, PWMSEQ_PCT() units
+ * @return 		None
+ **********************************************************************/
+static void pwmseq_stage (uint8_t ch, uint16_t duty)
+{
+	if (duty > PWMSEQ_DUTY_FULL)
+	{
+		duty = PWMSEQ_DUTY_FULL;
+	}
+	if (duty != pwmseq_duty[ch])
+	{
+		pwmseq_duty[ch] = duty;
+		pwmseq_dirty |= 1UL << ch;
+	}
+}
+
+
+/*********************************************************************//**
+ * @brief		Write the staged match registers and latch them all at the
+ * 				next MR0. Latches still pending are taken back first and
+ * 				set again with the new ones, so no period can see a part
+ * 				of the update. Called with interrupts off.
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+static void pwmseq_latch (void)
+{
+	uint32_t pend, n;
+
+	if (pwmseq_dirty == 0)
+	{
+		return;
+	}
+	pend = LPC_PWM1->LER & PWM_LER_BITMASK;
+	LPC_PWM1->LER = 0;
+	if (pwmseq_dirty & 0x01)
+	{
+		LPC_PWM1->MR0 = pwmseq_counts - 1;
+	}
+	for (n = 1; n <= PWMSEQ_CHANNELS; n++)
+	{
+		if (pwmseq_dirty & (1UL << n))
+		{
+			PWMSEQ_MR(n) = (uint32_t)(((uint64_t)pwmseq_duty[n] * pwmseq_scale) >> 16);
+		}
+	}
+	LPC_PWM1->LER = pend | pwmseq_dirty;
+	pwmseq_dirty = 0;
+	pwmseq_stats.Latches++;
+}
+
+
+/*********************************************************************//**
+ * @brief		Start the step from the current sequence entry to the next
+ * @param[in]	c: channel state
+ * @return 		None
+ **********************************************************************/
+static void pwmseq_segment (PWMSEQ_CH_Type *c)
+{
+	c->b = PWMSEQ_B(c->lv[c->idx]);
+	c->step = ((int32_t)PWMSEQ_B(c->lv[c->idx + 1]) - (int32_t)c->b) / c->per;
+	c->left = c->per;
+}
+
+
+/*********************************************************************//**
+ * @brief		Let the MR0 interrupt run the sequence of a channel.
+ * 				Called with interrupts off.
+ * @param[in]	ch: channel 1..6
+ * @return 		None
+ **********************************************************************/
+static void pwmseq_start (uint8_t ch)
+{
+	pwmseq_stage(ch, pwmseq_gamma_b(pwmseq_ch[ch - 1].b));
+	pwmseq_latch();
+	PWM_ClearIntPending(LPC_PWM1, PWM_INTSTAT_MR0);
+	LPC_PWM1->MCR |= PWM_MCR_INT_ON_MATCH(0);
+}
+
+/* End of Private Functions --------------------------------------------------- */
+
+
+/** @addtogroup PWMSEQ_Public_Functions
+ * @{
+ */
+
+/* Public Functions ----------------------------------------------------------- */
+/*********************************************************************//**
+ * @brief		Initialize PWM1 as a single edge PWM at a frequency, all
+ * 				channels at 0% and their outputs off
+ * @param[in]	hz: PWM frequency, PWMSEQ_FREQ_HZ is the default
+ * @return 		None
+ **********************************************************************/
+void PWMSEQ_Init (uint32_t hz)
+{
+	PWM_TIMERCFG_Type cfg;
+	PWM_MATCHCFG_Type mat;
+	uint8_t n;
+
+	NVIC_DisableIRQ(PWM1_IRQn);
+	cfg.PrescaleOption = PWM_TIMER_PRESCALE_TICKVAL;
+	cfg.PrescaleValue = 1;
+	PWM_Init(LPC_PWM1, PWM_MODE_TIMER, &cfg);
+
+	// MR0 ends the period, its interrupt only runs while a sequence does
+	mat.MatchChannel = 0;
+	mat.IntOnMatch = DISABLE;
+	mat.ResetOnMatch = ENABLE;
+	mat.StopOnMatch = DISABLE;
+	PWM_ConfigMatch(LPC_PWM1, &mat);
+	for (n = 2; n <= PWMSEQ_CHANNELS; n++)
+	{
+		PWM_ChannelConfig(LPC_PWM1, n, PWM_CHANNEL_SINGLE_EDGE);
+	}
+
+	for (n = 0; n < PWMSEQ_CHANNELS; n++)
+	{
+		pwmseq_ch[n].lv = NULL;
+		pwmseq_ch[n].b = 0;
+		pwmseq_duty[n + 1] = 0;
+	}
+	pwmseq_counts = PWMSEQ_COUNTS(hz);
+	pwmseq_scale = (uint32_t)(((uint64_t)pwmseq_counts << 16) / PWMSEQ_DUTY_FULL);
+	pwmseq_dirty = 0x7F;
+	pwmseq_latch();
+
+	PWM_ResetCounter(LPC_PWM1);
+	PWM_CounterCmd(LPC_PWM1, ENABLE);
+	PWM_Cmd(LPC_PWM1, ENABLE);
+
+	NVIC_SetPriority(PWM1_IRQn, 3);
+	NVIC_EnableIRQ(PWM1_IRQn);
+}
+
+
+/*********************************************************************//**
+ * @brief		Change the PWM frequency, the duties are kept. The new
+ * 				period and matches take effect together.
+ * @param[in]	hz: PWM frequency
+ * @return 		None
+ **********************************************************************/
+void PWMSEQ_SetFreq (uint32_t hz)
+{
+	uint32_t primask;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	pwmseq_counts = PWMSEQ_COUNTS(hz);
+	pwmseq_scale = (uint32_t)(((uint64_t)pwmseq_counts << 16) / PWMSEQ_DUTY_FULL);
+	pwmseq_dirty = 0x7F;
+	pwmseq_latch();
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		Connect or disconnect the output pin of a channel
+ * @param[in]	ch: channel 1..6, PWM1.n is on P2.n-1
+ * @param[in]	NewState: ENABLE or DISABLE
+ * @return 		None
+ **********************************************************************/
+void PWMSEQ_ChannelCmd (uint8_t ch, FunctionalState NewState)
+{
+	PINSEL_CFG_Type pin;
+
+	if ((ch < 1) || (ch > PWMSEQ_CHANNELS))
+	{
+		return;
+	}
+	pin.Portnum = 2;
+	pin.Pinnum = ch - 1;
+	pin.Funcnum = (NewState == ENABLE) ? 1 : 0;
+	pin.OpenDrain = 0;
+	pin.Pinmode = 0;
+	PINSEL_ConfigPin(&pin);
+	PWM_ChannelCmd(LPC_PWM1, ch, NewState);
+}
+
+
+/*********************************************************************//**
+ * @brief		Set the duty of a channel and stop its sequence. Takes
+ * 				effect with PWMSEQ_Latch().
+ * @param[in]	ch: channel 1..6
+ * @param[in]	duty: duty, PWMSEQ_PCT() units
+ * @return 		None
+ **********************************************************************/
+void PWMSEQ_SetDuty (uint8_t ch, uint16_t duty)
+{
+	uint32_t primask;
+
+	if ((ch < 1) || (ch > PWMSEQ_CHANNELS))
+	{
+		return;
+	}
+	primask = __get_PRIMASK();
+	__disable_irq();
+	pwmseq_ch[ch - 1].lv = NULL;
+	pwmseq_stage(ch, duty);
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		Set the gamma corrected level of a channel and stop its
+ * 				sequence. Takes effect with PWMSEQ_Latch().
+ * @param[in]	ch: channel 1..6
+ * @param[in]	level: level 0..255
+ * @return 		None
+ **********************************************************************/
+void PWMSEQ_SetLevel (uint8_t ch, uint8_t level)
+{
+	uint32_t primask;
+
+	if ((ch < 1) || (ch > PWMSEQ_CHANNELS))
+	{
+		return;
+	}
+	primask = __get_PRIMASK();
+	__disable_irq();
+	pwmseq_ch[ch - 1].lv = NULL;
+	pwmseq_ch[ch - 1].b = PWMSEQ_B(level);
+	pwmseq_stage(ch, pwmseq_gamma_b(pwmseq_ch[ch - 1].b));
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		Apply the duties set since the last latch. All of them
+ * 				change together at the start of the next period, the
+ * 				counter is not disturbed.
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void PWMSEQ_Latch (void)
+{
+	uint32_t primask;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	pwmseq_latch();
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		Gamma corrected duty of a level
+ * @param[in]	level: level 0..255
+ * @return 		Duty, PWMSEQ_PCT() units
+ **********************************************************************/
+uint16_t PWMSEQ_Gamma (uint8_t level)
+{
+	return pwmseq_gamma_b(PWMSEQ_B(level));
+}
+
+
+/*********************************************************************//**
+ * @brief		Run a level sequence on a channel from the MR0 interrupt
+ * @param[in]	ch: channel 1..6
+ * @param[in]	seq: sequence, must stay valid while it runs
+ * @return 		SUCCESS, or ERROR if the channel or sequence is invalid
+ **********************************************************************/
+Status PWMSEQ_Play (uint8_t ch, const PWMSEQ_SEQ_Type *seq)
+{
+	PWMSEQ_CH_Type *c;
+	uint32_t primask;
+
+	if ((ch < 1) || (ch > PWMSEQ_CHANNELS) || (seq->Count < 2) || (seq->Periods == 0))
+	{
+		return ERROR;
+	}
+	c = &pwmseq_ch[ch - 1];
+	primask = __get_PRIMASK();
+	__disable_irq();
+	c->lv = seq->Level;
+	c->count = seq->Count;
+	c->per = seq->Periods;
+	c->loop = seq->Loop;
+	c->idx = 0;
+	pwmseq_segment(c);
+	pwmseq_start(ch);
+	__set_PRIMASK(primask);
+
+	return SUCCESS;
+}
+
+
+/*********************************************************************//**
+ * @brief		Fade a channel from its current level to a new one,
+ * 				linearly in brightness
+ * @param[in]	ch: channel 1..6
+ * @param[in]	level: level 0..255 to end at
+ * @param[in]	periods: PWM periods the fade takes, see PWMSEQ_PERIODS()
+ * @return 		SUCCESS, or ERROR if the channel is invalid
+ **********************************************************************/
+Status PWMSEQ_Fade (uint8_t ch, uint8_t level, uint16_t periods)
+{
+	PWMSEQ_CH_Type *c;
+	uint32_t primask;
+
+	if ((ch < 1) || (ch > PWMSEQ_CHANNELS))
+	{
+		return ERROR;
+	}
+	c = &pwmseq_ch[ch - 1];
+	primask = __get_PRIMASK();
+	__disable_irq();
+	c->fade[0] = 0;
+	c->fade[1] = level;
+	c->lv = c->fade;
+	c->count = 2;
+	c->per = (periods != 0) ? periods : 1;
+	c->loop = FALSE;
+	c->idx = 0;
+	// Start from where the channel is, not from fade[0]
+	c->step = ((int32_t)PWMSEQ_B(level) - (int32_t)c->b) / c->per;
+	c->left = c->per;
+	pwmseq_start(ch);
+	__set_PRIMASK(primask);
+
+	return SUCCESS;
+}
+
+
+/*********************************************************************//**
+ * @brief		Stop the sequence or fade of a channel at its current level
+ * @param[in]	ch: channel 1..6
+ * @return 		None
+ **********************************************************************/
+void PWMSEQ_Hold (uint8_t ch)
+{
+	if ((ch >= 1) && (ch <= PWMSEQ_CHANNELS))
+	{
+		pwmseq_ch[ch - 1].lv = NULL;
+	}
+}
+
+
+/*********************************************************************//**
+ * @brief		Check a channel for a running sequence or fade
+ * @param[in]	ch: channel 1..6
+ * @return 		TRUE while one runs
+ **********************************************************************/
+Bool PWMSEQ_Busy (uint8_t ch)
+{
+	if ((ch < 1) || (ch > PWMSEQ_CHANNELS))
+	{
+		return FALSE;
+	}
+	return (pwmseq_ch[ch - 1].lv != NULL) ? TRUE : FALSE;
+}
+
+
+/*********************************************************************//**
+ * @brief		MR0 interrupt, called from PWM1_IRQHandler: move the
+ * 				running sequences on by one period and latch the new
+ * 				duties together. Turns itself off when none runs.
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void PWMSEQ_IntHandler (void)
+{
+	PWMSEQ_CH_Type *c;
+	Bool run = FALSE;
+	uint8_t n;
+
+	if (PWM_GetIntStatus(LPC_PWM1, PWM_INTSTAT_MR0) == RESET)
+	{
+		return;
+	}
+	PWM_ClearIntPending(LPC_PWM1, PWM_INTSTAT_MR0);
+	pwmseq_stats.Periods++;
+
+	for (n = 0; n < PWMSEQ_CHANNELS; n++)
+	{
+		c = &pwmseq_ch[n];
+		if (c->lv == NULL)
+		{
+			continue;
+		}
+		c->b += c->step;
+		if (--c->left == 0)
+		{
+			if (++c->idx < c->count - 1)
+			{
+				pwmseq_segment(c);
+			}
+			else if (c->loop == TRUE)
+			{
+				c->idx = 0;
+				pwmseq_segment(c);
+			}
+			else
+			{
+				// Land exactly on the last level
+				c->b = PWMSEQ_B(c->lv[c->count - 1]);
+				c->lv = NULL;
+			}
+		}
+		if (c->b > PWMSEQ_B_MAX)
+		{
+			c->b = PWMSEQ_B_MAX;
+		}
+		pwmseq_stage(n + 1, pwmseq_gamma_b(c->b));
+		if (c->lv != NULL)
+		{
+			run = TRUE;
+		}
+	}
+	pwmseq_latch();
+
+	if (run == FALSE)
+	{
+		LPC_PWM1->MCR &= ~PWM_MCR_INT_ON_MATCH(0);
+	}
+}
+
+
+/*********************************************************************//**
+ * @brief		Get the engine counters
+ * @param[out]	stats: pointer to PWMSEQ_STATS_Type
+ * @return 		None
+ **********************************************************************/
+void PWMSEQ_GetStats (PWMSEQ_STATS_Type *stats)
+{
+	*stats = pwmseq_stats;
+}
+
+/**
+ * @}
+ */
+
+/* End of Public Functions ---------------------------------------------------- */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
@@ -0,0 +1,468 @@
+/******************************************************************//**
+* @file		lpc_sched.c
+* @brief	Contains all functions support for the SysTick timer wheel
+*           and the cooperative task scheduler
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+/* Peripheral group ----------------------------------------------------------- */
+/** @addtogroup SCHED
+ * @{
+ */
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc_sched.h"
+
+/* If this source file built with example, the LPC17xx FW library configuration
+ * file in each example directory ("lpc17xx_libcfg.h") must be included,
+ * otherwise the default FW library configuration file must be included instead
+ */
+
+/* Private Macros ------------------------------------------------------------- */
+/** @defgroup SCHED_Private_Macros SCHED Private Macros
+ * @{
+ */
+
+#define SCHED_WHEEL_MASK	(SCHED_WHEEL_SLOTS - 1)
+/** Slot of tick t at level l */
+#define SCHED_SLOT(t, l)	(((t) >> (SCHED_WHEEL_BITS * (l))) & SCHED_WHEEL_MASK)
+/** Ticks spanned by the levels up to and including l */
+#define SCHED_SPAN(l)		(1UL << (SCHED_WHEEL_BITS * ((l) + 1)))
+
+/**
+ * @}
+ */
+
+
+/* Private Variables ---------------------------------------------------------- */
+/** Timer wheel, each slot heads a list of pending timers */
+static SCHED_TIMER_Type *sched_wheel[SCHED_WHEEL_LEVELS][SCHED_WHEEL_SLOTS];
+static __IO uint32_t sched_ticks;
+/** Tick the wheel positions are relative to, the first not yet expired */
+static uint32_t sched_base;
+
+/** Ready queues, bit n of sched_ready set while queue n holds a task */
+static SCHED_TASK_Type *sched_head[SCHED_PRIO_LEVELS];
+static SCHED_TASK_Type *sched_tail[SCHED_PRIO_LEVELS];
+static __IO uint32_t sched_ready;
+/** Priority of the running task, SCHED_PRIO_LEVELS outside any task */
+static uint8_t sched_prio = SCHED_PRIO_LEVELS;
+
+static SCHED_STATS_Type sched_stats;
+
+
+/* Private Functions ---------------------------------------------------------- */
+/*********************************************************************//**
+ * @brief		Unlink a pending timer from its slot
+ * @param[in]	tmr: timer
+ * @return 		None
+ **********************************************************************/
+static void sched_unlink (SCHED_TIMER_Type *tmr)
+{
+	*tmr->pprev = tmr->next;
+	if (tmr->next != NULL)
+	{
+		tmr->next->pprev = tmr->pprev;
+	}
+	tmr->next = NULL;
+	tmr->pprev = NULL;
+}
+
+
+/*********************************************************************//**
+ * @brief		Link a timer into the slot its expiry falls in, the
+ * 				lowest level whose span still reaches it
+ * @param[in]	tmr: timer, not pending
+ * @return 		None
+ **********************************************************************/
+static void sched_add (SCHED_TIMER_Type *tmr)
+{
+	SCHED_TIMER_Type **slot;
+	uint32_t delta = tmr->Expires - sched_base;
+	uint32_t l;
+
+	if ((int32_t)delta < 0)
+	{
+		// Overdue, expire on the first tick not processed yet
+		slot = &sched_wheel[0][SCHED_SLOT(sched_base, 0)];
+	}
+	else
+	{
+		for (l = 0; (l < SCHED_WHEEL_LEVELS - 1) && (delta >= SCHED_SPAN(l)); l++);
+		if (delta >= SCHED_SPAN(l))
+		{
+			// Past the wheel, park in the last slot and cascade again
+			slot = &sched_wheel[l][SCHED_SLOT(sched_base + SCHED_SPAN(l) - 1, l)];
+		}
+		else
+		{
+			slot = &sched_wheel[l][SCHED_SLOT(tmr->Expires, l)];
+		}
+	}
+	tmr->next = *slot;
+	if (tmr->next != NULL)
+	{
+		tmr->next->pprev = &tmr->next;
+	}
+	*slot = tmr;
+	tmr->pprev = slot;
+}
+
+
+/*********************************************************************//**
+ * @brief		Move the timers of an upper level slot down the wheel
+ * @param[in]	- l: level 1 .. SCHED_WHEEL_LEVELS-1
+ * 				- idx: slot
+ * @return 		None
+ **********************************************************************/
+static void sched_cascade (uint32_t l, uint32_t idx)
+{
+	SCHED_TIMER_Type *tmr;
+
+	while ((tmr = sched_wheel[l][idx]) != NULL)
+	{
+		sched_unlink(tmr);
+		sched_add(tmr);
+		sched_stats.Cascaded++;
+	}
+}
+
+
+/*********************************************************************//**
+ * @brief		Highest priority ready queue above the running task
+ * @param[in]	None
+ * @return 		Queue number, SCHED_PRIO_LEVELS when none
+ * Note: Call with interrupts disabled.
+ **********************************************************************/
+static uint32_t sched_next (void)
+{
+	uint32_t ready = sched_ready & ((1UL << sched_prio) - 1);
+
+	return ready ? (31 - __CLZ(ready & -ready)) : SCHED_PRIO_LEVELS;
+}
+
+/* End of Private Functions --------------------------------------------------- */
+
+
+/* Public Functions ----------------------------------------------------------- */
+/** @addtogroup SCHED_Public_Functions
+ * @{
+ */
+
+/*********************************************************************//**
+ * @brief		Clear the timer wheel and the ready queues
+ * @param[in]	None
+ * @return 		None
+ * Note: Call before SYSTICK_Config() starts the tick.
+ **********************************************************************/
+void SCHED_Init (void)
+{
+	uint32_t l, i;
+
+	for (l = 0; l < SCHED_WHEEL_LEVELS; l++)
+	{
+		for (i = 0; i < SCHED_WHEEL_SLOTS; i++)
+		{
+			sched_wheel[l][i] = NULL;
+		}
+	}
+	for (i = 0; i < SCHED_PRIO_LEVELS; i++)
+	{
+		sched_head[i] = NULL;
+		sched_tail[i] = NULL;
+	}
+	sched_ready = 0;
+	sched_ticks = 0;
+	sched_base = 1;
+	sched_prio = SCHED_PRIO_LEVELS;
+}
+
+
+/*********************************************************************//**
+ * @brief		Advance the wheel by one tick and call the callbacks of
+ * 				the timers that expired, from SysTick_Handler
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void SCHED_Tick (void)
+{
+	SCHED_TIMER_Type *list, *tmr;
+	uint32_t primask, l;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+
+	sched_base = ++sched_ticks;
+	// Each time a level wraps the next slot of the level above comes down
+	for (l = 1; (l < SCHED_WHEEL_LEVELS) && (SCHED_SLOT(sched_base, l - 1) == 0); l++)
+	{
+		sched_cascade(l, SCHED_SLOT(sched_base, l));
+	}
+
+	// Take the slot over, callbacks may stop timers still on it
+	list = sched_wheel[0][SCHED_SLOT(sched_base, 0)];
+	sched_wheel[0][SCHED_SLOT(sched_base, 0)] = NULL;
+	if (list != NULL)
+	{
+		list->pprev = &list;
+	}
+	sched_base++;
+
+	while ((tmr = list) != NULL)
+	{
+		sched_unlink(tmr);
+		sched_stats.Expired++;
+		__set_PRIMASK(primask);
+		tmr->Callback(tmr);
+		__disable_irq();
+		// Restarted or stopped by the callback otherwise
+		if ((tmr->pprev == NULL) && tmr->Period)
+		{
+			tmr->Expires += tmr->Period;
+			sched_add(tmr);
+		}
+	}
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		Get the tick count
+ * @param[in]	None
+ * @return 		SysTick ticks since SCHED_Init(), 1 ms each
+ **********************************************************************/
+uint32_t SCHED_GetTicks (void)
+{
+	return sched_ticks;
+}
+
+
+/*********************************************************************//**
+ * @brief		Set up a timer
+ * @param[in]	- tmr: timer
+ * 				- cb: expiry callback
+ * 				- arg: free for the caller
+ * @return 		None
+ **********************************************************************/
+void SCHED_TimerInit (SCHED_TIMER_Type *tmr, SCHED_TIMER_CB_Type cb, void *arg)
+{
+	tmr->Callback = cb;
+	tmr->Arg = arg;
+	tmr->Expires = 0;
+	tmr->Period = 0;
+	tmr->next = NULL;
+	tmr->pprev = NULL;
+}
+
+
+/*********************************************************************//**
+ * @brief		Start or restart a timer, O(1)
+ * @param[in]	- tmr: timer set up with SCHED_TimerInit()
+ * 				- delay: ticks to the first expiry, 0 for the next tick
+ * 				- period: ticks between later expiries, 0 for one shot
+ * @return 		None
+ **********************************************************************/
+void SCHED_TimerStart (SCHED_TIMER_Type *tmr, uint32_t delay, uint32_t period)
+{
+	uint32_t primask;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if (tmr->pprev != NULL)
+	{
+		sched_unlink(tmr);
+	}
+	tmr->Expires = sched_ticks + (delay ? delay : 1);
+	tmr->Period = period;
+	sched_add(tmr);
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		Stop a timer, O(1). A periodic timer stopped from its
+ * 				own callback is not restarted.
+ * @param[in]	tmr: timer
+ * @return 		None
+ **********************************************************************/
+void SCHED_TimerStop (SCHED_TIMER_Type *tmr)
+{
+	uint32_t primask;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if (tmr->pprev != NULL)
+	{
+		sched_unlink(tmr);
+	}
+	tmr->Period = 0;
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		Check whether a timer waits for its expiry
+ * @param[in]	tmr: timer
+ * @return 		TRUE while pending
+ **********************************************************************/
+Bool SCHED_TimerPending (SCHED_TIMER_Type *tmr)
+{
+	return (tmr->pprev != NULL) ? TRUE : FALSE;
+}
+
+
+/*********************************************************************//**
+ * @brief		Set up a task
+ * @param[in]	- task: task
+ * 				- func: task body
+ * 				- arg: free for the caller
+ * 				- prio: SCHED_PRIO_HIGH .. SCHED_PRIO_LOW
+ * @return 		None
+ **********************************************************************/
+void SCHED_TaskInit (SCHED_TASK_Type *task, SCHED_TASK_CB_Type func, void *arg, uint8_t prio)
+{
+	task->Func = func;
+	task->Arg = arg;
+	task->Prio = (prio < SCHED_PRIO_LEVELS) ? prio : SCHED_PRIO_LOW;
+	task->Posted = 0;
+	task->Next = NULL;
+}
+
+
+/*********************************************************************//**
+ * @brief		Make a task ready, from thread mode, a timer callback or
+ * 				any interrupt. A task already waiting is not queued twice.
+ * @param[in]	task: task set up with SCHED_TaskInit()
+ * @return 		None
+ **********************************************************************/
+void SCHED_Post (SCHED_TASK_Type *task)
+{
+	uint32_t primask;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if (!task->Posted)
+	{
+		task->Posted = 1;
+		task->Next = NULL;
+		if (sched_head[task->Prio] == NULL)
+		{
+			sched_head[task->Prio] = task;
+		}
+		else
+		{
+			sched_tail[task->Prio]->Next = task;
+		}
+		sched_tail[task->Prio] = task;
+		sched_ready |= 1UL << task->Prio;
+	}
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		Run the highest priority ready task to completion. From
+ * 				inside a task only tasks of higher priority are run.
+ * @param[in]	None
+ * @return 		TRUE when a task ran
+ **********************************************************************/
+Bool SCHED_Dispatch (void)
+{
+	SCHED_TASK_Type *task;
+	uint32_t primask, prio;
+	uint8_t save;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	prio = sched_next();
+	if (prio == SCHED_PRIO_LEVELS)
+	{
+		__set_PRIMASK(primask);
+		return FALSE;
+	}
+	task = sched_head[prio];
+	sched_head[prio] = task->Next;
+	if (sched_head[prio] == NULL)
+	{
+		sched_ready &= ~(1UL << prio);
+	}
+	// The task may post itself again while it runs
+	task->Posted = 0;
+	__set_PRIMASK(primask);
+
+	save = sched_prio;
+	sched_prio = (uint8_t)prio;
+	task->Func(task);
+	sched_prio = save;
+	sched_stats.Dispatched++;
+	return TRUE;
+}
+
+
+/*********************************************************************//**
+ * @brief		Yield point for code waiting on time or an event: run
+ * 				one ready task, or sleep until the next interrupt when
+ * 				there is none
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void SCHED_Yield (void)
+{
+	uint32_t primask;
+
+	sched_stats.Yields++;
+	if (SCHED_Dispatch())
+	{
+		return;
+	}
+	// WFI wakes on a pending interrupt with PRIMASK set, so a task
+	// posted after the check above is not slept over
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if (sched_next() == SCHED_PRIO_LEVELS)
+	{
+		sched_stats.Sleeps++;
+		__WFI();
+	}
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		Scheduler main loop, never returns
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void SCHED_Run (void)
+{
+	while (1)
+	{
+		SCHED_Yield();
+	}
+}
+
+
+/*********************************************************************//**
+ * @brief		Get the scheduler counters
+ * @param[out]	stats: pointer to SCHED_STATS_Type
+ * @return 		None
+ **********************************************************************/
+void SCHED_GetStats (SCHED_STATS_Type *stats)
+{
+	*stats = sched_stats;
+	stats->Ticks = sched_ticks;
+}
+
+/**
+ * @}
+ */
+
+/* End of Public Functions ---------------------------------------------------- */
+
+/**
+ * @}
+ */
+
+/* --------------------------------- End Of File ------------------------------ */
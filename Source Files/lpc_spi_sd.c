@@ -20,73 +20,340 @@
  * otherwise the default FW library configuration file must be included instead
  */
 
+/* Private Macros ------------------------------------------------------------- */
+/** Application command flag for sd_cmd(), CMD55 is sent first */
+#define SD_ACMD		0x80
 
-/** @addtogroup SD_Public_Functions
- * @{
- */
+/* Public Variables ----------------------------------------------------------- */
+uint8_t sd_cmd_buf[SD_CMD_BLOCK_LENGTH];
+uint8_t sd_data_buf[SD_DATA_BLOCK_LENGTH];
 
-/* Public Functions ----------------------------------------------------------- */
+/* Private Variables ---------------------------------------------------------- */
+static sd_card_type sd_type = SD_CARD_NONE;
+static uint32_t sd_blocks;
+static uint32_t sd_clock;
+static uint32_t sd_crc_errors;
+
+
+/* Private Functions ---------------------------------------------------------- */
 /*********************************************************************//**
- * @brief		check if SD card is inserted or not
+ * @brief		Exchange one byte on the SPI bus, /CS is left as it is
+ * @param[in]	tx: byte to send
+ * @return 		byte received
+ **********************************************************************/
+static uint8_t sd_xchg (uint8_t tx)
+{
+	LPC_SPI->SPDR = tx;
+	while (!(LPC_SPI->SPSR & SPI_SPSR_SPIF));
+	return (uint8_t)LPC_SPI->SPDR;
+}
+
+
+/*********************************************************************//**
+ * @brief		Assert /CS for a whole command and data transaction
  * @param[in]	none
- * @return 		SD_CONNECTED or SD_DISCONNECTED
+ * @return 		none
  **********************************************************************/
-sd_connect_status SD_GetCardConnectStatus (void)
+static void sd_select (void)
 {
-	sd_connect_status ret=SD_DISCONNECTED;
+	CS_Force(DISABLE);
+	sd_xchg(0xFF);
+}
 
-	if((GPIO_ReadValue(4)&_BIT(29))== 0)
-		ret = SD_CONNECTED;
 
+/*********************************************************************//**
+ * @brief		Release /CS, one more byte lets the card release DO
+ * @param[in]	none
+ * @return 		none
+ **********************************************************************/
+static void sd_deselect (void)
+{
+	CS_Force(ENABLE);
+	sd_xchg(0xFF);
+}
+
+
+/*********************************************************************//**
+ * @brief		Wait until the card stops holding DO low (busy)
+ * @param[in]	timeout: byte times to wait
+ * @return 		SD_OK or SD_ERROR_TIMEOUT
+ **********************************************************************/
+static sd_error sd_wait_ready (uint32_t timeout)
+{
+	while (sd_xchg(0xFF) != 0xFF)
+	{
+		if (timeout-- == 0) return SD_ERROR_TIMEOUT;
+	}
+	return SD_OK;
+}
+
+
+/*********************************************************************//**
+ * @brief		Send a command frame and wait for its R1
+ * @param[in]	- cmd: command code, ORed with SD_ACMD for an
+ * 					   application command
+ * 				- arg: 32 bit argument
+ * @return 		R1, 0xFF if the card did not answer
+ **********************************************************************/
+static uint8_t sd_cmd (uint8_t cmd, uint32_t arg)
+{
+	uint8_t frame[SD_CMD_BLOCK_LENGTH];
+	uint8_t r1, i;
+
+	if (cmd & SD_ACMD)
+	{
+		r1 = sd_cmd(CMD55_APP_CMD, 0);
+		if (r1 > R1_IDLE) return r1;
+		cmd &= ~SD_ACMD;
+	}
+	if (cmd != CMD0_GO_IDLE_STATE)
+	{
+		sd_wait_ready(SD_BUSY_TIMEOUT);
+	}
+
+	frame[0] = 0x40 | (cmd & 0x3f);
+	frame[1] = (uint8_t)(arg >> 24);
+	frame[2] = (uint8_t)(arg >> 16);
+	frame[3] = (uint8_t)(arg >> 8);
+	frame[4] = (uint8_t)arg;
+	frame[5] = (CRC7_Calc(frame, 5) << 1) | 0x01;
+	for (i = 0; i < SD_CMD_BLOCK_LENGTH; i++)
+	{
+		sd_xchg(frame[i]);
+	}
+	// The byte following CMD12 is a stuff byte
+	if (cmd == CMD12_STOP_TRANSMISSION)
+	{
+		sd_xchg(0xFF);
+	}
+
+	// R1 within Ncr (8 bytes)
+	for (i = 0; i < 10; i++)
+	{
+		r1 = sd_xchg(0xFF);
+		if (GETBIT(r1, 7) == 0) break;
+	}
+	return r1;
+}
+
+
+/*********************************************************************//**
+ * @brief		Receive a data block and check its CRC-16
+ * @param[in]	- buf: pointer to receive buffer
+ * 				- len: block length
+ * @return 		SD_OK, SD_ERROR_TIMEOUT, SD_ERROR_TOKEN or SD_ERROR_CRC
+ **********************************************************************/
+static sd_error sd_rx_block (uint8_t *buf, uint32_t len)
+{
+	uint32_t i;
+	uint16_t crc;
+	uint8_t token;
+
+	i = 0;
+	while ((token = sd_xchg(0xFF)) == 0xFF)
+	{
+		if (i++ > SD_TOKEN_TIMEOUT) return SD_ERROR_TIMEOUT;
+	}
+	// Anything else than the start token is a data error token
+	if (token != SD_TOKEN_START) return SD_ERROR_TOKEN;
+
+	for (i = 0; i < len; i++)
+	{
+		buf[i] = sd_xchg(0xFF);
+	}
+	crc = (uint16_t)(sd_xchg(0xFF) << 8);
+	crc |= sd_xchg(0xFF);
+
+	if (crc != CRC16_Calc(buf, len)) return SD_ERROR_CRC;
+	return SD_OK;
+}
+
+
+/*********************************************************************//**
+ * @brief		Send a data block and wait for programming to finish
+ * @param[in]	- buf: pointer to SD_BLOCK_SIZE bytes
+ * 				- token: SD_TOKEN_START or SD_TOKEN_MULTI_START
+ * @return 		SD_OK, SD_ERROR_CRC, SD_ERROR_DATA or SD_ERROR_TIMEOUT
+ **********************************************************************/
+static sd_error sd_tx_block (const uint8_t *buf, uint8_t token)
+{
+	uint16_t crc = CRC16_Calc(buf, SD_BLOCK_SIZE);
+	uint32_t i;
+	uint8_t resp;
+
+	sd_xchg(token);
+	for (i = 0; i < SD_BLOCK_SIZE; i++)
+	{
+		sd_xchg(buf[i]);
+	}
+	sd_xchg((uint8_t)(crc >> 8));
+	sd_xchg((uint8_t)crc);
+
+	resp = sd_xchg(0xFF) & SD_DATA_RESP_MASK;
+	if (resp == SD_DATA_CRC_ERR) return SD_ERROR_CRC;
+	if (resp != SD_DATA_ACCEPTED) return SD_ERROR_DATA;
+	return sd_wait_ready(SD_BUSY_TIMEOUT);
+}
+
+
+/*********************************************************************//**
+ * @brief		Map a failing R1 to an error code
+ * @param[in]	r1: R1 response
+ * @return 		SD_ERROR_RANGE, SD_ERROR_TIMEOUT or SD_NG
+ **********************************************************************/
+static sd_error sd_r1_error (uint8_t r1)
+{
+	if (r1 == 0xFF) return SD_ERROR_TIMEOUT;
+	if (r1 & (R1_ADDR_ERR | R1_PARAM_ERR)) return SD_ERROR_RANGE;
+	return SD_NG;
+}
+
+
+/*********************************************************************//**
+ * @brief		Read consecutive blocks in one CMD17/CMD18 transaction
+ * @param[in]	- block: first block
+ * 				- buf: pointer to receive buffer
+ * 				- count: number of blocks
+ * 				- done: returns the blocks read and verified
+ * @return 		error code of the first failing block
+ **********************************************************************/
+static sd_error sd_read (uint32_t block, uint8_t *buf, uint32_t count, uint32_t *done)
+{
+	uint32_t addr = (sd_type == SD_CARD_HC) ? block : (block * SD_BLOCK_SIZE);
+	sd_error ret;
+	uint8_t r1;
+
+	*done = 0;
+	sd_select();
+	r1 = sd_cmd((count == 1) ? CMD17_READ_SINGLE_BLOCK : CMD18_READ_MULTIPLE_BLOCK, addr);
+	if (r1 != R1_NOERROR)
+	{
+		sd_deselect();
+		return sd_r1_error(r1);
+	}
+	do
+	{
+		ret = sd_rx_block(buf, SD_BLOCK_SIZE);
+		if (ret != SD_OK) break;
+		buf += SD_BLOCK_SIZE;
+	} while (++(*done) < count);
+
+	if (count > 1)
+	{
+		sd_cmd(CMD12_STOP_TRANSMISSION, 0);
+		sd_wait_ready(SD_BUSY_TIMEOUT);
+	}
+	sd_deselect();
 	return ret;
 }
 
 
 /*********************************************************************//**
- * @brief		Calculate CRC-7 as required by SD specification
- * @param[in]	- old_crc: 0x00 to start new CRC
- * 			    or value from previous call to continue.
- * 				- data: data byte to add to CRC computation
- * @return 		CRC-7 checksum which MUST be augmented by crc_7augment() before used
+ * @brief		Write consecutive blocks in one CMD24/CMD25 transaction
+ * @param[in]	- block: first block
+ * 				- buf: pointer to data
+ * 				- count: number of blocks
+ * 				- done: returns the blocks accepted and programmed
+ * @return 		error code of the first failing block
  **********************************************************************/
-uint8_t CRC_7 (uint8_t old_crc, uint8_t data)
+static sd_error sd_write (uint32_t block, const uint8_t *buf, uint32_t count, uint32_t *done)
 {
-	uint8_t new_crc,x;
+	uint32_t addr = (sd_type == SD_CARD_HC) ? block : (block * SD_BLOCK_SIZE);
+	sd_error ret;
+	uint8_t r1;
 
-	new_crc = old_crc;
-	for (x = 7; x >= 0; x--)
+	*done = 0;
+	sd_select();
+	if (count == 1)
 	{
-		new_crc <<= 1;
-		new_crc |= GETBIT(data,x);
-		if (GETBIT(new_crc, 7) == 1)
-		{
-			new_crc ^= 0x89; /*CRC-7's polynomial is x^7 + x^3 + 1*/
-		}
-		if(x==0) break;
+		r1 = sd_cmd(CMD24_WRITE_BLOCK, addr);
 	}
-	return new_crc;
+	else
+	{
+		// Pre-erase hint, lets the card program the whole run faster
+		sd_cmd(SD_ACMD | ACMD23_SET_WR_BLK_ERASE_COUNT, count);
+		r1 = sd_cmd(CMD25_WRITE_MULTIPLE_BLOCK, addr);
+	}
+	if (r1 != R1_NOERROR)
+	{
+		sd_deselect();
+		return sd_r1_error(r1);
+	}
+	do
+	{
+		ret = sd_tx_block(buf, (count == 1) ? SD_TOKEN_START : SD_TOKEN_MULTI_START);
+		if (ret != SD_OK) break;
+		buf += SD_BLOCK_SIZE;
+	} while (++(*done) < count);
+
+	if (count > 1)
+	{
+		// Card goes busy one byte after the stop token
+		sd_xchg(SD_TOKEN_STOP_TRAN);
+		sd_xchg(0xFF);
+		sd_wait_ready(SD_BUSY_TIMEOUT);
+	}
+	if (ret != SD_OK)
+	{
+		// Read the R2 status to clear the error condition
+		sd_cmd(CMD13_SEND_STATUS, 0);
+		sd_xchg(0xFF);
+	}
+	sd_deselect();
+	return ret;
 }
 
 
 /*********************************************************************//**
- * @brief		Provides the zero-padding final step to CRC-7
- * @param[in]	- old_crc: value from last crc_7()call
- * @return 		Finalized CRC-7 checksum
+ * @brief		Capacity and transfer speed from the CSD register
+ * @param[in]	csd: pointer to 16 CSD bytes
+ * @return 		none
  **********************************************************************/
-uint8_t CRC_7Final (uint8_t old_crc)
+static void sd_parse_csd (const uint8_t *csd)
 {
-	uint8_t new_crc,x;
+	static const uint8_t tran_value[16] = { 0, 10, 12, 13, 15, 20, 25, 30,
+											35, 40, 45, 50, 55, 60, 70, 80 };
+	static const uint32_t tran_unit[4] = { 10000, 100000, 1000000, 10000000 };
+	uint32_t c_size, shift;
 
-	new_crc = old_crc;
-	for (x = 0; x < 7; x++)
+	if ((csd[0] >> 6) == 1)
 	{
-		new_crc <<= 1;
-		if (GETBIT(new_crc, 7) == 1)
-		{
-			new_crc ^= 0x89; /*CRC-7's polynomial is x^7 + x^3 + 1*/
-		}
+		// CSD v2.0: C_SIZE[69:48] in 512KB units
+		c_size = ((uint32_t)(csd[7] & 0x3F) << 16) | ((uint32_t)csd[8] << 8) | csd[9];
+		sd_blocks = (c_size + 1) << 10;
 	}
-	return new_crc;
+	else
+	{
+		// CSD v1.0: (C_SIZE + 1) * 2^(C_SIZE_MULT + 2) * 2^READ_BL_LEN
+		c_size = ((uint32_t)(csd[6] & 0x03) << 10) | ((uint32_t)csd[7] << 2) | (csd[8] >> 6);
+		shift = ((((csd[9] & 0x03) << 1) | (csd[10] >> 7)) + 2) + (csd[5] & 0x0F) - 9;
+		sd_blocks = (c_size + 1) << shift;
+	}
+	sd_clock = tran_value[(csd[3] >> 3) & 0x0F] * tran_unit[csd[3] & 0x03];
+}
+
+
+/* End of Private Functions --------------------------------------------------- */
+
+
+/** @addtogroup SD_Public_Functions
+ * @{
+ */
+
+/* Public Functions ----------------------------------------------------------- */
+/*********************************************************************//**
+ * @brief		check if SD card is inserted or not
+ * @param[in]	none
+ * @return 		SD_CONNECTED or SD_DISCONNECTED
+ **********************************************************************/
+sd_connect_status SD_GetCardConnectStatus (void)
+{
+	sd_connect_status ret=SD_DISCONNECTED;
+
+	if((GPIO_ReadValue(4)&_BIT(29))== 0)
+		ret = SD_CONNECTED;
+
+	return ret;
 }
 
 
@@ -126,7 +393,7 @@ uint32_t SD_SendReceiveData_Polling (void* tx_buf, void* rx_buf, uint32_t length
  **********************************************************************/
 void SD_SendCommand(uint8_t cmd, uint8_t *arg)
 {
-	uint8_t crc = 0x00;
+	uint8_t crc;
 
 	/* First byte has framing bits and command */
 	sd_cmd_buf[0] = 0x40 | (cmd & 0x3f);
@@ -135,12 +402,7 @@ void SD_SendCommand(uint8_t cmd, uint8_t *arg)
 	sd_cmd_buf[3] = arg[2];
 	sd_cmd_buf[4] = arg[3];
 	//calculate CRC
-	crc = CRC_7(crc, sd_cmd_buf[0]);//start new crc-7
-	crc = CRC_7(crc, sd_cmd_buf[1]);
-	crc = CRC_7(crc, sd_cmd_buf[2]);
-	crc = CRC_7(crc, sd_cmd_buf[3]);
-	crc = CRC_7(crc, sd_cmd_buf[4]);
-	crc = CRC_7Final(crc);
+	crc = CRC7_Calc(sd_cmd_buf, 5);
 	sd_cmd_buf[5] = (crc << 1) | 0x01;//stop bit
 
 	SD_SendReceiveData_Polling(sd_cmd_buf,NULL,SD_CMD_BLOCK_LENGTH);
@@ -241,65 +503,115 @@ sd_error SD_WaitDeviceIdle (uint32_t num_char)
 
 
 /*********************************************************************//**
- * @brief		Initialize SD card in SPI mode
+ * @brief		Initialize SD card in SPI mode. Identification runs at
+ * 				SD_CLOCK_INIT, afterwards the SPI clock is raised to the
+ * 				card's TRAN_SPEED (at most SD_CLOCK_MAX and PCLK/8).
  * @param[in]	- retries: number retry time
  * @return 		initialization successful or terminated with specific error code
  **********************************************************************/
 sd_error SD_Init (uint8_t retries)
 {
-	uint8_t rxdata,errors;
-	uint8_t SD_arg[4]={0,0,0,0};
-	uint16_t i;
+	sd_card_type type;
+	uint8_t r1,errors;
+	uint8_t resp[16];
+	uint32_t arg,i;
+
+	sd_type = SD_CARD_NONE;
+	sd_crc_errors = 0;
 
 	// check for SD card insertion
 	printf(LPC_UART0,"\n\rPlease plug-in SD card!");
 	while(SD_GetCardConnectStatus()==SD_DISCONNECTED);
 	printf(LPC_UART0,"...Connected!\n\r");
-	// Wait for bus idle
-	if(SD_WaitDeviceIdle(160) != SD_OK) return SD_ERROR_BUS_NOT_IDLE;
+
+	// Identification clock, at least 74 clocks with CS high
+	CLKPWR_SetPCLKDiv(CLKPWR_PCLKSEL_SPI, CLKPWR_PCLKSEL_CCLK_DIV_4);
+	SPI_SetClock(LPC_SPI, SD_CLOCK_INIT);
+	CS_Force(ENABLE);
+	for (i = 0; i < 10; i++) sd_xchg(0xFF);
 	printf(LPC_UART0,"Initialize SD card in SPI mode...");
 
-	errors = 0;
 	/* Send the CMD0_GO_IDLE_STATE while CS is asserted */
 	/* This signals the SD card to fall back to SPI mode */
-	while(errors < retries)
+	sd_select();
+	for (errors = 0; errors < retries; errors++)
 	{
-		SD_SendCommand(CMD0_GO_IDLE_STATE, SD_arg);
-		if(SD_WaitR1(&rxdata,0,1000)!= SD_OK)
-		{
-			errors++;
-			continue;
-		}
-		if(rxdata != R1_IDLE)
+		if (sd_cmd(CMD0_GO_IDLE_STATE, 0) == R1_IDLE) break;
+	}
+	if(errors >= retries)
+	{
+		sd_deselect();
+		return SD_ERROR_CMD0;
+	}
+
+	/* SD v2 cards echo the check pattern, v1 cards reject CMD8 */
+	type = SD_CARD_V1;
+	arg = 0;
+	r1 = sd_cmd(CMD8_SEND_IF_COND, 0x1AA);
+	if (r1 == R1_IDLE)
+	{
+		for (i = 0; i < 4; i++) resp[i] = sd_xchg(0xFF);
+		if (((resp[2] & 0x0F) != 0x01) || (resp[3] != 0xAA))
 		{
-			errors++;
-			continue;
+			sd_deselect();
+			return SD_ERROR_CMD8;
 		}
-		else break;
+		type = SD_CARD_V2;
+		arg = 0x40000000;		// HCS: host supports SDHC
 	}
-	if(errors >= retries)return SD_ERROR_CMD0;
-    printf(LPC_UART0,"I have cleared errors");
-	/* Check if the card is not MMC */
+
 	/* Start its internal initialization process */
-	while(1)
+	for (i = 0; ; i++)
 	{
-		SD_SendCommand(CMD55_APP_CMD, SD_arg);
-		if(SD_WaitR1(&rxdata,0,1000)!= SD_OK) return SD_ERROR_CMD55;
+		r1 = sd_cmd(SD_ACMD | ACMD41_SEND_OP_COND, arg);
+		if (r1 == R1_NOERROR) break;
+		if ((r1 != R1_IDLE) || (i >= SD_INIT_TIMEOUT))
+		{
+			sd_deselect();
+			return SD_ERROR_ACMD41;
+		}
+	}
 
-		SD_SendCommand(ACMD41_SEND_OP_COND, SD_arg);
-		SD_WaitR1(&rxdata,0,1000);
-		if (rxdata & R1_IDLE) //in_idle_state = 1
-			for (i = 0; i < 1000; i++); /* wait for a while */
-		else
-			break; //in_idle_state=0 --> ready
+	/* CCS bit of the OCR tells block addressing */
+	if (type == SD_CARD_V2)
+	{
+		if (sd_cmd(CMD58_READ_OCR, 0) != R1_NOERROR)
+		{
+			sd_deselect();
+			return SD_ERROR_CMD58;
+		}
+		for (i = 0; i < 4; i++) resp[i] = sd_xchg(0xFF);
+		if (resp[0] & 0x40) type = SD_CARD_HC;
 	}
-	printf(LPC_UART0,"I have cleared waiting");
+
 	/* Enable CRC */
-	SD_arg[3] = 0x01;
-	SD_SendCommand(CMD59_CRC_ON_OFF, SD_arg);
-	if(SD_WaitR1(&rxdata,0,1000)!= SD_OK) return SD_ERROR_CMD59;
-	if(rxdata != R1_NOERROR) return SD_ERROR_CMD59;
+	if (sd_cmd(CMD59_CRC_ON_OFF, 1) != R1_NOERROR)
+	{
+		sd_deselect();
+		return SD_ERROR_CMD59;
+	}
+	if ((type != SD_CARD_HC) && (sd_cmd(CMD16_SET_BLOCKLEN, SD_BLOCK_SIZE) != R1_NOERROR))
+	{
+		sd_deselect();
+		return SD_NG;
+	}
 
+	/* Capacity and speed */
+	if ((sd_cmd(CMD9_SEND_CSD, 0) != R1_NOERROR) || (sd_rx_block(resp, 16) != SD_OK))
+	{
+		sd_deselect();
+		return SD_NG;
+	}
+	sd_deselect();
+	sd_parse_csd(resp);
+
+	// Ramp up: SPI runs from CCLK, SPI_SetClock() keeps at or below target
+	if ((sd_clock == 0) || (sd_clock > SD_CLOCK_MAX)) sd_clock = SD_CLOCK_MAX;
+	CLKPWR_SetPCLKDiv(CLKPWR_PCLKSEL_SPI, CLKPWR_PCLKSEL_CCLK_DIV_1);
+	SPI_SetClock(LPC_SPI, sd_clock);
+	sd_clock = CLKPWR_GetPCLK(CLKPWR_PCLKSEL_SPI) / (LPC_SPI->SPCCR & 0xFF);
+
+	sd_type = type;
 	return SD_OK;
 }
 
@@ -312,15 +624,96 @@ sd_error SD_Init (uint8_t retries)
  **********************************************************************/
 sd_error SD_GetCID (void)
 {
-	uint8_t SD_arg[4]={0,0,0,0};
+	sd_error ret = SD_NG;
 
-	SD_SendCommand(CMD10_SEND_CID, SD_arg);
-	if(SD_WaitR1(sd_data_buf,18,1000)!= SD_OK) return SD_NG;
-	if(sd_data_buf[0]!= R1_NOERROR) return SD_NG;
+	sd_select();
+	sd_data_buf[0] = sd_cmd(CMD10_SEND_CID, 0);
+	if (sd_data_buf[0] == R1_NOERROR)
+	{
+		ret = sd_rx_block(sd_data_buf + 1, 16);
+	}
+	sd_deselect();
+	return (ret == SD_OK) ? SD_OK : SD_NG;
+}
+
+
+/*********************************************************************//**
+ * @brief		Read blocks, CMD18 for more than one block. A block
+ * 				failing its CRC-16 is read again up to SD_CRC_RETRIES times.
+ * @param[in]	- block: first block number (512 bytes each)
+ * 				- buf: pointer to count * SD_BLOCK_SIZE bytes
+ * 				- count: number of blocks
+ * @return 		SD_OK or error code
+ **********************************************************************/
+sd_error SD_ReadBlocks (uint32_t block, uint8_t *buf, uint32_t count)
+{
+	uint32_t done, retries = 0;
+	sd_error ret;
+
+	if (sd_type == SD_CARD_NONE) return SD_NG;
+	if ((buf == NULL) || (count == 0)) return SD_CMD_BAD_PARAMETER;
+	if ((block >= sd_blocks) || (count > sd_blocks - block)) return SD_ERROR_RANGE;
+
+	while (count)
+	{
+		ret = sd_read(block, buf, count, &done);
+		block += done;
+		buf += done * SD_BLOCK_SIZE;
+		count -= done;
+		if (ret == SD_OK) break;
+		if ((ret != SD_ERROR_CRC) || (retries++ >= SD_CRC_RETRIES)) return ret;
+		sd_crc_errors++;
+	}
 	return SD_OK;
 }
 
 
+/*********************************************************************//**
+ * @brief		Write blocks, CMD25 with a pre-erase count for more than
+ * 				one block. A block the card rejects with a CRC error is
+ * 				sent again up to SD_CRC_RETRIES times.
+ * @param[in]	- block: first block number (512 bytes each)
+ * 				- buf: pointer to count * SD_BLOCK_SIZE bytes
+ * 				- count: number of blocks
+ * @return 		SD_OK or error code
+ **********************************************************************/
+sd_error SD_WriteBlocks (uint32_t block, const uint8_t *buf, uint32_t count)
+{
+	uint32_t done, retries = 0;
+	sd_error ret;
+
+	if (sd_type == SD_CARD_NONE) return SD_NG;
+	if ((buf == NULL) || (count == 0)) return SD_CMD_BAD_PARAMETER;
+	if ((block >= sd_blocks) || (count > sd_blocks - block)) return SD_ERROR_RANGE;
+
+	while (count)
+	{
+		ret = sd_write(block, buf, count, &done);
+		block += done;
+		buf += done * SD_BLOCK_SIZE;
+		count -= done;
+		if (ret == SD_OK) break;
+		if ((ret != SD_ERROR_CRC) || (retries++ >= SD_CRC_RETRIES)) return ret;
+		sd_crc_errors++;
+	}
+	return SD_OK;
+}
+
+
+/*********************************************************************//**
+ * @brief		Get the card found by SD_Init()
+ * @param[out]	info: pointer to SD_INFO_Type
+ * @return 		None
+ **********************************************************************/
+void SD_GetInfo (SD_INFO_Type *info)
+{
+	info->Type = sd_type;
+	info->Blocks = (sd_type == SD_CARD_NONE) ? 0 : sd_blocks;
+	info->Clock = sd_clock;
+	info->CrcErrors = sd_crc_errors;
+}
+
+
 /*********************************************************************//**
  * @brief		Print Error Message
  * @param[in]	Print Message according to sd_status
@@ -346,6 +739,22 @@ void SD_ErrorMsg (sd_error sd_status)
 		printf(LPC_UART0,"Fail CMD59\n\r");
 		break;
 
+	case SD_ERROR_CMD8:
+		printf(LPC_UART0,"Fail CMD8\n\r");
+		break;
+
+	case SD_ERROR_CMD58:
+		printf(LPC_UART0,"Fail CMD58\n\r");
+		break;
+
+	case SD_ERROR_CRC:
+		printf(LPC_UART0,"Fail...CRC error.\n\r");
+		break;
+
+	case SD_ERROR_RANGE:
+		printf(LPC_UART0,"Fail...Block out of range.\n\r");
+		break;
+
 	case SD_ERROR_BUS_NOT_IDLE:
 		printf(LPC_UART0,"Fail...Device is not in idle state.\n\r");
 		break;
@@ -20,6 +20,9 @@
  * otherwise the default FW library configuration file must be included instead
  */
 
+/* Public Variables ----------------------------------------------------------- */
+EEPW_DEV_Type E2P25AA160A_Dev = EEPW_SSP_DEVICE(LPC_SSP0, 2, E2P25AA160A_PAGE, E2P25AA160A_SIZE);
+
 const char *status_reg[4]={"   STATUS REGISTER:\r\n\n",
                            "W/R                    W/R  W/R  R    R\r\n",
                            "D7   D6   D5   D4      D3   D2   D1   D0\r\n",
@@ -98,7 +101,7 @@ void Read_Eeprom_Status (LPC_SSP_TypeDef *SSPx)
 	print_status_reg();
 	printf(LPC_UART0,"\n\r%d01    X    X    X       %d01    %d01    %d01    %d01\n\r",wpen,bp1,bp0,wel,wip);
 
-	getche(LPC_UART0);
+	getche(LPC_UART0, BLOCKING);
 	EscFlag = 0;
 }
 
@@ -160,32 +163,9 @@ uchar Ssp_Eeprom_Write_Status_Reg (LPC_SSP_TypeDef *SSPx, uint8_t status_reg)
  **********************************************************************/
 uchar Ssp_Eeprom_Write_Byte (LPC_SSP_TypeDef *SSPx, uint16 eep_address, uint8_t byte_data)
 {
-	SSP_DATA_SETUP_Type xferConfig;
-	uint8_t WriteData[1],WriteStatus =0;
-
-	Tx_Buf1[0] = EEP_WRITE;                  /* WRITE IR 8bit msb       */
-	Tx_Buf1[1] = (uchar)(eep_address>>8);    // 1st byte extract
-	Tx_Buf1[2] = (uchar) eep_address;        // 2nd byte extract
-	Tx_Buf1[3] = byte_data;                  /* byte data lsb           */
-
-	WriteData[0] = EEP_WREN;
-
-	CS_Force1 (SSPx, DISABLE);
-	xferConfig.tx_data = WriteData;            /* Send Instruction Byte    */
-	xferConfig.rx_data = Rx_Buf1;               /* Store byte in Rx_Buf[0]  */
-	xferConfig.length = 1;
-	SSP_ReadWrite(SSPx, &xferConfig, SSP_TRANSFER_POLLING);  /* Write Enable Latch      */
-	CS_Force1 (SSPx, ENABLE);
-
-	CS_Force1 (SSPx, DISABLE);                              /* CS low active           */
-	xferConfig.tx_data = Tx_Buf1;               /* Send Instruction Byte    */
-	xferConfig.length = 4;
-	WriteStatus = SSP_ReadWrite(SSPx, &xferConfig, SSP_TRANSFER_POLLING);
-
-	if(WriteStatus)
+	E2P25AA160A_Dev.Periph = SSPx;
+	if(EEPW_Write(&E2P25AA160A_Dev, eep_address, &byte_data, 1, FALSE)==SUCCESS)
 	{
-		CS_Force1 (SSPx, ENABLE);                            /* CS high inactive        */
-		delay_ms(4);
 		return(1);
 	}
 	else
@@ -205,76 +185,14 @@ uchar Ssp_Eeprom_Write_Byte (LPC_SSP_TypeDef *SSPx, uint16 eep_address, uint8_t
  **********************************************************************/
 uchar Ssp_Eeprom_Write (LPC_SSP_TypeDef *SSPx, uint16_t eep_address, uint8_t *data_start, uint8_t length)
 {
-	SSP_DATA_SETUP_Type xferConfig;
-	uint8_t WriteData[1],WriteStatus =0,ip_len,new_length;
-	uint16 new_address;
-
-	WriteData[0] = EEP_WREN;
-
-	Tx_Buf1[0] = EEP_WRITE;                  // WRITE IR 8bit msb
-	Tx_Buf1[1] = (uchar)(eep_address>>8);    // 1st byte extract
-	Tx_Buf1[2] = (uchar)eep_address;         // 2nd byte extract
-
-	/* Intern page length(ip_len) gives length from address that can be occupied in page */
-	ip_len = 0x10 - (eep_address % 0x10);
-	new_address = eep_address + ip_len;
-
-	if(length > ip_len)
+	/* Page by page, each as soon as WIP clears */
+	E2P25AA160A_Dev.Periph = SSPx;
+	if(EEPW_Write(&E2P25AA160A_Dev, eep_address, data_start, length, FALSE)==SUCCESS)
 	{
-		new_length = length - ip_len;
-
-		CS_Force1 (SSPx, DISABLE);
-		xferConfig.tx_data = WriteData;            /* Send Instruction Byte    */
-		xferConfig.rx_data = Rx_Buf1;               /* Store byte in Rx_Buf[0]  */
-		xferConfig.length = 1;
-		SSP_ReadWrite(SSPx, &xferConfig, SSP_TRANSFER_POLLING);  /* Write Enable Latch      */
-		CS_Force1 (SSPx, ENABLE);
-
-		CS_Force1 (SSPx, DISABLE);                            // CS low active
-		xferConfig.tx_data = Tx_Buf1;                   /* Send Instruction Byte    */
-		xferConfig.length = 3;
-		SSP_ReadWrite(SSPx, &xferConfig, SSP_TRANSFER_POLLING);
-
-		xferConfig.tx_data = data_start;               // Pass value
-		xferConfig.length = ip_len;
-		WriteStatus = SSP_ReadWrite(SSPx, &xferConfig, SSP_TRANSFER_POLLING);
-
-		if(WriteStatus)
-		{
-			CS_Force1 (SSPx, ENABLE);                            /* CS high inactive        */
-		}
-		else
-			return(0);
-		// Recursive function
-		delay_ms(4);
-		Ssp_Eeprom_Write(SSPx, new_address,(data_start + ip_len),new_length);
-	}
-
-	if(length <= ip_len+1)
-	{
-		CS_Force1 (SSPx, DISABLE);
-		xferConfig.tx_data = WriteData;            /* Send Instruction Byte    */
-		xferConfig.rx_data = Rx_Buf1;               /* Store byte in Rx_Buf[0]  */
-		xferConfig.length = 1;
-		SSP_ReadWrite(SSPx, &xferConfig, SSP_TRANSFER_POLLING);  /* Write Enable Latch      */
-		CS_Force1 (SSPx, ENABLE);
-
-		CS_Force1 (SSPx, DISABLE);                            // CS low
-		xferConfig.tx_data = Tx_Buf1;                   /* Send Instruction Byte    */
-		xferConfig.length = 3;
-		SSP_ReadWrite(SSPx, &xferConfig, SSP_TRANSFER_POLLING);
-
-		xferConfig.tx_data = data_start;               // Pass value
-		xferConfig.length = length;
-		WriteStatus = SSP_ReadWrite(SSPx, &xferConfig, SSP_TRANSFER_POLLING);
-		if(WriteStatus)
-		{
-			CS_Force1 (SSPx, ENABLE);                            /* CS high inactive        */
-		}
-		else
-			return(0);
+		return(1);
 	}
-	return(1);
+	else
+		return(0);
 }
 
 
@@ -410,7 +328,7 @@ void Display_Eeprom_Loc (LPC_SSP_TypeDef *SSPx, uint16 mem_start_address, uint16
 		{
 			printf(LPC_UART0,"\x1b[24;01HPress any key to continue.");
 			line = 0;
-			getche(LPC_UART0);
+			getche(LPC_UART0, BLOCKING);
 
 			clr_scr_rst_cur(LPC_UART0);
 		}
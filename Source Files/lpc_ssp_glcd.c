@@ -14,6 +14,8 @@
 
 /* Includes ------------------------------------------------------------------- */
 #include "lpc_ssp_glcd.h"
+#include "lpc_glcd_text.h"
+#include "lpc_prof.h"
 #include "math.h"
 #include "Font_24x16.h"
 #include "Font_5x7.h"
@@ -29,6 +31,29 @@
 /******************************************************************************/
 static volatile uint16_t TextColor = Black, BackColor = White;
 
+#ifdef GLCD_DMA_MODE
+/* Pixel stream GPDMA channel, transfer chain and fill word */
+static int32_t GlcdDmaCh = -1;
+static __IO FlagStatus GlcdDmaBusy = RESET;
+static uint16_t GlcdDmaFill;
+static GPDMA_LLI_Type GlcdDmaLLI[GLCD_DMA_LLI_NUM];
+#endif
+
+#if GLCD_TEXT_OPAQUE_SEL
+/* One pixel row of a GLCD_Text() run */
+static uint16_t GlcdTextLine[WIDTH];
+#endif
+
+/* gprintf() output: text rendered into a run buffer and drawn per flush */
+typedef struct
+{
+	FMT_OUT_Type out;					/* Formatter output, must be first */
+	int16_t x, y;						/* Position of the next character */
+	int8_t size;						/* Text size */
+	uint16_t color;						/* Font color */
+	char text[32];						/* Run buffer */
+} GLCD_FMT_T;
+
 // Swap two bytes
 #define SWAP(x,y) do { (x)=(x)^(y); (y)=(x)^(y); (x)=(x)^(y); } while(0)
 #define bit_test(D,i) (D & (0x01 << i))
@@ -270,6 +295,13 @@ void GLCD_Init (void)
 	delay_ms(5);
 
 	Write_Command_Glcd(0x22);    // RAM data write/read
+
+#ifdef GLCD_DMA_MODE
+	if (GlcdDmaCh < 0)
+	{
+		GlcdDmaCh = GPDMA_AllocChannel();   // CPU streaming if none is free
+	}
+#endif
 }
 
 
@@ -338,49 +370,214 @@ static __INLINE void wr_dat_stop (void)
 
 
 /*********************************************************************//**
- * @brief	    Data writing to LCD controller
- * @param[in]	c     data to be written
+ * @brief	    Queue one pixel as a 16-bit SSP frame, waits only while
+ *              the TX FIFO is full
+ * @param[in]	c     pixel color
  * @return 		None
  **********************************************************************/
-static __INLINE void wr_dat_only (uint16_t c)
+static __INLINE void wr_pix (uint16_t c)
 {
-	SSP_DATA_SETUP_Type xferConfig;
+	while (!(LPC_SSP1->SR & SSP_SR_TNF));
+	LPC_SSP1->DR = c;
+}
 
-	Tx_Buf1[0] = (uchar)(c>>8);    // 1st byte extract
-	Tx_Buf1[1] = (uchar) c;        // 2nd byte extract
 
-	xferConfig.tx_data = Tx_Buf1;               /* Send Instruction Byte    */
-	xferConfig.rx_data = NULL;
-	xferConfig.length = 2;
-	SSP_ReadWrite(LPC_SSP1, &xferConfig, SSP_TRANSFER_POLLING);
+#ifdef GLCD_DMA_MODE
+/*********************************************************************//**
+ * @brief	    GPDMA completion callback of the pixel stream channel
+ * @param[in]	ChannelNum	DMA channel
+ * @param[in]	Status		GPDMA_STAT_INTTC or GPDMA_STAT_INTERR
+ * @return 		None
+ **********************************************************************/
+static void glcd_dma_done (uint32_t ChannelNum, GPDMA_Status_Type Status)
+{
+	GlcdDmaBusy = RESET;
 }
 
 
 /*********************************************************************//**
- * @brief	    Clear display
- * @param[in]	color    display clearing color
- * @return 		None
+ * @brief	    Send pixels to the SSP1 TX FIFO through GPDMA and wait
+ *              for the last transfer
+ * @param[in]	src      first pixel
+ *              count    number of pixels
+ *              fixed    TRUE to repeat *src (run-length fill)
+ * @return 		SUCCESS, or ERROR if no channel could be programmed
  **********************************************************************/
-void GLCD_Clear (uint16_t color)
+static Status glcd_dma_stream (const uint16_t *src, uint32_t count, Bool fixed)
 {
-	unsigned int   i;
+	GPDMA_Channel_CFG_Type cfg;
 
-	GLCD_Window (0,0,320,240);    // Window Max
+	if ((GlcdDmaCh < 0) || (GPDMA_ChainLength(count) > GLCD_DMA_LLI_NUM))
+	{
+		return ERROR;
+	}
 
-	Write_Command_Glcd(0x4E);     /* GDDRAM Horizontal */
-	Write_Data_Glcd(0);
+	cfg.ChannelNum = GlcdDmaCh;
+	cfg.TransferSize = count;
+	cfg.TransferWidth = 0;
+	cfg.SrcMemAddr = GPDMA_BUS_ADDR(src);
+	cfg.DstMemAddr = 0;
+	cfg.TransferType = GPDMA_TRANSFERTYPE_M2P;
+	cfg.SrcConn = 0;
+	cfg.DstConn = GPDMA_CONN_SSP1_Tx;
+	cfg.DMALLI = 0;
+	cfg.Options = fixed ? GPDMA_OPT_SRC_FIXED : 0;
+	cfg.Callback = glcd_dma_done;
+
+	if (GPDMA_SetupChain(&cfg, GlcdDmaLLI, GLCD_DMA_LLI_NUM) == ERROR)
+	{
+		return ERROR;
+	}
 
-	Write_Command_Glcd(0x4F);     /* GDDRAM Vertical */
-	Write_Data_Glcd(0);
+	GlcdDmaBusy = SET;
+	SSP_DMACmd(LPC_SSP1, SSP_DMA_TX, ENABLE);
+	GPDMA_ChannelCmd(GlcdDmaCh, ENABLE);
+	while (GlcdDmaBusy == SET);
+	SSP_DMACmd(LPC_SSP1, SSP_DMA_TX, DISABLE);
+
+	return SUCCESS;
+}
+#endif
+
+
+/*********************************************************************//**
+ * @brief	    Set the GRAM window and start a pixel stream. SSP1 is
+ *              switched to 16-bit frames and the chip select is held
+ *              until GLCD_Stream_Stop()
+ * @param[in]	x        horizontal position
+ *              y        vertical position
+ *              w        width of window
+ *              h        height of window
+ * @return 		None
+ **********************************************************************/
+void GLCD_Stream_Start (uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+	GLCD_Set_Loc (x,y,w,h);
 
-	Write_Command_Glcd(0x22);
 	wr_dat_start();
-	for(i = 0; i < (WIDTH*HEIGHT); i++)
-		wr_dat_only(color);
+	while (LPC_SSP1->SR & SSP_SR_BSY);
+	LPC_SSP1->CR0 = (LPC_SSP1->CR0 & ~SSP_CR0_DSS(16)) | SSP_DATABIT_16;
+}
+
+
+/*********************************************************************//**
+ * @brief	    Stream a block of pixels
+ * @param[in]	p        pixel data
+ *              count    number of pixels
+ * @return 		None
+ **********************************************************************/
+void GLCD_Stream_Pixels (const uint16_t *p, uint32_t count)
+{
+	PROF_BEGIN(PROF_ID_GLCD_PIXELS);
+#ifdef GLCD_DMA_MODE
+	if ((count >= GLCD_DMA_MIN_PIXELS) && (glcd_dma_stream(p, count, FALSE) == SUCCESS))
+	{
+		PROF_END(PROF_ID_GLCD_PIXELS);
+		return;
+	}
+#endif
+
+	/* Refill the whole FIFO each time it runs empty */
+	while (count >= 8)
+	{
+		while (!(LPC_SSP1->SR & SSP_SR_TFE));
+		LPC_SSP1->DR = p[0];
+		LPC_SSP1->DR = p[1];
+		LPC_SSP1->DR = p[2];
+		LPC_SSP1->DR = p[3];
+		LPC_SSP1->DR = p[4];
+		LPC_SSP1->DR = p[5];
+		LPC_SSP1->DR = p[6];
+		LPC_SSP1->DR = p[7];
+		p += 8;
+		count -= 8;
+	}
+	while (count--)
+	{
+		wr_pix(*p++);
+	}
+	PROF_END(PROF_ID_GLCD_PIXELS);
+}
+
+
+/*********************************************************************//**
+ * @brief	    Stream a run of pixels of the same color
+ * @param[in]	color    pixel color
+ *              count    run length in pixels
+ * @return 		None
+ **********************************************************************/
+void GLCD_Stream_Fill (uint16_t color, uint32_t count)
+{
+	PROF_BEGIN(PROF_ID_GLCD_RUN);
+#ifdef GLCD_DMA_MODE
+	if (count >= GLCD_DMA_MIN_PIXELS)
+	{
+		GlcdDmaFill = color;
+		if (glcd_dma_stream((const uint16_t *)&GlcdDmaFill, count, TRUE) == SUCCESS)
+		{
+			PROF_END(PROF_ID_GLCD_RUN);
+			return;
+		}
+	}
+#endif
+
+	while (count >= 8)
+	{
+		while (!(LPC_SSP1->SR & SSP_SR_TFE));
+		LPC_SSP1->DR = color;
+		LPC_SSP1->DR = color;
+		LPC_SSP1->DR = color;
+		LPC_SSP1->DR = color;
+		LPC_SSP1->DR = color;
+		LPC_SSP1->DR = color;
+		LPC_SSP1->DR = color;
+		LPC_SSP1->DR = color;
+		count -= 8;
+	}
+	while (count--)
+	{
+		wr_pix(color);
+	}
+	PROF_END(PROF_ID_GLCD_RUN);
+}
+
+
+/*********************************************************************//**
+ * @brief	    End a pixel stream: wait for the last frame, discard the
+ *              receive FIFO, restore 8-bit frames and release the chip
+ *              select
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void GLCD_Stream_Stop (void)
+{
+	while (LPC_SSP1->SR & SSP_SR_BSY);
+	while (LPC_SSP1->SR & SSP_SR_RNE)
+	{
+		(void)LPC_SSP1->DR;
+	}
+	LPC_SSP1->ICR = SSP_ICR_ROR;
+	LPC_SSP1->CR0 = (LPC_SSP1->CR0 & ~SSP_CR0_DSS(16)) | SSP_DATABIT_8;
+
 	wr_dat_stop();
 }
 
 
+/*********************************************************************//**
+ * @brief	    Clear display
+ * @param[in]	color    display clearing color
+ * @return 		None
+ **********************************************************************/
+void GLCD_Clear (uint16_t color)
+{
+	PROF_BEGIN(PROF_ID_GLCD_CLEAR);
+	GLCD_Stream_Start(0, 0, WIDTH, HEIGHT);
+	GLCD_Stream_Fill(color, WIDTH*HEIGHT);
+	GLCD_Stream_Stop();
+	PROF_END(PROF_ID_GLCD_CLEAR);
+}
+
+
 /*********************************************************************//**
  * @brief	    Draw character on given position
  * @param[in]	x       horizontal position
@@ -394,43 +591,23 @@ void GLCD_Draw_Char (uint16_t x, uint16_t y, uint16_t *c)
 
 	x = x-CHAR_W;
 
-	Write_Command_Glcd(0x45);      /* Horizontal GRAM Start Address      */
-	Write_Data_Glcd(x);
-
-	Write_Command_Glcd(0x46);      /* Horizontal GRAM End   Address (-1) */
-	Write_Data_Glcd(x+CHAR_W-1);
-
-	Write_Command_Glcd(0x44);      /* Vertical   GRAM Start Address      */
-	Write_Data_Glcd(y);
-
-	Write_Command_Glcd(0x44);      /* Vertical   GRAM End   Address (-1) */
-	Write_Data_Glcd((y+CHAR_H-1)<<8);
-
-	Write_Command_Glcd(0x4E);     /* GDDRAM Horizontal */
-	Write_Data_Glcd(x);
-
-	Write_Command_Glcd(0x4F);     /* GDDRAM Vertical */
-	Write_Data_Glcd(y);
-
-	Write_Command_Glcd(0x22);
-
-	wr_dat_start();
+	GLCD_Stream_Start(x, y, CHAR_W, CHAR_H);
 	for (j = 0; j < CHAR_H; j++)
 	{
 		for (i = 0; i<CHAR_W; i++)
 		{
 			if((c[idx] & (1 << i)) == 0x00)
 			{
-				wr_dat_only(BackColor);
+				wr_pix(BackColor);
 			}
 			else
 			{
-				wr_dat_only(TextColor);
+				wr_pix(TextColor);
 			}
 		}
 		c++;
 	}
-	wr_dat_stop();
+	GLCD_Stream_Stop();
 }
 
 
@@ -443,13 +620,13 @@ void GLCD_Draw_Char (uint16_t x, uint16_t y, uint16_t *c)
  **********************************************************************/
 void GLCD_Display_Char (uint16_t ln, uint16_t col, uchar c)
 {
-	c -= 32;
-	GLCD_Draw_Char(col * CHAR_W, ln * CHAR_H, (uint16_t *)&Font_24x16[c * CHAR_H]);
+	GTEXT_DrawText((col-1) * CHAR_W, ln * CHAR_H, &GTEXT_Font_24x16, (const char *)&c, 1, TextColor, BackColor);
 }
 
 
 /*********************************************************************//**
- * @brief	    Disply string on given line
+ * @brief	    Disply string on given line, the whole string is sent
+ *              through one GRAM window by the GTEXT blitter
  * @param[in]	ln       line number
  *              col      column number
  *              s        pointer to string
@@ -457,11 +634,7 @@ void GLCD_Display_Char (uint16_t ln, uint16_t col, uchar c)
  **********************************************************************/
 void GLCD_Display_String (uint16_t ln, uint16_t col, uchar *s)
 {
-	GLCD_Window(0,0,320,240);  // Window Max
-	while (*s)
-	{
-		GLCD_Display_Char(ln, col++, *s++);
-	}
+	GTEXT_DrawString((col-1) * CHAR_W, ln * CHAR_H, &GTEXT_Font_24x16, (const char *)s, TextColor, BackColor);
 }
 
 
@@ -491,20 +664,11 @@ void GLCD_ClearLn (uint16_t ln)
  **********************************************************************/
 void GLCD_Bitmap (uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t *bitmap)
 {
-	uint32_t i,j,k;
-
-	GLCD_Set_Loc (x,y,w,h);
-
-	wr_dat_start();
-	k = 16;
-	for (j = 0; j < h; j++)
-	{
-		for (i = 0; i < w; i++)
-		{
-			wr_dat_only(bitmap[k++]);
-		}
-	}
-	wr_dat_stop();
+	PROF_BEGIN(PROF_ID_GLCD_BITMAP);
+	GLCD_Stream_Start(x, y, w, h);
+	GLCD_Stream_Pixels(&bitmap[16], (uint32_t)w*h);
+	GLCD_Stream_Stop();
+	PROF_END(PROF_ID_GLCD_BITMAP);
 }
 
 
@@ -522,19 +686,157 @@ void GLCD_Bitmap (uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t *bitm
  **********************************************************************/
 void GLCD_Window_Fill (uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
 {
-	uint32_t i,j;
+	PROF_BEGIN(PROF_ID_GLCD_FILL);
+	GLCD_Stream_Start(x, y, w, h);
+	GLCD_Stream_Fill(color, (uint32_t)w*h);
+	GLCD_Stream_Stop();
+	PROF_END(PROF_ID_GLCD_FILL);
+}
 
-	GLCD_Set_Loc (x,y,w,h);
 
-	wr_dat_start();
-	for (j = 0; j < h; j++)
+/*********************************************************************//**
+ * @brief	    Empty a dirty rectangle list
+ * @param[in]	d        dirty rectangle list
+ * @return 		None
+ **********************************************************************/
+void GLCD_Dirty_Init (GLCD_DIRTY_Type *d)
+{
+	d->num = 0;
+}
+
+
+/*********************************************************************//**
+ * @brief	    Bounding box of two rectangles
+ * @param[in]	a, b     rectangles
+ *              u        union result
+ * @return 		Area of the union in pixels
+ **********************************************************************/
+static uint32_t glcd_rect_union (const GLCD_RECT_Type *a, const GLCD_RECT_Type *b, GLCD_RECT_Type *u)
+{
+	uint16_t x2 = ((a->x + a->w) > (b->x + b->w)) ? (a->x + a->w) : (b->x + b->w);
+	uint16_t y2 = ((a->y + a->h) > (b->y + b->h)) ? (a->y + a->h) : (b->y + b->h);
+
+	u->x = (a->x < b->x) ? a->x : b->x;
+	u->y = (a->y < b->y) ? a->y : b->y;
+	u->w = x2 - u->x;
+	u->h = y2 - u->y;
+
+	return (uint32_t)u->w * u->h;
+}
+
+
+/*********************************************************************//**
+ * @brief	    Mark a screen region as changed. Rectangles are merged
+ *              when streaming their bounding box costs no more than
+ *              streaming both plus one extra window setup
+ *              (GLCD_DIRTY_MERGE_COST pixels). When the list is full the
+ *              new region is merged into the rectangle it grows least
+ * @param[in]	d        dirty rectangle list
+ *              x        horizontal position
+ *              y        vertical position
+ *              w        width of region
+ *              h        height of region
+ * @return 		None
+ **********************************************************************/
+void GLCD_Dirty_Add (GLCD_DIRTY_Type *d, uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+	GLCD_RECT_Type r, u;
+	uint32_t area, grow, best_grow;
+	uint8_t i, best;
+
+	if ((x >= WIDTH) || (y >= HEIGHT) || (w == 0) || (h == 0))
 	{
-		for (i = 0; i < w; i++)
+		return;
+	}
+	r.x = x;
+	r.y = y;
+	r.w = ((x + w) > WIDTH) ? (WIDTH - x) : w;
+	r.h = ((y + h) > HEIGHT) ? (HEIGHT - y) : h;
+
+	/* Absorb every rectangle that is cheaper to send merged */
+	i = 0;
+	while (i < d->num)
+	{
+		area = (uint32_t)r.w * r.h + (uint32_t)d->rect[i].w * d->rect[i].h;
+		if (glcd_rect_union(&r, &d->rect[i], &u) <= area + GLCD_DIRTY_MERGE_COST)
 		{
-			wr_dat_only(color);
+			r = u;
+			d->rect[i] = d->rect[--d->num];
+			i = 0;
+			continue;
 		}
+		i++;
 	}
-	wr_dat_stop();
+
+	if (d->num < GLCD_DIRTY_MAX)
+	{
+		d->rect[d->num++] = r;
+		return;
+	}
+
+	/* List full: merge into the rectangle with the smallest growth */
+	best = 0;
+	best_grow = 0xFFFFFFFF;
+	for (i = 0; i < d->num; i++)
+	{
+		grow = glcd_rect_union(&r, &d->rect[i], &u) - (uint32_t)d->rect[i].w * d->rect[i].h;
+		if (grow < best_grow)
+		{
+			best_grow = grow;
+			best = i;
+		}
+	}
+	glcd_rect_union(&r, &d->rect[best], &d->rect[best]);
+}
+
+
+/*********************************************************************//**
+ * @brief	    Push the dirty regions of an off-screen buffer to the
+ *              display and empty the list
+ * @param[in]	d        dirty rectangle list
+ *              fb       off-screen pixel buffer, row stride area->w
+ *              area     screen region covered by fb
+ * @return 		Number of pixels sent
+ **********************************************************************/
+uint32_t GLCD_Dirty_Flush (GLCD_DIRTY_Type *d, const uint16_t *fb, const GLCD_RECT_Type *area)
+{
+	uint16_t x1, y1, x2, y2, row;
+	uint32_t sent = 0;
+	uint8_t i;
+
+	PROF_BEGIN(PROF_ID_GLCD_FLUSH);
+	for (i = 0; i < d->num; i++)
+	{
+		/* Clip to the buffer */
+		x1 = (d->rect[i].x > area->x) ? d->rect[i].x : area->x;
+		y1 = (d->rect[i].y > area->y) ? d->rect[i].y : area->y;
+		x2 = ((d->rect[i].x + d->rect[i].w) < (area->x + area->w)) ? (d->rect[i].x + d->rect[i].w) : (area->x + area->w);
+		y2 = ((d->rect[i].y + d->rect[i].h) < (area->y + area->h)) ? (d->rect[i].y + d->rect[i].h) : (area->y + area->h);
+		if ((x1 >= x2) || (y1 >= y2))
+		{
+			continue;
+		}
+
+		GLCD_Stream_Start(x1, y1, x2 - x1, y2 - y1);
+		if ((x1 == area->x) && (x2 == (area->x + area->w)))
+		{
+			/* Full buffer rows are contiguous */
+			GLCD_Stream_Pixels(&fb[(uint32_t)(y1 - area->y) * area->w], (uint32_t)(x2 - x1) * (y2 - y1));
+		}
+		else
+		{
+			for (row = y1; row < y2; row++)
+			{
+				GLCD_Stream_Pixels(&fb[(uint32_t)(row - area->y) * area->w + (x1 - area->x)], x2 - x1);
+			}
+		}
+		GLCD_Stream_Stop();
+		sent += (uint32_t)(x2 - x1) * (y2 - y1);
+	}
+	d->num = 0;
+	PROF_END(PROF_ID_GLCD_FLUSH);
+
+	return sent;
 }
 
 
@@ -551,6 +853,7 @@ void GLCD_Line(int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color)
 	int16_t  x, y, addx, addy, dx, dy;
 	int32_t P,i;
 
+	PROF_BEGIN(PROF_ID_GLCD_LINE);
 	dx = abs((int16_t)(x2 - x1));
 	dy = abs((int16_t)(y2 - y1));
 	x = x1;
@@ -608,6 +911,7 @@ void GLCD_Line(int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color)
 			}
 		}
 	}
+	PROF_END(PROF_ID_GLCD_LINE);
 }
 
 
@@ -624,6 +928,7 @@ void GLCD_Rect(COORDINATE_Type *p1, COORDINATE_Type *p2, Bool fill, uint16_t col
 {
 	int16_t  width,height;                          // Find the y min and max
 
+	PROF_BEGIN(PROF_ID_GLCD_RECT);
 	if(fill)
 	{
 		if(p2->x > p1->x)
@@ -665,6 +970,7 @@ void GLCD_Rect(COORDINATE_Type *p1, COORDINATE_Type *p2, Bool fill, uint16_t col
 		GLCD_Line(p1->x, p1->y, p1->x, p2->y, color);
 		GLCD_Line(p2->x, p1->y, p2->x, p2->y, color);
 	}
+	PROF_END(PROF_ID_GLCD_RECT);
 }
 
 
@@ -894,6 +1200,8 @@ void GLCD_Triangle(COORDINATE_Type *p1, COORDINATE_Type *p2, COORDINATE_Type *p3
 void GLCD_Circle(int16_t x, int16_t y, int16_t radius,COLORCFG_Type *cfg)
 {
 	int16_t a, b, P;
+
+	PROF_BEGIN(PROF_ID_GLCD_CIRCLE);
 	a = 0;
 	b = radius;
 	P = 1 - radius;
@@ -937,6 +1245,7 @@ void GLCD_Circle(int16_t x, int16_t y, int16_t radius,COLORCFG_Type *cfg)
 		else
 			P+= 5 + 2*(a++ - b--);
 	} while(a <= b);
+	PROF_END(PROF_ID_GLCD_CIRCLE);
 }
 
 
@@ -950,12 +1259,70 @@ void GLCD_Circle(int16_t x, int16_t y, int16_t radius,COLORCFG_Type *cfg)
  *              size       The size of the text: 1 = 5x7, 2 = 10x14, ...
  *              color      font color
  * @return 		None
+ *
+ * With GLCD_TEXT_OPAQUE_SEL the characters up to the next wrap are sent
+ * through one GRAM window, a streamed line per pixel row, and the cells
+ * are painted with the back color (GLCD_SetBackColor). Otherwise only
+ * the set pixels are drawn, one GLCD_PutPixel() each.
  **********************************************************************/
 void GLCD_Text(int16_t x, int16_t y, uint8_t* textptr, uint16_t length, uint8_t row, uint8_t col, int8_t (*font)[row], int8_t size, uint16_t color)
 {
+#if GLCD_TEXT_OPAQUE_SEL
+   int16_t adv = row*size + 1;              // Character cell with its gap column
+   int16_t skip, h, k;
+   uint16_t i, n, *p;
+   uint8_t j, l, bits;
+
+   if((size < 1) || (adv > WIDTH))
+   {
+      return;
+   }
+
+   PROF_BEGIN(PROF_ID_GLCD_TEXT);
+   while(length)
+   {
+      if(x+row*size >= WIDTH)        // Performs character wrapping
+      {
+         x = 0;                           // Set x at far left position
+         y += col*size + 1;                 // Set y below the cells
+      }
+      // Characters that fit before the next wrap, at least one
+      for(n = 1; (n < length) && (x+n*adv+row*size < WIDTH) && ((n+1)*adv <= WIDTH); ++n);
+
+      skip = (x < 0) ? -x : 0;           // Columns left of the screen
+      h = (y+col*size > HEIGHT) ? HEIGHT-y : col*size;
+      if((y >= 0) && (h > 0) && (skip < n*adv))
+      {
+         GLCD_Stream_Start(x+skip, y, n*adv-skip, h);
+         for(k=0; k<h; ++k)                // One line per pixel row
+         {
+            p = GlcdTextLine;
+            for(i=0; i<n; ++i)
+            {
+               for(j=0; j<row; ++j)
+               {
+                  bits = font[textptr[i]-' '][j];
+                  for(l=0; l<size; ++l)
+                  {
+                     *p++ = bit_test(bits, k/size) ? color : BackColor;
+                  }
+               }
+               *p++ = BackColor;
+            }
+            GLCD_Stream_Pixels(&GlcdTextLine[skip], n*adv-skip);
+         }
+         GLCD_Stream_Stop();
+      }
+      x += n*adv;
+      textptr += n;
+      length -= n;
+   }
+   PROF_END(PROF_ID_GLCD_TEXT);
+#else
    int16_t i, j, k, l, m;                     // Loop counters
    uint8_t pixelData[row];                     // Stores character data
 
+   PROF_BEGIN(PROF_ID_GLCD_TEXT);
    for(i=0; i<length; ++i, ++x) // Loop through the passed string
    {
       memcpy(pixelData, font[textptr[i]-' '], row);
@@ -982,31 +1349,60 @@ void GLCD_Text(int16_t x, int16_t y, uint8_t* textptr, uint16_t length, uint8_t
          }
       }
    }
+   PROF_END(PROF_ID_GLCD_TEXT);
+#endif
 }
 
 
+/*********************************************************************//**
+ * @brief		Formatter flush for gprintf(): draw the rendered text with
+ * 				one GLCD_Text() call per line segment
+ * @param[in]	out		Formatter output, first member of a GLCD_FMT_T
+ * @return		None
+ **********************************************************************/
+static void glcd_fmt_flush(FMT_OUT_Type *out)
+{
+	GLCD_FMT_T *f = (GLCD_FMT_T *)out;
+	int16_t adv = 5*f->size + 1;
+	int16_t x;
+	uint32_t i = 0, n;
+
+	while (i < out->Len)
+	{
+	    if(f->x+5*f->size >= 320)          // Performs character wrapping
+	    {
+	       f->x = 0;                           // Set x at far left position
+	       f->y += 7*f->size + 1;                 // Set y at next position down
+	    }
+		// Characters that fit before the next wrap, at least one
+		for (n = 0, x = f->x; ((i + n) < out->Len) && ((n == 0) || (x+5*f->size < 320)); n++)
+		{
+			x += adv;
+		}
+		GLCD_Text(f->x,f->y,(uint8_t *)&out->Buf[i],n,5,7,default5x7,f->size,f->color);
+		f->x = x;
+		i += n;
+	}
+	out->Len = 0;
+}
+
 /*********************************************************************//**
  * @brief		Modified version of Standard Printf statement
  *
- * @par			Supports standard formats "%c %s %d %x"
- * 				"%d" and "%x" requires non-standard qualifiers,"%dfn, %xfn":-
- *		        f supplies a fill character
- *		        n supplies a field width
+ * @par			Formats with FMT_VFormat(), see lpc_fmt.c:
+ * 				standard "%c %s %d %i %u %x %%" with flags and width,
+ * 				the library forms "%dfn, %xfn" (f = '0' fill character,
+ * 				n = field width) and the custom formats "%b %t %y %a"
  *
  *		        ENABLE RTC_SUPPORT in lpc17xx_uart.h for RTC Features
  *
- *				Supports custom formats  "%b  %u %t %y %a"
- *				"%b"	prints a 2 digit BCD value with leading zero
- *				"%u"	prints the 16 bit unsigned integer in hex format
- *				"%t"    prints current time
- *				"%y"    prints current date
- *				"%a"    prints alarm time and date
- * @param[in]	UARTx	Selected UART peripheral used to send data,
- * 				should be:
- *  			- LPC_UART0: UART0 peripheral
- * 				- LPC_UART1: UART1 peripheral
- * 				- LPC_UART2: UART2 peripheral
- * 				- LPC_UART3: UART3 peripheral
+ *				The text is drawn in runs, a character that would pass
+ *				the right edge wraps to the start of the next line. With
+ *				GLCD_TEXT_OPAQUE_SEL the cells are filled with the back
+ *				color, see GLCD_Text()
+ * @param[in]	(x,y)	The upper left coordinate of the first letter
+ * @param[in]	size	The size of the text: 1 = 5x7, 2 = 10x14, ...
+ * @param[in]	color	font color
  * @param[in] 	*format Character format
  * @param[in]   ...  <multiple argument>
  *
@@ -1014,193 +1410,19 @@ void GLCD_Text(int16_t x, int16_t y, uint8_t* textptr, uint16_t length, uint8_t
  **********************************************************************/
 int16 gprintf(int16_t x, int16_t y, int8_t size, uint16_t color, const char *format, ...)
 {
-	uchar hex[]= "0123456789ABCDEF";
-	unsigned int width_dec[10] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000};
-	unsigned int width_hex[10] = { 0x1, 0x10, 0x100, 0x1000, 0x10000, 0x100000, 0x1000000, 0x10000000};
-	unsigned int temp;
-
-	uchar format_flag, fill_char;
-	ulong32 u_val, div_val;
-	uint16 base;
-
-	uchar *ptr;
-#ifdef RTC_MODE
-	RTC_TIME_Type FullTime;
-#endif
+	GLCD_FMT_T f;
 	va_list ap;
-	va_start(ap, format);
 
-	for(;;)
-	{
-		while((format_flag = *format++) != '%')      // until full format string read
-		{
-			if(!format_flag)
-			{                        // until '%' or '\0'
-				return (0);
-			}
+	FMT_MemInit(&f.out, f.text, sizeof(f.text));
+	f.out.Flush = glcd_fmt_flush;
+	f.x = x;
+	f.y = y;
+	f.size = size;
+	f.color = color;
 
-		    if(x+5*size >= 320)          // Performs character wrapping
-		    {
-		       x = 0;                           // Set x at far left position
-		       y += 7*size + 1;                 // Set y at next position down
-		    }
-			GLCD_Text(x,y,&format_flag,1,5,7,default5x7,size,color);
-			x=x+5*size+1;
-		}
-
-		switch(format_flag = *format++)
-		{
-			case 'c':
-				format_flag = va_arg(ap, int);
-			    if(x+5*size >= 320)          // Performs character wrapping
-			    {
-			       x = 0;                           // Set x at far left position
-			       y += 7*size + 1;                 // Set y at next position down
-			    }
-				GLCD_Text(x,y,&format_flag,1,5,7,default5x7,size,color);
-				x=x+5*size+1;
-
-				continue;
-
-			default:
-			    if(x+5*size >= 320)          // Performs character wrapping
-			    {
-			       x = 0;                           // Set x at far left position
-			       y += 7*size + 1;                 // Set y at next position down
-			    }
-				GLCD_Text(x,y,&format_flag,1,5,7,default5x7,size,color);
-				x=x+5*size+1;
-
-        		continue;
-
-			case 'b':
-				format_flag = va_arg(ap,int);
-			    if(x+5*size >= 320)          // Performs character wrapping
-			    {
-			       x = 0;                           // Set x at far left position
-			       y += 7*size + 1;                 // Set y at next position down
-			    }
-				GLCD_Text(x,y,&(hex[(uint16)format_flag >> 4]),1,5,7,default5x7,size,color);
-				x=x+5*size+1;
-			    if(x+5*size >= 320)          // Performs character wrapping
-			    {
-			       x = 0;                           // Set x at far left position
-			       y += 7*size + 1;                 // Set y at next position down
-			    }
-				GLCD_Text(x,y,&(hex[(uint16)format_flag & 0x0F]),1,5,7,default5x7,size,color);
-				x=x+5*size+1;
-
-				continue;
-
-			case 's':
-				ptr = va_arg(ap, schar *);
-				while(*ptr)
-				{
-				    if(x+5*size >= 320)          // Performs character wrapping
-				    {
-				       x = 0;                           // Set x at far left position
-				       y += 7*size + 1;                 // Set y at next position down
-				    }
-					GLCD_Text(x,y,&(*ptr++),1,5,7,default5x7,size,color);
-					x=x+5*size+1;
-				}
-
-				continue;
-#ifdef RTC_MODE
-			case 't':
-				RTC_GetFullTime (LPC_RTC, &FullTime);
-			    gprintf(x,y,size,color, "%d02:%d02:%d02",FullTime.HOUR,FullTime.MIN,FullTime.SEC);
-
-				continue;
-
-			case 'y':
-				RTC_GetFullTime (LPC_RTC, &FullTime);
-			    gprintf(x,y,size,color, "%d02/%d02/%d04",FullTime.DOM,FullTime.MONTH,FullTime.YEAR);
-
-				continue;
-
-			case 'a':
-				RTC_GetFullAlarmTime (LPC_RTC, &FullTime);
-				gprintf(x,y,size,color, "Time: %d02:%d02:%d02",FullTime.HOUR,FullTime.MIN,FullTime.SEC);
-				gprintf(x,y,size,color, "  Date: %d02/%d02/%d04",FullTime.DOM,FullTime.MONTH,FullTime.YEAR);
-
-				continue;
-#endif
-			case 'u':
-				base = 16;
-				div_val = 0x100000;
-				u_val = va_arg(ap, uint32_t);
-				do
-				{
-				    if(x+5*size >= 320)          // Performs character wrapping
-				    {
-				       x = 0;                           // Set x at far left position
-				       y += 7*size + 1;                 // Set y at next position down
-				    }
-					GLCD_Text(x,y,&(hex[u_val/div_val]),1,5,7,default5x7,size,color);
-					x=x+5*size+1;
-					u_val %= div_val;
-					div_val /= base;
-				}while(div_val);
-
-				continue;
-
-			case 'd':
-				base = 10;
-				fill_char = *format++;
-				format_flag = ( *format++ ) - '1';
-				div_val = width_dec[format_flag];
-				u_val = va_arg(ap,int);
-
-				if(((int)u_val) < 0)
-				{
-					u_val = - u_val;    // applied to unsigned type, result still unsigned
-					temp = '-';
-				    if(x+5*size >= 320)          // Performs character wrapping
-				    {
-				       x = 0;                           // Set x at far left position
-				       y += 7*size + 1;                 // Set y at next position down
-				    }
-				    GLCD_Text(x,y,&temp,1,5,7,default5x7,size,color);
-				    x=x+5*size+1;
-				}
-
-				goto  CONVERSION_LOOP;
-
-			case 'x':
-				base = 16;
-				fill_char = *format++;
-				format_flag = (*format++) - '1';
-				div_val = width_hex[format_flag];
-				u_val = va_arg(ap, int);
-
-				CONVERSION_LOOP:
-				while(div_val > 1 && div_val > u_val)
-				{
-					div_val /= base;
-				    if(x+5*size >= 320)          // Performs character wrapping
-				    {
-				       x = 0;                           // Set x at far left position
-				       y += 7*size + 1;                 // Set y at next position down
-				    }
-					GLCD_Text(x,y,&fill_char,1,5,7,default5x7,size,color);
-					x=x+5*size+1;
-				}
-
-				do
-				{
-				    if(x+5*size >= 320)          // Performs character wrapping
-				    {
-				       x = 0;                           // Set x at far left position
-				       y += 7*size + 1;                 // Set y at next position down
-				    }
-					GLCD_Text(x,y,&(hex[u_val/div_val]),1,5,7,default5x7,size,color);
-					x=x+5*size+1;
-					u_val %= div_val;
-					div_val /= base;
-				}while(div_val);
-		}// end of switch statement
-	}
+	va_start(ap, format);
+	FMT_VFormat(&f.out, format, ap);
+	va_end(ap);
 	return(0);
 }
 
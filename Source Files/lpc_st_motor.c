@@ -21,7 +21,228 @@
  * otherwise the default FW library configuration file must be included instead
  */
 
-void Send_Sequence(StMotorDirection_e StMotorDirection, uint16 Speed);
+/* Private Macros ------------------------------------------------------------- */
+/** @defgroup ST_MOTOR_Private_Macros ST_MOTOR Private Macros
+ * @{
+ */
+
+#define STM_QUEUE_MASK			(STM_QUEUE_SIZE - 1)
+/** Step intervals are kept in 1/256 timer counts */
+#define STM_FP					8
+/** Timer counts a match must be ahead of TC to be caught */
+#define STM_LEAD				2
+
+/**
+ * @}
+ */
+
+
+/* Private Types -------------------------------------------------------------- */
+/** @defgroup ST_MOTOR_Private_Types ST_MOTOR Private Types
+ * @{
+ */
+
+/** Move with its ramp worked out, the step interrupt only iterates it */
+typedef struct {
+	int8_t Dir;					/* 1 clockwise, -1 anti-clockwise */
+	uint32_t Steps;
+	uint32_t AccSteps;			/* Steps accelerating from rest */
+	uint32_t DecSteps;			/* Steps decelerating to rest */
+	uint32_t C0;				/* First step interval */
+	uint32_t Cmin;				/* Cruise step interval */
+	uint32_t Accel, Decel;		/* Rates, for a stop part way through */
+} STM_PLAN_Type;
+
+/**
+ * @}
+ */
+
+
+/* Public Variables ----------------------------------------------------------- */
+/** Coils A, B, A' and B' are bits 1, 3, 5 and 7 */
+const uint8_t SmClk[8] = { 0x02, 0x0A, 0x08, 0x28, 0x20, 0xA0, 0x80, 0x82 };
+
+
+/* Private Variables ---------------------------------------------------------- */
+/** Moves waiting, filled in thread mode and taken by the step interrupt */
+static STM_PLAN_Type stm_queue[STM_QUEUE_SIZE];
+static uint32_t stm_head, stm_tail;
+
+/** Running move: steps done and left, interval and its fraction carried */
+static STM_PLAN_Type stm_cur;
+static volatile Bool stm_run;
+static uint32_t stm_done, stm_left;
+static uint32_t stm_c, stm_frac;
+
+/** Phase table entry on the coils and entries per step */
+static uint8_t stm_phase, stm_inc;
+static volatile int32_t stm_pos;
+
+static SCHED_TASK_Type *stm_task;
+static STM_STATS_Type stm_stats;
+
+
+/* Private Functions ---------------------------------------------------------- */
+static uint32_t stm_isqrt (uint64_t v);
+static Status stm_plan (const STM_MOVE_Type *move, STM_PLAN_Type *pl);
+static void stm_phase_out (void);
+static void stm_schedule (uint32_t match);
+static void stm_load (void);
+
+/*********************************************************************//**
+ * @brief		Integer square root
+ * @param[in]	v: value
+ * @return 		floor(sqrt(v))
+ **********************************************************************/
+static uint32_t stm_isqrt (uint64_t v)
+{
+	uint64_t r = 0, bit = (uint64_t)1 << 62;
+
+	while (bit > v)
+	{
+		bit >>= 2;
+	}
+	while (bit != 0)
+	{
+		if (v >= r + bit)
+		{
+			v -= r + bit;
+			r = (r >> 1) + bit;
+		}
+		else
+		{
+			r >>= 1;
+		}
+		bit >>= 2;
+	}
+	return (uint32_t)r;
+}
+
+
+/*********************************************************************//**
+ * @brief		Work out the ramp of a move. The speed follows
+ * 				v^2 = 2 * a * n, so the ramp lengths and the first step
+ * 				interval are all that is needed, the step interrupt steps
+ * 				the interval on with c = c - 2c / (4n + 1).
+ * @param[in]	move: move
+ * @param[out]	pl: plan
+ * @return 		SUCCESS, or ERROR if the move is out of range
+ **********************************************************************/
+static Status stm_plan (const STM_MOVE_Type *move, STM_PLAN_Type *pl)
+{
+	uint64_t v2;
+
+	if ((move->Steps == 0) || (move->Speed == 0) || (move->Speed > STM_SPEED_MAX))
+	{
+		return ERROR;
+	}
+	pl->Dir = (move->Steps > 0) ? 1 : -1;
+	pl->Steps = (move->Steps > 0) ? (uint32_t)move->Steps : (uint32_t)-move->Steps;
+	pl->Cmin = (STM_TICK_HZ << STM_FP) / move->Speed;
+	pl->Accel = move->Accel;
+	pl->Decel = (move->Decel != 0) ? move->Decel : move->Accel;
+
+	if (pl->Accel == 0)
+	{
+		pl->AccSteps = 0;
+		pl->DecSteps = 0;
+		pl->C0 = pl->Cmin;
+		return SUCCESS;
+	}
+
+	v2 = (uint64_t)move->Speed * move->Speed;
+	pl->AccSteps = (uint32_t)(v2 / (2 * (uint64_t)pl->Accel));
+	pl->DecSteps = (uint32_t)(v2 / (2 * (uint64_t)pl->Decel));
+	if ((uint64_t)pl->AccSteps + pl->DecSteps > pl->Steps)
+	{
+		// Cruise speed is never reached: accelerate to the point where
+		// the two ramps meet
+		pl->AccSteps = (uint32_t)(((uint64_t)pl->Steps * pl->Decel) / ((uint64_t)pl->Accel + pl->Decel));
+		pl->DecSteps = pl->Steps - pl->AccSteps;
+	}
+
+	// c0 = 0.676 * f * sqrt(2 / a), the factor corrects the error of the
+	// recurrence on its first steps
+	pl->C0 = (uint32_t)(((uint64_t)stm_isqrt(((uint64_t)2 * STM_TICK_HZ * STM_TICK_HZ / pl->Accel) << (2 * STM_FP)) * 676) / 1000);
+	if (pl->C0 < pl->Cmin)
+	{
+		pl->C0 = pl->Cmin;
+	}
+	return SUCCESS;
+}
+
+
+/*********************************************************************//**
+ * @brief		Put the current phase on the coils. The new coils are
+ * 				switched on before the old ones go off.
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+static void stm_phase_out (void)
+{
+	uint32_t on = _SBF(STM_PIN_SHIFT, SmClk[stm_phase]);
+
+	GPIO_SetValue(STM_PORT, on);
+	GPIO_ClearValue(STM_PORT, STM_PINS & ~on);
+}
+
+
+/*********************************************************************//**
+ * @brief		Set the time of the next step. A time already gone is
+ * 				moved just ahead of the timer, the match would only come
+ * 				round again after the counter wrapped.
+ * @param[in]	match: timer count of the step
+ * @return 		None
+ **********************************************************************/
+static void stm_schedule (uint32_t match)
+{
+	uint32_t tc = STM_TIM->TC;
+
+	if ((int32_t)(match - tc) < STM_LEAD)
+	{
+		match = tc + STM_LEAD;
+		stm_stats.Late++;
+	}
+	TIM_UpdateMatchValue(STM_TIM, 0, match);
+}
+
+
+/*********************************************************************//**
+ * @brief		Start the next queued move, or stop stepping if none is
+ * 				left. Called with the step interrupt held off.
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+static void stm_load (void)
+{
+	if (stm_tail == stm_head)
+	{
+		stm_run = FALSE;
+		STM_TIM->MCR &= ~TIM_INT_ON_MATCH(0);
+		return;
+	}
+	stm_cur = stm_queue[stm_tail];
+	stm_tail = (stm_tail + 1) & STM_QUEUE_MASK;
+	stm_done = 0;
+	stm_left = stm_cur.Steps;
+	stm_c = stm_cur.C0;
+	stm_frac = stm_c & ((1 << STM_FP) - 1);
+	if (stm_run == FALSE)
+	{
+		// From rest the first step is due one interval from now
+		stm_run = TRUE;
+		TIM_ClearIntPending(STM_TIM, TIM_MR0_INT);
+		stm_schedule(STM_TIM->TC + (stm_c >> STM_FP));
+		STM_TIM->MCR |= TIM_INT_ON_MATCH(0);
+	}
+	else
+	{
+		stm_schedule(STM_TIM->MR0 + (stm_c >> STM_FP));
+	}
+}
+
+/* End of Private Functions --------------------------------------------------- */
+
 
 /** @addtogroup ST_MOTOR_Public_Functions
  * @{
@@ -29,44 +250,262 @@ void Send_Sequence(StMotorDirection_e StMotorDirection, uint16 Speed);
 
 /* Public Functions ----------------------------------------------------------- */
 /*********************************************************************//**
- * @brief	    This function rotates stepper motor in desired direction and angle
- * @param[in]	None
+ * @brief		Initialize the motion engine: coil outputs, step timer and
+ * 				its interrupt. The coils are powered on the first phase
+ * 				of the step mode, the position is 0.
+ * @param[in]	mode: STM_FULL_STEP or STM_HALF_STEP
+ * @param[in]	task: posted whenever a move ends, NULL if not needed
+ * @return 		None
+ **********************************************************************/
+void STM_Init (uint8_t mode, SCHED_TASK_Type *task)
+{
+	TIM_TIMERCFG_Type tim;
+	TIM_MATCHCFG_Type mat;
+
+	NVIC_DisableIRQ(STM_TIM_IRQn);
+	stm_run = FALSE;
+	stm_head = 0;
+	stm_tail = 0;
+	stm_pos = 0;
+	stm_task = task;
+	stm_inc = (mode == STM_HALF_STEP) ? 1 : 2;
+	stm_phase = (mode == STM_HALF_STEP) ? 0 : 1;
+
+	GPIO_SetDir(STM_PORT, STM_PINS, 1);
+	stm_phase_out();
+
+	// Free running microsecond count, MR0 marks the next step
+	tim.PrescaleOption = TIM_PRESCALE_USVAL;
+	tim.PrescaleValue = 1;
+	TIM_Init(STM_TIM, TIM_TIMER_MODE, &tim);
+	mat.MatchChannel = 0;
+	mat.IntOnMatch = FALSE;
+	mat.ResetOnMatch = FALSE;
+	mat.StopOnMatch = FALSE;
+	mat.ExtMatchOutputType = TIM_EXTMATCH_NOTHING;
+	mat.MatchValue = 0;
+	TIM_ConfigMatch(STM_TIM, &mat);
+	TIM_Cmd(STM_TIM, ENABLE);
+
+	NVIC_SetPriority(STM_TIM_IRQn, 1);
+	NVIC_EnableIRQ(STM_TIM_IRQn);
+}
+
+
+/*********************************************************************//**
+ * @brief		Queue a move. It starts at once if the motor is at rest,
+ * 				otherwise when the moves before it are done.
+ * @param[in]	move: move, copied
+ * @return 		SUCCESS, or ERROR if the move is out of range or the
+ * 				queue is full
+ **********************************************************************/
+Status STM_Move (const STM_MOVE_Type *move)
+{
+	STM_PLAN_Type pl;
+	uint32_t primask;
+	Status ret = SUCCESS;
+
+	if (stm_plan(move, &pl) == ERROR)
+	{
+		return ERROR;
+	}
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if (((stm_head + 1) & STM_QUEUE_MASK) == stm_tail)
+	{
+		ret = ERROR;
+	}
+	else
+	{
+		stm_queue[stm_head] = pl;
+		stm_head = (stm_head + 1) & STM_QUEUE_MASK;
+		if (stm_run == FALSE)
+		{
+			stm_load();
+		}
+	}
+	__set_PRIMASK(primask);
+
+	return ret;
+}
+
+
+/*********************************************************************//**
+ * @brief		Stop the motor and drop the queued moves
+ * @param[in]	now: TRUE to stop on the spot, FALSE to ramp down at the
+ * 				deceleration of the running move
  * @return 		None
  **********************************************************************/
-void Rotate_Stepper_Motor (StMotorDirection_e StMotorDirection, uint16 Angle, uint16 Speed)
+void STM_Stop (Bool now)
+{
+	uint32_t primask, n, dec;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	stm_tail = stm_head;
+	if (stm_run == TRUE)
+	{
+		if ((now == TRUE) || (stm_cur.Accel == 0))
+		{
+			stm_stats.Moves++;
+			stm_load();
+			if (stm_task != NULL)
+			{
+				SCHED_Post(stm_task);
+			}
+		}
+		else if (stm_left > stm_cur.DecSteps)
+		{
+			// Speed is that of step n of the acceleration ramp, which
+			// takes n * Accel / Decel steps to ramp down
+			n = (stm_done < stm_cur.AccSteps) ? stm_done : stm_cur.AccSteps;
+			dec = (uint32_t)(((uint64_t)n * stm_cur.Accel) / stm_cur.Decel);
+			if (dec < stm_left)
+			{
+				stm_left = (dec != 0) ? dec : 1;
+			}
+			stm_cur.DecSteps = stm_left;
+		}
+	}
+	__set_PRIMASK(primask);
+}
+
+
+/*********************************************************************//**
+ * @brief		Check for motion
+ * @param[in]	None
+ * @return 		TRUE while a move runs
+ **********************************************************************/
+Bool STM_Busy (void)
+{
+	return stm_run;
+}
+
+
+/*********************************************************************//**
+ * @brief		Position of the motor
+ * @param[in]	None
+ * @return 		Steps of the step mode, clockwise counts up
+ **********************************************************************/
+int32_t STM_GetPosition (void)
 {
-    uint16 i,Count;
-    Count = (Angle / CAL_ANGLE);
-    for(i=0;i < Count;i++)
-    {
-        Send_Sequence(StMotorDirection,Speed);
-    }
+	return stm_pos;
 }
 
 
 /*********************************************************************//**
- * @brief	    This function will send sequence to Stepper motor
+ * @brief		Set the position count, e.g. after homing
+ * @param[in]	pos: new position
+ * @return 		SUCCESS, or ERROR while the motor moves
+ **********************************************************************/
+Status STM_SetPosition (int32_t pos)
+{
+	if (stm_run == TRUE)
+	{
+		return ERROR;
+	}
+	stm_pos = pos;
+	return SUCCESS;
+}
+
+
+/*********************************************************************//**
+ * @brief		Step interrupt, called from the STM_TIM interrupt
+ * 				handler: make the step that is due and set the match for
+ * 				the next one
  * @param[in]	None
  * @return 		None
  **********************************************************************/
-void Send_Sequence(StMotorDirection_e StMotorDirection, uint16 Speed)
+void STM_IntHandler (void)
+{
+	uint32_t c;
+
+	if (TIM_GetIntStatus(STM_TIM, TIM_MR0_INT) == RESET)
+	{
+		return;
+	}
+	TIM_ClearIntPending(STM_TIM, TIM_MR0_INT);
+	if (stm_run == FALSE)
+	{
+		return;
+	}
+
+	stm_phase = (stm_phase + ((stm_cur.Dir > 0) ? stm_inc : 8 - stm_inc)) & 0x07;
+	stm_phase_out();
+	stm_pos += stm_cur.Dir;
+	stm_stats.Steps++;
+	stm_done++;
+	if (--stm_left == 0)
+	{
+		stm_stats.Moves++;
+		stm_load();
+		if (stm_task != NULL)
+		{
+			SCHED_Post(stm_task);
+		}
+		return;
+	}
+
+	if (stm_left <= stm_cur.DecSteps)
+	{
+		// Deceleration: the recurrence run backwards, n = -left
+		stm_c += (2 * stm_c) / (4 * stm_left - 1);
+	}
+	else if (stm_done < stm_cur.AccSteps)
+	{
+		stm_c -= (2 * stm_c) / (4 * stm_done + 1);
+		if (stm_c < stm_cur.Cmin)
+		{
+			stm_c = stm_cur.Cmin;
+		}
+	}
+	else
+	{
+		stm_c = stm_cur.Cmin;
+	}
+
+	c = stm_c + stm_frac;
+	stm_frac = c & ((1 << STM_FP) - 1);
+	stm_schedule(STM_TIM->MR0 + (c >> STM_FP));
+}
+
+
+/*********************************************************************//**
+ * @brief		Get the motion counters
+ * @param[out]	stats: pointer to STM_STATS_Type
+ * @return 		None
+ **********************************************************************/
+void STM_GetStats (STM_STATS_Type *stats)
 {
-    if(StMotorDirection == StMotorClockwise)
-    {
-    	GPIO_ClearValue(1, _SBF(18, 0xAA));
-        GPIO_SetValue(1, _SBF(18, SmClk[temp]));
-    }
-    if(StMotorDirection == StMotorAntiClockwise)
-    {
-        GPIO_ClearValue(1, _SBF(18, 0xAA));
-        GPIO_SetValue(1, _SBF(18, SmAntClk[temp]));
-    }
-    delay_ms(Speed);
-    temp++;
-    if(temp>3) temp=0;
+	*stats = stm_stats;
 }
 
 
+/*********************************************************************//**
+ * @brief	    This function rotates stepper motor in desired direction
+ * 				and angle at a constant speed. It queues the move and
+ * 				returns at once, STM_Busy() tells when it is done.
+ * @param[in]	StMotorDirection: direction
+ * @param[in]	Angle: angle in degrees
+ * @param[in]	Speed: milliseconds per step
+ * @return 		SUCCESS, or ERROR if the move cannot be queued
+ **********************************************************************/
+Status Rotate_Stepper_Motor (StMotorDirection_e StMotorDirection, uint16_t Angle, uint16_t Speed)
+{
+	STM_MOVE_Type move;
+
+	move.Steps = (int32_t)(((uint32_t)Angle * STM_STEPS_REV * ((stm_inc == 1) ? 2 : 1)) / 360);
+	if (StMotorDirection == StMotorAntiClockwise)
+	{
+		move.Steps = -move.Steps;
+	}
+	move.Speed = 1000 / ((Speed != 0) ? Speed : 1);
+	move.Accel = 0;
+	move.Decel = 0;
+	return STM_Move(&move);
+}
+
 /**
  * @}
  */
@@ -78,4 +517,3 @@ void Send_Sequence(StMotorDirection_e StMotorDirection, uint16 Speed)
  */
 
 /* --------------------------------- End Of File ------------------------------ */
-
@@ -21,41 +21,102 @@
  * otherwise the default FW library configuration file must be included instead
  */
 
+/* Private Macros ------------------------------------------------------------- */
+#define		SWITCH_PINS			_SBF(SWITCH_PIN, ((1 << SWITCH_KEYS) - 1))
+
+/* Private Variables ---------------------------------------------------------- */
+static uint64_t Switch_Scan (void);
+
+/** Switches as a source of the input subsystem */
+static INPUT_SRC_Type Switch_Src = {
+	SWITCH_KEYS, 0, SWITCH_PINS, NULL, Switch_Scan, 0, NULL
+};
+static Bool Switch_Attached;
+
+
+/* Private Functions ---------------------------------------------------------- */
+/*********************************************************************//**
+ * @brief	    Reads the switches, input source scan
+ * @param[in]	None
+ * @return 		Switches down, bit 0 is switch 1
+ **********************************************************************/
+static uint64_t Switch_Scan (void)
+{
+	return (~LPC_GPIO0->FIOPIN >> SWITCH_PIN) & ((1 << SWITCH_KEYS) - 1);
+}
+
+/* End of Private Functions --------------------------------------------------- */
+
+
 /** @addtogroup SWITCH_Public_Functions
  * @{
  */
 
 /* Public Functions ----------------------------------------------------------- */
 /*********************************************************************//**
- * @brief	    Detects pressed Key
+ * @brief	    Hands the switches to the input subsystem, which must be
+ *              initialized with INPUT_Init() first. Presses and releases
+ *              then come as debounced events from INPUT_GetEvent().
+ * @param[in]	None
+ * @return 		None
+ **********************************************************************/
+void Switch_Init (void)
+{
+	GPIO_SetDir(0, SWITCH_PINS, 0);    // Set P0.19 to P0.22 as input
+	if (INPUT_Attach(&Switch_Src) == SUCCESS)
+	{
+		Switch_Attached = TRUE;
+	}
+}
+
+
+/*********************************************************************//**
+ * @brief	    Detects pressed Key, debounced once Switch_Init() was
+ *              called
  * @param[in]	None
  * @return 		Key Value
  **********************************************************************/
 uchar Detect_Key (void)
 {
 	uint32_t x;
-	x = GPIO_ReadValue(0);    // Read Port0 Pin state and store in x
-	if(!(x & _SBF(19,1)))      // check if Pin 0.19 is zero
-	{
-		return(1);
-	}
-	else if(!(x & _SBF(20,1))) // check if Pin 0.20 is zero
+	uchar i;
+
+	if (Switch_Attached)
 	{
-		return(2);
+		x = (uint32_t)(INPUT_GetKeys() >> Switch_Src.Base);
 	}
-	else if(!(x & _SBF(21,1))) // check if Pin 0.21 is zero
+	else
 	{
-		return(3);
+		x = Switch_Scan();
 	}
-	else if(!(x & _SBF(22,1))) // check if Pin 0.22 is zero
+	for (i = 0; i < SWITCH_KEYS; i++)
 	{
-		return(4);
+		if (x & _BIT(i))
+		{
+			return(i + 1);
+		}
 	}
 
     return(0);
 }
 
 
+/*********************************************************************//**
+ * @brief	    Converts the key number of an input event
+ * @param[in]	key		INPUT_EVENT_Type Key
+ * @return 		Switch 1 to SWITCH_KEYS, 0 if the key is not a switch
+ **********************************************************************/
+uchar Switch_Number (uint8_t key)
+{
+	if ((Switch_Attached == FALSE) || (key < Switch_Src.Base) ||
+		(key >= Switch_Src.Base + SWITCH_KEYS))
+	{
+		return(0);
+	}
+	return(key - Switch_Src.Base + 1);
+}
+
+
 /**
  * @}
  */
@@ -20,6 +20,26 @@
  * otherwise the default FW library configuration file must be included instead
  */
 
+/* Private Variables ---------------------------------------------------------- */
+/** Heartbeat LED timer */
+static SCHED_TIMER_Type heartbeat;
+
+
+/* Private Functions ---------------------------------------------------------- */
+/*********************************************************************//**
+ * @brief		Toggle the heartbeat LED P3.25, timer callback
+ * @param[in]	tmr: heartbeat timer
+ * @return 		None
+ **********************************************************************/
+static void Heartbeat_Toggle(SCHED_TIMER_Type *tmr)
+{
+	LPC_GPIO3->FIOPIN ^= _BIT(25);
+	tmr->Period = led_delay;            // Rate may be changed at run time
+}
+
+/* End of Private Functions --------------------------------------------------- */
+
+
 /** @addtogroup SYSTEM_INIT_Public_Functions
  * @{
  */
@@ -36,10 +56,13 @@ void System_Init(void)
 	LPC_WDT->WDMOD &= ~WDT_WDMOD_WDEN;  // Disable Watchdog
 	SystemInit();						// Initialize system and update core clock
 	Port_Init();                        // Port Initialization
+	SCHED_Init();                       // Timer wheel and task queues
 	SYSTICK_Config();                   // Systick Initialization
 	UART_Config(LPC_UART0, 9600);      // Uart0 Initialization
 	UART_Config(LPC_UART2, 115200);     // Uart2 Initialization
 	led_delay = 1000;                   // Heart Beat rate of 1Sec toggle
+	SCHED_TimerInit(&heartbeat, Heartbeat_Toggle, NULL);
+	SCHED_TimerStart(&heartbeat, led_delay, led_delay);
 }
 
 /*********************************************************************//**
@@ -0,0 +1,73 @@
+/******************************************************************//**
+* @file		host_test.h
+* @brief	Reporting for the host tests in this directory. The drivers
+* 			declare their own printf() in lpc17xx_uart.h, so the tests
+* 			print through write() instead of <stdio.h>
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+**********************************************************************/
+
+#ifndef HOST_TEST_H_
+#define HOST_TEST_H_
+
+/* Includes ------------------------------------------------------------------- */
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+
+extern int vsnprintf (char *s, size_t n, const char *format, va_list ap);
+
+/* Public Macros -------------------------------------------------------------- */
+/** Count a failure and report it when c is false */
+#define TEST_CHECK(c, ...) \
+	do { if (!(c)) { test_fails++; TEST_Print("FAIL: " __VA_ARGS__); TEST_Print("\n"); } } while (0)
+
+/* Public Variables ----------------------------------------------------------- */
+static int test_fails;
+
+/* Public Functions ----------------------------------------------------------- */
+/*********************************************************************//**
+ * @brief		Print to stdout, C printf() format
+ * @param[in]	format	Format string
+ * @return		None
+ **********************************************************************/
+static void TEST_Print (const char *format, ...)
+{
+	char buf[256];
+	va_list ap;
+	int n;
+
+	va_start(ap, format);
+	n = vsnprintf(buf, sizeof(buf), format, ap);
+	va_end(ap);
+	if (n > (int)sizeof(buf) - 1)
+	{
+		n = sizeof(buf) - 1;
+	}
+	if (n > 0)
+	{
+		(void)write(1, buf, n);
+	}
+}
+
+/*********************************************************************//**
+ * @brief		Print the verdict
+ * @param[in]	None
+ * @return		Exit status for main(), 0 when every check passed
+ **********************************************************************/
+static int TEST_Done (void)
+{
+	if (test_fails)
+	{
+		TEST_Print("FAILED %d\n", test_fails);
+		return 1;
+	}
+	TEST_Print("PASS\n");
+	return 0;
+}
+
+#endif /* HOST_TEST_H_ */
+
+/* --------------------------------- End Of File ------------------------------ */
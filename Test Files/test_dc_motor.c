@@ -0,0 +1,161 @@
+/******************************************************************//**
+* @file		test_dc_motor.c
+* @brief	Host test of the DC motor PID: speed and position steps on
+*           a first-order motor model (no inductance, no Coulomb
+*           friction), checked for overshoot, settling time and
+*           steady state error
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+*
+* Build and run from the repository root:
+*   gcc -DLPC_HOST_SIM -no-pie -I"CM3 Core" -I"Header Files" \
+*       "CM3 Core/system_LPC17xx.c" "Source Files/lpc_host_sim.c" \
+*       "Source Files/lpc_dc_motor.c" "Source Files/lpc17xx_mcpwm.c" \
+*       "Source Files/lpc17xx_qei.c" "Source Files/lpc17xx_clkpwr.c" \
+*       "Source Files/lpc17xx_pinsel.c" "Test Files/test_dc_motor.c" \
+*       -lm -o test_dc_motor
+*   ./test_dc_motor
+**********************************************************************/
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc_dc_motor.h"
+#include "lpc_host_sim.h"
+#include "host_test.h"
+
+/* Private Macros ------------------------------------------------------------- */
+#define TEST_SAMPLE_MS		1			/* Step response sample period */
+#define TEST_SPEED_MS		300			/* Speed step observed for */
+#define TEST_POS_MS			1500		/* Position step observed for */
+#define TEST_BAND			0.02		/* Settling band, of the step */
+
+/* Private Variables ---------------------------------------------------------- */
+/* 12 V bridge, 2 ohm, Kt = Ke = 0.03, 2048 line encoder: tau = J / (B + Kt Ke / R)
+ * is 44.3 ms and full duty runs at 3806 RPM, a gain K of 1.27 Q15 speed per duty */
+static const HOSTSIM_MOTOR_Type motor = {
+	.Vbus = 12.0, .R = 2.0, .L = 0, .Ke = 0.03, .Kt = 0.03,
+	.J = 2e-5, .B = 1e-6, .Friction = 0, .Ppr = 2048
+};
+
+/* Speed loop: Ki / Kp = 1 / tau puts the PI zero on the motor pole, the closed
+ * loop is then first order with tau / (Kp K) = 11.6 ms, settling to 2% in 47 ms.
+ * No feed-forward: with it the loop gains a slow zero and overshoots. */
+static const DCM_PID_CFG_Type speed_gains = {
+	.Kp = DCM_Q15(3), .Ki = DCM_KI(68, DCM_LOOP_HZ), .Kd = 0,
+	.Kff = 0, .Offset = 0, .OutMax = 32767
+};
+
+/* Position loop: P only, 1.33 Q15 speed per count, limited to 2000 RPM */
+static const DCM_PID_CFG_Type pos_gains = {
+	.Kp = 43690, .Ki = 0, .Kd = 0,
+	.Kff = 0, .Offset = 0, .OutMax = DCM_RPM(2000)
+};
+
+/* Private Types -------------------------------------------------------------- */
+typedef struct {
+	double Peak;				/* Furthest point past the start, in the step direction */
+	double Final;				/* Value at the end */
+	uint32_t SettleMs;			/* Last time outside the band, ms after the step */
+} STEP_Type;
+
+/* Private Functions ---------------------------------------------------------- */
+static double plant_rpm (void)
+{
+	return HOSTSIM_MotorGetSpeed();
+}
+
+static double plant_pos (void)
+{
+	return (double)DCM_GetPosition();
+}
+
+/* Sample get() for ms after a step from start to target */
+static void step_run (double (*get)(void), double start, double target, uint32_t ms, STEP_Type *s)
+{
+	double v, dir = (target >= start) ? 1 : -1;
+	double band = TEST_BAND * dir * (target - start);
+	uint32_t t;
+
+	s->Peak = start;
+	s->SettleMs = 0;
+	for (t = TEST_SAMPLE_MS; t <= ms; t += TEST_SAMPLE_MS)
+	{
+		HOSTSIM_Advance(HOSTSIM_UsToCycles(TEST_SAMPLE_MS * 1000));
+		v = get();
+		if ((dir * (v - s->Peak)) > 0)
+		{
+			s->Peak = v;
+		}
+		if ((v > target + band) || (v < target - band))
+		{
+			s->SettleMs = t;
+		}
+	}
+	s->Final = get();
+}
+
+static double overshoot (const STEP_Type *s, double start, double target)
+{
+	double os = (s->Peak - target) / (target - start);
+
+	return (os > 0) ? (100 * os) : 0;
+}
+
+/* Main Program --------------------------------------------------------------- */
+int main (void)
+{
+	STEP_Type s;
+	DCM_STATS_Type st;
+	double p0, os;
+
+	HOSTSIM_Init();
+	SystemInit();
+	HOSTSIM_MotorAttach(&motor);
+	DCM_Init();
+	TEST_CHECK(DCM_SetGains(DCM_LOOP_SPEED, &speed_gains) == SUCCESS, "speed gains");
+	TEST_CHECK(DCM_SetGains(DCM_LOOP_POSITION, &pos_gains) == SUCCESS, "position gains");
+
+	// Speed step from rest: no overshoot, within 2% in 60 ms, no steady
+	// state error beyond the 1% of speed measurement ripple
+	DCM_SetSpeed(1000);
+	step_run(plant_rpm, 0, 1000, TEST_SPEED_MS, &s);
+	os = overshoot(&s, 0, 1000);
+	TEST_Print("speed 0 -> 1000 RPM: overshoot %.1f%%, settled in %u ms, final %.1f RPM\n",
+			   os, s.SettleMs, s.Final);
+	TEST_CHECK(os < 1, "speed overshoot %.1f%%", os);
+	TEST_CHECK(s.SettleMs <= 60, "speed settling %u ms", s.SettleMs);
+	TEST_CHECK((s.Final > 990) && (s.Final < 1010), "speed final %.1f RPM", s.Final);
+
+	// Speed reversal: the output saturates for part of it, the anti-windup
+	// must keep it from overshooting
+	DCM_SetSpeed(-1000);
+	step_run(plant_rpm, 1000, -1000, TEST_SPEED_MS, &s);
+	os = overshoot(&s, 1000, -1000);
+	TEST_Print("speed 1000 -> -1000 RPM: overshoot %.1f%%, settled in %u ms, final %.1f RPM\n",
+			   os, s.SettleMs, s.Final);
+	TEST_CHECK(os < 1, "reversal overshoot %.1f%%", os);
+	TEST_CHECK(s.SettleMs <= 120, "reversal settling %u ms", s.SettleMs);
+	TEST_CHECK((s.Final > -1010) && (s.Final < -990), "reversal final %.1f RPM", s.Final);
+
+	// Three turn position move at up to 2000 RPM: no overshoot, within 2%
+	// in 400 ms, ending within a few counts
+	DCM_SetSpeed(0);
+	HOSTSIM_Advance(HOSTSIM_UsToCycles(200000));
+	p0 = plant_pos();
+	DCM_SetPosition((int32_t)p0 + 3 * DCM_CPR);
+	step_run(plant_pos, p0, p0 + 3 * DCM_CPR, TEST_POS_MS, &s);
+	os = overshoot(&s, p0, p0 + 3 * DCM_CPR);
+	TEST_Print("position +%d counts: overshoot %.1f%%, settled in %u ms, error %.0f counts\n",
+			   (int)(3 * DCM_CPR), os, s.SettleMs, s.Final - (p0 + 3 * DCM_CPR));
+	TEST_CHECK(os < 1, "position overshoot %.1f%%", os);
+	TEST_CHECK(s.SettleMs <= 400, "position settling %u ms", s.SettleMs);
+	TEST_CHECK((s.Final - (p0 + 3 * DCM_CPR) > -8) && (s.Final - (p0 + 3 * DCM_CPR) < 8),
+			   "position error %.0f counts", s.Final - (p0 + 3 * DCM_CPR));
+
+	DCM_GetStats(&st);
+	TEST_Print("%u samples, %u saturated, %u over budget\n", st.Samples, st.Saturated, st.OverBudget);
+	TEST_CHECK(st.Samples > 0, "the control loop never ran");
+	return TEST_Done();
+}
+
+/* --------------------------------- End Of File ------------------------------ */
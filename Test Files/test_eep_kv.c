@@ -0,0 +1,229 @@
+/******************************************************************//**
+* @file		test_eep_kv.c
+* @brief	Host test of the E2PROM key/value store: power is cut at
+*           every byte of every write an operation makes, the store
+*           must mount again and hold the old or the new value
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+*
+* Build and run from the repository root:
+*   gcc -DLPC_HOST_SIM -I"CM3 Core" -I"Header Files" "Source Files/lpc_eep_kv.c" \
+*       "Source Files/lpc_crc.c" "Test Files/test_eep_kv.c" -o test_eep_kv
+*   ./test_eep_kv
+**********************************************************************/
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc_eep_kv.h"
+#include "host_test.h"
+
+/* Private Macros ------------------------------------------------------------- */
+#define TEST_SIZE			1024		/* Part size, 4 segments of 256 bytes */
+#define TEST_PAGE			16
+#define TEST_KEYS			12			/* Keys used, few enough to force compaction */
+#define TEST_OPS			150
+
+/* Private Variables ---------------------------------------------------------- */
+/* E2PROM model: the bytes, and a write budget that cuts the power */
+static uint8_t mem[TEST_SIZE];
+static long budget = -1;				/* Bytes until the cut, -1 for none */
+static Bool garble;						/* Cut page is left random, not unwritten */
+static Bool dead;						/* Power is off until the next mount */
+static uint32_t written;				/* Bytes written since the last clear */
+static uint32_t seed = 1;
+
+static EEPW_DEV_Type dev = EEPW_I2C_DEVICE(LPC_I2C0, 0x50, 1, TEST_PAGE, TEST_SIZE);
+static KV_STORE_Type kv = KV_STORE(&dev, 0, 256, 4);
+
+/* Expected content, len -1 when the key is absent */
+static uint8_t model_val[TEST_KEYS][KV_VALUE_MAX];
+static int model_len[TEST_KEYS];
+
+/* Private Functions ---------------------------------------------------------- */
+static uint8_t rnd (void)
+{
+	seed = seed * 1103515245 + 12345;
+	return (uint8_t)(seed >> 16);
+}
+
+/* The store writes through these two, the real ones are in lpc_eep_writer.c */
+Status EEPW_Write (EEPW_DEV_Type *d, uint32_t addr, const uint8_t *data, uint32_t len, Bool verify)
+{
+	uint32_t n, i;
+
+	(void)verify;
+	if (dead || ((addr + len) > d->Size))
+	{
+		return ERROR;
+	}
+	while (len)
+	{
+		n = TEST_PAGE - (addr % TEST_PAGE);
+		if (n > len)
+		{
+			n = len;
+		}
+		if ((budget >= 0) && (budget < (long)n))
+		{
+			// Bytes before the cut are programmed, the rest of the page write is lost
+			for (i = 0; i < n; i++)
+			{
+				if ((long)i < budget)
+				{
+					mem[addr + i] = data[i];
+				}
+				else if (garble)
+				{
+					mem[addr + i] = rnd();
+				}
+			}
+			dead = TRUE;
+			return ERROR;
+		}
+		if (budget >= 0)
+		{
+			budget -= n;
+		}
+		memcpy(&mem[addr], data, n);
+		written += n;
+		addr += n;
+		data += n;
+		len -= n;
+	}
+	return SUCCESS;
+}
+
+Status EEPW_Read (EEPW_DEV_Type *d, uint32_t addr, uint8_t *buf, uint32_t len)
+{
+	if (dead || ((addr + len) > d->Size))
+	{
+		return ERROR;
+	}
+	memcpy(buf, &mem[addr], len);
+	return SUCCESS;
+}
+
+static Bool holds (int key, const uint8_t *val, int len)
+{
+	uint8_t buf[KV_VALUE_MAX], n = 0;
+	kv_error r = KV_Get(&kv, key, buf, sizeof(buf), &n);
+
+	if (len < 0)
+	{
+		return (r == KV_ERROR_NOT_FOUND);
+	}
+	return ((r == KV_OK) && (n == len) && !memcmp(buf, val, len));
+}
+
+static int others_bad (int skip)
+{
+	int k, bad = 0;
+
+	for (k = 0; k < TEST_KEYS; k++)
+	{
+		if ((k != skip) && !holds(k, model_val[k], model_len[k]))
+		{
+			bad++;
+		}
+	}
+	return bad;
+}
+
+static kv_error apply (Bool del, int key, const uint8_t *val, int len)
+{
+	return del ? KV_Delete(&kv, key) : KV_Set(&kv, key, val, len);
+}
+
+/* Main Program --------------------------------------------------------------- */
+int main (void)
+{
+	static uint8_t snap[TEST_SIZE];
+	uint8_t val[KV_VALUE_MAX];
+	uint32_t total, cut, cuts = 0, news = 0, olds = 0;
+	int op, key, len, i;
+	Bool del;
+	kv_error r;
+	KV_STATS_Type st;
+
+	memset(mem, 0xFF, sizeof(mem));
+	TEST_CHECK(KV_Format(&kv) == KV_OK, "format");
+	for (key = 0; key < TEST_KEYS; key++)
+	{
+		model_len[key] = -1;
+	}
+
+	for (op = 0; (op < TEST_OPS) && (test_fails < 10); op++)
+	{
+		key = rnd() % TEST_KEYS;
+		len = rnd() % (KV_VALUE_MAX + 1);
+		del = ((rnd() % 8) == 0) && (model_len[key] >= 0);
+		for (i = 0; i < len; i++)
+		{
+			val[i] = rnd();
+		}
+
+		// Count the bytes the operation writes when nothing goes wrong
+		memcpy(snap, mem, sizeof(mem));
+		written = 0;
+		TEST_CHECK(apply(del, key, val, len) == KV_OK, "op %d", op);
+		total = written;
+
+		// Cut the power after every byte of it, with the cut page unwritten or random
+		for (cut = 0; cut < (2 * total); cut++)
+		{
+			memcpy(mem, snap, sizeof(mem));
+			dead = FALSE;
+			budget = -1;
+			TEST_CHECK(KV_Mount(&kv) == KV_OK, "mount before op %d", op);
+
+			budget = cut / 2;
+			garble = (Bool)(cut & 1);
+			r = apply(del, key, val, len);
+			TEST_CHECK((r != KV_OK) && dead, "op %d cut %u did not fail", op, cut);
+
+			// Power up again
+			dead = FALSE;
+			budget = -1;
+			cuts++;
+			if (KV_Mount(&kv) != KV_OK)
+			{
+				TEST_CHECK(0, "mount after op %d cut %u", op, cut);
+				continue;
+			}
+			if (holds(key, model_val[key], model_len[key]))
+			{
+				olds++;
+			}
+			else if (del ? holds(key, val, -1) : holds(key, val, len))
+			{
+				news++;
+			}
+			else
+			{
+				TEST_CHECK(0, "op %d cut %u: key %d is neither old nor new", op, cut, key);
+			}
+			TEST_CHECK(others_bad(key) == 0, "op %d cut %u: other keys damaged", op, cut);
+		}
+
+		// Carry on from the uninterrupted result
+		memcpy(mem, snap, sizeof(mem));
+		dead = FALSE;
+		budget = -1;
+		TEST_CHECK((KV_Mount(&kv) == KV_OK) && (apply(del, key, val, len) == KV_OK), "redo op %d", op);
+		if (del)
+		{
+			model_len[key] = -1;
+		}
+		else
+		{
+			memcpy(model_val[key], val, len);
+			model_len[key] = len;
+		}
+		TEST_CHECK((KV_Mount(&kv) == KV_OK) && (others_bad(-1) == 0), "remount after op %d", op);
+	}
+
+	KV_GetStats(&kv, &st);
+	TEST_Print("%d ops, %u cuts: %u old, %u new, %u compactions\n", op, cuts, olds, news, st.Compactions);
+	TEST_CHECK(st.Compactions > 0, "no compaction was exercised");
+	return TEST_Done();
+}
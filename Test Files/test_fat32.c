@@ -0,0 +1,353 @@
+/******************************************************************//**
+* @file		test_fat32.c
+* @brief	Host test of the SD block layer and the FAT32 reader: a
+*           known card image is built, mounted through the simulated
+*           SPI card, its files are read and one is written in place
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+*
+* Build and run from the repository root:
+*   gcc -DLPC_HOST_SIM -no-pie -I"CM3 Core" -I"Header Files" \
+*       "CM3 Core/system_LPC17xx.c" "Source Files/lpc_host_sim.c" \
+*       "Source Files/lpc_fat32.c" "Source Files/lpc_spi_sd.c" \
+*       "Source Files/lpc17xx_spi.c" "Source Files/lpc_crc.c" \
+*       "Source Files/lpc17xx_clkpwr.c" "Source Files/lpc17xx_pinsel.c" \
+*       "Source Files/lpc17xx_gpio.c" "Test Files/test_fat32.c" -lm \
+*       -o test_fat32
+*   ./test_fat32
+**********************************************************************/
+
+/* Includes ------------------------------------------------------------------- */
+#include <fcntl.h>
+#include <stdlib.h>
+#include "lpc_fat32.h"
+#include "lpc_host_sim.h"
+#include "host_test.h"
+
+/* Private Macros ------------------------------------------------------------- */
+/* Card: 2 MB, MBR with one FAT32 partition, 1 KB clusters */
+#define IMG_BLOCKS			4096
+#define IMG_PART			8			/* Partition start, LBA */
+#define IMG_SPC				2			/* Sectors per cluster */
+#define IMG_RSVD			32			/* Reserved sectors */
+#define IMG_FATSZ			16			/* Sectors per FAT, two FATs */
+#define IMG_DATA			(IMG_PART + IMG_RSVD + 2 * IMG_FATSZ)
+#define IMG_CLUSTER			(IMG_SPC * 512)
+#define IMG_EOC				0x0FFFFFFF
+
+/* Files */
+#define HELLO_CL			3
+#define DATA_SIZE			17531		/* 18 clusters, the last one partly used */
+#define LOG_CL0				70			/* LOG directory, two clusters */
+#define LOG_CL1				72
+#define RUN_CL				80			/* LOG/RUN01.BIN, 4 clusters in a row */
+#define RUN_SIZE			4096
+
+#define CLUSTER_LBA(c)		(IMG_DATA + ((c) - 2) * IMG_SPC)
+
+/* Private Variables ---------------------------------------------------------- */
+static const char hello[] = "Hello from the LPC17xx FAT32 reader, read over SPI.\r\n";
+
+/* DATA.BIN chain: runs, backward jumps and more runs than FAT_EXTENTS */
+static const uint32_t data_chain[] = {
+	10, 11, 12, 5, 6, 30, 29, 40, 41, 8, 50, 52, 54, 56, 58, 60, 61, 62
+};
+
+static uint8_t img[IMG_BLOCKS * 512];
+static uint8_t buf[32 * 1024];
+static uint8_t disk[IMG_BLOCKS * 512];
+
+/* Private Functions ---------------------------------------------------------- */
+static uint8_t pat (int fid, uint32_t i)
+{
+	return (uint8_t)((i * 31) + (fid * 7) + (i >> 9));
+}
+
+static void st16 (uint8_t *p, uint32_t v)
+{
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+}
+
+static void st32 (uint8_t *p, uint32_t v)
+{
+	st16(p, v);
+	st16(p + 2, v >> 16);
+}
+
+/* Set a FAT entry in both FATs */
+static void fat_set (uint32_t cl, uint32_t next)
+{
+	st32(&img[(IMG_PART + IMG_RSVD) * 512 + cl * 4], next);
+	st32(&img[(IMG_PART + IMG_RSVD + IMG_FATSZ) * 512 + cl * 4], next);
+}
+
+/* 8.3 directory entry number n of the directory cluster cl */
+static uint8_t *dir_entry (uint32_t cl, uint32_t n, const char *name, uint8_t attr,
+						   uint32_t first, uint32_t size)
+{
+	uint8_t *e = &img[CLUSTER_LBA(cl) * 512 + n * 32];
+
+	memcpy(e, name, 11);
+	e[11] = attr;
+	st16(&e[20], first >> 16);
+	st16(&e[26], first);
+	st32(&e[28], size);
+	return e;
+}
+
+static void image_build (void)
+{
+	uint8_t *p, *e;
+	uint32_t i, n;
+	char name[12];
+
+	memset(img, 0, sizeof(img));
+
+	// MBR, partition 1 of type 0x0C (FAT32 LBA)
+	p = &img[0x1BE];
+	p[4] = 0x0C;
+	st32(&p[8], IMG_PART);
+	st32(&p[12], IMG_BLOCKS - IMG_PART);
+	img[510] = 0x55;
+	img[511] = 0xAA;
+
+	// Volume boot record
+	p = &img[IMG_PART * 512];
+	memcpy(p, "\xEB\x58\x90MSWIN4.1", 11);
+	st16(&p[0x0B], 512);
+	p[0x0D] = IMG_SPC;
+	st16(&p[0x0E], IMG_RSVD);
+	p[0x10] = 2;
+	p[0x15] = 0xF8;
+	st32(&p[0x1C], IMG_PART);
+	st32(&p[0x20], IMG_BLOCKS - IMG_PART);
+	st32(&p[0x24], IMG_FATSZ);
+	st32(&p[0x2C], 2);
+	p[0x42] = 0x29;
+	memcpy(&p[0x47], "NO NAME    FAT32   ", 19);
+	p[510] = 0x55;
+	p[511] = 0xAA;
+
+	fat_set(0, 0x0FFFFFF8);
+	fat_set(1, IMG_EOC);
+
+	// Root directory: label, long name entry, HELLO.TXT, a deleted
+	// entry, DATA.BIN, an empty file and LOG
+	fat_set(2, IMG_EOC);
+	dir_entry(2, 0, "SIMCARD    ", FAT_ATTR_VOLUME_ID, 0, 0);
+	e = dir_entry(2, 1, "\x41h\0e\0l\0l\0", FAT_ATTR_LFN, 0, 0);
+	e[13] = 0x5A;
+	dir_entry(2, 2, "HELLO   TXT", FAT_ATTR_ARCHIVE, HELLO_CL, sizeof(hello) - 1);
+	fat_set(HELLO_CL, IMG_EOC);
+	memcpy(&img[CLUSTER_LBA(HELLO_CL) * 512], hello, sizeof(hello) - 1);
+	e = dir_entry(2, 3, "OLD     BIN", FAT_ATTR_ARCHIVE, 90, 10);
+	e[0] = 0xE5;
+	dir_entry(2, 4, "DATA    BIN", FAT_ATTR_ARCHIVE, data_chain[0], DATA_SIZE);
+	dir_entry(2, 5, "EMPTY   DAT", FAT_ATTR_ARCHIVE, 0, 0);
+	dir_entry(2, 6, "LOG        ", FAT_ATTR_DIRECTORY, LOG_CL0, 0);
+
+	n = sizeof(data_chain) / sizeof(data_chain[0]);
+	for (i = 0; i < n; i++)
+	{
+		fat_set(data_chain[i], (i + 1 < n) ? data_chain[i + 1] : IMG_EOC);
+	}
+	for (i = 0; i < DATA_SIZE; i++)
+	{
+		img[CLUSTER_LBA(data_chain[i / IMG_CLUSTER]) * 512 + (i % IMG_CLUSTER)] = pat(2, i);
+	}
+
+	// LOG: the first cluster full of empty files, RUN01.BIN in the second
+	fat_set(LOG_CL0, LOG_CL1);
+	fat_set(LOG_CL1, IMG_EOC);
+	dir_entry(LOG_CL0, 0, ".          ", FAT_ATTR_DIRECTORY, LOG_CL0, 0);
+	dir_entry(LOG_CL0, 1, "..         ", FAT_ATTR_DIRECTORY, 0, 0);
+	for (i = 2; i < IMG_CLUSTER / 32; i++)
+	{
+		memcpy(name, "F0000000BIN", 12);
+		name[6] = (char)('0' + (i / 10));
+		name[7] = (char)('0' + (i % 10));
+		dir_entry(LOG_CL0, i, name, FAT_ATTR_ARCHIVE, 0, 0);
+	}
+	dir_entry(LOG_CL1, 0, "RUN01   BIN", FAT_ATTR_ARCHIVE, RUN_CL, RUN_SIZE);
+	for (i = 0; i < RUN_SIZE / IMG_CLUSTER; i++)
+	{
+		fat_set(RUN_CL + i, (i + 1 < RUN_SIZE / IMG_CLUSTER) ? RUN_CL + i + 1 : IMG_EOC);
+	}
+}
+
+static Bool image_write (const char *path)
+{
+	int fd = open(path, O_WRONLY | O_TRUNC);
+	Bool ok;
+
+	if (fd < 0)
+	{
+		return FALSE;
+	}
+	ok = (write(fd, img, sizeof(img)) == (ssize_t)sizeof(img)) ? TRUE : FALSE;
+	close(fd);
+	return ok;
+}
+
+static Bool image_read (const char *path)
+{
+	int fd = open(path, O_RDONLY);
+	Bool ok;
+
+	if (fd < 0)
+	{
+		return FALSE;
+	}
+	ok = (read(fd, disk, sizeof(disk)) == (ssize_t)sizeof(disk)) ? TRUE : FALSE;
+	close(fd);
+	return ok;
+}
+
+/* Insert the card and mount it */
+static Bool card_mount (const char *path)
+{
+	TEST_CHECK(HOSTSIM_SDCardOpen(path, FALSE) == SUCCESS, "card open");
+	SPI_Config(LPC_SPI);
+	TEST_CHECK(SD_Init(5) == SD_OK, "SD_Init");
+	TEST_CHECK(FAT_Mount() == FAT_OK, "FAT_Mount");
+	return (test_fails == 0) ? TRUE : FALSE;
+}
+
+static Bool check (int fid, const uint8_t *data, uint32_t from, uint32_t len)
+{
+	uint32_t i;
+
+	for (i = 0; i < len; i++)
+	{
+		if (data[i] != pat(fid, from + i))
+		{
+			TEST_Print("file %d differs at %u\n", fid, from + i);
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/* Read DATA.BIN through in chunk sized reads */
+static void data_read (uint32_t chunk)
+{
+	FAT_FILE_Type f;
+	uint32_t pos = 0, n;
+
+	TEST_CHECK(FAT_Open(&f, "/DATA.BIN") == FAT_OK, "open DATA.BIN");
+	while ((n = FAT_Read(&f, buf, chunk)) > 0)
+	{
+		if (!check(2, buf, pos, n))
+		{
+			TEST_CHECK(0, "DATA.BIN read in %u byte chunks", chunk);
+			return;
+		}
+		pos += n;
+	}
+	TEST_CHECK(pos == DATA_SIZE, "DATA.BIN in %u byte chunks: %u of %u bytes", chunk, pos, DATA_SIZE);
+}
+
+/* Main Program --------------------------------------------------------------- */
+int main (void)
+{
+	static const uint32_t chunks[] = { 1, 1000, sizeof(buf) };
+	char path[] = "/tmp/test_fat32_XXXXXX";
+	FAT_FILE_Type f;
+	FAT_STATS_Type st;
+	uint32_t i, pos, len, n, seed = 12345;
+	int fd;
+
+	HOSTSIM_Init();
+	SystemInit();
+	image_build();
+	fd = mkstemp(path);
+	TEST_CHECK(fd >= 0, "temporary image");
+	if (fd < 0)
+	{
+		return TEST_Done();
+	}
+	close(fd);
+	TEST_CHECK(image_write(path), "image write");
+	if (!card_mount(path))
+	{
+		unlink(path);
+		return TEST_Done();
+	}
+
+	// A short file, by a lower case name
+	TEST_CHECK(FAT_Open(&f, "hello.txt") == FAT_OK, "open hello.txt");
+	TEST_CHECK(f.Size == sizeof(hello) - 1, "HELLO.TXT size %u", f.Size);
+	memset(buf, 0, sizeof(buf));
+	n = FAT_Read(&f, buf, sizeof(buf));
+	TEST_CHECK((n == sizeof(hello) - 1) && !memcmp(buf, hello, n), "HELLO.TXT content");
+	TEST_CHECK(FAT_Read(&f, buf, 1) == 0, "HELLO.TXT read past the end");
+
+	// A fragmented file, in chunks smaller and larger than a cluster, and
+	// at random positions
+	for (i = 0; i < sizeof(chunks) / sizeof(chunks[0]); i++)
+	{
+		data_read(chunks[i]);
+	}
+	TEST_CHECK(FAT_Open(&f, "DATA.BIN") == FAT_OK, "open DATA.BIN");
+	for (i = 0; i < 16; i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		pos = (seed >> 8) % DATA_SIZE;
+		len = (seed >> 3) % 1500;
+		TEST_CHECK(FAT_Seek(&f, pos) == FAT_OK, "seek %u", pos);
+		n = FAT_Read(&f, buf, len);
+		TEST_CHECK((n == ((len < DATA_SIZE - pos) ? len : DATA_SIZE - pos)) && check(2, buf, pos, n),
+				   "DATA.BIN %u bytes at %u", len, pos);
+	}
+	TEST_CHECK(FAT_Seek(&f, DATA_SIZE + 1) == FAT_ERROR_RANGE, "seek past the end");
+
+	// Names that must not open
+	TEST_CHECK(FAT_Open(&f, "NOPE.BIN") == FAT_ERROR_NOT_FOUND, "NOPE.BIN");
+	TEST_CHECK(FAT_Open(&f, "OLD.BIN") == FAT_ERROR_NOT_FOUND, "deleted OLD.BIN");
+	TEST_CHECK(FAT_Open(&f, "HELLO.TXT/X") == FAT_ERROR_NOT_FOUND, "HELLO.TXT/X");
+	TEST_CHECK(FAT_Open(&f, "LOG") == FAT_ERROR_NOT_FOUND, "directory LOG");
+	TEST_CHECK((FAT_Open(&f, "EMPTY.DAT") == FAT_OK) && (f.Size == 0) && (FAT_Read(&f, buf, 1) == 0),
+			   "EMPTY.DAT");
+
+	// Overwrite a file in the second cluster of a directory, in writes
+	// that cross sectors and clusters; it does not grow
+	TEST_CHECK(FAT_Open(&f, "LOG/RUN01.BIN") == FAT_OK, "open LOG/RUN01.BIN");
+	TEST_CHECK(f.Size == RUN_SIZE, "RUN01.BIN size %u", f.Size);
+	for (i = 0; i < RUN_SIZE; i++)
+	{
+		buf[i] = pat(9, i);
+	}
+	n = FAT_Write(&f, buf, 100);
+	n += FAT_Write(&f, buf + 100, 1500);
+	n += FAT_Write(&f, buf + 1600, RUN_SIZE);
+	TEST_CHECK(n == RUN_SIZE, "RUN01.BIN wrote %u", n);
+	TEST_CHECK(FAT_Write(&f, buf, 10) == 0, "RUN01.BIN write past the end");
+	FAT_GetStats(&st);
+	TEST_Print("%u sectors read in %u reads (%u FAT), %u written in %u writes\n",
+			   st.SectorsRead, st.DiskReads, st.FatReads, st.SectorsWritten, st.DiskWrites);
+
+	// Take the card out, it holds the file and nothing else changed
+	HOSTSIM_SDCardClose();
+	TEST_CHECK(image_read(path), "image read back");
+	for (i = 0; i < RUN_SIZE; i++)
+	{
+		img[CLUSTER_LBA(RUN_CL) * 512 + i] = pat(9, i);
+	}
+	TEST_CHECK(!memcmp(disk, img, sizeof(img)), "card image after the write");
+
+	// And in again: the file reads back through the FAT
+	if (card_mount(path))
+	{
+		memset(buf, 0, sizeof(buf));
+		TEST_CHECK(FAT_Open(&f, "log/run01.bin") == FAT_OK, "reopen log/run01.bin");
+		n = FAT_Read(&f, buf, sizeof(buf));
+		TEST_CHECK((n == RUN_SIZE) && check(9, buf, 0, n), "RUN01.BIN read back");
+		HOSTSIM_SDCardClose();
+	}
+	unlink(path);
+	return TEST_Done();
+}
+
+/* --------------------------------- End Of File ------------------------------ */
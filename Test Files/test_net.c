@@ -0,0 +1,453 @@
+/******************************************************************//**
+* @file		test_net.c
+* @brief	Host test of the ARP/IPv4/ICMP/UDP stack: frames built here
+*           are replayed from a pcap file into the simulated EMAC and
+*           every frame sent back is checked field by field, then the
+*           EMAC Tx fragment limits and interrupt counters
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+*
+* Build and run from the repository root:
+*   gcc -DLPC_HOST_SIM -no-pie -I"CM3 Core" -I"Header Files" \
+*       "CM3 Core/system_LPC17xx.c" "Source Files/lpc_host_sim.c" \
+*       "Source Files/lpc_net.c" "Source Files/lpc17xx_emac.c" \
+*       "Source Files/lpc_crc.c" "Source Files/lpc17xx_uart.c" \
+*       "Source Files/lpc_fmt.c" "Source Files/lpc17xx_clkpwr.c" \
+*       "Source Files/lpc17xx_pinsel.c" \
+*       "Test Files/test_net.c" -lm -o test_net
+*   ./test_net
+**********************************************************************/
+
+/* Includes ------------------------------------------------------------------- */
+#include <fcntl.h>
+#include <stdlib.h>
+#include "lpc_net.h"
+#include "lpc17xx_uart.h"
+#include "lpc_host_sim.h"
+#include "host_test.h"
+
+/* Private Macros ------------------------------------------------------------- */
+#define MY_IP				NET_IP4(10, 0, 0, 10)
+#define PEER_IP				NET_IP4(10, 0, 0, 2)
+#define PARK_IP				NET_IP4(10, 0, 0, 3)
+#define ECHO_PORT			5000
+#define PEER_PORT			4000
+
+#define TX_FRAMES			16
+#define PROTO_ICMP			1
+#define PROTO_UDP			17
+
+/* UDP checksum of a frame built here */
+#define CS_GOOD				0
+#define CS_BAD				1
+#define CS_NONE				2
+
+/* Private Variables ---------------------------------------------------------- */
+static const uint8_t my_mac[6] = { 0x1F, 0x10, 0x12, 0xE0, 0x0C, 0x1D };
+static const uint8_t peer_mac[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x02 };
+static const uint8_t park_mac[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x03 };
+static const uint8_t other_mac[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x09 };
+static const uint8_t bcast_mac[6] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+
+/* pcap file being built */
+static uint8_t pcap[16 * 1024];
+static uint32_t pcap_len;
+
+/* Frames the EMAC sent */
+static uint8_t tx[TX_FRAMES][EMAC_ETH_MAX_FLEN];
+static uint32_t tx_len[TX_FRAMES];
+static uint32_t tx_n;
+
+/* Datagrams passed to the echo socket */
+static uint32_t rx_n;
+/* Characters written to UART0 */
+static uint32_t uart_n;
+
+/* Private Functions ---------------------------------------------------------- */
+static void st16 (uint8_t *p, uint32_t v)
+{
+	p[0] = (uint8_t)(v >> 8);
+	p[1] = (uint8_t)v;
+}
+
+static uint16_t ld16 (const uint8_t *p)
+{
+	return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+/* Ones complement sum, folded and not inverted */
+static uint16_t sum16 (uint32_t sum, const uint8_t *p, uint32_t len)
+{
+	while (len > 1)
+	{
+		sum += ld16(p);
+		p += 2;
+		len -= 2;
+	}
+	if (len)
+	{
+		sum += (uint32_t)p[0] << 8;
+	}
+	while (sum >> 16)
+	{
+		sum = (sum & 0xFFFF) + (sum >> 16);
+	}
+	return (uint16_t)sum;
+}
+
+/* UDP pseudo header sum */
+static uint32_t pseudo (const uint8_t *ip, uint32_t len)
+{
+	return sum16(PROTO_UDP + len, &ip[12], 8);
+}
+
+static uint32_t eth_hdr (uint8_t *f, const uint8_t *dst, const uint8_t *src, uint16_t type)
+{
+	memcpy(f, dst, 6);
+	memcpy(f + 6, src, 6);
+	st16(f + 12, type);
+	return NET_ETH_HLEN;
+}
+
+static uint32_t arp_frame (uint8_t *f, const uint8_t *dst, uint16_t op, const uint8_t *sha,
+						   uint32_t spa, const uint8_t *tha, uint32_t tpa)
+{
+	uint8_t *a = f + eth_hdr(f, dst, sha, 0x0806);
+
+	st16(a, 1);
+	st16(a + 2, 0x0800);
+	a[4] = 6;
+	a[5] = 4;
+	st16(a + 6, op);
+	memcpy(a + 8, sha, 6);
+	memcpy(a + 14, &spa, 4);
+	memcpy(a + 18, tha, 6);
+	memcpy(a + 24, &tpa, 4);
+	return NET_ETH_HLEN + 28;
+}
+
+/* IPv4 frame from the peer around a payload already at f + 34 */
+static uint32_t ip_frame (uint8_t *f, const uint8_t *dst, uint32_t dip, uint8_t proto,
+						  uint32_t len, uint16_t frag)
+{
+	uint8_t *ip = f + eth_hdr(f, dst, peer_mac, 0x0800);
+	uint32_t src = PEER_IP;
+
+	ip[0] = 0x45;
+	ip[1] = 0;
+	st16(ip + 2, NET_IP_HLEN + len);
+	st16(ip + 4, 1);
+	st16(ip + 6, frag);
+	ip[8] = 64;
+	ip[9] = proto;
+	st16(ip + 10, 0);
+	memcpy(ip + 12, &src, 4);
+	memcpy(ip + 16, &dip, 4);
+	st16(ip + 10, ~sum16(0, ip, NET_IP_HLEN));
+	return NET_ETH_HLEN + NET_IP_HLEN + len;
+}
+
+static uint32_t icmp_frame (uint8_t *f, uint16_t seq, const uint8_t *data, uint32_t len)
+{
+	uint8_t *m = f + NET_ETH_HLEN + NET_IP_HLEN;
+
+	m[0] = 8;
+	m[1] = 0;
+	st16(m + 2, 0);
+	st16(m + 4, 7);
+	st16(m + 6, seq);
+	memcpy(m + 8, data, len);
+	st16(m + 2, ~sum16(0, m, 8 + len));
+	return ip_frame(f, my_mac, MY_IP, PROTO_ICMP, 8 + len, 0);
+}
+
+static uint32_t udp_frame (uint8_t *f, const uint8_t *dst, uint32_t dip, uint16_t dport,
+						   const char *data, uint8_t cs, uint16_t frag)
+{
+	uint8_t *u = f + NET_ETH_HLEN + NET_IP_HLEN;
+	uint32_t len = 8 + strlen(data), n;
+	uint16_t c;
+
+	st16(u, PEER_PORT);
+	st16(u + 2, dport);
+	st16(u + 4, len);
+	st16(u + 6, 0);
+	memcpy(u + 8, data, len - 8);
+	n = ip_frame(f, dst, dip, PROTO_UDP, len, frag);
+	c = ~sum16(pseudo(f + NET_ETH_HLEN, len), u, len);
+	if (cs == CS_NONE)
+	{
+		c = 0;
+	}
+	else
+	{
+		c = (c == 0) ? 0xFFFF : c;
+		c ^= (cs == CS_BAD) ? 0x1234 : 0;
+	}
+	st16(u + 6, c);
+	return n;
+}
+
+static void pcap_start (void)
+{
+	static const uint32_t hdr[6] = { 0xA1B2C3D4, 0x00040002, 0, 0, 65535, 1 };
+
+	memcpy(pcap, hdr, sizeof(hdr));
+	pcap_len = sizeof(hdr);
+}
+
+static void pcap_add (const uint8_t *f, uint32_t len)
+{
+	uint32_t rec[4];
+
+	rec[0] = 1;
+	rec[1] = 0;
+	rec[2] = len;
+	rec[3] = len;
+	memcpy(&pcap[pcap_len], rec, sizeof(rec));
+	memcpy(&pcap[pcap_len + sizeof(rec)], f, len);
+	pcap_len += sizeof(rec) + len;
+}
+
+/* Firmware loop run between the replayed frames */
+static void poll (void)
+{
+	NET_Poll();
+}
+
+/* Write the pcap to path and replay it */
+static int32_t pcap_replay (const char *path)
+{
+	int fd = open(path, O_WRONLY | O_TRUNC);
+
+	if ((fd < 0) || (write(fd, pcap, pcap_len) != (ssize_t)pcap_len))
+	{
+		return -1;
+	}
+	close(fd);
+	return HOSTSIM_EMACReplayPcap(path, poll);
+}
+
+static void tx_sink (const uint8_t *frame, uint32_t len)
+{
+	if (tx_n < TX_FRAMES)
+	{
+		memcpy(tx[tx_n], frame, (len < EMAC_ETH_MAX_FLEN) ? len : EMAC_ETH_MAX_FLEN);
+		tx_len[tx_n] = len;
+	}
+	tx_n++;
+}
+
+static void uart0_sink (uint8_t port, uint8_t c)
+{
+	(void)port;
+	(void)c;
+	uart_n++;
+}
+
+static void udp_echo (uint32_t srcIp, uint16_t srcPort, uint16_t dstPort, const uint8_t *data, uint16_t len)
+{
+	TEST_CHECK((srcIp == PEER_IP) && (srcPort == PEER_PORT) && (dstPort == ECHO_PORT),
+			   "datagram from %08x:%u to %u", srcIp, srcPort, dstPort);
+	rx_n++;
+	NET_UdpSendTo(srcIp, dstPort, srcPort, data, len);
+}
+
+static void run (uint32_t us)
+{
+	uint64_t end = HOSTSIM_GetCycles() + HOSTSIM_UsToCycles(us);
+
+	while (HOSTSIM_GetCycles() < end)
+	{
+		HOSTSIM_Advance(1000);
+		NET_Poll();
+	}
+}
+
+/* Frame n is an ARP packet with these fields */
+static void check_arp (uint32_t n, const uint8_t *dst, uint16_t op, uint32_t tpa)
+{
+	const uint8_t *f = tx[n], *a = f + NET_ETH_HLEN;
+	uint32_t spa = MY_IP;
+
+	TEST_CHECK((n < tx_n) && (tx_len[n] >= NET_ETH_HLEN + 28), "frame %u: no ARP", n);
+	TEST_CHECK(!memcmp(f, dst, 6) && !memcmp(f + 6, my_mac, 6) && (ld16(f + 12) == 0x0806),
+			   "frame %u: ARP Ethernet header", n);
+	TEST_CHECK((ld16(a) == 1) && (ld16(a + 2) == 0x0800) && (a[4] == 6) && (a[5] == 4) &&
+			   (ld16(a + 6) == op), "frame %u: ARP op %u", n, op);
+	TEST_CHECK(!memcmp(a + 8, my_mac, 6) && !memcmp(a + 14, &spa, 4) && !memcmp(a + 24, &tpa, 4),
+			   "frame %u: ARP addresses", n);
+	if (op == 2)
+	{
+		TEST_CHECK(!memcmp(a + 18, dst, 6), "frame %u: ARP target MAC", n);
+	}
+}
+
+/* Frame n is an IPv4 packet from us; returns its payload and length */
+static const uint8_t *check_ip (uint32_t n, const uint8_t *dst, uint32_t dip, uint8_t proto, uint32_t *len)
+{
+	const uint8_t *f = tx[n], *ip = f + NET_ETH_HLEN;
+	uint32_t sip = MY_IP;
+
+	*len = 0;
+	TEST_CHECK((n < tx_n) && (tx_len[n] >= NET_ETH_HLEN + NET_IP_HLEN), "frame %u: no IP", n);
+	if ((n >= tx_n) || (tx_len[n] < NET_ETH_HLEN + NET_IP_HLEN))
+	{
+		return ip;
+	}
+	TEST_CHECK(!memcmp(f, dst, 6) && !memcmp(f + 6, my_mac, 6) && (ld16(f + 12) == 0x0800),
+			   "frame %u: IP Ethernet header", n);
+	TEST_CHECK((ip[0] == 0x45) && (ip[9] == proto) && (ip[8] > 0) && !(ld16(ip + 6) & 0x3FFF),
+			   "frame %u: IP header", n);
+	TEST_CHECK(!memcmp(ip + 12, &sip, 4) && !memcmp(ip + 16, &dip, 4), "frame %u: IP addresses", n);
+	TEST_CHECK(sum16(0, ip, NET_IP_HLEN) == 0xFFFF, "frame %u: IP checksum", n);
+	*len = ld16(ip + 2) - NET_IP_HLEN;
+	TEST_CHECK(NET_ETH_HLEN + NET_IP_HLEN + *len <= tx_len[n], "frame %u: IP length", n);
+	return ip + NET_IP_HLEN;
+}
+
+static void check_echo (uint32_t n, uint16_t seq, const uint8_t *data, uint32_t dlen)
+{
+	uint32_t len;
+	const uint8_t *m = check_ip(n, peer_mac, PEER_IP, PROTO_ICMP, &len);
+
+	TEST_CHECK((len == 8 + dlen) && (m[0] == 0) && (m[1] == 0), "frame %u: echo reply header", n);
+	TEST_CHECK((len == 8 + dlen) && (sum16(0, m, len) == 0xFFFF), "frame %u: ICMP checksum", n);
+	TEST_CHECK((ld16(m + 4) == 7) && (ld16(m + 6) == seq) && !memcmp(m + 8, data, dlen),
+			   "frame %u: echo reply content", n);
+}
+
+static void check_udp (uint32_t n, const uint8_t *dst, uint32_t dip, uint16_t sport, uint16_t dport,
+					   const char *data)
+{
+	uint32_t len, dlen = strlen(data);
+	const uint8_t *u = check_ip(n, dst, dip, PROTO_UDP, &len);
+
+	TEST_CHECK((len == 8 + dlen) && (ld16(u + 4) == len), "frame %u: UDP length", n);
+	TEST_CHECK((ld16(u) == sport) && (ld16(u + 2) == dport), "frame %u: UDP ports", n);
+	TEST_CHECK((len == 8 + dlen) && (ld16(u + 6) != 0) &&
+			   (sum16(pseudo(u - NET_IP_HLEN, len), u, len) == 0xFFFF), "frame %u: UDP checksum", n);
+	TEST_CHECK(!memcmp(u + 8, data, dlen), "frame %u: UDP data", n);
+}
+
+/* Main Program --------------------------------------------------------------- */
+int main (void)
+{
+	static uint8_t f[EMAC_ETH_MAX_FLEN];
+	static const NET_CFG_Type net = {
+		.Mac = { 0x1F, 0x10, 0x12, 0xE0, 0x0C, 0x1D },
+		.Ip = MY_IP, .Mask = NET_IP4(255, 255, 255, 0), .Gateway = NET_IP4(10, 0, 0, 1)
+	};
+	EMAC_CFG_Type emac = { .Mode = EMAC_MODE_AUTO, .pbEMAC_Addr = (uint8_t *)my_mac };
+	char path[] = "/tmp/test_net_XXXXXX";
+	uint8_t ping[64], mac[6];
+	NET_STATS_Type st;
+	EMAC_PBUF_Type pb;
+	uint32_t i;
+	int fd;
+
+	HOSTSIM_Init();
+	SystemInit();
+	HOSTSIM_EMACSetLink(TRUE);
+	HOSTSIM_EMACSetSink(tx_sink);
+	UART_Config(LPC_UART0, 115200);
+	TEST_CHECK(EMAC_Init(&emac) == SUCCESS, "EMAC_Init");
+	NET_Init(&net);
+	TEST_CHECK(NET_UdpBind(ECHO_PORT, udp_echo) == SUCCESS, "bind");
+	UART_TxFlush(LPC_UART0);
+	HOSTSIM_UARTSetSink(0, uart0_sink);
+	EMAC_IntCmd(EMAC_INT_RX_OVERRUN | EMAC_INT_RX_ERR | EMAC_INT_RX_FIN | EMAC_INT_RX_DONE |
+				EMAC_INT_TX_UNDERRUN | EMAC_INT_TX_ERR | EMAC_INT_TX_FIN | EMAC_INT_TX_DONE, ENABLE);
+	NVIC_EnableIRQ(ENET_IRQn);
+	fd = mkstemp(path);
+	TEST_CHECK(fd >= 0, "temporary pcap");
+	if (fd < 0)
+	{
+		return TEST_Done();
+	}
+	close(fd);
+	for (i = 0; i < sizeof(ping); i++)
+	{
+		ping[i] = (uint8_t)(i * 3 + 1);
+	}
+
+	// Requests and frames that must be dropped, in one capture
+	pcap_start();
+	pcap_add(f, arp_frame(f, bcast_mac, 1, peer_mac, PEER_IP, bcast_mac, MY_IP));
+	pcap_add(f, arp_frame(f, bcast_mac, 1, peer_mac, PEER_IP, bcast_mac, NET_IP4(10, 0, 0, 99)));
+	pcap_add(f, icmp_frame(f, 1, ping, 56));
+	pcap_add(f, icmp_frame(f, 2, ping, 33));
+	pcap_add(f, udp_frame(f, my_mac, MY_IP, ECHO_PORT, "hello sensor", CS_GOOD, 0));
+	pcap_add(f, udp_frame(f, my_mac, MY_IP, ECHO_PORT, "bad", CS_BAD, 0));
+	pcap_add(f, udp_frame(f, my_mac, MY_IP, ECHO_PORT, "nocsum!", CS_NONE, 0));
+	pcap_add(f, udp_frame(f, my_mac, MY_IP, ECHO_PORT + 1, "closed", CS_GOOD, 0));
+	pcap_add(f, udp_frame(f, my_mac, MY_IP, ECHO_PORT, "frag", CS_GOOD, 0x2000));
+	pcap_add(f, udp_frame(f, bcast_mac, NET_IP4(10, 0, 0, 255), ECHO_PORT, "bcast", CS_GOOD, 0));
+	pcap_add(f, udp_frame(f, other_mac, MY_IP, ECHO_PORT, "not mine", CS_GOOD, 0));
+	i = icmp_frame(f, 3, ping, 4);
+	f[NET_ETH_HLEN + 10] ^= 1;
+	pcap_add(f, i);
+	TEST_CHECK(pcap_replay(path) == 12, "replay");
+	run(2000);
+
+	// ARP reply, two echo replies and the three datagrams echoed, in order
+	TEST_CHECK(tx_n == 6, "%u frames sent, 6 expected", tx_n);
+	check_arp(0, peer_mac, 2, PEER_IP);
+	check_echo(1, 1, ping, 56);
+	check_echo(2, 2, ping, 33);
+	check_udp(3, peer_mac, PEER_IP, ECHO_PORT, PEER_PORT, "hello sensor");
+	check_udp(4, peer_mac, PEER_IP, ECHO_PORT, PEER_PORT, "nocsum!");
+	check_udp(5, peer_mac, PEER_IP, ECHO_PORT, PEER_PORT, "bcast");
+	TEST_CHECK(rx_n == 3, "%u datagrams received, 3 expected", rx_n);
+	NET_GetStats(&st);
+	TEST_CHECK((st.ArpReplies == 1) && (st.EchoReplies == 2) && (st.UdpReceived == 3) &&
+			   (st.UdpSent == 3) && (st.ChecksumErrors == 2) && (st.TxBusy == 0),
+			   "stats: arp %u echo %u udp rx %u tx %u csum %u busy %u", st.ArpReplies,
+			   st.EchoReplies, st.UdpReceived, st.UdpSent, st.ChecksumErrors, st.TxBusy);
+
+	// A datagram to an unknown neighbour waits for its ARP reply
+	tx_n = 0;
+	TEST_CHECK(NET_ArpLookup(PARK_IP, mac) == ERROR, "%08x is not known yet", PARK_IP);
+	TEST_CHECK(NET_UdpSendTo(PARK_IP, 6000, 7000, (const uint8_t *)"parked", 6) == SUCCESS, "send parked");
+	run(2000);
+	TEST_CHECK(tx_n == 1, "%u frames sent, 1 ARP request expected", tx_n);
+	check_arp(0, bcast_mac, 1, PARK_IP);
+	pcap_start();
+	pcap_add(f, arp_frame(f, my_mac, 2, park_mac, PARK_IP, my_mac, MY_IP));
+	TEST_CHECK(pcap_replay(path) == 1, "replay ARP reply");
+	run(2000);
+	TEST_CHECK(tx_n == 2, "%u frames sent, the parked datagram expected", tx_n);
+	check_udp(1, park_mac, PARK_IP, 6000, 7000, "parked");
+	TEST_CHECK((NET_ArpLookup(PARK_IP, mac) == SUCCESS) && !memcmp(mac, park_mac, 6), "ARP cache");
+
+	// A claimed buffer holds EMAC_ETH_MAX_FLEN bytes: a fragment running past
+	// its end is refused and stays claimed, a full one is sent whole
+	tx_n = 0;
+	TEST_CHECK(EMAC_TxClaim(&pb) == SUCCESS, "claim");
+	memset(pb.pbData, 0x5A, EMAC_ETH_MAX_FLEN);
+	pb.ulDataLen = EMAC_ETH_MAX_FLEN + 1;
+	TEST_CHECK(EMAC_TxSend(&pb, 1) == ERROR, "%u byte fragment accepted", pb.ulDataLen);
+	pb.pbData += 10;
+	pb.ulDataLen = EMAC_ETH_MAX_FLEN - 9;
+	TEST_CHECK(EMAC_TxSend(&pb, 1) == ERROR, "fragment past the buffer end accepted");
+	pb.pbData -= 10;
+	pb.ulDataLen = EMAC_ETH_MAX_FLEN;
+	TEST_CHECK((pb.bIndex != EMAC_PBUF_CALLER) && (EMAC_TxSend(&pb, 1) == SUCCESS),
+			   "%u byte fragment refused", pb.ulDataLen);
+	run(2000);
+	TEST_CHECK((tx_n == 1) && (tx_len[0] == EMAC_ETH_MAX_FLEN) && (tx[0][EMAC_ETH_MAX_FLEN - 1] == 0x5A),
+			   "%u frames sent, the full buffer expected", tx_n);
+
+	// The handler only counts: frames in and out print nothing on UART0
+	TEST_CHECK((RxDoneCount > 0) && (TxDoneCount > 0), "interrupts: rx done %u, tx done %u",
+			   RxDoneCount, TxDoneCount);
+	TEST_CHECK(uart_n == 0, "%u characters printed on UART0 while passing frames", uart_n);
+
+	unlink(path);
+	NET_GetStats(&st);
+	TEST_Print("%u frames in, %u dropped, %u checksum errors\n", st.RxFrames, st.RxDropped, st.ChecksumErrors);
+	return TEST_Done();
+}
+
+/* --------------------------------- End Of File ------------------------------ */
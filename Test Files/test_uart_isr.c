@@ -0,0 +1,139 @@
+/******************************************************************//**
+* @file		test_uart_isr.c
+* @brief	Host test of the UART0 Tx ring with printf() from a handler:
+*           SysTick prints while a long thread printf() is filling the
+*           ring, both outputs must arrive whole and in order
+* @version	1.0
+* @date		18. Oct. 2026
+* @author	Dwijay.Edutech Learning Solutions
+*
+* Build and run from the repository root:
+*   gcc -DLPC_HOST_SIM -no-pie -I"CM3 Core" -I"Header Files" \
+*       "CM3 Core/system_LPC17xx.c" "Source Files/lpc_host_sim.c" \
+*       "Source Files/lpc17xx_uart.c" "Source Files/lpc_fmt.c" \
+*       "Source Files/lpc17xx_clkpwr.c" "Source Files/lpc17xx_pinsel.c" \
+*       "Test Files/test_uart_isr.c" -lm -o test_uart_isr
+*   ./test_uart_isr
+**********************************************************************/
+
+/* Includes ------------------------------------------------------------------- */
+#include "lpc17xx_uart.h"
+#include "lpc_host_sim.h"
+#include "host_test.h"
+
+/* Private Macros ------------------------------------------------------------- */
+#define TEST_BAUD			115200
+#define TEST_LINES			30			/* Thread output, five times the ring */
+#define TEST_TICKS			60			/* Handler printf() calls */
+#define TEST_TICK_HZ		2000
+
+/* Private Variables ---------------------------------------------------------- */
+static uint8_t out[16 * 1024];			/* Characters on the UART0 wire */
+static uint32_t out_len;
+static volatile uint32_t ticks;
+
+/* Private Functions ---------------------------------------------------------- */
+static void uart0_sink (uint8_t port, uint8_t c)
+{
+	(void)port;
+	if (out_len < sizeof(out))
+	{
+		out[out_len] = c;
+	}
+	out_len++;
+}
+
+/* Preempts the thread printf() wherever the simulator takes interrupts */
+void SysTick_Handler (void)
+{
+	if (ticks < TEST_TICKS)
+	{
+		printf(LPC_UART0, "<%u>", ticks);
+		ticks++;
+	}
+}
+
+/* Line n of the thread output, '<' never appears in it */
+static uint32_t line (char *buf, uint32_t n)
+{
+	static const char text[] = " abcdefghijklmnopqrstuvwxyz 0123456789\r\n";
+	uint32_t len = 0;
+
+	buf[len++] = 'L';
+	buf[len++] = (char)('0' + (n / 100) % 10);
+	buf[len++] = (char)('0' + (n / 10) % 10);
+	buf[len++] = (char)('0' + n % 10);
+	memcpy(&buf[len], text, sizeof(text) - 1);
+	return len + sizeof(text) - 1;
+}
+
+/* Main Program --------------------------------------------------------------- */
+int main (void)
+{
+	char exp[64];
+	uint32_t i, n, pos, tick, thread, len, inside = 0;
+	uint64_t end;
+
+	HOSTSIM_Init();
+	SystemInit();
+	HOSTSIM_UARTSetSink(0, uart0_sink);
+	UART_Config(LPC_UART0, TEST_BAUD);
+	SysTick_Config(SystemCoreClock / TEST_TICK_HZ);
+
+	for (n = 0; n < TEST_LINES; n++)
+	{
+		printf(LPC_UART0, "L%03u abcdefghijklmnopqrstuvwxyz 0123456789\r\n", n);
+	}
+	end = HOSTSIM_GetCycles() + HOSTSIM_UsToCycles(100000);
+	while ((ticks < TEST_TICKS) && (HOSTSIM_GetCycles() < end))
+	{
+		HOSTSIM_Advance(HOSTSIM_UsToCycles(100));
+	}
+	UART_TxFlush(LPC_UART0);
+	HOSTSIM_Advance(HOSTSIM_UsToCycles(5000));
+	SysTick->CTRL = 0;
+
+	// Take the handler messages out of the wire: they must count up, and
+	// what is left must be the thread output exactly
+	TEST_CHECK(out_len < sizeof(out), "%u characters, more than captured", out_len);
+	tick = 0;
+	thread = 0;
+	n = 0;
+	len = line(exp, n);
+	for (pos = 0; (pos < out_len) && (pos < sizeof(out)) && (test_fails < 10); )
+	{
+		if (out[pos] == '<')
+		{
+			for (i = 0, pos++; (pos < out_len) && (out[pos] >= '0') && (out[pos] <= '9'); pos++)
+			{
+				i = i * 10 + (out[pos] - '0');
+			}
+			TEST_CHECK((pos < out_len) && (out[pos] == '>') && (i == tick),
+					   "handler message %u broken or out of order at %u", tick, pos);
+			pos++;
+			tick++;
+			inside += (n < TEST_LINES - 1) ? 1 : 0;
+			continue;
+		}
+		if ((n >= TEST_LINES) || (out[pos] != (uint8_t)exp[thread]))
+		{
+			TEST_CHECK(0, "thread line %u differs at column %u (wire %u)", n, thread, pos);
+			break;
+		}
+		pos++;
+		if (++thread == len)
+		{
+			thread = 0;
+			len = line(exp, ++n);
+		}
+	}
+	TEST_Print("%u characters: %u thread lines, %u handler messages, %u inside them\n",
+			   out_len, n, tick, inside);
+	TEST_CHECK(n == TEST_LINES, "%u thread lines, %u expected", n, TEST_LINES);
+	TEST_CHECK((tick == TEST_TICKS) && (ticks == TEST_TICKS), "%u handler messages, %u sent",
+			   tick, ticks);
+	TEST_CHECK(inside > 0, "no handler message preempted the thread output");
+	return TEST_Done();
+}
+
+/* --------------------------------- End Of File ------------------------------ */